@@ -645,6 +645,7 @@ class MixxxCore(Feature):
         sources = ["control/control.cpp",
                    "control/controlaudiotaperpot.cpp",
                    "control/controlbehavior.cpp",
+                   "control/controlhandleresolver.cpp",
                    "control/controleffectknob.cpp",
                    "control/controlindicator.cpp",
                    "control/controllinpotmeter.cpp",
@@ -729,9 +730,11 @@ class MixxxCore(Feature):
                    "engine/sync/enginesync.cpp",
                    "engine/sync/synccontrol.cpp",
                    "engine/sync/internalclock.cpp",
+                   "engine/sync/syncnotificationqueue.cpp",
 
                    "engine/engineworker.cpp",
                    "engine/engineworkerscheduler.cpp",
+                   "engine/channelprocessorpool.cpp",
                    "engine/enginebuffer.cpp",
                    "engine/enginebufferscale.cpp",
                    "engine/enginebufferscalelinear.cpp",
@@ -773,9 +776,12 @@ class MixxxCore(Feature):
                    "engine/enginetalkoverducking.cpp",
                    "engine/cachingreader.cpp",
                    "engine/cachingreaderchunk.cpp",
+                   "engine/cachingreaderdiskcache.cpp",
                    "engine/cachingreaderworker.cpp",
 
                    "analyzer/analyzerqueue.cpp",
+                   "analyzer/analyzerworker.cpp",
+                   "analyzer/analyzerpipeline.cpp",
                    "analyzer/analyzerwaveform.cpp",
                    "analyzer/analyzergain.cpp",
                    "analyzer/analyzerebur128.cpp",
@@ -789,6 +795,8 @@ class MixxxCore(Feature):
                    "controllers/controllerpresetfilehandler.cpp",
                    "controllers/controllerpresetinfo.cpp",
                    "controllers/controllerpresetinfoenumerator.cpp",
+                   "controllers/controllerscriptprofiler.cpp",
+                   "controllers/controllertimerwheel.cpp",
                    "controllers/controlpickermenu.cpp",
                    "controllers/controllermappingtablemodel.cpp",
                    "controllers/controllerinputmappingtablemodel.cpp",
@@ -805,6 +813,7 @@ class MixxxCore(Feature):
                    "controllers/midi/midicontrollerpresetfilehandler.cpp",
                    "controllers/midi/midienumerator.cpp",
                    "controllers/midi/midioutputhandler.cpp",
+                   "controllers/midi/midioutputqueue.cpp",
                    "controllers/softtakeover.cpp",
                    "controllers/keyboard/keyboardeventfilter.cpp",
 
@@ -896,6 +905,7 @@ class MixxxCore(Feature):
                    "library/trackcollection.cpp",
                    "library/basesqltablemodel.cpp",
                    "library/basetrackcache.cpp",
+                   "library/trackcolumnindex.cpp",
                    "library/columncache.cpp",
                    "library/librarytablemodel.cpp",
                    "library/searchquery.cpp",
@@ -970,6 +980,7 @@ class MixxxCore(Feature):
                    "library/dao/cuedao.cpp",
                    "library/dao/cue.cpp",
                    "library/dao/trackdao.cpp",
+                   "library/dao/tracksearchindex.cpp",
                    "library/dao/playlistdao.cpp",
                    "library/dao/libraryhashdao.cpp",
                    "library/dao/settingsdao.cpp",
@@ -997,6 +1008,7 @@ class MixxxCore(Feature):
 
                    "waveform/sharedglcontext.cpp",
                    "waveform/waveform.cpp",
+                   "waveform/waveformkernels.cpp",
                    "waveform/waveformfactory.cpp",
                    "waveform/waveformwidgetfactory.cpp",
                    "waveform/vsyncthread.cpp",
@@ -1008,12 +1020,14 @@ class MixxxCore(Feature):
                    "waveform/renderers/waveformrendermark.cpp",
                    "waveform/renderers/waveformrendermarkrange.cpp",
                    "waveform/renderers/waveformrenderbeat.cpp",
+                   "waveform/renderers/waveformrendertiles.cpp",
                    "waveform/renderers/waveformrendererendoftrack.cpp",
                    "waveform/renderers/waveformrendererpreroll.cpp",
 
                    "waveform/renderers/waveformrendererfilteredsignal.cpp",
                    "waveform/renderers/waveformrendererhsv.cpp",
                    "waveform/renderers/waveformrendererrgb.cpp",
+                   "waveform/renderers/rasterwaveformrendererrgb.cpp",
                    "waveform/renderers/qtwaveformrendererfilteredsignal.cpp",
                    "waveform/renderers/qtwaveformrenderersimplesignal.cpp",
 
@@ -1035,6 +1049,7 @@ class MixxxCore(Feature):
                    "waveform/widgets/softwarewaveformwidget.cpp",
                    "waveform/widgets/hsvwaveformwidget.cpp",
                    "waveform/widgets/rgbwaveformwidget.cpp",
+                   "waveform/widgets/rasterrgbwaveformwidget.cpp",
                    "waveform/widgets/qtwaveformwidget.cpp",
                    "waveform/widgets/qtsimplewaveformwidget.cpp",
                    "waveform/widgets/glwaveformwidget.cpp",
@@ -1104,6 +1119,7 @@ class MixxxCore(Feature):
                    "util/sleepableqthread.cpp",
                    "util/statsmanager.cpp",
                    "util/stat.cpp",
+                   "util/stathistogram.cpp",
                    "util/statmodel.cpp",
                    "util/duration.cpp",
                    "util/time.cpp",
@@ -1135,6 +1151,7 @@ class MixxxCore(Feature):
                    "util/db/sqlstringformatter.cpp",
                    "util/db/sqltransaction.cpp",
                    "util/sample.cpp",
+                   "util/samplekernels.cpp",
                    "util/samplebuffer.cpp",
                    "util/singularsamplebuffer.cpp",
                    "util/circularsamplebuffer.cpp",
@@ -7,6 +7,10 @@ import sys
 
 BASIC_INDENT = 4
 
+# From this number of channels on, the mixing loop is delegated to the
+# explicitly vectorized kernels, see src/util/samplekernels.h
+MIN_CHANNELS_FOR_KERNELS = 4
+
 COPY_WITH_GAIN_METHOD_PATTERN = 'copy%(i)dWithGain'
 def copy_with_gain_method_name(i):
     return COPY_WITH_GAIN_METHOD_PATTERN % {'i' : i}
@@ -168,6 +172,17 @@ def copy_with_gain(output, base_indent_depth, num_channels):
         write('return;', depth=2)
         write('}', depth=1)
 
+    if num_channels >= MIN_CHANNELS_FOR_KERNELS:
+        write('const CSAMPLE* const pSrc[%(n)d] = {%(srcs)s};' % {
+            'n': num_channels,
+            'srcs': ', '.join('pSrc%d' % i for i in xrange(num_channels))}, depth=1)
+        write('const CSAMPLE_GAIN gain[%(n)d] = {%(gains)s};' % {
+            'n': num_channels,
+            'gains': ', '.join('gain%d' % i for i in xrange(num_channels))}, depth=1)
+        write('copyMultipleWithGain(pDest, pSrc, gain, %d, iNumSamples);' % num_channels, depth=1)
+        write('}')
+        return
+
     write('// note: LOOP VECTORIZED.', depth=1)
     write('for (int i = 0; i < iNumSamples; ++i) {', depth=1)
     terms = ['pSrc%(i)d[i] * gain%(i)d' % {'i': i} for i in xrange(num_channels)]
@@ -206,6 +221,20 @@ def copy_with_ramping_gain(output, base_indent_depth, num_channels):
         write('const CSAMPLE_GAIN gain_delta%(i)d = (gain%(i)dout - gain%(i)din) / (iNumSamples / 2);' % {'i': i}, depth=1)
         write('const CSAMPLE_GAIN start_gain%(i)d = gain%(i)din + gain_delta%(i)d;' % {'i': i}, depth=1)
 
+    if num_channels >= MIN_CHANNELS_FOR_KERNELS:
+        write('const CSAMPLE* const pSrc[%(n)d] = {%(srcs)s};' % {
+            'n': num_channels,
+            'srcs': ', '.join('pSrc%d' % i for i in xrange(num_channels))}, depth=1)
+        write('const CSAMPLE_GAIN start_gain[%(n)d] = {%(gains)s};' % {
+            'n': num_channels,
+            'gains': ', '.join('start_gain%d' % i for i in xrange(num_channels))}, depth=1)
+        write('const CSAMPLE_GAIN gain_delta[%(n)d] = {%(gains)s};' % {
+            'n': num_channels,
+            'gains': ', '.join('gain_delta%d' % i for i in xrange(num_channels))}, depth=1)
+        write('copyMultipleWithRampingGain(pDest, pSrc, start_gain, gain_delta, %d, iNumSamples / 2);' % num_channels, depth=1)
+        write('}')
+        return
+
     write('// note: LOOP VECTORIZED.', depth=1)
     write('for (int i = 0; i < iNumSamples / 2; ++i) {', depth=1)
 
@@ -0,0 +1,108 @@
+#include "analyzer/analyzerpipeline.h"
+
+#include "analyzer/analyzer.h"
+#include "util/assert.h"
+
+AnalyzerPipelineStage::AnalyzerPipelineStage(
+        AnalyzerPipeline* pPipeline, Analyzer* pAnalyzer)
+        : m_pPipeline(pPipeline),
+          m_pAnalyzer(pAnalyzer),
+          m_blocksConsumed(0) {
+}
+
+void AnalyzerPipelineStage::run() {
+    QThread::currentThread()->setObjectName("AnalyzerPipelineStage");
+    while (true) {
+        const SampleBuffer* pBlock = m_pPipeline->waitForBlock(this);
+        if (!pBlock) {
+            break;
+        }
+        m_pAnalyzer->process(pBlock->data(), pBlock->size());
+        m_pPipeline->blockConsumed(this);
+    }
+}
+
+AnalyzerPipeline::AnalyzerPipeline(
+        const std::vector<Analyzer*>& analyzers,
+        SINT samplesPerBlock,
+        int ringSize)
+        : m_blocksCommitted(0),
+          m_exit(false) {
+    DEBUG_ASSERT(ringSize > 0);
+    m_ring.reserve(ringSize);
+    for (int i = 0; i < ringSize; ++i) {
+        m_ring.push_back(SampleBuffer(samplesPerBlock));
+    }
+    for (Analyzer* pAnalyzer: analyzers) {
+        m_stages.push_back(
+                std::make_unique<AnalyzerPipelineStage>(this, pAnalyzer));
+    }
+    for (const auto& pStage: m_stages) {
+        // Stages inherit the low priority of the analysis
+        pStage->start(QThread::LowPriority);
+    }
+}
+
+AnalyzerPipeline::~AnalyzerPipeline() {
+    {
+        QMutexLocker locked(&m_mutex);
+        m_exit = true;
+        m_blockCommitted.wakeAll();
+    }
+    for (const auto& pStage: m_stages) {
+        pStage->wait();
+    }
+}
+
+qint64 AnalyzerPipeline::minBlocksConsumed() const {
+    qint64 minConsumed = m_blocksCommitted;
+    for (const auto& pStage: m_stages) {
+        if (pStage->m_blocksConsumed < minConsumed) {
+            minConsumed = pStage->m_blocksConsumed;
+        }
+    }
+    return minConsumed;
+}
+
+SampleBuffer* AnalyzerPipeline::writeBlock() {
+    QMutexLocker locked(&m_mutex);
+    const qint64 ringSize = static_cast<qint64>(m_ring.size());
+    // The slot of the next block is still in use until the slowest
+    // stage has consumed the block that has been committed ringSize
+    // blocks before.
+    while (m_blocksCommitted - minBlocksConsumed() >= ringSize) {
+        m_blockConsumed.wait(&m_mutex);
+    }
+    return &m_ring[m_blocksCommitted % ringSize];
+}
+
+void AnalyzerPipeline::commitBlock() {
+    QMutexLocker locked(&m_mutex);
+    ++m_blocksCommitted;
+    m_blockCommitted.wakeAll();
+}
+
+void AnalyzerPipeline::drain() {
+    QMutexLocker locked(&m_mutex);
+    while (minBlocksConsumed() < m_blocksCommitted) {
+        m_blockConsumed.wait(&m_mutex);
+    }
+}
+
+const SampleBuffer* AnalyzerPipeline::waitForBlock(AnalyzerPipelineStage* pStage) {
+    QMutexLocker locked(&m_mutex);
+    while (!m_exit && (pStage->m_blocksConsumed >= m_blocksCommitted)) {
+        m_blockCommitted.wait(&m_mutex);
+    }
+    if (m_exit) {
+        return nullptr;
+    }
+    const qint64 ringSize = static_cast<qint64>(m_ring.size());
+    return &m_ring[pStage->m_blocksConsumed % ringSize];
+}
+
+void AnalyzerPipeline::blockConsumed(AnalyzerPipelineStage* pStage) {
+    QMutexLocker locked(&m_mutex);
+    ++pStage->m_blocksConsumed;
+    m_blockConsumed.wakeAll();
+}
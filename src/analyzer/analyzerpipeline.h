@@ -0,0 +1,89 @@
+#ifndef ANALYZER_ANALYZERPIPELINE_H
+#define ANALYZER_ANALYZERPIPELINE_H
+
+#include <QMutex>
+#include <QThread>
+#include <QWaitCondition>
+
+#include <vector>
+
+#include "util/samplebuffer.h"
+#include "util/memory.h"
+#include "util/types.h"
+
+class Analyzer;
+class AnalyzerPipeline;
+
+// Runs Analyzer::process() of a single analyzer on its own thread.
+class AnalyzerPipelineStage : public QThread {
+    Q_OBJECT
+  public:
+    AnalyzerPipelineStage(AnalyzerPipeline* pPipeline, Analyzer* pAnalyzer);
+    ~AnalyzerPipelineStage() override = default;
+
+  protected:
+    void run() override;
+
+  private:
+    friend class AnalyzerPipeline;
+
+    AnalyzerPipeline* const m_pPipeline;
+    Analyzer* const m_pAnalyzer;
+
+    // The number of blocks that have been processed by this stage.
+    // Protected by AnalyzerPipeline::m_mutex.
+    qint64 m_blocksConsumed;
+};
+
+// Decodes each block of audio samples only once and fans it out to
+// all analyzers that process the blocks concurrently on their own
+// threads. Decoded blocks are stored in a ring of fixed size. The
+// producer only blocks if the slowest analyzer falls behind by more
+// than the capacity of the ring.
+//
+// Usage from the thread that owns the analyzers:
+//  - initialize() all analyzers
+//  - repeat: fill writeBlock() and commitBlock()
+//  - drain() before calling finalize() or cleanup() on the analyzers
+class AnalyzerPipeline {
+  public:
+    AnalyzerPipeline(
+            const std::vector<Analyzer*>& analyzers,
+            SINT samplesPerBlock,
+            int ringSize);
+    ~AnalyzerPipeline();
+
+    // Returns the next free block of the ring, waiting until all
+    // analyzers have processed its previous contents.
+    SampleBuffer* writeBlock();
+    // Publishes the block returned by writeBlock() to all analyzers.
+    void commitBlock();
+    // Waits until all analyzers have processed all committed blocks.
+    void drain();
+
+  private:
+    friend class AnalyzerPipelineStage;
+
+    // Called from the stage threads. Returns nullptr on exit.
+    const SampleBuffer* waitForBlock(AnalyzerPipelineStage* pStage);
+    void blockConsumed(AnalyzerPipelineStage* pStage);
+
+    // Requires m_mutex to be locked.
+    qint64 minBlocksConsumed() const;
+
+    std::vector<SampleBuffer> m_ring;
+    std::vector<std::unique_ptr<AnalyzerPipelineStage>> m_stages;
+
+    QMutex m_mutex;
+    // Signaled when a new block has been committed or on exit
+    QWaitCondition m_blockCommitted;
+    // Signaled when a stage has consumed a block
+    QWaitCondition m_blockConsumed;
+
+    // The number of blocks that have been committed by the producer.
+    // Protected by m_mutex.
+    qint64 m_blocksCommitted;
+    bool m_exit;
+};
+
+#endif /* ANALYZER_ANALYZERPIPELINE_H */
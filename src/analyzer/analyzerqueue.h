@@ -1,24 +1,26 @@
 #ifndef ANALYZER_ANALYZERQUEUE_H
 #define ANALYZER_ANALYZERQUEUE_H
 
-#include <QThread>
+#include <QObject>
 #include <QQueue>
+#include <QMutex>
 #include <QWaitCondition>
-#include <QSemaphore>
 
 #include <vector>
 
 #include "preferences/usersettings.h"
-#include "sources/audiosource.h"
 #include "track/track.h"
+#include "util/compatibility.h"
 #include "util/db/dbconnectionpool.h"
-#include "util/samplebuffer.h"
 #include "util/memory.h"
 
-class Analyzer;
-class AnalysisDao;
+class AnalyzerWorker;
 
-class AnalyzerQueue : public QThread {
+// Distributes queued tracks among a pool of AnalyzerWorker threads.
+// Each worker analyzes one track at a time, so up to workerCount tracks
+// are analyzed concurrently. Progress of all workers is aggregated and
+// reported through the signals of this class.
+class AnalyzerQueue : public QObject {
     Q_OBJECT
 
   public:
@@ -30,62 +32,71 @@ class AnalyzerQueue : public QThread {
     AnalyzerQueue(
             mixxx::DbConnectionPoolPtr pDbConnectionPool,
             const UserSettingsPointer& pConfig,
-            Mode mode = Mode::Default);
+            Mode mode = Mode::Default,
+            int workerCount = 1);
     ~AnalyzerQueue() override;
 
+    // The number of workers for batch analysis as configured by the user.
+    // One core is left for the engine and the analysis of tracks that are
+    // loaded into players by default.
+    static int getBatchWorkerCount(const UserSettingsPointer& pConfig);
+
+    int workerCount() const {
+        return static_cast<int>(m_workers.size());
+    }
+
     void stop();
     void queueAnalyseTrack(TrackPointer tio);
 
   public slots:
     void slotAnalyseTrack(TrackPointer tio);
-    void slotUpdateProgress();
 
   signals:
     void trackProgress(int progress);
     void trackDone(TrackPointer track);
     void trackFinished(int size);
-    // Signals from AnalyzerQueue Thread:
+    // Signals from AnalyzerWorker threads:
     void queueEmpty();
-    void updateProgress();
+    // Progress of a queued track that no worker is analyzing yet
+    void queuedTrackProgress(TrackPointer pTrack, int progress);
 
-  protected:
-    void run();
+  private slots:
+    void slotQueuedTrackProgress(TrackPointer pTrack, int progress);
 
   private:
-    struct progress_info {
-        TrackPointer current_track;
-        int track_progress; // in 0.1 %
-        int queue_size;
-        QSemaphore sema;
-    };
-
-    mixxx::DbConnectionPoolPtr m_pDbConnectionPool;
-
-    std::unique_ptr<AnalysisDao> m_pAnalysisDao;
-
-    typedef std::unique_ptr<Analyzer> AnalyzerPtr;
-    std::vector<AnalyzerPtr> m_pAnalyzers;
+    friend class AnalyzerWorker;
+
+    // The following functions are called from the AnalyzerWorker threads
+    bool isExiting() const {
+        return load_atomic(m_exit) != 0;
+    }
+    bool isLoadedTrackWaiting(AnalyzerWorker* pWorker, TrackPointer analysingTrack);
+    // The returned track might be NULL, up to the caller to check.
+    TrackPointer dequeueNextBlocking(AnalyzerWorker* pWorker);
+    // Marks the worker as idle after it has finished a track.
+    void workerFinished(AnalyzerWorker* pWorker);
+    void emptyCheck();
 
-    void execThread();
+    // This is called from the GUI thread
+    void updateWorkerProgress(AnalyzerWorker* pWorker, int progress, int queueSize);
 
-    bool isLoadedTrackWaiting(TrackPointer analysingTrack);
-    TrackPointer dequeueNextBlocking();
-    bool doAnalysis(TrackPointer tio, mixxx::AudioSourcePointer pAudioSource);
-    void emitUpdateProgress(TrackPointer tio, int progress);
-    void emptyCheck();
-    void updateSize();
+    int remainingTracks() const;
 
-    bool m_exit;
-    QAtomicInt m_aiCheckPriorities;
+    std::vector<std::unique_ptr<AnalyzerWorker>> m_workers;
 
-    SampleBuffer m_sampleBuffer;
+    QAtomicInt m_exit;
 
     // The processing queue and associated mutex
     QQueue<TrackPointer> m_queuedTracks;
-    QMutex m_qm;
+    mutable QMutex m_qm;
     QWaitCondition m_qwait;
-    struct progress_info m_progressInfo;
-    int m_queue_size;
+    // Number of workers that are currently analyzing a track.
+    // Protected by m_qm.
+    int m_busyWorkers;
+
+    // Progress of the track that is currently analyzed by each
+    // worker in 0.1 % or -1 if idle. Only accessed from the GUI thread.
+    std::vector<int> m_workerProgress;
 };
 
 #endif /* ANALYZER_ANALYZERQUEUE_H */
@@ -115,7 +115,12 @@ bool AnalyzerWaveform::isDisabledOrLoadStoredSuccess(TrackPointer tio) const {
                 if (missingWaveform && vc == WaveformFactory::VC_USE) {
                     pLoadedTrackWaveform = ConstWaveformPointer(
                             WaveformFactory::loadWaveformFromAnalysis(analysis));
-                    missingWaveform = false;
+                    missingWaveform = !pLoadedTrackWaveform->isValid();
+                    if (missingWaveform) {
+                        // Corrupt, analyze again
+                        pLoadedTrackWaveform.clear();
+                        m_pAnalysisDao->deleteAnalysis(analysis.analysisId);
+                    }
                 } else if (vc != WaveformFactory::VC_KEEP) {
                     // remove all other Analysis except that one we should keep
                     m_pAnalysisDao->deleteAnalysis(analysis.analysisId);
@@ -125,7 +130,12 @@ bool AnalyzerWaveform::isDisabledOrLoadStoredSuccess(TrackPointer tio) const {
                 if (missingWavesummary && vc == WaveformFactory::VC_USE) {
                     pLoadedTrackWaveformSummary = ConstWaveformPointer(
                             WaveformFactory::loadWaveformFromAnalysis(analysis));
-                    missingWavesummary = false;
+                    missingWavesummary = !pLoadedTrackWaveformSummary->isValid();
+                    if (missingWavesummary) {
+                        // Corrupt, analyze again
+                        pLoadedTrackWaveformSummary.clear();
+                        m_pAnalysisDao->deleteAnalysis(analysis.analysisId);
+                    }
                 } else if (vc != WaveformFactory::VC_KEEP) {
                     // remove all other Analysis except that one we should keep
                     m_pAnalysisDao->deleteAnalysis(analysis.analysisId);
@@ -143,6 +153,11 @@ bool AnalyzerWaveform::isDisabledOrLoadStoredSuccess(TrackPointer tio) const {
         if (pLoadedTrackWaveformSummary) {
             tio->setWaveformSummary(pLoadedTrackWaveformSummary);
         }
+        if (pLoadedTrackWaveform || pLoadedTrackWaveformSummary) {
+            // Stores waveforms that have been loaded from an outdated
+            // format in the mappable format.
+            m_pAnalysisDao->saveTrackAnalyses(*tio);
+        }
         return true;
     }
     return false;
@@ -284,6 +299,7 @@ void AnalyzerWaveform::finalize(TrackPointer tio) {
         m_waveform->setCompletion(m_waveform->getDataSize());
         m_waveform->setVersion(WaveformFactory::currentWaveformVersion());
         m_waveform->setDescription(WaveformFactory::currentWaveformDescription());
+        m_waveform->buildMipLevels();
         // Since clear() could delete the waveform, clear our pointer to the
         // waveform's vector data first.
         m_waveformData = nullptr;
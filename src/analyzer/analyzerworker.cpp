@@ -0,0 +1,385 @@
+#include "analyzer/analyzerworker.h"
+
+#include <QTime>
+
+#ifdef __VAMP__
+#include "analyzer/analyzerbeats.h"
+#include "analyzer/analyzerkey.h"
+#endif
+#include "analyzer/analyzergain.h"
+#include "analyzer/analyzerebur128.h"
+#include "analyzer/analyzerpipeline.h"
+#include "analyzer/analyzerwaveform.h"
+#include "library/dao/analysisdao.h"
+#include "sources/soundsourceproxy.h"
+#include "util/db/dbconnectionpooler.h"
+#include "util/db/dbconnectionpooled.h"
+#include "util/math.h"
+#include "util/timer.h"
+#include "util/trace.h"
+#include "util/logger.h"
+
+// Measured in 0.1%,
+// 0 for no progress during finalize
+// 1 to display the text "finalizing"
+// 100 for 10% step after finalize
+#define FINALIZE_PROMILLE 1
+
+namespace {
+
+mixxx::Logger kLogger("AnalyzerWorker");
+
+// Analysis is done in blocks.
+// We need to use a smaller block size, because on Linux the AnalyzerQueue
+// can starve the CPU of its resources, resulting in xruns. A block size
+// of 4096 frames per block seems to do fine.
+const SINT kAnalysisChannels = mixxx::AudioSource::kChannelCountStereo;
+const SINT kAnalysisFramesPerBlock = 4096;
+const SINT kAnalysisSamplesPerBlock =
+        kAnalysisFramesPerBlock * kAnalysisChannels;
+
+// The number of decoded blocks that are buffered for the analyzer
+// pipeline. The decoder is allowed to run ahead of the slowest analyzer
+// by this number of blocks.
+const int kAnalysisPipelineBlocks = 16;
+
+QAtomicInt s_instanceCounter(0);
+
+} // anonymous namespace
+
+AnalyzerWorker::AnalyzerWorker(
+        AnalyzerQueue* pQueue,
+        int workerIndex,
+        mixxx::DbConnectionPoolPtr pDbConnectionPool,
+        const UserSettingsPointer& pConfig,
+        AnalyzerQueue::Mode mode)
+        : m_pQueue(pQueue),
+          m_workerIndex(workerIndex),
+          m_pDbConnectionPool(std::move(pDbConnectionPool)),
+          m_aiCheckPriorities(false),
+          m_sampleBuffer(kAnalysisSamplesPerBlock) {
+    if (mode != AnalyzerQueue::Mode::WithoutWaveform) {
+        m_pAnalysisDao = std::make_unique<AnalysisDao>(pConfig);
+        m_pAnalyzers.push_back(std::make_unique<AnalyzerWaveform>(m_pAnalysisDao.get()));
+    }
+    m_pAnalyzers.push_back(std::make_unique<AnalyzerGain>(pConfig));
+    m_pAnalyzers.push_back(std::make_unique<AnalyzerEbur128>(pConfig));
+#ifdef __VAMP__
+    m_pAnalyzers.push_back(std::make_unique<AnalyzerBeats>(pConfig));
+    m_pAnalyzers.push_back(std::make_unique<AnalyzerKey>(pConfig));
+#endif
+
+    m_progressInfo.track_progress = 0;
+    m_progressInfo.queue_size = 0;
+
+    connect(this, SIGNAL(updateProgress()),
+            this, SLOT(slotUpdateProgress()));
+}
+
+AnalyzerWorker::~AnalyzerWorker() {
+    releaseProgress();
+    wait(); //Wait until thread has actually stopped before proceeding.
+}
+
+void AnalyzerWorker::releaseProgress() {
+    m_progressInfo.sema.release();
+}
+
+// This is called from the AnalyzerWorker thread
+bool AnalyzerWorker::needsProcessing(TrackPointer pTrack) const {
+    bool processTrack = false;
+    for (auto const& pAnalyzer: m_pAnalyzers) {
+        if (!pAnalyzer->isDisabledOrLoadStoredSuccess(pTrack)) {
+            processTrack = true;
+        }
+    }
+    return processTrack;
+}
+
+// This is called from the AnalyzerWorker thread
+bool AnalyzerWorker::doAnalysis(TrackPointer pTrack, mixxx::AudioSourcePointer pAudioSource) {
+
+    QTime progressUpdateInhibitTimer;
+    progressUpdateInhibitTimer.start(); // Inhibit Updates for 60 milliseconds
+
+    SINT frameIndex = pAudioSource->getMinFrameIndex();
+    bool dieflag = false;
+    bool cancelled = false;
+    do {
+        ScopedTimer t("AnalyzerQueue::doAnalysis block");
+
+        DEBUG_ASSERT(frameIndex < pAudioSource->getMaxFrameIndex());
+        const SINT framesRemaining =
+                pAudioSource->getMaxFrameIndex() - frameIndex;
+        const SINT framesToRead =
+                math_min(kAnalysisFramesPerBlock, framesRemaining);
+        DEBUG_ASSERT(0 < framesToRead);
+
+        // Decode directly into the next free block of the pipeline
+        SampleBuffer* pBlock =
+                m_pPipeline ? m_pPipeline->writeBlock() : &m_sampleBuffer;
+        const SINT framesRead =
+                pAudioSource->readSampleFramesStereo(
+                        framesToRead,
+                        pBlock);
+        DEBUG_ASSERT(framesRead <= framesToRead);
+        frameIndex += framesRead;
+        DEBUG_ASSERT(pAudioSource->isValidFrameIndex(frameIndex));
+
+        // To compare apples to apples, let's only look at blocks that are
+        // the full block size.
+        if (kAnalysisFramesPerBlock == framesRead) {
+            // Complete analysis block of audio samples has been read.
+            processBlock(pBlock);
+        } else {
+            // Partial analysis block of audio samples has been read.
+            // This should only happen at the end of an audio stream,
+            // otherwise a decoding error must have occurred.
+            if (frameIndex < pAudioSource->getMaxFrameIndex()) {
+                // EOF not reached -> Maybe a corrupt file?
+                kLogger.warning() << "Failed to read sample data from file:"
+                        << pTrack->getLocation()
+                        << "@" << frameIndex;
+                if (0 >= framesRead) {
+                    // If no frames have been read then abort the analysis.
+                    // Otherwise we might get stuck in this loop forever.
+                    dieflag = true; // abort
+                    cancelled = false; // completed, no retry
+                }
+            }
+        }
+
+        // emit progress updates
+        // During the doAnalysis function it goes only to 100% - FINALIZE_PERCENT
+        // because the finalize functions will take also some time
+        //fp div here prevents insane signed overflow
+        DEBUG_ASSERT(pAudioSource->isValidFrameIndex(frameIndex));
+        const double frameProgress =
+                double(frameIndex) / double(pAudioSource->getMaxFrameIndex());
+        int progressPromille = frameProgress * (1000 - FINALIZE_PROMILLE);
+
+        if (m_progressInfo.track_progress != progressPromille) {
+            if (progressUpdateInhibitTimer.elapsed() > 60) {
+                // Inhibit Updates for 60 milliseconds
+                emitUpdateProgress(pTrack, progressPromille);
+                progressUpdateInhibitTimer.start();
+            }
+        }
+
+        // has something new entered the queue?
+        if (m_aiCheckPriorities.fetchAndStoreAcquire(false)) {
+            if (m_pQueue->isLoadedTrackWaiting(this, pTrack)) {
+                kLogger.debug() << "Interrupting analysis to give preference to a loaded track.";
+                dieflag = true;
+                cancelled = true;
+            }
+        }
+
+        if (m_pQueue->isExiting()) {
+            dieflag = true;
+            cancelled = true;
+        }
+
+        // Ignore blocks in which we decided to bail for stats purposes.
+        if (dieflag || cancelled) {
+            t.cancel();
+        }
+    } while (!dieflag && (frameIndex < pAudioSource->getMaxFrameIndex()));
+
+    if (m_pPipeline) {
+        // All analyzers must have processed all blocks before
+        // they are finalized or cleaned up.
+        m_pPipeline->drain();
+    }
+
+    return !cancelled; //don't return !dieflag or we might reanalyze over and over
+}
+
+// This is called from the AnalyzerWorker thread
+void AnalyzerWorker::processBlock(SampleBuffer* pBlock) {
+    if (m_pPipeline) {
+        // The analyzers will pick up the block on their own threads
+        m_pPipeline->commitBlock();
+    } else {
+        for (auto const& pAnalyzer: m_pAnalyzers) {
+            pAnalyzer->process(pBlock->data(), pBlock->size());
+        }
+    }
+}
+
+void AnalyzerWorker::run() {
+    // If there are no analyzers, don't waste time running.
+    if (m_pAnalyzers.empty()) {
+        return;
+    }
+
+    const int instanceId = s_instanceCounter.fetchAndAddAcquire(1) + 1;
+    QThread::currentThread()->setObjectName(QString("AnalyzerWorker %1").arg(instanceId));
+
+    kLogger.debug() << "Entering thread";
+
+    execThread();
+
+    kLogger.debug() << "Exiting thread";
+}
+
+void AnalyzerWorker::execThread() {
+    // The thread-local database connection for waveform analysis must not
+    // be closed before returning from this function. Therefore the
+    // DbConnectionPooler is defined at this outer function scope,
+    // independent of whether a database connection will be opened
+    // or not.
+    mixxx::DbConnectionPooler dbConnectionPooler;
+    // m_pAnalysisDao remains null if no analyzer needs database access.
+    // Currently only waveform analyses makes use of it.
+    if (m_pAnalysisDao) {
+        dbConnectionPooler = mixxx::DbConnectionPooler(m_pDbConnectionPool); // move assignment
+        if (!dbConnectionPooler.isPooling()) {
+            kLogger.warning()
+                    << "Failed to obtain database connection for analyzer worker thread";
+            return;
+        }
+        // Obtain and use the newly created database connection within this thread
+        QSqlDatabase dbConnection = mixxx::DbConnectionPooled(m_pDbConnectionPool);
+        DEBUG_ASSERT(dbConnection.isOpen());
+        m_pAnalysisDao->initialize(dbConnection);
+    }
+
+    // A pool of multiple workers already keeps all cores busy by
+    // analyzing different tracks concurrently. A single worker decodes
+    // each block once and lets the analyzers process it in parallel,
+    // so that the slowest analyzer bounds the time for a track instead
+    // of the sum of all analyzers.
+    if (m_pQueue->workerCount() == 1 && m_pAnalyzers.size() > 1) {
+        std::vector<Analyzer*> analyzers;
+        for (auto const& pAnalyzer: m_pAnalyzers) {
+            analyzers.push_back(pAnalyzer.get());
+        }
+        m_pPipeline = std::make_unique<AnalyzerPipeline>(
+                analyzers, kAnalysisSamplesPerBlock, kAnalysisPipelineBlocks);
+    }
+
+    m_progressInfo.current_track.reset();
+    m_progressInfo.track_progress = 0;
+    m_progressInfo.queue_size = 0;
+    m_progressInfo.sema.release(); // Initialize with one
+
+    while (!m_pQueue->isExiting()) {
+        TrackPointer nextTrack = m_pQueue->dequeueNextBlocking(this);
+
+        // It's important to check for m_exit here in case we decided to exit
+        // while blocking for a new track.
+        if (m_pQueue->isExiting()) {
+            if (nextTrack) {
+                m_pQueue->workerFinished(this);
+            }
+            break;
+        }
+
+        // If the track is NULL, try to get the next one.
+        // Could happen if the track was queued but then deleted,
+        // if another worker took the track first or if
+        // dequeueNextBlocking is unblocked by exit == true
+        if (!nextTrack) {
+            m_pQueue->emptyCheck();
+            continue;
+        }
+
+        kLogger.debug() << "Analyzing" << nextTrack->getTitle() << nextTrack->getLocation();
+
+        Trace trace("AnalyzerQueue analyzing track");
+
+        // Get the audio
+        mixxx::AudioSourceConfig audioSrcCfg;
+        audioSrcCfg.setChannelCount(kAnalysisChannels);
+        auto pAudioSource = SoundSourceProxy(nextTrack).openAudioSource(audioSrcCfg);
+        if (!pAudioSource) {
+            kLogger.warning() << "Failed to open file for analyzing:" << nextTrack->getLocation();
+            m_pQueue->workerFinished(this);
+            m_pQueue->emptyCheck();
+            continue;
+        }
+
+        bool processTrack = false;
+        for (auto const& pAnalyzer: m_pAnalyzers) {
+            // Make sure not to short-circuit initialize(...)
+            if (pAnalyzer->initialize(nextTrack, pAudioSource->getSamplingRate(), pAudioSource->getFrameCount() * kAnalysisChannels)) {
+                processTrack = true;
+            }
+        }
+
+        if (processTrack) {
+            emitUpdateProgress(nextTrack, 0);
+            bool completed = doAnalysis(nextTrack, pAudioSource);
+            if (!completed) {
+                // This track was cancelled
+                for (auto const& pAnalyzer: m_pAnalyzers) {
+                    pAnalyzer->cleanup(nextTrack);
+                }
+                m_pQueue->queueAnalyseTrack(nextTrack);
+                emitUpdateProgress(nextTrack, 0);
+            } else {
+                // 100% - FINALIZE_PERCENT finished
+                emitUpdateProgress(nextTrack, 1000 - FINALIZE_PROMILLE);
+                // This takes around 3 sec on a Atom Netbook
+                for (auto const& pAnalyzer: m_pAnalyzers) {
+                    pAnalyzer->finalize(nextTrack);
+                }
+                emit(m_pQueue->trackDone(nextTrack));
+                emitUpdateProgress(nextTrack, 1000); // 100%
+            }
+        } else {
+            emitUpdateProgress(nextTrack, 1000); // 100%
+            kLogger.debug() << "Skipping track analysis because no analyzer initialized.";
+        }
+        m_pQueue->workerFinished(this);
+        m_pQueue->emptyCheck();
+    }
+
+    // Stop the pipeline threads before the database connection
+    // of this thread is closed.
+    m_pPipeline.reset();
+
+    if (m_pAnalysisDao) {
+        // Invalidate reference to the thread-local database connection
+        // that will be closed soon. Not necessary, just in case ;)
+        m_pAnalysisDao->initialize(QSqlDatabase());
+    }
+
+    emit(m_pQueue->queueEmpty()); // emit in case of exit;
+}
+
+// This is called from the AnalyzerWorker thread
+void AnalyzerWorker::emitUpdateProgress(TrackPointer track, int progress) {
+    if (!m_pQueue->isExiting()) {
+        // First tryAcqire will have always success because sema is initialized with on
+        // The following tries will success if the previous signal was processed in the GUI Thread
+        // This prevent the AnalysisQueue from filling up the GUI Thread event Queue
+        // 100 % is emitted in any case
+        if (progress < 1000 - FINALIZE_PROMILLE && progress > 0) {
+            // Signals during processing are not required in any case
+            if (!m_progressInfo.sema.tryAcquire()) {
+               return;
+            }
+        } else {
+            m_progressInfo.sema.acquire();
+        }
+        m_progressInfo.current_track = track;
+        m_progressInfo.track_progress = progress;
+        // The track that is currently analyzed by this worker
+        // is not included in the remaining tracks.
+        m_progressInfo.queue_size = m_pQueue->remainingTracks() - 1;
+        emit(updateProgress());
+    }
+}
+
+//slot
+void AnalyzerWorker::slotUpdateProgress() {
+    if (m_progressInfo.current_track) {
+        m_progressInfo.current_track->setAnalyzerProgress(m_progressInfo.track_progress);
+        m_progressInfo.current_track.reset();
+    }
+    m_pQueue->updateWorkerProgress(
+            this, m_progressInfo.track_progress, m_progressInfo.queue_size);
+    m_progressInfo.sema.release();
+}
@@ -0,0 +1,106 @@
+#ifndef ANALYZER_ANALYZERWORKER_H
+#define ANALYZER_ANALYZERWORKER_H
+
+#include <QThread>
+#include <QSemaphore>
+
+#include <vector>
+
+#include "analyzer/analyzerqueue.h"
+#include "preferences/usersettings.h"
+#include "sources/audiosource.h"
+#include "track/track.h"
+#include "util/db/dbconnectionpool.h"
+#include "util/samplebuffer.h"
+#include "util/memory.h"
+
+class Analyzer;
+class AnalyzerPipeline;
+class AnalysisDao;
+
+// A single analysis thread of an AnalyzerQueue. Each worker owns its
+// own set of analyzers, its own sample buffer and its own thread-local
+// database connection, so that multiple workers can analyze different
+// tracks concurrently without sharing any mutable state except for the
+// queue of pending tracks that is owned by the AnalyzerQueue.
+class AnalyzerWorker : public QThread {
+    Q_OBJECT
+
+  public:
+    AnalyzerWorker(
+            AnalyzerQueue* pQueue,
+            int workerIndex,
+            mixxx::DbConnectionPoolPtr pDbConnectionPool,
+            const UserSettingsPointer& pConfig,
+            AnalyzerQueue::Mode mode);
+    ~AnalyzerWorker() override;
+
+    int workerIndex() const {
+        return m_workerIndex;
+    }
+
+    bool hasAnalyzers() const {
+        return !m_pAnalyzers.empty();
+    }
+
+    // Unblocks a pending progress update. Must be called before
+    // waiting for the thread to finish.
+    void releaseProgress();
+
+    // Requests the worker to check if a track that has been loaded
+    // into a player is waiting and should be preferred.
+    void checkPriorities() {
+        m_aiCheckPriorities = true;
+    }
+
+    // Tries to load stored analysis results for pTrack. Returns true if
+    // the track still needs to be processed by at least one analyzer.
+    // This is called from the AnalyzerWorker thread
+    bool needsProcessing(TrackPointer pTrack) const;
+
+    // This is called from the AnalyzerWorker thread
+    void emitUpdateProgress(TrackPointer pTrack, int progress);
+
+  signals:
+    void updateProgress();
+
+  protected:
+    void run() override;
+
+  private slots:
+    void slotUpdateProgress();
+
+  private:
+    struct progress_info {
+        TrackPointer current_track;
+        int track_progress; // in 0.1 %
+        int queue_size;
+        QSemaphore sema;
+    };
+
+    void execThread();
+    bool doAnalysis(TrackPointer tio, mixxx::AudioSourcePointer pAudioSource);
+    void processBlock(SampleBuffer* pBlock);
+
+    AnalyzerQueue* const m_pQueue;
+    const int m_workerIndex;
+
+    mixxx::DbConnectionPoolPtr m_pDbConnectionPool;
+
+    std::unique_ptr<AnalysisDao> m_pAnalysisDao;
+
+    typedef std::unique_ptr<Analyzer> AnalyzerPtr;
+    std::vector<AnalyzerPtr> m_pAnalyzers;
+
+    QAtomicInt m_aiCheckPriorities;
+
+    SampleBuffer m_sampleBuffer;
+
+    // Only created if the analyzers process the decoded blocks
+    // concurrently on their own threads.
+    std::unique_ptr<AnalyzerPipeline> m_pPipeline;
+
+    struct progress_info m_progressInfo;
+};
+
+#endif /* ANALYZER_ANALYZERWORKER_H */
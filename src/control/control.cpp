@@ -1,8 +1,11 @@
 #include <QtDebug>
 #include <QSharedPointer>
 
+#include <new>
+
 #include "control/control.h"
 
+#include "util/compatibility.h"
 #include "util/stat.h"
 
 // Static member variable definition
@@ -16,10 +19,34 @@ GUARDED_BY(ControlDoublePrivate::s_qCOHashMutex);
 
 MMutex ControlDoublePrivate::s_qCOHashMutex;
 
+// Slots of the flat handle storage. Each chunk is allocated on a cache
+// line boundary and the slots are stored contiguously.
+struct ControlDoublePrivate::HandleChunk {
+    struct Slot {
+        // Written once before the slot is published
+        QWeakPointer<ControlDoublePrivate> control;
+        QAtomicInt published;
+    };
+    Slot slots[kHandleChunkSize];
+};
+
+QAtomicPointer<ControlDoublePrivate::HandleChunk>
+ControlDoublePrivate::s_handleChunks[ControlDoublePrivate::kMaxHandleChunks];
+
+int ControlDoublePrivate::s_nextHandle
+GUARDED_BY(ControlDoublePrivate::s_qCOHashMutex) = 0;
+
+namespace {
+
+const size_t kCacheLineSize = 64;
+
+} // anonymous namespace
+
 /*
 ControlDoublePrivate::ControlDoublePrivate()
         : m_bIgnoreNops(true),
           m_bTrack(false),
+          m_trackStatId(Stat::kInvalidId),
           m_trackType(Stat::UNSPECIFIED),
           m_trackFlags(Stat::COUNT | Stat::SUM | Stat::AVERAGE |
                        Stat::SAMPLE_VARIANCE | Stat::MIN | Stat::MAX),
@@ -36,6 +63,7 @@ ControlDoublePrivate::ControlDoublePrivate(ConfigKey key,
           m_bPersistInConfiguration(bPersist),
           m_bIgnoreNops(bIgnoreNops),
           m_bTrack(bTrack),
+          m_trackStatId(Stat::kInvalidId),
           m_trackType(Stat::UNSPECIFIED),
           m_trackFlags(Stat::COUNT | Stat::SUM | Stat::AVERAGE |
                        Stat::SAMPLE_VARIANCE | Stat::MIN | Stat::MAX),
@@ -55,12 +83,13 @@ void ControlDoublePrivate::initialize(double defaultValue) {
     m_defaultValue.setValue(defaultValue);
     m_value.setValue(value);
 
-    //qDebug() << "Creating:" << m_trackKey << "at" << &m_value << sizeof(m_value);
+    //qDebug() << "Creating:" << m_key << "at" << &m_value << sizeof(m_value);
 
     if (m_bTrack) {
         // TODO(rryan): Make configurable.
-        m_trackKey = "control " + m_key.group + "," + m_key.item;
-        Stat::track(m_trackKey, static_cast<Stat::StatType>(m_trackType),
+        m_trackStatId = Stat::registerTag(
+                "control " + m_key.group + "," + m_key.item);
+        Stat::track(m_trackStatId, static_cast<Stat::StatType>(m_trackType),
                     static_cast<Stat::ComputeFlags>(m_trackFlags),
                     m_value.getValue());
     }
@@ -139,6 +168,7 @@ QSharedPointer<ControlDoublePrivate> ControlDoublePrivate::getControl(
             MMutexLocker locker(&s_qCOHashMutex);
             //qDebug() << "ControlDoublePrivate::s_qCOHash.insert(" << key.group << "," << key.item << ")";
             s_qCOHash.insert(key, pControl);
+            registerHandle(pControl);
         } else if (warn) {
             qWarning() << "ControlDoublePrivate::getControl returning NULL for ("
                        << key.group << "," << key.item << ")";
@@ -147,6 +177,63 @@ QSharedPointer<ControlDoublePrivate> ControlDoublePrivate::getControl(
     return pControl;
 }
 
+// static
+void ControlDoublePrivate::registerHandle(
+        const QSharedPointer<ControlDoublePrivate>& pControl) {
+    DEBUG_ASSERT(!pControl->m_handle.valid());
+    if (s_nextHandle >= kHandleChunkSize * kMaxHandleChunks) {
+        qWarning() << "ControlDoublePrivate: Out of control handles for"
+                   << pControl->m_key.group << pControl->m_key.item;
+        return;
+    }
+    const int handle = s_nextHandle++;
+
+    const int chunkIndex = handle / kHandleChunkSize;
+    HandleChunk* pChunk = load_atomic_pointer(s_handleChunks[chunkIndex]);
+    if (pChunk == nullptr) {
+        void* pMemory = qMallocAligned(sizeof(HandleChunk), kCacheLineSize);
+        pChunk = new (pMemory) HandleChunk();
+        // Publish the initialized chunk to lock-free readers
+        s_handleChunks[chunkIndex].fetchAndStoreRelease(pChunk);
+    }
+    HandleChunk::Slot& slot = pChunk->slots[handle % kHandleChunkSize];
+    slot.control = pControl;
+    slot.published.fetchAndStoreRelease(1);
+    pControl->m_handle = ControlHandle(handle);
+}
+
+// static
+ControlHandle ControlDoublePrivate::getHandle(const ConfigKey& key, bool warn) {
+    QSharedPointer<ControlDoublePrivate> pControl = getControl(key, warn);
+    if (pControl) {
+        return pControl->handle();
+    }
+    return ControlHandle();
+}
+
+// static
+QSharedPointer<ControlDoublePrivate> ControlDoublePrivate::getControlByHandle(
+        ControlHandle handle) {
+    if (!handle.valid() ||
+            handle.handle() >= kHandleChunkSize * kMaxHandleChunks) {
+        return QSharedPointer<ControlDoublePrivate>();
+    }
+    HandleChunk* pChunk = load_atomic_pointer(
+            s_handleChunks[handle.handle() / kHandleChunkSize]);
+    if (pChunk == nullptr) {
+        return QSharedPointer<ControlDoublePrivate>();
+    }
+    const HandleChunk::Slot& slot =
+            pChunk->slots[handle.handle() % kHandleChunkSize];
+    if (!load_atomic_acquire(slot.published)) {
+        return QSharedPointer<ControlDoublePrivate>();
+    }
+    // The slot is never written again, so it is safe to read it while
+    // other threads do the same. The strong reference keeps the control
+    // alive while it is in use.
+    return slot.control.toStrongRef();
+}
+
 // static
 void ControlDoublePrivate::getControls(
         QList<QSharedPointer<ControlDoublePrivate> >* pControlList) {
@@ -201,7 +288,7 @@ void ControlDoublePrivate::setInner(double value, QObject* pSender) {
     emit(valueChanged(value, pSender));
 
     if (m_bTrack) {
-        Stat::track(m_trackKey, static_cast<Stat::StatType>(m_trackType),
+        Stat::track(m_trackStatId, static_cast<Stat::StatType>(m_trackType),
                     static_cast<Stat::ComputeFlags>(m_trackFlags), value);
     }
 }
@@ -7,9 +7,11 @@
 #include <QAtomicPointer>
 
 #include "control/controlbehavior.h"
+#include "control/controlhandle.h"
 #include "control/controlvalue.h"
 #include "preferences/usersettings.h"
 #include "util/mutex.h"
+#include "util/stat.h"
 
 class ControlObject;
 
@@ -38,6 +40,17 @@ class ControlDoublePrivate : public QObject {
             ControlObject* pCreatorCO = NULL, bool bIgnoreNops = true, bool bTrack = false,
             bool bPersist = false, double defaultValue = 0.0);
 
+    // Resolves the ConfigKey to the handle of the control. The lookup
+    // is expensive and should only be done once per key, e.g. with a
+    // ControlHandleResolver.
+    static ControlHandle getHandle(const ConfigKey& key, bool warn = true);
+
+    // Returns the ControlDoublePrivate that is registered for handle or
+    // NULL if it has been deleted. Lock-free and safe to call from the
+    // engine thread.
+    static QSharedPointer<ControlDoublePrivate> getControlByHandle(
+            ControlHandle handle);
+
     // Adds all ControlDoublePrivate that currently exist to pControlList
     static void getControls(QList<QSharedPointer<ControlDoublePrivate> >* pControlsList);
 
@@ -109,6 +122,10 @@ class ControlDoublePrivate : public QObject {
         return m_key;
     }
 
+    inline ControlHandle handle() const {
+        return m_handle;
+    }
+
     // Connects a slot to the ValueChange request for CO validation. All change
     // requests issued by set are routed though the connected slot. This can
     // decide with its own thread safe solution if the requested value can be
@@ -131,7 +148,13 @@ class ControlDoublePrivate : public QObject {
     void initialize(double defaultValue);
     void setInner(double value, QObject* pSender);
 
+    // Registers the control in the flat handle storage.
+    // Requires s_qCOHashMutex to be locked.
+    static void registerHandle(
+            const QSharedPointer<ControlDoublePrivate>& pControl);
+
     ConfigKey m_key;
+    ControlHandle m_handle;
 
     // Whether the control should persist in the Mixxx user configuration. The
     // value is loaded from configuration when the control is created and
@@ -149,7 +172,7 @@ class ControlDoublePrivate : public QObject {
 
     // Whether to track value changes with the stats framework.
     bool m_bTrack;
-    QString m_trackKey;
+    Stat::Id m_trackStatId;
     int m_trackType;
     int m_trackFlags;
     bool m_confirmRequired;
@@ -177,7 +200,20 @@ class ControlDoublePrivate : public QObject {
     // alias associated with a key.
     static QHash<ConfigKey, ConfigKey> s_qCOAliasHash;
 
-    // Mutex guarding access to s_qCOHash and s_qCOAliasHash.
+    // Flat storage of all registered controls indexed by ControlHandle.
+    // The storage is split into chunks that are allocated on demand and
+    // never moved or freed, so that it can be read without locking. Each
+    // slot is written once when its handle is assigned and expires with
+    // its control, since handles are never reused.
+    static const int kHandleChunkSize = 1024;
+    static const int kMaxHandleChunks = 4096;
+    struct HandleChunk;
+    static QAtomicPointer<HandleChunk> s_handleChunks[kMaxHandleChunks];
+    // The next handle that has never been assigned.
+    static int s_nextHandle;
+
+    // Mutex guarding access to s_qCOHash, s_qCOAliasHash and the
+    // modification of the handle storage.
     static MMutex s_qCOHashMutex;
 };
 
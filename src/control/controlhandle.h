@@ -0,0 +1,56 @@
+#ifndef CONTROL_CONTROLHANDLE_H
+#define CONTROL_CONTROLHANDLE_H
+// ControlHandle is a dense integer identifier for a control. Looking up a
+// control by its ConfigKey requires hashing two strings and locking the
+// global control mutex. Clients that access the same control repeatedly
+// (controller mappings, skins, scripts) can resolve the ConfigKey to a
+// ControlHandle once and then use the handle to access the control through
+// a flat array without hashing or locking, see ControlHandleResolver.
+//
+// Handles are assigned when a control is registered and are never reused,
+// so the handle of a deleted control never resolves to another control.
+
+#include <QtDebug>
+#include <QHash>
+
+class ControlHandle {
+  public:
+    ControlHandle() : m_iHandle(-1) {
+    }
+
+    // For handles that have been passed around as integers, e.g. by
+    // controller scripts.
+    explicit ControlHandle(int iHandle)
+            : m_iHandle(iHandle) {
+    }
+
+    inline bool valid() const {
+        return m_iHandle >= 0;
+    }
+
+    inline int handle() const {
+        return m_iHandle;
+    }
+
+  private:
+    int m_iHandle;
+};
+
+inline bool operator==(const ControlHandle& h1, const ControlHandle& h2) {
+    return h1.handle() == h2.handle();
+}
+
+inline bool operator!=(const ControlHandle& h1, const ControlHandle& h2) {
+    return h1.handle() != h2.handle();
+}
+
+inline QDebug operator<<(QDebug stream, const ControlHandle& h) {
+    stream << "ControlHandle(" << h.handle() << ")";
+    return stream;
+}
+
+inline uint qHash(const ControlHandle& handle) {
+    return qHash(handle.handle());
+}
+
+#endif /* CONTROL_CONTROLHANDLE_H */
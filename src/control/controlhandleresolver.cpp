@@ -0,0 +1,20 @@
+#include "control/controlhandleresolver.h"
+
+#include "control/control.h"
+
+ControlHandle ControlHandleResolver::resolve(const ConfigKey& key, bool warn) {
+    QHash<ConfigKey, ControlHandle>::const_iterator it = m_handles.constFind(key);
+    if (it != m_handles.constEnd() &&
+            ControlDoublePrivate::getControlByHandle(it.value())) {
+        return it.value();
+    }
+    // Not resolved yet or the control has been deleted and may have been
+    // created again with a new handle.
+    const ControlHandle handle = ControlDoublePrivate::getHandle(key, warn);
+    if (handle.valid()) {
+        m_handles.insert(key, handle);
+    } else {
+        m_handles.remove(key);
+    }
+    return handle;
+}
@@ -0,0 +1,26 @@
+#ifndef CONTROL_CONTROLHANDLERESOLVER_H
+#define CONTROL_CONTROLHANDLERESOLVER_H
+
+#include <QHash>
+
+#include "control/controlhandle.h"
+#include "preferences/configobject.h"
+
+// Resolves the ConfigKeys of a controller mapping or skin to ControlHandles
+// once and remembers them, so that further lookups of the same key don't
+// lock the global control registry. Keys of controls that don't exist yet
+// are not remembered. Not thread-safe, every mapping or skin owns its own
+// resolver.
+class ControlHandleResolver {
+  public:
+    ControlHandle resolve(const ConfigKey& key, bool warn = true);
+
+    void clear() {
+        m_handles.clear();
+    }
+
+  private:
+    QHash<ConfigKey, ControlHandle> m_handles;
+};
+
+#endif /* CONTROL_CONTROLHANDLERESOLVER_H */
@@ -78,6 +78,16 @@ ControlObject* ControlObject::getControl(const ConfigKey& key, bool warn) {
     return NULL;
 }
 
+// static
+ControlObject* ControlObject::getControl(ControlHandle handle) {
+    QSharedPointer<ControlDoublePrivate> pCDP =
+            ControlDoublePrivate::getControlByHandle(handle);
+    if (pCDP) {
+        return pCDP->getCreatorCO();
+    }
+    return NULL;
+}
+
 void ControlObject::setValueFromMidi(MidiOpCode o, double v) {
     if (m_pControl) {
         m_pControl->setMidiParameter(o, v);
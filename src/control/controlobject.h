@@ -51,6 +51,9 @@ class ControlObject : public QObject {
         ConfigKey key(group, item);
         return getControl(key, warn);
     }
+    // Returns a pointer to the ControlObject registered for handle without
+    // hashing or locking.
+    static ControlObject* getControl(ControlHandle handle);
 
     QString name() const {
         return m_pControl ?  m_pControl->name() : QString();
@@ -77,6 +80,10 @@ class ControlObject : public QObject {
         return m_key;
     }
 
+    inline ControlHandle handle() const {
+        return m_pControl ? m_pControl->handle() : ControlHandle();
+    }
+
     // Returns the value of the ControlObject
     inline double get() const {
         return m_pControl ? m_pControl->get() : 0.0;
@@ -42,6 +42,10 @@ class ControlProxy : public QObject {
 
     inline bool valid() const { return m_pControl != NULL; }
 
+    inline ControlHandle handle() const {
+        return m_pControl ? m_pControl->handle() : ControlHandle();
+    }
+
     // Returns the value of the object. Thread safe, non-blocking.
     inline double get() const {
         return m_pControl ? m_pControl->get() : 0.0;
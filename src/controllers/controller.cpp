@@ -12,6 +12,7 @@
 #include "controllers/controllerdebug.h"
 #include "controllers/defs_controllers.h"
 #include "util/screensaver.h"
+#include "util/timer.h"
 
 Controller::Controller()
         : QObject(),
@@ -19,7 +20,8 @@ Controller::Controller()
           m_bIsOutputDevice(false),
           m_bIsInputDevice(false),
           m_bIsOpen(false),
-          m_bLearning(false) {
+          m_bLearning(false),
+          m_inputLatencyStatId(Stat::kInvalidId) {
         m_userActivityInhibitTimer.start();
 }
 
@@ -36,6 +38,9 @@ void Controller::startEngine()
         stopEngine();
     }
     m_pEngine = new ControllerEngine(this);
+    // The device name is known by now
+    m_inputLatencyStatId = Stat::registerTag(
+            QString("Controller %1 input latency").arg(m_sDeviceName));
 }
 
 void Controller::stopEngine() {
@@ -105,6 +110,15 @@ void Controller::triggerActivity()
         m_userActivityInhibitTimer.start();
     }
 }
+void Controller::reportInputLatency(mixxx::Duration latency) {
+    if (m_inputLatencyStatId == Stat::kInvalidId) {
+        return;
+    }
+    Stat::track(m_inputLatencyStatId, Stat::DURATION_MSEC,
+            Stat::experimentFlags(kDefaultComputeFlags | Stat::HISTOGRAM),
+            latency.toIntegerMicros() / 1000.0);
+}
+
 void Controller::receive(const QByteArray data, mixxx::Duration timestamp) {
 
     if (m_pEngine == NULL) {
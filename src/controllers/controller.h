@@ -19,6 +19,7 @@
 #include "controllers/controllerpresetvisitor.h"
 #include "controllers/controllerpresetfilehandler.h"
 #include "util/duration.h"
+#include "util/stat.h"
 
 class Controller : public QObject, ConstControllerPresetVisitor {
     Q_OBJECT
@@ -105,6 +106,10 @@ class Controller : public QObject, ConstControllerPresetVisitor {
     // To be called when receiving events
     void triggerActivity();
 
+    // Reports the time from the arrival of an input event until it has been
+    // processed to the StatsManager, as a histogram per controller.
+    void reportInputLatency(mixxx::Duration latency);
+
     inline ControllerEngine* getEngine() const {
         return m_pEngine;
     }
@@ -138,6 +143,12 @@ class Controller : public QObject, ConstControllerPresetVisitor {
         return false;
     }
 
+    // Limits the number of messages per second that the device sends for
+    // its static output mappings, 0 for no limit.
+    virtual void setOutputRateLimit(int messagesPerSecond) {
+        Q_UNUSED(messagesPerSecond);
+    }
+
   private:
     // This must be reimplemented by sub-classes desiring to send raw bytes to a
     // controller.
@@ -161,6 +172,7 @@ class Controller : public QObject, ConstControllerPresetVisitor {
     bool m_bIsOpen;
     bool m_bLearning;
     QTime m_userActivityInhibitTimer;
+    Stat::Id m_inputLatencyStatId;
 
     // accesses lots of our stuff, but in the same thread
     friend class ControllerManager;
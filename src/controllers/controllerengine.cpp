@@ -16,6 +16,7 @@
 #include "mixer/playermanager.h"
 // to tell the msvs compiler about `isnan`
 #include "util/math.h"
+#include "util/performancetimer.h"
 #include "util/time.h"
 
 // Used for id's inside controlConnection objects
@@ -24,16 +25,33 @@
 
 const int kDecks = 16;
 
-// Use 1ms for the Alpha-Beta dt. We're assuming the OS actually gives us a 1ms
-// timer.
+// Use 1ms for the Alpha-Beta dt. The timer wheel keeps the deadlines of the
+// scratch timers 1ms apart, even if the OS wakes us up late.
 const int kScratchTimerMs = 1;
 const double kAlphaBetaDt = kScratchTimerMs / 1000.0;
 
+// Earlier versions raised shorter script timer intervals to this minimum
+const int kLegacyMinTimerMs = 20;
+
 ControllerEngine::ControllerEngine(Controller* controller)
         : m_pEngine(nullptr),
           m_pController(controller),
           m_bPopups(false),
+          m_bShortTimerWarned(false),
+          m_timerWheelTimer(this),
           m_pBaClass(nullptr) {
+    if (ControllerScriptProfiler::enabled()) {
+        m_pProfiler.reset(new ControllerScriptProfiler());
+    }
+
+    m_timerWheelTimer.setSingleShot(true);
+#if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
+    // Coarse timers may be off by 5% of their interval.
+    m_timerWheelTimer.setTimerType(Qt::PreciseTimer);
+#endif
+    connect(&m_timerWheelTimer, SIGNAL(timeout()),
+            this, SLOT(slotTimerWheelTimeout()));
+
     // Handle error dialog buttons
     qRegisterMetaType<QMessageBox::StandardButton>("QMessageBox::StandardButton");
 
@@ -95,7 +113,14 @@ void ControllerEngine::callFunctionOnObjects(QList<QString> scriptFunctionPrefix
             continue;
         }
         controllerDebug("ControllerEngine: Executing" << prefixName << "." << function);
+        PerformanceTimer timer;
+        if (m_pProfiler) {
+            timer.start();
+        }
         init.call(prefix, args);
+        if (m_pProfiler) {
+            m_pProfiler->record(prefixName + "." + function, timer.elapsed());
+        }
     }
 }
 
@@ -129,6 +154,9 @@ QScriptValue ControllerEngine::wrapFunctionCode(const QString& codeSnippet,
         wrappedFunction = m_pEngine->evaluate(wrappedCode);
         checkException();
         m_scriptWrappedFunctionCache[codeSnippet] = wrappedFunction;
+        if (m_pProfiler) {
+            m_wrappedFunctionNames[wrappedFunction.objectId()] = codeSnippet;
+        }
     }
     return wrappedFunction;
 }
@@ -158,6 +186,11 @@ void ControllerEngine::gracefulShutdown() {
     // Call each script's shutdown function if it exists
     callFunctionOnObjects(m_scriptFunctionPrefixes, "shutdown");
 
+    if (m_pProfiler) {
+        dumpProfile();
+        m_pProfiler->reset();
+    }
+
     // Prevents leaving decks in an unstable state
     //  if the controller is shut down while scratching
     QHashIterator<int, int> i(m_scratchTimers);
@@ -175,8 +208,10 @@ void ControllerEngine::gracefulShutdown() {
 
     // Clear the cache of function wrappers
     m_scriptWrappedFunctionCache.clear();
+    m_wrappedFunctionNames.clear();
 
     // Free all the ControlObjectScripts
+    m_controlsByHandle.clear();
     QList<ConfigKey> keys = m_controlCache.keys();
     QList<ConfigKey>::iterator it = keys.begin();
     QList<ConfigKey>::iterator end = keys.end();
@@ -348,7 +383,8 @@ Input:   'this' object if applicable, Code string
 Output:  false if an exception
 -------- ------------------------------------------------------ */
 bool ControllerEngine::internalExecute(QScriptValue thisObject,
-                                       const QString& scriptCode) {
+                                       const QString& scriptCode,
+                                       const QString& profileName) {
     // A special version of safeExecute since we're evaluating strings, not actual functions
     //  (execute() would print an error that it's not a function every time a timer fires.)
     if (m_pEngine == nullptr) {
@@ -371,7 +407,8 @@ bool ControllerEngine::internalExecute(QScriptValue thisObject,
         return false;
     }
 
-    return internalExecute(thisObject, scriptFunction, QScriptValueList());
+    return internalExecute(thisObject, scriptFunction, QScriptValueList(),
+                           profileName);
 }
 
 /* -------- ------------------------------------------------------
@@ -380,7 +417,8 @@ Input:   'this' object if applicable, Code string
 Output:  false if an exception
 -------- ------------------------------------------------------ */
 bool ControllerEngine::internalExecute(QScriptValue thisObject, QScriptValue functionObject,
-                                       QScriptValueList args) {
+                                       QScriptValueList args,
+                                       const QString& profileName) {
     if (m_pEngine == nullptr) {
         qDebug() << "ControllerEngine::execute: No script engine exists!";
         return false;
@@ -401,7 +439,16 @@ bool ControllerEngine::internalExecute(QScriptValue thisObject, QScriptValue fun
     }
 
     // If it does happen to be a function, call it.
+    PerformanceTimer timer;
+    if (m_pProfiler) {
+        timer.start();
+    }
     QScriptValue rc = functionObject.call(thisObject, args);
+    if (m_pProfiler) {
+        m_pProfiler->record(
+                profileName.isNull() ? this->profileName(functionObject) : profileName,
+                timer.elapsed());
+    }
     if (!rc.isValid()) {
         qDebug() << "QScriptValue is not a function or ...";
         return false;
@@ -410,6 +457,48 @@ bool ControllerEngine::internalExecute(QScriptValue thisObject, QScriptValue fun
     return !checkException();
 }
 
+QString ControllerEngine::profileName(const QScriptValue& function) const {
+    QHash<qint64, QString>::const_iterator it =
+            m_wrappedFunctionNames.find(function.objectId());
+    if (it != m_wrappedFunctionNames.end()) {
+        return it.value();
+    }
+    const QString name = function.property("name").toString();
+    if (name.isEmpty()) {
+        return QString("(anonymous function)");
+    }
+    return name;
+}
+
+QString ControllerEngine::callerLocation() const {
+    // The context of the native function is the current one
+    QScriptContext* pContext = m_pEngine->currentContext();
+    if (pContext == nullptr || pContext->parentContext() == nullptr) {
+        return QString();
+    }
+    QScriptContextInfo caller(pContext->parentContext());
+    if (caller.fileName().isEmpty()) {
+        return QString();
+    }
+    return QString("%1:%2").arg(caller.fileName(),
+                                QString::number(caller.lineNumber()));
+}
+
+void ControllerEngine::dumpProfile() {
+    if (!m_pProfiler) {
+        qWarning() << "ControllerEngine: Start Mixxx with --controllerProfile"
+                   << "to profile controller scripts";
+        return;
+    }
+    // Printed regardless of the log level, like controllerDebug()
+    const QString name = m_pController ? m_pController->getName() : QString();
+    QDebug(QtDebugMsg) << ControllerDebug::kLogMessagePrefix
+                       << "Profile of the controller script of" << name;
+    for (const QString& line : m_pProfiler->report()) {
+        QDebug(QtDebugMsg) << ControllerDebug::kLogMessagePrefix << line;
+    }
+}
+
 bool ControllerEngine::execute(QScriptValue functionObject,
                                unsigned char channel,
                                unsigned char control,
@@ -541,6 +630,7 @@ ControlObjectScript* ControllerEngine::getControlObjectScript(const QString& gro
         coScript = new ControlObjectScript(key, this);
         if (coScript->valid()) {
             m_controlCache.insert(key, coScript);
+            m_controlsByHandle.insert(coScript->handle(), coScript);
         } else {
             delete coScript;
             coScript = nullptr;
@@ -549,6 +639,39 @@ ControlObjectScript* ControllerEngine::getControlObjectScript(const QString& gro
     return coScript;
 }
 
+ControlObjectScript* ControllerEngine::getControlObjectScript(
+        ControlHandle handle) {
+    ControlObjectScript* coScript = m_controlsByHandle.value(handle, nullptr);
+    if (coScript == nullptr) {
+        // Handles are never reused, so a handle that scripts got from
+        // another engine or that belongs to a deleted control can't
+        // resolve to the wrong control.
+        QSharedPointer<ControlDoublePrivate> pControl =
+                ControlDoublePrivate::getControlByHandle(handle);
+        if (pControl) {
+            coScript = getControlObjectScript(pControl->getKey().group,
+                                              pControl->getKey().item);
+        }
+    }
+    return coScript;
+}
+
+void ControllerEngine::setControlValue(ControlObjectScript* coScript,
+                                       double newValue) {
+    ControlObject* pControl = ControlObject::getControl(coScript->handle());
+    if (pControl && !m_st.ignore(pControl, coScript->getParameterForValue(newValue))) {
+        coScript->slotSet(newValue);
+    }
+}
+
+void ControllerEngine::setControlParameter(ControlObjectScript* coScript,
+                                           double newParameter) {
+    ControlObject* pControl = ControlObject::getControl(coScript->handle());
+    if (pControl && !m_st.ignore(pControl, newParameter)) {
+        coScript->setParameter(newParameter);
+    }
+}
+
 /* -------- ------------------------------------------------------
    Purpose: Returns the current value of a Mixxx control (for scripts)
    Input:   Control group (e.g. [Channel1]), Key name (e.g. [filterHigh])
@@ -578,10 +701,7 @@ void ControllerEngine::setValue(QString group, QString name, double newValue) {
     ControlObjectScript* coScript = getControlObjectScript(group, name);
 
     if (coScript != nullptr) {
-        ControlObject* pControl = ControlObject::getControl(coScript->getKey());
-        if (pControl && !m_st.ignore(pControl, coScript->getParameterForValue(newValue))) {
-            coScript->slotSet(newValue);
-        }
+        setControlValue(coScript, newValue);
     }
 }
 
@@ -615,10 +735,7 @@ void ControllerEngine::setParameter(QString group, QString name, double newParam
     ControlObjectScript* coScript = getControlObjectScript(group, name);
 
     if (coScript != nullptr) {
-        ControlObject* pControl = ControlObject::getControl(coScript->getKey());
-        if (pControl && !m_st.ignore(pControl, newParameter)) {
-          coScript->setParameter(newParameter);
-        }
+        setControlParameter(coScript, newParameter);
     }
 }
 
@@ -688,6 +805,62 @@ double ControllerEngine::getDefaultParameter(QString group, QString name) {
     return coScript->getParameterForValue(coScript->getDefault());
 }
 
+/* -------- ------------------------------------------------------
+   Purpose: Resolves a Mixxx control to a handle (for scripts)
+   Input:   Control group, Key name
+   Output:  The handle, -1 if the control doesn't exist
+   -------- ------------------------------------------------------ */
+int ControllerEngine::getControlHandle(QString group, QString name) {
+    ControlObjectScript* coScript = getControlObjectScript(group, name);
+    if (coScript == nullptr) {
+        qWarning() << "ControllerEngine: Unknown control" << group << name << ", returning -1";
+        return -1;
+    }
+    return coScript->handle().handle();
+}
+
+double ControllerEngine::getValueByHandle(int handle) {
+    ControlObjectScript* coScript = getControlObjectScript(ControlHandle(handle));
+    if (coScript == nullptr) {
+        qWarning() << "ControllerEngine: Unknown control handle" << handle << ", returning 0.0";
+        return 0.0;
+    }
+    return coScript->get();
+}
+
+void ControllerEngine::setValueByHandle(int handle, double newValue) {
+    if (isnan(newValue)) {
+        qWarning() << "ControllerEngine: script setting control handle" << handle
+                 << "to NotANumber, ignoring.";
+        return;
+    }
+    ControlObjectScript* coScript = getControlObjectScript(ControlHandle(handle));
+    if (coScript != nullptr) {
+        setControlValue(coScript, newValue);
+    }
+}
+
+double ControllerEngine::getParameterByHandle(int handle) {
+    ControlObjectScript* coScript = getControlObjectScript(ControlHandle(handle));
+    if (coScript == nullptr) {
+        qWarning() << "ControllerEngine: Unknown control handle" << handle << ", returning 0.0";
+        return 0.0;
+    }
+    return coScript->getParameter();
+}
+
+void ControllerEngine::setParameterByHandle(int handle, double newParameter) {
+    if (isnan(newParameter)) {
+        qWarning() << "ControllerEngine: script setting control handle" << handle
+                 << "to NotANumber, ignoring.";
+        return;
+    }
+    ControlObjectScript* coScript = getControlObjectScript(ControlHandle(handle));
+    if (coScript != nullptr) {
+        setControlParameter(coScript, newParameter);
+    }
+}
+
 /* -------- ------------------------------------------------------
    Purpose: qDebugs script output so it ends up in mixxx.log
    Input:   String to log
@@ -730,6 +903,14 @@ QScriptValue ControllerEngine::makeConnection(QString group, QString name,
     connection.callback = callback;
     connection.context = getThisObjectInFunctionCall();
     connection.id = QUuid::createUuid();
+    if (m_pProfiler) {
+        QString location = callerLocation();
+        if (location.isEmpty()) {
+            location = profileName(callback);
+        }
+        connection.profileName = QString("connection %1,%2 (%3)")
+                .arg(group, name, location);
+    }
 
     if (coScript->addScriptConnection(connection)) {
         return m_pEngine->newQObject(
@@ -750,7 +931,15 @@ void ScriptConnection::executeCallback(double value) const {
     args << QScriptValue(key.group);
     args << QScriptValue(key.item);
     QScriptValue func = callback; // copy function because QScriptValue::call is not const
+    ControllerScriptProfiler* pProfiler = controllerEngine->profiler();
+    PerformanceTimer timer;
+    if (pProfiler) {
+        timer.start();
+    }
     QScriptValue result = func.call(context, args);
+    if (pProfiler) {
+        pProfiler->record(profileName, timer.elapsed());
+    }
     if (result.isError()) {
         qWarning() << "ControllerEngine: Invocation of connection " << id.toString()
                    << "connected to (" + key.group + ", " + key.item + ") failed:"
@@ -1047,24 +1236,38 @@ int ControllerEngine::beginTimer(int interval, QScriptValue timerCallback,
         return 0;
     }
 
-    if (interval < 20) {
+    if (interval < 1) {
         qWarning() << "Timer request for" << interval
-                   << "ms is too short. Setting to the minimum of 20ms.";
-        interval = 20;
-    }
-
-    // This makes use of every QObject's internal timer mechanism. Nice, clean,
-    // and simple. See http://doc.trolltech.com/4.6/qobject.html#startTimer for
-    // details
-    int timerId = startTimer(interval);
+                   << "ms is too short. Setting to the minimum of 1ms.";
+        interval = 1;
+    }
+    if (interval < kLegacyMinTimerMs && !m_bShortTimerWarned) {
+        // Mappings that were made for earlier versions may rely on it
+        m_bShortTimerWarned = true;
+        const QString location = callerLocation();
+        qWarning() << "Timer request for" << interval << "ms"
+                   << (location.isEmpty() ? QString() : "at " + location)
+                   << "is shorter than the minimum of" << kLegacyMinTimerMs
+                   << "ms of earlier versions."
+                   << "The timer fires more often than it used to.";
+    }
+
+    int timerId = startWheelTimer(mixxx::Duration::fromMillis(interval),
+                                  oneShot);
     TimerInfo info;
     info.callback = timerCallback;
     info.context = getThisObjectInFunctionCall();
     info.oneShot = oneShot;
+    if (m_pProfiler) {
+        QString location = callerLocation();
+        if (location.isEmpty()) {
+            location = timerCallback.isString() ?
+                    timerCallback.toString() : profileName(timerCallback);
+        }
+        info.profileName = QString("timer (%1)").arg(location);
+    }
     m_timers[timerId] = info;
-    if (timerId == 0) {
-        qWarning() << "Script timer could not be created";
-    } else if (oneShot) {
+    if (oneShot) {
         controllerDebug("Starting one-shot timer:" << timerId);
     } else {
         controllerDebug("Starting timer:" << timerId);
@@ -1083,7 +1286,7 @@ void ControllerEngine::stopTimer(int timerId) {
         return;
     }
     controllerDebug("Killing timer:" << timerId);
-    killTimer(timerId);
+    stopWheelTimer(timerId);
     m_timers.remove(timerId);
 }
 
@@ -1095,36 +1298,67 @@ void ControllerEngine::stopAllTimers() {
     }
 }
 
-void ControllerEngine::timerEvent(QTimerEvent *event) {
-    int timerId = event->timerId();
+int ControllerEngine::startWheelTimer(mixxx::Duration interval, bool oneShot) {
+    int timerId = m_timerWheel.start(interval, oneShot, mixxx::Time::elapsed());
+    scheduleTimerWheel();
+    return timerId;
+}
 
-    // See if this is a scratching timer
-    if (m_scratchTimers.contains(timerId)) {
-        scratchProcess(timerId);
-        return;
+void ControllerEngine::stopWheelTimer(int timerId) {
+    m_timerWheel.stop(timerId);
+    if (m_timerWheel.isEmpty()) {
+        m_timerWheelTimer.stop();
     }
+}
 
-    QHash<int, TimerInfo>::const_iterator it = m_timers.find(timerId);
-    if (it == m_timers.end()) {
-        qWarning() << "Timer" << timerId << "fired but there's no function mapped to it!";
+void ControllerEngine::scheduleTimerWheel() {
+    if (m_timerWheel.isEmpty()) {
+        m_timerWheelTimer.stop();
         return;
     }
+    // QTimer only has millisecond resolution. Round up so that we don't
+    // wake up before the deadline, and catch up with the ticks in between
+    // when we do.
+    const qint64 remainingMicros = (m_timerWheel.nextDeadline() -
+            mixxx::Time::elapsed()).toIntegerMicros();
+    const int remainingMillis = static_cast<int>(
+            qMax(remainingMicros + 999, static_cast<qint64>(0)) / 1000);
+    m_timerWheelTimer.start(remainingMillis);
+}
 
-    // NOTE(rryan): Do not assign by reference -- make a copy. I have no idea
-    // why but this causes segfaults in ~QScriptValue while scratching if we
-    // don't copy here -- even though internalExecute passes the QScriptValues
-    // by value. *boggle*
-    const TimerInfo timerTarget = it.value();
-    if (timerTarget.oneShot) {
-        stopTimer(timerId);
-    }
+void ControllerEngine::slotTimerWheelTimeout() {
+    const QVector<int> expired = m_timerWheel.takeExpired(mixxx::Time::elapsed());
+    for (int timerId : expired) {
+        // See if this is a scratching timer
+        if (m_scratchTimers.contains(timerId)) {
+            scratchProcess(timerId);
+            continue;
+        }
 
-    if (timerTarget.callback.isString()) {
-        internalExecute(timerTarget.context, timerTarget.callback.toString());
-    } else if (timerTarget.callback.isFunction()) {
-        internalExecute(timerTarget.context, timerTarget.callback,
-                        QScriptValueList());
+        // A timer that has fired before in this round may have stopped it.
+        QHash<int, TimerInfo>::const_iterator it = m_timers.find(timerId);
+        if (it == m_timers.end()) {
+            continue;
+        }
+
+        // NOTE(rryan): Do not assign by reference -- make a copy. I have no idea
+        // why but this causes segfaults in ~QScriptValue while scratching if we
+        // don't copy here -- even though internalExecute passes the QScriptValues
+        // by value. *boggle*
+        const TimerInfo timerTarget = it.value();
+        if (timerTarget.oneShot) {
+            stopTimer(timerId);
+        }
+
+        if (timerTarget.callback.isString()) {
+            internalExecute(timerTarget.context, timerTarget.callback.toString(),
+                            timerTarget.profileName);
+        } else if (timerTarget.callback.isFunction()) {
+            internalExecute(timerTarget.context, timerTarget.callback,
+                            QScriptValueList(), timerTarget.profileName);
+        }
     }
+    scheduleTimerWheel();
 }
 
 double ControllerEngine::getDeckRate(const QString& group) {
@@ -1181,7 +1415,7 @@ void ControllerEngine::scratchEnable(int deck, int intervalsPerRev, double rpm,
     if (m_dx[deck]) {
         //qDebug() << "Already scratching deck" << deck << ". Overriding.";
         int timerId = m_scratchTimers.key(deck);
-        killTimer(timerId);
+        stopWheelTimer(timerId);
         m_scratchTimers.remove(timerId);
     }
 
@@ -1234,8 +1468,8 @@ void ControllerEngine::scratchEnable(int deck, int intervalsPerRev, double rpm,
         m_scratchFilters[deck]->init(kAlphaBetaDt, initVelocity);
     }
 
-    // 1ms is shortest possible, OS dependent
-    int timerId = startTimer(kScratchTimerMs);
+    int timerId = startWheelTimer(
+            mixxx::Duration::fromMillis(kScratchTimerMs), false);
 
     // Associate this virtual deck with this timer for later processing
     m_scratchTimers[timerId] = deck;
@@ -1331,7 +1565,7 @@ void ControllerEngine::scratchProcess(int timerId) {
         pScratch2Enable->slotSet(0);
 
         // Remove timer
-        killTimer(timerId);
+        stopWheelTimer(timerId);
         m_scratchTimers.remove(timerId);
 
         m_dx[deck] = 0.0;
@@ -1441,7 +1675,7 @@ void ControllerEngine::brake(int deck, bool activate, double factor, double rate
 
     // kill timer when both enabling or disabling
     int timerId = m_scratchTimers.key(deck);
-    killTimer(timerId);
+    stopWheelTimer(timerId);
     m_scratchTimers.remove(timerId);
 
     // enable/disable scratch2 mode
@@ -1471,7 +1705,8 @@ void ControllerEngine::brake(int deck, bool activate, double factor, double rate
         }
 
         // setup timer and set scratch2
-        timerId = startTimer(kScratchTimerMs);
+        timerId = startWheelTimer(
+                mixxx::Duration::fromMillis(kScratchTimerMs), false);
         m_scratchTimers[timerId] = deck;
 
         ControlObjectScript* pScratch2 = getControlObjectScript(group, "scratch2");
@@ -1508,7 +1743,7 @@ void ControllerEngine::softStart(int deck, bool activate, double factor, double
 
     // kill timer when both enabling or disabling
     int timerId = m_scratchTimers.key(deck);
-    killTimer(timerId);
+    stopWheelTimer(timerId);
     m_scratchTimers.remove(timerId);
 
     // enable/disable scratch2 mode
@@ -1540,7 +1775,8 @@ void ControllerEngine::softStart(int deck, bool activate, double factor, double
         }
 
         // setup timer, start playing and set scratch2
-        timerId = startTimer(kScratchTimerMs);
+        timerId = startWheelTimer(
+                mixxx::Duration::fromMillis(kScratchTimerMs), false);
         m_scratchTimers[timerId] = deck;
 
         ControlObjectScript* pPlay = getControlObjectScript(group, "play");
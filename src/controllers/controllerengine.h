@@ -8,14 +8,17 @@
 #ifndef CONTROLLERENGINE_H
 #define CONTROLLERENGINE_H
 
-#include <QTimerEvent>
 #include <QFileSystemWatcher>
 #include <QMessageBox>
+#include <QTimer>
 #include <QtScript>
 
 #include "bytearrayclass.h"
+#include "control/controlhandle.h"
 #include "preferences/usersettings.h"
 #include "controllers/controllerpreset.h"
+#include "controllers/controllerscriptprofiler.h"
+#include "controllers/controllertimerwheel.h"
 #include "controllers/softtakeover.h"
 #include "util/alphabetafilter.h"
 #include "util/duration.h"
@@ -35,6 +38,8 @@ class ScriptConnection {
     QScriptValue callback;
     ControllerEngine *controllerEngine;
     QScriptValue context;
+    // Only set while profiling
+    QString profileName;
 
     void executeCallback(double value) const;
 
@@ -100,6 +105,11 @@ class ControllerEngine : public QObject {
     void removeScriptConnection(const ScriptConnection conn);
     void triggerScriptConnection(const ScriptConnection conn);
 
+    // Returns nullptr unless profiling is enabled.
+    ControllerScriptProfiler* profiler() const {
+        return m_pProfiler.data();
+    }
+
   protected:
     Q_INVOKABLE double getValue(QString group, QString name);
     Q_INVOKABLE void setValue(QString group, QString name, double newValue);
@@ -109,6 +119,15 @@ class ControllerEngine : public QObject {
     Q_INVOKABLE void reset(QString group, QString name);
     Q_INVOKABLE double getDefaultValue(QString group, QString name);
     Q_INVOKABLE double getDefaultParameter(QString group, QString name);
+    // Scripts that access a control often can resolve it to a handle once,
+    // e.g. in init(), and pass the handle instead of the group and name to
+    // avoid looking up the control by its name on every call. Returns -1
+    // if the control doesn't exist.
+    Q_INVOKABLE int getControlHandle(QString group, QString name);
+    Q_INVOKABLE double getValueByHandle(int handle);
+    Q_INVOKABLE void setValueByHandle(int handle, double newValue);
+    Q_INVOKABLE double getParameterByHandle(int handle);
+    Q_INVOKABLE void setParameterByHandle(int handle, double newValue);
     Q_INVOKABLE QScriptValue makeConnection(QString group, QString name,
                                             const QScriptValue callback);
     // DEPRECATED: Use makeConnection instead.
@@ -130,9 +149,8 @@ class ControllerEngine : public QObject {
     Q_INVOKABLE void brake(int deck, bool activate, double factor=1.0, double rate=1.0);
     Q_INVOKABLE void spinback(int deck, bool activate, double factor=1.8, double rate=-10.0);
     Q_INVOKABLE void softStart(int deck, bool activate, double factor=1.0, double finalRate=1.0);
-
-    // Handler for timers that scripts set.
-    virtual void timerEvent(QTimerEvent *event);
+    // Logs the profile of the script, see ControllerScriptProfiler.
+    Q_INVOKABLE void dumpProfile();
 
   public slots:
     // Evaluate a script file
@@ -165,25 +183,44 @@ class ControllerEngine : public QObject {
 
   private slots:
     void errorDialogButton(const QString& key, QMessageBox::StandardButton button);
+    // Dispatches the expired timers of the timer wheel.
+    void slotTimerWheelTimeout();
 
   private:
     bool syntaxIsValid(const QString& scriptCode);
     bool evaluate(const QString& scriptName, QList<QString> scriptPaths);
-    bool internalExecute(QScriptValue thisObject, const QString& scriptCode);
+    // The call is profiled as profileName or the name of the function if
+    // profileName is null.
+    bool internalExecute(QScriptValue thisObject, const QString& scriptCode,
+                         const QString& profileName = QString());
     bool internalExecute(QScriptValue thisObject, QScriptValue functionObject,
-                         QScriptValueList arguments);
+                         QScriptValueList arguments,
+                         const QString& profileName = QString());
+    // The name of a function in the profile
+    QString profileName(const QScriptValue& function) const;
+    // Where the script function that called into the engine is
+    QString callerLocation() const;
     void initializeScriptEngine();
 
     void scriptErrorDialog(const QString& detailedError);
     void generateScriptFunctions(const QString& code);
     // Stops and removes all timers (for shutdown).
     void stopAllTimers();
+    // Script and scratch timers share the timer wheel.
+    int startWheelTimer(mixxx::Duration interval, bool oneShot);
+    void stopWheelTimer(int timerId);
+    // Arms m_timerWheelTimer for the next deadline of the timer wheel.
+    void scheduleTimerWheel();
 
     void callFunctionOnObjects(QList<QString>, const QString&, QScriptValueList args = QScriptValueList());
     bool checkException();
     QScriptEngine *m_pEngine;
 
     ControlObjectScript* getControlObjectScript(const QString& group, const QString& name);
+    ControlObjectScript* getControlObjectScript(ControlHandle handle);
+    // Sets the control unless soft takeover ignores the value.
+    void setControlValue(ControlObjectScript* coScript, double newValue);
+    void setControlParameter(ControlObjectScript* coScript, double newParameter);
 
     // Scratching functions & variables
     void scratchProcess(int timerId);
@@ -193,15 +230,23 @@ class ControllerEngine : public QObject {
 
     Controller* m_pController;
     bool m_bPopups;
+    // Whether a script has been warned about a timer interval shorter than
+    // the minimum of earlier versions
+    bool m_bShortTimerWarned;
     QList<QString> m_scriptFunctionPrefixes;
     QMap<QString, QStringList> m_scriptErrors;
     QHash<ConfigKey, ControlObjectScript*> m_controlCache;
+    // The controls of m_controlCache by their handle
+    QHash<ControlHandle, ControlObjectScript*> m_controlsByHandle;
     struct TimerInfo {
         QScriptValue callback;
         QScriptValue context;
         bool oneShot;
+        QString profileName;
     };
     QHash<int, TimerInfo> m_timers;
+    ControllerTimerWheel m_timerWheel;
+    QTimer m_timerWheelTimer;
     SoftTakeoverCtrl m_st;
     ByteArrayClass* m_pBaClass;
     // 256 (default) available virtual decks is enough I would think.
@@ -213,6 +258,9 @@ class ControllerEngine : public QObject {
     QVarLengthArray<AlphaBetaFilter*> m_scratchFilters;
     QHash<int, int> m_scratchTimers;
     QHash<QString, QScriptValue> m_scriptWrappedFunctionCache;
+    QScopedPointer<ControllerScriptProfiler> m_pProfiler;
+    // The code snippets of wrapped functions by object id, while profiling
+    QHash<qint64, QString> m_wrappedFunctionNames;
     // Filesystem watcher for script auto-reload
     QFileSystemWatcher m_scriptWatcher;
     QList<QString> m_lastScriptPaths;
@@ -39,6 +39,12 @@ const int kPollIntervalMillis = 5;
 const int kPollIntervalMillis = 1;
 #endif
 
+// Limits the static outputs of controllers to about the bandwidth of a MIDI
+// DIN cable, so that meters don't saturate the connection of large
+// controllers. 0 for no limit.
+const ConfigKey kOutputRateLimitConfigKey("[Controller]", "OutputRateLimit");
+const int kDefaultOutputRateLimit = 1000;
+
 } // anonymous namespace
 
 QString firstAvailableFilename(QSet<QString>& filenames,
@@ -250,6 +256,7 @@ void ControllerManager::slotSetUpDevices() {
 
         qDebug() << "Opening controller:" << name;
 
+        pController->setOutputRateLimit(outputRateLimit());
         int value = pController->open();
         if (value != 0) {
             qWarning() << "There was a problem opening" << name;
@@ -341,6 +348,7 @@ void ControllerManager::openController(Controller* pController) {
     if (pController->isOpen()) {
         pController->close();
     }
+    pController->setOutputRateLimit(outputRateLimit());
     int result = pController->open();
     maybeStartOrStopPolling();
 
@@ -355,6 +363,10 @@ void ControllerManager::openController(Controller* pController) {
     }
 }
 
+int ControllerManager::outputRateLimit() const {
+    return m_pConfig->getValue(kOutputRateLimitConfigKey, kDefaultOutputRateLimit);
+}
+
 void ControllerManager::closeController(Controller* pController) {
     if (!pController) {
         return;
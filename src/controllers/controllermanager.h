@@ -90,6 +90,10 @@ class ControllerManager : public QObject {
     }
 
   private:
+    // The output rate limit of the preferences, see
+    // Controller::setOutputRateLimit().
+    int outputRateLimit() const;
+
     UserSettingsPointer m_pConfig;
     ControllerLearningEventFilter* m_pControllerLearningEventFilter;
     QTimer m_pollTimer;
@@ -0,0 +1,48 @@
+#include "controllers/controllerscriptprofiler.h"
+
+#include <algorithm>
+
+#include "util/cmdlineargs.h"
+
+//static
+bool ControllerScriptProfiler::s_enabled = false;
+
+//static
+bool ControllerScriptProfiler::enabled() {
+    return s_enabled || CmdlineArgs::Instance().getControllerProfile();
+}
+
+void ControllerScriptProfiler::record(const QString& name,
+                                      mixxx::Duration elapsed) {
+    Entry& entry = m_entries[name];
+    ++entry.count;
+    entry.total += elapsed;
+    if (elapsed > entry.max) {
+        entry.max = elapsed;
+    }
+}
+
+QStringList ControllerScriptProfiler::report() const {
+    QList<QPair<mixxx::Duration, QString>> totals;
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        totals.append(qMakePair(it.value().total, it.key()));
+    }
+    std::sort(totals.begin(), totals.end(),
+            [](const QPair<mixxx::Duration, QString>& lhs,
+                    const QPair<mixxx::Duration, QString>& rhs) {
+                return lhs.first > rhs.first;
+            });
+
+    QStringList lines;
+    for (const auto& total : totals) {
+        const Entry entry = m_entries.value(total.second);
+        lines << QString("%1 calls, %2 total, %3 mean, %4 max: %5")
+                .arg(QString::number(entry.count),
+                        entry.total.formatMicrosWithUnit(),
+                        mixxx::Duration::fromNanos(entry.total.toIntegerNanos() /
+                                entry.count).formatMicrosWithUnit(),
+                        entry.max.formatMicrosWithUnit(),
+                        total.second);
+    }
+    return lines;
+}
@@ -0,0 +1,50 @@
+#ifndef CONTROLLERSCRIPTPROFILER_H
+#define CONTROLLERSCRIPTPROFILER_H
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+
+#include "util/duration.h"
+
+// Records how often the script functions, timers and connection callbacks of
+// a controller are called and how much time they take on the controller
+// thread. Enabled with --controllerProfile, since measuring every call has a
+// small cost.
+class ControllerScriptProfiler {
+  public:
+    static bool enabled();
+
+    // Override the command-line argument (for testing)
+    static void enable() {
+        s_enabled = true;
+    }
+    // Reverts enable()
+    static void disable() {
+        s_enabled = false;
+    }
+
+    void record(const QString& name, mixxx::Duration elapsed);
+
+    // One line per function, the most expensive first.
+    QStringList report() const;
+    void reset() {
+        m_entries.clear();
+    }
+
+  private:
+    struct Entry {
+        Entry()
+                : count(0) {
+        }
+        int count;
+        mixxx::Duration total;
+        mixxx::Duration max;
+    };
+
+    QHash<QString, Entry> m_entries;
+
+    static bool s_enabled;
+};
+
+#endif // CONTROLLERSCRIPTPROFILER_H
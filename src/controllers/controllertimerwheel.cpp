@@ -0,0 +1,132 @@
+#include "controllers/controllertimerwheel.h"
+
+#include <QPair>
+#include <algorithm>
+
+#include "util/assert.h"
+
+ControllerTimerWheel::ControllerTimerWheel()
+        : m_slots(kSlotCount),
+          m_currentTick(0),
+          m_nextTimerId(1) {
+}
+
+int ControllerTimerWheel::start(mixxx::Duration interval, bool oneShot,
+                                mixxx::Duration now) {
+    if (m_timers.isEmpty()) {
+        // Nothing is scheduled, so the wheel can skip ahead without
+        // processing the ticks in between.
+        m_currentTick = tickBefore(now);
+    }
+    // After wrapping around, skip the ids of timers that are still running.
+    while (m_timers.contains(m_nextTimerId)) {
+        m_nextTimerId = nextTimerId(m_nextTimerId);
+    }
+    const int timerId = m_nextTimerId;
+    m_nextTimerId = nextTimerId(m_nextTimerId);
+
+    const mixxx::Duration minInterval = mixxx::Duration::fromMicros(kTickMicros);
+    Timer timer;
+    timer.interval = interval < minInterval ? minInterval : interval;
+    timer.deadline = now + timer.interval;
+    timer.oneShot = oneShot;
+    schedule(timerId, &timer);
+    m_timers.insert(timerId, timer);
+    return timerId;
+}
+
+bool ControllerTimerWheel::stop(int timerId) {
+    QHash<int, Timer>::iterator it = m_timers.find(timerId);
+    if (it == m_timers.end()) {
+        return false;
+    }
+    m_slots[slotOf(it->tick)].removeOne(timerId);
+    m_timers.erase(it);
+    return true;
+}
+
+void ControllerTimerWheel::clear() {
+    m_timers.clear();
+    for (QVector<int>& slot : m_slots) {
+        slot.clear();
+    }
+}
+
+void ControllerTimerWheel::schedule(int timerId, Timer* pTimer) {
+    // Never schedule into a tick that has already been processed.
+    pTimer->tick = qMax(tickAfter(pTimer->deadline), m_currentTick + 1);
+    m_slots[slotOf(pTimer->tick)].append(timerId);
+}
+
+mixxx::Duration ControllerTimerWheel::nextDeadline() const {
+    DEBUG_ASSERT(!m_timers.isEmpty());
+    // Timers are taken at the end of the tick they are scheduled for, which
+    // may be later than their deadline.
+    for (qint64 tick = m_currentTick + 1;
+            tick <= m_currentTick + kSlotCount; ++tick) {
+        for (int timerId : m_slots[slotOf(tick)]) {
+            if (m_timers.constFind(timerId)->tick == tick) {
+                return mixxx::Duration::fromMicros(tick * kTickMicros);
+            }
+        }
+    }
+
+    // All timers are due after more than one revolution
+    qint64 earliest = m_timers.constBegin()->tick;
+    for (const Timer& timer : m_timers) {
+        earliest = qMin(earliest, timer.tick);
+    }
+    return mixxx::Duration::fromMicros(earliest * kTickMicros);
+}
+
+QVector<int> ControllerTimerWheel::takeExpired(mixxx::Duration now) {
+    QVector<int> expired;
+    const qint64 nowTick = tickBefore(now);
+    if (nowTick <= m_currentTick) {
+        return expired;
+    }
+
+    // If more than one revolution has passed, every slot is visited once.
+    QVector<QPair<mixxx::Duration, int>> due;
+    const qint64 lastTick = qMin(nowTick, m_currentTick + kSlotCount);
+    for (qint64 tick = m_currentTick + 1; tick <= lastTick; ++tick) {
+        QVector<int>& slot = m_slots[slotOf(tick)];
+        for (int i = 0; i < slot.size();) {
+            const int timerId = slot[i];
+            const Timer& timer = m_timers.constFind(timerId).value();
+            if (timer.tick <= nowTick) {
+                due.append(qMakePair(timer.deadline, timerId));
+                slot.remove(i);
+            } else {
+                // Due in a later revolution
+                ++i;
+            }
+        }
+    }
+    m_currentTick = nowTick;
+
+    // Ties are broken by the id, i.e. the timer that was started first
+    // fires first.
+    std::sort(due.begin(), due.end());
+    expired.reserve(due.size());
+    const qint64 nowNanos = now.toIntegerNanos();
+    for (const auto& entry : due) {
+        const int timerId = entry.second;
+        expired.append(timerId);
+        QHash<int, Timer>::iterator it = m_timers.find(timerId);
+        if (it->oneShot) {
+            m_timers.erase(it);
+            continue;
+        }
+        const qint64 interval = it->interval.toIntegerNanos();
+        qint64 deadline = it->deadline.toIntegerNanos() + interval;
+        if (deadline <= nowNanos) {
+            // Skip the missed deadlines but keep the phase, so that timers
+            // with the same interval keep expiring together.
+            deadline += ((nowNanos - deadline) / interval + 1) * interval;
+        }
+        it->deadline = mixxx::Duration::fromNanos(deadline);
+        schedule(timerId, &it.value());
+    }
+    return expired;
+}
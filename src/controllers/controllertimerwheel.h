@@ -0,0 +1,79 @@
+#ifndef CONTROLLERTIMERWHEEL_H
+#define CONTROLLERTIMERWHEEL_H
+
+#include <QHash>
+#include <QVector>
+#include <limits>
+
+#include "util/duration.h"
+
+// Schedules the timers of a controller script and its scratch ramps on a
+// hashed timing wheel, so that all of them are driven by a single system
+// timer on the controller thread. Deadlines are rounded up to ticks of
+// kTickMicros and timers that expire within the same tick are dispatched
+// together. Repeating timers are rescheduled from their previous deadline
+// instead of from the time they were dispatched, so they don't drift.
+class ControllerTimerWheel {
+  public:
+    static const qint64 kTickMicros = 250;
+    // One revolution covers 64 ms. Later deadlines stay in their slot for
+    // as many revolutions as needed.
+    static const int kSlotCount = 256;
+
+    ControllerTimerWheel();
+
+    // Returns the id of the new timer, which is never 0.
+    int start(mixxx::Duration interval, bool oneShot, mixxx::Duration now);
+    // Returns false if there is no such timer.
+    bool stop(int timerId);
+    bool isActive(int timerId) const {
+        return m_timers.contains(timerId);
+    }
+    bool isEmpty() const {
+        return m_timers.isEmpty();
+    }
+    void clear();
+
+    // The end of the tick of the earliest deadline of all timers, i.e. the
+    // time when takeExpired() returns the first timer. Must not be called if
+    // the wheel is empty.
+    mixxx::Duration nextDeadline() const;
+
+    // Returns the ids of the timers that have expired by now in the order of
+    // their deadlines. One-shot timers are removed and repeating timers are
+    // scheduled for their next deadline. A repeating timer that has fallen
+    // behind by more than its interval skips the deadlines it missed.
+    QVector<int> takeExpired(mixxx::Duration now);
+
+  private:
+    struct Timer {
+        mixxx::Duration deadline;
+        mixxx::Duration interval;
+        qint64 tick;
+        bool oneShot;
+    };
+
+    static qint64 tickBefore(mixxx::Duration time) {
+        return time.toIntegerMicros() / kTickMicros;
+    }
+    static qint64 tickAfter(mixxx::Duration time) {
+        return (time.toIntegerMicros() + kTickMicros - 1) / kTickMicros;
+    }
+    static int nextTimerId(int timerId) {
+        return timerId < std::numeric_limits<int>::max() ? timerId + 1 : 1;
+    }
+    static int slotOf(qint64 tick) {
+        return static_cast<int>(tick % kSlotCount);
+    }
+
+    void schedule(int timerId, Timer* pTimer);
+
+    QHash<int, Timer> m_timers;
+    // The ids of the timers whose deadline falls on the ticks of each slot
+    QVector<QVector<int>> m_slots;
+    // All ticks up to this one have been processed
+    qint64 m_currentTick;
+    int m_nextTimerId;
+};
+
+#endif // CONTROLLERTIMERWHEEL_H
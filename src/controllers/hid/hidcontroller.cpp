@@ -17,9 +17,17 @@
 #include "controllers/controllerdebug.h"
 #include "util/time.h"
 
+namespace {
+
+// At 1 kHz this buffers reports for a quarter of a second
+const int kHidPacketBufferSize = 256;
+
+} // anonymous namespace
+
 HidReader::HidReader(hid_device* device)
         : QThread(),
-          m_pHidDevice(device) {
+          m_pHidDevice(device),
+          m_packets(kHidPacketBufferSize) {
 }
 
 HidReader::~HidReader() {
@@ -27,25 +35,37 @@ HidReader::~HidReader() {
 
 void HidReader::run() {
     m_stop = 0;
-    unsigned char *data = new unsigned char[255];
+    HidPacket packet;
+    bool overflow = false;
     while (load_atomic(m_stop) == 0) {
         // Blocked polling: The only problem with this is that we can't close
         // the device until the block is released, which means the controller
         // has to send more data
-        //result = hid_read_timeout(m_pHidDevice, data, 255, -1);
+        //result = hid_read_timeout(m_pHidDevice, packet.data, 255, -1);
 
         // This relieves that at the cost of higher CPU usage since we only
         // block for a short while (500ms)
-        int result = hid_read_timeout(m_pHidDevice, data, 255, 500);
+        int result = hid_read_timeout(m_pHidDevice, packet.data,
+                sizeof(packet.data), 500);
         Trace timeout("HidReader timeout");
         if (result > 0) {
             Trace process("HidReader process packet");
-            //qDebug() << "Read" << result << "bytes, pointer:" << data;
-            QByteArray outData(reinterpret_cast<char*>(data), result);
-            emit(incomingData(outData, mixxx::Time::elapsed()));
+            //qDebug() << "Read" << result << "bytes, pointer:" << packet.data;
+            packet.size = result;
+            packet.timestamp = mixxx::Time::elapsed();
+            if (m_packets.write(&packet, 1) == 1) {
+                overflow = false;
+            } else if (!overflow) {
+                overflow = true;
+                qWarning() << objectName()
+                           << "is dropping reports, the controller thread"
+                           << "doesn't keep up";
+            }
+            if (m_packetsAvailable.testAndSetOrdered(0, 1)) {
+                emit(packetsAvailable());
+            }
         }
     }
-    delete [] data;
 }
 
 HidController::HidController(const hid_device_info deviceInfo)
@@ -251,8 +271,8 @@ int HidController::open() {
         m_pReader = new HidReader(m_pHidDevice);
         m_pReader->setObjectName(QString("HidReader %1").arg(getName()));
 
-        connect(m_pReader, SIGNAL(incomingData(QByteArray, mixxx::Duration)),
-                this, SLOT(receive(QByteArray, mixxx::Duration)));
+        connect(m_pReader, SIGNAL(packetsAvailable()),
+                this, SLOT(readPackets()));
 
         // Controller input needs to be prioritized since it can affect the
         // audio directly, like when scratching
@@ -275,8 +295,8 @@ int HidController::close() {
         qWarning() << "HidReader not present for" << getName()
                    << "yet the device is open!";
     } else {
-        disconnect(m_pReader, SIGNAL(incomingData(QByteArray, mixxx::Duration)),
-                   this, SLOT(receive(QByteArray, mixxx::Duration)));
+        disconnect(m_pReader, SIGNAL(packetsAvailable()),
+                   this, SLOT(readPackets()));
         m_pReader->stop();
         hid_set_nonblocking(m_pHidDevice, 1);   // Quit blocking
         controllerDebug("  Waiting on reader to finish");
@@ -296,6 +316,21 @@ int HidController::close() {
     return 0;
 }
 
+void HidController::readPackets() {
+    if (m_pReader == NULL) {
+        return;
+    }
+    // Packets that arrive from now on emit packetsAvailable() again
+    m_pReader->packetsRead();
+    HidPacket packet;
+    while (m_pReader->readPacket(&packet)) {
+        receive(QByteArray(reinterpret_cast<const char*>(packet.data),
+                        packet.size),
+                packet.timestamp);
+        reportInputLatency(mixxx::Time::elapsed() - packet.timestamp);
+    }
+}
+
 void HidController::send(QList<int> data, unsigned int length, unsigned int reportID) {
     Q_UNUSED(length);
     QByteArray temp;
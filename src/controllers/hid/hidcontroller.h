@@ -16,7 +16,19 @@
 #include "controllers/hid/hidcontrollerpreset.h"
 #include "controllers/hid/hidcontrollerpresetfilehandler.h"
 #include "util/duration.h"
+#include "util/fifo.h"
 
+// A report read from a HID device with the time it arrived.
+struct HidPacket {
+    unsigned char data[255];
+    int size;
+    mixxx::Duration timestamp;
+};
+
+// Reads the reports of a HID device into a lock-free ring buffer. Instead of
+// a queued signal per report, packetsAvailable() is emitted once until the
+// controller has started to read the buffer again, so that bursts of reports
+// are processed in one go.
 class HidReader : public QThread {
     Q_OBJECT
   public:
@@ -27,8 +39,18 @@ class HidReader : public QThread {
         m_stop = 1;
     }
 
+    // To be called by the controller before reading the available packets.
+    void packetsRead() {
+        m_packetsAvailable.fetchAndStoreOrdered(0);
+    }
+
+    // Returns false if no packet is available.
+    bool readPacket(HidPacket* pPacket) {
+        return m_packets.read(pPacket, 1) == 1;
+    }
+
   signals:
-    void incomingData(QByteArray data, mixxx::Duration timestamp);
+    void packetsAvailable();
 
   protected:
     void run();
@@ -36,6 +58,8 @@ class HidReader : public QThread {
   private:
     hid_device* m_pHidDevice;
     QAtomicInt m_stop;
+    FIFO<HidPacket> m_packets;
+    QAtomicInt m_packetsAvailable;
 };
 
 class HidController : public Controller {
@@ -78,6 +102,8 @@ class HidController : public Controller {
     int open() override;
     int close() override;
 
+    void readPackets();
+
   private:
     // For devices which only support a single report, reportID must be set to
     // 0x0.
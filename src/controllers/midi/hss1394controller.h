@@ -51,13 +51,11 @@ class Hss1394Controller : public MidiController {
     int close() override;
 
   protected:
-    void sendShortMsg(unsigned char status, unsigned char byte1,
-                      unsigned char byte2) override;
+    void writeShortMsg(unsigned char status, unsigned char byte1,
+                       unsigned char byte2) override;
 
   private:
-    // The sysex data must already contain the start byte 0xf0 and the end byte
-    // 0xf7.
-    void send(QByteArray data) override;
+    void writeSysex(QByteArray data) override;
 
     hss1394::TNodeInfo m_deviceInfo;
     int m_iDeviceIndex;
@@ -12,14 +12,36 @@
 #include "controllers/defs_controllers.h"
 #include "controllers/controllerdebug.h"
 #include "control/controlobject.h"
+#include "control/controlpushbutton.h"
 #include "errordialoghandler.h"
 #include "mixer/playermanager.h"
 #include "util/math.h"
 #include "util/screensaver.h"
+#include "util/time.h"
+
+namespace {
+
+// One entry per status byte without the high bit and data byte
+const int kDirectInputIndexSize = 128 * 128;
+
+// Static outputs are coalesced over this period, which is about the refresh
+// rate of the screen.
+const int kOutputFrameMillis = 20;
+
+} // anonymous namespace
 
 MidiController::MidiController()
-        : Controller() {
+        : Controller(),
+          m_directInputIndex(kDirectInputIndexSize, -1),
+          m_outputTimer(this),
+          m_outputSentStatId(Stat::kInvalidId),
+          m_outputSuppressedStatId(Stat::kInvalidId),
+          m_unreportedSentCount(0),
+          m_unreportedSuppressedCount(0) {
     setDeviceCategory(tr("MIDI Controller"));
+    m_outputTimer.setInterval(kOutputFrameMillis);
+    connect(&m_outputTimer, SIGNAL(timeout()),
+            this, SLOT(flushOutputs()));
 }
 
 MidiController::~MidiController() {
@@ -34,14 +56,202 @@ QString MidiController::presetExtension() {
 
 void MidiController::visit(const MidiControllerPreset* preset) {
     m_preset = *preset;
+    compileDirectInputMappings();
     emit(presetLoaded(getPreset()));
 }
 
+void MidiController::compileDirectInputMappings() {
+    m_directInputMappings.clear();
+    m_directInputIndex.fill(-1);
+
+    foreach (const uint16_t key, m_preset.inputMappings.uniqueKeys()) {
+        // Same order as iterating from QHash::find() in receive()
+        const QList<MidiInputMapping> mappings =
+                m_preset.inputMappings.values(key);
+        const MidiKey& mappingKey = mappings.first().key;
+        // Leave sysex and system messages to the regular path
+        if (mappingKey.status < 0x80 || mappingKey.status >= 0xF0) {
+            continue;
+        }
+        bool direct = true;
+        foreach (const MidiInputMapping& mapping, mappings) {
+            if (mapping.options.script ||
+                    mapping.options.fourteen_bit_msb ||
+                    mapping.options.fourteen_bit_lsb) {
+                direct = false;
+                break;
+            }
+        }
+        if (!direct) {
+            continue;
+        }
+
+        m_directInputIndex[directInputIndex(mappingKey.status, mappingKey.control)] =
+                m_directInputMappings.size();
+        foreach (const MidiInputMapping& mapping, mappings) {
+            DirectInputMapping directMapping;
+            directMapping.key = key;
+            directMapping.options = mapping.options;
+            directMapping.control = mapping.control;
+            m_directInputMappings.append(directMapping);
+        }
+    }
+}
+
+bool MidiController::processDirectInputMappings(unsigned char status,
+                                                unsigned char control,
+                                                unsigned char value) {
+    const MidiKey mappingKey(status, control);
+    const int first = m_directInputIndex.at(
+            directInputIndex(mappingKey.status, mappingKey.control));
+    if (first < 0) {
+        return false;
+    }
+    if (!m_fourteen_bit_queued_mappings.isEmpty()) {
+        // The regular path drops the incomplete 14-bit message
+        return false;
+    }
+
+    const unsigned char opCode = MidiUtils::opCodeFromStatus(status);
+    const uint16_t key = m_directInputMappings.at(first).key;
+    for (int i = first;
+            i < m_directInputMappings.size() &&
+                    m_directInputMappings.at(i).key == key;
+            ++i) {
+        DirectInputMapping* pMapping = &m_directInputMappings[i];
+        ControlObject* pCO = resolveDirectInputControl(pMapping);
+        if (pCO == NULL) {
+            continue;
+        }
+        const double newValue = computeInputValue(
+                pCO, pMapping->options, opCode, control, value);
+        setInputValue(pCO, pMapping->options, opCode, newValue);
+    }
+    return true;
+}
+
+ControlObject* MidiController::resolveDirectInputControl(
+        DirectInputMapping* pMapping) {
+    ControlObject* pCO = ControlObject::getControl(pMapping->handle);
+    if (pCO != NULL) {
+        return pCO;
+    }
+    // Not resolved yet or the control has been deleted. Handles are never
+    // reused, so a resolved handle can't refer to another control.
+    pCO = ControlObject::getControl(pMapping->control);
+    if (pCO != NULL) {
+        pMapping->handle = pCO->handle();
+    }
+    return pCO;
+}
+
 int MidiController::close() {
     destroyOutputHandlers();
+    m_outputTimer.stop();
+    m_outputQueue.reset();
+    reportOutputCounts(true);
     return 0;
 }
 
+void MidiController::sendShortMsg(unsigned char status, unsigned char byte1,
+                                  unsigned char byte2, bool suppressRepeated) {
+    if (m_outputQueue.sendNow(status, byte1, byte2, suppressRepeated)) {
+        writeShortMsg(status, byte1, byte2);
+    }
+    reportOutputCounts();
+}
+
+void MidiController::sendSysexMsg(QList<int> data, unsigned int length,
+                                  bool suppressRepeated) {
+    Q_UNUSED(length);
+    QByteArray msg(data.size(), 0);
+    for (int i = 0; i < data.size(); ++i) {
+        msg[i] = data.at(i);
+    }
+    sendSysex(msg, suppressRepeated);
+}
+
+void MidiController::send(QByteArray data) {
+    sendSysex(data, false);
+}
+
+void MidiController::sendSysex(const QByteArray& data, bool suppressRepeated) {
+    if (m_outputQueue.sendNow(data, suppressRepeated)) {
+        writeSysex(data);
+    }
+    reportOutputCounts();
+}
+
+void MidiController::setOutputRateLimit(int messagesPerSecond) {
+    int maxMessagesPerFrame = 0;
+    if (messagesPerSecond > 0) {
+        maxMessagesPerFrame = math_max(
+                1, messagesPerSecond * kOutputFrameMillis / 1000);
+    }
+    m_outputQueue.setMaxMessagesPerFrame(maxMessagesPerFrame);
+}
+
+void MidiController::queueOutput(unsigned char status, unsigned char byte1,
+                                 unsigned char byte2,
+                                 MidiOutputQueue::Priority priority) {
+    if (m_outputQueue.enqueue(status, byte1, byte2, priority)) {
+        sendShortMsg(status, byte1, byte2);
+        return;
+    }
+    if (m_outputTimer.isActive()) {
+        // Sent with the next frame
+        reportOutputCounts();
+    } else {
+        // The first output after an idle frame is sent right away
+        flushOutputs();
+    }
+}
+
+void MidiController::flushOutputs() {
+    if (m_outputQueue.isEmpty()) {
+        // Nothing has been queued during the last frame
+        m_outputTimer.stop();
+    } else {
+        const QVector<MidiOutputMessage> messages = m_outputQueue.takeFrame();
+        for (const MidiOutputMessage& message : messages) {
+            writeShortMsg(message.status, message.byte1, message.byte2);
+        }
+        if (!m_outputTimer.isActive()) {
+            m_outputTimer.start();
+        }
+    }
+    reportOutputCounts();
+}
+
+void MidiController::reportOutputCounts(bool flush) {
+    m_unreportedSentCount += m_outputQueue.takeSentCount();
+    m_unreportedSuppressedCount += m_outputQueue.takeSuppressedCount();
+    if (m_outputSentStatId == Stat::kInvalidId) {
+        m_unreportedSentCount = 0;
+        m_unreportedSuppressedCount = 0;
+        return;
+    }
+    // Scripts may send many messages per frame
+    const mixxx::Duration now = mixxx::Time::elapsed();
+    if (!flush && now - m_outputCountsReportedAt <
+            mixxx::Duration::fromMillis(kOutputFrameMillis)) {
+        return;
+    }
+    m_outputCountsReportedAt = now;
+    const Stat::ComputeFlags flags = Stat::experimentFlags(
+            Stat::COUNT | Stat::SUM | Stat::AVERAGE | Stat::MAX);
+    if (m_unreportedSentCount > 0) {
+        Stat::track(m_outputSentStatId, Stat::COUNTER, flags,
+                    m_unreportedSentCount);
+        m_unreportedSentCount = 0;
+    }
+    if (m_unreportedSuppressedCount > 0) {
+        Stat::track(m_outputSuppressedStatId, Stat::COUNTER, flags,
+                    m_unreportedSuppressedCount);
+        m_unreportedSuppressedCount = 0;
+    }
+}
+
 void MidiController::visit(const HidControllerPreset* preset) {
     Q_UNUSED(preset);
     qWarning() << "ERROR: Attempting to load an HidControllerPreset to a MidiController!";
@@ -65,6 +275,13 @@ bool MidiController::applyPreset(QList<QString> scriptPaths, bool initializeScri
 
     // Only execute this code if this is an output device
     if (isOutputDevice()) {
+        // The device name is known by now
+        if (m_outputSentStatId == Stat::kInvalidId) {
+            m_outputSentStatId = Stat::registerTag(
+                    QString("Controller %1 output messages sent").arg(getName()));
+            m_outputSuppressedStatId = Stat::registerTag(
+                    QString("Controller %1 output messages suppressed").arg(getName()));
+        }
         if (m_outputs.count() > 0) {
             destroyOutputHandlers();
         }
@@ -196,6 +413,7 @@ void MidiController::commitTemporaryInputMappings() {
     // the original set.
     m_preset.inputMappings.unite(m_temporaryInputMappings);
     m_temporaryInputMappings.clear();
+    compileDirectInputMappings();
 }
 
 void MidiController::receive(unsigned char status, unsigned char control,
@@ -208,6 +426,10 @@ void MidiController::receive(unsigned char status, unsigned char control,
     MidiKey mappingKey(status, control);
 
     triggerActivity();
+    if (isOutputDevice()) {
+        // The device may have changed the output on its own
+        m_outputQueue.forget(status, control);
+    }
     if (isLearning()) {
         emit(messageReceived(status, control, value));
 
@@ -221,6 +443,10 @@ void MidiController::receive(unsigned char status, unsigned char control,
         }
     }
 
+    if (processDirectInputMappings(status, control, value)) {
+        return;
+    }
+
     QHash<uint16_t, MidiInputMapping>::const_iterator it =
             m_preset.inputMappings.find(mappingKey.key);
     for (; it != m_preset.inputMappings.end() && it.key() == mappingKey.key; ++it) {
@@ -228,6 +454,41 @@ void MidiController::receive(unsigned char status, unsigned char control,
     }
 }
 
+bool MidiController::canCoalesceInput(unsigned char status,
+                                      unsigned char control,
+                                      unsigned char value,
+                                      unsigned char nextValue) const {
+    if (MidiUtils::opCodeFromStatus(status) != MIDI_CC || isLearning()) {
+        return false;
+    }
+    const MidiKey mappingKey(status, control);
+    QHash<uint16_t, MidiInputMapping>::const_iterator it =
+            m_preset.inputMappings.find(mappingKey.key);
+    if (it == m_preset.inputMappings.end()) {
+        return false;
+    }
+    for (; it != m_preset.inputMappings.end() && it.key() == mappingKey.key; ++it) {
+        const MidiOptions options = it.value().options;
+        // Only inverting the value keeps it absolute
+        if ((options.all & ~MIDI_OPTION_INVERT) != 0) {
+            return false;
+        }
+        // A value of 0 releases a button, see ControlPushButtonBehavior.
+        // Dropping it would lose a press or a release.
+        const double released = options.invert ? 127 : 0;
+        if ((value == released) != (nextValue == released)) {
+            return false;
+        }
+        // Buttons and toggles act on every message, even if the value
+        // stays on the same side of the threshold.
+        ControlObject* pCO = ControlObject::getControl(it.value().control, false);
+        if (pCO == NULL || qobject_cast<ControlPushButton*>(pCO) != NULL) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void MidiController::processInputMapping(const MidiInputMapping& mapping,
                                          unsigned char status,
                                          unsigned char control,
@@ -321,7 +582,19 @@ void MidiController::processInputMapping(const MidiInputMapping& mapping,
             m_fourteen_bit_queued_mappings.append(qMakePair(mapping, value));
             return;
         }
-    } else if (opCode == MIDI_PITCH_BEND) {
+    } else {
+        newValue = computeInputValue(pCO, mapping.options, opCode, control, value);
+    }
+
+    setInputValue(pCO, mapping.options, opCode, newValue);
+}
+
+double MidiController::computeInputValue(ControlObject* pCO,
+                                         MidiOptions options,
+                                         unsigned char opCode,
+                                         unsigned char control,
+                                         unsigned char value) {
+    if (opCode == MIDI_PITCH_BEND) {
         // compute 14-bit value for pitch bend messages
         int iValue;
         iValue = (value << 7) | control;
@@ -332,20 +605,24 @@ void MidiController::processInputMapping(const MidiInputMapping& mapping,
         // (0x40) and LSB 0. Dividing by 128 (0x80) maps 0x2000
         // directly to 0x40. See ControlLinPotmeterBehavior and
         // ControlPotmeterBehavior for more fun of this variety :).
-        newValue = static_cast<double>(iValue) / 128.0;
-        newValue = math_min(newValue, 127.0);
-    } else {
-        double currControlValue = pCO->getMidiParameter();
-        newValue = computeValue(mapping.options, currControlValue, value);
+        double newValue = static_cast<double>(iValue) / 128.0;
+        return math_min(newValue, 127.0);
     }
+    double currControlValue = pCO->getMidiParameter();
+    return computeValue(options, currControlValue, value);
+}
 
+void MidiController::setInputValue(ControlObject* pCO,
+                                   MidiOptions options,
+                                   unsigned char opCode,
+                                   double newValue) {
     // ControlPushButton ControlObjects only accept NOTE_ON, so if the midi
     // mapping is <button> we override the Midi 'status' appropriately.
-    if (mapping.options.button || mapping.options.sw) {
+    if (options.button || options.sw) {
         opCode = MIDI_NOTE_ON;
     }
 
-    if (mapping.options.soft_takeover) {
+    if (options.soft_takeover) {
         // This is the only place to enable it if it isn't already.
         m_st.enable(pCO);
         if (m_st.ignore(pCO, pCO->getParameterForMidiValue(newValue))) {
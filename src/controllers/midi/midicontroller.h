@@ -13,11 +13,16 @@
 #ifndef MIDICONTROLLER_H
 #define MIDICONTROLLER_H
 
+#include <QTimer>
+#include <QVector>
+
+#include "control/controlhandle.h"
 #include "controllers/controller.h"
 #include "controllers/midi/midicontrollerpreset.h"
 #include "controllers/midi/midicontrollerpresetfilehandler.h"
 #include "controllers/midi/midimessage.h"
 #include "controllers/midi/midioutputhandler.h"
+#include "controllers/midi/midioutputqueue.h"
 #include "controllers/softtakeover.h"
 
 class MidiController : public Controller {
@@ -56,16 +61,31 @@ class MidiController : public Controller {
                          unsigned char value);
 
   protected:
-    Q_INVOKABLE virtual void sendShortMsg(unsigned char status,
-                                          unsigned char byte1, unsigned char byte2) = 0;
-
-    // Alias for send()
+    // Sends the message right away. Scripts may skip messages that the
+    // device shows already with suppressRepeated, unless the device changes
+    // its outputs on its own.
+    Q_INVOKABLE void sendShortMsg(unsigned char status,
+                                  unsigned char byte1, unsigned char byte2,
+                                  bool suppressRepeated = false);
+
+    // Like send(), see MidiOutputQueue for suppressRepeated.
     // The length parameter is here for backwards compatibility for when scripts
     // were required to specify it.
-    Q_INVOKABLE inline void sendSysexMsg(QList<int> data, unsigned int length = 0) {
-        Q_UNUSED(length);
-        send(data);
-    }
+    Q_INVOKABLE void sendSysexMsg(QList<int> data, unsigned int length = 0,
+                                  bool suppressRepeated = false);
+
+    // Returns whether a message may be dropped if the next message sets the
+    // same control to nextValue, i.e. if it is a control change that is only
+    // mapped to the absolute value of controls other than buttons. Scripts,
+    // relative and 14-bit mappings, soft takeover and buttons see every
+    // message, and a value is never dropped if the next one would press or
+    // release a button.
+    bool canCoalesceInput(unsigned char status, unsigned char control,
+                          unsigned char value, unsigned char nextValue) const;
+
+    // Writes the message to the device.
+    virtual void writeShortMsg(unsigned char status, unsigned char byte1,
+                               unsigned char byte2) = 0;
 
   protected slots:
     virtual void receive(unsigned char status, unsigned char control,
@@ -82,7 +102,52 @@ class MidiController : public Controller {
     void clearTemporaryInputMappings();
     void commitTemporaryInputMappings();
 
+    // Sends the queued outputs of a frame.
+    void flushOutputs();
+
   private:
+    // Sends sysex messages right away.
+    void send(QByteArray data) override;
+    void sendSysex(const QByteArray& data, bool suppressRepeated);
+    // The sysex data must already contain the start byte 0xf0 and the end
+    // byte 0xf7.
+    virtual void writeSysex(QByteArray data) = 0;
+
+    void setOutputRateLimit(int messagesPerSecond) override;
+    // Sends the output of static output mappings, see MidiOutputQueue.
+    void queueOutput(unsigned char status, unsigned char byte1,
+                     unsigned char byte2, MidiOutputQueue::Priority priority);
+    // Tracks the counts of sent and suppressed messages once per frame, or
+    // right away if flush is true.
+    void reportOutputCounts(bool flush = false);
+
+    // A mapping that only sets the value of a control, see
+    // compileDirectInputMappings().
+    struct DirectInputMapping {
+        uint16_t key;
+        MidiOptions options;
+        ConfigKey control;
+        // Resolved when the first message arrives
+        ControlHandle handle;
+    };
+
+    // Messages whose mappings all set control values without scripts or
+    // 14-bit pairs are looked up in a flat table indexed by status and
+    // control byte, and write their controls through ControlHandles instead
+    // of looking them up by key. Must be called whenever the input mappings
+    // of m_preset change.
+    void compileDirectInputMappings();
+    // Returns false if the message has to take the regular path.
+    bool processDirectInputMappings(unsigned char status,
+                                    unsigned char control,
+                                    unsigned char value);
+    ControlObject* resolveDirectInputControl(DirectInputMapping* pMapping);
+    // The control of keys whose message has no control byte is 0xFF, for
+    // all keys of the status.
+    static int directInputIndex(unsigned char status, unsigned char control) {
+        return ((status & 0x7F) << 7) | (control & 0x7F);
+    }
+
     void processInputMapping(const MidiInputMapping& mapping,
                              unsigned char status,
                              unsigned char control,
@@ -93,6 +158,12 @@ class MidiController : public Controller {
                              mixxx::Duration timestamp);
 
     double computeValue(MidiOptions options, double _prevmidivalue, double _newmidivalue);
+    // Computes the new value of a control for a non 14-bit message.
+    double computeInputValue(ControlObject* pCO, MidiOptions options,
+                             unsigned char opCode, unsigned char control,
+                             unsigned char value);
+    void setInputValue(ControlObject* pCO, MidiOptions options,
+                       unsigned char opCode, double newValue);
     void createOutputHandlers();
     void updateAllOutputs();
     void destroyOutputHandlers();
@@ -108,8 +179,21 @@ class MidiController : public Controller {
     MidiControllerPreset m_preset;
     SoftTakeoverCtrl m_st;
     QList<QPair<MidiInputMapping, unsigned char> > m_fourteen_bit_queued_mappings;
-
-    // So it can access sendShortMsg()
+    // Grouped by key
+    QVector<DirectInputMapping> m_directInputMappings;
+    // Index of the first direct mapping of a message or -1
+    QVector<int> m_directInputIndex;
+    MidiOutputQueue m_outputQueue;
+    // Runs while frames of output are sent
+    QTimer m_outputTimer;
+    Stat::Id m_outputSentStatId;
+    Stat::Id m_outputSuppressedStatId;
+    // The counts are tracked at most once per frame
+    mixxx::Duration m_outputCountsReportedAt;
+    int m_unreportedSentCount;
+    int m_unreportedSuppressedCount;
+
+    // So it can access queueOutput()
     friend class MidiOutputHandler;
     friend class MidiControllerTest;
 };
@@ -13,10 +13,26 @@
 #include "controllers/controllerdebug.h"
 #include "control/controlobject.h"
 
+namespace {
+
+// Meters change continuously and are sent after other outputs, such as the
+// transport buttons, if the device can't keep up.
+MidiOutputQueue::Priority outputPriority(const ConfigKey& key) {
+    if (key.item.startsWith("VuMeter") ||
+            key.item.startsWith("PeakIndicator") ||
+            key.item == "playposition") {
+        return MidiOutputQueue::Priority::Low;
+    }
+    return MidiOutputQueue::Priority::High;
+}
+
+} // anonymous namespace
+
 MidiOutputHandler::MidiOutputHandler(MidiController* controller,
                                      const MidiOutputMapping& mapping)
         : m_pController(controller),
           m_mapping(mapping),
+          m_priority(outputPriority(mapping.controlKey)),
           m_cos(mapping.controlKey, this),
           m_lastVal(-1) { // -1 = virgin
     m_cos.connectValueChanged(SLOT(controlChanged(double)));
@@ -56,8 +72,9 @@ void MidiOutputHandler::controlChanged(double value) {
         controllerDebug("sending MIDI bytes:" << m_mapping.output.status
                      << "," << m_mapping.output.control << ","
                      << byte3);
-        m_pController->sendShortMsg(m_mapping.output.status,
-                                    m_mapping.output.control, byte3);
+        m_pController->queueOutput(m_mapping.output.status,
+                                   m_mapping.output.control, byte3,
+                                   m_priority);
         m_lastVal = static_cast<int>(byte3);
     }
 }
@@ -13,6 +13,7 @@
 
 #include "control/controlproxy.h"
 #include "controllers/midi/midimessage.h"
+#include "controllers/midi/midioutputqueue.h"
 
 class MidiController;
 
@@ -32,6 +33,7 @@ class MidiOutputHandler : QObject {
   private:
     MidiController* m_pController;
     const MidiOutputMapping m_mapping;
+    const MidiOutputQueue::Priority m_priority;
     ControlProxy m_cos;
     int m_lastVal;
 };
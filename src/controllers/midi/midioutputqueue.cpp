@@ -0,0 +1,193 @@
+#include "controllers/midi/midioutputqueue.h"
+
+#include <limits>
+
+#include "controllers/midi/midimessage.h"
+#include "controllers/midi/midiutils.h"
+
+namespace {
+
+// One entry per status byte without the high bit and data byte
+const int kOutputCount = 128 * 128;
+
+// Limits the memory for devices that send many different system exclusive
+// messages. The state of all of them is forgotten when it is exceeded.
+const int kMaxSysexOutputCount = 1024;
+
+} // anonymous namespace
+
+MidiOutputQueue::MidiOutputQueue()
+        : m_maxMessagesPerFrame(0),
+          m_lastSent(kOutputCount, -1),
+          m_sentOutputCount(0),
+          m_queued(kOutputCount, -1),
+          m_queuedCount(0),
+          m_listed(kOutputCount, false),
+          m_sentCount(0),
+          m_suppressedCount(0) {
+}
+
+//static
+int MidiOutputQueue::outputIndex(unsigned char status, unsigned char byte1) {
+    if (status < MIDI_NOTE_OFF || status >= MIDI_SYSEX) {
+        // System messages
+        return -1;
+    }
+    unsigned char opCode = MidiUtils::opCodeFromStatus(status);
+    if (opCode == MIDI_CC) {
+        // Data entry, data increment/decrement and the (N)RPN numbers that
+        // they refer to as well as channel mode messages act on what has
+        // been sent before.
+        if (byte1 == 0x06 || byte1 == 0x26 ||
+                (byte1 >= 0x60 && byte1 <= 0x65) || byte1 >= 0x78) {
+            return -1;
+        }
+    } else if (opCode == MIDI_NOTE_OFF) {
+        // Note on and off share the state of the note
+        opCode = MIDI_NOTE_ON;
+    }
+    const unsigned char channel = MidiUtils::channelFromStatus(status);
+    const unsigned char control =
+            MidiUtils::isMessageTwoBytes(opCode) ? (byte1 & 0x7F) : 0;
+    return (((opCode | channel) & 0x7F) << 7) | control;
+}
+
+bool MidiOutputQueue::sendNow(unsigned char status, unsigned char byte1,
+                              unsigned char byte2, bool suppressRepeated) {
+    const int index = outputIndex(status, byte1);
+    if (index < 0) {
+        ++m_sentCount;
+        return true;
+    }
+    if (m_queued[index] >= 0) {
+        // Superseded
+        m_queued[index] = -1;
+        --m_queuedCount;
+        ++m_suppressedCount;
+    }
+    const int state = messageState(status, byte1, byte2);
+    if (suppressRepeated && m_lastSent[index] == state) {
+        ++m_suppressedCount;
+        return false;
+    }
+    setLastSent(index, state);
+    ++m_sentCount;
+    return true;
+}
+
+bool MidiOutputQueue::sendNow(const QByteArray& data, bool suppressRepeated) {
+    // F0, at least one byte of the output, the state and F7
+    if (data.size() < 4) {
+        ++m_sentCount;
+        return true;
+    }
+    const QByteArray output = data.left(data.size() - 2);
+    const char state = data.at(data.size() - 2);
+    QHash<QByteArray, char>::iterator it = m_lastSysex.find(output);
+    if (suppressRepeated && it != m_lastSysex.end() && it.value() == state) {
+        ++m_suppressedCount;
+        return false;
+    }
+    // Devices switch modes or reset with system exclusive messages, which
+    // may change the outputs of the other messages.
+    forgetMessages();
+    if (it != m_lastSysex.end()) {
+        it.value() = state;
+    } else {
+        if (m_lastSysex.size() >= kMaxSysexOutputCount) {
+            m_lastSysex.clear();
+        }
+        m_lastSysex.insert(output, state);
+    }
+    ++m_sentCount;
+    return true;
+}
+
+bool MidiOutputQueue::enqueue(unsigned char status, unsigned char byte1,
+                              unsigned char byte2, Priority priority) {
+    const int index = outputIndex(status, byte1);
+    if (index < 0) {
+        return true;
+    }
+    const int state = messageState(status, byte1, byte2);
+    if (m_queued[index] >= 0) {
+        // Superseded
+        ++m_suppressedCount;
+        if (m_lastSent[index] == state) {
+            // Changed back before it was sent
+            m_queued[index] = -1;
+            --m_queuedCount;
+            ++m_suppressedCount;
+        } else {
+            m_queued[index] = state;
+        }
+        return false;
+    }
+    if (m_lastSent[index] == state) {
+        ++m_suppressedCount;
+        return false;
+    }
+    m_queued[index] = state;
+    ++m_queuedCount;
+    if (!m_listed[index]) {
+        m_listed[index] = true;
+        m_queuedOutputs[static_cast<int>(priority)].enqueue(index);
+    }
+    return false;
+}
+
+QVector<MidiOutputMessage> MidiOutputQueue::takeFrame() {
+    QVector<MidiOutputMessage> messages;
+    const int maxMessages = m_maxMessagesPerFrame > 0 ?
+            m_maxMessagesPerFrame : std::numeric_limits<int>::max();
+    for (QQueue<int>& outputs : m_queuedOutputs) {
+        while (!outputs.isEmpty() && messages.size() < maxMessages) {
+            const int index = outputs.dequeue();
+            m_listed[index] = false;
+            const int state = m_queued[index];
+            if (state < 0) {
+                continue;
+            }
+            m_queued[index] = -1;
+            --m_queuedCount;
+            setLastSent(index, state);
+            ++m_sentCount;
+            MidiOutputMessage message;
+            message.status = static_cast<unsigned char>(state >> 16);
+            message.byte1 = static_cast<unsigned char>(state >> 8);
+            message.byte2 = static_cast<unsigned char>(state);
+            messages.append(message);
+        }
+    }
+    return messages;
+}
+
+void MidiOutputQueue::forgetMessages() {
+    if (m_sentOutputCount > 0) {
+        m_lastSent.fill(-1);
+        m_sentOutputCount = 0;
+    }
+}
+
+void MidiOutputQueue::reset() {
+    forgetMessages();
+    m_queued.fill(-1);
+    m_queuedCount = 0;
+    m_listed.fill(false);
+    for (QQueue<int>& outputs : m_queuedOutputs) {
+        outputs.clear();
+    }
+    m_lastSysex.clear();
+}
+
+int MidiOutputQueue::takeSentCount() {
+    const int count = m_sentCount;
+    m_sentCount = 0;
+    return count;
+}
+
+int MidiOutputQueue::takeSuppressedCount() {
+    const int count = m_suppressedCount;
+    m_suppressedCount = 0;
+    return count;
+}
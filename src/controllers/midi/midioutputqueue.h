@@ -0,0 +1,119 @@
+#ifndef MIDIOUTPUTQUEUE_H
+#define MIDIOUTPUTQUEUE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QQueue>
+#include <QVector>
+
+struct MidiOutputMessage {
+    unsigned char status;
+    unsigned char byte1;
+    unsigned char byte2;
+};
+
+// Keeps the message that was last sent to each output of a MIDI device, i.e.
+// to each note, control change etc. per channel, so that messages that don't
+// change the state of the device are suppressed.
+//
+// Messages of mapped outputs are queued and coalesced per output. Each frame
+// sends at most a limited number of them, those with high priority first.
+// The rest is sent with the latest value in the following frames. Messages
+// of scripts are sent right away because scripts may depend on their order,
+// and they are only suppressed if the script asks for it.
+class MidiOutputQueue {
+  public:
+    enum class Priority {
+        High,
+        // Meters and other outputs that change continuously
+        Low,
+    };
+
+    MidiOutputQueue();
+
+    // 0 for no limit
+    void setMaxMessagesPerFrame(int maxMessages) {
+        m_maxMessagesPerFrame = maxMessages;
+    }
+
+    // Records a message that is sent right away and drops a queued message
+    // for the same output. Returns false if suppressRepeated is set and the
+    // output already shows the message, which then must not be sent.
+    bool sendNow(unsigned char status, unsigned char byte1,
+                 unsigned char byte2, bool suppressRepeated = true);
+    // The output of a system exclusive message is identified by all bytes
+    // but the last data byte, which is the state of the output. This only
+    // fits some devices, so only the scripts that ask for it suppress
+    // repeated system exclusive messages. Sending one forgets the state of
+    // the outputs of all other messages.
+    bool sendNow(const QByteArray& data, bool suppressRepeated);
+
+    // Queues a message unless the output already shows it. Returns true if
+    // the message has no state and needs to be sent right away instead.
+    bool enqueue(unsigned char status, unsigned char byte1,
+                 unsigned char byte2, Priority priority);
+    bool isEmpty() const {
+        return m_queuedCount == 0;
+    }
+    // Takes the queued messages that are sent in this frame.
+    QVector<MidiOutputMessage> takeFrame();
+
+    // Forgets the last message of the output of a received message, since
+    // controllers with local control may have changed it on their own.
+    void forget(unsigned char status, unsigned char byte1) {
+        if (m_sentOutputCount == 0) {
+            return;
+        }
+        const int index = outputIndex(status, byte1);
+        if (index >= 0 && m_lastSent[index] >= 0) {
+            m_lastSent[index] = -1;
+            --m_sentOutputCount;
+        }
+    }
+    // Forgets the state of all outputs of messages, so that the next
+    // message is sent in any case.
+    void forgetMessages();
+    // Forgets all state and queued messages, e.g. when the device is closed.
+    void reset();
+
+    // The number of messages that have been sent and suppressed since the
+    // last call.
+    int takeSentCount();
+    int takeSuppressedCount();
+
+  private:
+    // Returns -1 if the message has no state, e.g. data entry or
+    // channel mode messages.
+    static int outputIndex(unsigned char status, unsigned char byte1);
+    static int messageState(unsigned char status, unsigned char byte1,
+                            unsigned char byte2) {
+        return (status << 16) | (byte1 << 8) | byte2;
+    }
+
+    void setLastSent(int index, int state) {
+        if (m_lastSent[index] < 0) {
+            ++m_sentOutputCount;
+        }
+        m_lastSent[index] = state;
+    }
+
+    int m_maxMessagesPerFrame;
+    // The state of each output, -1 if unknown
+    QVector<int> m_lastSent;
+    // The number of outputs whose state is known
+    int m_sentOutputCount;
+    // The queued state of each output, -1 if none
+    QVector<int> m_queued;
+    int m_queuedCount;
+    // Outputs in the order they were queued, per priority. May contain
+    // outputs whose queued message has been dropped.
+    QQueue<int> m_queuedOutputs[2];
+    QVector<bool> m_listed;
+    // The last data byte of the system exclusive message that was sent to
+    // each output
+    QHash<QByteArray, char> m_lastSysex;
+    int m_sentCount;
+    int m_suppressedCount;
+};
+
+#endif /* MIDIOUTPUTQUEUE_H */
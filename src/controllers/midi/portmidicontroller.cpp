@@ -7,6 +7,8 @@
  *
  */
 
+#include <porttime.h>
+
 #include "controllers/midi/midiutils.h"
 #include "controllers/midi/portmidicontroller.h"
 #include "controllers/controllerdebug.h"
@@ -165,6 +167,15 @@ bool PortMidiController::poll() {
                 //unsigned char channel = status & 0x0F;
                 unsigned char note = Pm_MessageData1(m_midiBuffer[i].message);
                 unsigned char velocity = Pm_MessageData2(m_midiBuffer[i].message);
+                // Faders and knobs that are moved quickly send many messages
+                // per poll, of which only the last value matters.
+                if (i + 1 < numEvents &&
+                        Pm_MessageStatus(m_midiBuffer[i + 1].message) == status &&
+                        Pm_MessageData1(m_midiBuffer[i + 1].message) == note &&
+                        canCoalesceInput(status, note, velocity,
+                                Pm_MessageData2(m_midiBuffer[i + 1].message))) {
+                    continue;
+                }
                 receive(status, note, velocity, timestamp);
             }
         }
@@ -201,11 +212,20 @@ bool PortMidiController::poll() {
             }
         }
     }
+
+    // PortMidi timestamps the events with PortTime
+    const PmTimestamp processed = Pt_Time();
+    for (int i = 0; i < numEvents; i++) {
+        if (processed >= m_midiBuffer[i].timestamp) {
+            reportInputLatency(mixxx::Duration::fromMillis(
+                    processed - m_midiBuffer[i].timestamp));
+        }
+    }
     return numEvents > 0;
 }
 
-void PortMidiController::sendShortMsg(unsigned char status, unsigned char byte1,
-                                      unsigned char byte2) {
+void PortMidiController::writeShortMsg(unsigned char status, unsigned char byte1,
+                                       unsigned char byte2) {
     if (m_pOutputDevice.isNull() || !m_pOutputDevice->isOpen()) {
         return;
     }
@@ -230,7 +250,7 @@ void PortMidiController::sendShortMsg(unsigned char status, unsigned char byte1,
     }
 }
 
-void PortMidiController::send(QByteArray data) {
+void PortMidiController::writeSysex(QByteArray data) {
     // PortMidi does not receive a length argument for the buffer we provide to
     // Pm_WriteSysEx. Instead, it scans for a MIDI_EOX byte to know when the
     // message is over. If one is not provided, it will overflow the buffer and
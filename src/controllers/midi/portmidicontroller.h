@@ -71,14 +71,11 @@ class PortMidiController : public MidiController {
     bool poll() override;
 
   protected:
-    // MockPortMidiController needs this to not be private.
-    void sendShortMsg(unsigned char status, unsigned char byte1,
-                      unsigned char byte2) override;
+    void writeShortMsg(unsigned char status, unsigned char byte1,
+                       unsigned char byte2) override;
 
   private:
-    // The sysex data must already contain the start byte 0xf0 and the end byte
-    // 0xf7.
-    void send(QByteArray data) override;
+    void writeSysex(QByteArray data) override;
 
     bool isPolling() const override {
         return true;
@@ -63,6 +63,8 @@ DlgDeveloperTools::DlgDeveloperTools(QWidget* pParent,
             this, SLOT(slotControlSearchClear()));
     connect(controlDump, SIGNAL(clicked()),
             this, SLOT(slotControlDump()));
+    connect(statsDump, SIGNAL(clicked()),
+            this, SLOT(slotStatsDump()));
 
     // Set up the log search box
     connect(logSearch, SIGNAL(returnPressed()),
@@ -145,6 +147,18 @@ void DlgDeveloperTools::slotControlDump() {
     }
 }
 
+void DlgDeveloperTools::slotStatsDump() {
+    StatsManager* pManager = StatsManager::instance();
+    if (!pManager) {
+        return;
+    }
+    QString timestamp = QDateTime::currentDateTime()
+            .toString("yyyy-MM-dd_hh'h'mm'm'ss's'");
+    // The file is written by the StatsManager thread
+    pManager->dumpStats(CmdlineArgs::Instance().getSettingsPath() +
+            "/stats_dump_" + timestamp + ".json");
+}
+
 void DlgDeveloperTools::slotLogSearch() {
     QString textToFind = logSearch->text();
     m_logCursor = logTextView->document()->find(textToFind, m_logCursor);
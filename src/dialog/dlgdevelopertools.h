@@ -25,6 +25,7 @@ class DlgDeveloperTools : public QDialog, public Ui::DlgDeveloperTools {
     void slotControlSearchClear();
     void slotLogSearch();
     void slotControlDump();
+    void slotStatsDump();
 
   private:
     ControlModel m_controlModel;
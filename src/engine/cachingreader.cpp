@@ -3,11 +3,13 @@
 
 #include "engine/cachingreader.h"
 #include "control/controlobject.h"
+#include "control/controlpushbutton.h"
 #include "track/track.h"
 #include "util/assert.h"
 #include "util/counter.h"
 #include "util/math.h"
 #include "util/sample.h"
+#include "util/time.h"
 
 
 namespace {
@@ -17,6 +19,10 @@ namespace {
 // TODO() Do we suffer chache misses if we use an audio buffer of above 23 ms?
 const SINT kDefaultHintFrames = 1024;
 
+const mixxx::Duration kChunkMissInterval = mixxx::Duration::fromSeconds(60);
+
+const mixxx::Duration kStatsInterval = mixxx::Duration::fromSeconds(1);
+
 } // anonymous namespace
 
 // currently CachingReaderWorker::kCachingReaderChunkLength is 65536 (0x10000);
@@ -29,12 +35,39 @@ CachingReader::CachingReader(QString group,
         : m_pConfig(config),
           m_chunkReadRequestFIFO(1024),
           m_readerStatusFIFO(1024),
+          m_preloadReleaseFIFO(16),
           m_readerStatus(INVALID),
           m_mruCachingReaderChunk(nullptr),
           m_lruCachingReaderChunk(nullptr),
           m_sampleBuffer(CachingReaderChunk::kSamples * maximumCachingReaderChunksInMemory),
           m_maxReadableFrameIndex(mixxx::AudioSource::getMinFrameIndex()),
-          m_worker(group, &m_chunkReadRequestFIFO, &m_readerStatusFIFO) {
+          m_statsHits(0),
+          m_statsMisses(0),
+          m_statsZeroFilledFrames(0),
+          m_hitsCounter(QString("CachingReader %1 chunk hits").arg(group)),
+          m_missesCounter(QString("CachingReader %1 chunk misses").arg(group)),
+          m_zeroFilledFramesCounter(
+                  QString("CachingReader %1 zero-filled frames").arg(group)),
+          m_missesPerMinuteCounter(
+                  QString("CachingReader %1 chunk misses per minute").arg(group)),
+          m_cacheMissesAtMinuteStart(0.0),
+          m_pPreloadedSamples(nullptr),
+          m_worker(group, config, &m_chunkReadRequestFIFO, &m_readerStatusFIFO,
+                  &m_preloadReleaseFIFO) {
+    // The mixer decides which kinds of players are preloaded by default
+    m_pPreloadTrack = new ControlPushButton(ConfigKey(group, "preload_track"),
+            true);
+    m_pPreloadTrack->setButtonMode(ControlPushButton::TOGGLE);
+
+    m_pCacheHits = new ControlObject(ConfigKey(group, "cache_hits"));
+    m_pCacheHits->setReadOnly();
+    m_pCacheMisses = new ControlObject(ConfigKey(group, "cache_misses"));
+    m_pCacheMisses->setReadOnly();
+    m_pCacheZeroFilledFrames = new ControlObject(
+            ConfigKey(group, "cache_zero_filled_frames"));
+    m_pCacheZeroFilledFrames->setReadOnly();
+    m_statsPublishedAt = mixxx::Time::elapsed();
+    m_minuteStartedAt = m_statsPublishedAt;
 
     m_allocatedCachingReaderChunks.reserve(maximumCachingReaderChunksInMemory);
 
@@ -69,6 +102,21 @@ CachingReader::CachingReader(QString group,
 CachingReader::~CachingReader() {
     m_worker.quitWait();
     qDeleteAll(m_chunks);
+    delete m_pPreloadTrack;
+    delete m_pCacheHits;
+    delete m_pCacheMisses;
+    delete m_pCacheZeroFilledFrames;
+
+    // The worker has stopped and can't delete any buffers anymore
+    delete m_pPreloadedSamples;
+    ReaderStatusUpdate status;
+    while (m_readerStatusFIFO.read(&status, 1) == 1) {
+        delete status.preloadedSamples;
+    }
+    SampleBuffer* pSamples = nullptr;
+    while (m_preloadReleaseFIFO.read(&pSamples, 1) == 1) {
+        delete pSamples;
+    }
 }
 
 void CachingReader::freeChunk(CachingReaderChunkForOwner* pChunk) {
@@ -106,6 +154,18 @@ void CachingReader::freeAllChunks() {
     m_mruCachingReaderChunk = nullptr;
 }
 
+void CachingReader::releasePreloadedSamples() {
+    if (m_pPreloadedSamples == nullptr) {
+        return;
+    }
+    VERIFY_OR_DEBUG_ASSERT(m_preloadReleaseFIFO.write(&m_pPreloadedSamples, 1) == 1) {
+        qWarning() << "ERROR: Could not release preloaded samples";
+        return;
+    }
+    m_pPreloadedSamples = nullptr;
+    m_worker.workReady();
+}
+
 CachingReaderChunkForOwner* CachingReader::allocateChunk(SINT chunkIndex) {
     if (m_freeChunks.isEmpty()) {
         return nullptr;
@@ -199,12 +259,18 @@ void CachingReader::process() {
         }
         if (status.status == TRACK_NOT_LOADED) {
             m_readerStatus = status.status;
+            releasePreloadedSamples();
         } else if (status.status == TRACK_LOADED) {
             m_readerStatus = status.status;
             // Reset the max. readable frame index
             m_maxReadableFrameIndex = status.maxReadableFrameIndex;
             // Free all chunks with sample data from a previous track
             freeAllChunks();
+            releasePreloadedSamples();
+        } else if (status.status == TRACK_PRELOADED) {
+            // Always preceded by TRACK_LOADED for the same track
+            DEBUG_ASSERT(m_pPreloadedSamples == nullptr);
+            m_pPreloadedSamples = status.preloadedSamples;
         }
         // Adjust the max. readable frame index
         if (m_readerStatus == TRACK_LOADED) {
@@ -213,6 +279,41 @@ void CachingReader::process() {
             m_maxReadableFrameIndex = mixxx::AudioSource::getMinFrameIndex();
         }
     }
+
+    const mixxx::Duration now = mixxx::Time::elapsed();
+    if (now - m_statsPublishedAt >= kStatsInterval) {
+        m_statsPublishedAt = now;
+        publishStats(now);
+    }
+}
+
+void CachingReader::publishStats(mixxx::Duration now) {
+    if (m_statsHits > 0) {
+        m_hitsCounter += m_statsHits;
+        m_pCacheHits->forceSet(m_pCacheHits->get() + m_statsHits);
+        m_statsHits = 0;
+    }
+    if (m_statsMisses > 0) {
+        m_missesCounter += m_statsMisses;
+        m_pCacheMisses->forceSet(m_pCacheMisses->get() + m_statsMisses);
+        m_statsMisses = 0;
+    }
+    if (m_statsZeroFilledFrames > 0) {
+        m_zeroFilledFramesCounter += m_statsZeroFilledFrames;
+        m_pCacheZeroFilledFrames->forceSet(
+                m_pCacheZeroFilledFrames->get() + m_statsZeroFilledFrames);
+        m_statsZeroFilledFrames = 0;
+    }
+
+    if (now - m_minuteStartedAt >= kChunkMissInterval) {
+        m_minuteStartedAt = now;
+        const double cacheMisses = m_pCacheMisses->get();
+        if (m_readerStatus == TRACK_LOADED) {
+            m_missesPerMinuteCounter += static_cast<int>(
+                    cacheMisses - m_cacheMissesAtMinuteStart);
+        }
+        m_cacheMissesAtMinuteStart = cacheMisses;
+    }
 }
 
 SINT CachingReader::read(SINT startSample, SINT numSamples, bool reverse, CSAMPLE* buffer) {
@@ -290,61 +391,82 @@ SINT CachingReader::read(SINT startSample, SINT numSamples, bool reverse, CSAMPL
             // The intersection between the readable samples from the track
             // and the requested samples is not empty, so start reading.
 
-            const SINT firstCachingReaderChunkIndex = CachingReaderChunk::indexForFrame(frameIndex);
-            SINT lastCachingReaderChunkIndex = CachingReaderChunk::indexForFrame(maxReadableFrameIndex - 1);
-            for (SINT chunkIndex = firstCachingReaderChunkIndex; chunkIndex <= lastCachingReaderChunkIndex; ++chunkIndex) {
-
-                const CachingReaderChunkForOwner* const pChunk = lookupChunkAndFreshen(chunkIndex);
-                // If the chunk is not in cache, then we must return an error.
-                if (!pChunk || (pChunk->getState() != CachingReaderChunkForOwner::READY)) {
-                    Counter("CachingReader::read(): Failed to read chunk on cache miss")++;
-                    // Exit the loop and fill the remaining buffer with silence
-                    break;
-                }
-
-                // Please note that m_maxReadableFrameIndex might change with
-                // every read operation! On a cache miss audio data will be
-                // read from the audio source in lookupChunkAndFreshen() and
-                // the max. readable frame index might be adjusted if decoding
-                // errors occur.
-                maxReadableFrameIndex = math_min(maxReadableFrameIndex, m_maxReadableFrameIndex);
-                if (maxReadableFrameIndex <= frameIndex) {
-                    // No more readable data available. Exit the loop and
-                    // fill the remaining buffer with silence.
-                    break;
-                }
-                DEBUG_ASSERT(0 < maxReadableFrameIndex);
-                lastCachingReaderChunkIndex = CachingReaderChunk::indexForFrame(maxReadableFrameIndex - 1);
-
-                const SINT chunkFrameIndex = CachingReaderChunk::frameForIndex(chunkIndex);
-                DEBUG_ASSERT(chunkFrameIndex <= frameIndex);
-                DEBUG_ASSERT((chunkIndex == firstCachingReaderChunkIndex) ||
-                        (chunkFrameIndex == frameIndex));
-                const SINT chunkFrameOffset = frameIndex - chunkFrameIndex;
-                DEBUG_ASSERT(chunkFrameOffset >= 0);
-                const SINT chunkFrameCount = math_min(
-                        pChunk->getFrameCount(),
-                        maxReadableFrameIndex - chunkFrameIndex);
-                if (chunkFrameCount < chunkFrameOffset) {
-                    // No more readable data available from this chunk (and
-                    // consequently all following chunks). Exit the loop and
-                    // fill the remaining buffer with silence.
-                    break;
-                }
-
-                const SINT framesToCopy = chunkFrameCount - chunkFrameOffset;
-                DEBUG_ASSERT(framesToCopy >= 0);
-                const SINT chunkSampleOffset = CachingReaderChunk::frames2samples(chunkFrameOffset);
+            if (m_pPreloadedSamples) {
+                // All readable samples are available in a single buffer
+                const SINT framesToCopy = maxReadableFrameIndex - frameIndex;
                 const SINT samplesToCopy = CachingReaderChunk::frames2samples(framesToCopy);
-
+                const CSAMPLE* pSamples = m_pPreloadedSamples->data(
+                        CachingReaderChunk::frames2samples(frameIndex));
                 if (reverse) {
-                    pChunk->copySamplesReverse(&buffer[numSamples - samplesRead - samplesToCopy], chunkSampleOffset, samplesToCopy);
+                    SampleUtil::copyReverse(&buffer[numSamples - samplesRead - samplesToCopy],
+                            pSamples, samplesToCopy);
                 } else {
-                    pChunk->copySamples(buffer, chunkSampleOffset, samplesToCopy);
+                    SampleUtil::copy(buffer, pSamples, samplesToCopy);
                     buffer += samplesToCopy;
                 }
                 samplesRead += samplesToCopy;
                 frameIndex += framesToCopy;
+                ++m_statsHits;
+            } else {
+                const SINT firstCachingReaderChunkIndex = CachingReaderChunk::indexForFrame(frameIndex);
+                SINT lastCachingReaderChunkIndex = CachingReaderChunk::indexForFrame(maxReadableFrameIndex - 1);
+                for (SINT chunkIndex = firstCachingReaderChunkIndex; chunkIndex <= lastCachingReaderChunkIndex; ++chunkIndex) {
+
+                    const CachingReaderChunkForOwner* const pChunk = lookupChunkAndFreshen(chunkIndex);
+                    // If the chunk is not in cache, then we must return an error.
+                    if (!pChunk || (pChunk->getState() != CachingReaderChunkForOwner::READY)) {
+                        ++m_statsMisses;
+                        // All remaining readable frames are replaced by silence
+                        m_statsZeroFilledFrames += maxReadableFrameIndex - frameIndex;
+                        // Exit the loop and fill the remaining buffer with silence
+                        break;
+                    }
+                    ++m_statsHits;
+
+                    // Please note that m_maxReadableFrameIndex might change with
+                    // every read operation! On a cache miss audio data will be
+                    // read from the audio source in lookupChunkAndFreshen() and
+                    // the max. readable frame index might be adjusted if decoding
+                    // errors occur.
+                    maxReadableFrameIndex = math_min(maxReadableFrameIndex, m_maxReadableFrameIndex);
+                    if (maxReadableFrameIndex <= frameIndex) {
+                        // No more readable data available. Exit the loop and
+                        // fill the remaining buffer with silence.
+                        break;
+                    }
+                    DEBUG_ASSERT(0 < maxReadableFrameIndex);
+                    lastCachingReaderChunkIndex = CachingReaderChunk::indexForFrame(maxReadableFrameIndex - 1);
+
+                    const SINT chunkFrameIndex = CachingReaderChunk::frameForIndex(chunkIndex);
+                    DEBUG_ASSERT(chunkFrameIndex <= frameIndex);
+                    DEBUG_ASSERT((chunkIndex == firstCachingReaderChunkIndex) ||
+                            (chunkFrameIndex == frameIndex));
+                    const SINT chunkFrameOffset = frameIndex - chunkFrameIndex;
+                    DEBUG_ASSERT(chunkFrameOffset >= 0);
+                    const SINT chunkFrameCount = math_min(
+                            pChunk->getFrameCount(),
+                            maxReadableFrameIndex - chunkFrameIndex);
+                    if (chunkFrameCount < chunkFrameOffset) {
+                        // No more readable data available from this chunk (and
+                        // consequently all following chunks). Exit the loop and
+                        // fill the remaining buffer with silence.
+                        break;
+                    }
+
+                    const SINT framesToCopy = chunkFrameCount - chunkFrameOffset;
+                    DEBUG_ASSERT(framesToCopy >= 0);
+                    const SINT chunkSampleOffset = CachingReaderChunk::frames2samples(chunkFrameOffset);
+                    const SINT samplesToCopy = CachingReaderChunk::frames2samples(framesToCopy);
+
+                    if (reverse) {
+                        pChunk->copySamplesReverse(&buffer[numSamples - samplesRead - samplesToCopy], chunkSampleOffset, samplesToCopy);
+                    } else {
+                        pChunk->copySamples(buffer, chunkSampleOffset, samplesToCopy);
+                        buffer += samplesToCopy;
+                    }
+                    samplesRead += samplesToCopy;
+                    frameIndex += framesToCopy;
+                }
             }
         }
     }
@@ -356,8 +478,8 @@ SINT CachingReader::read(SINT startSample, SINT numSamples, bool reverse, CSAMPL
 }
 
 void CachingReader::hintAndMaybeWake(const HintVector& hintList) {
-    // If no file is loaded, skip.
-    if (m_readerStatus != TRACK_LOADED) {
+    // If no file is loaded or all samples are already in memory, skip.
+    if (m_readerStatus != TRACK_LOADED || m_pPreloadedSamples) {
         return;
     }
 
@@ -407,7 +529,7 @@ void CachingReader::hintAndMaybeWake(const HintVector& hintList) {
                 }
                 // Do not insert the allocated chunk into the MRU/LRU list,
                 // because it will be handed over to the worker immediately
-                CachingReaderChunkReadRequest request(pChunk);
+                CachingReaderChunkReadRequest request(pChunk, hint.priority);
                 pChunk->giveToWorker();
                 // qDebug() << "Requesting read of chunk" << current << "into" << pChunk;
                 // qDebug() << "Requesting read into " << request.chunk->data;
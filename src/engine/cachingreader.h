@@ -15,9 +15,14 @@
 #include "preferences/usersettings.h"
 #include "track/track.h"
 #include "engine/engineworker.h"
+#include "util/counter.h"
 #include "util/fifo.h"
+#include "util/duration.h"
 #include "engine/cachingreaderworker.h"
 
+class ControlObject;
+class ControlPushButton;
+
 // A Hint is an indication to the CachingReader that a certain section of a
 // SoundSource will be used 'soon' and so it should be brought into memory by
 // the reader work thread.
@@ -27,17 +32,28 @@ typedef struct Hint {
     // If a range of frames should be present, use frameCount to indicate that the
     // range (frame, frame + frameCount) should be present in memory.
     SINT frameCount;
-    // Currently unused -- but in the future could be used to prioritize certain
-    // hints over others. A priority of 1 is the highest priority and should be
-    // used for samples that will be read imminently. Hints for samples that
-    // have the potential to be read (i.e. a cue point) should be issued with
-    // priority >10.
+    // Used to prioritize certain hints over others. The worker reads the
+    // chunks of pending hints with a lower value first. A priority of 1 is
+    // the highest priority and should be used for samples that will be read
+    // imminently. Hints for samples that have the potential to be read (i.e.
+    // a cue point) should be issued with priority >= 10.
     int priority;
 
     // for the default frame count in forward direction
     static constexpr SINT kFrameCountForward = 0;
     static constexpr SINT kFrameCountBackward = -1;
 
+    // Priority classes
+    // The samples around the play position in the current direction
+    static constexpr int kPriorityImminent = 1;
+    // The jump target of an active loop
+    static constexpr int kPriorityLoop = 2;
+    // The samples behind the play position when the direction is reversed,
+    // e.g. while scratching
+    static constexpr int kPriorityReverse = 5;
+    // Cue points and inactive loops the user may jump to at any time
+    static constexpr int kPriorityCue = 10;
+
 } Hint;
 
 // Note that we use a QVarLengthArray here instead of a QVector. Since this list
@@ -102,6 +118,12 @@ class CachingReader : public QObject {
         m_worker.setScheduler(pScheduler);
     }
 
+    // Returns true if all samples of the current track are kept in memory.
+    // Reads never miss and hints are no longer needed in this case.
+    bool isTrackPreloaded() const {
+        return m_pPreloadedSamples != nullptr;
+    }
+
     const static int maximumCachingReaderChunksInMemory;
 
   signals:
@@ -117,6 +139,7 @@ class CachingReader : public QObject {
     // reader thread.
     FIFO<CachingReaderChunkReadRequest> m_chunkReadRequestFIFO;
     FIFO<ReaderStatusUpdate> m_readerStatusFIFO;
+    FIFO<SampleBuffer*> m_preloadReleaseFIFO;
 
     // Looks for the provided chunk number in the index of in-memory chunks and
     // returns it if it is present. If not, returns nullptr. If it is present then
@@ -136,6 +159,14 @@ class CachingReader : public QObject {
     // Returns all allocated chunks to the free list
     void freeAllChunks();
 
+    // Reports the instrumentation of read() that has been accumulated
+    // since the last call to the StatsManager and updates the controls.
+    void publishStats(mixxx::Duration now);
+
+    // Hands the preloaded samples of the previous track back to the
+    // worker, which deletes them outside of the engine callback.
+    void releasePreloadedSamples();
+
     // Gets a chunk from the free list. Returns nullptr if none available.
     CachingReaderChunkForOwner* allocateChunk(SINT chunkIndex);
 
@@ -167,6 +198,37 @@ class CachingReader : public QObject {
     // frame with sample data.
     SINT m_maxReadableFrameIndex;
 
+    // Instrumentation of read(), accumulated in the engine callback and
+    // published periodically by publishStats(). All statistics of cache
+    // misses are derived from m_statsMisses. The time is taken from
+    // mixxx::Time, so tests can control it.
+    int m_statsHits;
+    int m_statsMisses;
+    SINT m_statsZeroFilledFrames;
+    mixxx::Duration m_statsPublishedAt;
+    Counter m_hitsCounter;
+    Counter m_missesCounter;
+    Counter m_zeroFilledFramesCounter;
+    // Running totals since the reader has been created
+    ControlObject* m_pCacheHits;
+    ControlObject* m_pCacheMisses;
+    ControlObject* m_pCacheZeroFilledFrames;
+
+    // The misses of every minute with a loaded track are reported to
+    // measure the effectiveness of the hints.
+    Counter m_missesPerMinuteCounter;
+    mixxx::Duration m_minuteStartedAt;
+    double m_cacheMissesAtMinuteStart;
+
+    // All decoded samples of the current track if it has been preloaded
+    // by the worker, otherwise null. Owned by the engine thread until it
+    // is handed back through m_preloadReleaseFIFO.
+    SampleBuffer* m_pPreloadedSamples;
+
+    // Enables preloading whole tracks for this player, see
+    // CachingReaderWorker::kConfigKeyPreloadMaxMB for the size limit.
+    ControlPushButton* m_pPreloadTrack;
+
     CachingReaderWorker m_worker;
 };
 
@@ -2,6 +2,7 @@
 
 #include <QtDebug>
 
+#include "engine/cachingreaderdiskcache.h"
 #include "util/math.h"
 #include "util/sample.h"
 
@@ -109,6 +110,19 @@ SINT CachingReaderChunk::readSampleFrames(
     return m_frameCount;
 }
 
+SINT CachingReaderChunk::readSampleFramesFromCache(
+        const CachingReaderDiskCache& cache) {
+    DEBUG_ASSERT(isValid());
+    m_frameCount = cache.readChunk(getIndex(), m_sampleBuffer);
+    return m_frameCount;
+}
+
+void CachingReaderChunk::writeSampleFramesToCache(
+        CachingReaderDiskCache* pCache) const {
+    DEBUG_ASSERT(pCache);
+    pCache->writeChunk(getIndex(), m_sampleBuffer, m_frameCount);
+}
+
 void CachingReaderChunk::copySamples(
         CSAMPLE* sampleBuffer, SINT sampleOffset, SINT sampleCount) const {
     DEBUG_ASSERT(0 <= sampleOffset);
@@ -3,6 +3,8 @@
 
 #include "sources/audiosource.h"
 
+class CachingReaderDiskCache;
+
 // A Chunk is a memory-resident section of audio that has been cached.
 // Each chunk holds a fixed number kFrames of frames with samples for
 // kChannels.
@@ -73,6 +75,13 @@ public:
             const mixxx::AudioSourcePointer& pAudioSource,
             SINT* pMaxReadableFrameIndex);
 
+    // Read the sample frames from the decoded audio cache instead
+    // of the audio source. Returns 0 if the chunk is not cached.
+    SINT readSampleFramesFromCache(const CachingReaderDiskCache& cache);
+
+    // Store the sample frames that have been read in the cache.
+    void writeSampleFramesToCache(CachingReaderDiskCache* pCache) const;
+
     // Copy sampleCount samples starting at sampleOffset from
     // the chunk's internal buffer into sampleBuffer.
     void copySamples(
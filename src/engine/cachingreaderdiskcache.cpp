@@ -0,0 +1,389 @@
+#include "engine/cachingreaderdiskcache.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QtConcurrentRun>
+
+#include <atomic>
+#include <cstring>
+
+#ifdef __WINDOWS__
+#include <io.h>
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "engine/cachingreaderchunk.h"
+#include "util/logger.h"
+#include "util/math.h"
+#include "util/memory.h"
+
+const ConfigKey CachingReaderDiskCache::kConfigKeyEnabled(
+        "[DecodedAudioCache]", "Enabled");
+const ConfigKey CachingReaderDiskCache::kConfigKeyMaxSizeMB(
+        "[DecodedAudioCache]", "MaxSizeMB");
+
+namespace {
+
+const mixxx::Logger kLogger("CachingReaderDiskCache");
+
+const int kDefaultMaxSizeMB = 4096;
+
+const char kFileSuffix[] = "pcm";
+
+const char kMagic[8] = {'M', 'X', 'X', 'P', 'C', 'M', '\0', '\0'};
+const quint32 kVersion = 2;
+
+// The sample data starts at a page boundary
+const qint64 kPageSize = 4096;
+
+const quint8 kChunkMissing = 0;
+const quint8 kChunkCached = 1;
+
+// Syncing is expensive, so the chunks are synced in batches of 4 MB
+const SINT kChunksPerSync = 64;
+
+struct FileHeader {
+    char magic[8];
+    quint32 version;
+    quint32 channelCount;
+    quint32 samplingRate;
+    quint32 chunkFrames;
+    qint64 frameCount;
+    // SHA-1 of the decoder name
+    char decoderId[20];
+};
+
+// Compares the fields, since the padding of the struct is undefined in
+// files that have been written by earlier versions
+bool isSameHeader(const FileHeader& lhs, const FileHeader& rhs) {
+    return std::memcmp(lhs.magic, rhs.magic, sizeof(lhs.magic)) == 0 &&
+            lhs.version == rhs.version &&
+            lhs.channelCount == rhs.channelCount &&
+            lhs.samplingRate == rhs.samplingRate &&
+            lhs.chunkFrames == rhs.chunkFrames &&
+            lhs.frameCount == rhs.frameCount &&
+            std::memcmp(lhs.decoderId, rhs.decoderId,
+                    sizeof(lhs.decoderId)) == 0;
+}
+
+// The number of CachingReaderDiskCache instances per file that are open
+// in this process. Guarded by s_openFilesMutex, which is also held while
+// pruning the cache directory.
+QMutex s_openFilesMutex;
+QHash<QString, int> s_openFiles;
+bool s_pruned = false;
+
+qint64 samplesOffset(SINT chunkCount) {
+    const qint64 headerSize = sizeof(FileHeader) + chunkCount;
+    return ((headerSize + kPageSize - 1) / kPageSize) * kPageSize;
+}
+
+QString cacheFileName(const TrackPointer& pTrack) {
+    const QFileInfo fileInfo(pTrack->getLocation());
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(fileInfo.absoluteFilePath().toUtf8());
+    hash.addData(QByteArray::number(fileInfo.size()));
+    hash.addData(QByteArray::number(fileInfo.lastModified().toMSecsSinceEpoch()));
+    return QString::fromLatin1(hash.result().toHex()) + '.' + kFileSuffix;
+}
+
+// The space that a sparse file actually occupies on disk
+qint64 allocatedFileSize(const QFileInfo& fileInfo) {
+#ifdef __WINDOWS__
+    DWORD high = 0;
+    const DWORD low = GetCompressedFileSizeW(reinterpret_cast<LPCWSTR>(
+            QDir::toNativeSeparators(fileInfo.absoluteFilePath()).utf16()),
+            &high);
+    if (low == INVALID_FILE_SIZE && GetLastError() != NO_ERROR) {
+        return fileInfo.size();
+    }
+    return (qint64(high) << 32) | low;
+#else
+    struct stat fileStat;
+    if (stat(QFile::encodeName(fileInfo.absoluteFilePath()).constData(),
+            &fileStat) != 0) {
+        return fileInfo.size();
+    }
+    return qint64(fileStat.st_blocks) * 512;
+#endif
+}
+
+} // anonymous namespace
+
+// static
+QString CachingReaderDiskCache::cacheDirPath(const UserSettingsPointer& pConfig) {
+    return QDir(pConfig->getSettingsPath()).filePath("audiocache");
+}
+
+// static
+std::unique_ptr<CachingReaderDiskCache> CachingReaderDiskCache::openForTrack(
+        const UserSettingsPointer& pConfig,
+        const TrackPointer& pTrack,
+        const mixxx::AudioSourcePointer& pAudioSource,
+        const QString& decoderName) {
+    if (!pConfig || !pTrack || !pAudioSource ||
+            !pConfig->getValue(kConfigKeyEnabled, false)) {
+        return nullptr;
+    }
+    if (pAudioSource->getFrameCount() <= 0) {
+        return nullptr;
+    }
+
+    const QString dirPath = cacheDirPath(pConfig);
+    if (!QDir().mkpath(dirPath)) {
+        kLogger.warning() << "Failed to create cache directory" << dirPath;
+        return nullptr;
+    }
+    const QString filePath = QDir(dirPath).filePath(cacheFileName(pTrack));
+    auto pCache = std::make_unique<CachingReaderDiskCache>(filePath,
+            decoderName,
+            pAudioSource->getFrameCount(),
+            CachingReaderChunk::kChannels,
+            pAudioSource->getSamplingRate());
+
+    bool prune = false;
+    {
+        QMutexLocker locker(&s_openFilesMutex);
+        prune = !s_pruned;
+        s_pruned = true;
+    }
+    if (prune) {
+        const qint64 maxSizeBytes = qint64(pConfig->getValue(
+                kConfigKeyMaxSizeMB, kDefaultMaxSizeMB)) * 1024 * 1024;
+        QtConcurrent::run(&CachingReaderDiskCache::pruneCacheDir,
+                dirPath, maxSizeBytes);
+    }
+
+    if (!pCache->isValid()) {
+        return nullptr;
+    }
+    return pCache;
+}
+
+CachingReaderDiskCache::CachingReaderDiskCache(const QString& filePath,
+        const QString& decoderName,
+        SINT frameCount, SINT channelCount, SINT samplingRate)
+        : m_file(filePath),
+          m_decoderId(QCryptographicHash::hash(
+                  decoderName.toUtf8(), QCryptographicHash::Sha1)),
+          m_frameCount(frameCount),
+          m_channelCount(channelCount),
+          m_samplingRate(samplingRate),
+          m_chunkCount((frameCount + CachingReaderChunk::kFrames - 1) /
+                  CachingReaderChunk::kFrames),
+          m_pMapped(nullptr),
+          m_pChunkFlags(nullptr),
+          m_pSamples(nullptr),
+          m_mappedSize(0),
+          m_unsyncedChunks(m_chunkCount, false),
+          m_unsyncedChunkCount(0) {
+    {
+        // Registered before the file is created to protect
+        // it from being pruned.
+        QMutexLocker locker(&s_openFilesMutex);
+        ++s_openFiles[QFileInfo(filePath).absoluteFilePath()];
+    }
+    bool incompatible = false;
+    if (!open(&incompatible)) {
+        m_file.close();
+        if (incompatible) {
+            // Remove files from a previous version or decoder, unless
+            // another instance uses the file
+            QMutexLocker locker(&s_openFilesMutex);
+            if (s_openFiles.value(QFileInfo(filePath).absoluteFilePath()) <= 1) {
+                m_file.remove();
+            }
+        }
+    }
+}
+
+CachingReaderDiskCache::~CachingReaderDiskCache() {
+    if (m_pMapped) {
+        sync();
+        m_file.unmap(m_pMapped);
+    }
+    m_file.close();
+    QMutexLocker locker(&s_openFilesMutex);
+    const QString filePath = QFileInfo(m_file.fileName()).absoluteFilePath();
+    if (--s_openFiles[filePath] <= 0) {
+        s_openFiles.remove(filePath);
+    }
+}
+
+bool CachingReaderDiskCache::open(bool* pIncompatible) {
+    FileHeader header = {};
+    std::memcpy(header.magic, kMagic, sizeof(header.magic));
+    header.version = kVersion;
+    header.channelCount = m_channelCount;
+    header.samplingRate = m_samplingRate;
+    header.chunkFrames = CachingReaderChunk::kFrames;
+    header.frameCount = m_frameCount;
+    DEBUG_ASSERT(m_decoderId.size() == sizeof(header.decoderId));
+    std::memcpy(header.decoderId, m_decoderId.constData(),
+            sizeof(header.decoderId));
+
+    const qint64 fileSize = samplesOffset(m_chunkCount) +
+            qint64(m_frameCount) * m_channelCount * sizeof(CSAMPLE);
+
+    const bool exists = m_file.exists();
+    if (!m_file.open(QIODevice::ReadWrite)) {
+        kLogger.warning() << "Failed to open" << m_file.fileName();
+        return false;
+    }
+    if (exists) {
+        FileHeader existingHeader = {};
+        if (m_file.size() == fileSize &&
+                m_file.read(reinterpret_cast<char*>(&existingHeader),
+                        sizeof(existingHeader)) != sizeof(existingHeader)) {
+            kLogger.warning() << "Failed to read header of" << m_file.fileName();
+            return false;
+        }
+        if (m_file.size() != fileSize || !isSameHeader(header, existingHeader)) {
+            // Also after the decoder has been changed or updated
+            kLogger.debug() << "Discarding incompatible cache file"
+                    << m_file.fileName();
+            *pIncompatible = true;
+            return false;
+        }
+    } else if (!m_file.resize(fileSize)) {
+        // The file is sparse and only occupies disk space
+        // for the chunks that have actually been written.
+        kLogger.warning() << "Failed to resize" << m_file.fileName();
+        return false;
+    }
+    // (Re-)writing the header also marks the file as recently
+    // used by updating its modification time.
+    if (!m_file.seek(0) ||
+            m_file.write(reinterpret_cast<const char*>(&header),
+                    sizeof(header)) != sizeof(header) ||
+            !m_file.flush()) {
+        kLogger.warning() << "Failed to write header of" << m_file.fileName();
+        return false;
+    }
+
+    m_pMapped = m_file.map(0, fileSize);
+    if (!m_pMapped) {
+        kLogger.warning() << "Failed to map" << m_file.fileName()
+                << m_file.errorString();
+        return false;
+    }
+    m_mappedSize = fileSize;
+    m_pChunkFlags = m_pMapped + sizeof(FileHeader);
+    m_pSamples = reinterpret_cast<CSAMPLE*>(m_pMapped + samplesOffset(m_chunkCount));
+    return true;
+}
+
+SINT CachingReaderDiskCache::chunkFrameCount(SINT chunkIndex) const {
+    DEBUG_ASSERT(0 <= chunkIndex);
+    const SINT firstFrame = CachingReaderChunk::frameForIndex(chunkIndex);
+    return math_max(SINT(0), math_min(
+            CachingReaderChunk::kFrames, m_frameCount - firstFrame));
+}
+
+bool CachingReaderDiskCache::containsChunk(SINT chunkIndex) const {
+    if (!isValid() || chunkIndex < 0 || chunkIndex >= m_chunkCount) {
+        return false;
+    }
+    if (m_unsyncedChunks[chunkIndex]) {
+        return true;
+    }
+    // The same file might be written by the reader of another deck that
+    // has loaded the same track.
+    const bool cached = static_cast<volatile const quint8*>(
+            m_pChunkFlags)[chunkIndex] == kChunkCached;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return cached;
+}
+
+SINT CachingReaderDiskCache::readChunk(SINT chunkIndex, CSAMPLE* pDest) const {
+    if (!containsChunk(chunkIndex)) {
+        return 0;
+    }
+    const SINT frameCount = chunkFrameCount(chunkIndex);
+    std::memcpy(pDest,
+            m_pSamples + CachingReaderChunk::frames2samples(
+                    CachingReaderChunk::frameForIndex(chunkIndex)),
+            CachingReaderChunk::frames2samples(frameCount) * sizeof(CSAMPLE));
+    return frameCount;
+}
+
+void CachingReaderDiskCache::writeChunk(
+        SINT chunkIndex, const CSAMPLE* pSrc, SINT frameCount) {
+    if (!isValid() || chunkIndex < 0 || chunkIndex >= m_chunkCount) {
+        return;
+    }
+    if (frameCount != chunkFrameCount(chunkIndex) ||
+            containsChunk(chunkIndex)) {
+        return;
+    }
+    std::memcpy(m_pSamples + CachingReaderChunk::frames2samples(
+                    CachingReaderChunk::frameForIndex(chunkIndex)),
+            pSrc,
+            CachingReaderChunk::frames2samples(frameCount) * sizeof(CSAMPLE));
+    m_unsyncedChunks[chunkIndex] = true;
+    if (++m_unsyncedChunkCount >= kChunksPerSync) {
+        sync();
+    }
+}
+
+void CachingReaderDiskCache::sync() {
+    if (m_unsyncedChunkCount == 0) {
+        return;
+    }
+    if (!syncMapping()) {
+        // The chunks stay available until the file is closed, but
+        // they are never marked as cached in the file.
+        kLogger.warning() << "Failed to sync" << m_file.fileName();
+        return;
+    }
+    // Publish the chunks after their samples have been written
+    std::atomic_thread_fence(std::memory_order_release);
+    for (SINT chunkIndex = 0; chunkIndex < m_chunkCount; ++chunkIndex) {
+        if (m_unsyncedChunks[chunkIndex]) {
+            static_cast<volatile quint8*>(m_pChunkFlags)[chunkIndex] = kChunkCached;
+            m_unsyncedChunks[chunkIndex] = false;
+        }
+    }
+    m_unsyncedChunkCount = 0;
+}
+
+bool CachingReaderDiskCache::syncMapping() {
+    // Only the dirty pages are written
+#ifdef __WINDOWS__
+    return FlushViewOfFile(m_pMapped, 0) &&
+            FlushFileBuffers(reinterpret_cast<HANDLE>(
+                    _get_osfhandle(m_file.handle())));
+#else
+    return msync(m_pMapped, m_mappedSize, MS_SYNC) == 0;
+#endif
+}
+
+// static
+void CachingReaderDiskCache::pruneCacheDir(const QString& dirPath,
+        qint64 maxSizeBytes) {
+    // Most recently modified files first
+    const QFileInfoList files = QDir(dirPath).entryInfoList(
+            QStringList() << QString("*.") + kFileSuffix,
+            QDir::Files, QDir::Time);
+    qint64 totalSize = 0;
+    for (const QFileInfo& fileInfo: files) {
+        // Held while deleting, so that no reader opens the file meanwhile
+        QMutexLocker locker(&s_openFilesMutex);
+        // Files that are open are counted, but never deleted
+        totalSize += allocatedFileSize(fileInfo);
+        if (totalSize > maxSizeBytes &&
+                !s_openFiles.contains(fileInfo.absoluteFilePath())) {
+            kLogger.debug() << "Deleting least recently used cache file"
+                    << fileInfo.fileName();
+            QFile::remove(fileInfo.absoluteFilePath());
+        }
+    }
+}
@@ -0,0 +1,111 @@
+#ifndef ENGINE_CACHINGREADERDISKCACHE_H
+#define ENGINE_CACHINGREADERDISKCACHE_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+
+#include <memory>
+#include <vector>
+
+#include "preferences/usersettings.h"
+#include "sources/audiosource.h"
+#include "track/track.h"
+#include "util/types.h"
+
+// A persistent on-disk cache of the decoded sample data of a single track.
+//
+// The decoded stereo samples are stored in a sparse file that is memory-mapped
+// by the CachingReaderWorker. Chunks that have been decoded once are copied
+// into the file and subsequent read requests for the same chunk, even after
+// the track has been reloaded, are served from the mapped file instead of
+// seeking and decoding again. Reading a cached chunk is a plain memcpy that
+// at most causes a page fault.
+//
+// The cache files are identified by the location, size and modification time
+// of the track file. The header stores the decoder that has produced the
+// samples, so files from another decoder or version are discarded. Once per
+// session the least recently used files are deleted in the background until
+// the space that the cache directory occupies on disk is within the
+// configured limit. Files that are currently open are never deleted.
+//
+// New chunks are only marked as cached in the file after their samples have
+// been synced to disk, so a crash can never leave a chunk that is marked as
+// cached without its samples.
+//
+// Only accessed by the worker thread of a single CachingReader.
+class CachingReaderDiskCache {
+  public:
+    static const ConfigKey kConfigKeyEnabled;
+    static const ConfigKey kConfigKeyMaxSizeMB;
+
+    // Returns the directory of the cache files
+    static QString cacheDirPath(const UserSettingsPointer& pConfig);
+
+    // Opens the existing cache file for the track or creates a new one.
+    // The decoder name identifies the SoundSource provider that decodes the
+    // audio source. Returns nullptr if the cache is disabled or the file
+    // could not be mapped, e.g. due to the address space limits on 32-bit
+    // systems.
+    static std::unique_ptr<CachingReaderDiskCache> openForTrack(
+            const UserSettingsPointer& pConfig,
+            const TrackPointer& pTrack,
+            const mixxx::AudioSourcePointer& pAudioSource,
+            const QString& decoderName);
+
+    // Use openForTrack()
+    CachingReaderDiskCache(const QString& filePath, const QString& decoderName,
+            SINT frameCount, SINT channelCount, SINT samplingRate);
+    virtual ~CachingReaderDiskCache();
+
+    bool isValid() const {
+        return m_pMapped != nullptr;
+    }
+
+    // The number of frames that a completely decoded chunk contains
+    SINT chunkFrameCount(SINT chunkIndex) const;
+
+    bool containsChunk(SINT chunkIndex) const;
+
+    // Copies the cached samples of a chunk into pDest. Returns the number
+    // of frames that have been copied or 0 if the chunk is not cached.
+    SINT readChunk(SINT chunkIndex, CSAMPLE* pDest) const;
+
+    // Stores the samples of a completely decoded chunk. Chunks that have
+    // not been decoded completely are not stored.
+    void writeChunk(SINT chunkIndex, const CSAMPLE* pSrc, SINT frameCount);
+
+    // Syncs the samples of the chunks that have been written since the
+    // last sync to disk and then marks them as cached in the file.
+    void sync();
+
+    // Deletes the least recently used cache files that are not open until
+    // the space that they occupy on disk does not exceed the limit anymore.
+    static void pruneCacheDir(const QString& dirPath, qint64 maxSizeBytes);
+
+  private:
+    // Sets *pIncompatible if the file has been written for another version,
+    // decoder or audio format.
+    bool open(bool* pIncompatible);
+    bool syncMapping();
+
+    QFile m_file;
+    const QByteArray m_decoderId;
+    const SINT m_frameCount;
+    const SINT m_channelCount;
+    const SINT m_samplingRate;
+    const SINT m_chunkCount;
+
+    uchar* m_pMapped;
+    // Points into the mapped file
+    quint8* m_pChunkFlags;
+    CSAMPLE* m_pSamples;
+    qint64 m_mappedSize;
+
+    // Chunks that have been written, but are not marked as cached in the
+    // file until the next sync()
+    std::vector<bool> m_unsyncedChunks;
+    SINT m_unsyncedChunkCount;
+};
+
+#endif // ENGINE_CACHINGREADERDISKCACHE_H
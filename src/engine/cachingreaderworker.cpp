@@ -2,30 +2,111 @@
 #include <QFileInfo>
 #include <QMutexLocker>
 
+#include <algorithm>
+
 #include "control/controlobject.h"
 
 #include "engine/cachingreaderworker.h"
 #include "sources/soundsourceproxy.h"
 #include "util/compatibility.h"
 #include "util/event.h"
+#include "util/math.h"
+#include "util/memory.h"
+#include "util/performancetimer.h"
+#include "util/timer.h"
+#include "util/version.h"
 
+// 64 MiB hold about 3 minutes of stereo audio at 44.1 kHz
+const ConfigKey CachingReaderWorker::kConfigKeyPreloadMaxMB =
+        ConfigKey("[CachingReader]", "PreloadMaxMB");
+const int CachingReaderWorker::kDefaultPreloadMaxMB = 64;
 
 CachingReaderWorker::CachingReaderWorker(
         QString group,
+        UserSettingsPointer pConfig,
         FIFO<CachingReaderChunkReadRequest>* pChunkReadRequestFIFO,
-        FIFO<ReaderStatusUpdate>* pReaderStatusFIFO)
+        FIFO<ReaderStatusUpdate>* pReaderStatusFIFO,
+        FIFO<SampleBuffer*>* pPreloadReleaseFIFO)
         : m_group(group),
           m_tag(QString("CachingReaderWorker %1").arg(m_group)),
+          m_statId(Stat::registerTag(m_tag)),
+          m_pConfig(pConfig),
           m_pChunkReadRequestFIFO(pChunkReadRequestFIFO),
           m_pReaderStatusFIFO(pReaderStatusFIFO),
+          m_pPreloadReleaseFIFO(pPreloadReleaseFIFO),
           m_newTrackAvailable(false),
           m_maxReadableFrameIndex(mixxx::AudioSource::getMinFrameIndex()),
+          m_preloadChunkIndex(0),
+          m_decodeLatencyStatId(Stat::registerTag(
+                  QString("CachingReaderWorker %1 decode latency").arg(m_group))),
           m_stop(0) {
+    m_pDecodeLatency = std::make_unique<ControlObject>(
+            ConfigKey(m_group, "cache_decode_latency_ms"));
+    m_pDecodeLatency->setReadOnly();
+    m_pDecodeLatencyMax = std::make_unique<ControlObject>(
+            ConfigKey(m_group, "cache_decode_latency_max_ms"));
+    m_pDecodeLatencyMax->setReadOnly();
 }
 
 CachingReaderWorker::~CachingReaderWorker() {
 }
 
+SINT CachingReaderWorker::readChunkSampleFrames(CachingReaderChunk* pChunk) {
+    PerformanceTimer timer;
+    timer.start();
+
+    // Chunks that have been decoded before are read from the disk cache.
+    SINT framesRead = 0;
+    if (m_pDiskCache) {
+        framesRead = pChunk->readSampleFramesFromCache(*m_pDiskCache);
+    }
+    if (framesRead <= 0) {
+        // Try to read the data required for the chunk from the audio source
+        // and adjust the max. readable frame index if decoding errors occur.
+        framesRead = pChunk->readSampleFrames(
+                m_pAudioSource, &m_maxReadableFrameIndex);
+        if (m_pDiskCache && (0 < framesRead)) {
+            pChunk->writeSampleFramesToCache(m_pDiskCache.get());
+        }
+    }
+
+    reportDecodeLatency(timer.elapsed());
+    return framesRead;
+}
+
+void CachingReaderWorker::reportDecodeLatency(mixxx::Duration latency) {
+    const qint64 latencyMicros = latency.toIntegerMicros();
+    const double latencyMillis = latencyMicros / 1000.0;
+    m_pDecodeLatency->forceSet(latencyMillis);
+    if (latencyMillis > m_pDecodeLatencyMax->get()) {
+        m_pDecodeLatencyMax->forceSet(latencyMillis);
+    }
+    Stat::track(m_decodeLatencyStatId, Stat::DURATION_MSEC,
+            Stat::experimentFlags(kDefaultComputeFlags | Stat::HISTOGRAM),
+            latencyMillis);
+}
+
+bool CachingReaderWorker::takeNextReadRequest(
+        CachingReaderChunkReadRequest* pRequest) {
+    CachingReaderChunkReadRequest request;
+    while (m_pChunkReadRequestFIFO->read(&request, 1) == 1) {
+        const auto insertPos = std::upper_bound(
+                m_pendingReadRequests.begin(), m_pendingReadRequests.end(),
+                request,
+                [](const CachingReaderChunkReadRequest& lhs,
+                        const CachingReaderChunkReadRequest& rhs) {
+                    return lhs.priority < rhs.priority;
+                });
+        m_pendingReadRequests.insert(insertPos, request);
+    }
+    if (m_pendingReadRequests.empty()) {
+        return false;
+    }
+    *pRequest = m_pendingReadRequests.front();
+    m_pendingReadRequests.erase(m_pendingReadRequests.begin());
+    return true;
+}
+
 ReaderStatusUpdate CachingReaderWorker::processReadRequest(
         const CachingReaderChunkReadRequest& request) {
     CachingReaderChunk* pChunk = request.chunk;
@@ -38,10 +119,7 @@ ReaderStatusUpdate CachingReaderWorker::processReadRequest(
         return ReaderStatusUpdate(CHUNK_READ_INVALID, pChunk, m_maxReadableFrameIndex);
     }
 
-    // Try to read the data required for the chunk from the audio source
-    // and adjust the max. readable frame index if decoding errors occur.
-    const SINT framesRead = pChunk->readSampleFrames(
-            m_pAudioSource, &m_maxReadableFrameIndex);
+    const SINT framesRead = readChunkSampleFrames(pChunk);
 
     ReaderStatus status;
     if (0 < framesRead) {
@@ -75,8 +153,9 @@ void CachingReaderWorker::run() {
 
     CachingReaderChunkReadRequest request;
 
-    Event::start(m_tag);
+    Event::start(m_statId);
     while (!load_atomic(m_stop)) {
+        deleteReleasedPreloads();
         if (m_newTrackAvailable) {
             TrackPointer pLoadTrack;
             { // locking scope
@@ -86,25 +165,35 @@ void CachingReaderWorker::run() {
                 m_newTrackAvailable = false;
             } // implicitly unlocks the mutex
             loadTrack(pLoadTrack);
-        } else if (m_pChunkReadRequestFIFO->read(&request, 1) == 1) {
+        } else if (takeNextReadRequest(&request)) {
             // Read the requested chunk and send the result
             const ReaderStatusUpdate update(processReadRequest(request));
             m_pReaderStatusFIFO->writeBlocking(&update, 1);
+        } else if (m_pPreloadSamples) {
+            // Pending read requests take precedence over the preload
+            preloadNextChunk();
         } else {
-            Event::end(m_tag);
+            Event::end(m_statId);
             m_semaRun.acquire();
-            Event::start(m_tag);
+            Event::start(m_statId);
         }
     }
 }
 
 namespace {
 
-mixxx::AudioSourcePointer openAudioSourceForReading(const TrackPointer& pTrack, const mixxx::AudioSourceConfig& audioSrcCfg) {
-    auto pAudioSource = SoundSourceProxy(pTrack).openAudioSource(audioSrcCfg);
+mixxx::AudioSourcePointer openAudioSourceForReading(const TrackPointer& pTrack,
+        const mixxx::AudioSourceConfig& audioSrcCfg, QString* pDecoderName) {
+    SoundSourceProxy proxy(pTrack);
+    auto pAudioSource = proxy.openAudioSource(audioSrcCfg);
     if (!pAudioSource) {
         qWarning() << "Failed to open file:" << pTrack->getLocation();
     }
+    // The decoded samples may change with every version
+    *pDecoderName = QString("%1 %2 %3").arg(
+            proxy.getSoundSourceProviderName(),
+            Version::version(),
+            Version::developmentRevision());
     return pAudioSource;
 }
 
@@ -117,14 +206,22 @@ void CachingReaderWorker::loadTrack(const TrackPointer& pTrack) {
     ReaderStatusUpdate status;
     status.status = TRACK_NOT_LOADED;
 
+    // Abort preloading the previous track
+    m_pPreloadSamples.reset();
+    m_pDecodeLatencyMax->forceSet(0.0);
+
     if (!pTrack) {
         // Unload track
+        m_pDiskCache.reset();
         m_pAudioSource.reset(); // Close open file handles
         m_maxReadableFrameIndex = mixxx::AudioSource::getMinFrameIndex();
         m_pReaderStatusFIFO->writeBlocking(&status, 1);
         return;
     }
 
+    // The cache of the previous track must not be used for the new one
+    m_pDiskCache.reset();
+
     QString filename = pTrack->getLocation();
     if (filename.isEmpty() || !pTrack->exists()) {
         // Must unlock before emitting to avoid deadlock
@@ -139,7 +236,8 @@ void CachingReaderWorker::loadTrack(const TrackPointer& pTrack) {
 
     mixxx::AudioSourceConfig audioSrcCfg;
     audioSrcCfg.setChannelCount(CachingReaderChunk::kChannels);
-    m_pAudioSource = openAudioSourceForReading(pTrack, audioSrcCfg);
+    QString decoderName;
+    m_pAudioSource = openAudioSourceForReading(pTrack, audioSrcCfg, &decoderName);
     if (!m_pAudioSource) {
         m_maxReadableFrameIndex = mixxx::AudioSource::getMinFrameIndex();
         // Must unlock before emitting to avoid deadlock
@@ -156,13 +254,16 @@ void CachingReaderWorker::loadTrack(const TrackPointer& pTrack) {
     // be decreased to avoid repeated reading of corrupt audio data.
     m_maxReadableFrameIndex = m_pAudioSource->getMaxFrameIndex();
 
+    m_pDiskCache = CachingReaderDiskCache::openForTrack(
+            m_pConfig, pTrack, m_pAudioSource, decoderName);
+
     status.maxReadableFrameIndex = m_maxReadableFrameIndex;
     status.status = TRACK_LOADED;
     m_pReaderStatusFIFO->writeBlocking(&status, 1);
 
     // Clear the chunks to read list.
     CachingReaderChunkReadRequest request;
-    while (m_pChunkReadRequestFIFO->read(&request, 1) == 1) {
+    while (takeNextReadRequest(&request)) {
         qDebug() << "Skipping read request for " << request.chunk->getIndex();
         status.status = CHUNK_READ_INVALID;
         status.chunk = request.chunk;
@@ -174,6 +275,64 @@ void CachingReaderWorker::loadTrack(const TrackPointer& pTrack) {
             CachingReaderChunk::frames2samples(
                     m_pAudioSource->getFrameCount());
     emit(trackLoaded(pTrack, m_pAudioSource->getSamplingRate(), sampleCount));
+
+    startPreload();
+}
+
+void CachingReaderWorker::startPreload() {
+    DEBUG_ASSERT(!m_pPreloadSamples);
+    if (ControlObject::get(ConfigKey(m_group, "preload_track")) <= 0.0) {
+        return;
+    }
+    const int maxMB = m_pConfig ?
+            m_pConfig->getValue(kConfigKeyPreloadMaxMB, kDefaultPreloadMaxMB) :
+            kDefaultPreloadMaxMB;
+    if (m_maxReadableFrameIndex <= mixxx::AudioSource::getMinFrameIndex()) {
+        return;
+    }
+    // Every chunk reads into a buffer of kSamples, including the last one
+    const SINT chunkCount =
+            CachingReaderChunk::indexForFrame(m_maxReadableFrameIndex - 1) + 1;
+    const SINT sampleCount = chunkCount * CachingReaderChunk::kSamples;
+    if (qint64(sampleCount) * qint64(sizeof(CSAMPLE)) > qint64(maxMB) * 1024 * 1024) {
+        qDebug() << m_group << "Track is too long to be preloaded:"
+                 << sampleCount << "samples";
+        return;
+    }
+    m_pPreloadSamples = std::make_unique<SampleBuffer>(sampleCount);
+    m_preloadChunkIndex = 0;
+}
+
+void CachingReaderWorker::preloadNextChunk() {
+    DEBUG_ASSERT(m_pPreloadSamples);
+    // The chunk decodes directly into its slice of the preload buffer
+    CachingReaderChunkForOwner chunk(m_pPreloadSamples->data(
+            m_preloadChunkIndex * CachingReaderChunk::kSamples));
+    chunk.init(m_preloadChunkIndex);
+    SINT framesRead = 0;
+    if (chunk.isReadable(m_pAudioSource, m_maxReadableFrameIndex)) {
+        framesRead = readChunkSampleFrames(&chunk);
+    }
+    // Decoding errors may have shortened the readable range
+    const SINT preloadedFrameIndex = math_min(
+            CachingReaderChunk::frameForIndex(m_preloadChunkIndex) + framesRead,
+            m_maxReadableFrameIndex);
+    ++m_preloadChunkIndex;
+    if ((framesRead > 0) && (preloadedFrameIndex < m_maxReadableFrameIndex)) {
+        return;
+    }
+
+    // All readable frames of the track are now available in memory
+    ReaderStatusUpdate status(TRACK_PRELOADED, nullptr, preloadedFrameIndex);
+    status.preloadedSamples = m_pPreloadSamples.release();
+    m_pReaderStatusFIFO->writeBlocking(&status, 1);
+}
+
+void CachingReaderWorker::deleteReleasedPreloads() {
+    SampleBuffer* pSamples = nullptr;
+    while (m_pPreloadReleaseFIFO->read(&pSamples, 1) == 1) {
+        delete pSamples;
+    }
 }
 
 void CachingReaderWorker::quitWait() {
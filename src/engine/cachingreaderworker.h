@@ -7,19 +7,32 @@
 #include <QThread>
 #include <QString>
 
+#include <memory>
+#include <vector>
+
 #include "engine/cachingreaderchunk.h"
+#include "engine/cachingreaderdiskcache.h"
+#include "preferences/usersettings.h"
 #include "track/track.h"
 #include "engine/engineworker.h"
 #include "sources/audiosource.h"
 #include "util/fifo.h"
+#include "util/samplebuffer.h"
+#include "util/stat.h"
 
+class ControlObject;
 
 typedef struct CachingReaderChunkReadRequest {
     CachingReaderChunk* chunk;
+    // The priority of the hint that requested the chunk. Pending requests
+    // with a lower value are served first, see Hint::priority.
+    int priority;
 
     explicit CachingReaderChunkReadRequest(
-            CachingReaderChunk* chunkArg = nullptr)
-        : chunk(chunkArg) {
+            CachingReaderChunk* chunkArg = nullptr,
+            int priorityArg = 0)
+        : chunk(chunkArg),
+          priority(priorityArg) {
     }
 } CachingReaderChunkReadRequest;
 
@@ -29,17 +42,22 @@ enum ReaderStatus {
     TRACK_LOADED,
     CHUNK_READ_SUCCESS,
     CHUNK_READ_EOF,
-    CHUNK_READ_INVALID
+    CHUNK_READ_INVALID,
+    TRACK_PRELOADED
 };
 
 typedef struct ReaderStatusUpdate {
     ReaderStatus status;
     CachingReaderChunk* chunk;
     SINT maxReadableFrameIndex;
+    // The decoded samples of the whole track for TRACK_PRELOADED. The
+    // ownership is transferred to the receiver.
+    SampleBuffer* preloadedSamples;
     ReaderStatusUpdate()
         : status(INVALID)
         , chunk(nullptr)
-        , maxReadableFrameIndex(mixxx::AudioSource::getMinFrameIndex()) {
+        , maxReadableFrameIndex(mixxx::AudioSource::getMinFrameIndex())
+        , preloadedSamples(nullptr) {
     }
     ReaderStatusUpdate(
             ReaderStatus statusArg,
@@ -47,7 +65,8 @@ typedef struct ReaderStatusUpdate {
             SINT maxReadableFrameIndexArg)
         : status(statusArg)
         , chunk(chunkArg)
-        , maxReadableFrameIndex(maxReadableFrameIndexArg) {
+        , maxReadableFrameIndex(maxReadableFrameIndexArg)
+        , preloadedSamples(nullptr) {
     }
 } ReaderStatusUpdate;
 
@@ -55,10 +74,17 @@ class CachingReaderWorker : public EngineWorker {
     Q_OBJECT
 
   public:
+    // Tracks whose decoded samples don't exceed this size are preloaded
+    // completely if preloading is enabled for the player.
+    static const ConfigKey kConfigKeyPreloadMaxMB;
+    static const int kDefaultPreloadMaxMB;
+
     // Construct a CachingReader with the given group.
     CachingReaderWorker(QString group,
+            UserSettingsPointer pConfig,
             FIFO<CachingReaderChunkReadRequest>* pChunkReadRequestFIFO,
-            FIFO<ReaderStatusUpdate>* pReaderStatusFIFO);
+            FIFO<ReaderStatusUpdate>* pReaderStatusFIFO,
+            FIFO<SampleBuffer*>* pPreloadReleaseFIFO);
     virtual ~CachingReaderWorker();
 
     // Request to load a new track. wake() must be called afterwards.
@@ -79,11 +105,16 @@ class CachingReaderWorker : public EngineWorker {
   private:
     QString m_group;
     QString m_tag;
+    Stat::Id m_statId;
+    UserSettingsPointer m_pConfig;
 
     // Thread-safe FIFOs for communication between the engine callback and
     // reader thread.
     FIFO<CachingReaderChunkReadRequest>* m_pChunkReadRequestFIFO;
     FIFO<ReaderStatusUpdate>* m_pReaderStatusFIFO;
+    // Preloaded sample buffers that are no longer used by the engine
+    // and must be deleted outside of the engine callback.
+    FIFO<SampleBuffer*>* m_pPreloadReleaseFIFO;
 
     // Queue of Tracks to load, and the corresponding lock. Must acquire the
     // lock to touch.
@@ -94,12 +125,43 @@ class CachingReaderWorker : public EngineWorker {
     // Internal method to load a track. Emits trackLoaded when finished.
     void loadTrack(const TrackPointer& pTrack);
 
+    // Moves all requests from the FIFO into the queue of pending requests
+    // and takes the one with the highest priority. Requests with the same
+    // priority are served in the order they have been issued.
+    bool takeNextReadRequest(CachingReaderChunkReadRequest* pRequest);
+
+    // Pending read requests ordered by priority
+    std::vector<CachingReaderChunkReadRequest> m_pendingReadRequests;
+
     ReaderStatusUpdate processReadRequest(
             const CachingReaderChunkReadRequest& request);
 
+    // Reads the samples of a chunk from the disk cache or decodes
+    // them from the audio source. Returns the number of frames read.
+    SINT readChunkSampleFrames(CachingReaderChunk* pChunk);
+
+    // Publishes the time it took to read the samples of a chunk.
+    void reportDecodeLatency(mixxx::Duration latency);
+
+    // Starts to decode the whole track into a contiguous buffer if
+    // enabled and the track is short enough.
+    void startPreload();
+
+    // Decodes the next chunk of the preloaded track in between the
+    // regular read requests. Hands the buffer over to the CachingReader
+    // after the last chunk has been decoded.
+    void preloadNextChunk();
+
+    // Deletes all buffers that have been released by the CachingReader.
+    void deleteReleasedPreloads();
+
     // The current audio source of the track loaded
     mixxx::AudioSourcePointer m_pAudioSource;
 
+    // Persistent cache of the decoded samples of the track loaded,
+    // null if disabled.
+    std::unique_ptr<CachingReaderDiskCache> m_pDiskCache;
+
     // The maximum readable frame index of the AudioSource. Might
     // be adjusted when decoding errors occur to prevent reading
     // the same chunk(s) over and over again.
@@ -107,6 +169,17 @@ class CachingReaderWorker : public EngineWorker {
     // last frame with readable sample data.
     SINT m_maxReadableFrameIndex;
 
+    // The buffer for preloading the whole track while it is being
+    // decoded, null if no preload is in progress.
+    std::unique_ptr<SampleBuffer> m_pPreloadSamples;
+    SINT m_preloadChunkIndex;
+
+    // Latency of the most recent and of the slowest chunk read since the
+    // track has been loaded in milliseconds.
+    Stat::Id m_decodeLatencyStatId;
+    std::unique_ptr<ControlObject> m_pDecodeLatency;
+    std::unique_ptr<ControlObject> m_pDecodeLatencyMax;
+
     QAtomicInt m_stop;
 };
 
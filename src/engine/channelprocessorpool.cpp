@@ -0,0 +1,295 @@
+#include "engine/channelprocessorpool.h"
+
+#include <QtDebug>
+
+#ifdef __LINUX__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#ifndef __WINDOWS__
+#include <pthread.h>
+#endif
+
+#include "engine/enginechannel.h"
+#include "util/compatibility.h"
+#include "util/memory.h"
+#include "util/sleepableqthread.h"
+#include "util/spinlock.h"
+
+namespace {
+
+// Roughly some 100 microseconds of busy waiting before a helper
+// thread goes to sleep, depending on the CPU.
+const int kIdleSpins = 4096;
+
+// Roughly some 10 microseconds that the callback thread waits for the
+// jobs of the helper threads before it takes over the jobs that they have
+// claimed but not started yet, e.g. because they have been preempted.
+const int kJobWaitSpins = 512;
+
+// Marks a job as started in the generation of its state
+const int kJobStarted = 0x8000;
+
+#ifndef __LINUX__
+// Without a futex sleeping helper threads poll for wake ups. The callback
+// thread never waits for a sleeping helper, a helper that wakes up late
+// only processes fewer jobs.
+const unsigned long kWakeUpPollMicros = 200;
+#endif
+
+inline int makeClaim(int generation, int numJobs, int nextJob) {
+    return (generation << 16) | (numJobs << 8) | nextJob;
+}
+
+inline int claimNumJobs(int claim) {
+    return (claim >> 8) & 0xFF;
+}
+
+inline int claimNextJob(int claim) {
+    return claim & 0xFF;
+}
+
+inline int claimGeneration(int claim) {
+    return (claim >> 16) & 0x7FFF;
+}
+
+} // anonymous namespace
+
+ChannelProcessorThread::ChannelProcessorThread(
+        ChannelProcessorPool* pPool, int threadIndex)
+        : m_pPool(pPool),
+          m_threadIndex(threadIndex) {
+}
+
+void ChannelProcessorThread::run() {
+    QThread::currentThread()->setObjectName(
+            QString("ChannelProcessor %1").arg(m_threadIndex));
+    m_pPool->workerLoop();
+}
+
+ChannelProcessorPool::ChannelProcessorPool(int numThreads)
+        : m_pJobs(nullptr),
+          m_iBufferSize(0),
+          m_generation(0),
+          m_claim(0),
+          m_jobsDone(0),
+          m_sleepingThreads(0),
+          m_wakeUps(0),
+          m_exit(0),
+          m_callbackThreadId(nullptr),
+          m_schedulingPolicy(0),
+          m_schedulingPriority(0),
+          m_schedulingSerial(0) {
+    for (int i = 0; i < numThreads; ++i) {
+        m_threads.push_back(std::make_unique<ChannelProcessorThread>(this, i));
+    }
+    for (const auto& pThread: m_threads) {
+        // The helpers take over work from the callback thread that
+        // usually runs with a real-time priority. This is sufficient on
+        // Windows, other platforms adopt the scheduling of the callback
+        // thread once it is known.
+        pThread->start(QThread::TimeCriticalPriority);
+    }
+}
+
+ChannelProcessorPool::~ChannelProcessorPool() {
+    m_exit.fetchAndStoreOrdered(1);
+    wakeUpSleepingThreads();
+    for (const auto& pThread: m_threads) {
+        pThread->wait();
+    }
+}
+
+void ChannelProcessorPool::process(const Job* pJobs, int numJobs, int iBufferSize) {
+    if (numJobs <= 1 || m_threads.empty() || numJobs > kMaxJobs) {
+        for (int i = 0; i < numJobs; ++i) {
+            pJobs[i].pChannel->processParallel(pJobs[i].pBuffer, iBufferSize);
+        }
+        return;
+    }
+
+    // The callback thread changes when the sound device is reopened
+    const Qt::HANDLE threadId = QThread::currentThreadId();
+    if (threadId != m_callbackThreadId) {
+        m_callbackThreadId = threadId;
+        publishScheduling();
+    }
+
+    m_pJobs = pJobs;
+    m_iBufferSize = iBufferSize;
+    m_jobsDone.fetchAndStoreRelaxed(0);
+    m_generation = (m_generation + 1) & 0x7FFF;
+    for (int i = 0; i < numJobs; ++i) {
+        m_jobStates[i].fetchAndStoreRelaxed(m_generation);
+    }
+    // Publishes the jobs to the helper threads. The full barrier orders
+    // the store before reading m_sleepingThreads, see workerLoop().
+    m_claim.fetchAndStoreOrdered(makeClaim(m_generation, numJobs, 0));
+    if (m_sleepingThreads.fetchAndAddOrdered(0) > 0) {
+        wakeUpSleepingThreads();
+    }
+
+    processJobs();
+
+    int spins = 0;
+    while (load_atomic(m_jobsDone) < numJobs) {
+        if (spins < kJobWaitSpins) {
+            ++spins;
+            mixxx::spinPause();
+            continue;
+        }
+        if (spins == kJobWaitSpins) {
+            ++spins;
+            // Don't wait for helper threads that have not started their
+            // jobs yet
+            for (int i = 0; i < numJobs; ++i) {
+                if (startJob(i, m_generation)) {
+                    processJob(i);
+                }
+            }
+            continue;
+        }
+        // A helper thread is still processing a job. It has the same
+        // priority and may have been preempted on this CPU.
+        QThread::yieldCurrentThread();
+    }
+    // Synchronizes with the helper threads to make their
+    // results visible in this thread.
+    m_jobsDone.fetchAndAddAcquire(0);
+}
+
+int ChannelProcessorPool::claimJob(int* pGeneration) {
+    while (true) {
+        const int claim = load_atomic(m_claim);
+        const int nextJob = claimNextJob(claim);
+        if (nextJob >= claimNumJobs(claim)) {
+            return -1;
+        }
+        // Fails if another thread has claimed the job in the meantime
+        // or if a new generation of jobs has been published.
+        if (m_claim.testAndSetAcquire(claim, claim + 1)) {
+            *pGeneration = claimGeneration(claim);
+            return nextJob;
+        }
+    }
+}
+
+bool ChannelProcessorPool::startJob(int jobIndex, int generation) {
+    // Fails if the job has been started by another thread or if a later
+    // generation of jobs has been published in the meantime
+    return m_jobStates[jobIndex].testAndSetAcquire(
+            generation, generation | kJobStarted);
+}
+
+bool ChannelProcessorPool::hasPendingJobs() const {
+    const int claim = load_atomic(m_claim);
+    return claimNextJob(claim) < claimNumJobs(claim);
+}
+
+bool ChannelProcessorPool::processJobs() {
+    bool processed = false;
+    int jobIndex;
+    int generation;
+    while ((jobIndex = claimJob(&generation)) >= 0) {
+        // The callback thread may have taken over the job
+        if (startJob(jobIndex, generation)) {
+            processJob(jobIndex);
+            processed = true;
+        }
+    }
+    return processed;
+}
+
+void ChannelProcessorPool::processJob(int jobIndex) {
+    // The published jobs stay valid until all of them are done
+    const Job& job = m_pJobs[jobIndex];
+    job.pChannel->processParallel(job.pBuffer, m_iBufferSize);
+    m_jobsDone.fetchAndAddRelease(1);
+}
+
+void ChannelProcessorPool::workerLoop() {
+    int schedulingSerial = 0;
+    int idleSpins = 0;
+    while (!load_atomic(m_exit)) {
+        if (processJobs()) {
+            idleSpins = 0;
+            continue;
+        }
+        if (idleSpins < kIdleSpins) {
+            ++idleSpins;
+            mixxx::spinPause();
+            continue;
+        }
+        // Announce that this thread is going to sleep before checking for
+        // jobs once more. Together with the full barrier in process() either
+        // the callback thread sees this thread as sleeping and wakes it up or
+        // this thread sees the new jobs. Superfluous wake ups are harmless.
+        m_sleepingThreads.fetchAndAddOrdered(1);
+        const int wakeUps = m_wakeUps.fetchAndAddOrdered(0);
+        if (!hasPendingJobs() && !load_atomic(m_exit)) {
+            waitForWakeUp(wakeUps);
+        }
+        m_sleepingThreads.fetchAndAddOrdered(-1);
+        // Not done while processing jobs, because it is a system call
+        adoptScheduling(&schedulingSerial);
+        idleSpins = 0;
+    }
+}
+
+void ChannelProcessorPool::wakeUpSleepingThreads() {
+    m_wakeUps.fetchAndAddOrdered(1);
+#ifdef __LINUX__
+    static_assert(sizeof(QAtomicInt) == sizeof(int),
+            "The futex operates on the value of the QAtomicInt");
+    syscall(SYS_futex, reinterpret_cast<int*>(&m_wakeUps),
+            FUTEX_WAKE_PRIVATE, numThreads(), nullptr, nullptr, 0);
+#endif
+}
+
+void ChannelProcessorPool::waitForWakeUp(int wakeUps) {
+#ifdef __LINUX__
+    // Returns immediately if m_wakeUps has already changed. Spurious
+    // returns only cause another round of busy waiting.
+    syscall(SYS_futex, reinterpret_cast<int*>(&m_wakeUps),
+            FUTEX_WAIT_PRIVATE, wakeUps, nullptr, nullptr, 0);
+#else
+    while (load_atomic(m_wakeUps) == wakeUps) {
+        SleepableQThread::usleep(kWakeUpPollMicros);
+    }
+#endif
+}
+
+void ChannelProcessorPool::publishScheduling() {
+#ifndef __WINDOWS__
+    int policy;
+    struct sched_param param;
+    if (pthread_getschedparam(pthread_self(), &policy, &param) != 0) {
+        return;
+    }
+    m_schedulingPolicy.fetchAndStoreRelaxed(policy);
+    m_schedulingPriority.fetchAndStoreRelaxed(param.sched_priority);
+    m_schedulingSerial.fetchAndAddRelease(1);
+#endif
+}
+
+void ChannelProcessorPool::adoptScheduling(int* pSchedulingSerial) {
+#ifndef __WINDOWS__
+    const int schedulingSerial = load_atomic_acquire(m_schedulingSerial);
+    if (schedulingSerial == *pSchedulingSerial) {
+        return;
+    }
+    *pSchedulingSerial = schedulingSerial;
+    const int policy = load_atomic(m_schedulingPolicy);
+    struct sched_param param;
+    param.sched_priority = load_atomic(m_schedulingPriority);
+    const int error = pthread_setschedparam(pthread_self(), policy, &param);
+    if (error != 0) {
+        qWarning() << "Failed to adopt the scheduling of the engine thread"
+                   << "in" << QThread::currentThread()->objectName()
+                   << "error" << error;
+    }
+#else
+    Q_UNUSED(pSchedulingSerial);
+#endif
+}
@@ -0,0 +1,124 @@
+#ifndef ENGINE_CHANNELPROCESSORPOOL_H
+#define ENGINE_CHANNELPROCESSORPOOL_H
+
+#include <QAtomicInt>
+#include <QThread>
+
+#include <memory>
+#include <vector>
+
+#include "util/types.h"
+
+class EngineChannel;
+class ChannelProcessorPool;
+
+class ChannelProcessorThread : public QThread {
+    Q_OBJECT
+  public:
+    ChannelProcessorThread(ChannelProcessorPool* pPool, int threadIndex);
+
+  protected:
+    void run() override;
+
+  private:
+    ChannelProcessorPool* const m_pPool;
+    const int m_threadIndex;
+};
+
+// A pool of pre-spawned threads that helps the engine callback thread with
+// processing independent channels in parallel.
+//
+// The callback thread publishes the channels of a callback as jobs and then
+// processes jobs itself until none are left. The helper threads claim the
+// remaining jobs with a single compare-and-swap each and start them with
+// another one. If the helper threads don't finish their jobs within a few
+// microseconds the callback thread processes the jobs that have not been
+// started yet itself, so a preempted helper thread only delays the callback
+// by the job it is processing. Nothing is allocated
+// and no lock is taken while processing. Idle helper threads busy wait for
+// a short while after the last job to be ready for the next callback
+// without a context switch, then they go to sleep until they are woken up
+// by the next callback. Waking them up is a single atomic increment and,
+// on Linux, a futex wake up without any mutex.
+//
+// The helper threads adopt the scheduling policy and priority of the
+// callback thread, because QThread priorities don't select a real-time
+// policy on Linux and macOS.
+//
+// Only EngineChannel::processParallel() is called for the jobs. It must not
+// touch state that is shared with other channels. Everything else has to
+// be done in EngineChannel::processSerial() afterwards.
+class ChannelProcessorPool {
+  public:
+    struct Job {
+        EngineChannel* pChannel;
+        CSAMPLE* pBuffer;
+    };
+
+    // The number of jobs is encoded in 8 bits of the claim word
+    static const int kMaxJobs = 255;
+
+    explicit ChannelProcessorPool(int numThreads);
+    virtual ~ChannelProcessorPool();
+
+    int numThreads() const {
+        return static_cast<int>(m_threads.size());
+    }
+
+    // Calls EngineChannel::processParallel() for all jobs and returns when
+    // all channels have been processed. Must only be called from a single
+    // thread, i.e. the engine callback.
+    void process(const Job* pJobs, int numJobs, int iBufferSize);
+
+  private:
+    friend class ChannelProcessorThread;
+
+    void workerLoop();
+    void waitForWakeUp(int wakeUps);
+    void wakeUpSleepingThreads();
+    // Publishes the scheduling of the calling thread to the helper threads
+    void publishScheduling();
+    // Adopts the published scheduling in a helper thread
+    void adoptScheduling(int* pSchedulingSerial);
+
+    // Processes jobs until none are left, returns false if no job has
+    // been processed at all.
+    bool processJobs();
+    // Returns the index of the claimed job and its generation or -1 if no
+    // job is left.
+    int claimJob(int* pGeneration);
+    // Returns false if the job has already been started.
+    bool startJob(int jobIndex, int generation);
+    void processJob(int jobIndex);
+    bool hasPendingJobs() const;
+
+    std::vector<std::unique_ptr<ChannelProcessorThread>> m_threads;
+
+    // Only written by the callback thread while no job is pending
+    const Job* m_pJobs;
+    int m_iBufferSize;
+    int m_generation;
+
+    // Generation (bits 16-30) | number of jobs (bits 8-15) | next job (bits 0-7)
+    // The generation prevents that a helper thread that has been preempted
+    // claims a job from a later callback with the job count of an earlier one.
+    QAtomicInt m_claim;
+    QAtomicInt m_jobsDone;
+    // The generation of each job, with a flag that is set once the job has
+    // been started
+    QAtomicInt m_jobStates[kMaxJobs];
+    QAtomicInt m_sleepingThreads;
+    // Incremented for waking up sleeping helper threads, which wait for
+    // it to change.
+    QAtomicInt m_wakeUps;
+    QAtomicInt m_exit;
+
+    // The scheduling of the callback thread. The serial is incremented
+    // after both have been written.
+    Qt::HANDLE m_callbackThreadId;
+    QAtomicInt m_schedulingPolicy;
+    QAtomicInt m_schedulingPriority;
+    QAtomicInt m_schedulingSerial;
+};
+
+#endif /* ENGINE_CHANNELPROCESSORPOOL_H */
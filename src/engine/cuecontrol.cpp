@@ -552,7 +552,7 @@ void CueControl::hintReader(HintVector* pHintList) {
     if (cuePoint >= 0) {
         cue_hint.frame = SampleUtil::floorPlayPosToFrame(m_pCuePoint->get());
         cue_hint.frameCount = Hint::kFrameCountForward;
-        cue_hint.priority = 10;
+        cue_hint.priority = Hint::kPriorityCue;
         pHintList->append(cue_hint);
     }
 
@@ -564,7 +564,7 @@ void CueControl::hintReader(HintVector* pHintList) {
         if (position != -1) {
             cue_hint.frame = SampleUtil::floorPlayPosToFrame(position);
             cue_hint.frameCount = Hint::kFrameCountForward;
-            cue_hint.priority = 10;
+            cue_hint.priority = Hint::kPriorityCue;
             pHintList->append(cue_hint);
         }
     }
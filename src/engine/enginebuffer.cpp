@@ -202,7 +202,10 @@ EngineBuffer::EngineBuffer(QString group, UserSettingsPointer pConfig,
 
     m_pEngineSync = pMixingEngine->getEngineSync();
 
-    m_pSyncControl = new SyncControl(group, pConfig, pChannel, m_pEngineSync);
+    m_pSyncNotifications = new SyncNotificationQueue(m_pEngineSync);
+
+    m_pSyncControl = new SyncControl(group, pConfig, pChannel,
+                                     m_pSyncNotifications);
     addControl(m_pSyncControl);
 
 #ifdef __VINYLCONTROL__
@@ -309,6 +312,7 @@ EngineBuffer::~EngineBuffer() {
     SampleUtil::free(m_pCrossfadeBuffer);
 
     qDeleteAll(m_engineControls);
+    delete m_pSyncNotifications;
 }
 
 double EngineBuffer::fractionalPlayposFromAbsolute(double absolutePlaypos) {
@@ -392,7 +396,7 @@ void EngineBuffer::requestSyncPhase() {
 void EngineBuffer::requestEnableSync(bool enabled) {
     // If we're not playing, the queued event won't get processed so do it now.
     if (m_playButton->get() == 0.0) {
-        m_pEngineSync->requestEnableSync(m_pSyncControl, enabled);
+        m_pSyncNotifications->requestEnableSync(m_pSyncControl, enabled);
         return;
     }
     SyncRequestQueued enable_request =
@@ -417,7 +421,7 @@ void EngineBuffer::requestEnableSync(bool enabled) {
 void EngineBuffer::requestSyncMode(SyncMode mode) {
     // If we're not playing, the queued event won't get processed so do it now.
     if (m_playButton->get() == 0.0) {
-        m_pEngineSync->requestSyncMode(m_pSyncControl, mode);
+        m_pSyncNotifications->requestSyncMode(m_pSyncControl, mode);
     } else {
         m_iSyncModeQueued = mode;
     }
@@ -1114,20 +1118,20 @@ void EngineBuffer::processSyncRequests() {
             static_cast<SyncMode>(m_iSyncModeQueued.fetchAndStoreRelease(SYNC_INVALID));
     switch (enable_request) {
     case SYNC_REQUEST_ENABLE:
-        m_pEngineSync->requestEnableSync(m_pSyncControl, true);
+        m_pSyncNotifications->requestEnableSync(m_pSyncControl, true);
         break;
     case SYNC_REQUEST_DISABLE:
-        m_pEngineSync->requestEnableSync(m_pSyncControl, false);
+        m_pSyncNotifications->requestEnableSync(m_pSyncControl, false);
         break;
     case SYNC_REQUEST_ENABLEDISABLE:
-        m_pEngineSync->requestEnableSync(m_pSyncControl, true);
-        m_pEngineSync->requestEnableSync(m_pSyncControl, false);
+        m_pSyncNotifications->requestEnableSync(m_pSyncControl, true);
+        m_pSyncNotifications->requestEnableSync(m_pSyncControl, false);
         break;
     case SYNC_REQUEST_NONE:
         break;
     }
     if (mode_request != SYNC_INVALID) {
-        m_pEngineSync->requestSyncMode(m_pSyncControl,
+        m_pSyncNotifications->requestSyncMode(m_pSyncControl,
                                        static_cast<SyncMode>(mode_request));
     }
 }
@@ -1184,7 +1188,7 @@ void EngineBuffer::postProcess(const int iBufferSize) {
     SyncMode mode = m_pSyncControl->getSyncMode();
     if (mode == SYNC_MASTER) {
         m_pSyncControl->setLocalBpm(local_bpm);
-        m_pEngineSync->notifyBeatDistanceChanged(m_pSyncControl, beat_distance);
+        m_pSyncNotifications->notifyBeatDistanceChanged(m_pSyncControl, beat_distance);
     } else if (mode == SYNC_FOLLOWER) {
         // Report our speed to SyncControl.  If we are master, we already did this.
         m_pSyncControl->setLocalBpm(local_bpm);
@@ -1238,6 +1242,11 @@ void EngineBuffer::updateIndicators(double speed, int iBufferSize) {
 }
 
 void EngineBuffer::hintReader(const double dRate) {
+    if (m_pReader->isTrackPreloaded()) {
+        // Every position of the track can be read without a cache miss
+        return;
+    }
+
     m_hintList.clear();
     m_pReadAheadManager->hintReader(dRate, &m_hintList);
 
@@ -1245,7 +1254,7 @@ void EngineBuffer::hintReader(const double dRate) {
     if (m_bSlipEnabledProcessing) {
         Hint hint;
         hint.frame = SampleUtil::floorPlayPosToFrame(m_dSlipPosition);
-        hint.priority = 1;
+        hint.priority = Hint::kPriorityImminent;
         if (m_dSlipRate >= 0) {
             hint.frameCount = Hint::kFrameCountForward;
         } else {
@@ -1257,6 +1266,17 @@ void EngineBuffer::hintReader(const double dRate) {
     for (const auto& pControl: m_engineControls) {
         pControl->hintReader(&m_hintList);
     }
+    // Chunks that are hinted more than once are requested with the
+    // priority of the most urgent hint. The list is short and almost
+    // sorted, so an insertion sort does the job without allocating.
+    for (int i = 1; i < m_hintList.size(); ++i) {
+        const Hint hint = m_hintList[i];
+        int j = i;
+        for (; (j > 0) && (m_hintList[j - 1].priority > hint.priority); --j) {
+            m_hintList[j] = m_hintList[j - 1];
+        }
+        m_hintList[j] = hint;
+    }
     m_pReader->hintAndMaybeWake(m_hintList);
 }
 
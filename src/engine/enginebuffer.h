@@ -27,6 +27,7 @@
 #include "control/controlvalue.h"
 #include "engine/engineobject.h"
 #include "engine/sync/syncable.h"
+#include "engine/sync/syncnotificationqueue.h"
 #include "track/track.h"
 #include "util/rotary.h"
 #include "util/types.h"
@@ -130,6 +131,16 @@ class EngineBuffer : public EngineObject {
     void processSlip(int iBufferSize);
     void postProcess(const int iBufferSize);
 
+    // While the deck is processed in parallel with other channels, its sync
+    // notifications from the processing thread are queued until they are
+    // flushed in the engine thread.
+    void beginQueueingSyncNotifications() {
+        m_pSyncNotifications->beginQueueing();
+    }
+    void flushSyncNotifications() {
+        m_pSyncNotifications->flush();
+    }
+
     QString getGroup();
     bool isTrackLoaded();
     TrackPointer getLoadedTrack() const;
@@ -243,6 +254,8 @@ class EngineBuffer : public EngineObject {
     FRIEND_TEST(EngineSyncTest, UserTweakBeatDistance);
     FRIEND_TEST(EngineBufferTest, ScalerNoTransport);
     EngineSync* m_pEngineSync;
+    // All calls to EngineSync go through here
+    SyncNotificationQueue* m_pSyncNotifications;
     SyncControl* m_pSyncControl;
     VinylControlControl* m_pVinylControlControl;
     RateControl* m_pRateControl;
@@ -65,6 +65,19 @@ class EngineChannel : public EngineObject {
     virtual void process(CSAMPLE* pOut, const int iBufferSize) = 0;
     virtual void postProcess(const int iBuffersize) = 0;
 
+    // Used instead of process() if channels are processed in parallel.
+    // processParallel() may be called from any engine thread concurrently
+    // with other channels, so it must not touch state that is shared with
+    // them. processSerial() completes the buffer afterwards in the engine
+    // thread. By default the whole channel is processed serially.
+    virtual void processParallel(CSAMPLE* pOut, const int iBufferSize) {
+        Q_UNUSED(pOut);
+        Q_UNUSED(iBufferSize);
+    }
+    virtual void processSerial(CSAMPLE* pOut, const int iBufferSize) {
+        process(pOut, iBufferSize);
+    }
+
     // TODO(XXX) This hack needs to be removed.
     virtual EngineBuffer* getEngineBuffer() {
         return NULL;
@@ -39,7 +39,8 @@ EngineDeck::EngineDeck(const ChannelHandleAndGroup& handle_group,
           // Need a +1 here because the CircularBuffer only allows its size-1
           // items to be held at once (it keeps a blank spot open persistently)
           m_sampleBuffer(NULL),
-          m_wasActive(false) {
+          m_wasActive(false),
+          m_bBufferCleared(false) {
     if (pEffectsManager != NULL) {
         pEffectsManager->registerChannel(handle_group);
     }
@@ -75,7 +76,25 @@ EngineDeck::~EngineDeck() {
 }
 
 void EngineDeck::process(CSAMPLE* pOut, const int iBufferSize) {
-    GroupFeatureState features;
+    if (processBuffer(pOut, iBufferSize)) {
+        processEffects(pOut, iBufferSize);
+    }
+}
+
+void EngineDeck::processParallel(CSAMPLE* pOut, const int iBufferSize) {
+    m_pBuffer->beginQueueingSyncNotifications();
+    m_bBufferCleared = !processBuffer(pOut, iBufferSize);
+}
+
+void EngineDeck::processSerial(CSAMPLE* pOut, const int iBufferSize) {
+    m_pBuffer->flushSyncNotifications();
+    if (!m_bBufferCleared) {
+        processEffects(pOut, iBufferSize);
+    }
+}
+
+bool EngineDeck::processBuffer(CSAMPLE* pOut, const int iBufferSize) {
+    m_features = GroupFeatureState();
     // Feed the incoming audio through if passthrough is active
     const CSAMPLE* sampleBuffer = m_sampleBuffer; // save pointer on stack
     if (isPassthroughActive() && sampleBuffer) {
@@ -88,27 +107,31 @@ void EngineDeck::process(CSAMPLE* pOut, const int iBufferSize) {
         if (m_bPassthroughWasActive) {
             SampleUtil::clear(pOut, iBufferSize);
             m_bPassthroughWasActive = false;
-            return;
+            return false;
         }
 
         // Process the raw audio
         m_pBuffer->process(pOut, iBufferSize);
-        m_pBuffer->collectFeatures(&features);
+        m_pBuffer->collectFeatures(&m_features);
         m_pPregain->setSpeedAndScratching(m_pBuffer->getSpeed(), m_pBuffer->getScratching());
         m_bPassthroughWasActive = false;
     }
 
     // Apply pregain
     m_pPregain->process(pOut, iBufferSize);
+    return true;
+}
+
+void EngineDeck::processEffects(CSAMPLE* pOut, const int iBufferSize) {
     // Process effects enabled for this channel
     if (m_pEngineEffectsManager != NULL) {
         // This is out of date by a callback but some effects will want the RMS
         // volume.
-        m_pVUMeter->collectFeatures(&features);
-        m_pPregain->collectFeatures(&features);
+        m_pVUMeter->collectFeatures(&m_features);
+        m_pPregain->collectFeatures(&m_features);
         m_pEngineEffectsManager->process(
                 getHandle(), pOut, iBufferSize,
-                static_cast<unsigned int>(m_pSampleRate->get()), features);
+                static_cast<unsigned int>(m_pSampleRate->get()), m_features);
     }
     // Update VU meter
     m_pVUMeter->process(pOut, iBufferSize);
@@ -25,6 +25,7 @@
 #include "control/controlpushbutton.h"
 #include "engine/engineobject.h"
 #include "engine/enginechannel.h"
+#include "engine/effects/groupfeaturestate.h"
 #include "util/circularbuffer.h"
 
 #include "soundio/soundmanagerutil.h"
@@ -49,6 +50,11 @@ class EngineDeck : public EngineChannel, public AudioDestination {
     virtual void process(CSAMPLE* pOutput, const int iBufferSize);
     virtual void postProcess(const int iBufferSize);
 
+    // Decodes, scales and pregains the deck in parallel with other decks and
+    // queues its sync notifications. Effects and the VU meter follow serially.
+    void processParallel(CSAMPLE* pOutput, const int iBufferSize) override;
+    void processSerial(CSAMPLE* pOutput, const int iBufferSize) override;
+
     // TODO(XXX) This hack needs to be removed.
     virtual EngineBuffer* getEngineBuffer();
 
@@ -77,6 +83,11 @@ class EngineDeck : public EngineChannel, public AudioDestination {
     void slotPassingToggle(double v);
 
   private:
+    // Returns false if the buffer has been cleared and must not be processed
+    // any further.
+    bool processBuffer(CSAMPLE* pOut, const int iBufferSize);
+    void processEffects(CSAMPLE* pOut, const int iBufferSize);
+
     UserSettingsPointer m_pConfig;
     EngineBuffer* m_pBuffer;
     EnginePregain* m_pPregain;
@@ -91,6 +102,10 @@ class EngineDeck : public EngineChannel, public AudioDestination {
     bool m_bPassthroughIsActive;
     bool m_bPassthroughWasActive;
     bool m_wasActive;
+
+    // Passed from processBuffer() to processEffects()
+    GroupFeatureState m_features;
+    bool m_bBufferCleared;
 };
 
 #endif
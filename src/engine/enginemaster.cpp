@@ -54,6 +54,18 @@ EngineMaster::EngineMaster(UserSettingsPointer pConfig,
     m_pWorkerScheduler = new EngineWorkerScheduler(this);
     m_pWorkerScheduler->start(QThread::HighPriority);
 
+    // Optionally process channels on multiple threads including the
+    // callback thread. Disabled by default.
+    const int engineThreads = math_min(
+            pConfig->getValue(ConfigKey(group, "engine_threads"), 1),
+            QThread::idealThreadCount());
+    if (engineThreads > 1) {
+        qDebug() << "Processing channels on" << engineThreads << "threads";
+        m_pChannelProcessorPool = new ChannelProcessorPool(engineThreads - 1);
+    } else {
+        m_pChannelProcessorPool = nullptr;
+    }
+
     if (pEffectsManager) {
         pEffectsManager->registerChannel(m_masterHandle);
         pEffectsManager->registerChannel(m_headphoneHandle);
@@ -191,6 +203,7 @@ EngineMaster::EngineMaster(UserSettingsPointer pConfig,
 
 EngineMaster::~EngineMaster() {
     qDebug() << "in ~EngineMaster()";
+    delete m_pChannelProcessorPool;
     delete m_pKeylockEngine;
     delete m_pCrossfader;
     delete m_pBalance;
@@ -343,11 +356,38 @@ void EngineMaster::processChannels(int iBufferSize) {
     }
 
     // Now that the list is built and ordered, do the processing.
-    for (int i = activeChannelsStartIndex;
-             i < m_activeChannels.size(); ++i) {
-        ChannelInfo* pChannelInfo = m_activeChannels[i];
-        EngineChannel* pChannel = pChannelInfo->m_pChannel;
-        pChannel->process(pChannelInfo->m_pBuffer, iBufferSize);
+    if (m_pChannelProcessorPool) {
+        // The sync followers depend on the state of the sync master, so
+        // it is processed alone before all others are processed in parallel.
+        if (activeChannelsStartIndex == 0) {
+            ChannelInfo* pMasterChannelInfo = m_activeChannels[0];
+            pMasterChannelInfo->m_pChannel->process(
+                    pMasterChannelInfo->m_pBuffer, iBufferSize);
+        }
+        m_parallelChannelJobs.clear();
+        for (int i = 1; i < m_activeChannels.size(); ++i) {
+            ChannelInfo* pChannelInfo = m_activeChannels[i];
+            ChannelProcessorPool::Job job;
+            job.pChannel = pChannelInfo->m_pChannel;
+            job.pBuffer = pChannelInfo->m_pBuffer;
+            m_parallelChannelJobs.append(job);
+        }
+        m_pChannelProcessorPool->process(m_parallelChannelJobs.constData(),
+                m_parallelChannelJobs.size(), iBufferSize);
+        // Forwards the queued sync notifications and applies the effects,
+        // which are shared between all channels.
+        for (int i = 1; i < m_activeChannels.size(); ++i) {
+            ChannelInfo* pChannelInfo = m_activeChannels[i];
+            pChannelInfo->m_pChannel->processSerial(
+                    pChannelInfo->m_pBuffer, iBufferSize);
+        }
+    } else {
+        for (int i = activeChannelsStartIndex;
+                 i < m_activeChannels.size(); ++i) {
+            ChannelInfo* pChannelInfo = m_activeChannels[i];
+            EngineChannel* pChannel = pChannelInfo->m_pChannel;
+            pChannel->process(pChannelInfo->m_pBuffer, iBufferSize);
+        }
     }
 
     // After all the engines have been processed, trigger post-processing
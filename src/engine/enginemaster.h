@@ -27,6 +27,7 @@
 #include "engine/engineobject.h"
 #include "engine/enginechannel.h"
 #include "engine/channelhandle.h"
+#include "engine/channelprocessorpool.h"
 #include "soundio/soundmanager.h"
 #include "soundio/soundmanagerutil.h"
 #include "recording/recordingmanager.h"
@@ -310,6 +311,7 @@ class EngineMaster : public QObject, public AudioSource {
 
     // Pre-allocated buffers for performing channel mixing in the callback.
     QVarLengthArray<ChannelInfo*, kPreallocatedChannels> m_activeChannels;
+    QVarLengthArray<ChannelProcessorPool::Job, kPreallocatedChannels> m_parallelChannelJobs;
     QVarLengthArray<ChannelInfo*, kPreallocatedChannels> m_activeBusChannels[3];
     QVarLengthArray<ChannelInfo*, kPreallocatedChannels> m_activeHeadphoneChannels;
     QVarLengthArray<ChannelInfo*, kPreallocatedChannels> m_activeTalkoverChannels;
@@ -324,6 +326,8 @@ class EngineMaster : public QObject, public AudioSource {
     CSAMPLE** m_ppSidechainOutput;
 
     EngineWorkerScheduler* m_pWorkerScheduler;
+    // Processes channels in parallel if enabled, may be null
+    ChannelProcessorPool* m_pChannelProcessorPool;
     EngineSync* m_pMasterSync;
 
     ControlObject* m_pMasterGain;
@@ -24,6 +24,7 @@ EngineWorkerScheduler::~EngineWorkerScheduler() {
 
 void EngineWorkerScheduler::workerReady(EngineWorker* pWorker) {
     if (pWorker) {
+        mixxx::SpinLocker locker(&m_writeLock);
         // If the write fails, we really can't do much since we should not block
         // in this slot. Write the address of the variable pWorker, since it is
         // a 1-element array.
@@ -35,7 +36,8 @@ void EngineWorkerScheduler::workerReady(EngineWorker* pWorker) {
 void EngineWorkerScheduler::runWorkers() {
     // Wake the scheduler if we have written a worker-ready message to the
     // scheduler. There is no race condition in accessing this boolean because
-    // both workerReady and runWorkers are called from the callback thread.
+    // both workerReady and runWorkers are called from the callback thread
+    // or from channels that it processes in parallel and waits for.
     if (m_bWakeScheduler) {
         m_bWakeScheduler = false;
         m_waitCondition.wakeAll();
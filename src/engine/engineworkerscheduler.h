@@ -6,6 +6,7 @@
 #include <QWaitCondition>
 
 #include "util/fifo.h"
+#include "util/spinlock.h"
 
 // The max engine workers that can be expected to run within a callback
 // (e.g. the max that we will schedule). Must be a power of 2.
@@ -30,6 +31,9 @@ class EngineWorkerScheduler : public QThread {
     // runWorkers was run. This should only be touched from the engine callback.
     bool m_bWakeScheduler;
 
+    // Serializes workerReady() calls from channels that are processed in
+    // parallel. The FIFO only supports a single writer.
+    mixxx::SpinLock m_writeLock;
     FIFO<EngineWorker*> m_scheduleFIFO;
     QWaitCondition m_waitCondition;
     QMutex m_mutex;
@@ -197,8 +197,29 @@ void ReadAheadManager::hintReader(double dRate, HintVector* pHintList) {
     }
 
     // top priority, we need to read this data immediately
-    current_position.priority = 1;
+    current_position.priority = Hint::kPriorityImminent;
     pHintList->append(current_position);
+
+    // Keep one chunk behind the play position warm for the moment the
+    // direction changes, e.g. when scratching back and forth.
+    Hint reverse_window;
+    reverse_window.frameCount = CachingReaderChunk::kFrames;
+    if (in_reverse) {
+        reverse_window.frame =
+                static_cast<SINT>(ceil(m_currentPosition / kNumChannels));
+    } else {
+        reverse_window.frame =
+                static_cast<SINT>(floor(m_currentPosition / kNumChannels)) -
+                reverse_window.frameCount;
+        if (reverse_window.frame < 0) {
+            reverse_window.frameCount += reverse_window.frame;
+            reverse_window.frame = 0;
+        }
+    }
+    if (reverse_window.frameCount > 0) {
+        reverse_window.priority = Hint::kPriorityReverse;
+        pHintList->append(reverse_window);
+    }
 }
 
 // Not thread-save, call from engine thread only
@@ -0,0 +1,144 @@
+#include "engine/sync/syncnotificationqueue.h"
+
+#include "util/assert.h"
+
+SyncNotificationQueue::SyncNotificationQueue(SyncableListener* pEngineSync)
+        : m_pEngineSync(pEngineSync),
+          m_pQueueingThread(nullptr),
+          m_numNotifications(0) {
+}
+
+void SyncNotificationQueue::beginQueueing() {
+    m_pQueueingThread.fetchAndStoreRelease(QThread::currentThread());
+}
+
+void SyncNotificationQueue::flush() {
+    // Synchronizes with beginQueueing() and the processing thread
+    m_pQueueingThread.fetchAndStoreAcquire(nullptr);
+    for (int i = 0; i < m_numNotifications; ++i) {
+        const Notification& notification = m_notifications[i];
+        Syncable* pSyncable = notification.pSyncable;
+        switch (notification.type) {
+        case Type::RequestSyncMode:
+            m_pEngineSync->requestSyncMode(
+                    pSyncable, static_cast<SyncMode>(notification.flag));
+            break;
+        case Type::RequestEnableSync:
+            m_pEngineSync->requestEnableSync(pSyncable, notification.flag);
+            break;
+        case Type::BpmChanged:
+            m_pEngineSync->notifyBpmChanged(
+                    pSyncable, notification.value, notification.flag);
+            break;
+        case Type::InstantaneousBpmChanged:
+            m_pEngineSync->notifyInstantaneousBpmChanged(
+                    pSyncable, notification.value);
+            break;
+        case Type::Scratching:
+            m_pEngineSync->notifyScratching(pSyncable, notification.flag);
+            break;
+        case Type::BeatDistanceChanged:
+            m_pEngineSync->notifyBeatDistanceChanged(
+                    pSyncable, notification.value);
+            break;
+        case Type::Playing:
+            m_pEngineSync->notifyPlaying(pSyncable, notification.flag);
+            break;
+        case Type::TrackLoaded:
+            m_pEngineSync->notifyTrackLoaded(pSyncable, notification.value);
+            break;
+        }
+    }
+    m_numNotifications = 0;
+}
+
+void SyncNotificationQueue::enqueue(
+        Type type, Syncable* pSyncable, double value, int flag) {
+    if (m_numNotifications > 0) {
+        Notification* pLast = &m_notifications[m_numNotifications - 1];
+        const bool mergeable = type == Type::BpmChanged ||
+                type == Type::InstantaneousBpmChanged ||
+                type == Type::BeatDistanceChanged;
+        if (mergeable && pLast->type == type &&
+                pLast->pSyncable == pSyncable && pLast->flag == flag) {
+            pLast->value = value;
+            return;
+        }
+    }
+    VERIFY_OR_DEBUG_ASSERT(m_numNotifications < kMaxNotifications) {
+        return;
+    }
+    Notification* pNotification = &m_notifications[m_numNotifications++];
+    pNotification->type = type;
+    pNotification->pSyncable = pSyncable;
+    pNotification->value = value;
+    pNotification->flag = flag;
+}
+
+void SyncNotificationQueue::requestSyncMode(Syncable* pSyncable, SyncMode mode) {
+    if (isQueueing()) {
+        enqueue(Type::RequestSyncMode, pSyncable, 0.0, mode);
+    } else {
+        m_pEngineSync->requestSyncMode(pSyncable, mode);
+    }
+}
+
+void SyncNotificationQueue::requestEnableSync(Syncable* pSyncable, bool enabled) {
+    if (isQueueing()) {
+        enqueue(Type::RequestEnableSync, pSyncable, 0.0, enabled);
+    } else {
+        m_pEngineSync->requestEnableSync(pSyncable, enabled);
+    }
+}
+
+void SyncNotificationQueue::notifyBpmChanged(Syncable* pSyncable, double bpm,
+                                             bool fileChanged) {
+    if (isQueueing()) {
+        enqueue(Type::BpmChanged, pSyncable, bpm, fileChanged);
+    } else {
+        m_pEngineSync->notifyBpmChanged(pSyncable, bpm, fileChanged);
+    }
+}
+
+void SyncNotificationQueue::notifyInstantaneousBpmChanged(
+        Syncable* pSyncable, double bpm) {
+    if (isQueueing()) {
+        enqueue(Type::InstantaneousBpmChanged, pSyncable, bpm, 0);
+    } else {
+        m_pEngineSync->notifyInstantaneousBpmChanged(pSyncable, bpm);
+    }
+}
+
+void SyncNotificationQueue::notifyScratching(Syncable* pSyncable, bool scratching) {
+    if (isQueueing()) {
+        enqueue(Type::Scratching, pSyncable, 0.0, scratching);
+    } else {
+        m_pEngineSync->notifyScratching(pSyncable, scratching);
+    }
+}
+
+void SyncNotificationQueue::notifyBeatDistanceChanged(
+        Syncable* pSyncable, double beatDistance) {
+    if (isQueueing()) {
+        enqueue(Type::BeatDistanceChanged, pSyncable, beatDistance, 0);
+    } else {
+        m_pEngineSync->notifyBeatDistanceChanged(pSyncable, beatDistance);
+    }
+}
+
+void SyncNotificationQueue::notifyPlaying(Syncable* pSyncable, bool playing) {
+    if (isQueueing()) {
+        enqueue(Type::Playing, pSyncable, 0.0, playing);
+    } else {
+        m_pEngineSync->notifyPlaying(pSyncable, playing);
+    }
+}
+
+void SyncNotificationQueue::notifyTrackLoaded(Syncable* pSyncable,
+                                              double suggested_bpm) {
+    if (isQueueing()) {
+        enqueue(Type::TrackLoaded, pSyncable, suggested_bpm, 0);
+    } else {
+        m_pEngineSync->notifyTrackLoaded(pSyncable, suggested_bpm);
+    }
+}
@@ -0,0 +1,75 @@
+#ifndef SYNCNOTIFICATIONQUEUE_H
+#define SYNCNOTIFICATIONQUEUE_H
+
+#include <QAtomicPointer>
+#include <QThread>
+
+#include "engine/sync/syncable.h"
+#include "util/compatibility.h"
+
+// Forwards the notifications of a deck to EngineSync. EngineSync modifies
+// the state of all syncables, so it must only be called from one engine
+// thread at a time. While the deck is processed in parallel with other
+// channels, the notifications that are sent from the processing thread are
+// queued and forwarded later by flush() in the engine thread.
+class SyncNotificationQueue : public SyncableListener {
+  public:
+    explicit SyncNotificationQueue(SyncableListener* pEngineSync);
+
+    // Queues the notifications from the calling thread until flush()
+    void beginQueueing();
+    // Forwards the queued notifications in their original order. Must be
+    // called from the engine thread while the deck is not processed.
+    void flush();
+
+    void requestSyncMode(Syncable* pSyncable, SyncMode mode) override;
+    void requestEnableSync(Syncable* pSyncable, bool enabled) override;
+    void notifyBpmChanged(Syncable* pSyncable, double bpm,
+                          bool fileChanged=false) override;
+    void notifyInstantaneousBpmChanged(Syncable* pSyncable, double bpm) override;
+    void notifyScratching(Syncable* pSyncable, bool scratching) override;
+    void notifyBeatDistanceChanged(
+        Syncable* pSyncable, double beatDistance) override;
+    void notifyPlaying(Syncable* pSyncable, bool playing) override;
+    void notifyTrackLoaded(Syncable* pSyncable, double suggested_bpm) override;
+
+  private:
+    enum class Type {
+        RequestSyncMode,
+        RequestEnableSync,
+        BpmChanged,
+        InstantaneousBpmChanged,
+        Scratching,
+        BeatDistanceChanged,
+        Playing,
+        TrackLoaded,
+    };
+
+    struct Notification {
+        Type type;
+        Syncable* pSyncable;
+        double value;
+        // The sync mode, the file changed flag or the enabled, scratching
+        // and playing states
+        int flag;
+    };
+
+    // A deck sends only a few notifications per callback, the repeated
+    // BPM and beat distance updates are merged.
+    static const int kMaxNotifications = 32;
+
+    bool isQueueing() const {
+        const QThread* pThread = load_atomic_pointer(m_pQueueingThread);
+        return pThread && pThread == QThread::currentThread();
+    }
+    void enqueue(Type type, Syncable* pSyncable, double value, int flag);
+
+    SyncableListener* const m_pEngineSync;
+    // Notifications from other threads, e.g. from the GUI, are forwarded
+    // immediately as before.
+    QAtomicPointer<QThread> m_pQueueingThread;
+    Notification m_notifications[kMaxNotifications];
+    int m_numNotifications;
+};
+
+#endif /* SYNCNOTIFICATIONQUEUE_H */
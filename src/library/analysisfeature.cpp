@@ -135,7 +135,8 @@ void AnalysisFeature::analyzeTracks(QList<TrackId> trackIds) {
         m_pAnalyzerQueue = new AnalyzerQueue(
                 m_pDbConnectionPool,
                 m_pConfig,
-                getAnalyzerQueueMode(m_pConfig));
+                getAnalyzerQueueMode(m_pConfig),
+                AnalyzerQueue::getBatchWorkerCount(m_pConfig));
 
         connect(m_pAnalyzerQueue, SIGNAL(trackProgress(int)),
                 m_pAnalysisView, SLOT(trackAnalysisProgress(int)));
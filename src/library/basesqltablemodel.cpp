@@ -1,6 +1,7 @@
 // Created by RJ Ryan (rryan@mit.edu) 1/29/2010
 
 #include <QtAlgorithms>
+#include <QtConcurrentRun>
 #include <QtDebug>
 #include <QUrl>
 
@@ -20,6 +21,7 @@
 #include "util/duration.h"
 #include "util/dnd.h"
 #include "util/assert.h"
+#include "util/math.h"
 #include "util/performancetimer.h"
 
 static const bool sDebug = false;
@@ -29,10 +31,30 @@ static const bool sDebug = false;
 // Column 0 is skipped when calculating the the columns of the view table
 static const int kIdColumn = 0;
 static const int kMaxSortColumns = 3;
+// The number of search results that are inserted at once
+static const int kRowPageSize = 5000;
 
 // Constant for getModelSetting(name)
 static const char* COLUMNS_SORTING = "ColumnsSorting";
 
+// Returns a revision of the database that changes whenever rows are
+// modified through this connection, i.e. total_changes(), or through any
+// other connection, i.e. the data_version. Returns an empty string if the
+// revision is unknown.
+static QString queryDatabaseRevision(const QSqlDatabase& database) {
+    QSqlQuery query(database);
+    if (!query.exec("SELECT total_changes()") || !query.next()) {
+        LOG_FAILED_QUERY(query);
+        return QString();
+    }
+    const QString totalChanges = query.value(0).toString();
+    if (!query.exec("PRAGMA data_version") || !query.next()) {
+        LOG_FAILED_QUERY(query);
+        return QString();
+    }
+    return totalChanges + ":" + query.value(0).toString();
+}
+
 BaseSqlTableModel::BaseSqlTableModel(QObject* pParent,
                                      TrackCollection* pTrackCollection,
                                      const char* settingsNamespace)
@@ -42,8 +64,21 @@ BaseSqlTableModel::BaseSqlTableModel(QObject* pParent,
           m_database(pTrackCollection->database()),
           m_previewDeckGroup(PlayerManager::groupForPreviewDeck(0)),
           m_bInitialized(false),
-          m_currentSearch("") {
+          m_currentSearch(""),
+          m_bTableRowsCached(false),
+          m_searchGeneration(0),
+          m_searchJobGeneration(0),
+          m_bSearchPending(false),
+          m_pendingRowIndex(0),
+          m_pendingRowsGeneration(0),
+          m_searchLatencyTimer("BaseSqlTableModel::search latency") {
     DEBUG_ASSERT(m_pTrackCollection);
+    connect(&m_searchWatcher, SIGNAL(finished()),
+            this, SLOT(slotSearchSorted()));
+    m_rowPageTimer.setSingleShot(true);
+    m_rowPageTimer.setInterval(0);
+    connect(&m_rowPageTimer, SIGNAL(timeout()),
+            this, SLOT(slotInsertRowPage()));
     connect(&PlayerInfo::instance(), SIGNAL(trackLoaded(QString, TrackPointer)),
             this, SLOT(trackLoaded(QString, TrackPointer)));
     connect(&m_pTrackCollection->getTrackDAO(), SIGNAL(forceModelUpdate()),
@@ -52,6 +87,8 @@ BaseSqlTableModel::BaseSqlTableModel(QObject* pParent,
 }
 
 BaseSqlTableModel::~BaseSqlTableModel() {
+    // The worker only uses its own copy of the job
+    m_searchWatcher.waitForFinished();
 }
 
 void BaseSqlTableModel::initHeaderData() {
@@ -236,6 +273,11 @@ void BaseSqlTableModel::select() {
         qDebug() << this << "select()";
     }
 
+    // The rows are up to date after this select()
+    cancelSearch();
+    // Before the query, so that modifications in between are not missed
+    const QString databaseRevision = queryDatabaseRevision(m_database);
+
     PerformanceTimer time;
     time.start();
 
@@ -292,6 +334,11 @@ void BaseSqlTableModel::select() {
         qDebug() << "Rows actually received:" << rowInfo.size();
     }
 
+    m_tableRows = rowInfo;
+    m_tableTrackIds = trackIds;
+    m_tableRowsRevision = databaseRevision;
+    m_bTableRowsCached = !databaseRevision.isEmpty();
+
     if (m_trackSource) {
         m_trackSource->filterAndSort(trackIds, m_currentSearch,
                                      m_currentSearchFilter,
@@ -299,11 +346,31 @@ void BaseSqlTableModel::select() {
                                      m_sortColumns,
                                      m_tableColumns.size() - 1,
                                      &m_trackSortOrder);
+    }
+    orderRows(&rowInfo);
 
+    TrackId2Rows trackIdToRows;
+    for (int i = 0; i < rowInfo.size(); ++i) {
+        trackIdToRows[rowInfo[i].trackId].push_back(i);
+    }
+
+    // We're done! Issue the update signals and replace the master maps.
+    replaceRows(
+            std::move(rowInfo),
+            std::move(trackIdToRows));
+    // Both rowInfo and trackIdToRows (might) have been moved and
+    // must not be used afterwards!
+
+    qDebug() << this << "select() took" << time.elapsed().debugMillisWithUnit()
+             << m_rowInfo.size();
+}
+
+void BaseSqlTableModel::orderRows(QVector<RowInfo>* pRows) const {
+    if (m_trackSource) {
         // Re-sort the track IDs since filterAndSort can change their order or mark
         // them for removal (by setting their row to -1).
-        for (QVector<RowInfo>::iterator it = rowInfo.begin();
-                it != rowInfo.end(); ++it) {
+        for (QVector<RowInfo>::iterator it = pRows->begin();
+                it != pRows->end(); ++it) {
             // If the sort is not a track column then we will sort only to
             // separate removed tracks (order == -1) from present tracks (order ==
             // 0). Otherwise we sort by the order that filterAndSort returned to us.
@@ -319,30 +386,117 @@ void BaseSqlTableModel::select() {
     // end so we can easily slice off rows that are no longer present. Stable
     // sort is necessary because the tracks may be in pre-sorted order so we
     // should not disturb that if we are only removing tracks.
-    qStableSort(rowInfo.begin(), rowInfo.end());
-
-    TrackId2Rows trackIdToRows;
-    for (int i = 0; i < rowInfo.size(); ++i) {
-        const RowInfo& row = rowInfo[i];
+    qStableSort(pRows->begin(), pRows->end());
 
-        if (row.order == -1) {
-            // We've reached the end of valid rows. Resize rowInfo to cut off
+    for (int i = 0; i < pRows->size(); ++i) {
+        if (pRows->at(i).order == -1) {
+            // We've reached the end of valid rows. Resize the rows to cut off
             // this and all further elements.
-            rowInfo.resize(i);
+            pRows->resize(i);
             break;
         }
-        trackIdToRows[row.trackId].push_back(i);
     }
+}
 
-    // We're done! Issue the update signals and replace the master maps.
-    replaceRows(
-            std::move(rowInfo),
-            std::move(trackIdToRows));
-    // Both rowInfo and trackIdToRows (might) have been moved and
-    // must not be used afterwards!
+bool BaseSqlTableModel::startSearch() {
+    if (!m_bTableRowsCached || !m_trackSource) {
+        return false;
+    }
+    // The columns of the table and its rows, e.g. the tracks of a playlist
+    // or crate, may have been modified since the last select().
+    if (queryDatabaseRevision(m_database) != m_tableRowsRevision) {
+        m_bTableRowsCached = false;
+        return false;
+    }
+    ++m_searchGeneration;
+    if (m_searchWatcher.isRunning()) {
+        // Started when the running search is done
+        m_bSearchPending = true;
+        return true;
+    }
+    m_bSearchPending = false;
 
-    qDebug() << this << "select() took" << time.elapsed().debugMillisWithUnit()
-             << m_rowInfo.size();
+    // Filtering needs the database connection and stays on this thread
+    m_pSearchJob = m_trackSource->startFilterAndSort(
+            m_tableTrackIds, m_currentSearch, m_currentSearchFilter,
+            m_trackSourceOrderBy, m_sortColumns, m_tableColumns.size() - 1);
+    if (!m_pSearchJob) {
+        return false;
+    }
+    m_searchJobGeneration = m_searchGeneration;
+    // The worker sorts a copy of the tracks
+    m_searchWatcher.setFuture(QtConcurrent::run(
+            m_pSearchJob->tracks, &SortableTracks::sort));
+    return true;
+}
+
+void BaseSqlTableModel::cancelSearch() {
+    ++m_searchGeneration;
+    m_bSearchPending = false;
+    m_rowPageTimer.stop();
+    m_pendingRows.clear();
+    m_pendingRowIndex = 0;
+}
+
+void BaseSqlTableModel::slotSearchSorted() {
+    std::unique_ptr<FilterAndSortJob> pJob(std::move(m_pSearchJob));
+    VERIFY_OR_DEBUG_ASSERT(pJob) {
+        return;
+    }
+    if (m_searchJobGeneration != m_searchGeneration) {
+        if (sDebug) {
+            qDebug() << this << "Dropping the result of a superseded search";
+        }
+        if (m_bSearchPending && !startSearch()) {
+            select();
+            m_searchLatencyTimer.elapsed(true);
+        }
+        return;
+    }
+
+    m_trackSource->finishFilterAndSort(
+            *pJob, m_searchWatcher.result(), &m_trackSortOrder);
+    QVector<RowInfo> rowInfo(m_tableRows);
+    orderRows(&rowInfo);
+
+    cancelSearch();
+    clearRows();
+    m_pendingRows = rowInfo;
+    m_pendingRowsGeneration = m_searchGeneration;
+    slotInsertRowPage();
+    m_searchLatencyTimer.elapsed(true);
+}
+
+void BaseSqlTableModel::slotInsertRowPage() {
+    if (m_pendingRowsGeneration != m_searchGeneration) {
+        // The rows have been replaced since the search finished
+        m_pendingRows.clear();
+        m_pendingRowIndex = 0;
+        return;
+    }
+    const int firstRow = m_rowInfo.size();
+    const int rowCount = math_min(kRowPageSize,
+            m_pendingRows.size() - m_pendingRowIndex);
+    if (rowCount <= 0) {
+        return;
+    }
+
+    beginInsertRows(QModelIndex(), firstRow, firstRow + rowCount - 1);
+    for (int i = 0; i < rowCount; ++i) {
+        const RowInfo& row = m_pendingRows[m_pendingRowIndex + i];
+        m_rowInfo.append(row);
+        m_trackIdToRows[row.trackId].push_back(firstRow + i);
+    }
+    endInsertRows();
+
+    m_pendingRowIndex += rowCount;
+    if (m_pendingRowIndex < m_pendingRows.size()) {
+        // Give the view a chance to paint the rows so far
+        m_rowPageTimer.start();
+    } else {
+        m_pendingRows.clear();
+        m_pendingRowIndex = 0;
+    }
 }
 
 void BaseSqlTableModel::setTable(const QString& tableName,
@@ -357,6 +511,11 @@ void BaseSqlTableModel::setTable(const QString& tableName,
     m_tableColumns = tableColumns;
     m_tableColumnsJoined = tableColumns.join(",");
 
+    cancelSearch();
+    m_tableRows.clear();
+    m_tableTrackIds.clear();
+    m_bTableRowsCached = false;
+
     if (m_trackSource) {
         disconnect(m_trackSource.data(), SIGNAL(tracksChanged(QSet<TrackId>)),
                    this, SLOT(tracksChanged(QSet<TrackId>)));
@@ -408,8 +567,12 @@ void BaseSqlTableModel::search(const QString& searchText, const QString& extraFi
     if (sDebug) {
         qDebug() << this << "search" << searchText;
     }
+    m_searchLatencyTimer.start();
     setSearch(searchText, extraFilter);
-    select();
+    if (!startSearch()) {
+        select();
+        m_searchLatencyTimer.elapsed(true);
+    }
 }
 
 void BaseSqlTableModel::setSort(int column, Qt::SortOrder order) {
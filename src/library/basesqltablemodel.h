@@ -2,7 +2,9 @@
 #ifndef BASESQLTABLEMODEL_H
 #define BASESQLTABLEMODEL_H
 
+#include <QFutureWatcher>
 #include <QHash>
+#include <QTimer>
 #include <QtSql>
 
 #include "library/basetrackcache.h"
@@ -11,6 +13,8 @@
 #include "library/trackmodel.h"
 #include "library/columncache.h"
 #include "util/class.h"
+#include "util/memory.h"
+#include "util/timer.h"
 
 // BaseSqlTableModel is a custom-written SQL-backed table which aggressively
 // caches the contents of the table and supports lightweight updates.
@@ -105,6 +109,8 @@ class BaseSqlTableModel : public QAbstractTableModel, public TrackModel {
     virtual void tracksChanged(QSet<TrackId> trackIds);
     virtual void trackLoaded(QString group, TrackPointer pTrack);
     void refreshCell(int row, int column);
+    void slotSearchSorted();
+    void slotInsertRowPage();
 
   private:
     // A simple helper function for initializing header title and width.  Note
@@ -140,6 +146,14 @@ class BaseSqlTableModel : public QAbstractTableModel, public TrackModel {
     void replaceRows(
             QVector<RowInfo>&& rows,
             TrackId2Rows&& trackIdToRows);
+    // Orders the rows like m_trackSortOrder and removes the rows that
+    // don't match.
+    void orderRows(QVector<RowInfo>* pRows) const;
+
+    // Filters and sorts the rows of the last select() without querying
+    // the table. Returns false if the search needs a select().
+    bool startSearch();
+    void cancelSearch();
 
     QVector<RowInfo> m_rowInfo;
 
@@ -159,6 +173,33 @@ class BaseSqlTableModel : public QAbstractTableModel, public TrackModel {
     QVector<QHash<int, QVariant> > m_headerInfo;
     QString m_trackSourceOrderBy;
 
+    // The rows of the table from the last select(), searched without
+    // querying the table again
+    QVector<RowInfo> m_tableRows;
+    QSet<TrackId> m_tableTrackIds;
+    // The revision of the database when the rows have been selected. The
+    // rows are selected again if the database has been modified since.
+    QString m_tableRowsRevision;
+    bool m_bTableRowsCached;
+
+    // Searches sort on a worker thread, one at a time. Results of searches
+    // that have been superseded in the meantime are dropped.
+    QFutureWatcher<QVector<TrackId> > m_searchWatcher;
+    std::unique_ptr<FilterAndSortJob> m_pSearchJob;
+    int m_searchGeneration;
+    int m_searchJobGeneration;
+    bool m_bSearchPending;
+
+    // The rows of a search result that are not inserted yet. Rows are
+    // inserted in pages, so that the first matches show up immediately.
+    QVector<RowInfo> m_pendingRows;
+    int m_pendingRowIndex;
+    // The search generation the pending rows belong to
+    int m_pendingRowsGeneration;
+    QTimer m_rowPageTimer;
+    // From search() to the first page of results
+    Timer m_searchLatencyTimer;
+
     DISALLOW_COPY_AND_ASSIGN(BaseSqlTableModel);
 };
 
@@ -5,6 +5,8 @@
 
 #include <QScopedPointer>
 
+#include <algorithm>
+
 #include "control/controlproxy.h"
 #include "library/trackcollection.h"
 #include "library/searchqueryparser.h"
@@ -18,6 +20,49 @@ const bool sDebug = false;
 
 }  // namespace
 
+QVector<TrackId> SortableTracks::sort() const {
+    if (!ordered) {
+        return trackIds;
+    }
+
+    QVector<int> order(trackIds.size());
+    for (int i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    const QVector<int>& rows = this->rows;
+    const QVector<QVector<int> >& sortRanks = this->sortRanks;
+    const QVector<bool>& descending = this->descending;
+    std::sort(order.begin(), order.end(),
+            [&rows, &sortRanks, &descending](int a, int b) {
+        const int rowA = rows[a];
+        const int rowB = rows[b];
+        for (int i = 0; i < sortRanks.size(); ++i) {
+            const int rankA = sortRanks[i][rowA];
+            const int rankB = sortRanks[i][rowB];
+            if (rankA != rankB) {
+                return descending[i] ? rankA > rankB : rankA < rankB;
+            }
+        }
+        // Keep the order stable between searches
+        return rowA < rowB;
+    });
+
+    QVector<TrackId> sortedTrackIds;
+    sortedTrackIds.reserve(order.size());
+    for (int i: order) {
+        sortedTrackIds.append(trackIds[i]);
+    }
+    return sortedTrackIds;
+}
+
+FilterAndSortJob::FilterAndSortJob()
+        : columnOffset(0) {
+}
+
+// Destroys the query, which is incomplete in the header
+FilterAndSortJob::~FilterAndSortJob() {
+}
+
 BaseTrackCache::BaseTrackCache(TrackCollection* pTrackCollection,
                                const QString& tableName,
                                const QString& idColumn,
@@ -31,6 +76,7 @@ BaseTrackCache::BaseTrackCache(TrackCollection* pTrackCollection,
           m_columnCache(columns),
           m_bIndexBuilt(false),
           m_bIsCaching(isCaching),
+          m_trackIndex(columns),
           m_trackDAO(pTrackCollection->getTrackDAO()),
           m_database(pTrackCollection->database()),
           m_pQueryParser(new SearchQueryParser(pTrackCollection)) {
@@ -50,6 +96,18 @@ BaseTrackCache::BaseTrackCache(TrackCollection* pTrackCollection,
     for (int i = 0; i < m_searchColumns.size(); ++i) {
         m_searchColumnIndices[i] = m_columnCache.fieldIndex(m_searchColumns[i]);
     }
+
+    // Sort like the ORDER BY clauses from ColumnCache::columnSortForFieldIndex()
+    const int trackNumberColumn =
+            fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_TRACKNUMBER);
+    if (trackNumberColumn >= 0) {
+        m_trackIndex.setSortMode(trackNumberColumn,
+                TrackColumnIndex::SortMode::Integer);
+    }
+    const int keyColumn = fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_KEY);
+    if (keyColumn >= 0) {
+        m_trackIndex.setSortMode(keyColumn, TrackColumnIndex::SortMode::Key);
+    }
 }
 
 BaseTrackCache::~BaseTrackCache() {
@@ -99,7 +157,7 @@ void BaseTrackCache::slotTracksRemoved(QSet<TrackId> trackIds) {
         qDebug() << this << "slotTracksRemoved" << trackIds.size();
     }
     for (const auto& trackId : trackIds) {
-        m_trackInfo.remove(trackId);
+        m_trackIndex.removeRow(trackId);
     }
 }
 
@@ -128,7 +186,7 @@ void BaseTrackCache::slotTrackClean(TrackId trackId) {
 }
 
 bool BaseTrackCache::isCached(TrackId trackId) const {
-    return m_trackInfo.contains(trackId);
+    return m_trackIndex.contains(trackId);
 }
 
 void BaseTrackCache::ensureCached(TrackId trackId) {
@@ -143,6 +201,10 @@ void BaseTrackCache::setSearchColumns(const QStringList& columns) {
     m_searchColumns = columns;
 }
 
+void BaseTrackCache::enableTrackSearchIndex() {
+    m_pQueryParser->enableTrackSearchIndex(m_idColumn);
+}
+
 TrackPointer BaseTrackCache::lookupCachedTrack(TrackId trackId) const {
     // Only get the track from the TrackDAO if it's in the cache and marked as
     // dirty.
@@ -165,13 +227,15 @@ bool BaseTrackCache::updateIndexWithTrackpointer(TrackPointer pTrack) {
 
     TrackId trackId(pTrack->getId());
     if (trackId.isValid()) {
-        // m_trackInfo[id] will insert a QVector<QVariant> into the
-        // m_trackInfo HashTable with the key "id"
-        QVector<QVariant>& record = m_trackInfo[trackId];
-        // prealocate memory for all columns at once
-        record.resize(numColumns);
+        // Inserts a row for new tracks
+        const int row = m_trackIndex.insertRow(trackId);
         for (int i = 0; i < numColumns; ++i) {
-            getTrackValueForColumn(pTrack, i, record[i]);
+            // Keep the values of columns that Track doesn't know
+            QVariant trackValue;
+            getTrackValueForColumn(pTrack, i, trackValue);
+            if (trackValue.isValid()) {
+                m_trackIndex.setValue(row, i, trackValue);
+            }
         }
     }
     return true;
@@ -202,13 +266,10 @@ bool BaseTrackCache::updateIndexWithQuery(const QString& queryString) {
     while (query.next()) {
         TrackId trackId(query.value(idColumn));
 
-        //m_trackInfo[id] will insert a QVector<QVariant> into the
-        //m_trackInfo HashTable with the key "id"
-        QVector<QVariant>& record = m_trackInfo[trackId];
-        record.resize(numColumns);
-
+        // Inserts a row for new tracks
+        const int row = m_trackIndex.insertRow(trackId);
         for (int i = 0; i < numColumns; ++i) {
-            record[i] = query.value(i);
+            m_trackIndex.setValue(row, i, query.value(i));
         }
     }
 
@@ -231,7 +292,7 @@ void BaseTrackCache::buildIndex() {
     // TODO(rryan) for very large tables, it probably makes more sense to NOT
     // clear the table, and keep track of what IDs we see, then delete the ones
     // we don't see.
-    m_trackInfo.clear();
+    m_trackIndex.clear();
 
     if (!updateIndexWithQuery(queryString)) {
         qDebug() << "buildIndex failed!";
@@ -359,12 +420,10 @@ QVariant BaseTrackCache::data(TrackId trackId, int column) const {
     // TODO(rryan) this code is flawed for columns that contains row-specific
     // metadata. Currently the upper-levels will not delegate row-specific
     // columns to this method, but there should still be a check here I think.
-    if (!result.isValid()) {
-        QHash<TrackId, QVector<QVariant> >::const_iterator it =
-                m_trackInfo.find(trackId);
-        if (it != m_trackInfo.end()) {
-            const QVector<QVariant>& fields = it.value();
-            result = fields.value(column, result);
+    if (!result.isValid() && column >= 0 && column < columnCount()) {
+        const int row = m_trackIndex.row(trackId);
+        if (row >= 0) {
+            result = m_trackIndex.value(row, column);
         }
     }
     return result;
@@ -386,60 +445,47 @@ void BaseTrackCache::filterAndSort(const QSet<TrackId>& trackIds,
         buildIndex();
     }
 
-    QStringList idStrings;
+    std::unique_ptr<FilterAndSortJob> pJob(startFilterAndSort(
+            trackIds, searchQuery, extraFilter, orderByClause,
+            sortColumns, columnOffset));
+    if (pJob) {
+        finishFilterAndSort(*pJob, pJob->tracks.sort(), trackToIndex);
+        return;
+    }
+
     // TODO(rryan) consider making this the data passed in and a separate
     // QVector for output
     QSet<TrackId> dirtyTracks;
     for (const auto& trackId: trackIds) {
-        idStrings << trackId.toString();
         if (m_dirtyTracks.contains(trackId)) {
             dirtyTracks.insert(trackId);
         }
     }
 
-    std::unique_ptr<QueryNode> pQuery(parseQuery(
-        searchQuery, extraFilter, idStrings));
-
-    QString filter = pQuery->toSql();
-    if (!filter.isEmpty()) {
-        filter.prepend("WHERE ");
-    }
-
-    QString queryString = QString("SELECT %1 FROM %2 %3 %4")
-            .arg(m_idColumn, m_tableName, filter, orderByClause);
-
-    if (sDebug) {
-        qDebug() << this << "select() executing:" << queryString;
-    }
-
-    QSqlQuery query(m_database);
-    // This causes a memory savings since QSqlCachedResult (what QtSQLite uses)
-    // won't allocate a giant in-memory table that we won't use at all.
-    query.setForwardOnly(true);
-    query.prepare(queryString);
-
-    if (!query.exec()) {
-        LOG_FAILED_QUERY(query);
-    }
-
-    int idColumn = query.record().indexOf(m_idColumn);
-    int rows = query.size();
+    std::unique_ptr<QueryNode> pQuery(filterAndSortInDatabase(
+            trackIds, searchQuery, extraFilter, orderByClause));
+    updateTrackOrder(dirtyTracks, *pQuery, searchQuery, sortColumns,
+            columnOffset, trackToIndex);
+}
 
-    if (sDebug) {
-        qDebug() << "Rows returned:" << rows;
-    }
+void BaseTrackCache::finishFilterAndSort(const FilterAndSortJob& job,
+                                         const QVector<TrackId>& trackOrder,
+                                         QHash<TrackId, int>* trackToIndex) {
+    m_trackOrder = trackOrder;
+    updateTrackOrder(job.dirtyTracks, *job.pQuery, job.searchQuery,
+            job.sortColumns, job.columnOffset, trackToIndex);
+}
 
-    m_trackOrder.resize(0); // keeps alocated memory
+void BaseTrackCache::updateTrackOrder(const QSet<TrackId>& dirtyTracks,
+                                      const QueryNode& query,
+                                      const QString& searchQuery,
+                                      const QList<SortColumn>& sortColumns,
+                                      const int columnOffset,
+                                      QHash<TrackId, int>* trackToIndex) {
     trackToIndex->clear();
-    if (rows > 0) {
-        trackToIndex->reserve(rows);
-        m_trackOrder.reserve(rows);
-    }
-
-    while (query.next()) {
-        TrackId trackId(query.value(idColumn));
-        (*trackToIndex)[trackId] = m_trackOrder.size();
-        m_trackOrder.append(trackId);
+    trackToIndex->reserve(m_trackOrder.size());
+    for (int i = 0; i < m_trackOrder.size(); ++i) {
+        (*trackToIndex)[m_trackOrder[i]] = i;
     }
 
     // At this point, the original set of tracks have been divided into two
@@ -466,7 +512,7 @@ void BaseTrackCache::filterAndSort(const QSet<TrackId>& trackIds,
         // The track should be in the result set if the search is empty or the
         // track matches the search.
         bool shouldBeInResultSet = searchQuery.isEmpty() ||
-                pQuery->match(pTrack);
+                query.match(pTrack);
 
         // If the track is in this result set.
         bool isInResultSet = trackToIndex->contains(trackId);
@@ -516,6 +562,146 @@ void BaseTrackCache::filterAndSort(const QSet<TrackId>& trackIds,
     }
 }
 
+std::unique_ptr<FilterAndSortJob> BaseTrackCache::startFilterAndSort(
+        const QSet<TrackId>& trackIds,
+        const QString& searchQuery,
+        const QString& extraFilter,
+        const QString& orderByClause,
+        const QList<SortColumn>& sortColumns,
+        const int columnOffset) {
+    if (!m_bIndexBuilt) {
+        buildIndex();
+    }
+
+    // The database shuffles, see BaseSqlTableModel::setSort()
+    if (orderByClause.contains("RANDOM()")) {
+        return std::unique_ptr<FilterAndSortJob>();
+    }
+
+    QVector<int> rows;
+    rows.reserve(trackIds.size());
+    for (const auto& trackId: trackIds) {
+        const int row = m_trackIndex.row(trackId);
+        if (row < 0) {
+            // The database knows tracks that are not indexed yet
+            return std::unique_ptr<FilterAndSortJob>();
+        }
+        rows.append(row);
+    }
+
+    // The tracks are already restricted to trackIds
+    std::unique_ptr<QueryNode> pQuery(parseQuery(
+            searchQuery, extraFilter, QStringList()));
+    RowMatches matches(rows.size());
+    if (!pQuery->matchRows(m_trackIndex, rows, &matches)) {
+        if (sDebug) {
+            qDebug() << this << "startFilterAndSort() can't match"
+                     << pQuery->toSql();
+        }
+        return std::unique_ptr<FilterAndSortJob>();
+    }
+
+    auto pJob = std::make_unique<FilterAndSortJob>();
+    SortableTracks& tracks = pJob->tracks;
+    const int matchingRowCount = matches.matching.count(true);
+    tracks.rows.reserve(matchingRowCount);
+    tracks.trackIds.reserve(matchingRowCount);
+    for (int i = 0; i < rows.size(); ++i) {
+        if (matches.matching.testBit(i)) {
+            tracks.rows.append(rows[i]);
+            tracks.trackIds.append(m_trackIndex.trackId(rows[i]));
+        }
+    }
+
+    // The order only matters if there is an ORDER BY clause, see
+    // BaseSqlTableModel::select()
+    tracks.ordered = !orderByClause.isEmpty();
+    if (tracks.ordered) {
+        m_trackIndex.setKeyNotation(KeyUtils::keyNotationFromNumericValue(
+                m_pKeyNotationCP->get()));
+        for (const auto& sc: sortColumns) {
+            int column = sc.m_column - columnOffset;
+            if (sc.m_column <= columnOffset) {
+                // Only the id is shared with the columns of the table model
+                if (sc.m_column != 0) {
+                    continue;
+                }
+                column = 0;
+            }
+            if (column >= columnCount()) {
+                continue;
+            }
+            // Computed on this thread, so that the index keeps the ranks
+            tracks.sortRanks.append(m_trackIndex.sortRanks(column));
+            tracks.descending.append(sc.m_order == Qt::DescendingOrder);
+        }
+    }
+
+    for (const auto& trackId: trackIds) {
+        if (m_dirtyTracks.contains(trackId)) {
+            pJob->dirtyTracks.insert(trackId);
+        }
+    }
+    pJob->pQuery = std::move(pQuery);
+    pJob->searchQuery = searchQuery;
+    pJob->sortColumns = sortColumns;
+    pJob->columnOffset = columnOffset;
+    return pJob;
+}
+
+std::unique_ptr<QueryNode> BaseTrackCache::filterAndSortInDatabase(
+        const QSet<TrackId>& trackIds,
+        const QString& searchQuery,
+        const QString& extraFilter,
+        const QString& orderByClause) {
+    QStringList idStrings;
+    for (const auto& trackId: trackIds) {
+        idStrings << trackId.toString();
+    }
+
+    std::unique_ptr<QueryNode> pQuery(parseQuery(
+        searchQuery, extraFilter, idStrings));
+
+    QString filter = pQuery->toSql();
+    if (!filter.isEmpty()) {
+        filter.prepend("WHERE ");
+    }
+
+    QString queryString = QString("SELECT %1 FROM %2 %3 %4")
+            .arg(m_idColumn, m_tableName, filter, orderByClause);
+
+    if (sDebug) {
+        qDebug() << this << "select() executing:" << queryString;
+    }
+
+    QSqlQuery query(m_database);
+    // This causes a memory savings since QSqlCachedResult (what QtSQLite uses)
+    // won't allocate a giant in-memory table that we won't use at all.
+    query.setForwardOnly(true);
+    query.prepare(queryString);
+
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+    }
+
+    int idColumn = query.record().indexOf(m_idColumn);
+    int rows = query.size();
+
+    if (sDebug) {
+        qDebug() << "Rows returned:" << rows;
+    }
+
+    m_trackOrder.resize(0); // keeps alocated memory
+    if (rows > 0) {
+        m_trackOrder.reserve(rows);
+    }
+
+    while (query.next()) {
+        m_trackOrder.append(TrackId(query.value(idColumn)));
+    }
+    return pQuery;
+}
+
 std::unique_ptr<QueryNode> BaseTrackCache::parseQuery(QString query, QString extraFilter,
                                       QStringList idStrings) const {
     QStringList queryFragments;
@@ -562,7 +748,7 @@ int BaseTrackCache::findSortInsertionPoint(TrackPointer pTrack,
 
         // This should not happen, but it's a recoverable error so we should
         // only log it.
-        if (!m_trackInfo.contains(otherTrackId)) {
+        if (!m_trackIndex.contains(otherTrackId)) {
             qDebug() << "WARNING: track" << otherTrackId << "was not in index";
             //updateTrackInIndex(otherTrackId);
         }
@@ -16,6 +16,7 @@
 #include "control/controlproxy.h"
 #include "library/dao/trackdao.h"
 #include "library/columncache.h"
+#include "library/trackcolumnindex.h"
 #include "track/track.h"
 #include "util/class.h"
 #include "util/memory.h"
@@ -34,6 +35,40 @@ class SortColumn {
     Qt::SortOrder m_order;
 };
 
+// The tracks that matched a query in the index of a BaseTrackCache, with
+// the ranks to sort them by. The vectors are implicitly shared with the
+// index, so sort() can run on a worker thread while the cache changes.
+struct SortableTracks {
+    SortableTracks()
+        : ordered(false) {
+    }
+
+    // Returns the tracks in order. Thread-safe.
+    QVector<TrackId> sort() const;
+
+    QVector<TrackId> trackIds;
+    // The rows of the tracks in the index
+    QVector<int> rows;
+    // The ranks of all rows of the index, per sort column
+    QVector<QVector<int> > sortRanks;
+    QVector<bool> descending;
+    bool ordered;
+};
+
+// A filterAndSort() that sorts the matching tracks on a worker thread.
+struct FilterAndSortJob {
+    FilterAndSortJob();
+    ~FilterAndSortJob();
+
+    SortableTracks tracks;
+
+    std::unique_ptr<QueryNode> pQuery;
+    QString searchQuery;
+    QList<SortColumn> sortColumns;
+    int columnOffset;
+    QSet<TrackId> dirtyTracks;
+};
+
 // BaseTrackCache is a cache of all of the values in certain table. It supports
 // searching and sorting of tracks by values within the table. The reasoning for
 // this is that previously there was a per-table-model cache which was largely a
@@ -71,10 +106,27 @@ class BaseTrackCache : public QObject {
                                const QList<SortColumn>& sortColumns,
                                const int columnOffset,
                                QHash<TrackId, int>* trackToIndex);
+    // filterAndSort() in steps, so that sorting can run on a worker thread:
+    // startFilterAndSort(), SortableTracks::sort() and finishFilterAndSort().
+    // Returns nothing if the query can only be evaluated by the database,
+    // then filterAndSort() has to be used.
+    std::unique_ptr<FilterAndSortJob> startFilterAndSort(
+            const QSet<TrackId>& trackIds,
+            const QString& query,
+            const QString& extraFilter,
+            const QString& orderByClause,
+            const QList<SortColumn>& sortColumns,
+            const int columnOffset);
+    void finishFilterAndSort(const FilterAndSortJob& job,
+                             const QVector<TrackId>& trackOrder,
+                             QHash<TrackId, int>* trackToIndex);
     virtual bool isCached(TrackId trackId) const;
     virtual void ensureCached(TrackId trackId);
     virtual void ensureCached(QSet<TrackId> trackIds);
     virtual void setSearchColumns(const QStringList& columns);
+    // Searches the library's full-text index instead of comparing the
+    // text columns. Only for tables with the track ids of the library.
+    void enableTrackSearchIndex();
 
   signals:
     void tracksChanged(QSet<TrackId> trackIds);
@@ -98,6 +150,21 @@ class BaseTrackCache : public QObject {
 
     std::unique_ptr<QueryNode> parseQuery(QString query, QString extraFilter,
                           QStringList idStrings) const;
+    // Filters and sorts the tracks into m_trackOrder and returns the
+    // parsed query.
+    std::unique_ptr<QueryNode> filterAndSortInDatabase(
+            const QSet<TrackId>& trackIds,
+            const QString& searchQuery,
+            const QString& extraFilter,
+            const QString& orderByClause);
+    // Moves the dirty tracks in m_trackOrder to where they belong now
+    // and updates trackToIndex.
+    void updateTrackOrder(const QSet<TrackId>& dirtyTracks,
+                          const QueryNode& query,
+                          const QString& searchQuery,
+                          const QList<SortColumn>& sortColumns,
+                          const int columnOffset,
+                          QHash<TrackId, int>* trackToIndex);
     int findSortInsertionPoint(TrackPointer pTrack,
                                const QList<SortColumn>& sortColumns,
                                const int columnOffset,
@@ -130,7 +197,7 @@ class BaseTrackCache : public QObject {
 
     bool m_bIndexBuilt;
     bool m_bIsCaching;
-    QHash<TrackId, QVector<QVariant> > m_trackInfo;
+    TrackColumnIndex m_trackIndex;
     TrackDAO& m_trackDAO;
     QSqlDatabase m_database;
     SearchQueryParser* m_pQueryParser;
@@ -84,7 +84,26 @@ QList<AnalysisDao::AnalysisInfo> AnalysisDao::loadAnalysesFromQuery(TrackId trac
         int checksum = query->value(dataChecksumColumn).toInt();
         QString dataPath = analysisPath.absoluteFilePath(
             QString::number(info.analysisId));
-        QByteArray compressedData = loadDataFromFile(dataPath);
+        QFile file(dataPath);
+        if (!file.open(QIODevice::ReadOnly)) {
+            qDebug() << "WARNING: Missing analysis data" << dataPath;
+            continue;
+        }
+        const QByteArray header = file.peek(Waveform::kMappableHeaderSize);
+        if (Waveform::isMappableData(header)) {
+            // Neither read nor decompressed here, the data is validated
+            // against the checksum in its header when it is mapped.
+            if (checksum != static_cast<int>(
+                    Waveform::mappableChecksum(header))) {
+                qDebug() << "WARNING: Analysis" << dataPath
+                         << "has been replaced by other data";
+                continue;
+            }
+            info.dataPath = dataPath;
+            analyses.append(info);
+            continue;
+        }
+        QByteArray compressedData = file.readAll();
         int file_checksum = qChecksum(compressedData.constData(),
                                       compressedData.length());
         if (checksum != file_checksum) {
@@ -114,9 +133,14 @@ bool AnalysisDao::saveAnalysis(AnalysisDao::AnalysisInfo* info) {
     PerformanceTimer time;
     time.start();
 
-    QByteArray compressedData = qCompress(info->data, kCompressionLevel);
-    int checksum = qChecksum(compressedData.constData(),
-                             compressedData.length());
+    // Data that is mapped into memory when loaded is not compressed and
+    // contains its own checksum.
+    const bool mappable = Waveform::isMappableData(info->data);
+    QByteArray compressedData = mappable ? info->data :
+            qCompress(info->data, kCompressionLevel);
+    int checksum = mappable ?
+            static_cast<int>(Waveform::mappableChecksum(info->data)) :
+            qChecksum(compressedData.constData(), compressedData.length());
 
     QSqlQuery query(m_db);
     if (info->analysisId == -1) {
@@ -192,6 +216,7 @@ bool AnalysisDao::deleteAnalysis(const int analysisId) {
     QString dataPath = getAnalysisStoragePath().absoluteFilePath(
         QString::number(analysisId));
     deleteFile(dataPath);
+    deleteRenderedOverviews(m_pConfig, analysisId);
     return true;
 }
 
@@ -212,6 +237,7 @@ void AnalysisDao::deleteAnalyses(const QList<TrackId>& trackIds) {
         int id = query.value(idColumn).toInt();
         QString dataPath = analysisPath.absoluteFilePath(QString::number(id));
         deleteFile(dataPath);
+        deleteRenderedOverviews(m_pConfig, id);
     }
     query.prepare(QString("DELETE FROM track_analysis "
                           "WHERE track_id in (%1)").arg(idList.join(",")));
@@ -247,20 +273,34 @@ bool AnalysisDao::deleteAnalysesForTrack(TrackId trackId) {
 }
 
 QDir AnalysisDao::getAnalysisStoragePath() const {
-    QString settingsPath = m_pConfig->getSettingsPath();
+    return analysisStoragePath(m_pConfig);
+}
+
+//static
+QDir AnalysisDao::analysisStoragePath(const UserSettingsPointer& pConfig) {
+    QString settingsPath = pConfig->getSettingsPath();
     QDir dir(settingsPath.append("/analysis/"));
     return dir.absolutePath().append("/");
 }
 
-QByteArray AnalysisDao::loadDataFromFile(const QString& filename) const {
-    QFile file(filename);
-    if (!file.exists()) {
-        return QByteArray();
-    }
-    if (!file.open(QIODevice::ReadOnly)) {
-        return QByteArray();
+//static
+QString AnalysisDao::renderedOverviewPath(const UserSettingsPointer& pConfig,
+        int analysisId, const QString& name) {
+    return analysisStoragePath(pConfig).absoluteFilePath(
+            QString("%1.overview.%2.png").arg(QString::number(analysisId), name));
+}
+
+//static
+void AnalysisDao::deleteRenderedOverviews(const UserSettingsPointer& pConfig,
+        int analysisId, const QString& namePrefix) {
+    const QDir dir = analysisStoragePath(pConfig);
+    const QStringList fileNames = dir.entryList(QStringList() <<
+            QString("%1.overview.%2*.png").arg(
+                    QString::number(analysisId), namePrefix),
+            QDir::Files);
+    for (const QString& fileName : fileNames) {
+        QFile::remove(dir.absoluteFilePath(fileName));
     }
-    return file.readAll();
 }
 
 bool AnalysisDao::deleteFile(const QString& fileName) const {
@@ -316,46 +356,46 @@ void AnalysisDao::saveTrackAnalyses(const Track& track) {
     ConstWaveformPointer pWaveform = track.getWaveform();
     ConstWaveformPointer pWaveSummary = track.getWaveformSummary();
 
-    // Don't try to save invalid or non-dirty waveforms.
-    if (!pWaveform || pWaveform->saveState() != Waveform::SaveState::SavePending ||
-        !pWaveSummary || pWaveSummary->saveState() != Waveform::SaveState::SavePending) {
-        return;
-    }
-
     TrackId trackId(track.getId());
 
-    AnalysisDao::AnalysisInfo analysis;
-    analysis.trackId = trackId;
-    if (pWaveform->getId() != -1) {
+    // Don't try to save invalid or non-dirty waveforms. Either of them
+    // may be pending alone, e.g. if only one of them has been converted
+    // from an outdated format when it was loaded.
+    if (pWaveform && pWaveform->saveState() == Waveform::SaveState::SavePending) {
+        AnalysisDao::AnalysisInfo analysis;
+        analysis.trackId = trackId;
+        // Replace the stored waveform if there is one
         analysis.analysisId = pWaveform->getId();
-    }
-    analysis.type = AnalysisDao::TYPE_WAVEFORM;
-    analysis.description = pWaveform->getDescription();
-    analysis.version = pWaveform->getVersion();
-    analysis.data = pWaveform->toByteArray();
-    bool success = saveAnalysis(&analysis);
-    if (success) {
-        pWaveform->setSaveState(Waveform::SaveState::Saved);
-    }
-
-    qDebug() << (success ? "Saved" : "Failed to save")
+        analysis.type = AnalysisDao::TYPE_WAVEFORM;
+        analysis.description = pWaveform->getDescription();
+        analysis.version = pWaveform->getVersion();
+        analysis.data = pWaveform->toByteArray();
+        bool success = saveAnalysis(&analysis);
+        if (success) {
+            pWaveform->setSaveState(Waveform::SaveState::Saved);
+        }
+        qDebug() << (success ? "Saved" : "Failed to save")
                  << "waveform analysis for trackId" << trackId
                  << "analysisId" << analysis.analysisId;
+    }
 
-    // Clear analysisId since we are re-using the AnalysisInfo
-    analysis.analysisId = -1;
-    analysis.type = AnalysisDao::TYPE_WAVESUMMARY;
-    analysis.description = pWaveSummary->getDescription();
-    analysis.version = pWaveSummary->getVersion();
-    analysis.data = pWaveSummary->toByteArray();
-
-    success = saveAnalysis(&analysis);
-    if (success) {
-        pWaveSummary->setSaveState(Waveform::SaveState::Saved);
+    if (pWaveSummary && pWaveSummary->saveState() == Waveform::SaveState::SavePending) {
+        AnalysisDao::AnalysisInfo analysis;
+        analysis.trackId = trackId;
+        // Replace the stored summary if there is one
+        analysis.analysisId = pWaveSummary->getId();
+        analysis.type = AnalysisDao::TYPE_WAVESUMMARY;
+        analysis.description = pWaveSummary->getDescription();
+        analysis.version = pWaveSummary->getVersion();
+        analysis.data = pWaveSummary->toByteArray();
+        bool success = saveAnalysis(&analysis);
+        if (success) {
+            pWaveSummary->setSaveState(Waveform::SaveState::Saved);
+        }
+        qDebug() << (success ? "Saved" : "Failed to save")
+                 << "waveform summary analysis for trackId" << trackId
+                 << "analysisId" << analysis.analysisId;
     }
-    qDebug() << (success ? "Saved" : "Failed to save")
-             << "waveform summary analysis for trackId" << trackId
-             << "analysisId" << analysis.analysisId;
 }
 
 size_t AnalysisDao::getDiskUsageInBytes(
@@ -28,7 +28,10 @@ class AnalysisDao : public DAO {
         AnalysisType type;
         QString description;
         QString version;
+        // Empty if the data is stored in a format that is used in place.
+        // The file at dataPath needs to be mapped into memory instead.
         QByteArray data;
+        QString dataPath;
     };
 
     explicit AnalysisDao(UserSettingsPointer pConfig);
@@ -57,6 +60,16 @@ class AnalysisDao : public DAO {
 
     void saveTrackAnalyses(const Track& track);
 
+    // Rendered overviews of a summary waveform are stored next to its
+    // analysis and deleted with it. The name identifies the variant, e.g.
+    // the type of the overview and its colors.
+    static QString renderedOverviewPath(const UserSettingsPointer& pConfig,
+            int analysisId, const QString& name);
+    // Deletes the rendered overviews of the analysis whose names start
+    // with namePrefix.
+    static void deleteRenderedOverviews(const UserSettingsPointer& pConfig,
+            int analysisId, const QString& namePrefix = QString());
+
   private:
     bool saveWaveform(const Track& tio,
                       const Waveform& waveform,
@@ -64,7 +77,7 @@ class AnalysisDao : public DAO {
     bool loadWaveform(const Track& tio,
                       Waveform* waveform, AnalysisType type);
     QDir getAnalysisStoragePath() const;
-    QByteArray loadDataFromFile(const QString& fileName) const;
+    static QDir analysisStoragePath(const UserSettingsPointer& pConfig);
     bool saveDataToFile(const QString& fileName, const QByteArray& data) const;
     bool deleteFile(const QString& filename) const;
     QList<AnalysisInfo> loadAnalysesFromQuery(TrackId trackId, QSqlQuery* query);
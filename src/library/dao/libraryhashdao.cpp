@@ -26,6 +26,38 @@ QHash<QString, int> LibraryHashDAO::getDirectoryHashes() {
     return hashes;
 }
 
+QHash<QString, qint64> LibraryHashDAO::getDirectoryModificationTimes() {
+    QSqlQuery query(m_database);
+    query.prepare("SELECT directory_path, directory_mtime FROM LibraryHashes "
+                  "WHERE directory_mtime >= 0");
+    QHash<QString, qint64> modificationTimes;
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+    }
+
+    while (query.next()) {
+        modificationTimes[query.value(0).toString()] =
+                query.value(1).toLongLong();
+    }
+    return modificationTimes;
+}
+
+void LibraryHashDAO::updateDirectoryModificationTimes(
+        const QHash<QString, qint64>& modificationTimes) {
+    QSqlQuery query(m_database);
+    query.prepare("UPDATE LibraryHashes "
+                  "SET directory_mtime=:directory_mtime "
+                  "WHERE directory_path=:directory_path");
+    for (auto it = modificationTimes.constBegin();
+            it != modificationTimes.constEnd(); ++it) {
+        query.bindValue(":directory_mtime", it.value());
+        query.bindValue(":directory_path", it.key());
+        if (!query.exec()) {
+            LOG_FAILED_QUERY(query) << "Updating directory mtime failed.";
+        }
+    }
+}
+
 int LibraryHashDAO::getDirectoryHash(const QString& dirPath) {
     //qDebug() << "LibraryHashDAO::getDirectoryHash" << QThread::currentThread() << m_database.connectionName();
     int hash = -1;
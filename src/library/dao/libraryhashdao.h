@@ -17,6 +17,10 @@ class LibraryHashDAO : public DAO {
     };
 
     QHash<QString, int> getDirectoryHashes();
+    // Returns the defined modification times of the directories.
+    QHash<QString, qint64> getDirectoryModificationTimes();
+    void updateDirectoryModificationTimes(
+            const QHash<QString, qint64>& modificationTimes);
     int getDirectoryHash(const QString& dirPath);
     void saveDirectoryHash(const QString& dirPath, const int hash);
     void updateDirectoryHash(const QString& dirPath, const int newHash,
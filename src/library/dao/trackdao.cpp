@@ -25,6 +25,7 @@
 #include "library/dao/playlistdao.h"
 #include "library/dao/analysisdao.h"
 #include "library/dao/libraryhashdao.h"
+#include "library/dao/tracksearchindex.h"
 #include "library/coverartcache.h"
 #include "track/beatfactory.h"
 #include "track/beats.h"
@@ -90,6 +91,13 @@ TrackDAO::~TrackDAO() {
     addTracksFinish(true);
 }
 
+void TrackDAO::initialize(const QSqlDatabase& database) {
+    m_database = database;
+    // Installs the triggers that keep the index up to date on this
+    // connection. Searches fall back to LIKE if it is not available.
+    TrackSearchIndex::initialize(m_database);
+}
+
 void TrackDAO::finish() {
     // Save all tracks that haven't been saved yet.
     QMutexLocker locker(&m_sTracksMutex);
@@ -62,9 +62,7 @@ class TrackDAO : public QObject, public virtual DAO {
             UserSettingsPointer pConfig);
     ~TrackDAO() override;
 
-    void initialize(const QSqlDatabase& database) override {
-        m_database = database;
-    }
+    void initialize(const QSqlDatabase& database) override;
     void finish();
 
     TrackId getTrackId(const QString& absoluteFilePath);
@@ -0,0 +1,288 @@
+#include "library/dao/tracksearchindex.h"
+
+#include <QSqlQuery>
+#include <QtDebug>
+
+#include "library/dao/trackschema.h"
+#include "library/queryutil.h"
+#include "util/db/dbconnection.h"
+#include "util/db/sqllikewildcards.h"
+#include "util/db/sqltransaction.h"
+#include "util/logger.h"
+#include "util/performancetimer.h"
+
+namespace {
+
+const mixxx::Logger kLogger("TrackSearchIndex");
+
+const QString kTableName = "library_fts";
+const QString kInsertTrigger = "library_fts_insert";
+// A single row with the number of modifications of the indexed columns
+// that have been made to the library and to the index. The library
+// revision is counted by persistent triggers, which also fire in versions
+// that don't know the index.
+const QString kStateTableName = "library_fts_state";
+
+// The location is taken from track_locations
+QStringList indexedColumns() {
+    return QStringList()
+            << LIBRARYTABLE_ARTIST
+            << LIBRARYTABLE_TITLE
+            << LIBRARYTABLE_ALBUM
+            << LIBRARYTABLE_ALBUMARTIST
+            << LIBRARYTABLE_GENRE
+            << LIBRARYTABLE_COMPOSER
+            << LIBRARYTABLE_GROUPING
+            << LIBRARYTABLE_COMMENT
+            << LIBRARYTABLE_LOCATION;
+}
+
+// The folded values of the indexed columns of the library row prefix
+QString foldedValues(const QString& prefix) {
+    const QString latinLow = mixxx::DbConnection::latinLowFunction();
+    QStringList values;
+    for (const auto& column: indexedColumns()) {
+        if (column == LIBRARYTABLE_LOCATION) {
+            values << QString("%1((SELECT %2 FROM track_locations WHERE %3=%4.%5))")
+                    .arg(latinLow, TRACKLOCATIONSTABLE_LOCATION,
+                            TRACKLOCATIONSTABLE_ID, prefix, LIBRARYTABLE_LOCATION);
+        } else {
+            values << QString("%1(%2.%3)").arg(latinLow, prefix, column);
+        }
+    }
+    return values.join(",");
+}
+
+bool execute(const QSqlDatabase& database, const QString& statement) {
+    QSqlQuery query(database);
+    if (!query.exec(statement)) {
+        LOG_FAILED_QUERY(query);
+        return false;
+    }
+    return true;
+}
+
+bool tableExists(const QSqlDatabase& database, const QString& tableName) {
+    QSqlQuery query(database);
+    query.prepare("SELECT 1 FROM sqlite_master WHERE type='table' AND name=:name");
+    query.bindValue(":name", tableName);
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+        return false;
+    }
+    return query.next();
+}
+
+}  // namespace
+
+//static
+bool TrackSearchIndex::initialize(const QSqlDatabase& database) {
+    if (mixxx::DbConnection::latinLowFunction().isEmpty()) {
+        return false;
+    }
+
+    bool created = false;
+    if (!tableExists(database, kTableName)) {
+        // The values are folded already
+        QSqlQuery query(database);
+        if (!query.exec(QString(
+                "CREATE VIRTUAL TABLE %1 USING fts5(%2, "
+                "tokenize='trigram case_sensitive 1')")
+                .arg(kTableName, indexedColumns().join(",")))) {
+            kLogger.info()
+                    << "Searching without full-text index:"
+                    << query.lastError();
+            return false;
+        }
+        created = true;
+    }
+    if (!tableExists(database, kStateTableName)) {
+        // Out of sync until the index has been rebuilt
+        if (!execute(database, QString(
+                "CREATE TABLE %1 (library_revision INTEGER NOT NULL, "
+                "index_revision INTEGER NOT NULL)").arg(kStateTableName)) ||
+                !execute(database, QString(
+                        "INSERT INTO %1 VALUES (1, 0)").arg(kStateTableName))) {
+            return false;
+        }
+    }
+
+    if (!createTriggers(database)) {
+        return false;
+    }
+    if (created || !isInSync(database)) {
+        return rebuild(database);
+    }
+    return true;
+}
+
+//static
+bool TrackSearchIndex::createTriggers(const QSqlDatabase& database) {
+    const QString columns = indexedColumns().join(",");
+    const QString insertNew = QString(
+            "INSERT INTO %1(rowid,%2) VALUES (NEW.%3,%4);")
+            .arg(kTableName, columns, LIBRARYTABLE_ID, foldedValues("NEW"));
+    const QString deleteOld = QString(
+            "DELETE FROM %1 WHERE rowid=OLD.%2;")
+            .arg(kTableName, LIBRARYTABLE_ID);
+    const QString countIndexRevision = QString(
+            "UPDATE %1 SET index_revision=index_revision+1;")
+            .arg(kStateTableName);
+    const QString countLibraryRevision = QString(
+            "UPDATE %1 SET library_revision=library_revision+1;")
+            .arg(kStateTableName);
+
+    // Persistent triggers count the modifications of all versions. They
+    // fire for the same statements as the temporary triggers below.
+    QStringList revisionTriggers;
+    revisionTriggers << QString(
+            "CREATE TRIGGER IF NOT EXISTS library_revision_insert "
+            "AFTER INSERT ON library BEGIN %1 END")
+            .arg(countLibraryRevision);
+    revisionTriggers << QString(
+            "CREATE TRIGGER IF NOT EXISTS library_revision_update "
+            "AFTER UPDATE OF %1,%2 ON library BEGIN %3 END")
+            .arg(LIBRARYTABLE_ID, columns, countLibraryRevision);
+    revisionTriggers << QString(
+            "CREATE TRIGGER IF NOT EXISTS library_revision_delete "
+            "AFTER DELETE ON library BEGIN %1 END")
+            .arg(countLibraryRevision);
+    revisionTriggers << QString(
+            "CREATE TRIGGER IF NOT EXISTS library_revision_relocate "
+            "AFTER UPDATE OF %1 ON track_locations BEGIN %2 END")
+            .arg(TRACKLOCATIONSTABLE_LOCATION, countLibraryRevision);
+    for (const auto& trigger: revisionTriggers) {
+        if (!execute(database, trigger)) {
+            return false;
+        }
+    }
+
+    // Temporary triggers live on this connection only and may refer to
+    // functions of the connection
+    QStringList triggers;
+    triggers << QString(
+            "CREATE TEMP TRIGGER IF NOT EXISTS %1 "
+            "AFTER INSERT ON main.library BEGIN %2 %3 END")
+            .arg(kInsertTrigger, insertNew, countIndexRevision);
+    triggers << QString(
+            "CREATE TEMP TRIGGER IF NOT EXISTS library_fts_update "
+            "AFTER UPDATE OF %1,%2 ON main.library BEGIN %3 %4 %5 END")
+            .arg(LIBRARYTABLE_ID, columns, deleteOld, insertNew,
+                    countIndexRevision);
+    triggers << QString(
+            "CREATE TEMP TRIGGER IF NOT EXISTS library_fts_delete "
+            "AFTER DELETE ON main.library BEGIN %1 %2 END")
+            .arg(deleteOld, countIndexRevision);
+    triggers << QString(
+            "CREATE TEMP TRIGGER IF NOT EXISTS library_fts_relocate "
+            "AFTER UPDATE OF %1 ON main.track_locations BEGIN "
+            "UPDATE %2 SET %3=%4(NEW.%1) WHERE rowid IN "
+            "(SELECT %5 FROM library WHERE %3=NEW.%6); %7 END")
+            .arg(TRACKLOCATIONSTABLE_LOCATION, kTableName,
+                    LIBRARYTABLE_LOCATION,
+                    mixxx::DbConnection::latinLowFunction(),
+                    LIBRARYTABLE_ID, TRACKLOCATIONSTABLE_ID,
+                    countIndexRevision);
+
+    for (const auto& trigger: triggers) {
+        if (!execute(database, trigger)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//static
+bool TrackSearchIndex::isInSync(const QSqlDatabase& database) {
+    // Every modification without the temporary triggers counts only the
+    // library revision. The row counts catch modifications while the
+    // persistent triggers were missing, e.g. after the library table has
+    // been recreated.
+    QSqlQuery query(database);
+    if (!query.exec(QString(
+            "SELECT (SELECT library_revision=index_revision FROM %1) AND "
+            "(SELECT COUNT(*) FROM library)=(SELECT COUNT(*) FROM %2)")
+            .arg(kStateTableName, kTableName))) {
+        LOG_FAILED_QUERY(query);
+        return false;
+    }
+    return query.next() && query.value(0).toBool();
+}
+
+//static
+bool TrackSearchIndex::rebuild(const QSqlDatabase& database) {
+    PerformanceTimer time;
+    time.start();
+
+    SqlTransaction transaction(database);
+    if (!execute(database, QString("DELETE FROM %1").arg(kTableName)) ||
+            !execute(database, QString(
+                    "INSERT INTO %1(rowid,%2) SELECT %3,%4 FROM library")
+                    .arg(kTableName, indexedColumns().join(","),
+                            LIBRARYTABLE_ID, foldedValues("library"))) ||
+            !execute(database, QString(
+                    "UPDATE %1 SET index_revision=library_revision")
+                    .arg(kStateTableName))) {
+        return false;
+    }
+    if (!transaction.commit()) {
+        return false;
+    }
+
+    kLogger.info()
+            << "Rebuilding the full-text index took"
+            << time.elapsed().debugMillisWithUnit();
+    return true;
+}
+
+//static
+bool TrackSearchIndex::isAvailable(const QSqlDatabase& database) {
+    QSqlQuery query(database);
+    query.prepare("SELECT 1 FROM sqlite_temp_master WHERE type='trigger' AND name=:name");
+    query.bindValue(":name", kInsertTrigger);
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+        return false;
+    }
+    return query.next();
+}
+
+//static
+bool TrackSearchIndex::isIndexedColumn(const QString& column) {
+    return indexedColumns().contains(column);
+}
+
+//static
+QString TrackSearchIndex::matchSql(const QSqlDatabase& database,
+        const QString& idColumn,
+        const QStringList& columns,
+        const QString& argument) {
+    if (columns.isEmpty() ||
+            argument.contains(kSqlLikeMatchAll) ||
+            argument.contains(kSqlLikeMatchOne)) {
+        return QString();
+    }
+    QString folded = mixxx::DbConnection::latinLow(argument);
+    if (folded.toUcs4().size() < kMinTermLength) {
+        // Shorter than a trigram
+        return QString();
+    }
+
+    QStringList nullChecks;
+    for (const auto& column: columns) {
+        if (!isIndexedColumn(column)) {
+            return QString();
+        }
+        nullChecks << QString("%1 IS NULL").arg(column);
+    }
+
+    // A phrase of trigrams matches the substring
+    const QString match = QString("{%1} : \"%2\"")
+            .arg(columns.join(" "), folded.replace("\"", "\"\""));
+    FieldEscaper escaper(database);
+    // LIKE is NULL if no column matches and one of them is NULL
+    return QString("(%1 IN (SELECT rowid FROM %2 WHERE %2 MATCH %3) OR "
+            "CASE WHEN %4 THEN NULL ELSE 0 END)")
+            .arg(idColumn, kTableName, escaper.escapeString(match),
+                    nullChecks.join(" OR "));
+}
@@ -0,0 +1,50 @@
+#ifndef MIXXX_TRACKSEARCHINDEX_H
+#define MIXXX_TRACKSEARCHINDEX_H
+
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+
+// A full-text index (SQLite FTS5) of the text columns of the library and
+// of the track locations, which answers the "column LIKE '%term%'"
+// comparisons of searches without scanning the library.
+//
+// The index stores the text as the LIKE operator compares it, i.e. lower
+// case and without diacritics, split into trigrams. Matching a folded term
+// therefore finds exactly the substrings that LIKE finds. Terms that are
+// shorter than a trigram or contain LIKE wildcards are left to LIKE.
+//
+// The index is maintained by temporary triggers that TrackDAO installs on
+// each of its database connections. Versions that don't know the index
+// can still modify the library. Persistent triggers count all
+// modifications, so the index is rebuilt if it has missed any.
+class TrackSearchIndex final {
+  public:
+    static const int kMinTermLength = 3;
+
+    // Creates the index unless it exists, installs the triggers on the
+    // connection and rebuilds the index if needed. Returns false if the
+    // index is not available, e.g. because SQLite lacks FTS5.
+    static bool initialize(const QSqlDatabase& database);
+
+    // Returns whether the index is maintained on this connection.
+    static bool isAvailable(const QSqlDatabase& database);
+
+    static bool isIndexedColumn(const QString& column);
+
+    // Returns an SQL expression for "column LIKE '%argument%' OR ..." that
+    // looks up the tracks identified by idColumn in the index, with the
+    // same result including NULL. Returns a null string if the index can't
+    // answer the comparison.
+    static QString matchSql(const QSqlDatabase& database,
+            const QString& idColumn,
+            const QStringList& columns,
+            const QString& argument);
+
+  private:
+    static bool createTriggers(const QSqlDatabase& database);
+    static bool rebuild(const QSqlDatabase& database);
+    static bool isInSync(const QSqlDatabase& database);
+};
+
+#endif // MIXXX_TRACKSEARCHINDEX_H
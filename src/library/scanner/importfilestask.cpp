@@ -1,8 +1,18 @@
 #include "library/scanner/importfilestask.h"
 
+#include "library/coverartutils.h"
 #include "library/scanner/libraryscanner.h"
+#include "sources/soundsourceproxy.h"
 #include "util/timer.h"
 
+namespace {
+
+// Parsed tracks are handed over to the scanner thread in batches to
+// keep the number of queued signals low.
+const int kTrackBatchSize = 64;
+
+} // anonymous namespace
+
 ImportFilesTask::ImportFilesTask(LibraryScanner* pScanner,
                                  const ScannerGlobalPointer scannerGlobal,
                                  const QString& dirPath,
@@ -22,6 +32,7 @@ ImportFilesTask::ImportFilesTask(LibraryScanner* pScanner,
 
 void ImportFilesTask::run() {
     ScopedTimer timer("ImportFilesTask::run");
+    QList<TrackPointer> newTracks;
     for (const QFileInfo& fileInfo: m_filesToImport) {
         // If a flag was raised telling us to cancel the library scan then stop.
         if (m_scannerGlobal->shouldCancel()) {
@@ -49,10 +60,41 @@ void ImportFilesTask::run() {
             }
             qDebug() << "Importing track" << filePath;
 
-            emit(addNewTrack(filePath));
+            newTracks.append(parseTrack(fileInfo));
+            if (newTracks.size() >= kTrackBatchSize) {
+                emit(addNewTracks(newTracks));
+                newTracks.clear();
+            }
         }
     }
+    if (!newTracks.isEmpty()) {
+        emit(addNewTracks(newTracks));
+    }
     // Insert or update the hash in the database.
     emit(directoryHashedAndScanned(m_dirPath, !m_prevHashExists, m_newHash));
     setSuccess(true);
 }
+
+TrackPointer ImportFilesTask::parseTrack(const QFileInfo& fileInfo) const {
+    TrackPointer pTrack(Track::newTemporary(fileInfo, m_pToken));
+    // Tracks are deleted later by the event loop of their thread and the
+    // threads of the pool have none. This also moves the beats that are
+    // created while parsing.
+    pTrack->moveToThread(m_pScanner);
+
+    SoundSourceProxy(pTrack).updateTrack();
+    if (!pTrack->isHeaderParsed()) {
+        qWarning() << "ImportFilesTask: Failed to parse track metadata from file"
+                << pTrack->getLocation();
+        // Continue with adding the track to the library, no matter
+        // if parsing the metadata from file succeeded or failed.
+    }
+
+    // Guess the cover art from the images in the directory unless the file
+    // has embedded cover art, instead of detecting it after the scan.
+    if (pTrack->getCoverInfo().source == CoverInfo::UNKNOWN) {
+        pTrack->setCoverInfo(CoverArtUtils::selectCoverArtForTrack(
+                fileInfo.baseName(), pTrack->getAlbum(), m_possibleCovers));
+    }
+    return pTrack;
+}
@@ -10,6 +10,10 @@
 
 // Import the provided files. Successful if the scan completed without being
 // cancelled. False if the scan was cancelled part-way through.
+//
+// The metadata and cover art of new files are parsed by the task, i.e. in
+// parallel for different directories, only inserting the tracks into the
+// library is left to the scanner thread.
 class ImportFilesTask : public ScannerTask {
     Q_OBJECT
   public:
@@ -26,6 +30,8 @@ class ImportFilesTask : public ScannerTask {
     virtual void run();
 
   private:
+    TrackPointer parseTrack(const QFileInfo& fileInfo) const;
+
     const QString m_dirPath;
     const bool m_prevHashExists;
     const int m_newHash;
@@ -11,14 +11,22 @@
 #include "util/trace.h"
 #include "util/file.h"
 #include "util/timer.h"
+#include "util/math.h"
 #include "library/scanner/scannerutil.h"
 #include "util/db/dbconnectionpooler.h"
 #include "util/db/dbconnectionpooled.h"
 
 namespace {
 
-// TODO(rryan) make configurable
-const int kScannerThreadPoolSize = 1;
+// Directories are listed and their tracks parsed in parallel, up to this
+// many threads by default. More threads mostly add seeks on spinning disks.
+const int kMaxScannerThreadPoolSize = 4;
+
+const ConfigKey kScannerThreadPoolSizeConfigKey(
+        "[Library]", "ScannerThreadPoolSize");
+
+// Skip listing directories that have not been modified since the last scan
+const ConfigKey kIncrementalRescanConfigKey("[Library]", "IncrementalRescan");
 
 mixxx::Logger kLogger("LibraryScanner");
 
@@ -32,6 +40,7 @@ LibraryScanner::LibraryScanner(
         const UserSettingsPointer& pConfig)
         : m_pDbConnectionPool(std::move(pDbConnectionPool)),
           m_pTrackCollection(pTrackCollection),
+          m_pConfig(pConfig),
           m_analysisDao(pConfig),
           m_trackDao(m_cueDao, m_playlistDao,
                   m_analysisDao, m_libraryHashDao,
@@ -47,7 +56,11 @@ LibraryScanner::LibraryScanner(
     const int instanceId = s_instanceCounter.fetchAndAddAcquire(1) + 1;
     setObjectName(QString("LibraryScanner %1").arg(instanceId));
 
-    m_pool.setMaxThreadCount(kScannerThreadPoolSize);
+    const int threadPoolSize = m_pConfig->getValue(
+            kScannerThreadPoolSizeConfigKey,
+            math_min(QThread::idealThreadCount(), kMaxScannerThreadPoolSize));
+    m_pool.setMaxThreadCount(math_max(threadPoolSize, 1));
+    kLogger.debug() << "Using" << m_pool.maxThreadCount() << "threads";
 
     // Listen to signals from our public methods (invoked by other threads) and
     // connect them to our slots to run the command on the scanner thread.
@@ -133,8 +146,16 @@ void LibraryScanner::slotStartScan() {
     }
     changeScannerState(SCANNING);
 
+    m_phaseDurations.clear();
+    m_phaseTimer.start();
+
     QSet<QString> trackLocations = m_trackDao.getTrackLocations();
     QHash<QString, int> directoryHashes = m_libraryHashDao.getDirectoryHashes();
+    QHash<QString, qint64> directoryModificationTimes;
+    if (m_pConfig->getValue(kIncrementalRescanConfigKey, true)) {
+        directoryModificationTimes =
+                m_libraryHashDao.getDirectoryModificationTimes();
+    }
     QRegExp extensionFilter(SoundSourceProxy::getSupportedFileNamesRegex());
     QRegExp coverExtensionFilter =
             QRegExp(CoverArtUtils::supportedCoverArtExtensionsRegex(),
@@ -142,7 +163,8 @@ void LibraryScanner::slotStartScan() {
     QStringList directoryBlacklist = ScannerUtil::getDirectoryBlacklist();
 
     m_scannerGlobal = ScannerGlobalPointer(
-            new ScannerGlobal(trackLocations, directoryHashes, extensionFilter,
+            new ScannerGlobal(trackLocations, directoryHashes,
+                              directoryModificationTimes, extensionFilter,
                               coverExtensionFilter, directoryBlacklist));
 
     m_scannerGlobal->startTimer();
@@ -165,6 +187,7 @@ void LibraryScanner::slotStartScan() {
     // Start scanning the library. This prepares insertion queries in TrackDAO
     // (must be called before calling addTracksAdd) and begins a transaction.
     m_trackDao.addTracksPrepare();
+    finishScanPhase("preparing");
 
     // First Scan all known directories we have a hash for.
     // In a second stage, we scan all new directories. This guarantees,
@@ -205,6 +228,7 @@ void LibraryScanner::slotFinishHashedScan() {
     TaskWatcher* pWatcher = &m_scannerGlobal->getTaskWatcher();
     disconnect(pWatcher, SIGNAL(allTasksDone()),
             this, SLOT(slotFinishHashedScan()));
+    finishScanPhase("scanning known directories");
 
     if (m_scannerGlobal->unhashedDirs().empty()) {
         // bypass the second stage
@@ -243,6 +267,11 @@ void LibraryScanner::cleanUpScan() {
     QSqlDatabase dbConnection = mixxx::DbConnectionPooled(m_pDbConnectionPool);
     ScopedTransaction transaction(dbConnection);
 
+    // Only directories that have been listed completely, i.e. after a clean
+    // scan, may be skipped by the next scan
+    m_libraryHashDao.updateDirectoryModificationTimes(
+            m_scannerGlobal->listedDirectories());
+
     kLogger.debug() << "Marking tracks in changed directories as verified";
     m_trackDao.markTrackLocationsAsVerified(m_scannerGlobal->verifiedTracks());
 
@@ -253,6 +282,7 @@ void LibraryScanner::cleanUpScan() {
             true);
     m_trackDao.markTracksInDirectoriesAsVerified(
             m_scannerGlobal->verifiedDirectories());
+    finishScanPhase("verifying directories");
 
     // After verifying tracks and directories via recursive scanning of the
     // library directories the only unverified tracks will be files that are
@@ -266,6 +296,7 @@ void LibraryScanner::cleanUpScan() {
         // canceled
         return;
     }
+    finishScanPhase("verifying remaining tracks");
 
     kLogger.debug() << "Marking unverified tracks as deleted";
     m_trackDao.markUnverifiedTracksAsDeleted();
@@ -285,6 +316,7 @@ void LibraryScanner::cleanUpScan() {
         // canceled
         return;
     }
+    finishScanPhase("detecting moved tracks");
 
     // Remove the hashes for any directories that have been marked as
     // deleted to clean up. We need to do this otherwise we can skip over
@@ -293,11 +325,13 @@ void LibraryScanner::cleanUpScan() {
     m_libraryHashDao.removeDeletedDirectoryHashes();
 
     transaction.commit();
+    finishScanPhase("committing");
 
     kLogger.debug() << "Detecting cover art for unscanned files";
     QSet<TrackId> coverArtTracksChanged;
     m_trackDao.detectCoverArtForTracksWithoutCover(
             m_scannerGlobal->shouldCancelPointer(), &coverArtTracksChanged);
+    finishScanPhase("detecting cover art");
 
     // Update BaseTrackCache via signals connected to the main TrackDAO.
     emit(tracksMoved(tracksMovedSetOld, tracksMovedSetNew));
@@ -313,6 +347,9 @@ void LibraryScanner::slotFinishUnhashedScan() {
         return;
     }
 
+    if (!m_scannerGlobal->unhashedDirs().empty()) {
+        finishScanPhase("scanning new directories");
+    }
     bool bScanFinishedCleanly = m_scannerGlobal->scanFinishedCleanly();
 
     if (bScanFinishedCleanly) {
@@ -325,6 +362,7 @@ void LibraryScanner::slotFinishUnhashedScan() {
     // finish cleanly and the user did not cancel the transaction.
     m_trackDao.addTracksFinish(!m_scannerGlobal->shouldCancel() &&
                                !bScanFinishedCleanly);
+    finishScanPhase("adding tracks");
 
     if (!m_scannerGlobal->shouldCancel() && bScanFinishedCleanly) {
         cleanUpScan();
@@ -338,15 +376,17 @@ void LibraryScanner::slotFinishUnhashedScan() {
 
     // TODO(XXX) doesn't take into account verifyRemainingTracks.
     qDebug("Scan took: %s. "
-           "%d unchanged directories. "
+           "%d unchanged directories, %d of them not listed. "
            "%d changed/added directories. "
            "%d tracks verified from changed/added directories. "
            "%d new tracks.",
            m_scannerGlobal->timerElapsed().formatNanosWithUnit().toLocal8Bit().constData(),
            m_scannerGlobal->verifiedDirectories().size(),
+           m_scannerGlobal->numUnmodifiedDirectories(),
            m_scannerGlobal->numScannedDirectories(),
            m_scannerGlobal->verifiedTracks().size(),
            m_scannerGlobal->addedTracks().size());
+    kLogger.info() << "Scan phases:" << m_phaseDurations.join(", ");
 
     m_scannerGlobal.clear();
     changeScannerState(FINISHED);
@@ -355,6 +395,11 @@ void LibraryScanner::slotFinishUnhashedScan() {
     emit(scanFinished());
 }
 
+void LibraryScanner::finishScanPhase(const QString& phase) {
+    m_phaseDurations << QString("%1 %2").arg(
+            phase, m_phaseTimer.restart().debugMillisWithUnit());
+}
+
 void LibraryScanner::scan() {
     if (changeScannerState(STARTING)) {
         emit(startScan());
@@ -416,8 +461,8 @@ void LibraryScanner::queueTask(ScannerTask* pTask) {
             this, SLOT(slotDirectoryUnchanged(QString)));
     connect(pTask, SIGNAL(trackExists(QString)),
             this, SLOT(slotTrackExists(QString)));
-    connect(pTask, SIGNAL(addNewTrack(QString)),
-            this, SLOT(slotAddNewTrack(QString)));
+    connect(pTask, SIGNAL(addNewTracks(QList<TrackPointer>)),
+            this, SLOT(slotAddNewTracks(QList<TrackPointer>)));
 
     // Progress signals.
     // Pass directly to the main thread
@@ -466,33 +511,31 @@ void LibraryScanner::slotTrackExists(const QString& trackPath) {
     }
 }
 
-void LibraryScanner::slotAddNewTrack(const QString& trackPath) {
-    //kLogger.debug() << "slotAddNewTrack" << trackPath;
-    ScopedTimer timer("LibraryScanner::addNewTrack");
-    // For statistics tracking and to detect moved tracks
-    TrackPointer pTrack(m_trackDao.addTracksAddFile(trackPath, false));
-    if (pTrack) {
-        // The track's actual location might differ from the
-        // given trackPath
+void LibraryScanner::slotAddNewTracks(const QList<TrackPointer>& tracks) {
+    //kLogger.debug() << "slotAddNewTracks" << tracks.size();
+    ScopedTimer timer("LibraryScanner::addNewTracks");
+    // The metadata has been parsed by the ImportFilesTask already, only
+    // the insertion into the scan's transaction is left to this thread.
+    for (const auto& pTrack: tracks) {
+        // For statistics tracking and to detect moved tracks
         const QString trackLocation(pTrack->getLocation());
-        // Acknowledge successful track addition
-        if (m_scannerGlobal) {
-            m_scannerGlobal->trackAdded(trackLocation);
-        }
-        // Signal the main instance of TrackDAO, that there is
-        // a new track in the database.
-        emit(trackAdded(pTrack));
-        emit(progressLoading(trackLocation));
-    } else {
-        // Acknowledge failed track addition
+        const TrackId trackId(m_trackDao.addTracksAddTrack(pTrack, false));
+        // Acknowledge the track addition, even if it failed
         // TODO(XXX): Is it really intended to acknowledge a failed
         // track addition with a trackAdded() signal??
         if (m_scannerGlobal) {
-            m_scannerGlobal->trackAdded(trackPath);
+            m_scannerGlobal->trackAdded(trackLocation);
+        }
+        if (trackId.isValid()) {
+            // Signal the main instance of TrackDAO, that there is
+            // a new track in the database.
+            emit(trackAdded(pTrack));
+            emit(progressLoading(trackLocation));
+        } else {
+            kLogger.warning()
+                    << "Failed to add track to library:"
+                    << trackLocation;
         }
-        kLogger.warning()
-                << "Failed to add track to library:"
-                << trackPath;
     }
 }
 
@@ -17,6 +17,7 @@
 #include "library/scanner/scannerglobal.h"
 #include "track/track.h"
 #include "util/db/dbconnectionpool.h"
+#include "util/performancetimer.h"
 
 #include <gtest/gtest.h>
 
@@ -72,7 +73,7 @@ class LibraryScanner : public QThread {
                                    bool newDirectory, int hash);
     void slotDirectoryUnchanged(const QString& directoryPath);
     void slotTrackExists(const QString& trackPath);
-    void slotAddNewTrack(const QString& trackPath);
+    void slotAddNewTracks(const QList<TrackPointer>& tracks);
 
   private:
     enum ScannerState {
@@ -97,6 +98,8 @@ class LibraryScanner : public QThread {
     bool changeScannerState(LibraryScanner::ScannerState newState);
 
     void cleanUpScan();
+    // Records the duration of a phase of the scan for the summary.
+    void finishScanPhase(const QString& phase);
 
     mixxx::DbConnectionPoolPtr m_pDbConnectionPool;
 
@@ -104,6 +107,8 @@ class LibraryScanner : public QThread {
     // thread.
     TrackCollection* m_pTrackCollection;
 
+    UserSettingsPointer m_pConfig;
+
     // The pool of threads used for worker tasks.
     QThreadPool m_pool;
 
@@ -126,6 +131,9 @@ class LibraryScanner : public QThread {
     volatile ScannerState m_state;
 
     QStringList m_libraryRootDirs;
+
+    PerformanceTimer m_phaseTimer;
+    QStringList m_phaseDurations;
     QScopedPointer<LibraryScannerDlg> m_pProgressDlg;
 };
 
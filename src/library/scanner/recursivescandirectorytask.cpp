@@ -1,3 +1,4 @@
+#include <QDateTime>
 #include <QDirIterator>
 
 #include "library/scanner/recursivescandirectorytask.h"
@@ -26,6 +27,30 @@ void RecursiveScanDirectoryTask::run() {
     //qDebug() << "Burn CPU";
     //for (int i = 0;i < 1000000000; i++) asm("nop");
 
+    const QString dirPath = m_dir.path();
+
+    // Stat the directory before listing it, so that modifications during
+    // the listing are noticed by the next scan.
+    const QDateTime lastModified = QFileInfo(dirPath).lastModified();
+    const qint64 modificationTime =
+            lastModified.isValid() ? lastModified.toMSecsSinceEpoch() : -1;
+    if (m_scannerGlobal->directoryUnmodified(dirPath, modificationTime)) {
+        // Neither the file list nor the subdirectories have changed,
+        // which saves listing large libraries on slow network shares.
+        m_scannerGlobal->unmodifiedDirectorySkipped();
+        emit(directoryUnchanged(dirPath));
+        QLinkedList<QDir> dirsToScan;
+        foreach (const QString& subdirPath,
+                m_scannerGlobal->knownSubdirectories(dirPath)) {
+            if (!m_scannerGlobal->directoryBlacklisted(subdirPath)) {
+                dirsToScan.append(QDir(subdirPath));
+            }
+        }
+        scanSubdirectories(dirsToScan);
+        setSuccess(true);
+        return;
+    }
+
     // Note, we save on filesystem operations (and random work) by initializing
     // a QDirIterator with a QDir instead of a QString -- but it inherits its
     // Filter from the QDir so we have to set it first. If the QDir has not done
@@ -71,12 +96,12 @@ void RecursiveScanDirectoryTask::run() {
         }
     }
 
+    m_scannerGlobal->directoryListed(dirPath, modificationTime);
+
     // Note: A hash of "0" is a real hash if the directory contains no files!
     // Calculate a hash of the directory's file list.
     int newHash = qHash(newHashStr.join(""));
 
-    QString dirPath = m_dir.path();
-
     // Try to retrieve a hash from the last time that directory was scanned.
     int prevHash = m_scannerGlobal->directoryHashInDatabase(dirPath);
     bool prevHashExists = prevHash != -1;
@@ -102,6 +127,12 @@ void RecursiveScanDirectoryTask::run() {
         m_scannerGlobal->addUnhashedDir(m_dir, m_pToken);
     }
 
+    scanSubdirectories(dirsToScan);
+    setSuccess(true);
+}
+
+void RecursiveScanDirectoryTask::scanSubdirectories(
+        const QLinkedList<QDir>& dirsToScan) {
     // Process all of the sub-directories.
     foreach (const QDir& nextDir, dirsToScan) {
         // Atomically test and mark the directory as scanned to avoid
@@ -113,5 +144,4 @@ void RecursiveScanDirectoryTask::run() {
                                                    nextDir, m_pToken, m_scanUnhashed));
         }
     }
-    setSuccess(true);
 }
@@ -2,6 +2,7 @@
 #define RECURSIVESCANDIRECTORYTASK_H
 
 #include <QDir>
+#include <QLinkedList>
 
 #include "library/scanner/scannertask.h"
 #include "util/sandbox.h"
@@ -9,7 +10,9 @@
 // Recursively scan a music library. Doesn't import tracks for any directories
 // that have already been scanned and have not changed. Changes are tracked by
 // performing a hash of the directory's file list, and those hashes are stored
-// in the database. Successful if the scan completed without being
+// in the database. Directories that have not been modified since the last
+// scan are not even listed, their subdirectories are known from the
+// database. Successful if the scan completed without being
 // cancelled. False if the scan was cancelled part-way through.
 class RecursiveScanDirectoryTask : public ScannerTask {
     Q_OBJECT
@@ -25,6 +28,8 @@ class RecursiveScanDirectoryTask : public ScannerTask {
     virtual void run();
 
   private:
+    void scanSubdirectories(const QLinkedList<QDir>& dirsToScan);
+
     QDir m_dir;
     SecurityTokenPointer m_pToken;
     bool m_scanUnhashed;
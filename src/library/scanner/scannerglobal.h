@@ -1,6 +1,7 @@
 #ifndef SCANNERGLOBAL_H
 #define SCANNERGLOBAL_H
 
+#include <QDateTime>
 #include <QSet>
 #include <QHash>
 #include <QRegExp>
@@ -36,20 +37,37 @@ class DirInfo {
 
 class ScannerGlobal {
   public:
+    // Directories with one of the directoryModificationTimes are not listed
+    // again, empty for a full scan.
     ScannerGlobal(const QSet<QString>& trackLocations,
                   const QHash<QString, int>& directoryHashes,
+                  const QHash<QString, qint64>& directoryModificationTimes,
                   const QRegExp& supportedExtensionsMatcher,
                   const QRegExp& supportedCoverExtensionsMatcher,
                   const QStringList& directoriesBlacklist)
             : m_trackLocations(trackLocations),
               m_directoryHashes(directoryHashes),
+              m_directoryModificationTimes(directoryModificationTimes),
               m_supportedExtensionsMatcher(supportedExtensionsMatcher),
               m_supportedCoverExtensionsMatcher(supportedCoverExtensionsMatcher),
               m_directoriesBlacklist(directoriesBlacklist),
               // Unless marked un-clean, we assume it will finish cleanly.
               m_scanFinishedCleanly(true),
               m_shouldCancel(false),
-              m_numScannedDirectories(0) {
+              m_scanStartTime(QDateTime::currentMSecsSinceEpoch()),
+              m_numScannedDirectories(0),
+              m_numUnmodifiedDirectories(0) {
+        if (!m_directoryModificationTimes.isEmpty()) {
+            for (auto it = m_directoryHashes.constBegin();
+                    it != m_directoryHashes.constEnd(); ++it) {
+                const QString& directoryPath = it.key();
+                const int separator = directoryPath.lastIndexOf('/');
+                if (separator > 0) {
+                    m_subdirectories[directoryPath.left(separator)]
+                            << directoryPath;
+                }
+            }
+        }
     }
 
     TaskWatcher& getTaskWatcher() {
@@ -66,6 +84,48 @@ class ScannerGlobal {
         return m_directoryHashes.value(directoryPath, -1);
     }
 
+    // Returns whether the directory has the same modification time as when
+    // it was listed by the last scan. Entries of a directory can't be
+    // added, removed or renamed without modifying it.
+    inline bool directoryUnmodified(const QString& directoryPath,
+                                    qint64 modificationTime) const {
+        return modificationTime >= 0 &&
+                m_directoryHashes.contains(directoryPath) &&
+                m_directoryModificationTimes.value(directoryPath, -1) ==
+                        modificationTime;
+    }
+
+    // The subdirectories that the last scan found in the directory.
+    inline QStringList knownSubdirectories(const QString& directoryPath) const {
+        return m_subdirectories.value(directoryPath);
+    }
+
+    // Records the modification time of a directory from before it was
+    // listed. Modification times that may still change within their
+    // granularity are not recorded, then the next scan lists the directory.
+    void directoryListed(const QString& directoryPath,
+                         qint64 modificationTime) {
+        if (modificationTime > m_scanStartTime - kModificationTimeGranularity) {
+            modificationTime = -1;
+        }
+        QMutexLocker locker(&m_listedDirectoriesMutex);
+        m_listedDirectories[directoryPath] = modificationTime;
+    }
+
+    // Only used when only one using thread is around.
+    const QHash<QString, qint64>& listedDirectories() const {
+        return m_listedDirectories;
+    }
+
+    void unmodifiedDirectorySkipped() {
+        QMutexLocker locker(&m_listedDirectoriesMutex);
+        ++m_numUnmodifiedDirectories;
+    }
+
+    int numUnmodifiedDirectories() const {
+        return m_numUnmodifiedDirectories;
+    }
+
     inline bool directoryBlacklisted(const QString& directoryPath) const {
         return m_directoriesBlacklist.contains(directoryPath);
     }
@@ -174,10 +234,21 @@ class ScannerGlobal {
 
 
   private:
+    // FAT and some network file systems store seconds or even two
+    // seconds
+    static const qint64 kModificationTimeGranularity = 2000;
+
     TaskWatcher m_watcher;
 
     QSet<QString> m_trackLocations;
     QHash<QString, int> m_directoryHashes;
+    QHash<QString, qint64> m_directoryModificationTimes;
+    QHash<QString, QStringList> m_subdirectories;
+
+    // The modification times of the directories that have been listed by
+    // this scan
+    mutable QMutex m_listedDirectoriesMutex;
+    QHash<QString, qint64> m_listedDirectories;
 
     mutable QMutex m_supportedExtensionsMatcherMutex;
     QRegExp m_supportedExtensionsMatcher;
@@ -214,9 +285,13 @@ class ScannerGlobal {
     volatile bool m_scanFinishedCleanly;
     volatile bool m_shouldCancel;
 
+    // Milliseconds since the epoch
+    const qint64 m_scanStartTime;
+
     // Stats tracking.
     PerformanceTimer m_timer;
     int m_numScannedDirectories;
+    int m_numUnmodifiedDirectories;
 };
 
 typedef QSharedPointer<ScannerGlobal> ScannerGlobalPointer;
@@ -25,7 +25,9 @@ class ScannerTask : public QObject, public QRunnable {
                                    bool newDirectory, int hash);
     void directoryUnchanged(const QString& directoryPath);
     void trackExists(const QString& filePath);
-    void addNewTrack(const QString& filePath);
+    // Tracks whose metadata has been parsed from file, to be added to
+    // the library on the scanner thread.
+    void addNewTracks(const QList<TrackPointer>& tracks);
 
     // Feedback to GUI
     void progressLoading(const QString& fileName);
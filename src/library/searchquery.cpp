@@ -1,12 +1,32 @@
 #include <QtDebug>
 
+#include <cmath>
+
 #include "library/searchquery.h"
 
 #include "library/queryutil.h"
+#include "library/trackcolumnindex.h"
 #include "track/keyutils.h"
 #include "library/dao/trackschema.h"
+#include "library/dao/tracksearchindex.h"
+#include "util/db/dbconnection.h"
 #include "util/db/sqllikewildcards.h"
 
+namespace {
+
+// Returns the matches of the node for the rows. Nodes without SQL are
+// left out of the query and match everything.
+bool matchNodeRows(const QueryNode& node, const TrackColumnIndex& index,
+        const QVector<int>& rows, RowMatches* pMatches) {
+    if (node.toSql().isEmpty()) {
+        pMatches->fill(true);
+        return true;
+    }
+    return node.matchRows(index, rows, pMatches);
+}
+
+}  // anonymous namespace
+
 QVariant getTrackValueForColumn(const TrackPointer& pTrack, const QString& column) {
     if (column == LIBRARYTABLE_ARTIST) {
         return pTrack->getArtist();
@@ -84,6 +104,24 @@ bool AndNode::match(const TrackPointer& pTrack) const {
     return true;
 }
 
+bool AndNode::matchRows(const TrackColumnIndex& index,
+        const QVector<int>& rows, RowMatches* pMatches) const {
+    pMatches->fill(true);
+    for (const auto& pNode: m_nodes) {
+        RowMatches nodeMatches(rows.size());
+        if (!matchNodeRows(*pNode, index, rows, &nodeMatches)) {
+            return false;
+        }
+        // Unknown AND true is unknown, anything AND false is false
+        const QBitArray notFalse =
+                (pMatches->matching | pMatches->unknown) &
+                (nodeMatches.matching | nodeMatches.unknown);
+        pMatches->matching &= nodeMatches.matching;
+        pMatches->unknown = notFalse & ~pMatches->matching;
+    }
+    return true;
+}
+
 QString AndNode::toSql() const {
     QStringList queryFragments;
     queryFragments.reserve(m_nodes.size());
@@ -113,6 +151,31 @@ bool OrNode::match(const TrackPointer& pTrack) const {
     return false;
 }
 
+bool OrNode::matchRows(const TrackColumnIndex& index,
+        const QVector<int>& rows, RowMatches* pMatches) const {
+    // Nodes without SQL are left out of the query, see toSql()
+    bool empty = true;
+    pMatches->fill(false);
+    for (const auto& pNode: m_nodes) {
+        if (pNode->toSql().isEmpty()) {
+            continue;
+        }
+        empty = false;
+        RowMatches nodeMatches(rows.size());
+        if (!pNode->matchRows(index, rows, &nodeMatches)) {
+            return false;
+        }
+        // Unknown OR false is unknown, anything OR true is true
+        pMatches->matching |= nodeMatches.matching;
+        pMatches->unknown = (pMatches->unknown | nodeMatches.unknown) &
+                ~pMatches->matching;
+    }
+    if (empty) {
+        pMatches->fill(true);
+    }
+    return true;
+}
+
 QString OrNode::toSql() const {
     QStringList queryFragments;
     queryFragments.reserve(m_nodes.size());
@@ -129,6 +192,23 @@ bool NotNode::match(const TrackPointer& pTrack) const {
     return !m_pNode->match(pTrack);
 }
 
+bool NotNode::matchRows(const TrackColumnIndex& index,
+        const QVector<int>& rows, RowMatches* pMatches) const {
+    if (m_pNode->toSql().isEmpty()) {
+        // NOT of nothing is nothing, see toSql()
+        pMatches->fill(true);
+        return true;
+    }
+    RowMatches nodeMatches(rows.size());
+    if (!m_pNode->matchRows(index, rows, &nodeMatches)) {
+        return false;
+    }
+    // NOT unknown is unknown
+    pMatches->matching = ~(nodeMatches.matching | nodeMatches.unknown);
+    pMatches->unknown = nodeMatches.unknown;
+    return true;
+}
+
 QString NotNode::toSql() const {
     QString sql(m_pNode->toSql());
     if (sql.isEmpty()) {
@@ -155,7 +235,71 @@ bool TextFilterNode::match(const TrackPointer& pTrack) const {
     return false;
 }
 
+bool TextFilterNode::matchRows(const TrackColumnIndex& index,
+        const QVector<int>& rows, RowMatches* pMatches) const {
+    // Leave LIKE wildcards in the argument to the database
+    if (m_argument.contains(kSqlLikeMatchAll) ||
+            m_argument.contains(kSqlLikeMatchOne)) {
+        return false;
+    }
+    const QString argument = mixxx::DbConnection::latinLow(m_argument);
+
+    // Strings repeat within and across columns, e.g. artist and album
+    // artist. Each one is only searched once.
+    enum StringMatch : char {
+        kUnknown,
+        kMatch,
+        kNoMatch,
+    };
+    QVector<char> stringMatches(index.stringCount(), kUnknown);
+
+    pMatches->fill(false);
+    for (const auto& sqlColumn: m_sqlColumns) {
+        const int column = index.columnIndex(sqlColumn);
+        if (column < 0) {
+            return false;
+        }
+        switch (index.columnType(column)) {
+        case TrackColumnIndex::ColumnType::Null:
+            pMatches->unknown.fill(true);
+            break;
+        case TrackColumnIndex::ColumnType::String: {
+            const QVector<int>& stringIds = index.stringIds(column);
+            for (int i = 0; i < rows.size(); ++i) {
+                const int stringId = stringIds[rows[i]];
+                if (stringId < 0) {
+                    pMatches->unknown.setBit(i);
+                    continue;
+                }
+                char& stringMatch = stringMatches[stringId];
+                if (stringMatch == kUnknown) {
+                    stringMatch = index.foldedString(stringId).contains(argument)
+                            ? kMatch : kNoMatch;
+                }
+                if (stringMatch == kMatch) {
+                    pMatches->matching.setBit(i);
+                }
+            }
+            break;
+        }
+        default:
+            // Numbers are matched as text by the database
+            return false;
+        }
+    }
+    pMatches->unknown &= ~pMatches->matching;
+    return true;
+}
+
 QString TextFilterNode::toSql() const {
+    if (!m_searchIndexIdColumn.isEmpty()) {
+        QString matchSql = TrackSearchIndex::matchSql(
+                m_database, m_searchIndexIdColumn, m_sqlColumns, m_argument);
+        if (!matchSql.isNull()) {
+            return matchSql;
+        }
+    }
+
     FieldEscaper escaper(m_database);
     QString escapedArgument = escaper.escapeString(kSqlLikeMatchAll + m_argument + kSqlLikeMatchAll);
 
@@ -173,7 +317,7 @@ CrateFilterNode::CrateFilterNode(const CrateStorage* pCrateStorage,
       m_matchInitialized(false) {
 }
 
-bool CrateFilterNode::match(const TrackPointer& pTrack) const {
+void CrateFilterNode::initMatchingTrackIds() const {
     if (!m_matchInitialized) {
         CrateTrackSelectResult crateTracks(
              m_pCrateStorage->selectTracksSortedByCrateNameLike(m_crateNameLike));
@@ -184,10 +328,26 @@ bool CrateFilterNode::match(const TrackPointer& pTrack) const {
 
         m_matchInitialized = true;
     }
+}
 
+bool CrateFilterNode::match(const TrackPointer& pTrack) const {
+    initMatchingTrackIds();
     return std::binary_search(m_matchingTrackIds.begin(), m_matchingTrackIds.end(), pTrack->getId());
 }
 
+bool CrateFilterNode::matchRows(const TrackColumnIndex& index,
+        const QVector<int>& rows, RowMatches* pMatches) const {
+    initMatchingTrackIds();
+    pMatches->fill(false);
+    for (int i = 0; i < rows.size(); ++i) {
+        if (std::binary_search(m_matchingTrackIds.begin(),
+                m_matchingTrackIds.end(), index.trackId(rows[i]))) {
+            pMatches->matching.setBit(i);
+        }
+    }
+    return true;
+}
+
 QString CrateFilterNode::toSql() const {
     return QString("id IN (%1)").arg(CrateStorage::formatQueryForTrackIdsByCrateNameLike(m_crateNameLike));
 }
@@ -263,6 +423,48 @@ bool NumericFilterNode::match(const TrackPointer& pTrack) const {
     return false;
 }
 
+bool NumericFilterNode::matchRows(const TrackColumnIndex& index,
+        const QVector<int>& rows, RowMatches* pMatches) const {
+    pMatches->fill(false);
+    for (const auto& sqlColumn: m_sqlColumns) {
+        const int column = index.columnIndex(sqlColumn);
+        if (column < 0) {
+            return false;
+        }
+        if (index.columnType(column) == TrackColumnIndex::ColumnType::Null) {
+            pMatches->unknown.fill(true);
+            continue;
+        }
+        if (index.columnType(column) != TrackColumnIndex::ColumnType::Number) {
+            // The database compares text with numbers as text
+            return false;
+        }
+        const QVector<double>& numbers = index.numbers(column);
+        for (int i = 0; i < rows.size(); ++i) {
+            const double dValue = numbers[rows[i]];
+            if (std::isnan(dValue)) {
+                pMatches->unknown.setBit(i);
+                continue;
+            }
+            bool matching = false;
+            if (m_bOperatorQuery) {
+                matching = (m_operator == "=" && dValue == m_dOperatorArgument) ||
+                        (m_operator == "<" && dValue < m_dOperatorArgument) ||
+                        (m_operator == ">" && dValue > m_dOperatorArgument) ||
+                        (m_operator == "<=" && dValue <= m_dOperatorArgument) ||
+                        (m_operator == ">=" && dValue >= m_dOperatorArgument);
+            } else if (m_bRangeQuery) {
+                matching = dValue >= m_dRangeLow && dValue <= m_dRangeHigh;
+            }
+            if (matching) {
+                pMatches->matching.setBit(i);
+            }
+        }
+    }
+    pMatches->unknown &= ~pMatches->matching;
+    return true;
+}
+
 QString NumericFilterNode::toSql() const {
     if (m_bOperatorQuery) {
         QStringList searchClauses;
@@ -340,6 +542,34 @@ bool KeyFilterNode::match(const TrackPointer& pTrack) const {
     return m_matchKeys.contains(pTrack->getKey());
 }
 
+bool KeyFilterNode::matchRows(const TrackColumnIndex& index,
+        const QVector<int>& rows, RowMatches* pMatches) const {
+    const int column = index.columnIndex("key_id");
+    if (column < 0) {
+        return false;
+    }
+    pMatches->fill(false);
+    switch (index.columnType(column)) {
+    case TrackColumnIndex::ColumnType::Null:
+        return true;
+    case TrackColumnIndex::ColumnType::Number: {
+        const QVector<double>& numbers = index.numbers(column);
+        for (int i = 0; i < rows.size(); ++i) {
+            // IS is never unknown
+            const double key = numbers[rows[i]];
+            if (!std::isnan(key) && m_matchKeys.contains(
+                    static_cast<mixxx::track::io::key::ChromaticKey>(
+                            static_cast<int>(key)))) {
+                pMatches->matching.setBit(i);
+            }
+        }
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
 QString KeyFilterNode::toSql() const {
     QStringList searchClauses;
     for (const auto& matchKey: m_matchKeys) {
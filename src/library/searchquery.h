@@ -4,6 +4,7 @@
 #include <vector>
 #include <utility>
 
+#include <QBitArray>
 #include <QList>
 #include <QSqlDatabase>
 #include <QRegExp>
@@ -16,8 +17,30 @@
 #include "util/memory.h"
 #include "library/crate/cratestorage.h"
 
+class TrackColumnIndex;
+
 QVariant getTrackValueForColumn(const TrackPointer& pTrack, const QString& column);
 
+// The result of matching rows of a TrackColumnIndex in the three-valued
+// logic of SQL: a row matches, doesn't match or is unknown, because a
+// value that it was compared with is NULL. Neither matching nor unknown
+// rows are selected by a WHERE clause, but NOT turns the first into the
+// latter.
+struct RowMatches {
+    explicit RowMatches(int size)
+            : matching(size),
+              unknown(size) {
+    }
+
+    void fill(bool isMatching) {
+        matching.fill(isMatching);
+        unknown.fill(false);
+    }
+
+    QBitArray matching;
+    QBitArray unknown;
+};
+
 class QueryNode {
   public:
     QueryNode(const QueryNode&) = delete; // prevent copying
@@ -26,6 +49,17 @@ class QueryNode {
     virtual bool match(const TrackPointer& pTrack) const = 0;
     virtual QString toSql() const = 0;
 
+    // Matches the rows of the index all at once, consistent with the
+    // result of toSql(). Returns false if the node can only be evaluated
+    // by the database.
+    virtual bool matchRows(const TrackColumnIndex& index,
+            const QVector<int>& rows, RowMatches* pMatches) const {
+        Q_UNUSED(index);
+        Q_UNUSED(rows);
+        Q_UNUSED(pMatches);
+        return false;
+    }
+
   protected:
     QueryNode() {}
 
@@ -50,12 +84,16 @@ class OrNode : public GroupNode {
   public:
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
+    bool matchRows(const TrackColumnIndex& index,
+            const QVector<int>& rows, RowMatches* pMatches) const override;
 };
 
 class AndNode : public GroupNode {
   public:
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
+    bool matchRows(const TrackColumnIndex& index,
+            const QVector<int>& rows, RowMatches* pMatches) const override;
 };
 
 class NotNode : public QueryNode {
@@ -67,6 +105,8 @@ class NotNode : public QueryNode {
 
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
+    bool matchRows(const TrackColumnIndex& index,
+            const QVector<int>& rows, RowMatches* pMatches) const override;
 
   private:
     std::unique_ptr<QueryNode> m_pNode;
@@ -74,21 +114,28 @@ class NotNode : public QueryNode {
 
 class TextFilterNode : public QueryNode {
   public:
+    // Looks up the argument in the TrackSearchIndex if searchIndexIdColumn
+    // is not empty, the column that holds the track ids of the table.
     TextFilterNode(const QSqlDatabase& database,
                    const QStringList& sqlColumns,
-                   const QString& argument)
+                   const QString& argument,
+                   const QString& searchIndexIdColumn = QString())
             : m_database(database),
               m_sqlColumns(sqlColumns),
-              m_argument(argument) {
+              m_argument(argument),
+              m_searchIndexIdColumn(searchIndexIdColumn) {
     }
 
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
+    bool matchRows(const TrackColumnIndex& index,
+            const QVector<int>& rows, RowMatches* pMatches) const override;
 
   private:
     QSqlDatabase m_database;
     QStringList m_sqlColumns;
     QString m_argument;
+    QString m_searchIndexIdColumn;
 };
 
 class CrateFilterNode : public QueryNode {
@@ -98,8 +145,12 @@ class CrateFilterNode : public QueryNode {
 
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
+    bool matchRows(const TrackColumnIndex& index,
+            const QVector<int>& rows, RowMatches* pMatches) const override;
 
   private:
+    void initMatchingTrackIds() const;
+
     const CrateStorage* m_pCrateStorage;
     QString m_crateNameLike;
     mutable bool m_matchInitialized;
@@ -112,6 +163,8 @@ class NumericFilterNode : public QueryNode {
 
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
+    bool matchRows(const TrackColumnIndex& index,
+            const QVector<int>& rows, RowMatches* pMatches) const override;
 
   protected:
     // Single argument constructor for that does not call init()
@@ -149,6 +202,8 @@ class KeyFilterNode : public QueryNode {
 
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
+    bool matchRows(const TrackColumnIndex& index,
+            const QVector<int>& rows, RowMatches* pMatches) const override;
 
   private:
     QList<mixxx::track::io::key::ChromaticKey> m_matchKeys;
@@ -1,5 +1,6 @@
 #include "library/searchqueryparser.h"
 
+#include "library/dao/tracksearchindex.h"
 #include "track/keyutils.h"
 
 const char* kNegatePrefix = "-";
@@ -63,6 +64,12 @@ SearchQueryParser::SearchQueryParser(TrackCollection* pTrackCollection)
 SearchQueryParser::~SearchQueryParser() {
 }
 
+void SearchQueryParser::enableTrackSearchIndex(const QString& idColumn) {
+    if (TrackSearchIndex::isAvailable(m_pTrackCollection->database())) {
+        m_searchIndexIdColumn = idColumn;
+    }
+}
+
 QString SearchQueryParser::getTextArgument(QString argument,
                                            QStringList* tokens) const {
     // If the argument is empty, assume the user placed a space after an
@@ -131,7 +138,8 @@ void SearchQueryParser::parseTokens(QStringList tokens,
                           &m_pTrackCollection->crates(), argument);
                 } else {
                     pNode = std::make_unique<TextFilterNode>(
-                          m_pTrackCollection->database(), m_fieldToSqlColumns[field], argument);
+                          m_pTrackCollection->database(), m_fieldToSqlColumns[field], argument,
+                          m_searchIndexIdColumn);
                 }
             }
         } else if (m_numericFilterMatcher.indexIn(token) != -1) {
@@ -154,7 +162,8 @@ void SearchQueryParser::parseTokens(QStringList tokens,
                             KeyUtils::guessKeyFromText(argument);
                     if (key == mixxx::track::io::key::INVALID) {
                         pNode = std::make_unique<TextFilterNode>(
-                                m_pTrackCollection->database(), m_fieldToSqlColumns[field], argument);
+                                m_pTrackCollection->database(), m_fieldToSqlColumns[field], argument,
+                                m_searchIndexIdColumn);
                     } else {
                         pNode = std::make_unique<KeyFilterNode>(key, fuzzy);
                     }
@@ -167,7 +176,8 @@ void SearchQueryParser::parseTokens(QStringList tokens,
                            field == "dateadded") {
                     field = "datetime_added";
                     pNode = std::make_unique<TextFilterNode>(
-                        m_pTrackCollection->database(), m_fieldToSqlColumns[field], argument);
+                        m_pTrackCollection->database(), m_fieldToSqlColumns[field], argument,
+                        m_searchIndexIdColumn);
                 }
             }
         } else {
@@ -178,7 +188,8 @@ void SearchQueryParser::parseTokens(QStringList tokens,
             // Don't trigger on a lone minus sign.
             if (!token.isEmpty()) {
                 pNode = std::make_unique<TextFilterNode>(
-                                m_pTrackCollection->database(), searchColumns, token);
+                                m_pTrackCollection->database(), searchColumns, token,
+                                m_searchIndexIdColumn);
             }
         }
         if (pNode) {
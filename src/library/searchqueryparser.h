@@ -16,6 +16,11 @@ class SearchQueryParser {
 
     virtual ~SearchQueryParser();
 
+    // Text filters look up their arguments in the TrackSearchIndex if it is
+    // available. Only for queries of tables with the library's track ids in
+    // idColumn.
+    void enableTrackSearchIndex(const QString& idColumn);
+
     std::unique_ptr<QueryNode> parseQuery(
             const QString& query,
             const QStringList& searchColumns,
@@ -36,6 +41,7 @@ class SearchQueryParser {
     QStringList m_specialFilters;
     QStringList m_allFilters;
     QHash<QString, QStringList> m_fieldToSqlColumns;
+    QString m_searchIndexIdColumn;
 
     QRegExp m_fuzzyMatcher;
     QRegExp m_textFilterMatcher;
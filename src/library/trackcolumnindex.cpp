@@ -0,0 +1,478 @@
+#include "library/trackcolumnindex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "util/assert.h"
+#include "util/db/dbconnection.h"
+
+namespace {
+
+const double kNullNumber = std::numeric_limits<double>::quiet_NaN();
+const int kNullStringId = -1;
+
+// The integer that SQLite casts a text to: optional whitespace and sign
+// followed by digits, 0 if there are none.
+qint64 leadingInteger(const QString& text) {
+    const int length = text.length();
+    int i = 0;
+    while (i < length && text[i].isSpace()) {
+        ++i;
+    }
+    bool negative = false;
+    if (i < length && (text[i] == '-' || text[i] == '+')) {
+        negative = text[i] == '-';
+        ++i;
+    }
+    qint64 value = 0;
+    while (i < length && text[i].unicode() >= '0' && text[i].unicode() <= '9') {
+        value = value * 10 + (text[i].unicode() - '0');
+        ++i;
+    }
+    return negative ? -value : value;
+}
+
+bool isNullVariant(const QVariant& value) {
+    return !value.isValid() || value.isNull();
+}
+
+}  // anonymous namespace
+
+TrackColumnIndex::Column::Column()
+        : type(ColumnType::Null),
+          numberType(NumberType::Bool),
+          sortMode(SortMode::Lexicographic),
+          sortRanksValid(false) {
+}
+
+TrackColumnIndex::TrackColumnIndex(const QStringList& columns)
+        : m_columns(columns.size()),
+          m_keyNotation(KeyUtils::CUSTOM) {
+    for (int i = 0; i < columns.size(); ++i) {
+        m_columnIndexByName[columns[i]] = i;
+    }
+}
+
+void TrackColumnIndex::clear() {
+    for (auto& column: m_columns) {
+        column.type = ColumnType::Null;
+        column.numbers.clear();
+        column.stringIds.clear();
+        column.variants.clear();
+        column.sortRanks.clear();
+        column.sortRanksValid = false;
+    }
+    m_trackIds.clear();
+    m_rowByTrackId.clear();
+    m_freeRows.clear();
+    m_strings.clear();
+    m_foldedStrings.clear();
+    m_stringIds.clear();
+    m_stringRefCounts.clear();
+    m_freeStringIds.clear();
+}
+
+int TrackColumnIndex::insertRow(TrackId trackId) {
+    QHash<TrackId, int>::const_iterator it = m_rowByTrackId.constFind(trackId);
+    if (it != m_rowByTrackId.constEnd()) {
+        return it.value();
+    }
+
+    int row;
+    if (!m_freeRows.isEmpty()) {
+        // The values of free rows are NULL already
+        row = m_freeRows.last();
+        m_freeRows.removeLast();
+        m_trackIds[row] = trackId;
+    } else {
+        row = m_trackIds.size();
+        m_trackIds.append(trackId);
+        for (auto& column: m_columns) {
+            switch (column.type) {
+            case ColumnType::Null:
+                break;
+            case ColumnType::Number:
+                column.numbers.append(kNullNumber);
+                break;
+            case ColumnType::String:
+                column.stringIds.append(kNullStringId);
+                break;
+            case ColumnType::Variant:
+                column.variants.append(QVariant());
+                break;
+            }
+        }
+    }
+    m_rowByTrackId.insert(trackId, row);
+    return row;
+}
+
+void TrackColumnIndex::removeRow(TrackId trackId) {
+    const int row = m_rowByTrackId.value(trackId, -1);
+    if (row < 0) {
+        return;
+    }
+    for (int column = 0; column < m_columns.size(); ++column) {
+        setValue(row, column, QVariant());
+    }
+    m_trackIds[row] = TrackId();
+    m_rowByTrackId.remove(trackId);
+    m_freeRows.append(row);
+}
+
+QVariant TrackColumnIndex::value(int row, int column) const {
+    const Column& col = m_columns[column];
+    switch (col.type) {
+    case ColumnType::Null:
+        return QVariant();
+    case ColumnType::Number: {
+        const double number = col.numbers[row];
+        if (std::isnan(number)) {
+            return QVariant();
+        }
+        switch (col.numberType) {
+        case NumberType::Bool:
+            return QVariant(number != 0.0);
+        case NumberType::Integer:
+            return QVariant(static_cast<qlonglong>(number));
+        case NumberType::Real:
+            return QVariant(number);
+        }
+        return QVariant();
+    }
+    case ColumnType::String: {
+        const int stringId = col.stringIds[row];
+        if (stringId == kNullStringId) {
+            return QVariant();
+        }
+        return QVariant(m_strings[stringId]);
+    }
+    case ColumnType::Variant:
+        return col.variants[row];
+    }
+    return QVariant();
+}
+
+void TrackColumnIndex::setValue(int row, int column, const QVariant& value) {
+    DEBUG_ASSERT(row >= 0 && row < rowCount());
+    Column& col = m_columns[column];
+
+    if (isNullVariant(value)) {
+        switch (col.type) {
+        case ColumnType::Null:
+            break;
+        case ColumnType::Number:
+            if (!std::isnan(col.numbers[row])) {
+                col.numbers[row] = kNullNumber;
+                col.sortRanksValid = false;
+            }
+            break;
+        case ColumnType::String:
+            if (col.stringIds[row] != kNullStringId) {
+                releaseString(col.stringIds[row]);
+                col.stringIds[row] = kNullStringId;
+                col.sortRanksValid = false;
+            }
+            break;
+        case ColumnType::Variant:
+            if (col.variants[row].isValid()) {
+                col.variants[row] = QVariant();
+                col.sortRanksValid = false;
+            }
+            break;
+        }
+        return;
+    }
+
+    NumberType numberType;
+    if (numberTypeOf(value, &numberType)) {
+        if (col.type == ColumnType::Null) {
+            col.type = ColumnType::Number;
+            col.numberType = numberType;
+            col.numbers.fill(kNullNumber, rowCount());
+        }
+        if (col.type == ColumnType::Number) {
+            if (col.numberType != numberType) {
+                // SQL returns integers for booleans, Track does not
+                col.numberType = (col.numberType == NumberType::Real ||
+                                  numberType == NumberType::Real)
+                        ? NumberType::Real : NumberType::Integer;
+            }
+            const double number = value.toDouble();
+            if (col.numbers[row] != number) {
+                col.numbers[row] = number;
+                col.sortRanksValid = false;
+            }
+            return;
+        }
+    } else if (isText(value)) {
+        if (col.type == ColumnType::Null) {
+            col.type = ColumnType::String;
+            col.stringIds.fill(kNullStringId, rowCount());
+        }
+        if (col.type == ColumnType::String) {
+            // Dates are stored as the text that the database returns for
+            // them, which also sorts them in order.
+            const int stringId = internString(value.toString());
+            if (col.stringIds[row] != stringId) {
+                if (col.stringIds[row] != kNullStringId) {
+                    releaseString(col.stringIds[row]);
+                }
+                col.stringIds[row] = stringId;
+                col.sortRanksValid = false;
+            } else {
+                // Interned again for the same cell
+                releaseString(stringId);
+            }
+            return;
+        }
+    }
+
+    // The type of the value doesn't match the column
+    convertToVariants(&col, column);
+    col.variants[row] = value;
+    col.sortRanksValid = false;
+}
+
+//static
+bool TrackColumnIndex::numberTypeOf(const QVariant& value, NumberType* pType) {
+    switch (value.userType()) {
+    case QMetaType::Bool:
+        *pType = NumberType::Bool;
+        return true;
+    case QMetaType::Char:
+    case QMetaType::UChar:
+    case QMetaType::Short:
+    case QMetaType::UShort:
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::Long:
+    case QMetaType::ULong:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+        *pType = NumberType::Integer;
+        return true;
+    case QMetaType::Float:
+    case QMetaType::Double:
+        *pType = NumberType::Real;
+        return true;
+    default:
+        return false;
+    }
+}
+
+//static
+bool TrackColumnIndex::isText(const QVariant& value) {
+    switch (value.userType()) {
+    case QMetaType::QString:
+    case QMetaType::QDate:
+    case QMetaType::QTime:
+    case QMetaType::QDateTime:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void TrackColumnIndex::convertToVariants(Column* pColumn, int column) {
+    if (pColumn->type == ColumnType::Variant) {
+        return;
+    }
+    QVector<QVariant> variants(rowCount());
+    for (int row = 0; row < rowCount(); ++row) {
+        variants[row] = value(row, column);
+    }
+    for (int stringId: pColumn->stringIds) {
+        if (stringId != kNullStringId) {
+            releaseString(stringId);
+        }
+    }
+    pColumn->type = ColumnType::Variant;
+    pColumn->numbers.clear();
+    pColumn->stringIds.clear();
+    pColumn->variants = variants;
+    pColumn->sortRanksValid = false;
+}
+
+int TrackColumnIndex::internString(const QString& string) {
+    QHash<QString, int>::const_iterator it = m_stringIds.constFind(string);
+    if (it != m_stringIds.constEnd()) {
+        ++m_stringRefCounts[it.value()];
+        return it.value();
+    }
+    int stringId;
+    if (!m_freeStringIds.isEmpty()) {
+        stringId = m_freeStringIds.last();
+        m_freeStringIds.removeLast();
+        m_strings[stringId] = string;
+        m_foldedStrings[stringId] = mixxx::DbConnection::latinLow(string);
+        m_stringRefCounts[stringId] = 1;
+    } else {
+        stringId = m_strings.size();
+        m_strings.append(string);
+        m_foldedStrings.append(mixxx::DbConnection::latinLow(string));
+        m_stringRefCounts.append(1);
+    }
+    m_stringIds.insert(string, stringId);
+    return stringId;
+}
+
+void TrackColumnIndex::releaseString(int stringId) {
+    DEBUG_ASSERT(m_stringRefCounts[stringId] > 0);
+    if (--m_stringRefCounts[stringId] > 0) {
+        return;
+    }
+    m_stringIds.remove(m_strings[stringId]);
+    m_strings[stringId] = QString();
+    m_foldedStrings[stringId] = QString();
+    m_freeStringIds.append(stringId);
+}
+
+void TrackColumnIndex::setSortMode(int column, SortMode sortMode) {
+    Column& col = m_columns[column];
+    if (col.sortMode != sortMode) {
+        col.sortMode = sortMode;
+        col.sortRanksValid = false;
+    }
+}
+
+void TrackColumnIndex::setKeyNotation(KeyUtils::KeyNotation keyNotation) {
+    if (m_keyNotation == keyNotation) {
+        return;
+    }
+    m_keyNotation = keyNotation;
+    for (auto& column: m_columns) {
+        if (column.sortMode == SortMode::Key) {
+            column.sortRanksValid = false;
+        }
+    }
+}
+
+const QVector<int>& TrackColumnIndex::sortRanks(int column) const {
+    const Column& col = m_columns[column];
+    if (!col.sortRanksValid || col.sortRanks.size() != rowCount()) {
+        computeSortRanks(col);
+        col.sortRanksValid = true;
+    }
+    return col.sortRanks;
+}
+
+void TrackColumnIndex::computeSortRanks(const Column& column) const {
+    column.sortRanks.fill(0, rowCount());
+
+    switch (column.type) {
+    case ColumnType::Null:
+        return;
+    case ColumnType::Number: {
+        const QVector<double>& numbers = column.numbers;
+        QVector<int> rows;
+        rows.reserve(rowCount());
+        for (int row = 0; row < rowCount(); ++row) {
+            if (!std::isnan(numbers[row])) {
+                rows.append(row);
+            }
+        }
+        std::sort(rows.begin(), rows.end(), [&numbers](int a, int b) {
+            return numbers[a] < numbers[b];
+        });
+        int rank = 0;
+        for (int i = 0; i < rows.size(); ++i) {
+            if (i == 0 || numbers[rows[i]] != numbers[rows[i - 1]]) {
+                ++rank;
+            }
+            column.sortRanks[rows[i]] = rank;
+        }
+        return;
+    }
+    case ColumnType::String:
+        computeStringSortRanks(column);
+        return;
+    case ColumnType::Variant: {
+        const QVector<QVariant>& variants = column.variants;
+        QVector<int> rows;
+        QVector<QString> strings(rowCount());
+        for (int row = 0; row < rowCount(); ++row) {
+            if (!isNullVariant(variants[row])) {
+                rows.append(row);
+                strings[row] = variants[row].toString();
+            }
+        }
+        std::sort(rows.begin(), rows.end(), [&strings](int a, int b) {
+            return mixxx::DbConnection::compareLexicographically(
+                    strings[a], strings[b]) < 0;
+        });
+        int rank = 0;
+        for (int i = 0; i < rows.size(); ++i) {
+            if (i == 0 || mixxx::DbConnection::compareLexicographically(
+                    strings[rows[i]], strings[rows[i - 1]]) != 0) {
+                ++rank;
+            }
+            column.sortRanks[rows[i]] = rank;
+        }
+        return;
+    }
+    }
+}
+
+void TrackColumnIndex::computeStringSortRanks(const Column& column) const {
+    // Rank the distinct strings of the column instead of its rows. Artists,
+    // albums, genres and keys repeat a lot.
+    QVector<int> stringRanks(m_strings.size(), -1);
+    QVector<int> stringIds;
+    for (int stringId: column.stringIds) {
+        if (stringId != kNullStringId && stringRanks[stringId] < 0) {
+            stringRanks[stringId] = 0;
+            stringIds.append(stringId);
+        }
+    }
+
+    if (column.sortMode == SortMode::Lexicographic) {
+        // Same as DbConnection::compareLexicographically(), but every
+        // string is lowered only once.
+        QVector<QString> lowerStrings(m_strings.size());
+        for (int stringId: stringIds) {
+            lowerStrings[stringId] = m_strings[stringId].toLower();
+        }
+        std::sort(stringIds.begin(), stringIds.end(), [&lowerStrings](int a, int b) {
+            return QString::localeAwareCompare(lowerStrings[a], lowerStrings[b]) < 0;
+        });
+        int rank = 0;
+        for (int i = 0; i < stringIds.size(); ++i) {
+            if (i == 0 || QString::localeAwareCompare(
+                    lowerStrings[stringIds[i]],
+                    lowerStrings[stringIds[i - 1]]) != 0) {
+                ++rank;
+            }
+            stringRanks[stringIds[i]] = rank;
+        }
+    } else {
+        QVector<qint64> keys(m_strings.size());
+        for (int stringId: stringIds) {
+            if (column.sortMode == SortMode::Integer) {
+                keys[stringId] = leadingInteger(m_strings[stringId]);
+            } else {
+                keys[stringId] = KeyUtils::keyToCircleOfFifthsOrder(
+                        KeyUtils::guessKeyFromText(m_strings[stringId]),
+                        m_keyNotation);
+            }
+        }
+        std::sort(stringIds.begin(), stringIds.end(), [&keys](int a, int b) {
+            return keys[a] < keys[b];
+        });
+        int rank = 0;
+        for (int i = 0; i < stringIds.size(); ++i) {
+            if (i == 0 || keys[stringIds[i]] != keys[stringIds[i - 1]]) {
+                ++rank;
+            }
+            stringRanks[stringIds[i]] = rank;
+        }
+    }
+
+    for (int row = 0; row < rowCount(); ++row) {
+        const int stringId = column.stringIds[row];
+        if (stringId != kNullStringId) {
+            column.sortRanks[row] = stringRanks[stringId];
+        }
+    }
+}
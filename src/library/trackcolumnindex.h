@@ -0,0 +1,152 @@
+#ifndef TRACKCOLUMNINDEX_H
+#define TRACKCOLUMNINDEX_H
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QVector>
+
+#include "track/keyutils.h"
+#include "track/trackid.h"
+
+// Stores the values of a track table column by column. Numbers are kept in
+// typed arrays and strings are interned together with the folded text that
+// the LIKE operator compares. Searching and sorting scan these arrays
+// instead of converting a QVariant per track and column.
+//
+// Rows of removed tracks are reused for new tracks, so rowCount() may
+// include rows without a track.
+class TrackColumnIndex {
+  public:
+    enum class ColumnType {
+        // Only NULL values so far
+        Null,
+        // numbers(), NaN for NULL
+        Number,
+        // stringIds(), -1 for NULL
+        String,
+        // Mixed or other types, only available through value()
+        Variant,
+    };
+
+    enum class SortMode {
+        // Numbers by value, text like the lexicographical collation
+        Lexicographic,
+        // Text by its leading integer, like "cast(text as integer)"
+        Integer,
+        // Key text in circle of fifths order
+        Key,
+    };
+
+    explicit TrackColumnIndex(const QStringList& columns);
+
+    void clear();
+
+    int columnCount() const {
+        return m_columns.size();
+    }
+    int columnIndex(const QString& name) const {
+        return m_columnIndexByName.value(name, -1);
+    }
+
+    int rowCount() const {
+        return m_trackIds.size();
+    }
+    int row(TrackId trackId) const {
+        return m_rowByTrackId.value(trackId, -1);
+    }
+    TrackId trackId(int row) const {
+        return m_trackIds[row];
+    }
+    bool contains(TrackId trackId) const {
+        return m_rowByTrackId.contains(trackId);
+    }
+
+    // Returns the row of the track, which is added if it is missing.
+    int insertRow(TrackId trackId);
+    void removeRow(TrackId trackId);
+
+    QVariant value(int row, int column) const;
+    void setValue(int row, int column, const QVariant& value);
+
+    ColumnType columnType(int column) const {
+        return m_columns[column].type;
+    }
+    const QVector<double>& numbers(int column) const {
+        return m_columns[column].numbers;
+    }
+    const QVector<int>& stringIds(int column) const {
+        return m_columns[column].stringIds;
+    }
+    // The number of string IDs. Strings that are no longer referenced by
+    // any cell are released and their IDs reused, so some IDs may belong
+    // to empty strings that no cell refers to.
+    int stringCount() const {
+        return m_strings.size();
+    }
+    const QString& string(int stringId) const {
+        return m_strings[stringId];
+    }
+    const QString& foldedString(int stringId) const {
+        return m_foldedStrings[stringId];
+    }
+
+    void setSortMode(int column, SortMode sortMode);
+    void setKeyNotation(KeyUtils::KeyNotation keyNotation);
+
+    // Returns the rank of each row when sorting by the column in ascending
+    // order. Equal values share a rank and NULL sorts first, as in SQL. The
+    // ranks are computed once and kept until the column is modified.
+    const QVector<int>& sortRanks(int column) const;
+
+  private:
+    enum class NumberType {
+        Bool,
+        Integer,
+        Real,
+    };
+
+    struct Column {
+        Column();
+
+        ColumnType type;
+        NumberType numberType;
+        SortMode sortMode;
+        QVector<double> numbers;
+        QVector<int> stringIds;
+        QVector<QVariant> variants;
+
+        mutable QVector<int> sortRanks;
+        mutable bool sortRanksValid;
+    };
+
+    static bool numberTypeOf(const QVariant& value, NumberType* pType);
+    static bool isText(const QVariant& value);
+
+    // Returns the ID of the string with a new reference for a cell
+    int internString(const QString& string);
+    // Drops the reference of a cell
+    void releaseString(int stringId);
+    void convertToVariants(Column* pColumn, int column);
+    void computeSortRanks(const Column& column) const;
+    void computeStringSortRanks(const Column& column) const;
+
+    QVector<Column> m_columns;
+    QHash<QString, int> m_columnIndexByName;
+
+    QVector<TrackId> m_trackIds;
+    QHash<TrackId, int> m_rowByTrackId;
+    QVector<int> m_freeRows;
+
+    QVector<QString> m_strings;
+    QVector<QString> m_foldedStrings;
+    QHash<QString, int> m_stringIds;
+    // The number of cells that refer to each string
+    QVector<int> m_stringRefCounts;
+    QVector<int> m_freeStringIds;
+
+    KeyUtils::KeyNotation m_keyNotation;
+};
+
+#endif // TRACKCOLUMNINDEX_H
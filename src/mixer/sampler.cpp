@@ -10,6 +10,16 @@ Sampler::Sampler(QObject* pParent,
                  QString group) :
         BaseTrackPlayerImpl(pParent, pConfig, pMixingEngine, pEffectsManager,
                             defaultOrientation, group, true, false) {
+    // Samples are usually short and triggered at random positions, so they
+    // are preloaded completely unless the user has disabled it.
+    const ConfigKey preloadTrackKey(group, "preload_track");
+    ControlObject* pPreloadTrack = ControlObject::getControl(preloadTrackKey);
+    if (pPreloadTrack) {
+        pPreloadTrack->setDefaultValue(1.0);
+        if (!pConfig->exists(preloadTrackKey)) {
+            pPreloadTrack->set(1.0);
+        }
+    }
 }
 
 Sampler::~Sampler() {
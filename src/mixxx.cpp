@@ -123,8 +123,8 @@ MixxxMainWindow::MixxxMainWindow(QApplication* pApp, const CmdlineArgs& args)
 
     Version::logBuildDetails();
 
-    // Only record stats in developer mode.
-    if (m_cmdLineArgs.getDeveloper()) {
+    // Only record stats in developer mode or if they are exported.
+    if (m_cmdLineArgs.getDeveloper() || !m_cmdLineArgs.getStatsPath().isEmpty()) {
         StatsManager::create();
     }
 
@@ -43,6 +43,7 @@ void MixxxApplication::registerMetaTypes() {
     qRegisterMetaType<QList<CrateId>>("QList<CrateId>");
     qRegisterMetaType<QSet<CrateId>>("QSet<CrateId>");
     qRegisterMetaType<TrackPointer>("TrackPointer");
+    qRegisterMetaType<QList<TrackPointer>>("QList<TrackPointer>");
     qRegisterMetaType<mixxx::ReplayGain>("mixxx::ReplayGain");
     qRegisterMetaType<mixxx::Bpm>("mixxx::Bpm");
     qRegisterMetaType<mixxx::Duration>("mixxx::Duration");
@@ -93,14 +93,16 @@ QMutex LegacySkinParser::s_safeStringMutex;
 
 static bool sDebug = false;
 
-ControlObject* controlFromConfigKey(const ConfigKey& key, bool bPersist,
-                                    bool* created) {
+ControlObject* LegacySkinParser::controlFromConfigKey(const ConfigKey& key,
+                                                      bool bPersist,
+                                                      bool* created) {
     if (key.isEmpty()) {
         return nullptr;
     }
     // Don't warn if the control doesn't exist. Skins use this to create
     // controls.
-    ControlObject* pControl = ControlObject::getControl(key, false);
+    ControlObject* pControl = ControlObject::getControl(
+            m_controlResolver.resolve(key, false));
 
     if (pControl) {
         if (created) {
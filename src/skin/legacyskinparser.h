@@ -7,6 +7,7 @@
 #include <QDomElement>
 #include <QMutex>
 
+#include "control/controlhandleresolver.h"
 #include "preferences/usersettings.h"
 #include "skin/skinparser.h"
 #include "vinylcontrol/vinylcontrolmanager.h"
@@ -132,6 +133,8 @@ class LegacySkinParser : public QObject, public SkinParser {
     ControlObject* controlFromConfigNode(const QDomElement& element,
                                          const QString& nodeName,
                                          bool* created);
+    ControlObject* controlFromConfigKey(const ConfigKey& key, bool bPersist,
+                                        bool* created);
 
     QString parseLaunchImageStyle(const QDomNode& node);
     void parseChildren(const QDomElement& node, WWidgetGroup* pGroup);
@@ -146,6 +149,8 @@ class LegacySkinParser : public QObject, public SkinParser {
     RecordingManager* m_pRecordingManager;
     QWidget* m_pParent;
     std::unique_ptr<SkinContext> m_pContext;
+    // Skins refer to the same controls from many widgets
+    ControlHandleResolver m_controlResolver;
     Tooltips m_tooltips;
     QHash<QString, QDomElement> m_templateCache;
     static QList<const char*> s_channelStrs;
@@ -55,6 +55,10 @@ const int kFifoSize = 2 * kDriftReserve + 1;
 // callbacks can be always wrong due to a setup/open jitter
 const int m_invalidTimeInfoWarningCount = 3;
 
+// The jitter of the callback is what we are interested in
+const Stat::ComputeFlags kCallbackComputeFlags =
+        kDefaultComputeFlags | Stat::HISTOGRAM;
+
 int paV19Callback(const void *inputBuffer, void *outputBuffer,
                   unsigned long framesPerBuffer,
                   const PaStreamCallbackTimeInfo *timeInfo,
@@ -113,6 +117,15 @@ SoundDevicePortAudio::SoundDevicePortAudio(UserSettingsPointer config,
     m_strInternalName = QString("%1, %2").arg(QString::number(m_devId),
             deviceInfo->name);
     m_strDisplayName = QString::fromLocal8Bit(deviceInfo->name);
+    m_inputStatId = Stat::registerTag(
+            QString("SoundDevicePortAudio::callbackProcess input %1")
+                    .arg(m_strInternalName));
+    m_prepareStatId = Stat::registerTag(
+            QString("SoundDevicePortAudio::callbackProcess prepare %1")
+                    .arg(m_strInternalName));
+    m_outputStatId = Stat::registerTag(
+            QString("SoundDevicePortAudio::callbackProcess output %1")
+                    .arg(m_strInternalName));
     m_iNumInputChannels = m_deviceInfo->maxInputChannels;
     m_iNumOutputChannels = m_deviceInfo->maxOutputChannels;
 
@@ -932,8 +945,7 @@ int SoundDevicePortAudio::callbackProcessClkRef(
 
     // Send audio from the soundcard's input off to the SoundManager...
     if (in) {
-        ScopedTimer t("SoundDevicePortAudio::callbackProcess input %1",
-                getInternalName());
+        ScopedTimer t(m_inputStatId, kCallbackComputeFlags);
         composeInputBuffer(in, framesPerBuffer, 0,
                            m_inputParams.channelCount);
         m_pSoundManager->pushInputBuffers(m_audioInputs, m_framesPerBuffer);
@@ -942,14 +954,12 @@ int SoundDevicePortAudio::callbackProcessClkRef(
     m_pSoundManager->readProcess();
 
     {
-        ScopedTimer t("SoundDevicePortAudio::callbackProcess prepare %1",
-                getInternalName());
+        ScopedTimer t(m_prepareStatId, kCallbackComputeFlags);
         m_pSoundManager->onDeviceOutputCallback(framesPerBuffer);
     }
 
     if (out) {
-        ScopedTimer t("SoundDevicePortAudio::callbackProcess output %1",
-                getInternalName());
+        ScopedTimer t(m_outputStatId, kCallbackComputeFlags);
 
         if (m_outputParams.channelCount <= 0) {
             qWarning()
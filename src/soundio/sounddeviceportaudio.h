@@ -25,6 +25,7 @@
 
 #include "soundio/sounddevice.h"
 #include "util/duration.h"
+#include "util/stat.h"
 
 
 #define CPU_USAGE_UPDATE_RATE 30 // in 1/s, fits to display frame rate
@@ -109,6 +110,10 @@ class SoundDevicePortAudio : public SoundDevice {
     int m_invalidTimeInfoCount;
     PerformanceTimer m_clkRefTimer;
     PaTime m_lastCallbackEntrytoDacSecs;
+    // Registered up front, so the callback neither allocates nor locks
+    Stat::Id m_inputStatId;
+    Stat::Id m_prepareStatId;
+    Stat::Id m_outputStatId;
 
 };
 
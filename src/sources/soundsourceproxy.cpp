@@ -345,6 +345,11 @@ SoundSourceProxy::SoundSourceProxy(const Track* pTrack)
     initSoundSource();
 }
 
+QString SoundSourceProxy::getSoundSourceProviderName() const {
+    const mixxx::SoundSourceProviderPointer pProvider = getSoundSourceProvider();
+    return pProvider ? pProvider->getName() : QString();
+}
+
 mixxx::SoundSourceProviderPointer SoundSourceProxy::getSoundSourceProvider() const {
     DEBUG_ASSERT(0 <= m_soundSourceProviderRegistrationIndex);
     if (m_soundSourceProviderRegistrations.size() > m_soundSourceProviderRegistrationIndex) {
@@ -96,6 +96,9 @@ class SoundSourceProxy {
 
     void closeAudioSource();
 
+    // The name of the provider that is used for opening the audio source
+    QString getSoundSourceProviderName() const;
+
   private:
     static mixxx::SoundSourceProviderRegistry s_soundSourceProviders;
     static QStringList s_supportedFileNamePatterns;
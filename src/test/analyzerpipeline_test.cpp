@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include "analyzer/analyzer.h"
+#include "analyzer/analyzerpipeline.h"
+#include "util/sample.h"
+#include "util/sleepableqthread.h"
+
+namespace {
+
+const SINT kSamplesPerBlock = 64;
+
+// Records the first sample of every block it has processed
+class RecordingAnalyzer : public Analyzer {
+  public:
+    explicit RecordingAnalyzer(unsigned long sleepMicros)
+            : m_sleepMicros(sleepMicros) {
+    }
+
+    bool initialize(TrackPointer tio, int sampleRate, int totalSamples) override {
+        Q_UNUSED(tio);
+        Q_UNUSED(sampleRate);
+        Q_UNUSED(totalSamples);
+        return true;
+    }
+    bool isDisabledOrLoadStoredSuccess(TrackPointer tio) const override {
+        Q_UNUSED(tio);
+        return false;
+    }
+    void process(const CSAMPLE* pIn, const int iLen) override {
+        EXPECT_EQ(kSamplesPerBlock, iLen);
+        if (m_sleepMicros > 0) {
+            SleepableQThread::usleep(m_sleepMicros);
+        }
+        m_blocks.push_back(pIn[0]);
+    }
+    void cleanup(TrackPointer tio) override {
+        Q_UNUSED(tio);
+    }
+    void finalize(TrackPointer tio) override {
+        Q_UNUSED(tio);
+    }
+
+    const std::vector<CSAMPLE>& blocks() const {
+        return m_blocks;
+    }
+
+  private:
+    const unsigned long m_sleepMicros;
+    std::vector<CSAMPLE> m_blocks;
+};
+
+class AnalyzerPipelineTest : public testing::Test {
+  protected:
+    void feedBlocks(AnalyzerPipeline* pPipeline, int blockCount) {
+        for (int i = 0; i < blockCount; ++i) {
+            SampleBuffer* pBlock = pPipeline->writeBlock();
+            SampleUtil::fill(pBlock->data(), CSAMPLE(i), pBlock->size());
+            pPipeline->commitBlock();
+        }
+    }
+};
+
+TEST_F(AnalyzerPipelineTest, AllAnalyzersReceiveAllBlocksInOrder) {
+    RecordingAnalyzer fast(0);
+    RecordingAnalyzer slow(100);
+    const int kBlockCount = 100;
+    {
+        // Use a ring that is much smaller than the number of blocks
+        // to make sure that the producer waits for the slow analyzer.
+        AnalyzerPipeline pipeline({&fast, &slow}, kSamplesPerBlock, 4);
+        feedBlocks(&pipeline, kBlockCount);
+        pipeline.drain();
+    }
+    for (const RecordingAnalyzer* pAnalyzer: {&fast, &slow}) {
+        ASSERT_EQ(kBlockCount, static_cast<int>(pAnalyzer->blocks().size()));
+        for (int i = 0; i < kBlockCount; ++i) {
+            EXPECT_EQ(CSAMPLE(i), pAnalyzer->blocks()[i]);
+        }
+    }
+}
+
+TEST_F(AnalyzerPipelineTest, DrainWithoutBlocks) {
+    RecordingAnalyzer analyzer(0);
+    AnalyzerPipeline pipeline({&analyzer}, kSamplesPerBlock, 2);
+    pipeline.drain();
+    EXPECT_TRUE(analyzer.blocks().empty());
+}
+
+}  // namespace
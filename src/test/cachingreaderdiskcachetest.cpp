@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryFile>
+
+#include <algorithm>
+#include <vector>
+
+#include "engine/cachingreaderchunk.h"
+#include "engine/cachingreaderdiskcache.h"
+#include "test/mixxxtest.h"
+#include "util/memory.h"
+
+namespace {
+
+// Two complete chunks and a partial one at the end
+const SINT kFrameCount = 2 * CachingReaderChunk::kFrames + 100;
+const SINT kSamplingRate = 44100;
+const QString kDecoderName = "TestDecoder 2.1.0";
+
+class CachingReaderDiskCacheTest : public MixxxTest {
+  protected:
+    void SetUp() override {
+        // Only used to obtain a unique file name
+        m_tempFile.open();
+        m_filePath = m_tempFile.fileName() + ".pcm";
+    }
+
+    void TearDown() override {
+        QFile::remove(m_filePath);
+    }
+
+    std::unique_ptr<CachingReaderDiskCache> openCache(SINT frameCount,
+            const QString& decoderName = kDecoderName) {
+        return std::make_unique<CachingReaderDiskCache>(m_filePath,
+                decoderName, frameCount, CachingReaderChunk::kChannels,
+                kSamplingRate);
+    }
+
+    static std::vector<CSAMPLE> makeChunkSamples(SINT frameCount, CSAMPLE offset) {
+        std::vector<CSAMPLE> samples(CachingReaderChunk::frames2samples(frameCount));
+        for (size_t i = 0; i < samples.size(); ++i) {
+            samples[i] = offset + CSAMPLE(i % 1000) / 1000.0f;
+        }
+        return samples;
+    }
+
+    QTemporaryFile m_tempFile;
+    QString m_filePath;
+};
+
+TEST_F(CachingReaderDiskCacheTest, ChunkFrameCount) {
+    auto pCache = openCache(kFrameCount);
+    ASSERT_TRUE(pCache->isValid());
+    EXPECT_EQ(CachingReaderChunk::kFrames, pCache->chunkFrameCount(0));
+    EXPECT_EQ(CachingReaderChunk::kFrames, pCache->chunkFrameCount(1));
+    EXPECT_EQ(100, pCache->chunkFrameCount(2));
+    EXPECT_EQ(0, pCache->chunkFrameCount(3));
+}
+
+TEST_F(CachingReaderDiskCacheTest, WriteAndReadChunks) {
+    auto pCache = openCache(kFrameCount);
+    ASSERT_TRUE(pCache->isValid());
+    std::vector<CSAMPLE> buffer(CachingReaderChunk::kSamples);
+    EXPECT_EQ(0, pCache->readChunk(1, buffer.data()));
+
+    const auto chunk1 = makeChunkSamples(CachingReaderChunk::kFrames, 1.0f);
+    pCache->writeChunk(1, chunk1.data(), CachingReaderChunk::kFrames);
+    const auto chunk2 = makeChunkSamples(100, 2.0f);
+    pCache->writeChunk(2, chunk2.data(), 100);
+    // Partially decoded chunks are not cached
+    pCache->writeChunk(0, chunk1.data(), CachingReaderChunk::kFrames - 1);
+
+    EXPECT_FALSE(pCache->containsChunk(0));
+    EXPECT_TRUE(pCache->containsChunk(1));
+    EXPECT_TRUE(pCache->containsChunk(2));
+    EXPECT_FALSE(pCache->containsChunk(3));
+
+    ASSERT_EQ(CachingReaderChunk::kFrames, pCache->readChunk(1, buffer.data()));
+    EXPECT_TRUE(std::equal(chunk1.begin(), chunk1.end(), buffer.begin()));
+    ASSERT_EQ(100, pCache->readChunk(2, buffer.data()));
+    EXPECT_TRUE(std::equal(chunk2.begin(), chunk2.end(), buffer.begin()));
+}
+
+TEST_F(CachingReaderDiskCacheTest, ChunksPersistWhenReopened) {
+    const auto chunk0 = makeChunkSamples(CachingReaderChunk::kFrames, -1.0f);
+    {
+        auto pCache = openCache(kFrameCount);
+        ASSERT_TRUE(pCache->isValid());
+        pCache->writeChunk(0, chunk0.data(), CachingReaderChunk::kFrames);
+    }
+    auto pCache = openCache(kFrameCount);
+    ASSERT_TRUE(pCache->isValid());
+    EXPECT_TRUE(pCache->containsChunk(0));
+    EXPECT_FALSE(pCache->containsChunk(1));
+    std::vector<CSAMPLE> buffer(CachingReaderChunk::kSamples);
+    ASSERT_EQ(CachingReaderChunk::kFrames, pCache->readChunk(0, buffer.data()));
+    EXPECT_TRUE(std::equal(chunk0.begin(), chunk0.end(), buffer.begin()));
+}
+
+TEST_F(CachingReaderDiskCacheTest, IncompatibleFileIsDiscarded) {
+    const auto chunk0 = makeChunkSamples(CachingReaderChunk::kFrames, 0.0f);
+    {
+        auto pCache = openCache(kFrameCount);
+        ASSERT_TRUE(pCache->isValid());
+        pCache->writeChunk(0, chunk0.data(), CachingReaderChunk::kFrames);
+    }
+    // A different frame count, e.g. after the decoder has been updated
+    {
+        auto pCache = openCache(kFrameCount + 1);
+        EXPECT_FALSE(pCache->isValid());
+        EXPECT_FALSE(pCache->containsChunk(0));
+    }
+    // The incompatible file has been deleted and is recreated from scratch
+    auto pCache = openCache(kFrameCount + 1);
+    ASSERT_TRUE(pCache->isValid());
+    EXPECT_FALSE(pCache->containsChunk(0));
+}
+
+TEST_F(CachingReaderDiskCacheTest, OtherDecoderIsDiscarded) {
+    const auto chunk0 = makeChunkSamples(CachingReaderChunk::kFrames, 0.0f);
+    {
+        auto pCache = openCache(kFrameCount);
+        ASSERT_TRUE(pCache->isValid());
+        pCache->writeChunk(0, chunk0.data(), CachingReaderChunk::kFrames);
+    }
+    EXPECT_FALSE(openCache(kFrameCount, "TestDecoder 2.2.0")->isValid());
+    auto pCache = openCache(kFrameCount);
+    ASSERT_TRUE(pCache->isValid());
+    EXPECT_FALSE(pCache->containsChunk(0));
+}
+
+TEST_F(CachingReaderDiskCacheTest, OpenFileIsNotDiscarded) {
+    const auto chunk0 = makeChunkSamples(CachingReaderChunk::kFrames, 0.0f);
+    auto pCache = openCache(kFrameCount);
+    ASSERT_TRUE(pCache->isValid());
+    pCache->writeChunk(0, chunk0.data(), CachingReaderChunk::kFrames);
+    pCache->sync();
+
+    EXPECT_FALSE(openCache(kFrameCount, "TestDecoder 2.2.0")->isValid());
+    EXPECT_TRUE(QFile::exists(m_filePath));
+    EXPECT_TRUE(pCache->containsChunk(0));
+}
+
+TEST_F(CachingReaderDiskCacheTest, ChunksAreMarkedInFileAfterSync) {
+    const auto chunk0 = makeChunkSamples(CachingReaderChunk::kFrames, 0.0f);
+    auto pWriter = openCache(kFrameCount);
+    ASSERT_TRUE(pWriter->isValid());
+    pWriter->writeChunk(0, chunk0.data(), CachingReaderChunk::kFrames);
+    EXPECT_TRUE(pWriter->containsChunk(0));
+
+    // Another reader of the same file only sees the chunk after
+    // its samples have been synced.
+    auto pReader = openCache(kFrameCount);
+    ASSERT_TRUE(pReader->isValid());
+    EXPECT_FALSE(pReader->containsChunk(0));
+    pWriter->sync();
+    EXPECT_TRUE(pReader->containsChunk(0));
+}
+
+TEST_F(CachingReaderDiskCacheTest, PruneKeepsOpenFiles) {
+    const QString dirPath = m_tempFile.fileName() + "_dir";
+    ASSERT_TRUE(QDir().mkpath(dirPath));
+    const auto chunk0 = makeChunkSamples(CachingReaderChunk::kFrames, 0.0f);
+    const QString openFilePath = QDir(dirPath).filePath("open.pcm");
+    const QString closedFilePath = QDir(dirPath).filePath("closed.pcm");
+    {
+        CachingReaderDiskCache closedCache(closedFilePath, kDecoderName,
+                kFrameCount, CachingReaderChunk::kChannels, kSamplingRate);
+        closedCache.writeChunk(0, chunk0.data(), CachingReaderChunk::kFrames);
+    }
+    {
+        CachingReaderDiskCache openFileCache(openFilePath, kDecoderName,
+                kFrameCount, CachingReaderChunk::kChannels, kSamplingRate);
+        openFileCache.writeChunk(0, chunk0.data(), CachingReaderChunk::kFrames);
+        openFileCache.sync();
+
+        CachingReaderDiskCache::pruneCacheDir(dirPath, 0);
+        EXPECT_TRUE(QFile::exists(openFilePath));
+        EXPECT_FALSE(QFile::exists(closedFilePath));
+    }
+
+    QFile::remove(openFilePath);
+    QDir().rmdir(dirPath);
+}
+
+TEST_F(CachingReaderDiskCacheTest, DisabledByDefault) {
+    EXPECT_FALSE(config()->getValue(CachingReaderDiskCache::kConfigKeyEnabled, false));
+    EXPECT_FALSE(CachingReaderDiskCache::openForTrack(
+            config(), TrackPointer(), mixxx::AudioSourcePointer(), kDecoderName));
+}
+
+}  // namespace
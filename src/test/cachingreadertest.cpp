@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+
+#include <QDir>
+#include <QtTest>
+
+#include "control/controlobject.h"
+#include "engine/cachingreader.h"
+#include "engine/engineworkerscheduler.h"
+#include "sources/soundsourceproxy.h"
+#include "test/mixxxtest.h"
+#include "util/samplebuffer.h"
+#include "util/time.h"
+
+namespace {
+
+const int kTimeoutMillis = 10000;
+
+// Longer than the interval for publishing the cache statistics
+const mixxx::Duration kStatsInterval = mixxx::Duration::fromMillis(1100);
+
+class CachingReaderTest : public MixxxTest {
+  protected:
+    void SetUp() override {
+        m_pTrack = Track::newTemporary(
+                QDir::currentPath() + "/src/test/sine-30.wav");
+        m_scheduler.start();
+        // The cache statistics are published depending on the elapsed time
+        mixxx::Time::setTestMode(true);
+        mixxx::Time::setTestElapsedTime(mixxx::Duration::fromSeconds(0));
+    }
+
+    void TearDown() override {
+        mixxx::Time::setTestMode(false);
+    }
+
+    // Advances the clock so that the next call to process() publishes
+    // the cache statistics.
+    static void advancePastStatsInterval() {
+        mixxx::Time::setTestElapsedTime(
+                mixxx::Time::elapsed() + kStatsInterval);
+    }
+
+    // Enables preloading like Sampler does by default
+    static void enablePreload(const QString& group) {
+        ControlObject::set(ConfigKey(group, "preload_track"), 1.0);
+    }
+
+    // Loads the test track and waits until the worker has finished
+    // loading and optionally preloading it.
+    void loadTrack(CachingReader* pReader) {
+        QSignalSpy loadedSpy(pReader,
+                SIGNAL(trackLoaded(TrackPointer, int, int)));
+        pReader->setScheduler(&m_scheduler);
+        pReader->newTrack(m_pTrack);
+        for (int i = 0; i < kTimeoutMillis; ++i) {
+            m_scheduler.runWorkers();
+            pReader->process();
+            if (pReader->isTrackPreloaded() ||
+                    (!loadedSpy.isEmpty() && !m_expectPreload)) {
+                break;
+            }
+            QTest::qSleep(1);
+        }
+        ASSERT_FALSE(loadedSpy.isEmpty());
+        // Receive the status of the loaded track
+        pReader->process();
+    }
+
+    // Decodes the whole test track without the CachingReader
+    SampleBuffer decodeTrack(SINT* pFrameCount) {
+        mixxx::AudioSourceConfig audioSrcCfg;
+        audioSrcCfg.setChannelCount(CachingReaderChunk::kChannels);
+        auto pAudioSource = SoundSourceProxy(m_pTrack).openAudioSource(audioSrcCfg);
+        EXPECT_TRUE(pAudioSource != nullptr);
+        *pFrameCount = pAudioSource->getFrameCount();
+        SampleBuffer samples(CachingReaderChunk::frames2samples(*pFrameCount));
+        EXPECT_EQ(*pFrameCount,
+                pAudioSource->readSampleFramesStereo(*pFrameCount, &samples));
+        return samples;
+    }
+
+    TrackPointer m_pTrack;
+    EngineWorkerScheduler m_scheduler;
+    bool m_expectPreload = true;
+};
+
+TEST_F(CachingReaderTest, SamplerReadsWithoutHints) {
+    CachingReader reader("[Sampler1]", config());
+    enablePreload("[Sampler1]");
+    loadTrack(&reader);
+    ASSERT_TRUE(reader.isTrackPreloaded());
+
+    SINT frameCount = 0;
+    const SampleBuffer expected = decodeTrack(&frameCount);
+    ASSERT_LT(3 * CachingReaderChunk::kFrames, frameCount);
+
+    // Read across chunk boundaries at random positions without any hints
+    const SINT kReadFrames = 1000;
+    const SINT kReadSamples = CachingReaderChunk::frames2samples(kReadFrames);
+    SampleBuffer actual(kReadSamples);
+    const SINT startFrames[] = {
+            CachingReaderChunk::kFrames * 3 - 500,
+            0,
+            frameCount - kReadFrames};
+    for (SINT startFrame : startFrames) {
+        const SINT startSample = CachingReaderChunk::frames2samples(startFrame);
+        ASSERT_EQ(kReadSamples, reader.read(
+                startSample, kReadSamples, false, actual.data()));
+        for (SINT i = 0; i < kReadSamples; ++i) {
+            ASSERT_EQ(expected[startSample + i], actual[i]) << startFrame;
+        }
+    }
+
+    // Backwards playback reads the same frames in reverse order
+    const SINT endSample = CachingReaderChunk::frames2samples(
+            CachingReaderChunk::kFrames + 200);
+    ASSERT_EQ(kReadSamples, reader.read(
+            endSample, kReadSamples, true, actual.data()));
+    for (SINT i = 0; i < kReadSamples; i += CachingReaderChunk::kChannels) {
+        const SINT expectedSample = endSample - i - CachingReaderChunk::kChannels;
+        EXPECT_EQ(expected[expectedSample], actual[i]);
+        EXPECT_EQ(expected[expectedSample + 1], actual[i + 1]);
+    }
+
+    // Reading beyond the end of the track is padded with silence
+    const SINT endOfTrackSample = CachingReaderChunk::frames2samples(frameCount);
+    ASSERT_EQ(kReadSamples, reader.read(
+            endOfTrackSample - 100, kReadSamples, false, actual.data()));
+    for (SINT i = 0; i < 100; ++i) {
+        EXPECT_EQ(expected[endOfTrackSample - 100 + i], actual[i]);
+    }
+    for (SINT i = 100; i < kReadSamples; ++i) {
+        EXPECT_EQ(0.0f, actual[i]);
+    }
+}
+
+TEST_F(CachingReaderTest, DeckIsNotPreloadedByDefault) {
+    m_expectPreload = false;
+    CachingReader reader("[Channel1]", config());
+    EXPECT_EQ(0.0, ControlObject::get(ConfigKey("[Channel1]", "preload_track")));
+    loadTrack(&reader);
+    EXPECT_FALSE(reader.isTrackPreloaded());
+}
+
+TEST_F(CachingReaderTest, LongTrackIsNotPreloaded) {
+    m_expectPreload = false;
+    config()->setValue(CachingReaderWorker::kConfigKeyPreloadMaxMB, 1);
+    CachingReader reader("[Sampler1]", config());
+    enablePreload("[Sampler1]");
+    loadTrack(&reader);
+    EXPECT_FALSE(reader.isTrackPreloaded());
+}
+
+TEST_F(CachingReaderTest, CacheMissesAreCounted) {
+    m_expectPreload = false;
+    CachingReader reader("[Channel1]", config());
+    loadTrack(&reader);
+
+    // Nothing has been hinted, so the chunk is not available yet
+    const SINT kReadFrames = 1000;
+    SampleBuffer buffer(CachingReaderChunk::frames2samples(kReadFrames));
+    reader.read(0, buffer.size(), false, buffer.data());
+
+    advancePastStatsInterval();
+    reader.process();
+    EXPECT_EQ(0.0, ControlObject::get(ConfigKey("[Channel1]", "cache_hits")));
+    EXPECT_EQ(1.0, ControlObject::get(ConfigKey("[Channel1]", "cache_misses")));
+    EXPECT_EQ(double(kReadFrames), ControlObject::get(
+            ConfigKey("[Channel1]", "cache_zero_filled_frames")));
+}
+
+TEST_F(CachingReaderTest, CacheHitsAreCounted) {
+    CachingReader reader("[Sampler1]", config());
+    enablePreload("[Sampler1]");
+    loadTrack(&reader);
+    ASSERT_TRUE(reader.isTrackPreloaded());
+    // The chunks have been decoded while preloading
+    EXPECT_LE(0.0, ControlObject::get(
+            ConfigKey("[Sampler1]", "cache_decode_latency_ms")));
+    EXPECT_LE(ControlObject::get(ConfigKey("[Sampler1]", "cache_decode_latency_ms")),
+            ControlObject::get(ConfigKey("[Sampler1]", "cache_decode_latency_max_ms")));
+
+    SampleBuffer buffer(CachingReaderChunk::frames2samples(1000));
+    reader.read(0, buffer.size(), false, buffer.data());
+    reader.read(buffer.size(), buffer.size(), false, buffer.data());
+
+    advancePastStatsInterval();
+    reader.process();
+    EXPECT_EQ(2.0, ControlObject::get(ConfigKey("[Sampler1]", "cache_hits")));
+    EXPECT_EQ(0.0, ControlObject::get(ConfigKey("[Sampler1]", "cache_misses")));
+    EXPECT_EQ(0.0, ControlObject::get(
+            ConfigKey("[Sampler1]", "cache_zero_filled_frames")));
+}
+
+}  // namespace
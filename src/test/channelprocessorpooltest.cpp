@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <QAtomicInt>
+#include <QThread>
+
+#include <memory>
+#include <vector>
+
+#include "engine/channelhandle.h"
+#include "engine/channelprocessorpool.h"
+#include "engine/enginechannel.h"
+#include "test/mixxxtest.h"
+#include "util/compatibility.h"
+#include "util/memory.h"
+#include "util/sample.h"
+#include "util/sleepableqthread.h"
+
+namespace {
+
+// Fills the buffer with its own value and remembers the processing thread
+class FillingChannel : public EngineChannel {
+  public:
+    FillingChannel(const ChannelHandleAndGroup& handleGroup, CSAMPLE value)
+            : EngineChannel(handleGroup),
+              m_value(value),
+              m_pThread(nullptr),
+              m_processCount(0) {
+    }
+
+    bool isActive() override {
+        return true;
+    }
+
+    void process(CSAMPLE* pOut, const int iBufferSize) override {
+        processParallel(pOut, iBufferSize);
+    }
+
+    void processParallel(CSAMPLE* pOut, const int iBufferSize) override {
+        SampleUtil::fill(pOut, m_value, iBufferSize);
+        m_pThread = QThread::currentThread();
+        m_processCount.fetchAndAddOrdered(1);
+    }
+
+    void postProcess(const int iBufferSize) override {
+        Q_UNUSED(iBufferSize);
+    }
+
+    QThread* processingThread() const {
+        return m_pThread;
+    }
+
+    int processCount() const {
+        return load_atomic(m_processCount);
+    }
+
+  private:
+    const CSAMPLE m_value;
+    QThread* m_pThread;
+    QAtomicInt m_processCount;
+};
+
+class ChannelProcessorPoolTest : public MixxxTest {
+  protected:
+    static const int kBufferSize = 256;
+
+    void addChannels(int numChannels) {
+        for (int i = 0; i < numChannels; ++i) {
+            const QString group = QString("[Channel%1]").arg(i + 1);
+            const ChannelHandleAndGroup handleGroup(
+                    m_handleFactory.getOrCreateHandle(group), group);
+            m_channels.push_back(
+                    std::make_unique<FillingChannel>(handleGroup, CSAMPLE(i)));
+            m_buffers.push_back(std::vector<CSAMPLE>(kBufferSize));
+        }
+        for (int i = 0; i < numChannels; ++i) {
+            ChannelProcessorPool::Job job;
+            job.pChannel = m_channels[i].get();
+            job.pBuffer = m_buffers[i].data();
+            m_jobs.push_back(job);
+        }
+    }
+
+    void processAndVerify(ChannelProcessorPool* pPool, int expectedCount) {
+        for (auto& buffer: m_buffers) {
+            SampleUtil::fill(buffer.data(), CSAMPLE(-1), kBufferSize);
+        }
+        pPool->process(m_jobs.data(), static_cast<int>(m_jobs.size()), kBufferSize);
+        for (size_t i = 0; i < m_channels.size(); ++i) {
+            EXPECT_EQ(expectedCount, m_channels[i]->processCount());
+            for (int j = 0; j < kBufferSize; ++j) {
+                ASSERT_EQ(CSAMPLE(i), m_buffers[i][j]);
+            }
+        }
+    }
+
+    ChannelHandleFactory m_handleFactory;
+    std::vector<std::unique_ptr<FillingChannel>> m_channels;
+    std::vector<std::vector<CSAMPLE>> m_buffers;
+    std::vector<ChannelProcessorPool::Job> m_jobs;
+};
+
+TEST_F(ChannelProcessorPoolTest, ProcessesAllChannelsOnce) {
+    addChannels(8);
+    ChannelProcessorPool pool(3);
+    // Many callbacks in a row to cover helper threads that
+    // are still busy waiting or already sleeping.
+    for (int i = 1; i <= 1000; ++i) {
+        processAndVerify(&pool, i);
+    }
+}
+
+TEST_F(ChannelProcessorPoolTest, WithoutThreadsProcessesInCallingThread) {
+    addChannels(4);
+    ChannelProcessorPool pool(0);
+    processAndVerify(&pool, 1);
+    for (const auto& pChannel: m_channels) {
+        EXPECT_EQ(QThread::currentThread(), pChannel->processingThread());
+    }
+}
+
+TEST_F(ChannelProcessorPoolTest, WakesUpSleepingThreads) {
+    addChannels(4);
+    ChannelProcessorPool pool(2);
+    processAndVerify(&pool, 1);
+    // Give the helper threads enough time to go to sleep
+    SleepableQThread::msleep(50);
+    processAndVerify(&pool, 2);
+}
+
+}  // namespace
@@ -6,6 +6,7 @@
 #include "preferences/usersettings.h"
 #include "controllers/controllerengine.h"
 #include "controllers/controllerdebug.h"
+#include "controllers/controllerscriptprofiler.h"
 #include "controllers/softtakeover.h"
 #include "test/mixxxtest.h"
 #include "util/memory.h"
@@ -25,6 +26,7 @@ class ControllerEngineTest : public MixxxTest {
     void TearDown() override {
         cEngine->gracefulShutdown();
         delete cEngine;
+        ControllerScriptProfiler::disable();
         mixxx::Time::setTestMode(false);
     }
 
@@ -71,6 +73,31 @@ TEST_F(ControllerEngineTest, getSetValue) {
     EXPECT_DOUBLE_EQ(1.0, co->get());
 }
 
+TEST_F(ControllerEngineTest, getSetValueByHandle) {
+    auto co = std::make_unique<ControlObject>(ConfigKey("[Test]", "co"));
+    EXPECT_TRUE(execute("function() {"
+                        "  var handle = engine.getControlHandle('[Test]', 'co');"
+                        "  engine.setValueByHandle(handle,"
+                        "      engine.getValueByHandle(handle) + 1); }"));
+    EXPECT_DOUBLE_EQ(1.0, co->get());
+    EXPECT_TRUE(execute(QString("function() {"
+                                "  engine.setParameterByHandle(%1, 0.5); }")
+                        .arg(co->handle().handle())));
+    EXPECT_DOUBLE_EQ(0.5, co->getParameter());
+}
+
+TEST_F(ControllerEngineTest, setValueByHandle_DeletedControl) {
+    auto co = std::make_unique<ControlObject>(ConfigKey("[Test]", "co"));
+    const int handle = co->handle().handle();
+    co.reset();
+    // Handles are not reused, so the handle doesn't refer to the new control
+    auto co2 = std::make_unique<ControlObject>(ConfigKey("[Test]", "co2"));
+    EXPECT_TRUE(execute(QString("function() {"
+                                "  engine.setValueByHandle(%1, 1.0); }")
+                        .arg(handle)));
+    EXPECT_DOUBLE_EQ(0.0, co2->get());
+}
+
 TEST_F(ControllerEngineTest, setParameter) {
     auto co = std::make_unique<ControlPotmeter>(ConfigKey("[Test]", "co"),
                                                 -10.0, 10.0);
@@ -588,3 +615,29 @@ TEST_F(ControllerEngineTest, connectionExecutesWithCorrectThisObject) {
     // The counter should have been incremented exactly once.
     EXPECT_DOUBLE_EQ(1.0, pass->get());
 }
+
+TEST_F(ControllerEngineTest, profilerRecordsFunctionsAndConnections) {
+    // The profiler is created with the engine
+    ControllerScriptProfiler::enable();
+    cEngine->gracefulShutdown();
+    delete cEngine;
+    cEngine = new ControllerEngine(nullptr);
+    cEngine->setPopups(false);
+    ASSERT_NE(nullptr, cEngine->profiler());
+
+    auto co = std::make_unique<ControlObject>(ConfigKey("[Test]", "co"));
+    ScopedTemporaryFile script(makeTemporaryFile(
+        "var profiled = function () { engine.setValue('[Test]', 'co', 1); };"
+        "var connection = engine.makeConnection('[Test]', 'co', profiled);"
+        "connection.trigger();"));
+    cEngine->evaluate(script->fileName());
+    EXPECT_FALSE(cEngine->hasErrors(script->fileName()));
+    EXPECT_TRUE(execute("profiled"));
+
+    const QStringList report = cEngine->profiler()->report();
+    ASSERT_EQ(2, report.size());
+    EXPECT_EQ(1, report.filter(QRegExp("^1 calls, .*: profiled$")).size());
+    EXPECT_EQ(2, report.filter(QString("1 calls, ")).size());
+    // Identified by where it was made
+    EXPECT_EQ(1, report.filter(QRegExp(": connection \\[Test\\],co \\(.+:1\\)$")).size());
+}
@@ -0,0 +1,35 @@
+#include <gtest/gtest.h>
+
+#include "controllers/controllerscriptprofiler.h"
+
+namespace {
+
+class ControllerScriptProfilerTest : public testing::Test {
+  protected:
+    void TearDown() override {
+        ControllerScriptProfiler::disable();
+    }
+};
+
+TEST_F(ControllerScriptProfilerTest, ReportsMostExpensiveFirst) {
+    ControllerScriptProfiler profiler;
+    profiler.record("cheap", mixxx::Duration::fromMicros(10));
+    profiler.record("expensive", mixxx::Duration::fromMicros(100));
+    profiler.record("cheap", mixxx::Duration::fromMicros(30));
+    profiler.record("expensive", mixxx::Duration::fromMicros(300));
+
+    EXPECT_EQ(QStringList()
+              << "2 calls, 400 us total, 200 us mean, 300 us max: expensive"
+              << "2 calls, 40 us total, 20 us mean, 30 us max: cheap",
+              profiler.report());
+
+    profiler.reset();
+    EXPECT_TRUE(profiler.report().isEmpty());
+}
+
+TEST_F(ControllerScriptProfilerTest, CanBeEnabledForTesting) {
+    ControllerScriptProfiler::enable();
+    EXPECT_TRUE(ControllerScriptProfiler::enabled());
+}
+
+}  // namespace
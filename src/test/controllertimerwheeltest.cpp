@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include "controllers/controllertimerwheel.h"
+
+namespace {
+
+mixxx::Duration micros(qint64 value) {
+    return mixxx::Duration::fromMicros(value);
+}
+
+class ControllerTimerWheelTest : public testing::Test {
+  protected:
+    ControllerTimerWheel m_wheel;
+};
+
+TEST_F(ControllerTimerWheelTest, OneShot) {
+    const int timerId = m_wheel.start(micros(1000), true, micros(0));
+    EXPECT_NE(0, timerId);
+    EXPECT_TRUE(m_wheel.isActive(timerId));
+    EXPECT_EQ(micros(1000), m_wheel.nextDeadline());
+
+    EXPECT_TRUE(m_wheel.takeExpired(micros(999)).isEmpty());
+    EXPECT_EQ(QVector<int>() << timerId, m_wheel.takeExpired(micros(1000)));
+    EXPECT_FALSE(m_wheel.isActive(timerId));
+    EXPECT_TRUE(m_wheel.isEmpty());
+    EXPECT_TRUE(m_wheel.takeExpired(micros(5000)).isEmpty());
+}
+
+TEST_F(ControllerTimerWheelTest, SubMillisecondResolution) {
+    const int first = m_wheel.start(micros(250), true, micros(0));
+    const int second = m_wheel.start(micros(750), true, micros(0));
+    EXPECT_EQ(QVector<int>() << first, m_wheel.takeExpired(micros(500)));
+    EXPECT_EQ(micros(750), m_wheel.nextDeadline());
+    EXPECT_EQ(QVector<int>() << second, m_wheel.takeExpired(micros(800)));
+}
+
+TEST_F(ControllerTimerWheelTest, DeadlinesBetweenTicks) {
+    const int timerId = m_wheel.start(micros(1100), false, micros(0));
+    // Rounded up to the end of the tick
+    EXPECT_EQ(micros(1250), m_wheel.nextDeadline());
+    EXPECT_TRUE(m_wheel.takeExpired(micros(1100)).isEmpty());
+    EXPECT_TRUE(m_wheel.takeExpired(micros(1249)).isEmpty());
+    EXPECT_EQ(QVector<int>() << timerId,
+              m_wheel.takeExpired(m_wheel.nextDeadline()));
+    EXPECT_EQ(micros(2250), m_wheel.nextDeadline());
+    EXPECT_EQ(QVector<int>() << timerId,
+              m_wheel.takeExpired(m_wheel.nextDeadline()));
+    EXPECT_EQ(micros(3500), m_wheel.nextDeadline());
+
+    const int later = m_wheel.start(micros(ControllerTimerWheel::kTickMicros *
+                                           ControllerTimerWheel::kSlotCount * 2 + 10),
+                                    true, micros(2250));
+    EXPECT_TRUE(m_wheel.stop(timerId));
+    EXPECT_EQ(micros(ControllerTimerWheel::kTickMicros *
+                     ControllerTimerWheel::kSlotCount * 2 + 2500),
+              m_wheel.nextDeadline());
+    EXPECT_EQ(QVector<int>() << later,
+              m_wheel.takeExpired(m_wheel.nextDeadline()));
+}
+
+TEST_F(ControllerTimerWheelTest, RepeatingDoesNotDrift) {
+    const int timerId = m_wheel.start(micros(1000), false, micros(0));
+    // Dispatched late
+    EXPECT_EQ(QVector<int>() << timerId, m_wheel.takeExpired(micros(1400)));
+    EXPECT_EQ(micros(2000), m_wheel.nextDeadline());
+    EXPECT_EQ(QVector<int>() << timerId, m_wheel.takeExpired(micros(2000)));
+    EXPECT_EQ(micros(3000), m_wheel.nextDeadline());
+
+    // Missed deadlines are skipped
+    EXPECT_EQ(QVector<int>() << timerId, m_wheel.takeExpired(micros(5500)));
+    EXPECT_EQ(micros(6000), m_wheel.nextDeadline());
+
+    EXPECT_TRUE(m_wheel.stop(timerId));
+    EXPECT_FALSE(m_wheel.stop(timerId));
+    EXPECT_TRUE(m_wheel.isEmpty());
+}
+
+TEST_F(ControllerTimerWheelTest, ExpiresInOrderOfDeadlines) {
+    const int slow = m_wheel.start(micros(3000), true, micros(0));
+    const int fast = m_wheel.start(micros(1000), false, micros(0));
+    const int medium = m_wheel.start(micros(2000), true, micros(0));
+    const int sameAsMedium = m_wheel.start(micros(2000), true, micros(0));
+    EXPECT_EQ(QVector<int>() << fast << medium << sameAsMedium << slow,
+              m_wheel.takeExpired(micros(3000)));
+    EXPECT_EQ(micros(4000), m_wheel.nextDeadline());
+}
+
+TEST_F(ControllerTimerWheelTest, DeadlinesBeyondOneRevolution) {
+    const qint64 revolution =
+            ControllerTimerWheel::kTickMicros * ControllerTimerWheel::kSlotCount;
+    const int later = m_wheel.start(micros(revolution * 3 + 500), true,
+                                    micros(0));
+    const int soon = m_wheel.start(micros(500), true, micros(0));
+    EXPECT_EQ(QVector<int>() << soon, m_wheel.takeExpired(micros(500)));
+    EXPECT_EQ(micros(revolution * 3 + 500), m_wheel.nextDeadline());
+
+    // Passing the slot of the later timer doesn't fire it early
+    EXPECT_TRUE(m_wheel.takeExpired(micros(revolution + 500)).isEmpty());
+    EXPECT_TRUE(m_wheel.takeExpired(micros(revolution * 2 + 600)).isEmpty());
+    EXPECT_EQ(QVector<int>() << later,
+              m_wheel.takeExpired(micros(revolution * 10)));
+}
+
+TEST_F(ControllerTimerWheelTest, ManyTimers) {
+    QVector<int> timerIds;
+    for (int i = 0; i < 64; ++i) {
+        timerIds.append(m_wheel.start(micros(20000), false, micros(0)));
+    }
+    EXPECT_TRUE(m_wheel.takeExpired(micros(19999)).isEmpty());
+    EXPECT_EQ(timerIds, m_wheel.takeExpired(micros(20000)));
+    EXPECT_EQ(timerIds, m_wheel.takeExpired(micros(40000)));
+
+    m_wheel.clear();
+    EXPECT_TRUE(m_wheel.isEmpty());
+    EXPECT_TRUE(m_wheel.takeExpired(micros(60000)).isEmpty());
+}
+
+}  // namespace
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <QtDebug>
 
+#include "control/controlhandleresolver.h"
 #include "control/controlobject.h"
 #include "util/memory.h"
 #include "test/mixxxtest.h"
@@ -35,6 +36,46 @@ TEST_F(ControlObjectTest, getControl) {
     EXPECT_EQ(ControlObject::getControl(ck2), (ControlObject*)nullptr);
 }
 
+TEST_F(ControlObjectTest, getControlByHandle) {
+    ControlHandle handle1 = ControlDoublePrivate::getHandle(ck1);
+    ControlHandle handle2 = ControlDoublePrivate::getHandle(ck2);
+    ASSERT_TRUE(handle1.valid());
+    ASSERT_TRUE(handle2.valid());
+    EXPECT_NE(handle1, handle2);
+    EXPECT_EQ(co1->handle(), handle1);
+    EXPECT_EQ(ControlObject::getControl(handle1), co1.get());
+    EXPECT_EQ(ControlObject::getControl(handle2), co2.get());
+    co2.reset();
+    EXPECT_EQ(ControlObject::getControl(handle2), (ControlObject*)nullptr);
+    EXPECT_FALSE(ControlDoublePrivate::getHandle(ck2, false).valid());
+    EXPECT_EQ(ControlObject::getControl(ControlHandle()), (ControlObject*)nullptr);
+}
+
+TEST_F(ControlObjectTest, getControlByHandle_HandlesAreNotReused) {
+    ControlHandle handle2 = co2->handle();
+    co2.reset();
+    co2 = std::make_unique<ControlObject>(ck2);
+    EXPECT_NE(handle2, co2->handle());
+    EXPECT_TRUE(ControlDoublePrivate::getControlByHandle(handle2).isNull());
+    EXPECT_EQ(ControlObject::getControl(co2->handle()), co2.get());
+
+    auto co3 = std::make_unique<ControlObject>(ConfigKey("[Channel1]", "co3"));
+    EXPECT_NE(handle2, co3->handle());
+    EXPECT_TRUE(ControlDoublePrivate::getControlByHandle(handle2).isNull());
+}
+
+TEST_F(ControlObjectTest, ControlHandleResolver) {
+    ControlHandleResolver resolver;
+    EXPECT_EQ(co1->handle(), resolver.resolve(ck1));
+    EXPECT_EQ(co1->handle(), resolver.resolve(ck1));
+
+    // Resolves the new handle of a control that has been created again
+    co1.reset();
+    EXPECT_FALSE(resolver.resolve(ck1, false).valid());
+    co1 = std::make_unique<ControlObject>(ck1);
+    EXPECT_EQ(co1->handle(), resolver.resolve(ck1));
+}
+
 TEST_F(ControlObjectTest, AliasRetrieval) {
     ConfigKey ck("[Microphone1]", "volume");
     ConfigKey ckAlias("[Microphone]", "volume");
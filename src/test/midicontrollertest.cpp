@@ -1,5 +1,6 @@
 #include <QScopedPointer>
 
+#include <benchmark/benchmark.h>
 #include <gmock/gmock.h>
 
 #include "test/mixxxtest.h"
@@ -17,11 +18,13 @@ class MockMidiController : public MidiController {
 
     MOCK_METHOD0(open, int());
     MOCK_METHOD0(close, int());
-    MOCK_METHOD3(sendShortMsg, void(unsigned char status,
-                                    unsigned char byte1,
-                                    unsigned char byte2));
-    MOCK_METHOD1(send, void(QByteArray data));
+    MOCK_METHOD3(writeShortMsg, void(unsigned char status,
+                                     unsigned char byte1,
+                                     unsigned char byte2));
+    MOCK_METHOD1(writeSysex, void(QByteArray data));
     MOCK_CONST_METHOD0(isPolling, bool());
+
+    using MidiController::receive;
 };
 
 class MidiControllerTest : public MixxxTest {
@@ -523,3 +526,106 @@ TEST_F(MidiControllerTest, ReceiveMessage_PotMeterCO_14BitPitchBend) {
     receive(MIDI_PITCH_BEND | channel, 0x01, 0x40);
     EXPECT_LT(kMiddleValue, potmeter.get());
 }
+
+TEST_F(MidiControllerTest, ReceiveMessage_DirectMapping_ControlReplaced) {
+    ConfigKey key("[Channel1]", "rate");
+    unsigned char channel = 0x01;
+    unsigned char control = 0x10;
+
+    addMapping(MidiInputMapping(MidiKey(MIDI_CC | channel, control),
+                                MidiOptions(), key));
+    loadPreset(m_preset);
+
+    // The control doesn't exist yet
+    receive(MIDI_CC | channel, control, 0x7F);
+
+    QScopedPointer<ControlPotmeter> pPotmeter(new ControlPotmeter(key, 0.0, 1.0));
+    receive(MIDI_CC | channel, control, 0x7F);
+    EXPECT_DOUBLE_EQ(1.0, pPotmeter->get());
+
+    // A control with the same key that replaces the resolved one is found
+    pPotmeter.reset();
+    ControlPotmeter otherControl(ConfigKey("[Channel1]", "other"), 0.0, 1.0);
+    pPotmeter.reset(new ControlPotmeter(key, 0.0, 2.0));
+    receive(MIDI_CC | channel, control, 0x7F);
+    EXPECT_DOUBLE_EQ(2.0, pPotmeter->get());
+    EXPECT_DOUBLE_EQ(0.0, otherControl.get());
+}
+
+TEST_F(MidiControllerTest, ReceiveMessage_DirectMapping_MixedWithScript) {
+    ConfigKey key("[Channel1]", "rate");
+    ControlPotmeter potmeter(key, 0.0, 1.0);
+    unsigned char channel = 0x01;
+    unsigned char control = 0x10;
+
+    // A script mapping for the same message takes the regular path, which
+    // still sets the control of the other mapping.
+    MidiOptions scriptOptions;
+    scriptOptions.script = true;
+    addMapping(MidiInputMapping(MidiKey(MIDI_CC | channel, control),
+                                MidiOptions(), key));
+    addMapping(MidiInputMapping(MidiKey(MIDI_CC | channel, control),
+                                scriptOptions,
+                                ConfigKey("[Channel1]", "script.handler")));
+    loadPreset(m_preset);
+
+    receive(MIDI_CC | channel, control, 0x7F);
+    EXPECT_DOUBLE_EQ(1.0, potmeter.get());
+}
+
+TEST_F(MidiControllerTest, SendShortMsg_SendsRepeatedMessagesByDefault) {
+    EXPECT_CALL(*m_pController, writeShortMsg(MIDI_NOTE_ON, 0x10, 0x7F))
+            .Times(2);
+
+    m_pController->sendShortMsg(MIDI_NOTE_ON, 0x10, 0x7F);
+    m_pController->sendShortMsg(MIDI_NOTE_ON, 0x10, 0x7F);
+}
+
+TEST_F(MidiControllerTest, SendShortMsg_SuppressesRepeatedMessagesOnRequest) {
+    EXPECT_CALL(*m_pController, writeShortMsg(MIDI_NOTE_ON, 0x10, 0x7F))
+            .Times(2);
+    EXPECT_CALL(*m_pController, writeShortMsg(MIDI_NOTE_OFF, 0x10, 0x00))
+            .Times(1);
+
+    m_pController->sendShortMsg(MIDI_NOTE_ON, 0x10, 0x7F, true);
+    m_pController->sendShortMsg(MIDI_NOTE_ON, 0x10, 0x7F, true);
+    m_pController->sendShortMsg(MIDI_NOTE_OFF, 0x10, 0x00, true);
+    m_pController->sendShortMsg(MIDI_NOTE_OFF, 0x10, 0x00, true);
+
+    // Controllers with local control light their LEDs on their own
+    receive(MIDI_NOTE_ON, 0x10, 0x7F);
+    m_pController->sendShortMsg(MIDI_NOTE_ON, 0x10, 0x7F, true);
+}
+
+// Measures the time from receiving a message until the control has changed.
+static void BM_MidiControllerReceive(benchmark::State& state) {
+    ConfigKey key("[Channel1]", "rate");
+    ControlPotmeter potmeter(key, 0.0, 1.0);
+    unsigned char status = MIDI_CC | 0x01;
+    unsigned char control = 0x10;
+
+    // A script mapping of the message sends all of its mappings down the
+    // regular path. Without a script engine it returns right away, so only
+    // the plain mapping is measured.
+    MidiControllerPreset preset;
+    MidiKey mappingKey(status, control);
+    preset.inputMappings.insertMulti(mappingKey.key,
+            MidiInputMapping(mappingKey, MidiOptions(), key));
+    if (state.range_x() == 0) {
+        MidiOptions options;
+        options.script = true;
+        preset.inputMappings.insertMulti(mappingKey.key,
+                MidiInputMapping(mappingKey, options,
+                                 ConfigKey("[Channel1]", "scriptFunction")));
+    }
+    MockMidiController controller;
+    controller.visit(&preset);
+
+    unsigned char value = 0;
+    while (state.KeepRunning()) {
+        value = (value + 1) & 0x7F;
+        controller.receive(status, control, value, mixxx::Duration());
+    }
+}
+// 0: regular path, 1: direct path
+BENCHMARK(BM_MidiControllerReceive)->Arg(0)->Arg(1);
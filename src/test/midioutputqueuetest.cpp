@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include <QStringList>
+
+#include "controllers/midi/midimessage.h"
+#include "controllers/midi/midioutputqueue.h"
+
+namespace {
+
+class MidiOutputQueueTest : public testing::Test {
+  protected:
+    // Returns the messages of the next frame as "status byte1 byte2" hex
+    // strings.
+    QStringList takeFrame() {
+        QStringList messages;
+        for (const MidiOutputMessage& message : m_queue.takeFrame()) {
+            messages << QString("%1 %2 %3")
+                    .arg(message.status, 2, 16, QChar('0'))
+                    .arg(message.byte1, 2, 16, QChar('0'))
+                    .arg(message.byte2, 2, 16, QChar('0'));
+        }
+        return messages;
+    }
+
+    MidiOutputQueue m_queue;
+};
+
+TEST_F(MidiOutputQueueTest, SuppressesRedundantMessages) {
+    EXPECT_TRUE(m_queue.sendNow(MIDI_NOTE_ON, 0x10, 0x7F));
+    EXPECT_FALSE(m_queue.sendNow(MIDI_NOTE_ON, 0x10, 0x7F));
+    // Other channel and note
+    EXPECT_TRUE(m_queue.sendNow(MIDI_NOTE_ON | 0x01, 0x10, 0x7F));
+    EXPECT_TRUE(m_queue.sendNow(MIDI_NOTE_ON, 0x11, 0x7F));
+    // Note off changes the state of the note
+    EXPECT_TRUE(m_queue.sendNow(MIDI_NOTE_OFF, 0x10, 0x00));
+    EXPECT_TRUE(m_queue.sendNow(MIDI_NOTE_ON, 0x10, 0x7F));
+    EXPECT_EQ(5, m_queue.takeSentCount());
+    EXPECT_EQ(1, m_queue.takeSuppressedCount());
+    EXPECT_EQ(0, m_queue.takeSentCount());
+}
+
+TEST_F(MidiOutputQueueTest, StatelessMessagesAreAlwaysSent) {
+    // Data entry of (N)RPNs
+    EXPECT_TRUE(m_queue.sendNow(MIDI_CC, 0x06, 0x10));
+    EXPECT_TRUE(m_queue.sendNow(MIDI_CC, 0x06, 0x10));
+    // All notes off
+    EXPECT_TRUE(m_queue.sendNow(MIDI_CC, 0x7B, 0x00));
+    EXPECT_TRUE(m_queue.sendNow(MIDI_CC, 0x7B, 0x00));
+    EXPECT_TRUE(m_queue.sendNow(MIDI_SYSTEM_RESET, 0xFF, 0xFF));
+    EXPECT_TRUE(m_queue.sendNow(MIDI_SYSTEM_RESET, 0xFF, 0xFF));
+    EXPECT_TRUE(m_queue.enqueue(MIDI_CC, 0x06, 0x10,
+                                MidiOutputQueue::Priority::High));
+    EXPECT_TRUE(m_queue.isEmpty());
+}
+
+TEST_F(MidiOutputQueueTest, Sysex) {
+    QByteArray sysex("\xF0\x00\x20\x29\x01\xF7", 6);
+    QByteArray otherSysex("\xF0\x00\x20\x29\x02\xF7", 6);
+    EXPECT_TRUE(m_queue.sendNow(sysex, true));
+    EXPECT_FALSE(m_queue.sendNow(sysex, true));
+    EXPECT_TRUE(m_queue.sendNow(otherSysex, true));
+    EXPECT_TRUE(m_queue.sendNow(sysex, true));
+
+    // Repeated identity requests are sent
+    QByteArray identityRequest("\xF0\x7E\x7F\x06\x01\xF7", 6);
+    EXPECT_TRUE(m_queue.sendNow(identityRequest, false));
+    EXPECT_TRUE(m_queue.sendNow(identityRequest, false));
+}
+
+TEST_F(MidiOutputQueueTest, SysexPerOutput) {
+    QByteArray firstLed("\xF0\x00\x20\x29\x10\x01\xF7", 7);
+    QByteArray secondLed("\xF0\x00\x20\x29\x11\x01\xF7", 7);
+    EXPECT_TRUE(m_queue.sendNow(firstLed, true));
+    EXPECT_TRUE(m_queue.sendNow(secondLed, true));
+    EXPECT_FALSE(m_queue.sendNow(firstLed, true));
+    EXPECT_FALSE(m_queue.sendNow(secondLed, true));
+
+    // Only suppressed on request
+    EXPECT_TRUE(m_queue.sendNow(firstLed, false));
+}
+
+TEST_F(MidiOutputQueueTest, SysexForgetsMessages) {
+    QByteArray sysex("\xF0\x00\x20\x29\x01\xF7", 6);
+    EXPECT_TRUE(m_queue.sendNow(MIDI_NOTE_ON, 0x10, 0x7F));
+    EXPECT_TRUE(m_queue.sendNow(sysex, true));
+    EXPECT_TRUE(m_queue.sendNow(MIDI_NOTE_ON, 0x10, 0x7F));
+    // A suppressed one doesn't
+    EXPECT_FALSE(m_queue.sendNow(sysex, true));
+    EXPECT_FALSE(m_queue.sendNow(MIDI_NOTE_ON, 0x10, 0x7F));
+
+    m_queue.forgetMessages();
+    EXPECT_TRUE(m_queue.sendNow(MIDI_NOTE_ON, 0x10, 0x7F));
+}
+
+TEST_F(MidiOutputQueueTest, ForgetsOutputsOfInput) {
+    EXPECT_TRUE(m_queue.sendNow(MIDI_NOTE_ON, 0x10, 0x7F));
+    m_queue.forget(MIDI_NOTE_OFF, 0x10);
+    EXPECT_TRUE(m_queue.sendNow(MIDI_NOTE_ON, 0x10, 0x7F));
+
+    EXPECT_TRUE(m_queue.sendNow(MIDI_CC, 0x20, 0x40));
+    m_queue.reset();
+    EXPECT_TRUE(m_queue.sendNow(MIDI_CC, 0x20, 0x40));
+}
+
+TEST_F(MidiOutputQueueTest, CoalescesQueuedMessages) {
+    m_queue.enqueue(MIDI_CC, 0x20, 0x01, MidiOutputQueue::Priority::Low);
+    m_queue.enqueue(MIDI_CC, 0x21, 0x01, MidiOutputQueue::Priority::High);
+    m_queue.enqueue(MIDI_CC, 0x20, 0x02, MidiOutputQueue::Priority::Low);
+    EXPECT_FALSE(m_queue.isEmpty());
+    EXPECT_EQ(QStringList() << "b0 21 01" << "b0 20 02", takeFrame());
+    EXPECT_TRUE(m_queue.isEmpty());
+
+    // Changed back before the next frame
+    m_queue.enqueue(MIDI_CC, 0x20, 0x03, MidiOutputQueue::Priority::Low);
+    m_queue.enqueue(MIDI_CC, 0x20, 0x02, MidiOutputQueue::Priority::Low);
+    EXPECT_TRUE(m_queue.isEmpty());
+    EXPECT_TRUE(takeFrame().isEmpty());
+
+    // A message that is sent right away replaces the queued one
+    m_queue.enqueue(MIDI_CC, 0x21, 0x02, MidiOutputQueue::Priority::High);
+    EXPECT_TRUE(m_queue.sendNow(MIDI_CC, 0x21, 0x03));
+    EXPECT_TRUE(m_queue.isEmpty());
+    EXPECT_TRUE(takeFrame().isEmpty());
+    m_queue.enqueue(MIDI_CC, 0x21, 0x04, MidiOutputQueue::Priority::High);
+    EXPECT_EQ(QStringList() << "b0 21 04", takeFrame());
+
+    EXPECT_EQ(4, m_queue.takeSentCount());
+    EXPECT_EQ(4, m_queue.takeSuppressedCount());
+}
+
+TEST_F(MidiOutputQueueTest, LimitsMessagesPerFrame) {
+    m_queue.setMaxMessagesPerFrame(2);
+    m_queue.enqueue(MIDI_CC, 0x20, 0x01, MidiOutputQueue::Priority::Low);
+    m_queue.enqueue(MIDI_CC, 0x21, 0x01, MidiOutputQueue::Priority::Low);
+    m_queue.enqueue(MIDI_NOTE_ON, 0x10, 0x7F, MidiOutputQueue::Priority::High);
+    m_queue.enqueue(MIDI_NOTE_ON, 0x11, 0x7F, MidiOutputQueue::Priority::High);
+    m_queue.enqueue(MIDI_NOTE_ON, 0x12, 0x7F, MidiOutputQueue::Priority::High);
+
+    // High priority first, in order
+    EXPECT_EQ(QStringList() << "90 10 7f" << "90 11 7f", takeFrame());
+    // Meters are sent with their latest value
+    m_queue.enqueue(MIDI_CC, 0x20, 0x02, MidiOutputQueue::Priority::Low);
+    EXPECT_EQ(QStringList() << "90 12 7f" << "b0 20 02", takeFrame());
+    EXPECT_EQ(QStringList() << "b0 21 01", takeFrame());
+    EXPECT_TRUE(m_queue.isEmpty());
+}
+
+}  // namespace
@@ -5,6 +5,8 @@
 
 #include "controllers/midi/portmidicontroller.h"
 #include "controllers/midi/portmididevice.h"
+#include "control/controlpotmeter.h"
+#include "control/controlpushbutton.h"
 #include "test/mixxxtest.h"
 
 using ::testing::_;
@@ -235,6 +237,98 @@ TEST_F(PortMidiControllerTest, Poll_Read_Basic) {
     pollDevice();
 };
 
+TEST_F(PortMidiControllerTest, Poll_Read_CoalescesAbsoluteControlChanges) {
+    ControlPotmeter volume(ConfigKey("[Channel1]", "volume"));
+    MidiControllerPreset preset;
+    MidiKey faderKey(0xB0, 0x10);
+    preset.inputMappings.insertMulti(faderKey.key, MidiInputMapping(
+            faderKey, MidiOptions(), ConfigKey("[Channel1]", "volume")));
+    MidiKey jogKey(0xB0, 0x11);
+    MidiOptions scriptOptions;
+    scriptOptions.script = true;
+    preset.inputMappings.insertMulti(jogKey.key, MidiInputMapping(
+            jogKey, scriptOptions, ConfigKey("[Channel1]", "jog")));
+    m_pController->visit(&preset);
+
+    std::vector<PmEvent> messages;
+    messages.push_back(MakeEvent(0x0110B0, 0x0));
+    messages.push_back(MakeEvent(0x0210B0, 0x1));
+    messages.push_back(MakeEvent(0x0111B0, 0x1));
+    messages.push_back(MakeEvent(0x0111B0, 0x2));
+    messages.push_back(MakeEvent(0x0310B0, 0x2));
+    messages.push_back(MakeEvent(0x0410B0, 0x3));
+
+    Sequence read;
+    EXPECT_CALL(*m_mockInput, isOpen())
+            .WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mockInput, poll())
+            .InSequence(read)
+            .WillOnce(Return((PmError)TRUE));
+    EXPECT_CALL(*m_mockInput, read(NotNull(), _))
+            .InSequence(read)
+            .WillOnce(DoAll(SetArrayArgument<0>(messages.begin(), messages.end()),
+                            Return(messages.size())));
+
+    // Only the last of consecutive values of the fader is processed, the
+    // script sees every message.
+    EXPECT_CALL(*m_pController, receive(0xB0, 0x10, 0x02, _))
+            .InSequence(read);
+    EXPECT_CALL(*m_pController, receive(0xB0, 0x11, 0x01, _))
+            .Times(2)
+            .InSequence(read);
+    EXPECT_CALL(*m_pController, receive(0xB0, 0x10, 0x04, _))
+            .InSequence(read);
+
+    pollDevice();
+};
+
+TEST_F(PortMidiControllerTest, Poll_Read_DoesNotCoalesceButtons) {
+    ControlPushButton play(ConfigKey("[Channel1]", "play"));
+    ControlPotmeter volume(ConfigKey("[Channel1]", "volume"));
+    MidiControllerPreset preset;
+    MidiKey buttonKey(0xB0, 0x20);
+    preset.inputMappings.insertMulti(buttonKey.key, MidiInputMapping(
+            buttonKey, MidiOptions(), ConfigKey("[Channel1]", "play")));
+    MidiKey faderKey(0xB0, 0x10);
+    preset.inputMappings.insertMulti(faderKey.key, MidiInputMapping(
+            faderKey, MidiOptions(), ConfigKey("[Channel1]", "volume")));
+    m_pController->visit(&preset);
+
+    std::vector<PmEvent> messages;
+    // A press and a release of a button that is mapped without options
+    messages.push_back(MakeEvent(0x7F20B0, 0x0));
+    messages.push_back(MakeEvent(0x0020B0, 0x1));
+    // A fader that is moved to 0 and back
+    messages.push_back(MakeEvent(0x0210B0, 0x2));
+    messages.push_back(MakeEvent(0x0010B0, 0x3));
+    messages.push_back(MakeEvent(0x0110B0, 0x4));
+    messages.push_back(MakeEvent(0x0210B0, 0x5));
+
+    Sequence read;
+    EXPECT_CALL(*m_mockInput, isOpen())
+            .WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mockInput, poll())
+            .InSequence(read)
+            .WillOnce(Return((PmError)TRUE));
+    EXPECT_CALL(*m_mockInput, read(NotNull(), _))
+            .InSequence(read)
+            .WillOnce(DoAll(SetArrayArgument<0>(messages.begin(), messages.end()),
+                            Return(messages.size())));
+
+    EXPECT_CALL(*m_pController, receive(0xB0, 0x20, 0x7F, _))
+            .InSequence(read);
+    EXPECT_CALL(*m_pController, receive(0xB0, 0x20, 0x00, _))
+            .InSequence(read);
+    EXPECT_CALL(*m_pController, receive(0xB0, 0x10, 0x02, _))
+            .InSequence(read);
+    EXPECT_CALL(*m_pController, receive(0xB0, 0x10, 0x00, _))
+            .InSequence(read);
+    EXPECT_CALL(*m_pController, receive(0xB0, 0x10, 0x02, _))
+            .InSequence(read);
+
+    pollDevice();
+};
+
 TEST_F(PortMidiControllerTest, Poll_Read_SysExWithRealtime) {
     std::vector<PmEvent> messages;
     messages.push_back(MakeEvent(0x332211F0, 0x0));
@@ -177,3 +177,34 @@ TEST_F(ReadAheadManagerTest, FractionalFrameLoop) {
     // The rounding error must not exceed a half frame (one samples in stereo)
     EXPECT_NEAR(16, m_pReadAheadManager->getPlaypos(), 1);
 }
+
+TEST_F(ReadAheadManagerTest, HintReverseWindow) {
+    const SINT kFrame = 3 * CachingReaderChunk::kFrames;
+    m_pReadAheadManager->notifySeek(CachingReaderChunk::frames2samples(kFrame));
+
+    HintVector hints;
+    m_pReadAheadManager->hintReader(1.0, &hints);
+    ASSERT_EQ(2, hints.size());
+    EXPECT_EQ(Hint::kPriorityImminent, hints[0].priority);
+    EXPECT_EQ(kFrame, hints[0].frame);
+    // The chunk behind the play position is kept for scratching backwards
+    EXPECT_EQ(Hint::kPriorityReverse, hints[1].priority);
+    EXPECT_EQ(kFrame - CachingReaderChunk::kFrames, hints[1].frame);
+    EXPECT_EQ(CachingReaderChunk::kFrames, hints[1].frameCount);
+
+    hints.clear();
+    m_pReadAheadManager->hintReader(-1.0, &hints);
+    ASSERT_EQ(2, hints.size());
+    EXPECT_EQ(Hint::kPriorityImminent, hints[0].priority);
+    EXPECT_EQ(Hint::kPriorityReverse, hints[1].priority);
+    EXPECT_EQ(kFrame, hints[1].frame);
+}
+
+TEST_F(ReadAheadManagerTest, HintReverseWindowAtTrackStart) {
+    m_pReadAheadManager->notifySeek(0);
+    HintVector hints;
+    m_pReadAheadManager->hintReader(1.0, &hints);
+    // Nothing to read before the start of the track
+    ASSERT_EQ(1, hints.size());
+    EXPECT_EQ(Hint::kPriorityImminent, hints[0].priority);
+}
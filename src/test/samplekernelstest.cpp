@@ -0,0 +1,265 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+#include "util/sample.h"
+#include "util/samplekernels.h"
+
+using mixxx::SampleKernels;
+
+namespace {
+
+const int kNumChannels = 8;
+
+const SampleKernels::InstructionSet kInstructionSets[] = {
+    SampleKernels::InstructionSet::Scalar,
+    SampleKernels::InstructionSet::SSE2,
+    SampleKernels::InstructionSet::AVX,
+};
+
+// The vectorized kernels must produce the same results as the scalar kernels,
+// including the remaining samples that do not fill a whole register. Only
+// sums that are added up in a different order may differ by rounding.
+class SampleKernelsTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        // Odd frame counts to cover the scalar tails of all kernels
+        m_sizes = {2, 6, 14, 30, 1022};
+        for (int j = 0; j < kNumChannels; ++j) {
+            std::vector<CSAMPLE> channel(kMaxSize);
+            for (int i = 0; i < kMaxSize; ++i) {
+                // Deterministic samples in the range [-2.0, 2.0] to
+                // also cover clipping
+                channel[i] = CSAMPLE(((i * 37 + j * 101) % 401) - 200) / 100.0f;
+            }
+            m_channels.push_back(channel);
+            m_gain.push_back(0.1f * (j + 1));
+            m_startGain.push_back(1.0f - 0.1f * j);
+            m_gainDelta.push_back(0.001f * (j - kNumChannels / 2));
+        }
+        for (const auto& channel: m_channels) {
+            m_pChannels.push_back(channel.data());
+        }
+    }
+
+    static const int kMaxSize = 1024;
+
+    std::vector<int> m_sizes;
+    std::vector<std::vector<CSAMPLE>> m_channels;
+    std::vector<const CSAMPLE*> m_pChannels;
+    std::vector<CSAMPLE_GAIN> m_gain;
+    std::vector<CSAMPLE_GAIN> m_startGain;
+    std::vector<CSAMPLE_GAIN> m_gainDelta;
+};
+
+// EXPECT_FLOAT_EQ would allow a difference of 4 ULP.
+void expectBitExact(const std::vector<CSAMPLE>& expected,
+        const std::vector<CSAMPLE>& actual,
+        SampleKernels::InstructionSet instructionSet) {
+    ASSERT_EQ(expected.size(), actual.size());
+    EXPECT_EQ(0, memcmp(expected.data(), actual.data(),
+            expected.size() * sizeof(CSAMPLE)))
+            << SampleKernels::instructionSetName(instructionSet);
+}
+
+TEST_F(SampleKernelsTest, scalarIsAlwaysSupported) {
+    EXPECT_TRUE(SampleKernels::isSupported(SampleKernels::InstructionSet::Scalar));
+    EXPECT_TRUE(SampleKernels::isSupported(SampleKernels::detectInstructionSet()));
+}
+
+TEST_F(SampleKernelsTest, rampingGainMatchesScalar) {
+    const SampleKernels& scalar = SampleKernels::forInstructionSet(
+            SampleKernels::InstructionSet::Scalar);
+    for (auto instructionSet: kInstructionSets) {
+        const SampleKernels& kernels = SampleKernels::forInstructionSet(instructionSet);
+        for (int size: m_sizes) {
+            std::vector<CSAMPLE> expected(size, 0.5f);
+            std::vector<CSAMPLE> actual(size, 0.5f);
+            scalar.addWithRampingGain(expected.data(), m_pChannels[0],
+                    0.3f, 0.01f, size / 2);
+            kernels.addWithRampingGain(actual.data(), m_pChannels[0],
+                    0.3f, 0.01f, size / 2);
+            expectBitExact(expected, actual, instructionSet);
+            scalar.copyWithRampingGain(expected.data(), m_pChannels[1],
+                    1.0f, -0.02f, size / 2);
+            kernels.copyWithRampingGain(actual.data(), m_pChannels[1],
+                    1.0f, -0.02f, size / 2);
+            expectBitExact(expected, actual, instructionSet);
+        }
+    }
+}
+
+TEST_F(SampleKernelsTest, multipleWithGainMatchesScalar) {
+    const SampleKernels& scalar = SampleKernels::forInstructionSet(
+            SampleKernels::InstructionSet::Scalar);
+    for (auto instructionSet: kInstructionSets) {
+        const SampleKernels& kernels = SampleKernels::forInstructionSet(instructionSet);
+        for (int size: m_sizes) {
+            for (int numChannels = 1; numChannels <= kNumChannels; ++numChannels) {
+                std::vector<CSAMPLE> expected(size);
+                std::vector<CSAMPLE> actual(size);
+                scalar.copyMultipleWithGain(expected.data(), m_pChannels.data(),
+                        m_gain.data(), numChannels, size);
+                kernels.copyMultipleWithGain(actual.data(), m_pChannels.data(),
+                        m_gain.data(), numChannels, size);
+                expectBitExact(expected, actual, instructionSet);
+                scalar.copyMultipleWithRampingGain(expected.data(),
+                        m_pChannels.data(), m_startGain.data(),
+                        m_gainDelta.data(), numChannels, size / 2);
+                kernels.copyMultipleWithRampingGain(actual.data(),
+                        m_pChannels.data(), m_startGain.data(),
+                        m_gainDelta.data(), numChannels, size / 2);
+                expectBitExact(expected, actual, instructionSet);
+            }
+        }
+    }
+}
+
+TEST_F(SampleKernelsTest, clampAndSumAbsMatchScalar) {
+    const SampleKernels& scalar = SampleKernels::forInstructionSet(
+            SampleKernels::InstructionSet::Scalar);
+    for (auto instructionSet: kInstructionSets) {
+        const SampleKernels& kernels = SampleKernels::forInstructionSet(instructionSet);
+        for (int size: m_sizes) {
+            std::vector<CSAMPLE> expected(size);
+            std::vector<CSAMPLE> actual(size);
+            scalar.copyClamp(expected.data(), m_pChannels[2], size);
+            kernels.copyClamp(actual.data(), m_pChannels[2], size);
+            expectBitExact(expected, actual, instructionSet);
+            for (int i = 0; i < size; ++i) {
+                EXPECT_LE(fabs(actual[i]), CSAMPLE_PEAK);
+            }
+
+            CSAMPLE expectedSumL, expectedSumR, expectedPeakL, expectedPeakR;
+            CSAMPLE sumL, sumR, peakL, peakR;
+            scalar.sumAbsAndPeakPerChannel(m_pChannels[3], size / 2,
+                    &expectedSumL, &expectedSumR, &expectedPeakL, &expectedPeakR);
+            kernels.sumAbsAndPeakPerChannel(m_pChannels[3], size / 2,
+                    &sumL, &sumR, &peakL, &peakR);
+            // The partial sums are added up in a different order, so only
+            // the sums are compared with a tolerance.
+            EXPECT_NEAR(expectedSumL, sumL, 1e-5 * size)
+                    << SampleKernels::instructionSetName(instructionSet);
+            EXPECT_NEAR(expectedSumR, sumR, 1e-5 * size)
+                    << SampleKernels::instructionSetName(instructionSet);
+            EXPECT_EQ(expectedPeakL, peakL);
+            EXPECT_EQ(expectedPeakR, peakR);
+        }
+    }
+}
+
+TEST_F(SampleKernelsTest, sumAbsPerChannelDetectsClipping) {
+    std::vector<CSAMPLE> buffer(64, 0.5f);
+    CSAMPLE sumL, sumR;
+    EXPECT_EQ(SampleUtil::NO_CLIPPING, SampleUtil::sumAbsPerChannel(
+            &sumL, &sumR, buffer.data(), buffer.size()));
+    EXPECT_EQ(16.0f, sumL);
+    EXPECT_EQ(16.0f, sumR);
+    // Clipping in the scalar tail of the left channel: 31 frames leave one
+    // frame after the last whole SSE2 register.
+    buffer[60] = -1.5f;
+    EXPECT_EQ(SampleUtil::CLIPPING_LEFT, SampleUtil::sumAbsPerChannel(
+            &sumL, &sumR, buffer.data(), buffer.size() - 2));
+    EXPECT_EQ(SampleUtil::CLIPPING_LEFT, SampleUtil::sumAbsPerChannel(
+            &sumL, &sumR, buffer.data(), buffer.size()));
+    buffer[1] = 1.1f;
+    EXPECT_EQ(SampleUtil::CLIPPING_LEFT | SampleUtil::CLIPPING_RIGHT,
+            SampleUtil::sumAbsPerChannel(
+                    &sumL, &sumR, buffer.data(), buffer.size()));
+}
+
+TEST_F(SampleKernelsTest, copyMultipleWithGainMatchesCopyNWithGain) {
+    const int size = 1024;
+    std::vector<CSAMPLE> expected(size);
+    std::vector<CSAMPLE> actual(size);
+    SampleUtil::copy4WithGain(expected.data(),
+            m_pChannels[0], m_gain[0], m_pChannels[1], m_gain[1],
+            m_pChannels[2], m_gain[2], m_pChannels[3], m_gain[3], size);
+    SampleUtil::copyMultipleWithGain(actual.data(), m_pChannels.data(),
+            m_gain.data(), 4, size);
+    expectBitExact(expected, actual, SampleKernels::detectInstructionSet());
+}
+
+// Arguments: buffer size in samples, instruction set
+static void BM_CopyMultipleWithRampingGain(benchmark::State& state) {
+    const int size = state.range_x();
+    const auto instructionSet =
+            static_cast<SampleKernels::InstructionSet>(state.range_y());
+    if (!SampleKernels::isSupported(instructionSet)) {
+        state.SetLabel("unsupported");
+        while (state.KeepRunning()) {
+        }
+        return;
+    }
+    state.SetLabel(SampleKernels::instructionSetName(instructionSet));
+    const SampleKernels& kernels = SampleKernels::forInstructionSet(instructionSet);
+
+    std::vector<CSAMPLE*> buffers;
+    std::vector<CSAMPLE_GAIN> startGain;
+    std::vector<CSAMPLE_GAIN> gainDelta;
+    for (int j = 0; j < kNumChannels; ++j) {
+        CSAMPLE* buffer = SampleUtil::alloc(size);
+        SampleUtil::fill(buffer, 0.1f * j, size);
+        buffers.push_back(buffer);
+        startGain.push_back(1.0f);
+        gainDelta.push_back(-1.0f / size);
+    }
+    CSAMPLE* pOutput = SampleUtil::alloc(size);
+
+    while (state.KeepRunning()) {
+        kernels.copyMultipleWithRampingGain(pOutput, buffers.data(),
+                startGain.data(), gainDelta.data(), kNumChannels, size / 2);
+    }
+    state.SetItemsProcessed(state.iterations() * size * kNumChannels);
+
+    SampleUtil::free(pOutput);
+    for (CSAMPLE* buffer: buffers) {
+        SampleUtil::free(buffer);
+    }
+}
+BENCHMARK(BM_CopyMultipleWithRampingGain)
+        ->ArgPair(128, static_cast<int>(SampleKernels::InstructionSet::Scalar))
+        ->ArgPair(128, static_cast<int>(SampleKernels::InstructionSet::SSE2))
+        ->ArgPair(128, static_cast<int>(SampleKernels::InstructionSet::AVX))
+        ->ArgPair(1024, static_cast<int>(SampleKernels::InstructionSet::Scalar))
+        ->ArgPair(1024, static_cast<int>(SampleKernels::InstructionSet::SSE2))
+        ->ArgPair(1024, static_cast<int>(SampleKernels::InstructionSet::AVX));
+
+// Arguments: buffer size in samples, instruction set
+static void BM_AddWithRampingGain(benchmark::State& state) {
+    const int size = state.range_x();
+    const auto instructionSet =
+            static_cast<SampleKernels::InstructionSet>(state.range_y());
+    if (!SampleKernels::isSupported(instructionSet)) {
+        state.SetLabel("unsupported");
+        while (state.KeepRunning()) {
+        }
+        return;
+    }
+    state.SetLabel(SampleKernels::instructionSetName(instructionSet));
+    const SampleKernels& kernels = SampleKernels::forInstructionSet(instructionSet);
+
+    CSAMPLE* pInput = SampleUtil::alloc(size);
+    SampleUtil::fill(pInput, 0.5f, size);
+    CSAMPLE* pOutput = SampleUtil::alloc(size);
+    SampleUtil::clear(pOutput, size);
+
+    while (state.KeepRunning()) {
+        kernels.addWithRampingGain(pOutput, pInput, 0.0f, 2.0f / size, size / 2);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+
+    SampleUtil::free(pOutput);
+    SampleUtil::free(pInput);
+}
+BENCHMARK(BM_AddWithRampingGain)
+        ->ArgPair(128, static_cast<int>(SampleKernels::InstructionSet::Scalar))
+        ->ArgPair(128, static_cast<int>(SampleKernels::InstructionSet::SSE2))
+        ->ArgPair(128, static_cast<int>(SampleKernels::InstructionSet::AVX))
+        ->ArgPair(1024, static_cast<int>(SampleKernels::InstructionSet::Scalar))
+        ->ArgPair(1024, static_cast<int>(SampleKernels::InstructionSet::SSE2))
+        ->ArgPair(1024, static_cast<int>(SampleKernels::InstructionSet::AVX));
+
+}  // namespace
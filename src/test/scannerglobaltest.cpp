@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <QDateTime>
+
+#include "library/scanner/scannerglobal.h"
+
+namespace {
+
+class ScannerGlobalTest : public testing::Test {
+  protected:
+    ScannerGlobalTest() {
+        m_directoryHashes["/music"] = 1;
+        m_directoryHashes["/music/a"] = 2;
+        m_directoryHashes["/music/b"] = 3;
+        m_directoryHashes["/music/a/c"] = 4;
+    }
+
+    ScannerGlobalPointer scannerGlobal(
+            const QHash<QString, qint64>& directoryModificationTimes) const {
+        return ScannerGlobalPointer(new ScannerGlobal(
+                QSet<QString>(), m_directoryHashes, directoryModificationTimes,
+                QRegExp(), QRegExp(), QStringList()));
+    }
+
+    QHash<QString, int> m_directoryHashes;
+};
+
+TEST_F(ScannerGlobalTest, FullScan) {
+    ScannerGlobalPointer pGlobal = scannerGlobal(QHash<QString, qint64>());
+    EXPECT_FALSE(pGlobal->directoryUnmodified("/music", 1000));
+    EXPECT_TRUE(pGlobal->knownSubdirectories("/music").isEmpty());
+}
+
+TEST_F(ScannerGlobalTest, UnmodifiedDirectories) {
+    QHash<QString, qint64> modificationTimes;
+    modificationTimes["/music"] = 1000;
+    modificationTimes["/music/unhashed"] = 1000;
+    ScannerGlobalPointer pGlobal = scannerGlobal(modificationTimes);
+
+    EXPECT_TRUE(pGlobal->directoryUnmodified("/music", 1000));
+    EXPECT_FALSE(pGlobal->directoryUnmodified("/music", 2000));
+    EXPECT_FALSE(pGlobal->directoryUnmodified("/music/a", 1000));
+    EXPECT_FALSE(pGlobal->directoryUnmodified("/music/unhashed", 1000));
+    EXPECT_FALSE(pGlobal->directoryUnmodified("/music", -1));
+
+    QStringList subdirectories = pGlobal->knownSubdirectories("/music");
+    subdirectories.sort();
+    EXPECT_EQ(QStringList() << "/music/a" << "/music/b", subdirectories);
+    EXPECT_EQ(QStringList() << "/music/a/c",
+            pGlobal->knownSubdirectories("/music/a"));
+}
+
+TEST_F(ScannerGlobalTest, RecentModificationTimesAreNotRecorded) {
+    ScannerGlobalPointer pGlobal = scannerGlobal(QHash<QString, qint64>());
+    pGlobal->directoryListed("/music/a", 1000);
+    pGlobal->directoryListed("/music/b", QDateTime::currentMSecsSinceEpoch());
+    EXPECT_EQ(1000, pGlobal->listedDirectories().value("/music/a"));
+    EXPECT_EQ(-1, pGlobal->listedDirectories().value("/music/b"));
+}
+
+}  // namespace
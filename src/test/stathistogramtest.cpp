@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include "util/stat.h"
+#include "util/stathistogram.h"
+
+namespace {
+
+TEST(StatHistogramTest, BucketContainsValue) {
+    const double values[] = { 1e-6, 0.001, 0.5, 1.0, 1.5, 3.0, 1000.0,
+            123456.789, 1e12 };
+    for (double value : values) {
+        const int bucket = StatHistogram::bucketForValue(value);
+        const double lower = StatHistogram::bucketLowerBound(bucket);
+        const double upper = StatHistogram::bucketUpperBound(bucket);
+        EXPECT_LE(lower, value) << value;
+        EXPECT_GT(upper, value) << value;
+        // The bucket width is bounded relative to the value
+        EXPECT_LE(upper - lower,
+                value / StatHistogram::kSubBuckets + 1e-12) << value;
+    }
+}
+
+TEST(StatHistogramTest, OutOfRangeValues) {
+    EXPECT_EQ(0, StatHistogram::bucketForValue(0.0));
+    EXPECT_EQ(0, StatHistogram::bucketForValue(-1.0));
+    EXPECT_EQ(0, StatHistogram::bucketForValue(1e-9));
+    EXPECT_EQ(StatHistogram::kBucketCount - 1,
+            StatHistogram::bucketForValue(1e300));
+}
+
+TEST(StatHistogramTest, EmptyHistogram) {
+    StatHistogram histogram;
+    EXPECT_TRUE(histogram.isEmpty());
+    EXPECT_EQ(0, histogram.bucketCount());
+    EXPECT_EQ(0.0, histogram.valueAtQuantile(0.5));
+}
+
+TEST(StatHistogramTest, Quantiles) {
+    StatHistogram histogram;
+    for (int i = 1; i <= 1000; ++i) {
+        histogram.record(i);
+    }
+    EXPECT_FALSE(histogram.isEmpty());
+    EXPECT_EQ(1000.0, histogram.totalCount());
+    EXPECT_NEAR(500.0, histogram.valueAtQuantile(0.5), 500.0 / 16);
+    EXPECT_NEAR(990.0, histogram.valueAtQuantile(0.99), 990.0 / 16);
+    EXPECT_NEAR(1000.0, histogram.valueAtQuantile(1.0), 1000.0 / 16);
+    EXPECT_LE(1000.0, histogram.valueAtQuantile(1.0));
+}
+
+TEST(StatHistogramTest, OutlierOnlyAffectsTail) {
+    StatHistogram histogram;
+    histogram.record(1.0, 999);
+    histogram.record(1000.0);
+    EXPECT_GT(1.1, histogram.valueAtQuantile(0.99));
+    EXPECT_LE(1000.0, histogram.valueAtQuantile(0.9999));
+}
+
+TEST(StatTest, RegisterTagReturnsStableIds) {
+    const Stat::Id id = Stat::registerTag(QString("StatTest tag"));
+    EXPECT_NE(Stat::kInvalidId, id);
+    EXPECT_EQ(id, Stat::registerTag(QString("StatTest tag")));
+    EXPECT_NE(id, Stat::registerTag(QString("StatTest other tag")));
+    EXPECT_EQ(QString("StatTest tag"), Stat::tagForId(id));
+}
+
+TEST(StatTest, RegisterTagWithArgument) {
+    const char* kKey = "StatTest key %1";
+    const Stat::Id id1 = Stat::registerTag(kKey, 1);
+    const Stat::Id id2 = Stat::registerTag(kKey, 2);
+    EXPECT_NE(id1, id2);
+    // Cached lookups return the same IDs as the initial registration
+    EXPECT_EQ(id1, Stat::registerTag(kKey, 1));
+    EXPECT_EQ(id2, Stat::registerTag(kKey, 2));
+    EXPECT_EQ(id1, Stat::registerTag(QString("StatTest key 1")));
+    EXPECT_EQ(QString("StatTest key 2"), Stat::tagForId(id2));
+
+    const Stat::Id id3 = Stat::registerTag(kKey, "three");
+    EXPECT_EQ(id3, Stat::registerTag(kKey, "three"));
+    EXPECT_EQ(QString("StatTest key three"), Stat::tagForId(id3));
+
+    const char* kPlainKey = "StatTest plain key";
+    const Stat::Id id4 = Stat::registerTag(kPlainKey,
+            static_cast<const char*>(nullptr));
+    EXPECT_EQ(id4, Stat::registerTag(QString(kPlainKey)));
+}
+
+TEST(StatTest, RegisterTagCachesByContents) {
+    char key[] = "StatTest buffer %1";
+    char arg[] = "first";
+    const Stat::Id first = Stat::registerTag(key, arg);
+    EXPECT_EQ(QString("StatTest buffer first"), Stat::tagForId(first));
+
+    // The same buffer with other contents must not hit the cached entry
+    qstrcpy(arg, "other");
+    const Stat::Id other = Stat::registerTag(key, arg);
+    EXPECT_NE(first, other);
+    EXPECT_EQ(QString("StatTest buffer other"), Stat::tagForId(other));
+
+    // Equal contents at another address hit the cached entry
+    const QByteArray copy("first");
+    EXPECT_EQ(first, Stat::registerTag(key, copy.constData()));
+}
+
+} // namespace
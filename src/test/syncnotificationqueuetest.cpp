@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <QStringList>
+#include <QThread>
+
+#include "engine/sync/syncnotificationqueue.h"
+
+namespace {
+
+class RecordingListener : public SyncableListener {
+  public:
+    void requestSyncMode(Syncable*, SyncMode mode) override {
+        m_calls << QString("requestSyncMode %1").arg(mode);
+    }
+    void requestEnableSync(Syncable*, bool enabled) override {
+        m_calls << QString("requestEnableSync %1").arg(enabled);
+    }
+    void notifyBpmChanged(Syncable*, double bpm, bool fileChanged) override {
+        m_calls << QString("notifyBpmChanged %1 %2").arg(bpm).arg(fileChanged);
+    }
+    void notifyInstantaneousBpmChanged(Syncable*, double bpm) override {
+        m_calls << QString("notifyInstantaneousBpmChanged %1").arg(bpm);
+    }
+    void notifyScratching(Syncable*, bool scratching) override {
+        m_calls << QString("notifyScratching %1").arg(scratching);
+    }
+    void notifyBeatDistanceChanged(Syncable*, double beatDistance) override {
+        m_calls << QString("notifyBeatDistanceChanged %1").arg(beatDistance);
+    }
+    void notifyPlaying(Syncable*, bool playing) override {
+        m_calls << QString("notifyPlaying %1").arg(playing);
+    }
+    void notifyTrackLoaded(Syncable*, double suggested_bpm) override {
+        m_calls << QString("notifyTrackLoaded %1").arg(suggested_bpm);
+    }
+
+    QStringList m_calls;
+};
+
+class NotifyingThread : public QThread {
+  public:
+    explicit NotifyingThread(SyncNotificationQueue* pQueue)
+            : m_pQueue(pQueue) {
+    }
+
+  protected:
+    void run() override {
+        m_pQueue->notifyPlaying(nullptr, true);
+    }
+
+  private:
+    SyncNotificationQueue* const m_pQueue;
+};
+
+class SyncNotificationQueueTest : public testing::Test {
+  protected:
+    SyncNotificationQueueTest()
+            : m_queue(&m_listener) {
+    }
+
+    RecordingListener m_listener;
+    SyncNotificationQueue m_queue;
+};
+
+TEST_F(SyncNotificationQueueTest, ForwardsImmediatelyWhenNotQueueing) {
+    m_queue.notifyBpmChanged(nullptr, 120.0, false);
+    m_queue.requestSyncMode(nullptr, SYNC_FOLLOWER);
+    EXPECT_EQ(QStringList()
+              << "notifyBpmChanged 120 0"
+              << "requestSyncMode 1",
+              m_listener.m_calls);
+}
+
+TEST_F(SyncNotificationQueueTest, QueuesUntilFlushed) {
+    m_queue.beginQueueing();
+    m_queue.notifyPlaying(nullptr, true);
+    m_queue.notifyBpmChanged(nullptr, 120.0, false);
+    // Repeated updates are merged
+    m_queue.notifyBpmChanged(nullptr, 121.0, false);
+    m_queue.notifyBpmChanged(nullptr, 122.0, true);
+    m_queue.requestEnableSync(nullptr, true);
+    m_queue.notifyTrackLoaded(nullptr, 128.0);
+    EXPECT_TRUE(m_listener.m_calls.isEmpty());
+
+    m_queue.flush();
+    EXPECT_EQ(QStringList()
+              << "notifyPlaying 1"
+              << "notifyBpmChanged 121 0"
+              << "notifyBpmChanged 122 1"
+              << "requestEnableSync 1"
+              << "notifyTrackLoaded 128",
+              m_listener.m_calls);
+
+    // Not queueing anymore
+    m_listener.m_calls.clear();
+    m_queue.notifyScratching(nullptr, true);
+    EXPECT_EQ(QStringList() << "notifyScratching 1", m_listener.m_calls);
+    m_queue.flush();
+    EXPECT_EQ(1, m_listener.m_calls.size());
+}
+
+TEST_F(SyncNotificationQueueTest, ForwardsFromOtherThreads) {
+    m_queue.beginQueueing();
+    NotifyingThread thread(&m_queue);
+    thread.start();
+    thread.wait();
+    EXPECT_EQ(QStringList() << "notifyPlaying 1", m_listener.m_calls);
+    m_queue.flush();
+}
+
+}  // namespace
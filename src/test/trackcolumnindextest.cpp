@@ -0,0 +1,230 @@
+#include <gtest/gtest.h>
+
+#include "test/librarytest.h"
+
+#include "library/basetrackcache.h"
+#include "library/searchqueryparser.h"
+#include "library/trackcolumnindex.h"
+
+namespace {
+
+QStringList indexColumns() {
+    return QStringList() << "id" << "artist" << "album" << "bpm"
+                         << "tracknumber" << "key_id";
+}
+
+class TrackColumnIndexTest : public testing::Test {
+  protected:
+    TrackColumnIndexTest()
+            : m_index(indexColumns()),
+              m_artist(m_index.columnIndex("artist")),
+              m_album(m_index.columnIndex("album")),
+              m_bpm(m_index.columnIndex("bpm")),
+              m_trackNumber(m_index.columnIndex("tracknumber")) {
+    }
+
+    int addRow(int id, const QVariant& artist, const QVariant& bpm) {
+        const int row = m_index.insertRow(TrackId(id));
+        m_index.setValue(row, m_artist, artist);
+        m_index.setValue(row, m_bpm, bpm);
+        return row;
+    }
+
+    TrackColumnIndex m_index;
+    const int m_artist;
+    const int m_album;
+    const int m_bpm;
+    const int m_trackNumber;
+};
+
+TEST_F(TrackColumnIndexTest, StoresTypedColumns) {
+    const int row = addRow(1, QString("Artist"), 128.5);
+    EXPECT_EQ(TrackColumnIndex::ColumnType::String, m_index.columnType(m_artist));
+    EXPECT_EQ(TrackColumnIndex::ColumnType::Number, m_index.columnType(m_bpm));
+    EXPECT_EQ(TrackColumnIndex::ColumnType::Null, m_index.columnType(m_album));
+    EXPECT_EQ(QVariant(QString("Artist")), m_index.value(row, m_artist));
+    EXPECT_EQ(QVariant(128.5), m_index.value(row, m_bpm));
+    EXPECT_FALSE(m_index.value(row, m_album).isValid());
+
+    // SQL NULL
+    m_index.setValue(row, m_artist, QVariant(QVariant::String));
+    EXPECT_FALSE(m_index.value(row, m_artist).isValid());
+}
+
+TEST_F(TrackColumnIndexTest, InternsStrings) {
+    const int row1 = addRow(1, QString("Björk"), 90.0);
+    const int row2 = addRow(2, QString("Björk"), 100.0);
+    const QVector<int>& stringIds = m_index.stringIds(m_artist);
+    EXPECT_EQ(stringIds[row1], stringIds[row2]);
+    EXPECT_EQ(1, m_index.stringCount());
+    EXPECT_EQ(QString("bjork"), m_index.foldedString(stringIds[row1]));
+}
+
+TEST_F(TrackColumnIndexTest, UnusedStringsAreReleased) {
+    const int row1 = addRow(1, QString("First"), 90.0);
+    const int row2 = addRow(2, QString("First"), 100.0);
+    const int firstId = m_index.stringIds(m_artist)[row1];
+
+    // Still referenced by the second row
+    m_index.setValue(row1, m_artist, QVariant(QString("Second")));
+    EXPECT_EQ(firstId, m_index.stringIds(m_artist)[row2]);
+    EXPECT_EQ(QString("First"), m_index.string(firstId));
+
+    m_index.setValue(row2, m_artist, QVariant(QString("Second")));
+    EXPECT_TRUE(m_index.string(firstId).isEmpty());
+    EXPECT_EQ(2, m_index.stringCount());
+
+    // The released ID is reused instead of growing the strings
+    m_index.setValue(row1, m_artist, QVariant(QString("Third")));
+    EXPECT_EQ(firstId, m_index.stringIds(m_artist)[row1]);
+    EXPECT_EQ(QString("third"), m_index.foldedString(firstId));
+    EXPECT_EQ(2, m_index.stringCount());
+
+    // Setting the same value again doesn't leak a reference
+    m_index.setValue(row1, m_artist, QVariant(QString("Third")));
+    m_index.removeRow(TrackId(1));
+    EXPECT_TRUE(m_index.string(firstId).isEmpty());
+}
+
+TEST_F(TrackColumnIndexTest, MixedTypesAreKept) {
+    const int row1 = addRow(1, QString("Artist"), 90.0);
+    const int row2 = addRow(2, QString("Artist"), QString("fast"));
+    EXPECT_EQ(TrackColumnIndex::ColumnType::Variant, m_index.columnType(m_bpm));
+    EXPECT_EQ(QVariant(90.0), m_index.value(row1, m_bpm));
+    EXPECT_EQ(QVariant(QString("fast")), m_index.value(row2, m_bpm));
+}
+
+TEST_F(TrackColumnIndexTest, RemovedRowsAreReused) {
+    addRow(1, QString("A"), 90.0);
+    const int row = addRow(2, QString("B"), 100.0);
+    m_index.removeRow(TrackId(2));
+    EXPECT_FALSE(m_index.contains(TrackId(2)));
+
+    EXPECT_EQ(row, m_index.insertRow(TrackId(3)));
+    EXPECT_EQ(TrackId(3), m_index.trackId(row));
+    EXPECT_FALSE(m_index.value(row, m_artist).isValid());
+    EXPECT_EQ(2, m_index.rowCount());
+}
+
+TEST_F(TrackColumnIndexTest, SortRanks) {
+    const int row1 = addRow(1, QString("beta"), 120.0);
+    const int row2 = addRow(2, QString("Alpha"), 90.0);
+    const int row3 = addRow(3, QVariant(), 120.0);
+    const int row4 = addRow(4, QString("alpha"), QVariant());
+
+    // NULL first, case-insensitive, equal values share a rank
+    const QVector<int> artistRanks = m_index.sortRanks(m_artist);
+    EXPECT_EQ(0, artistRanks[row3]);
+    EXPECT_EQ(artistRanks[row2], artistRanks[row4]);
+    EXPECT_LT(artistRanks[row3], artistRanks[row2]);
+    EXPECT_LT(artistRanks[row2], artistRanks[row1]);
+
+    const QVector<int> bpmRanks = m_index.sortRanks(m_bpm);
+    EXPECT_EQ(0, bpmRanks[row4]);
+    EXPECT_EQ(bpmRanks[row1], bpmRanks[row3]);
+    EXPECT_LT(bpmRanks[row2], bpmRanks[row1]);
+
+    // Ranks follow modifications
+    m_index.setValue(row2, m_bpm, 150.0);
+    EXPECT_LT(m_index.sortRanks(m_bpm)[row1], m_index.sortRanks(m_bpm)[row2]);
+}
+
+TEST_F(TrackColumnIndexTest, SortRanksOfTrackNumbers) {
+    m_index.setSortMode(m_trackNumber, TrackColumnIndex::SortMode::Integer);
+    const int row1 = m_index.insertRow(TrackId(1));
+    m_index.setValue(row1, m_trackNumber, QString("10"));
+    const int row2 = m_index.insertRow(TrackId(2));
+    m_index.setValue(row2, m_trackNumber, QString("9/12"));
+    EXPECT_LT(m_index.sortRanks(m_trackNumber)[row2],
+            m_index.sortRanks(m_trackNumber)[row1]);
+}
+
+TEST_F(TrackColumnIndexTest, SortableTracks) {
+    const int row1 = addRow(1, QString("b"), 120.0);
+    const int row2 = addRow(2, QString("a"), 90.0);
+    const int row3 = addRow(3, QString("b"), 90.0);
+
+    SortableTracks tracks;
+    tracks.trackIds << TrackId(1) << TrackId(2) << TrackId(3);
+    tracks.rows << row1 << row2 << row3;
+    EXPECT_EQ(tracks.trackIds, tracks.sort());
+
+    tracks.ordered = true;
+    tracks.sortRanks << m_index.sortRanks(m_artist) << m_index.sortRanks(m_bpm);
+    tracks.descending << true << false;
+    EXPECT_EQ(QVector<TrackId>() << TrackId(3) << TrackId(1) << TrackId(2),
+            tracks.sort());
+}
+
+class TrackColumnIndexQueryTest : public LibraryTest {
+  protected:
+    TrackColumnIndexQueryTest()
+            : m_parser(collection()),
+              m_index(indexColumns()) {
+        m_searchColumns << "artist" << "album";
+        addRow(QString("Foo Fighters"), QString("Bar"), 130.0);
+        addRow(QString("Café"), QVariant(QVariant::String), 90.0);
+        addRow(QString("Other"), QString("FOO"), QVariant());
+        addRow(QString("Other"), QVariant(QVariant::String), 120.0);
+        for (int row = 0; row < m_index.rowCount(); ++row) {
+            m_rows.append(row);
+        }
+    }
+
+    void addRow(const QVariant& artist, const QVariant& album,
+            const QVariant& bpm) {
+        const int row = m_index.insertRow(TrackId(m_index.rowCount() + 1));
+        m_index.setValue(row, m_index.columnIndex("artist"), artist);
+        m_index.setValue(row, m_index.columnIndex("album"), album);
+        m_index.setValue(row, m_index.columnIndex("bpm"), bpm);
+    }
+
+    // Returns the matching rows as a string of 0s and 1s
+    QString matchRows(const QString& query, const QString& extraFilter = QString()) {
+        auto pQuery = m_parser.parseQuery(query, m_searchColumns, extraFilter);
+        RowMatches matches(m_rows.size());
+        if (!pQuery->matchRows(m_index, m_rows, &matches)) {
+            return QString();
+        }
+        QString result;
+        for (int i = 0; i < m_rows.size(); ++i) {
+            result += matches.matching.testBit(i) ? "1" : "0";
+        }
+        return result;
+    }
+
+    SearchQueryParser m_parser;
+    TrackColumnIndex m_index;
+    QStringList m_searchColumns;
+    QVector<int> m_rows;
+};
+
+TEST_F(TrackColumnIndexQueryTest, EmptyQueryMatchesAll) {
+    EXPECT_QSTRING_EQ("1111", matchRows(""));
+}
+
+TEST_F(TrackColumnIndexQueryTest, Text) {
+    EXPECT_QSTRING_EQ("1010", matchRows("foo"));
+    EXPECT_QSTRING_EQ("0100", matchRows("cafe"));
+    EXPECT_QSTRING_EQ("0010", matchRows("foo other"));
+}
+
+TEST_F(TrackColumnIndexQueryTest, NegatedTextSkipsNull) {
+    // NOT (artist LIKE '%foo%' OR album LIKE '%foo%') is NULL, i.e. not
+    // matching, if one of them is NULL and the other doesn't match.
+    EXPECT_QSTRING_EQ("0000", matchRows("-foo"));
+    EXPECT_QSTRING_EQ("1000", matchRows("-other"));
+}
+
+TEST_F(TrackColumnIndexQueryTest, Numeric) {
+    EXPECT_QSTRING_EQ("1001", matchRows("bpm:>100"));
+    EXPECT_QSTRING_EQ("0101", matchRows("bpm:80-120"));
+    EXPECT_QSTRING_EQ("0100", matchRows("-bpm:>100"));
+}
+
+TEST_F(TrackColumnIndexQueryTest, SqlIsLeftToTheDatabase) {
+    EXPECT_TRUE(matchRows("foo", "bpm > 100").isNull());
+    EXPECT_TRUE(matchRows("fo_").isNull());
+}
+
+}  // namespace
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <QSqlQuery>
+
+#include "test/librarytest.h"
+
+#include "library/dao/tracksearchindex.h"
+#include "library/queryutil.h"
+#include "library/searchquery.h"
+
+namespace {
+
+class TrackSearchIndexTest : public LibraryTest {
+  protected:
+    TrackSearchIndexTest() {
+        QSqlQuery query(dbConnection());
+        EXPECT_TRUE(query.exec(
+                "CREATE TEMPORARY VIEW search_view AS "
+                "SELECT library.id, artist, album, track_locations.location "
+                "FROM library INNER JOIN track_locations "
+                "ON library.location = track_locations.id"));
+        m_searchColumns << "artist" << "album" << "location";
+        addTrack("Foo Fighters", "Bar", "/music/one.mp3");
+        addTrack("Café Tacuba", QVariant(), "/music/two.mp3");
+        addTrack("Other", "FOO\"d", "/music/fooo.mp3");
+    }
+
+    bool isAvailable() const {
+        if (!TrackSearchIndex::isAvailable(dbConnection())) {
+            qWarning() << "Skipping test, SQLite lacks FTS5 or the trigram tokenizer";
+            return false;
+        }
+        return true;
+    }
+
+    void addTrack(const QString& artist, const QVariant& album,
+            const QString& location) {
+        QSqlQuery query(dbConnection());
+        query.prepare("INSERT INTO track_locations (location) VALUES (:location)");
+        query.bindValue(":location", location);
+        if (!query.exec()) {
+            LOG_FAILED_QUERY(query);
+        }
+        const QVariant locationId = query.lastInsertId();
+        query.prepare("INSERT INTO library (artist, album, location) "
+                "VALUES (:artist, :album, :location)");
+        query.bindValue(":artist", artist);
+        query.bindValue(":album", album.isValid() ? album : QVariant(QVariant::String));
+        query.bindValue(":location", locationId);
+        if (!query.exec()) {
+            LOG_FAILED_QUERY(query);
+        }
+    }
+
+    // Returns the ids of the tracks that match the filter, in order
+    QString select(const QString& filter) {
+        QSqlQuery query(dbConnection());
+        if (!query.exec(QString("SELECT id FROM search_view WHERE %1 ORDER BY id")
+                .arg(filter))) {
+            LOG_FAILED_QUERY(query);
+            return QString("error");
+        }
+        QStringList ids;
+        while (query.next()) {
+            ids << query.value(0).toString();
+        }
+        return ids.join(",");
+    }
+
+    // Expects the same tracks with and without the index
+    void expectSameMatches(const QString& argument, const QString& expected) {
+        TextFilterNode likeNode(dbConnection(), m_searchColumns, argument);
+        TextFilterNode indexNode(dbConnection(), m_searchColumns, argument, "id");
+        EXPECT_QSTRING_EQ(expected, select(likeNode.toSql()));
+        EXPECT_QSTRING_EQ(expected, select(indexNode.toSql()));
+        EXPECT_QSTRING_EQ(select(QString("NOT (%1)").arg(likeNode.toSql())),
+                select(QString("NOT (%1)").arg(indexNode.toSql())));
+    }
+
+    QStringList m_searchColumns;
+};
+
+TEST_F(TrackSearchIndexTest, MatchesLikeComparisons) {
+    if (!isAvailable()) {
+        return;
+    }
+    expectSameMatches("foo", "1,3");
+    expectSameMatches("CAFE", "2");
+    expectSameMatches("ighter", "1");
+    expectSameMatches("o\"d", "3");
+    expectSameMatches("music/", "1,2,3");
+    expectSameMatches("nothing", "");
+}
+
+TEST_F(TrackSearchIndexTest, LeavesShortTermsToLike) {
+    TextFilterNode node(dbConnection(), m_searchColumns, "fo", "id");
+    EXPECT_TRUE(node.toSql().contains("LIKE"));
+    TextFilterNode wildcardNode(dbConnection(), m_searchColumns, "f%o", "id");
+    EXPECT_TRUE(wildcardNode.toSql().contains("LIKE"));
+    TextFilterNode yearNode(dbConnection(), QStringList() << "year", "2000", "id");
+    EXPECT_TRUE(yearNode.toSql().contains("LIKE"));
+}
+
+TEST_F(TrackSearchIndexTest, FollowsChanges) {
+    if (!isAvailable()) {
+        return;
+    }
+    QSqlQuery query(dbConnection());
+    EXPECT_TRUE(query.exec("UPDATE library SET artist='Bar Fighters' WHERE id=1"));
+    EXPECT_TRUE(query.exec(
+            "UPDATE track_locations SET location='/music/foo.mp3' WHERE id=2"));
+    EXPECT_TRUE(query.exec("DELETE FROM library WHERE id=3"));
+    expectSameMatches("foo", "2");
+    expectSameMatches("bar", "1");
+}
+
+TEST_F(TrackSearchIndexTest, RebuildsAfterUntrackedChanges) {
+    if (!isAvailable()) {
+        return;
+    }
+    // Modify the library like a version that doesn't know the index,
+    // without changing the number of tracks
+    QSqlQuery query(dbConnection());
+    EXPECT_TRUE(query.exec("DROP TRIGGER temp.library_fts_update"));
+    EXPECT_TRUE(query.exec("UPDATE library SET artist='Bar Fighters' WHERE id=1"));
+    EXPECT_TRUE(TrackSearchIndex::initialize(dbConnection()));
+    expectSameMatches("foo", "3");
+    expectSameMatches("bar", "1");
+}
+
+}  // namespace
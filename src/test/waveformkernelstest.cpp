@@ -0,0 +1,122 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "util/samplekernels.h"
+#include "waveform/waveformkernels.h"
+
+using mixxx::SampleKernels;
+using mixxx::WaveformKernels;
+
+namespace {
+
+const SampleKernels::InstructionSet kInstructionSets[] = {
+    SampleKernels::InstructionSet::Scalar,
+    SampleKernels::InstructionSet::SSE2,
+    SampleKernels::InstructionSet::AVX,
+};
+
+std::vector<WaveformData> makeWaveformData(int numFrames) {
+    std::vector<WaveformData> data(numFrames * 2);
+    for (int i = 0; i < numFrames * 2; ++i) {
+        data[i].filtered.low = (i * 37) % 256;
+        data[i].filtered.mid = (i * 101) % 251;
+        data[i].filtered.high = (i * 13 + 7) % 241;
+        data[i].filtered.all = (i * 53 + 11) % 256;
+    }
+    return data;
+}
+
+TEST(WaveformKernelsTest, maxPerChannelFindsMaximum) {
+    std::vector<WaveformData> data(6, WaveformData(0));
+    data[0].filtered.low = 10;   // left
+    data[3].filtered.mid = 20;   // right
+    data[4].filtered.high = 30;  // left
+    data[5].filtered.all = 40;   // right
+    for (auto instructionSet : kInstructionSets) {
+        const WaveformKernels& kernels =
+                WaveformKernels::forInstructionSet(instructionSet);
+        WaveformData maxLeft;
+        WaveformData maxRight;
+        kernels.maxPerChannel(data.data(), 3, &maxLeft, &maxRight);
+        EXPECT_EQ(10, maxLeft.filtered.low);
+        EXPECT_EQ(0, maxLeft.filtered.mid);
+        EXPECT_EQ(30, maxLeft.filtered.high);
+        EXPECT_EQ(0, maxLeft.filtered.all);
+        EXPECT_EQ(0, maxRight.filtered.low);
+        EXPECT_EQ(20, maxRight.filtered.mid);
+        EXPECT_EQ(0, maxRight.filtered.high);
+        EXPECT_EQ(40, maxRight.filtered.all);
+
+        kernels.maxPerChannel(data.data(), 0, &maxLeft, &maxRight);
+        EXPECT_EQ(0, maxLeft.m_i);
+        EXPECT_EQ(0, maxRight.m_i);
+    }
+}
+
+// The vectorized kernels must produce the same results as the scalar kernels,
+// including the remaining frames that do not fill a whole register.
+TEST(WaveformKernelsTest, maxPerChannelMatchesScalar) {
+    const std::vector<WaveformData> data = makeWaveformData(1024);
+    const WaveformKernels& scalarKernels = WaveformKernels::forInstructionSet(
+            SampleKernels::InstructionSet::Scalar);
+    for (int numFrames : {1, 2, 3, 5, 8, 33, 1023}) {
+        // Unaligned start
+        const WaveformData* pData = data.data() + 2;
+        WaveformData expectedLeft;
+        WaveformData expectedRight;
+        scalarKernels.maxPerChannel(pData, numFrames,
+                &expectedLeft, &expectedRight);
+        for (auto instructionSet : kInstructionSets) {
+            const WaveformKernels& kernels =
+                    WaveformKernels::forInstructionSet(instructionSet);
+            WaveformData maxLeft;
+            WaveformData maxRight;
+            kernels.maxPerChannel(pData, numFrames, &maxLeft, &maxRight);
+            EXPECT_EQ(expectedLeft.m_i, maxLeft.m_i)
+                    << SampleKernels::instructionSetName(instructionSet)
+                    << " " << numFrames;
+            EXPECT_EQ(expectedRight.m_i, maxRight.m_i)
+                    << SampleKernels::instructionSetName(instructionSet)
+                    << " " << numFrames;
+        }
+    }
+}
+
+// Arguments: visual frames per column, instruction set
+static void BM_MaxPerChannel(benchmark::State& state) {
+    const int framesPerColumn = state.range_x();
+    const auto instructionSet =
+            static_cast<SampleKernels::InstructionSet>(state.range_y());
+    if (!SampleKernels::isSupported(instructionSet)) {
+        state.SetLabel("unsupported");
+        while (state.KeepRunning()) {
+        }
+        return;
+    }
+    state.SetLabel(SampleKernels::instructionSetName(instructionSet));
+    const WaveformKernels& kernels =
+            WaveformKernels::forInstructionSet(instructionSet);
+    // One column per pixel of a wide waveform
+    const int kColumns = 1920;
+    const std::vector<WaveformData> data =
+            makeWaveformData(kColumns * framesPerColumn);
+    WaveformData maxLeft;
+    WaveformData maxRight;
+    while (state.KeepRunning()) {
+        for (int x = 0; x < kColumns; ++x) {
+            kernels.maxPerChannel(data.data() + x * framesPerColumn * 2,
+                    framesPerColumn, &maxLeft, &maxRight);
+        }
+        benchmark::DoNotOptimize(maxLeft.m_i + maxRight.m_i);
+    }
+    state.SetItemsProcessed(state.iterations() * kColumns);
+}
+BENCHMARK(BM_MaxPerChannel)
+        ->ArgPair(2, static_cast<int>(SampleKernels::InstructionSet::Scalar))
+        ->ArgPair(2, static_cast<int>(SampleKernels::InstructionSet::SSE2))
+        ->ArgPair(16, static_cast<int>(SampleKernels::InstructionSet::Scalar))
+        ->ArgPair(16, static_cast<int>(SampleKernels::InstructionSet::SSE2));
+
+}  // namespace
@@ -0,0 +1,213 @@
+#include <gtest/gtest.h>
+
+#include <QFile>
+#include <QTemporaryFile>
+
+#include <algorithm>
+#include <memory>
+
+#include "util/memory.h"
+#include "waveform/waveform.h"
+
+namespace {
+
+const int kSampleRate = 44100;
+const int kVisualSampleRate = 441;
+
+class WaveformTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        // Not a multiple of the texture stride
+        m_pWaveform = std::make_unique<Waveform>(
+                kSampleRate, 10 * 2 * kSampleRate + 1234, kVisualSampleRate, -1);
+        ASSERT_TRUE(m_pWaveform->isValid());
+        WaveformData* pData = m_pWaveform->data();
+        for (int i = 0; i < m_pWaveform->getDataSize(); ++i) {
+            pData[i].filtered.low = i % 251;
+            pData[i].filtered.mid = i % 241;
+            pData[i].filtered.high = i % 239;
+            pData[i].filtered.all = i % 233;
+        }
+        m_pWaveform->setCompletion(m_pWaveform->getDataSize());
+    }
+
+    void expectEqualMipLevels(const Waveform& waveform) {
+        ASSERT_EQ(m_pWaveform->getMipLevelCount(), waveform.getMipLevelCount());
+        for (int level = 1; level <= waveform.getMipLevelCount(); ++level) {
+            const int dataSize = waveform.getMipLevelDataSize(level);
+            ASSERT_EQ(m_pWaveform->getMipLevelDataSize(level), dataSize);
+            const WaveformData* pExpected = m_pWaveform->getMipLevelData(level);
+            const WaveformData* pActual = waveform.getMipLevelData(level);
+            for (int i = 0; i < dataSize; ++i) {
+                ASSERT_EQ(pExpected[i].m_i, pActual[i].m_i) << level << " " << i;
+            }
+        }
+    }
+
+    void expectEqualData(const Waveform& waveform) {
+        ASSERT_TRUE(waveform.isValid());
+        ASSERT_EQ(m_pWaveform->getDataSize(), waveform.getDataSize());
+        EXPECT_EQ(m_pWaveform->getTextureStride(), waveform.getTextureStride());
+        EXPECT_DOUBLE_EQ(m_pWaveform->getAudioVisualRatio(),
+                waveform.getAudioVisualRatio());
+        EXPECT_EQ(waveform.getDataSize(), waveform.getCompletion());
+        for (int i = 0; i < waveform.getDataSize(); ++i) {
+            ASSERT_EQ(m_pWaveform->get(i).m_i, waveform.get(i).m_i) << i;
+        }
+    }
+
+    QString writeTemporaryFile(const QByteArray& data) {
+        m_tempFile.open();
+        m_tempFile.write(data);
+        m_tempFile.close();
+        return m_tempFile.fileName();
+    }
+
+    std::unique_ptr<Waveform> m_pWaveform;
+    QTemporaryFile m_tempFile;
+};
+
+TEST_F(WaveformTest, ByteArrayRoundTrip) {
+    const QByteArray data = m_pWaveform->toByteArray();
+    EXPECT_TRUE(Waveform::isMappableData(data));
+    Waveform waveform(data);
+    expectEqualData(waveform);
+    EXPECT_FALSE(waveform.isMapped());
+    EXPECT_EQ(Waveform::SaveState::Saved, waveform.saveState());
+    // Copies are padded to a square texture
+    EXPECT_EQ(waveform.getTextureStride() * waveform.getTextureStride(),
+            waveform.getTextureSize());
+}
+
+TEST_F(WaveformTest, MappedFile) {
+    const QString fileName = writeTemporaryFile(m_pWaveform->toByteArray());
+    std::unique_ptr<Waveform> pWaveform(Waveform::createMapped(fileName));
+    expectEqualData(*pWaveform);
+#ifdef __WINDOWS__
+    // Read into memory, so the file can be replaced
+    EXPECT_FALSE(pWaveform->isMapped());
+#else
+    EXPECT_TRUE(pWaveform->isMapped());
+    // Only the rows with data are mapped
+    const int stride = pWaveform->getTextureStride();
+    EXPECT_EQ(0, pWaveform->getTextureSize() % stride);
+    EXPECT_LE(pWaveform->getDataSize(), pWaveform->getTextureSize());
+    EXPECT_GT(pWaveform->getDataSize() + stride, pWaveform->getTextureSize());
+#endif
+}
+
+TEST_F(WaveformTest, MappedFileCanBeReplaced) {
+    const QString fileName = writeTemporaryFile(m_pWaveform->toByteArray());
+    std::unique_ptr<Waveform> pWaveform(Waveform::createMapped(fileName));
+    ASSERT_TRUE(pWaveform->isValid());
+    // Like AnalysisDao::saveDataToFile()
+    QFile tempFile(fileName + ".tmp");
+    ASSERT_TRUE(tempFile.open(QIODevice::WriteOnly));
+    tempFile.write(m_pWaveform->toByteArray());
+    tempFile.close();
+    EXPECT_TRUE(QFile::remove(fileName));
+    EXPECT_TRUE(tempFile.rename(fileName));
+    expectEqualData(*pWaveform);
+}
+
+TEST_F(WaveformTest, CorruptDataIsInvalid) {
+    QByteArray data = m_pWaveform->toByteArray();
+    EXPECT_NE(0u, Waveform::mappableChecksum(data));
+    EXPECT_EQ(Waveform::mappableChecksum(data), Waveform::mappableChecksum(
+            data.left(Waveform::kMappableHeaderSize)));
+    data[data.size() / 2] = data[data.size() / 2] + 1;
+
+    Waveform waveform(data);
+    EXPECT_FALSE(waveform.isValid());
+    const QString fileName = writeTemporaryFile(data);
+    std::unique_ptr<Waveform> pWaveform(Waveform::createMapped(fileName));
+    EXPECT_FALSE(pWaveform->isValid());
+    EXPECT_FALSE(pWaveform->isMapped());
+}
+
+TEST_F(WaveformTest, TruncatedFileIsInvalid) {
+    QByteArray data = m_pWaveform->toByteArray();
+    data.chop(1);
+    const QString fileName = writeTemporaryFile(data);
+    std::unique_ptr<Waveform> pWaveform(Waveform::createMapped(fileName));
+    EXPECT_FALSE(pWaveform->isValid());
+    EXPECT_FALSE(pWaveform->isMapped());
+}
+
+TEST_F(WaveformTest, DataChecksumFollowsContents) {
+    const quint32 checksum = m_pWaveform->computeDataChecksum();
+    Waveform waveform(m_pWaveform->toByteArray());
+    EXPECT_EQ(checksum, waveform.computeDataChecksum());
+    m_pWaveform->data()[0].filtered.all += 1;
+    EXPECT_NE(checksum, m_pWaveform->computeDataChecksum());
+}
+
+TEST_F(WaveformTest, MissingFileIsInvalid) {
+    std::unique_ptr<Waveform> pWaveform(
+            Waveform::createMapped(QString("/nonexistent/waveform")));
+    EXPECT_FALSE(pWaveform->isValid());
+}
+
+TEST_F(WaveformTest, LegacyDataIsNotMappable) {
+    EXPECT_FALSE(Waveform::isMappableData(QByteArray()));
+    EXPECT_FALSE(Waveform::isMappableData(QByteArray("\x0d\x00\x00", 3)));
+}
+
+TEST_F(WaveformTest, MipLevelsHoldMaximum) {
+    EXPECT_EQ(0, m_pWaveform->getMipLevelCount());
+    m_pWaveform->buildMipLevels();
+    const int levelCount = m_pWaveform->getMipLevelCount();
+    ASSERT_EQ(Waveform::mipLevelCountForSize(m_pWaveform->getDataSize()),
+            levelCount);
+    ASSERT_LT(0, levelCount);
+
+    for (int level = 1; level <= levelCount; ++level) {
+        const int sourceSize = m_pWaveform->getMipLevelDataSize(level - 1);
+        const WaveformData* pSource = m_pWaveform->getMipLevelData(level - 1);
+        const int dataSize = m_pWaveform->getMipLevelDataSize(level);
+        const WaveformData* pData = m_pWaveform->getMipLevelData(level);
+        EXPECT_EQ(0, dataSize % 2);
+        EXPECT_LE(sourceSize, 2 * dataSize);
+        EXPECT_GT(sourceSize, 2 * dataSize - 4);
+        for (int i = 0; i < dataSize; ++i) {
+            // Each frame covers two frames of the same channel one level up
+            const int first = 2 * i - i % 2;
+            const int second = first + 2 < sourceSize ? first + 2 : first;
+            ASSERT_EQ(std::max(pSource[first].filtered.low,
+                            pSource[second].filtered.low),
+                    pData[i].filtered.low) << level << " " << i;
+            ASSERT_EQ(std::max(pSource[first].filtered.high,
+                            pSource[second].filtered.high),
+                    pData[i].filtered.high) << level << " " << i;
+            ASSERT_EQ(std::max(pSource[first].filtered.all,
+                            pSource[second].filtered.all),
+                    pData[i].filtered.all) << level << " " << i;
+        }
+    }
+    EXPECT_LE(Waveform::kMinMipLevelFrames,
+            m_pWaveform->getMipLevelDataSize(levelCount) / 2);
+}
+
+TEST_F(WaveformTest, MipLevelsRoundTrip) {
+    m_pWaveform->buildMipLevels();
+    ASSERT_LT(0, m_pWaveform->getMipLevelCount());
+    const QByteArray data = m_pWaveform->toByteArray();
+
+    Waveform waveform(data);
+    expectEqualData(waveform);
+    expectEqualMipLevels(waveform);
+
+    const QString fileName = writeTemporaryFile(data);
+    std::unique_ptr<Waveform> pWaveform(Waveform::createMapped(fileName));
+    ASSERT_TRUE(pWaveform->isValid());
+    expectEqualMipLevels(*pWaveform);
+}
+
+TEST_F(WaveformTest, MipLevelsAreBuiltWhenMissing) {
+    // Data stored without mip levels gets them on load
+    Waveform waveform(m_pWaveform->toByteArray());
+    m_pWaveform->buildMipLevels();
+    expectEqualMipLevels(waveform);
+}
+
+} // namespace
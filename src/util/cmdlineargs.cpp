@@ -9,6 +9,7 @@
 CmdlineArgs::CmdlineArgs()
     : m_startInFullscreen(false), // Initialize vars
       m_midiDebug(false),
+      m_controllerProfile(false),
       m_developer(false),
       m_safeMode(false),
       m_debugAssertBreak(false),
@@ -55,6 +56,9 @@ bool CmdlineArgs::Parse(int &argc, char **argv) {
         } else if (argv[i] == QString("--timelinePath") && i+1 < argc) {
             m_timelinePath = QString::fromLocal8Bit(argv[i+1]);
             i++;
+        } else if (argv[i] == QString("--statsPath") && i+1 < argc) {
+            m_statsPath = QString::fromLocal8Bit(argv[i+1]);
+            i++;
         } else if (argv[i] == QString("--logLevel") && i+1 < argc) {
             logLevelSet = true;
             auto level = QLatin1String(argv[i+1]);
@@ -76,6 +80,8 @@ warnings and errors to the console unless this is set properly.\n", stdout);
         } else if (QString::fromLocal8Bit(argv[i]).contains("--midiDebug", Qt::CaseInsensitive) ||
                    QString::fromLocal8Bit(argv[i]).contains("--controllerDebug", Qt::CaseInsensitive)) {
             m_midiDebug = true;
+        } else if (QString::fromLocal8Bit(argv[i]).contains("--controllerProfile", Qt::CaseInsensitive)) {
+            m_controllerProfile = true;
         } else if (QString::fromLocal8Bit(argv[i]).contains("--developer", Qt::CaseInsensitive)) {
             m_developer = true;
         } else if (QString::fromLocal8Bit(argv[i]).contains("--safeMode", Qt::CaseInsensitive)) {
@@ -130,9 +136,17 @@ void CmdlineArgs::printUsage() {
 --controllerDebug       Causes Mixxx to display/log all of the controller\n\
                         data it receives and script functions it loads\n\
 \n\
+--controllerProfile     Measures the time that controller script functions,\n\
+                        timers and connections take and logs it when the\n\
+                        controller is closed\n\
+\n\
 --developer             Enables developer-mode. Includes extra log info,\n\
                         stats on performance, and a Developer tools menu.\n\
 \n\
+--statsPath PATH        Records performance stats and writes them to PATH\n\
+                        on shutdown. The file is written as JSON if PATH\n\
+                        ends with .json and as CSV otherwise.\n\
+\n\
 --safeMode              Enables safe-mode. Disables OpenGL waveforms,\n\
                         and spinning vinyl widgets. Try this option if\n\
                         Mixxx is crashing on startup.\n\
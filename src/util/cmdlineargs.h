@@ -22,6 +22,7 @@ class CmdlineArgs final {
     const QList<QString>& getMusicFiles() const { return m_musicFiles; }
     bool getStartInFullscreen() const { return m_startInFullscreen; }
     bool getMidiDebug() const { return m_midiDebug; }
+    bool getControllerProfile() const { return m_controllerProfile; }
     bool getDeveloper() const { return m_developer; }
     bool getSafeMode() const { return m_safeMode; }
     bool getDebugAssertBreak() const { return m_debugAssertBreak; }
@@ -36,6 +37,7 @@ class CmdlineArgs final {
     const QString& getResourcePath() const { return m_resourcePath; }
     const QString& getPluginPath() const { return m_pluginPath; }
     const QString& getTimelinePath() const { return m_timelinePath; }
+    const QString& getStatsPath() const { return m_statsPath; }
 
   private:
     CmdlineArgs();
@@ -43,6 +45,7 @@ class CmdlineArgs final {
     QList<QString> m_musicFiles;    // List of files to load into players at startup
     bool m_startInFullscreen;       // Start in fullscreen mode
     bool m_midiDebug;
+    bool m_controllerProfile;
     bool m_developer; // Developer Mode
     bool m_safeMode;
     bool m_debugAssertBreak;
@@ -53,6 +56,7 @@ class CmdlineArgs final {
     QString m_resourcePath;
     QString m_pluginPath;
     QString m_timelinePath;
+    QString m_statsPath;
 };
 
 #endif /* CMDLINEARGS_H */
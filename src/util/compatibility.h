@@ -2,6 +2,7 @@
 #define COMPATABILITY_H
 
 #include <QAtomicInt>
+#include <QAtomicPointer>
 #include <QStringList>
 
 #include <QLocale>
@@ -20,6 +21,23 @@ inline int load_atomic(const QAtomicInt& value) {
 #endif
 }
 
+inline int load_atomic_acquire(const QAtomicInt& value) {
+#if QT_VERSION < QT_VERSION_CHECK(5, 0, 0)
+    return value;
+#else
+    return value.loadAcquire();
+#endif
+}
+
+template <typename T>
+inline T* load_atomic_pointer(const QAtomicPointer<T>& value) {
+#if QT_VERSION < QT_VERSION_CHECK(5, 0, 0)
+    return value;
+#else
+    return value.loadAcquire();
+#endif
+}
+
 inline QLocale inputLocale() {
 #if QT_VERSION < QT_VERSION_CHECK(5, 0, 0)
     return QApplication::keyboardInputLocale();
@@ -6,13 +6,13 @@
 class Counter {
   public:
     Counter(const QString& tag)
-    : m_tag(tag) {
+    : m_statId(Stat::registerTag(tag)) {
     }
     void increment(int by=1) {
         Stat::ComputeFlags flags = Stat::experimentFlags(
             Stat::COUNT | Stat::SUM | Stat::AVERAGE |
             Stat::SAMPLE_VARIANCE | Stat::MIN | Stat::MAX);
-        Stat::track(m_tag, Stat::COUNTER, flags, by);
+        Stat::track(m_statId, Stat::COUNTER, flags, by);
     }
     Counter& operator+=(int by) {
         this->increment(by);
@@ -24,7 +24,7 @@ class Counter {
         return result;
     }
   private:
-    QString m_tag;
+    Stat::Id m_statId;
 };
 
 #endif /* COUNTER_H */
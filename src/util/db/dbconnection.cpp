@@ -213,6 +213,30 @@ void sqliteLike(sqlite3_context *context,
     return;
 }
 
+const char* const kLatinLowFunc = "mixxx_latin_low";
+
+// This implements the mixxx_latin_low() SQL function, which returns its
+// argument as the LIKE operator compares it.
+void sqliteLatinLow(sqlite3_context *context,
+                    int aArgc,
+                    sqlite3_value **aArgv) {
+    VERIFY_OR_DEBUG_ASSERT(aArgc == 1) {
+        return;
+    }
+
+    const char* a = reinterpret_cast<const char*>(
+            sqlite3_value_text(aArgv[0]));
+    if (!a) {
+        // NULL
+        return;
+    }
+
+    const QByteArray result =
+            DbConnection::latinLow(QString::fromUtf8(a)).toUtf8();
+    sqlite3_result_text(context, result.constData(), result.size(),
+            SQLITE_TRANSIENT);
+}
+
 #endif // __SQLITE3__
 
 bool initDatabase(QSqlDatabase database) {
@@ -276,6 +300,20 @@ bool initDatabase(QSqlDatabase database) {
                 << "Failed to install custom 3-arg LIKE function for SQLite3:"
                 << result;
     }
+
+    result = sqlite3_create_function(
+                    handle,
+                    kLatinLowFunc,
+                    1,
+                    SQLITE_UTF8,
+                    nullptr,
+                    sqliteLatinLow,
+                    nullptr, nullptr);
+    VERIFY_OR_DEBUG_ASSERT(result == SQLITE_OK) {
+        kLogger.warning()
+                << "Failed to install latin low function for SQLite3:"
+                << result;
+    }
 #endif // __SQLITE3__
     return true;
 }
@@ -346,6 +384,28 @@ QString DbConnection::collateLexicographically(const QString& orderByQuery) {
 #endif //  __SQLITE3__
 }
 
+//static
+int DbConnection::compareLexicographically(
+        const QString& first,
+        const QString& second) {
+    return compareLocaleAwareCaseInsensitive(first, second);
+}
+
+//static
+QString DbConnection::latinLow(QString string) {
+    makeLatinLow(string.data(), string.length());
+    return string;
+}
+
+//static
+QString DbConnection::latinLowFunction() {
+#ifdef __SQLITE3__
+        return kLatinLowFunc;
+#else
+        return QString();
+#endif //  __SQLITE3__
+}
+
 //static
 int DbConnection::likeCompareLatinLow(
         QString* pattern,
@@ -22,6 +22,19 @@ class DbConnection final {
         QString* string,
         QChar esc);
 
+    // Compares strings like the lexicographical collation does.
+    static int compareLexicographically(
+            const QString& first,
+            const QString& second);
+
+    // Returns the string as it is compared by the LIKE operator,
+    // i.e. lower case and without diacritics.
+    static QString latinLow(QString string);
+    // The name of an SQL function that returns latinLow() of its
+    // argument if available (SQLite3). Otherwise an empty string is
+    // returned.
+    static QString latinLowFunction();
+
     struct Params {
         QString type;
         QString hostName;
@@ -19,16 +19,38 @@ class Event {
     EventType m_type;
     mixxx::Duration m_time;
 
+    static bool event(Stat::Id id, Event::EventType type = Stat::EVENT) {
+        return Stat::track(id, type, Stat::experimentFlags(Stat::COUNT), 0.0);
+    }
     static bool event(const QString& tag, Event::EventType type = Stat::EVENT) {
         return Stat::track(tag, type, Stat::experimentFlags(Stat::COUNT), 0.0);
     }
+    // The tag is cached by its contents, so it may be a temporary string.
+    // Prefer registering the tag up front on real-time code paths, see
+    // Stat::registerTag().
+    static bool event(const char* tag, Event::EventType type = Stat::EVENT) {
+        return event(Stat::registerTag(tag, static_cast<const char*>(nullptr)),
+                type);
+    }
 
+    static bool start(Stat::Id id) {
+        return event(id, Stat::EVENT_START);
+    }
     static bool start(const QString& tag) {
         return event(tag, Stat::EVENT_START);
     }
+    static bool start(const char* tag) {
+        return event(tag, Stat::EVENT_START);
+    }
+    static bool end(Stat::Id id) {
+        return event(id, Stat::EVENT_END);
+    }
     static bool end(const QString& tag) {
         return event(tag, Stat::EVENT_END);
     }
+    static bool end(const char* tag) {
+        return event(tag, Stat::EVENT_END);
+    }
 };
 
 #endif /* EVENT_H */
@@ -1,6 +1,7 @@
 #include <cstdlib>
 
 #include "util/sample.h"
+#include "util/samplekernels.h"
 #include "util/math.h"
 
 #ifdef __WINDOWS__
@@ -218,12 +219,9 @@ void SampleUtil::addWithRampingGain(CSAMPLE* M_RESTRICT pDest,
             / CSAMPLE_GAIN(numSamples / 2);
     if (gain_delta) {
         const CSAMPLE_GAIN start_gain = old_gain + gain_delta;
-        // note: LOOP VECTORIZED.
-        for (int i = 0; i < numSamples / 2; ++i) {
-            const CSAMPLE_GAIN gain = start_gain + gain_delta * i;
-            pDest[i * 2] += pSrc[i * 2] * gain;
-            pDest[i * 2 + 1] += pSrc[i * 2 + 1] * gain;
-        }
+        // The interleaved gain ramp is not auto-vectorized, see samplekernels.h
+        mixxx::SampleKernels::get().addWithRampingGain(
+                pDest, pSrc, start_gain, gain_delta, numSamples / 2);
     } else {
         // note: LOOP VECTORIZED.
         for (int i = 0; i < numSamples; ++i) {
@@ -311,12 +309,9 @@ void SampleUtil::copyWithRampingGain(CSAMPLE* M_RESTRICT pDest,
             / CSAMPLE_GAIN(numSamples / 2);
     if (gain_delta) {
         const CSAMPLE_GAIN start_gain = old_gain + gain_delta;
-        // note: LOOP VECTORIZED only with "int i"
-        for (int i = 0; i < numSamples / 2; ++i) {
-            const CSAMPLE_GAIN gain = start_gain + gain_delta * i;
-            pDest[i * 2] = pSrc[i * 2] * gain;
-            pDest[i * 2 + 1] = pSrc[i * 2 + 1] * gain;
-        }
+        // The interleaved gain ramp is not auto-vectorized, see samplekernels.h
+        mixxx::SampleKernels::get().copyWithRampingGain(
+                pDest, pSrc, start_gain, gain_delta, numSamples / 2);
     } else {
         // note: LOOP VECTORIZED.
         for (SINT i = 0; i < numSamples; ++i) {
@@ -329,6 +324,30 @@ void SampleUtil::copyWithRampingGain(CSAMPLE* M_RESTRICT pDest,
     // applyRampingGain(pDest, gain);
 }
 
+// static
+void SampleUtil::copyMultipleWithGain(CSAMPLE* pDest,
+        const CSAMPLE* const* pSrc, const CSAMPLE_GAIN* pGain,
+        int numChannels, SINT numSamples) {
+    if (numChannels <= 0) {
+        clear(pDest, numSamples);
+        return;
+    }
+    mixxx::SampleKernels::get().copyMultipleWithGain(
+            pDest, pSrc, pGain, numChannels, numSamples);
+}
+
+// static
+void SampleUtil::copyMultipleWithRampingGain(CSAMPLE* pDest,
+        const CSAMPLE* const* pSrc, const CSAMPLE_GAIN* pStartGain,
+        const CSAMPLE_GAIN* pGainDelta, int numChannels, SINT numFrames) {
+    if (numChannels <= 0) {
+        clear(pDest, numFrames * 2);
+        return;
+    }
+    mixxx::SampleKernels::get().copyMultipleWithRampingGain(
+            pDest, pSrc, pStartGain, pGainDelta, numChannels, numFrames);
+}
+
 // static
 void SampleUtil::convertS16ToFloat32(CSAMPLE* M_RESTRICT pDest,
         const SAMPLE* M_RESTRICT pSrc, SINT numSamples) {
@@ -357,29 +376,16 @@ void SampleUtil::convertFloat32ToS16(SAMPLE* pDest, const CSAMPLE* pSrc,
 // static
 SampleUtil::CLIP_STATUS SampleUtil::sumAbsPerChannel(CSAMPLE* pfAbsL,
         CSAMPLE* pfAbsR, const CSAMPLE* pBuffer, SINT numSamples) {
-    CSAMPLE fAbsL = CSAMPLE_ZERO;
-    CSAMPLE fAbsR = CSAMPLE_ZERO;
-    CSAMPLE clippedL = 0;
-    CSAMPLE clippedR = 0;
+    CSAMPLE peakL;
+    CSAMPLE peakR;
+    mixxx::SampleKernels::get().sumAbsAndPeakPerChannel(
+            pBuffer, numSamples / 2, pfAbsL, pfAbsR, &peakL, &peakR);
 
-    // note: LOOP VECTORIZED.
-    for (SINT i = 0; i < numSamples / 2; ++i) {
-        CSAMPLE absl = fabs(pBuffer[i * 2]);
-        fAbsL += absl;
-        clippedL += absl > CSAMPLE_PEAK ? 1 : 0;
-        CSAMPLE absr = fabs(pBuffer[i * 2 + 1]);
-        fAbsR += absr;
-        // Replacing the code with a bool clipped will prevent vetorizing
-        clippedR += absr > CSAMPLE_PEAK ? 1 : 0;
-    }
-
-    *pfAbsL = fAbsL;
-    *pfAbsR = fAbsR;
     SampleUtil::CLIP_STATUS clipping = SampleUtil::NO_CLIPPING;
-    if (clippedL > 0) {
+    if (peakL > CSAMPLE_PEAK) {
         clipping |= SampleUtil::CLIPPING_LEFT;
     }
-    if (clippedR > 0) {
+    if (peakR > CSAMPLE_PEAK) {
         clipping |= SampleUtil::CLIPPING_RIGHT;
     }
     return clipping;
@@ -388,10 +394,7 @@ SampleUtil::CLIP_STATUS SampleUtil::sumAbsPerChannel(CSAMPLE* pfAbsL,
 // static
 void SampleUtil::copyClampBuffer(CSAMPLE* M_RESTRICT pDest,
         const CSAMPLE* M_RESTRICT pSrc, SINT iNumSamples) {
-    // note: LOOP VECTORIZED.
-    for (SINT i = 0; i < iNumSamples; ++i) {
-        pDest[i] = clampSample(pSrc[i]);
-    }
+    mixxx::SampleKernels::get().copyClamp(pDest, pSrc, iNumSamples);
 }
 
 // static
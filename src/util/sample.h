@@ -272,6 +272,18 @@ class SampleUtil {
             const CSAMPLE* M_RESTRICT pSrc, SINT numSamples);
 
 
+    // Copy the sum of the numChannels buffers in pSrc, each multiplied by
+    // the matching gain in pGain, to pDest.
+    static void copyMultipleWithGain(CSAMPLE* pDest,
+            const CSAMPLE* const* pSrc, const CSAMPLE_GAIN* pGain,
+            int numChannels, SINT numSamples);
+
+    // Like copyMultipleWithGain(), but the gain of channel j ramps over the
+    // stereo frames: pStartGain[j] + pGainDelta[j] * frame
+    static void copyMultipleWithRampingGain(CSAMPLE* pDest,
+            const CSAMPLE* const* pSrc, const CSAMPLE_GAIN* pStartGain,
+            const CSAMPLE_GAIN* pGainDelta, int numChannels, SINT numFrames);
+
     // Include auto-generated methods (e.g. copyXWithGain, copyXWithRampingGain,
     // etc.)
 #include "util/sample_autogen.h"
@@ -158,13 +158,9 @@ static inline void copy4WithGain(CSAMPLE* M_RESTRICT pDest,
         copy3WithGain(pDest, pSrc0, gain0, pSrc1, gain1, pSrc2, gain2, iNumSamples);
         return;
     }
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples; ++i) {
-        pDest[i] = pSrc0[i] * gain0 +
-                   pSrc1[i] * gain1 +
-                   pSrc2[i] * gain2 +
-                   pSrc3[i] * gain3;
-    }
+    const CSAMPLE* const pSrc[4] = {pSrc0, pSrc1, pSrc2, pSrc3};
+    const CSAMPLE_GAIN gain[4] = {gain0, gain1, gain2, gain3};
+    copyMultipleWithGain(pDest, pSrc, gain, 4, iNumSamples);
 }
 static inline void copy4WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                         const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
@@ -196,21 +192,10 @@ static inline void copy4WithRampingGain(CSAMPLE* M_RESTRICT pDest,
     const CSAMPLE_GAIN start_gain2 = gain2in + gain_delta2;
     const CSAMPLE_GAIN gain_delta3 = (gain3out - gain3in) / (iNumSamples / 2);
     const CSAMPLE_GAIN start_gain3 = gain3in + gain_delta3;
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples / 2; ++i) {
-        const CSAMPLE_GAIN gain0 = start_gain0 + gain_delta0 * i;
-        const CSAMPLE_GAIN gain1 = start_gain1 + gain_delta1 * i;
-        const CSAMPLE_GAIN gain2 = start_gain2 + gain_delta2 * i;
-        const CSAMPLE_GAIN gain3 = start_gain3 + gain_delta3 * i;
-        pDest[i * 2] = pSrc0[i * 2] * gain0 +
-                       pSrc1[i * 2] * gain1 +
-                       pSrc2[i * 2] * gain2 +
-                       pSrc3[i * 2] * gain3;
-        pDest[i * 2 + 1] = pSrc0[i * 2 + 1] * gain0 +
-                           pSrc1[i * 2 + 1] * gain1 +
-                           pSrc2[i * 2 + 1] * gain2 +
-                           pSrc3[i * 2 + 1] * gain3;
-    }
+    const CSAMPLE* const pSrc[4] = {pSrc0, pSrc1, pSrc2, pSrc3};
+    const CSAMPLE_GAIN start_gain[4] = {start_gain0, start_gain1, start_gain2, start_gain3};
+    const CSAMPLE_GAIN gain_delta[4] = {gain_delta0, gain_delta1, gain_delta2, gain_delta3};
+    copyMultipleWithRampingGain(pDest, pSrc, start_gain, gain_delta, 4, iNumSamples / 2);
 }
 static inline void copy5WithGain(CSAMPLE* M_RESTRICT pDest,
                                  const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
@@ -239,14 +224,9 @@ static inline void copy5WithGain(CSAMPLE* M_RESTRICT pDest,
         copy4WithGain(pDest, pSrc0, gain0, pSrc1, gain1, pSrc2, gain2, pSrc3, gain3, iNumSamples);
         return;
     }
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples; ++i) {
-        pDest[i] = pSrc0[i] * gain0 +
-                   pSrc1[i] * gain1 +
-                   pSrc2[i] * gain2 +
-                   pSrc3[i] * gain3 +
-                   pSrc4[i] * gain4;
-    }
+    const CSAMPLE* const pSrc[5] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4};
+    const CSAMPLE_GAIN gain[5] = {gain0, gain1, gain2, gain3, gain4};
+    copyMultipleWithGain(pDest, pSrc, gain, 5, iNumSamples);
 }
 static inline void copy5WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                         const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
@@ -285,24 +265,10 @@ static inline void copy5WithRampingGain(CSAMPLE* M_RESTRICT pDest,
     const CSAMPLE_GAIN start_gain3 = gain3in + gain_delta3;
     const CSAMPLE_GAIN gain_delta4 = (gain4out - gain4in) / (iNumSamples / 2);
     const CSAMPLE_GAIN start_gain4 = gain4in + gain_delta4;
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples / 2; ++i) {
-        const CSAMPLE_GAIN gain0 = start_gain0 + gain_delta0 * i;
-        const CSAMPLE_GAIN gain1 = start_gain1 + gain_delta1 * i;
-        const CSAMPLE_GAIN gain2 = start_gain2 + gain_delta2 * i;
-        const CSAMPLE_GAIN gain3 = start_gain3 + gain_delta3 * i;
-        const CSAMPLE_GAIN gain4 = start_gain4 + gain_delta4 * i;
-        pDest[i * 2] = pSrc0[i * 2] * gain0 +
-                       pSrc1[i * 2] * gain1 +
-                       pSrc2[i * 2] * gain2 +
-                       pSrc3[i * 2] * gain3 +
-                       pSrc4[i * 2] * gain4;
-        pDest[i * 2 + 1] = pSrc0[i * 2 + 1] * gain0 +
-                           pSrc1[i * 2 + 1] * gain1 +
-                           pSrc2[i * 2 + 1] * gain2 +
-                           pSrc3[i * 2 + 1] * gain3 +
-                           pSrc4[i * 2 + 1] * gain4;
-    }
+    const CSAMPLE* const pSrc[5] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4};
+    const CSAMPLE_GAIN start_gain[5] = {start_gain0, start_gain1, start_gain2, start_gain3, start_gain4};
+    const CSAMPLE_GAIN gain_delta[5] = {gain_delta0, gain_delta1, gain_delta2, gain_delta3, gain_delta4};
+    copyMultipleWithRampingGain(pDest, pSrc, start_gain, gain_delta, 5, iNumSamples / 2);
 }
 static inline void copy6WithGain(CSAMPLE* M_RESTRICT pDest,
                                  const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
@@ -336,15 +302,9 @@ static inline void copy6WithGain(CSAMPLE* M_RESTRICT pDest,
         copy5WithGain(pDest, pSrc0, gain0, pSrc1, gain1, pSrc2, gain2, pSrc3, gain3, pSrc4, gain4, iNumSamples);
         return;
     }
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples; ++i) {
-        pDest[i] = pSrc0[i] * gain0 +
-                   pSrc1[i] * gain1 +
-                   pSrc2[i] * gain2 +
-                   pSrc3[i] * gain3 +
-                   pSrc4[i] * gain4 +
-                   pSrc5[i] * gain5;
-    }
+    const CSAMPLE* const pSrc[6] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5};
+    const CSAMPLE_GAIN gain[6] = {gain0, gain1, gain2, gain3, gain4, gain5};
+    copyMultipleWithGain(pDest, pSrc, gain, 6, iNumSamples);
 }
 static inline void copy6WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                         const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
@@ -390,27 +350,10 @@ static inline void copy6WithRampingGain(CSAMPLE* M_RESTRICT pDest,
     const CSAMPLE_GAIN start_gain4 = gain4in + gain_delta4;
     const CSAMPLE_GAIN gain_delta5 = (gain5out - gain5in) / (iNumSamples / 2);
     const CSAMPLE_GAIN start_gain5 = gain5in + gain_delta5;
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples / 2; ++i) {
-        const CSAMPLE_GAIN gain0 = start_gain0 + gain_delta0 * i;
-        const CSAMPLE_GAIN gain1 = start_gain1 + gain_delta1 * i;
-        const CSAMPLE_GAIN gain2 = start_gain2 + gain_delta2 * i;
-        const CSAMPLE_GAIN gain3 = start_gain3 + gain_delta3 * i;
-        const CSAMPLE_GAIN gain4 = start_gain4 + gain_delta4 * i;
-        const CSAMPLE_GAIN gain5 = start_gain5 + gain_delta5 * i;
-        pDest[i * 2] = pSrc0[i * 2] * gain0 +
-                       pSrc1[i * 2] * gain1 +
-                       pSrc2[i * 2] * gain2 +
-                       pSrc3[i * 2] * gain3 +
-                       pSrc4[i * 2] * gain4 +
-                       pSrc5[i * 2] * gain5;
-        pDest[i * 2 + 1] = pSrc0[i * 2 + 1] * gain0 +
-                           pSrc1[i * 2 + 1] * gain1 +
-                           pSrc2[i * 2 + 1] * gain2 +
-                           pSrc3[i * 2 + 1] * gain3 +
-                           pSrc4[i * 2 + 1] * gain4 +
-                           pSrc5[i * 2 + 1] * gain5;
-    }
+    const CSAMPLE* const pSrc[6] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5};
+    const CSAMPLE_GAIN start_gain[6] = {start_gain0, start_gain1, start_gain2, start_gain3, start_gain4, start_gain5};
+    const CSAMPLE_GAIN gain_delta[6] = {gain_delta0, gain_delta1, gain_delta2, gain_delta3, gain_delta4, gain_delta5};
+    copyMultipleWithRampingGain(pDest, pSrc, start_gain, gain_delta, 6, iNumSamples / 2);
 }
 static inline void copy7WithGain(CSAMPLE* M_RESTRICT pDest,
                                  const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
@@ -449,16 +392,9 @@ static inline void copy7WithGain(CSAMPLE* M_RESTRICT pDest,
         copy6WithGain(pDest, pSrc0, gain0, pSrc1, gain1, pSrc2, gain2, pSrc3, gain3, pSrc4, gain4, pSrc5, gain5, iNumSamples);
         return;
     }
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples; ++i) {
-        pDest[i] = pSrc0[i] * gain0 +
-                   pSrc1[i] * gain1 +
-                   pSrc2[i] * gain2 +
-                   pSrc3[i] * gain3 +
-                   pSrc4[i] * gain4 +
-                   pSrc5[i] * gain5 +
-                   pSrc6[i] * gain6;
-    }
+    const CSAMPLE* const pSrc[7] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6};
+    const CSAMPLE_GAIN gain[7] = {gain0, gain1, gain2, gain3, gain4, gain5, gain6};
+    copyMultipleWithGain(pDest, pSrc, gain, 7, iNumSamples);
 }
 static inline void copy7WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                         const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
@@ -511,30 +447,10 @@ static inline void copy7WithRampingGain(CSAMPLE* M_RESTRICT pDest,
     const CSAMPLE_GAIN start_gain5 = gain5in + gain_delta5;
     const CSAMPLE_GAIN gain_delta6 = (gain6out - gain6in) / (iNumSamples / 2);
     const CSAMPLE_GAIN start_gain6 = gain6in + gain_delta6;
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples / 2; ++i) {
-        const CSAMPLE_GAIN gain0 = start_gain0 + gain_delta0 * i;
-        const CSAMPLE_GAIN gain1 = start_gain1 + gain_delta1 * i;
-        const CSAMPLE_GAIN gain2 = start_gain2 + gain_delta2 * i;
-        const CSAMPLE_GAIN gain3 = start_gain3 + gain_delta3 * i;
-        const CSAMPLE_GAIN gain4 = start_gain4 + gain_delta4 * i;
-        const CSAMPLE_GAIN gain5 = start_gain5 + gain_delta5 * i;
-        const CSAMPLE_GAIN gain6 = start_gain6 + gain_delta6 * i;
-        pDest[i * 2] = pSrc0[i * 2] * gain0 +
-                       pSrc1[i * 2] * gain1 +
-                       pSrc2[i * 2] * gain2 +
-                       pSrc3[i * 2] * gain3 +
-                       pSrc4[i * 2] * gain4 +
-                       pSrc5[i * 2] * gain5 +
-                       pSrc6[i * 2] * gain6;
-        pDest[i * 2 + 1] = pSrc0[i * 2 + 1] * gain0 +
-                           pSrc1[i * 2 + 1] * gain1 +
-                           pSrc2[i * 2 + 1] * gain2 +
-                           pSrc3[i * 2 + 1] * gain3 +
-                           pSrc4[i * 2 + 1] * gain4 +
-                           pSrc5[i * 2 + 1] * gain5 +
-                           pSrc6[i * 2 + 1] * gain6;
-    }
+    const CSAMPLE* const pSrc[7] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6};
+    const CSAMPLE_GAIN start_gain[7] = {start_gain0, start_gain1, start_gain2, start_gain3, start_gain4, start_gain5, start_gain6};
+    const CSAMPLE_GAIN gain_delta[7] = {gain_delta0, gain_delta1, gain_delta2, gain_delta3, gain_delta4, gain_delta5, gain_delta6};
+    copyMultipleWithRampingGain(pDest, pSrc, start_gain, gain_delta, 7, iNumSamples / 2);
 }
 static inline void copy8WithGain(CSAMPLE* M_RESTRICT pDest,
                                  const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
@@ -578,17 +494,9 @@ static inline void copy8WithGain(CSAMPLE* M_RESTRICT pDest,
         copy7WithGain(pDest, pSrc0, gain0, pSrc1, gain1, pSrc2, gain2, pSrc3, gain3, pSrc4, gain4, pSrc5, gain5, pSrc6, gain6, iNumSamples);
         return;
     }
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples; ++i) {
-        pDest[i] = pSrc0[i] * gain0 +
-                   pSrc1[i] * gain1 +
-                   pSrc2[i] * gain2 +
-                   pSrc3[i] * gain3 +
-                   pSrc4[i] * gain4 +
-                   pSrc5[i] * gain5 +
-                   pSrc6[i] * gain6 +
-                   pSrc7[i] * gain7;
-    }
+    const CSAMPLE* const pSrc[8] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7};
+    const CSAMPLE_GAIN gain[8] = {gain0, gain1, gain2, gain3, gain4, gain5, gain6, gain7};
+    copyMultipleWithGain(pDest, pSrc, gain, 8, iNumSamples);
 }
 static inline void copy8WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                         const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
@@ -648,33 +556,10 @@ static inline void copy8WithRampingGain(CSAMPLE* M_RESTRICT pDest,
     const CSAMPLE_GAIN start_gain6 = gain6in + gain_delta6;
     const CSAMPLE_GAIN gain_delta7 = (gain7out - gain7in) / (iNumSamples / 2);
     const CSAMPLE_GAIN start_gain7 = gain7in + gain_delta7;
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples / 2; ++i) {
-        const CSAMPLE_GAIN gain0 = start_gain0 + gain_delta0 * i;
-        const CSAMPLE_GAIN gain1 = start_gain1 + gain_delta1 * i;
-        const CSAMPLE_GAIN gain2 = start_gain2 + gain_delta2 * i;
-        const CSAMPLE_GAIN gain3 = start_gain3 + gain_delta3 * i;
-        const CSAMPLE_GAIN gain4 = start_gain4 + gain_delta4 * i;
-        const CSAMPLE_GAIN gain5 = start_gain5 + gain_delta5 * i;
-        const CSAMPLE_GAIN gain6 = start_gain6 + gain_delta6 * i;
-        const CSAMPLE_GAIN gain7 = start_gain7 + gain_delta7 * i;
-        pDest[i * 2] = pSrc0[i * 2] * gain0 +
-                       pSrc1[i * 2] * gain1 +
-                       pSrc2[i * 2] * gain2 +
-                       pSrc3[i * 2] * gain3 +
-                       pSrc4[i * 2] * gain4 +
-                       pSrc5[i * 2] * gain5 +
-                       pSrc6[i * 2] * gain6 +
-                       pSrc7[i * 2] * gain7;
-        pDest[i * 2 + 1] = pSrc0[i * 2 + 1] * gain0 +
-                           pSrc1[i * 2 + 1] * gain1 +
-                           pSrc2[i * 2 + 1] * gain2 +
-                           pSrc3[i * 2 + 1] * gain3 +
-                           pSrc4[i * 2 + 1] * gain4 +
-                           pSrc5[i * 2 + 1] * gain5 +
-                           pSrc6[i * 2 + 1] * gain6 +
-                           pSrc7[i * 2 + 1] * gain7;
-    }
+    const CSAMPLE* const pSrc[8] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7};
+    const CSAMPLE_GAIN start_gain[8] = {start_gain0, start_gain1, start_gain2, start_gain3, start_gain4, start_gain5, start_gain6, start_gain7};
+    const CSAMPLE_GAIN gain_delta[8] = {gain_delta0, gain_delta1, gain_delta2, gain_delta3, gain_delta4, gain_delta5, gain_delta6, gain_delta7};
+    copyMultipleWithRampingGain(pDest, pSrc, start_gain, gain_delta, 8, iNumSamples / 2);
 }
 static inline void copy9WithGain(CSAMPLE* M_RESTRICT pDest,
                                  const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
@@ -723,18 +608,9 @@ static inline void copy9WithGain(CSAMPLE* M_RESTRICT pDest,
         copy8WithGain(pDest, pSrc0, gain0, pSrc1, gain1, pSrc2, gain2, pSrc3, gain3, pSrc4, gain4, pSrc5, gain5, pSrc6, gain6, pSrc7, gain7, iNumSamples);
         return;
     }
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples; ++i) {
-        pDest[i] = pSrc0[i] * gain0 +
-                   pSrc1[i] * gain1 +
-                   pSrc2[i] * gain2 +
-                   pSrc3[i] * gain3 +
-                   pSrc4[i] * gain4 +
-                   pSrc5[i] * gain5 +
-                   pSrc6[i] * gain6 +
-                   pSrc7[i] * gain7 +
-                   pSrc8[i] * gain8;
-    }
+    const CSAMPLE* const pSrc[9] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8};
+    const CSAMPLE_GAIN gain[9] = {gain0, gain1, gain2, gain3, gain4, gain5, gain6, gain7, gain8};
+    copyMultipleWithGain(pDest, pSrc, gain, 9, iNumSamples);
 }
 static inline void copy9WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                         const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
@@ -801,36 +677,10 @@ static inline void copy9WithRampingGain(CSAMPLE* M_RESTRICT pDest,
     const CSAMPLE_GAIN start_gain7 = gain7in + gain_delta7;
     const CSAMPLE_GAIN gain_delta8 = (gain8out - gain8in) / (iNumSamples / 2);
     const CSAMPLE_GAIN start_gain8 = gain8in + gain_delta8;
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples / 2; ++i) {
-        const CSAMPLE_GAIN gain0 = start_gain0 + gain_delta0 * i;
-        const CSAMPLE_GAIN gain1 = start_gain1 + gain_delta1 * i;
-        const CSAMPLE_GAIN gain2 = start_gain2 + gain_delta2 * i;
-        const CSAMPLE_GAIN gain3 = start_gain3 + gain_delta3 * i;
-        const CSAMPLE_GAIN gain4 = start_gain4 + gain_delta4 * i;
-        const CSAMPLE_GAIN gain5 = start_gain5 + gain_delta5 * i;
-        const CSAMPLE_GAIN gain6 = start_gain6 + gain_delta6 * i;
-        const CSAMPLE_GAIN gain7 = start_gain7 + gain_delta7 * i;
-        const CSAMPLE_GAIN gain8 = start_gain8 + gain_delta8 * i;
-        pDest[i * 2] = pSrc0[i * 2] * gain0 +
-                       pSrc1[i * 2] * gain1 +
-                       pSrc2[i * 2] * gain2 +
-                       pSrc3[i * 2] * gain3 +
-                       pSrc4[i * 2] * gain4 +
-                       pSrc5[i * 2] * gain5 +
-                       pSrc6[i * 2] * gain6 +
-                       pSrc7[i * 2] * gain7 +
-                       pSrc8[i * 2] * gain8;
-        pDest[i * 2 + 1] = pSrc0[i * 2 + 1] * gain0 +
-                           pSrc1[i * 2 + 1] * gain1 +
-                           pSrc2[i * 2 + 1] * gain2 +
-                           pSrc3[i * 2 + 1] * gain3 +
-                           pSrc4[i * 2 + 1] * gain4 +
-                           pSrc5[i * 2 + 1] * gain5 +
-                           pSrc6[i * 2 + 1] * gain6 +
-                           pSrc7[i * 2 + 1] * gain7 +
-                           pSrc8[i * 2 + 1] * gain8;
-    }
+    const CSAMPLE* const pSrc[9] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8};
+    const CSAMPLE_GAIN start_gain[9] = {start_gain0, start_gain1, start_gain2, start_gain3, start_gain4, start_gain5, start_gain6, start_gain7, start_gain8};
+    const CSAMPLE_GAIN gain_delta[9] = {gain_delta0, gain_delta1, gain_delta2, gain_delta3, gain_delta4, gain_delta5, gain_delta6, gain_delta7, gain_delta8};
+    copyMultipleWithRampingGain(pDest, pSrc, start_gain, gain_delta, 9, iNumSamples / 2);
 }
 static inline void copy10WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
@@ -884,19 +734,9 @@ static inline void copy10WithGain(CSAMPLE* M_RESTRICT pDest,
         copy9WithGain(pDest, pSrc0, gain0, pSrc1, gain1, pSrc2, gain2, pSrc3, gain3, pSrc4, gain4, pSrc5, gain5, pSrc6, gain6, pSrc7, gain7, pSrc8, gain8, iNumSamples);
         return;
     }
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples; ++i) {
-        pDest[i] = pSrc0[i] * gain0 +
-                   pSrc1[i] * gain1 +
-                   pSrc2[i] * gain2 +
-                   pSrc3[i] * gain3 +
-                   pSrc4[i] * gain4 +
-                   pSrc5[i] * gain5 +
-                   pSrc6[i] * gain6 +
-                   pSrc7[i] * gain7 +
-                   pSrc8[i] * gain8 +
-                   pSrc9[i] * gain9;
-    }
+    const CSAMPLE* const pSrc[10] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9};
+    const CSAMPLE_GAIN gain[10] = {gain0, gain1, gain2, gain3, gain4, gain5, gain6, gain7, gain8, gain9};
+    copyMultipleWithGain(pDest, pSrc, gain, 10, iNumSamples);
 }
 static inline void copy10WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
@@ -970,39 +810,10 @@ static inline void copy10WithRampingGain(CSAMPLE* M_RESTRICT pDest,
     const CSAMPLE_GAIN start_gain8 = gain8in + gain_delta8;
     const CSAMPLE_GAIN gain_delta9 = (gain9out - gain9in) / (iNumSamples / 2);
     const CSAMPLE_GAIN start_gain9 = gain9in + gain_delta9;
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples / 2; ++i) {
-        const CSAMPLE_GAIN gain0 = start_gain0 + gain_delta0 * i;
-        const CSAMPLE_GAIN gain1 = start_gain1 + gain_delta1 * i;
-        const CSAMPLE_GAIN gain2 = start_gain2 + gain_delta2 * i;
-        const CSAMPLE_GAIN gain3 = start_gain3 + gain_delta3 * i;
-        const CSAMPLE_GAIN gain4 = start_gain4 + gain_delta4 * i;
-        const CSAMPLE_GAIN gain5 = start_gain5 + gain_delta5 * i;
-        const CSAMPLE_GAIN gain6 = start_gain6 + gain_delta6 * i;
-        const CSAMPLE_GAIN gain7 = start_gain7 + gain_delta7 * i;
-        const CSAMPLE_GAIN gain8 = start_gain8 + gain_delta8 * i;
-        const CSAMPLE_GAIN gain9 = start_gain9 + gain_delta9 * i;
-        pDest[i * 2] = pSrc0[i * 2] * gain0 +
-                       pSrc1[i * 2] * gain1 +
-                       pSrc2[i * 2] * gain2 +
-                       pSrc3[i * 2] * gain3 +
-                       pSrc4[i * 2] * gain4 +
-                       pSrc5[i * 2] * gain5 +
-                       pSrc6[i * 2] * gain6 +
-                       pSrc7[i * 2] * gain7 +
-                       pSrc8[i * 2] * gain8 +
-                       pSrc9[i * 2] * gain9;
-        pDest[i * 2 + 1] = pSrc0[i * 2 + 1] * gain0 +
-                           pSrc1[i * 2 + 1] * gain1 +
-                           pSrc2[i * 2 + 1] * gain2 +
-                           pSrc3[i * 2 + 1] * gain3 +
-                           pSrc4[i * 2 + 1] * gain4 +
-                           pSrc5[i * 2 + 1] * gain5 +
-                           pSrc6[i * 2 + 1] * gain6 +
-                           pSrc7[i * 2 + 1] * gain7 +
-                           pSrc8[i * 2 + 1] * gain8 +
-                           pSrc9[i * 2 + 1] * gain9;
-    }
+    const CSAMPLE* const pSrc[10] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9};
+    const CSAMPLE_GAIN start_gain[10] = {start_gain0, start_gain1, start_gain2, start_gain3, start_gain4, start_gain5, start_gain6, start_gain7, start_gain8, start_gain9};
+    const CSAMPLE_GAIN gain_delta[10] = {gain_delta0, gain_delta1, gain_delta2, gain_delta3, gain_delta4, gain_delta5, gain_delta6, gain_delta7, gain_delta8, gain_delta9};
+    copyMultipleWithRampingGain(pDest, pSrc, start_gain, gain_delta, 10, iNumSamples / 2);
 }
 static inline void copy11WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
@@ -1061,20 +872,9 @@ static inline void copy11WithGain(CSAMPLE* M_RESTRICT pDest,
         copy10WithGain(pDest, pSrc0, gain0, pSrc1, gain1, pSrc2, gain2, pSrc3, gain3, pSrc4, gain4, pSrc5, gain5, pSrc6, gain6, pSrc7, gain7, pSrc8, gain8, pSrc9, gain9, iNumSamples);
         return;
     }
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples; ++i) {
-        pDest[i] = pSrc0[i] * gain0 +
-                   pSrc1[i] * gain1 +
-                   pSrc2[i] * gain2 +
-                   pSrc3[i] * gain3 +
-                   pSrc4[i] * gain4 +
-                   pSrc5[i] * gain5 +
-                   pSrc6[i] * gain6 +
-                   pSrc7[i] * gain7 +
-                   pSrc8[i] * gain8 +
-                   pSrc9[i] * gain9 +
-                   pSrc10[i] * gain10;
-    }
+    const CSAMPLE* const pSrc[11] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10};
+    const CSAMPLE_GAIN gain[11] = {gain0, gain1, gain2, gain3, gain4, gain5, gain6, gain7, gain8, gain9, gain10};
+    copyMultipleWithGain(pDest, pSrc, gain, 11, iNumSamples);
 }
 static inline void copy11WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
@@ -1155,42 +955,10 @@ static inline void copy11WithRampingGain(CSAMPLE* M_RESTRICT pDest,
     const CSAMPLE_GAIN start_gain9 = gain9in + gain_delta9;
     const CSAMPLE_GAIN gain_delta10 = (gain10out - gain10in) / (iNumSamples / 2);
     const CSAMPLE_GAIN start_gain10 = gain10in + gain_delta10;
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples / 2; ++i) {
-        const CSAMPLE_GAIN gain0 = start_gain0 + gain_delta0 * i;
-        const CSAMPLE_GAIN gain1 = start_gain1 + gain_delta1 * i;
-        const CSAMPLE_GAIN gain2 = start_gain2 + gain_delta2 * i;
-        const CSAMPLE_GAIN gain3 = start_gain3 + gain_delta3 * i;
-        const CSAMPLE_GAIN gain4 = start_gain4 + gain_delta4 * i;
-        const CSAMPLE_GAIN gain5 = start_gain5 + gain_delta5 * i;
-        const CSAMPLE_GAIN gain6 = start_gain6 + gain_delta6 * i;
-        const CSAMPLE_GAIN gain7 = start_gain7 + gain_delta7 * i;
-        const CSAMPLE_GAIN gain8 = start_gain8 + gain_delta8 * i;
-        const CSAMPLE_GAIN gain9 = start_gain9 + gain_delta9 * i;
-        const CSAMPLE_GAIN gain10 = start_gain10 + gain_delta10 * i;
-        pDest[i * 2] = pSrc0[i * 2] * gain0 +
-                       pSrc1[i * 2] * gain1 +
-                       pSrc2[i * 2] * gain2 +
-                       pSrc3[i * 2] * gain3 +
-                       pSrc4[i * 2] * gain4 +
-                       pSrc5[i * 2] * gain5 +
-                       pSrc6[i * 2] * gain6 +
-                       pSrc7[i * 2] * gain7 +
-                       pSrc8[i * 2] * gain8 +
-                       pSrc9[i * 2] * gain9 +
-                       pSrc10[i * 2] * gain10;
-        pDest[i * 2 + 1] = pSrc0[i * 2 + 1] * gain0 +
-                           pSrc1[i * 2 + 1] * gain1 +
-                           pSrc2[i * 2 + 1] * gain2 +
-                           pSrc3[i * 2 + 1] * gain3 +
-                           pSrc4[i * 2 + 1] * gain4 +
-                           pSrc5[i * 2 + 1] * gain5 +
-                           pSrc6[i * 2 + 1] * gain6 +
-                           pSrc7[i * 2 + 1] * gain7 +
-                           pSrc8[i * 2 + 1] * gain8 +
-                           pSrc9[i * 2 + 1] * gain9 +
-                           pSrc10[i * 2 + 1] * gain10;
-    }
+    const CSAMPLE* const pSrc[11] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10};
+    const CSAMPLE_GAIN start_gain[11] = {start_gain0, start_gain1, start_gain2, start_gain3, start_gain4, start_gain5, start_gain6, start_gain7, start_gain8, start_gain9, start_gain10};
+    const CSAMPLE_GAIN gain_delta[11] = {gain_delta0, gain_delta1, gain_delta2, gain_delta3, gain_delta4, gain_delta5, gain_delta6, gain_delta7, gain_delta8, gain_delta9, gain_delta10};
+    copyMultipleWithRampingGain(pDest, pSrc, start_gain, gain_delta, 11, iNumSamples / 2);
 }
 static inline void copy12WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
@@ -1254,21 +1022,9 @@ static inline void copy12WithGain(CSAMPLE* M_RESTRICT pDest,
         copy11WithGain(pDest, pSrc0, gain0, pSrc1, gain1, pSrc2, gain2, pSrc3, gain3, pSrc4, gain4, pSrc5, gain5, pSrc6, gain6, pSrc7, gain7, pSrc8, gain8, pSrc9, gain9, pSrc10, gain10, iNumSamples);
         return;
     }
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples; ++i) {
-        pDest[i] = pSrc0[i] * gain0 +
-                   pSrc1[i] * gain1 +
-                   pSrc2[i] * gain2 +
-                   pSrc3[i] * gain3 +
-                   pSrc4[i] * gain4 +
-                   pSrc5[i] * gain5 +
-                   pSrc6[i] * gain6 +
-                   pSrc7[i] * gain7 +
-                   pSrc8[i] * gain8 +
-                   pSrc9[i] * gain9 +
-                   pSrc10[i] * gain10 +
-                   pSrc11[i] * gain11;
-    }
+    const CSAMPLE* const pSrc[12] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11};
+    const CSAMPLE_GAIN gain[12] = {gain0, gain1, gain2, gain3, gain4, gain5, gain6, gain7, gain8, gain9, gain10, gain11};
+    copyMultipleWithGain(pDest, pSrc, gain, 12, iNumSamples);
 }
 static inline void copy12WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
@@ -1356,45 +1112,10 @@ static inline void copy12WithRampingGain(CSAMPLE* M_RESTRICT pDest,
     const CSAMPLE_GAIN start_gain10 = gain10in + gain_delta10;
     const CSAMPLE_GAIN gain_delta11 = (gain11out - gain11in) / (iNumSamples / 2);
     const CSAMPLE_GAIN start_gain11 = gain11in + gain_delta11;
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples / 2; ++i) {
-        const CSAMPLE_GAIN gain0 = start_gain0 + gain_delta0 * i;
-        const CSAMPLE_GAIN gain1 = start_gain1 + gain_delta1 * i;
-        const CSAMPLE_GAIN gain2 = start_gain2 + gain_delta2 * i;
-        const CSAMPLE_GAIN gain3 = start_gain3 + gain_delta3 * i;
-        const CSAMPLE_GAIN gain4 = start_gain4 + gain_delta4 * i;
-        const CSAMPLE_GAIN gain5 = start_gain5 + gain_delta5 * i;
-        const CSAMPLE_GAIN gain6 = start_gain6 + gain_delta6 * i;
-        const CSAMPLE_GAIN gain7 = start_gain7 + gain_delta7 * i;
-        const CSAMPLE_GAIN gain8 = start_gain8 + gain_delta8 * i;
-        const CSAMPLE_GAIN gain9 = start_gain9 + gain_delta9 * i;
-        const CSAMPLE_GAIN gain10 = start_gain10 + gain_delta10 * i;
-        const CSAMPLE_GAIN gain11 = start_gain11 + gain_delta11 * i;
-        pDest[i * 2] = pSrc0[i * 2] * gain0 +
-                       pSrc1[i * 2] * gain1 +
-                       pSrc2[i * 2] * gain2 +
-                       pSrc3[i * 2] * gain3 +
-                       pSrc4[i * 2] * gain4 +
-                       pSrc5[i * 2] * gain5 +
-                       pSrc6[i * 2] * gain6 +
-                       pSrc7[i * 2] * gain7 +
-                       pSrc8[i * 2] * gain8 +
-                       pSrc9[i * 2] * gain9 +
-                       pSrc10[i * 2] * gain10 +
-                       pSrc11[i * 2] * gain11;
-        pDest[i * 2 + 1] = pSrc0[i * 2 + 1] * gain0 +
-                           pSrc1[i * 2 + 1] * gain1 +
-                           pSrc2[i * 2 + 1] * gain2 +
-                           pSrc3[i * 2 + 1] * gain3 +
-                           pSrc4[i * 2 + 1] * gain4 +
-                           pSrc5[i * 2 + 1] * gain5 +
-                           pSrc6[i * 2 + 1] * gain6 +
-                           pSrc7[i * 2 + 1] * gain7 +
-                           pSrc8[i * 2 + 1] * gain8 +
-                           pSrc9[i * 2 + 1] * gain9 +
-                           pSrc10[i * 2 + 1] * gain10 +
-                           pSrc11[i * 2 + 1] * gain11;
-    }
+    const CSAMPLE* const pSrc[12] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11};
+    const CSAMPLE_GAIN start_gain[12] = {start_gain0, start_gain1, start_gain2, start_gain3, start_gain4, start_gain5, start_gain6, start_gain7, start_gain8, start_gain9, start_gain10, start_gain11};
+    const CSAMPLE_GAIN gain_delta[12] = {gain_delta0, gain_delta1, gain_delta2, gain_delta3, gain_delta4, gain_delta5, gain_delta6, gain_delta7, gain_delta8, gain_delta9, gain_delta10, gain_delta11};
+    copyMultipleWithRampingGain(pDest, pSrc, start_gain, gain_delta, 12, iNumSamples / 2);
 }
 static inline void copy13WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
@@ -1463,22 +1184,9 @@ static inline void copy13WithGain(CSAMPLE* M_RESTRICT pDest,
         copy12WithGain(pDest, pSrc0, gain0, pSrc1, gain1, pSrc2, gain2, pSrc3, gain3, pSrc4, gain4, pSrc5, gain5, pSrc6, gain6, pSrc7, gain7, pSrc8, gain8, pSrc9, gain9, pSrc10, gain10, pSrc11, gain11, iNumSamples);
         return;
     }
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples; ++i) {
-        pDest[i] = pSrc0[i] * gain0 +
-                   pSrc1[i] * gain1 +
-                   pSrc2[i] * gain2 +
-                   pSrc3[i] * gain3 +
-                   pSrc4[i] * gain4 +
-                   pSrc5[i] * gain5 +
-                   pSrc6[i] * gain6 +
-                   pSrc7[i] * gain7 +
-                   pSrc8[i] * gain8 +
-                   pSrc9[i] * gain9 +
-                   pSrc10[i] * gain10 +
-                   pSrc11[i] * gain11 +
-                   pSrc12[i] * gain12;
-    }
+    const CSAMPLE* const pSrc[13] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12};
+    const CSAMPLE_GAIN gain[13] = {gain0, gain1, gain2, gain3, gain4, gain5, gain6, gain7, gain8, gain9, gain10, gain11, gain12};
+    copyMultipleWithGain(pDest, pSrc, gain, 13, iNumSamples);
 }
 static inline void copy13WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
@@ -1573,48 +1281,10 @@ static inline void copy13WithRampingGain(CSAMPLE* M_RESTRICT pDest,
     const CSAMPLE_GAIN start_gain11 = gain11in + gain_delta11;
     const CSAMPLE_GAIN gain_delta12 = (gain12out - gain12in) / (iNumSamples / 2);
     const CSAMPLE_GAIN start_gain12 = gain12in + gain_delta12;
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples / 2; ++i) {
-        const CSAMPLE_GAIN gain0 = start_gain0 + gain_delta0 * i;
-        const CSAMPLE_GAIN gain1 = start_gain1 + gain_delta1 * i;
-        const CSAMPLE_GAIN gain2 = start_gain2 + gain_delta2 * i;
-        const CSAMPLE_GAIN gain3 = start_gain3 + gain_delta3 * i;
-        const CSAMPLE_GAIN gain4 = start_gain4 + gain_delta4 * i;
-        const CSAMPLE_GAIN gain5 = start_gain5 + gain_delta5 * i;
-        const CSAMPLE_GAIN gain6 = start_gain6 + gain_delta6 * i;
-        const CSAMPLE_GAIN gain7 = start_gain7 + gain_delta7 * i;
-        const CSAMPLE_GAIN gain8 = start_gain8 + gain_delta8 * i;
-        const CSAMPLE_GAIN gain9 = start_gain9 + gain_delta9 * i;
-        const CSAMPLE_GAIN gain10 = start_gain10 + gain_delta10 * i;
-        const CSAMPLE_GAIN gain11 = start_gain11 + gain_delta11 * i;
-        const CSAMPLE_GAIN gain12 = start_gain12 + gain_delta12 * i;
-        pDest[i * 2] = pSrc0[i * 2] * gain0 +
-                       pSrc1[i * 2] * gain1 +
-                       pSrc2[i * 2] * gain2 +
-                       pSrc3[i * 2] * gain3 +
-                       pSrc4[i * 2] * gain4 +
-                       pSrc5[i * 2] * gain5 +
-                       pSrc6[i * 2] * gain6 +
-                       pSrc7[i * 2] * gain7 +
-                       pSrc8[i * 2] * gain8 +
-                       pSrc9[i * 2] * gain9 +
-                       pSrc10[i * 2] * gain10 +
-                       pSrc11[i * 2] * gain11 +
-                       pSrc12[i * 2] * gain12;
-        pDest[i * 2 + 1] = pSrc0[i * 2 + 1] * gain0 +
-                           pSrc1[i * 2 + 1] * gain1 +
-                           pSrc2[i * 2 + 1] * gain2 +
-                           pSrc3[i * 2 + 1] * gain3 +
-                           pSrc4[i * 2 + 1] * gain4 +
-                           pSrc5[i * 2 + 1] * gain5 +
-                           pSrc6[i * 2 + 1] * gain6 +
-                           pSrc7[i * 2 + 1] * gain7 +
-                           pSrc8[i * 2 + 1] * gain8 +
-                           pSrc9[i * 2 + 1] * gain9 +
-                           pSrc10[i * 2 + 1] * gain10 +
-                           pSrc11[i * 2 + 1] * gain11 +
-                           pSrc12[i * 2 + 1] * gain12;
-    }
+    const CSAMPLE* const pSrc[13] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12};
+    const CSAMPLE_GAIN start_gain[13] = {start_gain0, start_gain1, start_gain2, start_gain3, start_gain4, start_gain5, start_gain6, start_gain7, start_gain8, start_gain9, start_gain10, start_gain11, start_gain12};
+    const CSAMPLE_GAIN gain_delta[13] = {gain_delta0, gain_delta1, gain_delta2, gain_delta3, gain_delta4, gain_delta5, gain_delta6, gain_delta7, gain_delta8, gain_delta9, gain_delta10, gain_delta11, gain_delta12};
+    copyMultipleWithRampingGain(pDest, pSrc, start_gain, gain_delta, 13, iNumSamples / 2);
 }
 static inline void copy14WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
@@ -1688,23 +1358,9 @@ static inline void copy14WithGain(CSAMPLE* M_RESTRICT pDest,
         copy13WithGain(pDest, pSrc0, gain0, pSrc1, gain1, pSrc2, gain2, pSrc3, gain3, pSrc4, gain4, pSrc5, gain5, pSrc6, gain6, pSrc7, gain7, pSrc8, gain8, pSrc9, gain9, pSrc10, gain10, pSrc11, gain11, pSrc12, gain12, iNumSamples);
         return;
     }
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples; ++i) {
-        pDest[i] = pSrc0[i] * gain0 +
-                   pSrc1[i] * gain1 +
-                   pSrc2[i] * gain2 +
-                   pSrc3[i] * gain3 +
-                   pSrc4[i] * gain4 +
-                   pSrc5[i] * gain5 +
-                   pSrc6[i] * gain6 +
-                   pSrc7[i] * gain7 +
-                   pSrc8[i] * gain8 +
-                   pSrc9[i] * gain9 +
-                   pSrc10[i] * gain10 +
-                   pSrc11[i] * gain11 +
-                   pSrc12[i] * gain12 +
-                   pSrc13[i] * gain13;
-    }
+    const CSAMPLE* const pSrc[14] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13};
+    const CSAMPLE_GAIN gain[14] = {gain0, gain1, gain2, gain3, gain4, gain5, gain6, gain7, gain8, gain9, gain10, gain11, gain12, gain13};
+    copyMultipleWithGain(pDest, pSrc, gain, 14, iNumSamples);
 }
 static inline void copy14WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
@@ -1806,51 +1462,10 @@ static inline void copy14WithRampingGain(CSAMPLE* M_RESTRICT pDest,
     const CSAMPLE_GAIN start_gain12 = gain12in + gain_delta12;
     const CSAMPLE_GAIN gain_delta13 = (gain13out - gain13in) / (iNumSamples / 2);
     const CSAMPLE_GAIN start_gain13 = gain13in + gain_delta13;
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples / 2; ++i) {
-        const CSAMPLE_GAIN gain0 = start_gain0 + gain_delta0 * i;
-        const CSAMPLE_GAIN gain1 = start_gain1 + gain_delta1 * i;
-        const CSAMPLE_GAIN gain2 = start_gain2 + gain_delta2 * i;
-        const CSAMPLE_GAIN gain3 = start_gain3 + gain_delta3 * i;
-        const CSAMPLE_GAIN gain4 = start_gain4 + gain_delta4 * i;
-        const CSAMPLE_GAIN gain5 = start_gain5 + gain_delta5 * i;
-        const CSAMPLE_GAIN gain6 = start_gain6 + gain_delta6 * i;
-        const CSAMPLE_GAIN gain7 = start_gain7 + gain_delta7 * i;
-        const CSAMPLE_GAIN gain8 = start_gain8 + gain_delta8 * i;
-        const CSAMPLE_GAIN gain9 = start_gain9 + gain_delta9 * i;
-        const CSAMPLE_GAIN gain10 = start_gain10 + gain_delta10 * i;
-        const CSAMPLE_GAIN gain11 = start_gain11 + gain_delta11 * i;
-        const CSAMPLE_GAIN gain12 = start_gain12 + gain_delta12 * i;
-        const CSAMPLE_GAIN gain13 = start_gain13 + gain_delta13 * i;
-        pDest[i * 2] = pSrc0[i * 2] * gain0 +
-                       pSrc1[i * 2] * gain1 +
-                       pSrc2[i * 2] * gain2 +
-                       pSrc3[i * 2] * gain3 +
-                       pSrc4[i * 2] * gain4 +
-                       pSrc5[i * 2] * gain5 +
-                       pSrc6[i * 2] * gain6 +
-                       pSrc7[i * 2] * gain7 +
-                       pSrc8[i * 2] * gain8 +
-                       pSrc9[i * 2] * gain9 +
-                       pSrc10[i * 2] * gain10 +
-                       pSrc11[i * 2] * gain11 +
-                       pSrc12[i * 2] * gain12 +
-                       pSrc13[i * 2] * gain13;
-        pDest[i * 2 + 1] = pSrc0[i * 2 + 1] * gain0 +
-                           pSrc1[i * 2 + 1] * gain1 +
-                           pSrc2[i * 2 + 1] * gain2 +
-                           pSrc3[i * 2 + 1] * gain3 +
-                           pSrc4[i * 2 + 1] * gain4 +
-                           pSrc5[i * 2 + 1] * gain5 +
-                           pSrc6[i * 2 + 1] * gain6 +
-                           pSrc7[i * 2 + 1] * gain7 +
-                           pSrc8[i * 2 + 1] * gain8 +
-                           pSrc9[i * 2 + 1] * gain9 +
-                           pSrc10[i * 2 + 1] * gain10 +
-                           pSrc11[i * 2 + 1] * gain11 +
-                           pSrc12[i * 2 + 1] * gain12 +
-                           pSrc13[i * 2 + 1] * gain13;
-    }
+    const CSAMPLE* const pSrc[14] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13};
+    const CSAMPLE_GAIN start_gain[14] = {start_gain0, start_gain1, start_gain2, start_gain3, start_gain4, start_gain5, start_gain6, start_gain7, start_gain8, start_gain9, start_gain10, start_gain11, start_gain12, start_gain13};
+    const CSAMPLE_GAIN gain_delta[14] = {gain_delta0, gain_delta1, gain_delta2, gain_delta3, gain_delta4, gain_delta5, gain_delta6, gain_delta7, gain_delta8, gain_delta9, gain_delta10, gain_delta11, gain_delta12, gain_delta13};
+    copyMultipleWithRampingGain(pDest, pSrc, start_gain, gain_delta, 14, iNumSamples / 2);
 }
 static inline void copy15WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
@@ -1929,24 +1544,9 @@ static inline void copy15WithGain(CSAMPLE* M_RESTRICT pDest,
         copy14WithGain(pDest, pSrc0, gain0, pSrc1, gain1, pSrc2, gain2, pSrc3, gain3, pSrc4, gain4, pSrc5, gain5, pSrc6, gain6, pSrc7, gain7, pSrc8, gain8, pSrc9, gain9, pSrc10, gain10, pSrc11, gain11, pSrc12, gain12, pSrc13, gain13, iNumSamples);
         return;
     }
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples; ++i) {
-        pDest[i] = pSrc0[i] * gain0 +
-                   pSrc1[i] * gain1 +
-                   pSrc2[i] * gain2 +
-                   pSrc3[i] * gain3 +
-                   pSrc4[i] * gain4 +
-                   pSrc5[i] * gain5 +
-                   pSrc6[i] * gain6 +
-                   pSrc7[i] * gain7 +
-                   pSrc8[i] * gain8 +
-                   pSrc9[i] * gain9 +
-                   pSrc10[i] * gain10 +
-                   pSrc11[i] * gain11 +
-                   pSrc12[i] * gain12 +
-                   pSrc13[i] * gain13 +
-                   pSrc14[i] * gain14;
-    }
+    const CSAMPLE* const pSrc[15] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14};
+    const CSAMPLE_GAIN gain[15] = {gain0, gain1, gain2, gain3, gain4, gain5, gain6, gain7, gain8, gain9, gain10, gain11, gain12, gain13, gain14};
+    copyMultipleWithGain(pDest, pSrc, gain, 15, iNumSamples);
 }
 static inline void copy15WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
@@ -2055,54 +1655,10 @@ static inline void copy15WithRampingGain(CSAMPLE* M_RESTRICT pDest,
     const CSAMPLE_GAIN start_gain13 = gain13in + gain_delta13;
     const CSAMPLE_GAIN gain_delta14 = (gain14out - gain14in) / (iNumSamples / 2);
     const CSAMPLE_GAIN start_gain14 = gain14in + gain_delta14;
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples / 2; ++i) {
-        const CSAMPLE_GAIN gain0 = start_gain0 + gain_delta0 * i;
-        const CSAMPLE_GAIN gain1 = start_gain1 + gain_delta1 * i;
-        const CSAMPLE_GAIN gain2 = start_gain2 + gain_delta2 * i;
-        const CSAMPLE_GAIN gain3 = start_gain3 + gain_delta3 * i;
-        const CSAMPLE_GAIN gain4 = start_gain4 + gain_delta4 * i;
-        const CSAMPLE_GAIN gain5 = start_gain5 + gain_delta5 * i;
-        const CSAMPLE_GAIN gain6 = start_gain6 + gain_delta6 * i;
-        const CSAMPLE_GAIN gain7 = start_gain7 + gain_delta7 * i;
-        const CSAMPLE_GAIN gain8 = start_gain8 + gain_delta8 * i;
-        const CSAMPLE_GAIN gain9 = start_gain9 + gain_delta9 * i;
-        const CSAMPLE_GAIN gain10 = start_gain10 + gain_delta10 * i;
-        const CSAMPLE_GAIN gain11 = start_gain11 + gain_delta11 * i;
-        const CSAMPLE_GAIN gain12 = start_gain12 + gain_delta12 * i;
-        const CSAMPLE_GAIN gain13 = start_gain13 + gain_delta13 * i;
-        const CSAMPLE_GAIN gain14 = start_gain14 + gain_delta14 * i;
-        pDest[i * 2] = pSrc0[i * 2] * gain0 +
-                       pSrc1[i * 2] * gain1 +
-                       pSrc2[i * 2] * gain2 +
-                       pSrc3[i * 2] * gain3 +
-                       pSrc4[i * 2] * gain4 +
-                       pSrc5[i * 2] * gain5 +
-                       pSrc6[i * 2] * gain6 +
-                       pSrc7[i * 2] * gain7 +
-                       pSrc8[i * 2] * gain8 +
-                       pSrc9[i * 2] * gain9 +
-                       pSrc10[i * 2] * gain10 +
-                       pSrc11[i * 2] * gain11 +
-                       pSrc12[i * 2] * gain12 +
-                       pSrc13[i * 2] * gain13 +
-                       pSrc14[i * 2] * gain14;
-        pDest[i * 2 + 1] = pSrc0[i * 2 + 1] * gain0 +
-                           pSrc1[i * 2 + 1] * gain1 +
-                           pSrc2[i * 2 + 1] * gain2 +
-                           pSrc3[i * 2 + 1] * gain3 +
-                           pSrc4[i * 2 + 1] * gain4 +
-                           pSrc5[i * 2 + 1] * gain5 +
-                           pSrc6[i * 2 + 1] * gain6 +
-                           pSrc7[i * 2 + 1] * gain7 +
-                           pSrc8[i * 2 + 1] * gain8 +
-                           pSrc9[i * 2 + 1] * gain9 +
-                           pSrc10[i * 2 + 1] * gain10 +
-                           pSrc11[i * 2 + 1] * gain11 +
-                           pSrc12[i * 2 + 1] * gain12 +
-                           pSrc13[i * 2 + 1] * gain13 +
-                           pSrc14[i * 2 + 1] * gain14;
-    }
+    const CSAMPLE* const pSrc[15] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14};
+    const CSAMPLE_GAIN start_gain[15] = {start_gain0, start_gain1, start_gain2, start_gain3, start_gain4, start_gain5, start_gain6, start_gain7, start_gain8, start_gain9, start_gain10, start_gain11, start_gain12, start_gain13, start_gain14};
+    const CSAMPLE_GAIN gain_delta[15] = {gain_delta0, gain_delta1, gain_delta2, gain_delta3, gain_delta4, gain_delta5, gain_delta6, gain_delta7, gain_delta8, gain_delta9, gain_delta10, gain_delta11, gain_delta12, gain_delta13, gain_delta14};
+    copyMultipleWithRampingGain(pDest, pSrc, start_gain, gain_delta, 15, iNumSamples / 2);
 }
 static inline void copy16WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
@@ -2186,25 +1742,9 @@ static inline void copy16WithGain(CSAMPLE* M_RESTRICT pDest,
         copy15WithGain(pDest, pSrc0, gain0, pSrc1, gain1, pSrc2, gain2, pSrc3, gain3, pSrc4, gain4, pSrc5, gain5, pSrc6, gain6, pSrc7, gain7, pSrc8, gain8, pSrc9, gain9, pSrc10, gain10, pSrc11, gain11, pSrc12, gain12, pSrc13, gain13, pSrc14, gain14, iNumSamples);
         return;
     }
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples; ++i) {
-        pDest[i] = pSrc0[i] * gain0 +
-                   pSrc1[i] * gain1 +
-                   pSrc2[i] * gain2 +
-                   pSrc3[i] * gain3 +
-                   pSrc4[i] * gain4 +
-                   pSrc5[i] * gain5 +
-                   pSrc6[i] * gain6 +
-                   pSrc7[i] * gain7 +
-                   pSrc8[i] * gain8 +
-                   pSrc9[i] * gain9 +
-                   pSrc10[i] * gain10 +
-                   pSrc11[i] * gain11 +
-                   pSrc12[i] * gain12 +
-                   pSrc13[i] * gain13 +
-                   pSrc14[i] * gain14 +
-                   pSrc15[i] * gain15;
-    }
+    const CSAMPLE* const pSrc[16] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15};
+    const CSAMPLE_GAIN gain[16] = {gain0, gain1, gain2, gain3, gain4, gain5, gain6, gain7, gain8, gain9, gain10, gain11, gain12, gain13, gain14, gain15};
+    copyMultipleWithGain(pDest, pSrc, gain, 16, iNumSamples);
 }
 static inline void copy16WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
@@ -2320,57 +1860,10 @@ static inline void copy16WithRampingGain(CSAMPLE* M_RESTRICT pDest,
     const CSAMPLE_GAIN start_gain14 = gain14in + gain_delta14;
     const CSAMPLE_GAIN gain_delta15 = (gain15out - gain15in) / (iNumSamples / 2);
     const CSAMPLE_GAIN start_gain15 = gain15in + gain_delta15;
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples / 2; ++i) {
-        const CSAMPLE_GAIN gain0 = start_gain0 + gain_delta0 * i;
-        const CSAMPLE_GAIN gain1 = start_gain1 + gain_delta1 * i;
-        const CSAMPLE_GAIN gain2 = start_gain2 + gain_delta2 * i;
-        const CSAMPLE_GAIN gain3 = start_gain3 + gain_delta3 * i;
-        const CSAMPLE_GAIN gain4 = start_gain4 + gain_delta4 * i;
-        const CSAMPLE_GAIN gain5 = start_gain5 + gain_delta5 * i;
-        const CSAMPLE_GAIN gain6 = start_gain6 + gain_delta6 * i;
-        const CSAMPLE_GAIN gain7 = start_gain7 + gain_delta7 * i;
-        const CSAMPLE_GAIN gain8 = start_gain8 + gain_delta8 * i;
-        const CSAMPLE_GAIN gain9 = start_gain9 + gain_delta9 * i;
-        const CSAMPLE_GAIN gain10 = start_gain10 + gain_delta10 * i;
-        const CSAMPLE_GAIN gain11 = start_gain11 + gain_delta11 * i;
-        const CSAMPLE_GAIN gain12 = start_gain12 + gain_delta12 * i;
-        const CSAMPLE_GAIN gain13 = start_gain13 + gain_delta13 * i;
-        const CSAMPLE_GAIN gain14 = start_gain14 + gain_delta14 * i;
-        const CSAMPLE_GAIN gain15 = start_gain15 + gain_delta15 * i;
-        pDest[i * 2] = pSrc0[i * 2] * gain0 +
-                       pSrc1[i * 2] * gain1 +
-                       pSrc2[i * 2] * gain2 +
-                       pSrc3[i * 2] * gain3 +
-                       pSrc4[i * 2] * gain4 +
-                       pSrc5[i * 2] * gain5 +
-                       pSrc6[i * 2] * gain6 +
-                       pSrc7[i * 2] * gain7 +
-                       pSrc8[i * 2] * gain8 +
-                       pSrc9[i * 2] * gain9 +
-                       pSrc10[i * 2] * gain10 +
-                       pSrc11[i * 2] * gain11 +
-                       pSrc12[i * 2] * gain12 +
-                       pSrc13[i * 2] * gain13 +
-                       pSrc14[i * 2] * gain14 +
-                       pSrc15[i * 2] * gain15;
-        pDest[i * 2 + 1] = pSrc0[i * 2 + 1] * gain0 +
-                           pSrc1[i * 2 + 1] * gain1 +
-                           pSrc2[i * 2 + 1] * gain2 +
-                           pSrc3[i * 2 + 1] * gain3 +
-                           pSrc4[i * 2 + 1] * gain4 +
-                           pSrc5[i * 2 + 1] * gain5 +
-                           pSrc6[i * 2 + 1] * gain6 +
-                           pSrc7[i * 2 + 1] * gain7 +
-                           pSrc8[i * 2 + 1] * gain8 +
-                           pSrc9[i * 2 + 1] * gain9 +
-                           pSrc10[i * 2 + 1] * gain10 +
-                           pSrc11[i * 2 + 1] * gain11 +
-                           pSrc12[i * 2 + 1] * gain12 +
-                           pSrc13[i * 2 + 1] * gain13 +
-                           pSrc14[i * 2 + 1] * gain14 +
-                           pSrc15[i * 2 + 1] * gain15;
-    }
+    const CSAMPLE* const pSrc[16] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15};
+    const CSAMPLE_GAIN start_gain[16] = {start_gain0, start_gain1, start_gain2, start_gain3, start_gain4, start_gain5, start_gain6, start_gain7, start_gain8, start_gain9, start_gain10, start_gain11, start_gain12, start_gain13, start_gain14, start_gain15};
+    const CSAMPLE_GAIN gain_delta[16] = {gain_delta0, gain_delta1, gain_delta2, gain_delta3, gain_delta4, gain_delta5, gain_delta6, gain_delta7, gain_delta8, gain_delta9, gain_delta10, gain_delta11, gain_delta12, gain_delta13, gain_delta14, gain_delta15};
+    copyMultipleWithRampingGain(pDest, pSrc, start_gain, gain_delta, 16, iNumSamples / 2);
 }
 static inline void copy17WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
@@ -2459,26 +1952,9 @@ static inline void copy17WithGain(CSAMPLE* M_RESTRICT pDest,
         copy16WithGain(pDest, pSrc0, gain0, pSrc1, gain1, pSrc2, gain2, pSrc3, gain3, pSrc4, gain4, pSrc5, gain5, pSrc6, gain6, pSrc7, gain7, pSrc8, gain8, pSrc9, gain9, pSrc10, gain10, pSrc11, gain11, pSrc12, gain12, pSrc13, gain13, pSrc14, gain14, pSrc15, gain15, iNumSamples);
         return;
     }
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples; ++i) {
-        pDest[i] = pSrc0[i] * gain0 +
-                   pSrc1[i] * gain1 +
-                   pSrc2[i] * gain2 +
-                   pSrc3[i] * gain3 +
-                   pSrc4[i] * gain4 +
-                   pSrc5[i] * gain5 +
-                   pSrc6[i] * gain6 +
-                   pSrc7[i] * gain7 +
-                   pSrc8[i] * gain8 +
-                   pSrc9[i] * gain9 +
-                   pSrc10[i] * gain10 +
-                   pSrc11[i] * gain11 +
-                   pSrc12[i] * gain12 +
-                   pSrc13[i] * gain13 +
-                   pSrc14[i] * gain14 +
-                   pSrc15[i] * gain15 +
-                   pSrc16[i] * gain16;
-    }
+    const CSAMPLE* const pSrc[17] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15, pSrc16};
+    const CSAMPLE_GAIN gain[17] = {gain0, gain1, gain2, gain3, gain4, gain5, gain6, gain7, gain8, gain9, gain10, gain11, gain12, gain13, gain14, gain15, gain16};
+    copyMultipleWithGain(pDest, pSrc, gain, 17, iNumSamples);
 }
 static inline void copy17WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
@@ -2601,60 +2077,10 @@ static inline void copy17WithRampingGain(CSAMPLE* M_RESTRICT pDest,
     const CSAMPLE_GAIN start_gain15 = gain15in + gain_delta15;
     const CSAMPLE_GAIN gain_delta16 = (gain16out - gain16in) / (iNumSamples / 2);
     const CSAMPLE_GAIN start_gain16 = gain16in + gain_delta16;
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples / 2; ++i) {
-        const CSAMPLE_GAIN gain0 = start_gain0 + gain_delta0 * i;
-        const CSAMPLE_GAIN gain1 = start_gain1 + gain_delta1 * i;
-        const CSAMPLE_GAIN gain2 = start_gain2 + gain_delta2 * i;
-        const CSAMPLE_GAIN gain3 = start_gain3 + gain_delta3 * i;
-        const CSAMPLE_GAIN gain4 = start_gain4 + gain_delta4 * i;
-        const CSAMPLE_GAIN gain5 = start_gain5 + gain_delta5 * i;
-        const CSAMPLE_GAIN gain6 = start_gain6 + gain_delta6 * i;
-        const CSAMPLE_GAIN gain7 = start_gain7 + gain_delta7 * i;
-        const CSAMPLE_GAIN gain8 = start_gain8 + gain_delta8 * i;
-        const CSAMPLE_GAIN gain9 = start_gain9 + gain_delta9 * i;
-        const CSAMPLE_GAIN gain10 = start_gain10 + gain_delta10 * i;
-        const CSAMPLE_GAIN gain11 = start_gain11 + gain_delta11 * i;
-        const CSAMPLE_GAIN gain12 = start_gain12 + gain_delta12 * i;
-        const CSAMPLE_GAIN gain13 = start_gain13 + gain_delta13 * i;
-        const CSAMPLE_GAIN gain14 = start_gain14 + gain_delta14 * i;
-        const CSAMPLE_GAIN gain15 = start_gain15 + gain_delta15 * i;
-        const CSAMPLE_GAIN gain16 = start_gain16 + gain_delta16 * i;
-        pDest[i * 2] = pSrc0[i * 2] * gain0 +
-                       pSrc1[i * 2] * gain1 +
-                       pSrc2[i * 2] * gain2 +
-                       pSrc3[i * 2] * gain3 +
-                       pSrc4[i * 2] * gain4 +
-                       pSrc5[i * 2] * gain5 +
-                       pSrc6[i * 2] * gain6 +
-                       pSrc7[i * 2] * gain7 +
-                       pSrc8[i * 2] * gain8 +
-                       pSrc9[i * 2] * gain9 +
-                       pSrc10[i * 2] * gain10 +
-                       pSrc11[i * 2] * gain11 +
-                       pSrc12[i * 2] * gain12 +
-                       pSrc13[i * 2] * gain13 +
-                       pSrc14[i * 2] * gain14 +
-                       pSrc15[i * 2] * gain15 +
-                       pSrc16[i * 2] * gain16;
-        pDest[i * 2 + 1] = pSrc0[i * 2 + 1] * gain0 +
-                           pSrc1[i * 2 + 1] * gain1 +
-                           pSrc2[i * 2 + 1] * gain2 +
-                           pSrc3[i * 2 + 1] * gain3 +
-                           pSrc4[i * 2 + 1] * gain4 +
-                           pSrc5[i * 2 + 1] * gain5 +
-                           pSrc6[i * 2 + 1] * gain6 +
-                           pSrc7[i * 2 + 1] * gain7 +
-                           pSrc8[i * 2 + 1] * gain8 +
-                           pSrc9[i * 2 + 1] * gain9 +
-                           pSrc10[i * 2 + 1] * gain10 +
-                           pSrc11[i * 2 + 1] * gain11 +
-                           pSrc12[i * 2 + 1] * gain12 +
-                           pSrc13[i * 2 + 1] * gain13 +
-                           pSrc14[i * 2 + 1] * gain14 +
-                           pSrc15[i * 2 + 1] * gain15 +
-                           pSrc16[i * 2 + 1] * gain16;
-    }
+    const CSAMPLE* const pSrc[17] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15, pSrc16};
+    const CSAMPLE_GAIN start_gain[17] = {start_gain0, start_gain1, start_gain2, start_gain3, start_gain4, start_gain5, start_gain6, start_gain7, start_gain8, start_gain9, start_gain10, start_gain11, start_gain12, start_gain13, start_gain14, start_gain15, start_gain16};
+    const CSAMPLE_GAIN gain_delta[17] = {gain_delta0, gain_delta1, gain_delta2, gain_delta3, gain_delta4, gain_delta5, gain_delta6, gain_delta7, gain_delta8, gain_delta9, gain_delta10, gain_delta11, gain_delta12, gain_delta13, gain_delta14, gain_delta15, gain_delta16};
+    copyMultipleWithRampingGain(pDest, pSrc, start_gain, gain_delta, 17, iNumSamples / 2);
 }
 static inline void copy18WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
@@ -2748,27 +2174,9 @@ static inline void copy18WithGain(CSAMPLE* M_RESTRICT pDest,
         copy17WithGain(pDest, pSrc0, gain0, pSrc1, gain1, pSrc2, gain2, pSrc3, gain3, pSrc4, gain4, pSrc5, gain5, pSrc6, gain6, pSrc7, gain7, pSrc8, gain8, pSrc9, gain9, pSrc10, gain10, pSrc11, gain11, pSrc12, gain12, pSrc13, gain13, pSrc14, gain14, pSrc15, gain15, pSrc16, gain16, iNumSamples);
         return;
     }
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples; ++i) {
-        pDest[i] = pSrc0[i] * gain0 +
-                   pSrc1[i] * gain1 +
-                   pSrc2[i] * gain2 +
-                   pSrc3[i] * gain3 +
-                   pSrc4[i] * gain4 +
-                   pSrc5[i] * gain5 +
-                   pSrc6[i] * gain6 +
-                   pSrc7[i] * gain7 +
-                   pSrc8[i] * gain8 +
-                   pSrc9[i] * gain9 +
-                   pSrc10[i] * gain10 +
-                   pSrc11[i] * gain11 +
-                   pSrc12[i] * gain12 +
-                   pSrc13[i] * gain13 +
-                   pSrc14[i] * gain14 +
-                   pSrc15[i] * gain15 +
-                   pSrc16[i] * gain16 +
-                   pSrc17[i] * gain17;
-    }
+    const CSAMPLE* const pSrc[18] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15, pSrc16, pSrc17};
+    const CSAMPLE_GAIN gain[18] = {gain0, gain1, gain2, gain3, gain4, gain5, gain6, gain7, gain8, gain9, gain10, gain11, gain12, gain13, gain14, gain15, gain16, gain17};
+    copyMultipleWithGain(pDest, pSrc, gain, 18, iNumSamples);
 }
 static inline void copy18WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
@@ -2898,63 +2306,10 @@ static inline void copy18WithRampingGain(CSAMPLE* M_RESTRICT pDest,
     const CSAMPLE_GAIN start_gain16 = gain16in + gain_delta16;
     const CSAMPLE_GAIN gain_delta17 = (gain17out - gain17in) / (iNumSamples / 2);
     const CSAMPLE_GAIN start_gain17 = gain17in + gain_delta17;
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples / 2; ++i) {
-        const CSAMPLE_GAIN gain0 = start_gain0 + gain_delta0 * i;
-        const CSAMPLE_GAIN gain1 = start_gain1 + gain_delta1 * i;
-        const CSAMPLE_GAIN gain2 = start_gain2 + gain_delta2 * i;
-        const CSAMPLE_GAIN gain3 = start_gain3 + gain_delta3 * i;
-        const CSAMPLE_GAIN gain4 = start_gain4 + gain_delta4 * i;
-        const CSAMPLE_GAIN gain5 = start_gain5 + gain_delta5 * i;
-        const CSAMPLE_GAIN gain6 = start_gain6 + gain_delta6 * i;
-        const CSAMPLE_GAIN gain7 = start_gain7 + gain_delta7 * i;
-        const CSAMPLE_GAIN gain8 = start_gain8 + gain_delta8 * i;
-        const CSAMPLE_GAIN gain9 = start_gain9 + gain_delta9 * i;
-        const CSAMPLE_GAIN gain10 = start_gain10 + gain_delta10 * i;
-        const CSAMPLE_GAIN gain11 = start_gain11 + gain_delta11 * i;
-        const CSAMPLE_GAIN gain12 = start_gain12 + gain_delta12 * i;
-        const CSAMPLE_GAIN gain13 = start_gain13 + gain_delta13 * i;
-        const CSAMPLE_GAIN gain14 = start_gain14 + gain_delta14 * i;
-        const CSAMPLE_GAIN gain15 = start_gain15 + gain_delta15 * i;
-        const CSAMPLE_GAIN gain16 = start_gain16 + gain_delta16 * i;
-        const CSAMPLE_GAIN gain17 = start_gain17 + gain_delta17 * i;
-        pDest[i * 2] = pSrc0[i * 2] * gain0 +
-                       pSrc1[i * 2] * gain1 +
-                       pSrc2[i * 2] * gain2 +
-                       pSrc3[i * 2] * gain3 +
-                       pSrc4[i * 2] * gain4 +
-                       pSrc5[i * 2] * gain5 +
-                       pSrc6[i * 2] * gain6 +
-                       pSrc7[i * 2] * gain7 +
-                       pSrc8[i * 2] * gain8 +
-                       pSrc9[i * 2] * gain9 +
-                       pSrc10[i * 2] * gain10 +
-                       pSrc11[i * 2] * gain11 +
-                       pSrc12[i * 2] * gain12 +
-                       pSrc13[i * 2] * gain13 +
-                       pSrc14[i * 2] * gain14 +
-                       pSrc15[i * 2] * gain15 +
-                       pSrc16[i * 2] * gain16 +
-                       pSrc17[i * 2] * gain17;
-        pDest[i * 2 + 1] = pSrc0[i * 2 + 1] * gain0 +
-                           pSrc1[i * 2 + 1] * gain1 +
-                           pSrc2[i * 2 + 1] * gain2 +
-                           pSrc3[i * 2 + 1] * gain3 +
-                           pSrc4[i * 2 + 1] * gain4 +
-                           pSrc5[i * 2 + 1] * gain5 +
-                           pSrc6[i * 2 + 1] * gain6 +
-                           pSrc7[i * 2 + 1] * gain7 +
-                           pSrc8[i * 2 + 1] * gain8 +
-                           pSrc9[i * 2 + 1] * gain9 +
-                           pSrc10[i * 2 + 1] * gain10 +
-                           pSrc11[i * 2 + 1] * gain11 +
-                           pSrc12[i * 2 + 1] * gain12 +
-                           pSrc13[i * 2 + 1] * gain13 +
-                           pSrc14[i * 2 + 1] * gain14 +
-                           pSrc15[i * 2 + 1] * gain15 +
-                           pSrc16[i * 2 + 1] * gain16 +
-                           pSrc17[i * 2 + 1] * gain17;
-    }
+    const CSAMPLE* const pSrc[18] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15, pSrc16, pSrc17};
+    const CSAMPLE_GAIN start_gain[18] = {start_gain0, start_gain1, start_gain2, start_gain3, start_gain4, start_gain5, start_gain6, start_gain7, start_gain8, start_gain9, start_gain10, start_gain11, start_gain12, start_gain13, start_gain14, start_gain15, start_gain16, start_gain17};
+    const CSAMPLE_GAIN gain_delta[18] = {gain_delta0, gain_delta1, gain_delta2, gain_delta3, gain_delta4, gain_delta5, gain_delta6, gain_delta7, gain_delta8, gain_delta9, gain_delta10, gain_delta11, gain_delta12, gain_delta13, gain_delta14, gain_delta15, gain_delta16, gain_delta17};
+    copyMultipleWithRampingGain(pDest, pSrc, start_gain, gain_delta, 18, iNumSamples / 2);
 }
 static inline void copy19WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
@@ -3053,28 +2408,9 @@ static inline void copy19WithGain(CSAMPLE* M_RESTRICT pDest,
         copy18WithGain(pDest, pSrc0, gain0, pSrc1, gain1, pSrc2, gain2, pSrc3, gain3, pSrc4, gain4, pSrc5, gain5, pSrc6, gain6, pSrc7, gain7, pSrc8, gain8, pSrc9, gain9, pSrc10, gain10, pSrc11, gain11, pSrc12, gain12, pSrc13, gain13, pSrc14, gain14, pSrc15, gain15, pSrc16, gain16, pSrc17, gain17, iNumSamples);
         return;
     }
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples; ++i) {
-        pDest[i] = pSrc0[i] * gain0 +
-                   pSrc1[i] * gain1 +
-                   pSrc2[i] * gain2 +
-                   pSrc3[i] * gain3 +
-                   pSrc4[i] * gain4 +
-                   pSrc5[i] * gain5 +
-                   pSrc6[i] * gain6 +
-                   pSrc7[i] * gain7 +
-                   pSrc8[i] * gain8 +
-                   pSrc9[i] * gain9 +
-                   pSrc10[i] * gain10 +
-                   pSrc11[i] * gain11 +
-                   pSrc12[i] * gain12 +
-                   pSrc13[i] * gain13 +
-                   pSrc14[i] * gain14 +
-                   pSrc15[i] * gain15 +
-                   pSrc16[i] * gain16 +
-                   pSrc17[i] * gain17 +
-                   pSrc18[i] * gain18;
-    }
+    const CSAMPLE* const pSrc[19] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15, pSrc16, pSrc17, pSrc18};
+    const CSAMPLE_GAIN gain[19] = {gain0, gain1, gain2, gain3, gain4, gain5, gain6, gain7, gain8, gain9, gain10, gain11, gain12, gain13, gain14, gain15, gain16, gain17, gain18};
+    copyMultipleWithGain(pDest, pSrc, gain, 19, iNumSamples);
 }
 static inline void copy19WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
@@ -3211,66 +2547,10 @@ static inline void copy19WithRampingGain(CSAMPLE* M_RESTRICT pDest,
     const CSAMPLE_GAIN start_gain17 = gain17in + gain_delta17;
     const CSAMPLE_GAIN gain_delta18 = (gain18out - gain18in) / (iNumSamples / 2);
     const CSAMPLE_GAIN start_gain18 = gain18in + gain_delta18;
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples / 2; ++i) {
-        const CSAMPLE_GAIN gain0 = start_gain0 + gain_delta0 * i;
-        const CSAMPLE_GAIN gain1 = start_gain1 + gain_delta1 * i;
-        const CSAMPLE_GAIN gain2 = start_gain2 + gain_delta2 * i;
-        const CSAMPLE_GAIN gain3 = start_gain3 + gain_delta3 * i;
-        const CSAMPLE_GAIN gain4 = start_gain4 + gain_delta4 * i;
-        const CSAMPLE_GAIN gain5 = start_gain5 + gain_delta5 * i;
-        const CSAMPLE_GAIN gain6 = start_gain6 + gain_delta6 * i;
-        const CSAMPLE_GAIN gain7 = start_gain7 + gain_delta7 * i;
-        const CSAMPLE_GAIN gain8 = start_gain8 + gain_delta8 * i;
-        const CSAMPLE_GAIN gain9 = start_gain9 + gain_delta9 * i;
-        const CSAMPLE_GAIN gain10 = start_gain10 + gain_delta10 * i;
-        const CSAMPLE_GAIN gain11 = start_gain11 + gain_delta11 * i;
-        const CSAMPLE_GAIN gain12 = start_gain12 + gain_delta12 * i;
-        const CSAMPLE_GAIN gain13 = start_gain13 + gain_delta13 * i;
-        const CSAMPLE_GAIN gain14 = start_gain14 + gain_delta14 * i;
-        const CSAMPLE_GAIN gain15 = start_gain15 + gain_delta15 * i;
-        const CSAMPLE_GAIN gain16 = start_gain16 + gain_delta16 * i;
-        const CSAMPLE_GAIN gain17 = start_gain17 + gain_delta17 * i;
-        const CSAMPLE_GAIN gain18 = start_gain18 + gain_delta18 * i;
-        pDest[i * 2] = pSrc0[i * 2] * gain0 +
-                       pSrc1[i * 2] * gain1 +
-                       pSrc2[i * 2] * gain2 +
-                       pSrc3[i * 2] * gain3 +
-                       pSrc4[i * 2] * gain4 +
-                       pSrc5[i * 2] * gain5 +
-                       pSrc6[i * 2] * gain6 +
-                       pSrc7[i * 2] * gain7 +
-                       pSrc8[i * 2] * gain8 +
-                       pSrc9[i * 2] * gain9 +
-                       pSrc10[i * 2] * gain10 +
-                       pSrc11[i * 2] * gain11 +
-                       pSrc12[i * 2] * gain12 +
-                       pSrc13[i * 2] * gain13 +
-                       pSrc14[i * 2] * gain14 +
-                       pSrc15[i * 2] * gain15 +
-                       pSrc16[i * 2] * gain16 +
-                       pSrc17[i * 2] * gain17 +
-                       pSrc18[i * 2] * gain18;
-        pDest[i * 2 + 1] = pSrc0[i * 2 + 1] * gain0 +
-                           pSrc1[i * 2 + 1] * gain1 +
-                           pSrc2[i * 2 + 1] * gain2 +
-                           pSrc3[i * 2 + 1] * gain3 +
-                           pSrc4[i * 2 + 1] * gain4 +
-                           pSrc5[i * 2 + 1] * gain5 +
-                           pSrc6[i * 2 + 1] * gain6 +
-                           pSrc7[i * 2 + 1] * gain7 +
-                           pSrc8[i * 2 + 1] * gain8 +
-                           pSrc9[i * 2 + 1] * gain9 +
-                           pSrc10[i * 2 + 1] * gain10 +
-                           pSrc11[i * 2 + 1] * gain11 +
-                           pSrc12[i * 2 + 1] * gain12 +
-                           pSrc13[i * 2 + 1] * gain13 +
-                           pSrc14[i * 2 + 1] * gain14 +
-                           pSrc15[i * 2 + 1] * gain15 +
-                           pSrc16[i * 2 + 1] * gain16 +
-                           pSrc17[i * 2 + 1] * gain17 +
-                           pSrc18[i * 2 + 1] * gain18;
-    }
+    const CSAMPLE* const pSrc[19] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15, pSrc16, pSrc17, pSrc18};
+    const CSAMPLE_GAIN start_gain[19] = {start_gain0, start_gain1, start_gain2, start_gain3, start_gain4, start_gain5, start_gain6, start_gain7, start_gain8, start_gain9, start_gain10, start_gain11, start_gain12, start_gain13, start_gain14, start_gain15, start_gain16, start_gain17, start_gain18};
+    const CSAMPLE_GAIN gain_delta[19] = {gain_delta0, gain_delta1, gain_delta2, gain_delta3, gain_delta4, gain_delta5, gain_delta6, gain_delta7, gain_delta8, gain_delta9, gain_delta10, gain_delta11, gain_delta12, gain_delta13, gain_delta14, gain_delta15, gain_delta16, gain_delta17, gain_delta18};
+    copyMultipleWithRampingGain(pDest, pSrc, start_gain, gain_delta, 19, iNumSamples / 2);
 }
 static inline void copy20WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
@@ -3374,29 +2654,9 @@ static inline void copy20WithGain(CSAMPLE* M_RESTRICT pDest,
         copy19WithGain(pDest, pSrc0, gain0, pSrc1, gain1, pSrc2, gain2, pSrc3, gain3, pSrc4, gain4, pSrc5, gain5, pSrc6, gain6, pSrc7, gain7, pSrc8, gain8, pSrc9, gain9, pSrc10, gain10, pSrc11, gain11, pSrc12, gain12, pSrc13, gain13, pSrc14, gain14, pSrc15, gain15, pSrc16, gain16, pSrc17, gain17, pSrc18, gain18, iNumSamples);
         return;
     }
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples; ++i) {
-        pDest[i] = pSrc0[i] * gain0 +
-                   pSrc1[i] * gain1 +
-                   pSrc2[i] * gain2 +
-                   pSrc3[i] * gain3 +
-                   pSrc4[i] * gain4 +
-                   pSrc5[i] * gain5 +
-                   pSrc6[i] * gain6 +
-                   pSrc7[i] * gain7 +
-                   pSrc8[i] * gain8 +
-                   pSrc9[i] * gain9 +
-                   pSrc10[i] * gain10 +
-                   pSrc11[i] * gain11 +
-                   pSrc12[i] * gain12 +
-                   pSrc13[i] * gain13 +
-                   pSrc14[i] * gain14 +
-                   pSrc15[i] * gain15 +
-                   pSrc16[i] * gain16 +
-                   pSrc17[i] * gain17 +
-                   pSrc18[i] * gain18 +
-                   pSrc19[i] * gain19;
-    }
+    const CSAMPLE* const pSrc[20] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15, pSrc16, pSrc17, pSrc18, pSrc19};
+    const CSAMPLE_GAIN gain[20] = {gain0, gain1, gain2, gain3, gain4, gain5, gain6, gain7, gain8, gain9, gain10, gain11, gain12, gain13, gain14, gain15, gain16, gain17, gain18, gain19};
+    copyMultipleWithGain(pDest, pSrc, gain, 20, iNumSamples);
 }
 static inline void copy20WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
@@ -3540,69 +2800,10 @@ static inline void copy20WithRampingGain(CSAMPLE* M_RESTRICT pDest,
     const CSAMPLE_GAIN start_gain18 = gain18in + gain_delta18;
     const CSAMPLE_GAIN gain_delta19 = (gain19out - gain19in) / (iNumSamples / 2);
     const CSAMPLE_GAIN start_gain19 = gain19in + gain_delta19;
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples / 2; ++i) {
-        const CSAMPLE_GAIN gain0 = start_gain0 + gain_delta0 * i;
-        const CSAMPLE_GAIN gain1 = start_gain1 + gain_delta1 * i;
-        const CSAMPLE_GAIN gain2 = start_gain2 + gain_delta2 * i;
-        const CSAMPLE_GAIN gain3 = start_gain3 + gain_delta3 * i;
-        const CSAMPLE_GAIN gain4 = start_gain4 + gain_delta4 * i;
-        const CSAMPLE_GAIN gain5 = start_gain5 + gain_delta5 * i;
-        const CSAMPLE_GAIN gain6 = start_gain6 + gain_delta6 * i;
-        const CSAMPLE_GAIN gain7 = start_gain7 + gain_delta7 * i;
-        const CSAMPLE_GAIN gain8 = start_gain8 + gain_delta8 * i;
-        const CSAMPLE_GAIN gain9 = start_gain9 + gain_delta9 * i;
-        const CSAMPLE_GAIN gain10 = start_gain10 + gain_delta10 * i;
-        const CSAMPLE_GAIN gain11 = start_gain11 + gain_delta11 * i;
-        const CSAMPLE_GAIN gain12 = start_gain12 + gain_delta12 * i;
-        const CSAMPLE_GAIN gain13 = start_gain13 + gain_delta13 * i;
-        const CSAMPLE_GAIN gain14 = start_gain14 + gain_delta14 * i;
-        const CSAMPLE_GAIN gain15 = start_gain15 + gain_delta15 * i;
-        const CSAMPLE_GAIN gain16 = start_gain16 + gain_delta16 * i;
-        const CSAMPLE_GAIN gain17 = start_gain17 + gain_delta17 * i;
-        const CSAMPLE_GAIN gain18 = start_gain18 + gain_delta18 * i;
-        const CSAMPLE_GAIN gain19 = start_gain19 + gain_delta19 * i;
-        pDest[i * 2] = pSrc0[i * 2] * gain0 +
-                       pSrc1[i * 2] * gain1 +
-                       pSrc2[i * 2] * gain2 +
-                       pSrc3[i * 2] * gain3 +
-                       pSrc4[i * 2] * gain4 +
-                       pSrc5[i * 2] * gain5 +
-                       pSrc6[i * 2] * gain6 +
-                       pSrc7[i * 2] * gain7 +
-                       pSrc8[i * 2] * gain8 +
-                       pSrc9[i * 2] * gain9 +
-                       pSrc10[i * 2] * gain10 +
-                       pSrc11[i * 2] * gain11 +
-                       pSrc12[i * 2] * gain12 +
-                       pSrc13[i * 2] * gain13 +
-                       pSrc14[i * 2] * gain14 +
-                       pSrc15[i * 2] * gain15 +
-                       pSrc16[i * 2] * gain16 +
-                       pSrc17[i * 2] * gain17 +
-                       pSrc18[i * 2] * gain18 +
-                       pSrc19[i * 2] * gain19;
-        pDest[i * 2 + 1] = pSrc0[i * 2 + 1] * gain0 +
-                           pSrc1[i * 2 + 1] * gain1 +
-                           pSrc2[i * 2 + 1] * gain2 +
-                           pSrc3[i * 2 + 1] * gain3 +
-                           pSrc4[i * 2 + 1] * gain4 +
-                           pSrc5[i * 2 + 1] * gain5 +
-                           pSrc6[i * 2 + 1] * gain6 +
-                           pSrc7[i * 2 + 1] * gain7 +
-                           pSrc8[i * 2 + 1] * gain8 +
-                           pSrc9[i * 2 + 1] * gain9 +
-                           pSrc10[i * 2 + 1] * gain10 +
-                           pSrc11[i * 2 + 1] * gain11 +
-                           pSrc12[i * 2 + 1] * gain12 +
-                           pSrc13[i * 2 + 1] * gain13 +
-                           pSrc14[i * 2 + 1] * gain14 +
-                           pSrc15[i * 2 + 1] * gain15 +
-                           pSrc16[i * 2 + 1] * gain16 +
-                           pSrc17[i * 2 + 1] * gain17 +
-                           pSrc18[i * 2 + 1] * gain18 +
-                           pSrc19[i * 2 + 1] * gain19;
-    }
+    const CSAMPLE* const pSrc[20] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15, pSrc16, pSrc17, pSrc18, pSrc19};
+    const CSAMPLE_GAIN start_gain[20] = {start_gain0, start_gain1, start_gain2, start_gain3, start_gain4, start_gain5, start_gain6, start_gain7, start_gain8, start_gain9, start_gain10, start_gain11, start_gain12, start_gain13, start_gain14, start_gain15, start_gain16, start_gain17, start_gain18, start_gain19};
+    const CSAMPLE_GAIN gain_delta[20] = {gain_delta0, gain_delta1, gain_delta2, gain_delta3, gain_delta4, gain_delta5, gain_delta6, gain_delta7, gain_delta8, gain_delta9, gain_delta10, gain_delta11, gain_delta12, gain_delta13, gain_delta14, gain_delta15, gain_delta16, gain_delta17, gain_delta18, gain_delta19};
+    copyMultipleWithRampingGain(pDest, pSrc, start_gain, gain_delta, 20, iNumSamples / 2);
 }
 static inline void copy21WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
@@ -3711,30 +2912,9 @@ static inline void copy21WithGain(CSAMPLE* M_RESTRICT pDest,
         copy20WithGain(pDest, pSrc0, gain0, pSrc1, gain1, pSrc2, gain2, pSrc3, gain3, pSrc4, gain4, pSrc5, gain5, pSrc6, gain6, pSrc7, gain7, pSrc8, gain8, pSrc9, gain9, pSrc10, gain10, pSrc11, gain11, pSrc12, gain12, pSrc13, gain13, pSrc14, gain14, pSrc15, gain15, pSrc16, gain16, pSrc17, gain17, pSrc18, gain18, pSrc19, gain19, iNumSamples);
         return;
     }
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples; ++i) {
-        pDest[i] = pSrc0[i] * gain0 +
-                   pSrc1[i] * gain1 +
-                   pSrc2[i] * gain2 +
-                   pSrc3[i] * gain3 +
-                   pSrc4[i] * gain4 +
-                   pSrc5[i] * gain5 +
-                   pSrc6[i] * gain6 +
-                   pSrc7[i] * gain7 +
-                   pSrc8[i] * gain8 +
-                   pSrc9[i] * gain9 +
-                   pSrc10[i] * gain10 +
-                   pSrc11[i] * gain11 +
-                   pSrc12[i] * gain12 +
-                   pSrc13[i] * gain13 +
-                   pSrc14[i] * gain14 +
-                   pSrc15[i] * gain15 +
-                   pSrc16[i] * gain16 +
-                   pSrc17[i] * gain17 +
-                   pSrc18[i] * gain18 +
-                   pSrc19[i] * gain19 +
-                   pSrc20[i] * gain20;
-    }
+    const CSAMPLE* const pSrc[21] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15, pSrc16, pSrc17, pSrc18, pSrc19, pSrc20};
+    const CSAMPLE_GAIN gain[21] = {gain0, gain1, gain2, gain3, gain4, gain5, gain6, gain7, gain8, gain9, gain10, gain11, gain12, gain13, gain14, gain15, gain16, gain17, gain18, gain19, gain20};
+    copyMultipleWithGain(pDest, pSrc, gain, 21, iNumSamples);
 }
 static inline void copy21WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
@@ -3885,72 +3065,10 @@ static inline void copy21WithRampingGain(CSAMPLE* M_RESTRICT pDest,
     const CSAMPLE_GAIN start_gain19 = gain19in + gain_delta19;
     const CSAMPLE_GAIN gain_delta20 = (gain20out - gain20in) / (iNumSamples / 2);
     const CSAMPLE_GAIN start_gain20 = gain20in + gain_delta20;
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples / 2; ++i) {
-        const CSAMPLE_GAIN gain0 = start_gain0 + gain_delta0 * i;
-        const CSAMPLE_GAIN gain1 = start_gain1 + gain_delta1 * i;
-        const CSAMPLE_GAIN gain2 = start_gain2 + gain_delta2 * i;
-        const CSAMPLE_GAIN gain3 = start_gain3 + gain_delta3 * i;
-        const CSAMPLE_GAIN gain4 = start_gain4 + gain_delta4 * i;
-        const CSAMPLE_GAIN gain5 = start_gain5 + gain_delta5 * i;
-        const CSAMPLE_GAIN gain6 = start_gain6 + gain_delta6 * i;
-        const CSAMPLE_GAIN gain7 = start_gain7 + gain_delta7 * i;
-        const CSAMPLE_GAIN gain8 = start_gain8 + gain_delta8 * i;
-        const CSAMPLE_GAIN gain9 = start_gain9 + gain_delta9 * i;
-        const CSAMPLE_GAIN gain10 = start_gain10 + gain_delta10 * i;
-        const CSAMPLE_GAIN gain11 = start_gain11 + gain_delta11 * i;
-        const CSAMPLE_GAIN gain12 = start_gain12 + gain_delta12 * i;
-        const CSAMPLE_GAIN gain13 = start_gain13 + gain_delta13 * i;
-        const CSAMPLE_GAIN gain14 = start_gain14 + gain_delta14 * i;
-        const CSAMPLE_GAIN gain15 = start_gain15 + gain_delta15 * i;
-        const CSAMPLE_GAIN gain16 = start_gain16 + gain_delta16 * i;
-        const CSAMPLE_GAIN gain17 = start_gain17 + gain_delta17 * i;
-        const CSAMPLE_GAIN gain18 = start_gain18 + gain_delta18 * i;
-        const CSAMPLE_GAIN gain19 = start_gain19 + gain_delta19 * i;
-        const CSAMPLE_GAIN gain20 = start_gain20 + gain_delta20 * i;
-        pDest[i * 2] = pSrc0[i * 2] * gain0 +
-                       pSrc1[i * 2] * gain1 +
-                       pSrc2[i * 2] * gain2 +
-                       pSrc3[i * 2] * gain3 +
-                       pSrc4[i * 2] * gain4 +
-                       pSrc5[i * 2] * gain5 +
-                       pSrc6[i * 2] * gain6 +
-                       pSrc7[i * 2] * gain7 +
-                       pSrc8[i * 2] * gain8 +
-                       pSrc9[i * 2] * gain9 +
-                       pSrc10[i * 2] * gain10 +
-                       pSrc11[i * 2] * gain11 +
-                       pSrc12[i * 2] * gain12 +
-                       pSrc13[i * 2] * gain13 +
-                       pSrc14[i * 2] * gain14 +
-                       pSrc15[i * 2] * gain15 +
-                       pSrc16[i * 2] * gain16 +
-                       pSrc17[i * 2] * gain17 +
-                       pSrc18[i * 2] * gain18 +
-                       pSrc19[i * 2] * gain19 +
-                       pSrc20[i * 2] * gain20;
-        pDest[i * 2 + 1] = pSrc0[i * 2 + 1] * gain0 +
-                           pSrc1[i * 2 + 1] * gain1 +
-                           pSrc2[i * 2 + 1] * gain2 +
-                           pSrc3[i * 2 + 1] * gain3 +
-                           pSrc4[i * 2 + 1] * gain4 +
-                           pSrc5[i * 2 + 1] * gain5 +
-                           pSrc6[i * 2 + 1] * gain6 +
-                           pSrc7[i * 2 + 1] * gain7 +
-                           pSrc8[i * 2 + 1] * gain8 +
-                           pSrc9[i * 2 + 1] * gain9 +
-                           pSrc10[i * 2 + 1] * gain10 +
-                           pSrc11[i * 2 + 1] * gain11 +
-                           pSrc12[i * 2 + 1] * gain12 +
-                           pSrc13[i * 2 + 1] * gain13 +
-                           pSrc14[i * 2 + 1] * gain14 +
-                           pSrc15[i * 2 + 1] * gain15 +
-                           pSrc16[i * 2 + 1] * gain16 +
-                           pSrc17[i * 2 + 1] * gain17 +
-                           pSrc18[i * 2 + 1] * gain18 +
-                           pSrc19[i * 2 + 1] * gain19 +
-                           pSrc20[i * 2 + 1] * gain20;
-    }
+    const CSAMPLE* const pSrc[21] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15, pSrc16, pSrc17, pSrc18, pSrc19, pSrc20};
+    const CSAMPLE_GAIN start_gain[21] = {start_gain0, start_gain1, start_gain2, start_gain3, start_gain4, start_gain5, start_gain6, start_gain7, start_gain8, start_gain9, start_gain10, start_gain11, start_gain12, start_gain13, start_gain14, start_gain15, start_gain16, start_gain17, start_gain18, start_gain19, start_gain20};
+    const CSAMPLE_GAIN gain_delta[21] = {gain_delta0, gain_delta1, gain_delta2, gain_delta3, gain_delta4, gain_delta5, gain_delta6, gain_delta7, gain_delta8, gain_delta9, gain_delta10, gain_delta11, gain_delta12, gain_delta13, gain_delta14, gain_delta15, gain_delta16, gain_delta17, gain_delta18, gain_delta19, gain_delta20};
+    copyMultipleWithRampingGain(pDest, pSrc, start_gain, gain_delta, 21, iNumSamples / 2);
 }
 static inline void copy22WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
@@ -4064,31 +3182,9 @@ static inline void copy22WithGain(CSAMPLE* M_RESTRICT pDest,
         copy21WithGain(pDest, pSrc0, gain0, pSrc1, gain1, pSrc2, gain2, pSrc3, gain3, pSrc4, gain4, pSrc5, gain5, pSrc6, gain6, pSrc7, gain7, pSrc8, gain8, pSrc9, gain9, pSrc10, gain10, pSrc11, gain11, pSrc12, gain12, pSrc13, gain13, pSrc14, gain14, pSrc15, gain15, pSrc16, gain16, pSrc17, gain17, pSrc18, gain18, pSrc19, gain19, pSrc20, gain20, iNumSamples);
         return;
     }
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples; ++i) {
-        pDest[i] = pSrc0[i] * gain0 +
-                   pSrc1[i] * gain1 +
-                   pSrc2[i] * gain2 +
-                   pSrc3[i] * gain3 +
-                   pSrc4[i] * gain4 +
-                   pSrc5[i] * gain5 +
-                   pSrc6[i] * gain6 +
-                   pSrc7[i] * gain7 +
-                   pSrc8[i] * gain8 +
-                   pSrc9[i] * gain9 +
-                   pSrc10[i] * gain10 +
-                   pSrc11[i] * gain11 +
-                   pSrc12[i] * gain12 +
-                   pSrc13[i] * gain13 +
-                   pSrc14[i] * gain14 +
-                   pSrc15[i] * gain15 +
-                   pSrc16[i] * gain16 +
-                   pSrc17[i] * gain17 +
-                   pSrc18[i] * gain18 +
-                   pSrc19[i] * gain19 +
-                   pSrc20[i] * gain20 +
-                   pSrc21[i] * gain21;
-    }
+    const CSAMPLE* const pSrc[22] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15, pSrc16, pSrc17, pSrc18, pSrc19, pSrc20, pSrc21};
+    const CSAMPLE_GAIN gain[22] = {gain0, gain1, gain2, gain3, gain4, gain5, gain6, gain7, gain8, gain9, gain10, gain11, gain12, gain13, gain14, gain15, gain16, gain17, gain18, gain19, gain20, gain21};
+    copyMultipleWithGain(pDest, pSrc, gain, 22, iNumSamples);
 }
 static inline void copy22WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
@@ -4246,75 +3342,10 @@ static inline void copy22WithRampingGain(CSAMPLE* M_RESTRICT pDest,
     const CSAMPLE_GAIN start_gain20 = gain20in + gain_delta20;
     const CSAMPLE_GAIN gain_delta21 = (gain21out - gain21in) / (iNumSamples / 2);
     const CSAMPLE_GAIN start_gain21 = gain21in + gain_delta21;
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples / 2; ++i) {
-        const CSAMPLE_GAIN gain0 = start_gain0 + gain_delta0 * i;
-        const CSAMPLE_GAIN gain1 = start_gain1 + gain_delta1 * i;
-        const CSAMPLE_GAIN gain2 = start_gain2 + gain_delta2 * i;
-        const CSAMPLE_GAIN gain3 = start_gain3 + gain_delta3 * i;
-        const CSAMPLE_GAIN gain4 = start_gain4 + gain_delta4 * i;
-        const CSAMPLE_GAIN gain5 = start_gain5 + gain_delta5 * i;
-        const CSAMPLE_GAIN gain6 = start_gain6 + gain_delta6 * i;
-        const CSAMPLE_GAIN gain7 = start_gain7 + gain_delta7 * i;
-        const CSAMPLE_GAIN gain8 = start_gain8 + gain_delta8 * i;
-        const CSAMPLE_GAIN gain9 = start_gain9 + gain_delta9 * i;
-        const CSAMPLE_GAIN gain10 = start_gain10 + gain_delta10 * i;
-        const CSAMPLE_GAIN gain11 = start_gain11 + gain_delta11 * i;
-        const CSAMPLE_GAIN gain12 = start_gain12 + gain_delta12 * i;
-        const CSAMPLE_GAIN gain13 = start_gain13 + gain_delta13 * i;
-        const CSAMPLE_GAIN gain14 = start_gain14 + gain_delta14 * i;
-        const CSAMPLE_GAIN gain15 = start_gain15 + gain_delta15 * i;
-        const CSAMPLE_GAIN gain16 = start_gain16 + gain_delta16 * i;
-        const CSAMPLE_GAIN gain17 = start_gain17 + gain_delta17 * i;
-        const CSAMPLE_GAIN gain18 = start_gain18 + gain_delta18 * i;
-        const CSAMPLE_GAIN gain19 = start_gain19 + gain_delta19 * i;
-        const CSAMPLE_GAIN gain20 = start_gain20 + gain_delta20 * i;
-        const CSAMPLE_GAIN gain21 = start_gain21 + gain_delta21 * i;
-        pDest[i * 2] = pSrc0[i * 2] * gain0 +
-                       pSrc1[i * 2] * gain1 +
-                       pSrc2[i * 2] * gain2 +
-                       pSrc3[i * 2] * gain3 +
-                       pSrc4[i * 2] * gain4 +
-                       pSrc5[i * 2] * gain5 +
-                       pSrc6[i * 2] * gain6 +
-                       pSrc7[i * 2] * gain7 +
-                       pSrc8[i * 2] * gain8 +
-                       pSrc9[i * 2] * gain9 +
-                       pSrc10[i * 2] * gain10 +
-                       pSrc11[i * 2] * gain11 +
-                       pSrc12[i * 2] * gain12 +
-                       pSrc13[i * 2] * gain13 +
-                       pSrc14[i * 2] * gain14 +
-                       pSrc15[i * 2] * gain15 +
-                       pSrc16[i * 2] * gain16 +
-                       pSrc17[i * 2] * gain17 +
-                       pSrc18[i * 2] * gain18 +
-                       pSrc19[i * 2] * gain19 +
-                       pSrc20[i * 2] * gain20 +
-                       pSrc21[i * 2] * gain21;
-        pDest[i * 2 + 1] = pSrc0[i * 2 + 1] * gain0 +
-                           pSrc1[i * 2 + 1] * gain1 +
-                           pSrc2[i * 2 + 1] * gain2 +
-                           pSrc3[i * 2 + 1] * gain3 +
-                           pSrc4[i * 2 + 1] * gain4 +
-                           pSrc5[i * 2 + 1] * gain5 +
-                           pSrc6[i * 2 + 1] * gain6 +
-                           pSrc7[i * 2 + 1] * gain7 +
-                           pSrc8[i * 2 + 1] * gain8 +
-                           pSrc9[i * 2 + 1] * gain9 +
-                           pSrc10[i * 2 + 1] * gain10 +
-                           pSrc11[i * 2 + 1] * gain11 +
-                           pSrc12[i * 2 + 1] * gain12 +
-                           pSrc13[i * 2 + 1] * gain13 +
-                           pSrc14[i * 2 + 1] * gain14 +
-                           pSrc15[i * 2 + 1] * gain15 +
-                           pSrc16[i * 2 + 1] * gain16 +
-                           pSrc17[i * 2 + 1] * gain17 +
-                           pSrc18[i * 2 + 1] * gain18 +
-                           pSrc19[i * 2 + 1] * gain19 +
-                           pSrc20[i * 2 + 1] * gain20 +
-                           pSrc21[i * 2 + 1] * gain21;
-    }
+    const CSAMPLE* const pSrc[22] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15, pSrc16, pSrc17, pSrc18, pSrc19, pSrc20, pSrc21};
+    const CSAMPLE_GAIN start_gain[22] = {start_gain0, start_gain1, start_gain2, start_gain3, start_gain4, start_gain5, start_gain6, start_gain7, start_gain8, start_gain9, start_gain10, start_gain11, start_gain12, start_gain13, start_gain14, start_gain15, start_gain16, start_gain17, start_gain18, start_gain19, start_gain20, start_gain21};
+    const CSAMPLE_GAIN gain_delta[22] = {gain_delta0, gain_delta1, gain_delta2, gain_delta3, gain_delta4, gain_delta5, gain_delta6, gain_delta7, gain_delta8, gain_delta9, gain_delta10, gain_delta11, gain_delta12, gain_delta13, gain_delta14, gain_delta15, gain_delta16, gain_delta17, gain_delta18, gain_delta19, gain_delta20, gain_delta21};
+    copyMultipleWithRampingGain(pDest, pSrc, start_gain, gain_delta, 22, iNumSamples / 2);
 }
 static inline void copy23WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
@@ -4433,32 +3464,9 @@ static inline void copy23WithGain(CSAMPLE* M_RESTRICT pDest,
         copy22WithGain(pDest, pSrc0, gain0, pSrc1, gain1, pSrc2, gain2, pSrc3, gain3, pSrc4, gain4, pSrc5, gain5, pSrc6, gain6, pSrc7, gain7, pSrc8, gain8, pSrc9, gain9, pSrc10, gain10, pSrc11, gain11, pSrc12, gain12, pSrc13, gain13, pSrc14, gain14, pSrc15, gain15, pSrc16, gain16, pSrc17, gain17, pSrc18, gain18, pSrc19, gain19, pSrc20, gain20, pSrc21, gain21, iNumSamples);
         return;
     }
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples; ++i) {
-        pDest[i] = pSrc0[i] * gain0 +
-                   pSrc1[i] * gain1 +
-                   pSrc2[i] * gain2 +
-                   pSrc3[i] * gain3 +
-                   pSrc4[i] * gain4 +
-                   pSrc5[i] * gain5 +
-                   pSrc6[i] * gain6 +
-                   pSrc7[i] * gain7 +
-                   pSrc8[i] * gain8 +
-                   pSrc9[i] * gain9 +
-                   pSrc10[i] * gain10 +
-                   pSrc11[i] * gain11 +
-                   pSrc12[i] * gain12 +
-                   pSrc13[i] * gain13 +
-                   pSrc14[i] * gain14 +
-                   pSrc15[i] * gain15 +
-                   pSrc16[i] * gain16 +
-                   pSrc17[i] * gain17 +
-                   pSrc18[i] * gain18 +
-                   pSrc19[i] * gain19 +
-                   pSrc20[i] * gain20 +
-                   pSrc21[i] * gain21 +
-                   pSrc22[i] * gain22;
-    }
+    const CSAMPLE* const pSrc[23] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15, pSrc16, pSrc17, pSrc18, pSrc19, pSrc20, pSrc21, pSrc22};
+    const CSAMPLE_GAIN gain[23] = {gain0, gain1, gain2, gain3, gain4, gain5, gain6, gain7, gain8, gain9, gain10, gain11, gain12, gain13, gain14, gain15, gain16, gain17, gain18, gain19, gain20, gain21, gain22};
+    copyMultipleWithGain(pDest, pSrc, gain, 23, iNumSamples);
 }
 static inline void copy23WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
@@ -4623,78 +3631,10 @@ static inline void copy23WithRampingGain(CSAMPLE* M_RESTRICT pDest,
     const CSAMPLE_GAIN start_gain21 = gain21in + gain_delta21;
     const CSAMPLE_GAIN gain_delta22 = (gain22out - gain22in) / (iNumSamples / 2);
     const CSAMPLE_GAIN start_gain22 = gain22in + gain_delta22;
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples / 2; ++i) {
-        const CSAMPLE_GAIN gain0 = start_gain0 + gain_delta0 * i;
-        const CSAMPLE_GAIN gain1 = start_gain1 + gain_delta1 * i;
-        const CSAMPLE_GAIN gain2 = start_gain2 + gain_delta2 * i;
-        const CSAMPLE_GAIN gain3 = start_gain3 + gain_delta3 * i;
-        const CSAMPLE_GAIN gain4 = start_gain4 + gain_delta4 * i;
-        const CSAMPLE_GAIN gain5 = start_gain5 + gain_delta5 * i;
-        const CSAMPLE_GAIN gain6 = start_gain6 + gain_delta6 * i;
-        const CSAMPLE_GAIN gain7 = start_gain7 + gain_delta7 * i;
-        const CSAMPLE_GAIN gain8 = start_gain8 + gain_delta8 * i;
-        const CSAMPLE_GAIN gain9 = start_gain9 + gain_delta9 * i;
-        const CSAMPLE_GAIN gain10 = start_gain10 + gain_delta10 * i;
-        const CSAMPLE_GAIN gain11 = start_gain11 + gain_delta11 * i;
-        const CSAMPLE_GAIN gain12 = start_gain12 + gain_delta12 * i;
-        const CSAMPLE_GAIN gain13 = start_gain13 + gain_delta13 * i;
-        const CSAMPLE_GAIN gain14 = start_gain14 + gain_delta14 * i;
-        const CSAMPLE_GAIN gain15 = start_gain15 + gain_delta15 * i;
-        const CSAMPLE_GAIN gain16 = start_gain16 + gain_delta16 * i;
-        const CSAMPLE_GAIN gain17 = start_gain17 + gain_delta17 * i;
-        const CSAMPLE_GAIN gain18 = start_gain18 + gain_delta18 * i;
-        const CSAMPLE_GAIN gain19 = start_gain19 + gain_delta19 * i;
-        const CSAMPLE_GAIN gain20 = start_gain20 + gain_delta20 * i;
-        const CSAMPLE_GAIN gain21 = start_gain21 + gain_delta21 * i;
-        const CSAMPLE_GAIN gain22 = start_gain22 + gain_delta22 * i;
-        pDest[i * 2] = pSrc0[i * 2] * gain0 +
-                       pSrc1[i * 2] * gain1 +
-                       pSrc2[i * 2] * gain2 +
-                       pSrc3[i * 2] * gain3 +
-                       pSrc4[i * 2] * gain4 +
-                       pSrc5[i * 2] * gain5 +
-                       pSrc6[i * 2] * gain6 +
-                       pSrc7[i * 2] * gain7 +
-                       pSrc8[i * 2] * gain8 +
-                       pSrc9[i * 2] * gain9 +
-                       pSrc10[i * 2] * gain10 +
-                       pSrc11[i * 2] * gain11 +
-                       pSrc12[i * 2] * gain12 +
-                       pSrc13[i * 2] * gain13 +
-                       pSrc14[i * 2] * gain14 +
-                       pSrc15[i * 2] * gain15 +
-                       pSrc16[i * 2] * gain16 +
-                       pSrc17[i * 2] * gain17 +
-                       pSrc18[i * 2] * gain18 +
-                       pSrc19[i * 2] * gain19 +
-                       pSrc20[i * 2] * gain20 +
-                       pSrc21[i * 2] * gain21 +
-                       pSrc22[i * 2] * gain22;
-        pDest[i * 2 + 1] = pSrc0[i * 2 + 1] * gain0 +
-                           pSrc1[i * 2 + 1] * gain1 +
-                           pSrc2[i * 2 + 1] * gain2 +
-                           pSrc3[i * 2 + 1] * gain3 +
-                           pSrc4[i * 2 + 1] * gain4 +
-                           pSrc5[i * 2 + 1] * gain5 +
-                           pSrc6[i * 2 + 1] * gain6 +
-                           pSrc7[i * 2 + 1] * gain7 +
-                           pSrc8[i * 2 + 1] * gain8 +
-                           pSrc9[i * 2 + 1] * gain9 +
-                           pSrc10[i * 2 + 1] * gain10 +
-                           pSrc11[i * 2 + 1] * gain11 +
-                           pSrc12[i * 2 + 1] * gain12 +
-                           pSrc13[i * 2 + 1] * gain13 +
-                           pSrc14[i * 2 + 1] * gain14 +
-                           pSrc15[i * 2 + 1] * gain15 +
-                           pSrc16[i * 2 + 1] * gain16 +
-                           pSrc17[i * 2 + 1] * gain17 +
-                           pSrc18[i * 2 + 1] * gain18 +
-                           pSrc19[i * 2 + 1] * gain19 +
-                           pSrc20[i * 2 + 1] * gain20 +
-                           pSrc21[i * 2 + 1] * gain21 +
-                           pSrc22[i * 2 + 1] * gain22;
-    }
+    const CSAMPLE* const pSrc[23] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15, pSrc16, pSrc17, pSrc18, pSrc19, pSrc20, pSrc21, pSrc22};
+    const CSAMPLE_GAIN start_gain[23] = {start_gain0, start_gain1, start_gain2, start_gain3, start_gain4, start_gain5, start_gain6, start_gain7, start_gain8, start_gain9, start_gain10, start_gain11, start_gain12, start_gain13, start_gain14, start_gain15, start_gain16, start_gain17, start_gain18, start_gain19, start_gain20, start_gain21, start_gain22};
+    const CSAMPLE_GAIN gain_delta[23] = {gain_delta0, gain_delta1, gain_delta2, gain_delta3, gain_delta4, gain_delta5, gain_delta6, gain_delta7, gain_delta8, gain_delta9, gain_delta10, gain_delta11, gain_delta12, gain_delta13, gain_delta14, gain_delta15, gain_delta16, gain_delta17, gain_delta18, gain_delta19, gain_delta20, gain_delta21, gain_delta22};
+    copyMultipleWithRampingGain(pDest, pSrc, start_gain, gain_delta, 23, iNumSamples / 2);
 }
 static inline void copy24WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
@@ -4818,33 +3758,9 @@ static inline void copy24WithGain(CSAMPLE* M_RESTRICT pDest,
         copy23WithGain(pDest, pSrc0, gain0, pSrc1, gain1, pSrc2, gain2, pSrc3, gain3, pSrc4, gain4, pSrc5, gain5, pSrc6, gain6, pSrc7, gain7, pSrc8, gain8, pSrc9, gain9, pSrc10, gain10, pSrc11, gain11, pSrc12, gain12, pSrc13, gain13, pSrc14, gain14, pSrc15, gain15, pSrc16, gain16, pSrc17, gain17, pSrc18, gain18, pSrc19, gain19, pSrc20, gain20, pSrc21, gain21, pSrc22, gain22, iNumSamples);
         return;
     }
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples; ++i) {
-        pDest[i] = pSrc0[i] * gain0 +
-                   pSrc1[i] * gain1 +
-                   pSrc2[i] * gain2 +
-                   pSrc3[i] * gain3 +
-                   pSrc4[i] * gain4 +
-                   pSrc5[i] * gain5 +
-                   pSrc6[i] * gain6 +
-                   pSrc7[i] * gain7 +
-                   pSrc8[i] * gain8 +
-                   pSrc9[i] * gain9 +
-                   pSrc10[i] * gain10 +
-                   pSrc11[i] * gain11 +
-                   pSrc12[i] * gain12 +
-                   pSrc13[i] * gain13 +
-                   pSrc14[i] * gain14 +
-                   pSrc15[i] * gain15 +
-                   pSrc16[i] * gain16 +
-                   pSrc17[i] * gain17 +
-                   pSrc18[i] * gain18 +
-                   pSrc19[i] * gain19 +
-                   pSrc20[i] * gain20 +
-                   pSrc21[i] * gain21 +
-                   pSrc22[i] * gain22 +
-                   pSrc23[i] * gain23;
-    }
+    const CSAMPLE* const pSrc[24] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15, pSrc16, pSrc17, pSrc18, pSrc19, pSrc20, pSrc21, pSrc22, pSrc23};
+    const CSAMPLE_GAIN gain[24] = {gain0, gain1, gain2, gain3, gain4, gain5, gain6, gain7, gain8, gain9, gain10, gain11, gain12, gain13, gain14, gain15, gain16, gain17, gain18, gain19, gain20, gain21, gain22, gain23};
+    copyMultipleWithGain(pDest, pSrc, gain, 24, iNumSamples);
 }
 static inline void copy24WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
@@ -5016,81 +3932,10 @@ static inline void copy24WithRampingGain(CSAMPLE* M_RESTRICT pDest,
     const CSAMPLE_GAIN start_gain22 = gain22in + gain_delta22;
     const CSAMPLE_GAIN gain_delta23 = (gain23out - gain23in) / (iNumSamples / 2);
     const CSAMPLE_GAIN start_gain23 = gain23in + gain_delta23;
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples / 2; ++i) {
-        const CSAMPLE_GAIN gain0 = start_gain0 + gain_delta0 * i;
-        const CSAMPLE_GAIN gain1 = start_gain1 + gain_delta1 * i;
-        const CSAMPLE_GAIN gain2 = start_gain2 + gain_delta2 * i;
-        const CSAMPLE_GAIN gain3 = start_gain3 + gain_delta3 * i;
-        const CSAMPLE_GAIN gain4 = start_gain4 + gain_delta4 * i;
-        const CSAMPLE_GAIN gain5 = start_gain5 + gain_delta5 * i;
-        const CSAMPLE_GAIN gain6 = start_gain6 + gain_delta6 * i;
-        const CSAMPLE_GAIN gain7 = start_gain7 + gain_delta7 * i;
-        const CSAMPLE_GAIN gain8 = start_gain8 + gain_delta8 * i;
-        const CSAMPLE_GAIN gain9 = start_gain9 + gain_delta9 * i;
-        const CSAMPLE_GAIN gain10 = start_gain10 + gain_delta10 * i;
-        const CSAMPLE_GAIN gain11 = start_gain11 + gain_delta11 * i;
-        const CSAMPLE_GAIN gain12 = start_gain12 + gain_delta12 * i;
-        const CSAMPLE_GAIN gain13 = start_gain13 + gain_delta13 * i;
-        const CSAMPLE_GAIN gain14 = start_gain14 + gain_delta14 * i;
-        const CSAMPLE_GAIN gain15 = start_gain15 + gain_delta15 * i;
-        const CSAMPLE_GAIN gain16 = start_gain16 + gain_delta16 * i;
-        const CSAMPLE_GAIN gain17 = start_gain17 + gain_delta17 * i;
-        const CSAMPLE_GAIN gain18 = start_gain18 + gain_delta18 * i;
-        const CSAMPLE_GAIN gain19 = start_gain19 + gain_delta19 * i;
-        const CSAMPLE_GAIN gain20 = start_gain20 + gain_delta20 * i;
-        const CSAMPLE_GAIN gain21 = start_gain21 + gain_delta21 * i;
-        const CSAMPLE_GAIN gain22 = start_gain22 + gain_delta22 * i;
-        const CSAMPLE_GAIN gain23 = start_gain23 + gain_delta23 * i;
-        pDest[i * 2] = pSrc0[i * 2] * gain0 +
-                       pSrc1[i * 2] * gain1 +
-                       pSrc2[i * 2] * gain2 +
-                       pSrc3[i * 2] * gain3 +
-                       pSrc4[i * 2] * gain4 +
-                       pSrc5[i * 2] * gain5 +
-                       pSrc6[i * 2] * gain6 +
-                       pSrc7[i * 2] * gain7 +
-                       pSrc8[i * 2] * gain8 +
-                       pSrc9[i * 2] * gain9 +
-                       pSrc10[i * 2] * gain10 +
-                       pSrc11[i * 2] * gain11 +
-                       pSrc12[i * 2] * gain12 +
-                       pSrc13[i * 2] * gain13 +
-                       pSrc14[i * 2] * gain14 +
-                       pSrc15[i * 2] * gain15 +
-                       pSrc16[i * 2] * gain16 +
-                       pSrc17[i * 2] * gain17 +
-                       pSrc18[i * 2] * gain18 +
-                       pSrc19[i * 2] * gain19 +
-                       pSrc20[i * 2] * gain20 +
-                       pSrc21[i * 2] * gain21 +
-                       pSrc22[i * 2] * gain22 +
-                       pSrc23[i * 2] * gain23;
-        pDest[i * 2 + 1] = pSrc0[i * 2 + 1] * gain0 +
-                           pSrc1[i * 2 + 1] * gain1 +
-                           pSrc2[i * 2 + 1] * gain2 +
-                           pSrc3[i * 2 + 1] * gain3 +
-                           pSrc4[i * 2 + 1] * gain4 +
-                           pSrc5[i * 2 + 1] * gain5 +
-                           pSrc6[i * 2 + 1] * gain6 +
-                           pSrc7[i * 2 + 1] * gain7 +
-                           pSrc8[i * 2 + 1] * gain8 +
-                           pSrc9[i * 2 + 1] * gain9 +
-                           pSrc10[i * 2 + 1] * gain10 +
-                           pSrc11[i * 2 + 1] * gain11 +
-                           pSrc12[i * 2 + 1] * gain12 +
-                           pSrc13[i * 2 + 1] * gain13 +
-                           pSrc14[i * 2 + 1] * gain14 +
-                           pSrc15[i * 2 + 1] * gain15 +
-                           pSrc16[i * 2 + 1] * gain16 +
-                           pSrc17[i * 2 + 1] * gain17 +
-                           pSrc18[i * 2 + 1] * gain18 +
-                           pSrc19[i * 2 + 1] * gain19 +
-                           pSrc20[i * 2 + 1] * gain20 +
-                           pSrc21[i * 2 + 1] * gain21 +
-                           pSrc22[i * 2 + 1] * gain22 +
-                           pSrc23[i * 2 + 1] * gain23;
-    }
+    const CSAMPLE* const pSrc[24] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15, pSrc16, pSrc17, pSrc18, pSrc19, pSrc20, pSrc21, pSrc22, pSrc23};
+    const CSAMPLE_GAIN start_gain[24] = {start_gain0, start_gain1, start_gain2, start_gain3, start_gain4, start_gain5, start_gain6, start_gain7, start_gain8, start_gain9, start_gain10, start_gain11, start_gain12, start_gain13, start_gain14, start_gain15, start_gain16, start_gain17, start_gain18, start_gain19, start_gain20, start_gain21, start_gain22, start_gain23};
+    const CSAMPLE_GAIN gain_delta[24] = {gain_delta0, gain_delta1, gain_delta2, gain_delta3, gain_delta4, gain_delta5, gain_delta6, gain_delta7, gain_delta8, gain_delta9, gain_delta10, gain_delta11, gain_delta12, gain_delta13, gain_delta14, gain_delta15, gain_delta16, gain_delta17, gain_delta18, gain_delta19, gain_delta20, gain_delta21, gain_delta22, gain_delta23};
+    copyMultipleWithRampingGain(pDest, pSrc, start_gain, gain_delta, 24, iNumSamples / 2);
 }
 static inline void copy25WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
@@ -5219,34 +4064,9 @@ static inline void copy25WithGain(CSAMPLE* M_RESTRICT pDest,
         copy24WithGain(pDest, pSrc0, gain0, pSrc1, gain1, pSrc2, gain2, pSrc3, gain3, pSrc4, gain4, pSrc5, gain5, pSrc6, gain6, pSrc7, gain7, pSrc8, gain8, pSrc9, gain9, pSrc10, gain10, pSrc11, gain11, pSrc12, gain12, pSrc13, gain13, pSrc14, gain14, pSrc15, gain15, pSrc16, gain16, pSrc17, gain17, pSrc18, gain18, pSrc19, gain19, pSrc20, gain20, pSrc21, gain21, pSrc22, gain22, pSrc23, gain23, iNumSamples);
         return;
     }
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples; ++i) {
-        pDest[i] = pSrc0[i] * gain0 +
-                   pSrc1[i] * gain1 +
-                   pSrc2[i] * gain2 +
-                   pSrc3[i] * gain3 +
-                   pSrc4[i] * gain4 +
-                   pSrc5[i] * gain5 +
-                   pSrc6[i] * gain6 +
-                   pSrc7[i] * gain7 +
-                   pSrc8[i] * gain8 +
-                   pSrc9[i] * gain9 +
-                   pSrc10[i] * gain10 +
-                   pSrc11[i] * gain11 +
-                   pSrc12[i] * gain12 +
-                   pSrc13[i] * gain13 +
-                   pSrc14[i] * gain14 +
-                   pSrc15[i] * gain15 +
-                   pSrc16[i] * gain16 +
-                   pSrc17[i] * gain17 +
-                   pSrc18[i] * gain18 +
-                   pSrc19[i] * gain19 +
-                   pSrc20[i] * gain20 +
-                   pSrc21[i] * gain21 +
-                   pSrc22[i] * gain22 +
-                   pSrc23[i] * gain23 +
-                   pSrc24[i] * gain24;
-    }
+    const CSAMPLE* const pSrc[25] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15, pSrc16, pSrc17, pSrc18, pSrc19, pSrc20, pSrc21, pSrc22, pSrc23, pSrc24};
+    const CSAMPLE_GAIN gain[25] = {gain0, gain1, gain2, gain3, gain4, gain5, gain6, gain7, gain8, gain9, gain10, gain11, gain12, gain13, gain14, gain15, gain16, gain17, gain18, gain19, gain20, gain21, gain22, gain23, gain24};
+    copyMultipleWithGain(pDest, pSrc, gain, 25, iNumSamples);
 }
 static inline void copy25WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
@@ -5425,84 +4245,10 @@ static inline void copy25WithRampingGain(CSAMPLE* M_RESTRICT pDest,
     const CSAMPLE_GAIN start_gain23 = gain23in + gain_delta23;
     const CSAMPLE_GAIN gain_delta24 = (gain24out - gain24in) / (iNumSamples / 2);
     const CSAMPLE_GAIN start_gain24 = gain24in + gain_delta24;
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples / 2; ++i) {
-        const CSAMPLE_GAIN gain0 = start_gain0 + gain_delta0 * i;
-        const CSAMPLE_GAIN gain1 = start_gain1 + gain_delta1 * i;
-        const CSAMPLE_GAIN gain2 = start_gain2 + gain_delta2 * i;
-        const CSAMPLE_GAIN gain3 = start_gain3 + gain_delta3 * i;
-        const CSAMPLE_GAIN gain4 = start_gain4 + gain_delta4 * i;
-        const CSAMPLE_GAIN gain5 = start_gain5 + gain_delta5 * i;
-        const CSAMPLE_GAIN gain6 = start_gain6 + gain_delta6 * i;
-        const CSAMPLE_GAIN gain7 = start_gain7 + gain_delta7 * i;
-        const CSAMPLE_GAIN gain8 = start_gain8 + gain_delta8 * i;
-        const CSAMPLE_GAIN gain9 = start_gain9 + gain_delta9 * i;
-        const CSAMPLE_GAIN gain10 = start_gain10 + gain_delta10 * i;
-        const CSAMPLE_GAIN gain11 = start_gain11 + gain_delta11 * i;
-        const CSAMPLE_GAIN gain12 = start_gain12 + gain_delta12 * i;
-        const CSAMPLE_GAIN gain13 = start_gain13 + gain_delta13 * i;
-        const CSAMPLE_GAIN gain14 = start_gain14 + gain_delta14 * i;
-        const CSAMPLE_GAIN gain15 = start_gain15 + gain_delta15 * i;
-        const CSAMPLE_GAIN gain16 = start_gain16 + gain_delta16 * i;
-        const CSAMPLE_GAIN gain17 = start_gain17 + gain_delta17 * i;
-        const CSAMPLE_GAIN gain18 = start_gain18 + gain_delta18 * i;
-        const CSAMPLE_GAIN gain19 = start_gain19 + gain_delta19 * i;
-        const CSAMPLE_GAIN gain20 = start_gain20 + gain_delta20 * i;
-        const CSAMPLE_GAIN gain21 = start_gain21 + gain_delta21 * i;
-        const CSAMPLE_GAIN gain22 = start_gain22 + gain_delta22 * i;
-        const CSAMPLE_GAIN gain23 = start_gain23 + gain_delta23 * i;
-        const CSAMPLE_GAIN gain24 = start_gain24 + gain_delta24 * i;
-        pDest[i * 2] = pSrc0[i * 2] * gain0 +
-                       pSrc1[i * 2] * gain1 +
-                       pSrc2[i * 2] * gain2 +
-                       pSrc3[i * 2] * gain3 +
-                       pSrc4[i * 2] * gain4 +
-                       pSrc5[i * 2] * gain5 +
-                       pSrc6[i * 2] * gain6 +
-                       pSrc7[i * 2] * gain7 +
-                       pSrc8[i * 2] * gain8 +
-                       pSrc9[i * 2] * gain9 +
-                       pSrc10[i * 2] * gain10 +
-                       pSrc11[i * 2] * gain11 +
-                       pSrc12[i * 2] * gain12 +
-                       pSrc13[i * 2] * gain13 +
-                       pSrc14[i * 2] * gain14 +
-                       pSrc15[i * 2] * gain15 +
-                       pSrc16[i * 2] * gain16 +
-                       pSrc17[i * 2] * gain17 +
-                       pSrc18[i * 2] * gain18 +
-                       pSrc19[i * 2] * gain19 +
-                       pSrc20[i * 2] * gain20 +
-                       pSrc21[i * 2] * gain21 +
-                       pSrc22[i * 2] * gain22 +
-                       pSrc23[i * 2] * gain23 +
-                       pSrc24[i * 2] * gain24;
-        pDest[i * 2 + 1] = pSrc0[i * 2 + 1] * gain0 +
-                           pSrc1[i * 2 + 1] * gain1 +
-                           pSrc2[i * 2 + 1] * gain2 +
-                           pSrc3[i * 2 + 1] * gain3 +
-                           pSrc4[i * 2 + 1] * gain4 +
-                           pSrc5[i * 2 + 1] * gain5 +
-                           pSrc6[i * 2 + 1] * gain6 +
-                           pSrc7[i * 2 + 1] * gain7 +
-                           pSrc8[i * 2 + 1] * gain8 +
-                           pSrc9[i * 2 + 1] * gain9 +
-                           pSrc10[i * 2 + 1] * gain10 +
-                           pSrc11[i * 2 + 1] * gain11 +
-                           pSrc12[i * 2 + 1] * gain12 +
-                           pSrc13[i * 2 + 1] * gain13 +
-                           pSrc14[i * 2 + 1] * gain14 +
-                           pSrc15[i * 2 + 1] * gain15 +
-                           pSrc16[i * 2 + 1] * gain16 +
-                           pSrc17[i * 2 + 1] * gain17 +
-                           pSrc18[i * 2 + 1] * gain18 +
-                           pSrc19[i * 2 + 1] * gain19 +
-                           pSrc20[i * 2 + 1] * gain20 +
-                           pSrc21[i * 2 + 1] * gain21 +
-                           pSrc22[i * 2 + 1] * gain22 +
-                           pSrc23[i * 2 + 1] * gain23 +
-                           pSrc24[i * 2 + 1] * gain24;
-    }
+    const CSAMPLE* const pSrc[25] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15, pSrc16, pSrc17, pSrc18, pSrc19, pSrc20, pSrc21, pSrc22, pSrc23, pSrc24};
+    const CSAMPLE_GAIN start_gain[25] = {start_gain0, start_gain1, start_gain2, start_gain3, start_gain4, start_gain5, start_gain6, start_gain7, start_gain8, start_gain9, start_gain10, start_gain11, start_gain12, start_gain13, start_gain14, start_gain15, start_gain16, start_gain17, start_gain18, start_gain19, start_gain20, start_gain21, start_gain22, start_gain23, start_gain24};
+    const CSAMPLE_GAIN gain_delta[25] = {gain_delta0, gain_delta1, gain_delta2, gain_delta3, gain_delta4, gain_delta5, gain_delta6, gain_delta7, gain_delta8, gain_delta9, gain_delta10, gain_delta11, gain_delta12, gain_delta13, gain_delta14, gain_delta15, gain_delta16, gain_delta17, gain_delta18, gain_delta19, gain_delta20, gain_delta21, gain_delta22, gain_delta23, gain_delta24};
+    copyMultipleWithRampingGain(pDest, pSrc, start_gain, gain_delta, 25, iNumSamples / 2);
 }
 static inline void copy26WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
@@ -5636,35 +4382,9 @@ static inline void copy26WithGain(CSAMPLE* M_RESTRICT pDest,
         copy25WithGain(pDest, pSrc0, gain0, pSrc1, gain1, pSrc2, gain2, pSrc3, gain3, pSrc4, gain4, pSrc5, gain5, pSrc6, gain6, pSrc7, gain7, pSrc8, gain8, pSrc9, gain9, pSrc10, gain10, pSrc11, gain11, pSrc12, gain12, pSrc13, gain13, pSrc14, gain14, pSrc15, gain15, pSrc16, gain16, pSrc17, gain17, pSrc18, gain18, pSrc19, gain19, pSrc20, gain20, pSrc21, gain21, pSrc22, gain22, pSrc23, gain23, pSrc24, gain24, iNumSamples);
         return;
     }
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples; ++i) {
-        pDest[i] = pSrc0[i] * gain0 +
-                   pSrc1[i] * gain1 +
-                   pSrc2[i] * gain2 +
-                   pSrc3[i] * gain3 +
-                   pSrc4[i] * gain4 +
-                   pSrc5[i] * gain5 +
-                   pSrc6[i] * gain6 +
-                   pSrc7[i] * gain7 +
-                   pSrc8[i] * gain8 +
-                   pSrc9[i] * gain9 +
-                   pSrc10[i] * gain10 +
-                   pSrc11[i] * gain11 +
-                   pSrc12[i] * gain12 +
-                   pSrc13[i] * gain13 +
-                   pSrc14[i] * gain14 +
-                   pSrc15[i] * gain15 +
-                   pSrc16[i] * gain16 +
-                   pSrc17[i] * gain17 +
-                   pSrc18[i] * gain18 +
-                   pSrc19[i] * gain19 +
-                   pSrc20[i] * gain20 +
-                   pSrc21[i] * gain21 +
-                   pSrc22[i] * gain22 +
-                   pSrc23[i] * gain23 +
-                   pSrc24[i] * gain24 +
-                   pSrc25[i] * gain25;
-    }
+    const CSAMPLE* const pSrc[26] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15, pSrc16, pSrc17, pSrc18, pSrc19, pSrc20, pSrc21, pSrc22, pSrc23, pSrc24, pSrc25};
+    const CSAMPLE_GAIN gain[26] = {gain0, gain1, gain2, gain3, gain4, gain5, gain6, gain7, gain8, gain9, gain10, gain11, gain12, gain13, gain14, gain15, gain16, gain17, gain18, gain19, gain20, gain21, gain22, gain23, gain24, gain25};
+    copyMultipleWithGain(pDest, pSrc, gain, 26, iNumSamples);
 }
 static inline void copy26WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
@@ -5850,87 +4570,10 @@ static inline void copy26WithRampingGain(CSAMPLE* M_RESTRICT pDest,
     const CSAMPLE_GAIN start_gain24 = gain24in + gain_delta24;
     const CSAMPLE_GAIN gain_delta25 = (gain25out - gain25in) / (iNumSamples / 2);
     const CSAMPLE_GAIN start_gain25 = gain25in + gain_delta25;
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples / 2; ++i) {
-        const CSAMPLE_GAIN gain0 = start_gain0 + gain_delta0 * i;
-        const CSAMPLE_GAIN gain1 = start_gain1 + gain_delta1 * i;
-        const CSAMPLE_GAIN gain2 = start_gain2 + gain_delta2 * i;
-        const CSAMPLE_GAIN gain3 = start_gain3 + gain_delta3 * i;
-        const CSAMPLE_GAIN gain4 = start_gain4 + gain_delta4 * i;
-        const CSAMPLE_GAIN gain5 = start_gain5 + gain_delta5 * i;
-        const CSAMPLE_GAIN gain6 = start_gain6 + gain_delta6 * i;
-        const CSAMPLE_GAIN gain7 = start_gain7 + gain_delta7 * i;
-        const CSAMPLE_GAIN gain8 = start_gain8 + gain_delta8 * i;
-        const CSAMPLE_GAIN gain9 = start_gain9 + gain_delta9 * i;
-        const CSAMPLE_GAIN gain10 = start_gain10 + gain_delta10 * i;
-        const CSAMPLE_GAIN gain11 = start_gain11 + gain_delta11 * i;
-        const CSAMPLE_GAIN gain12 = start_gain12 + gain_delta12 * i;
-        const CSAMPLE_GAIN gain13 = start_gain13 + gain_delta13 * i;
-        const CSAMPLE_GAIN gain14 = start_gain14 + gain_delta14 * i;
-        const CSAMPLE_GAIN gain15 = start_gain15 + gain_delta15 * i;
-        const CSAMPLE_GAIN gain16 = start_gain16 + gain_delta16 * i;
-        const CSAMPLE_GAIN gain17 = start_gain17 + gain_delta17 * i;
-        const CSAMPLE_GAIN gain18 = start_gain18 + gain_delta18 * i;
-        const CSAMPLE_GAIN gain19 = start_gain19 + gain_delta19 * i;
-        const CSAMPLE_GAIN gain20 = start_gain20 + gain_delta20 * i;
-        const CSAMPLE_GAIN gain21 = start_gain21 + gain_delta21 * i;
-        const CSAMPLE_GAIN gain22 = start_gain22 + gain_delta22 * i;
-        const CSAMPLE_GAIN gain23 = start_gain23 + gain_delta23 * i;
-        const CSAMPLE_GAIN gain24 = start_gain24 + gain_delta24 * i;
-        const CSAMPLE_GAIN gain25 = start_gain25 + gain_delta25 * i;
-        pDest[i * 2] = pSrc0[i * 2] * gain0 +
-                       pSrc1[i * 2] * gain1 +
-                       pSrc2[i * 2] * gain2 +
-                       pSrc3[i * 2] * gain3 +
-                       pSrc4[i * 2] * gain4 +
-                       pSrc5[i * 2] * gain5 +
-                       pSrc6[i * 2] * gain6 +
-                       pSrc7[i * 2] * gain7 +
-                       pSrc8[i * 2] * gain8 +
-                       pSrc9[i * 2] * gain9 +
-                       pSrc10[i * 2] * gain10 +
-                       pSrc11[i * 2] * gain11 +
-                       pSrc12[i * 2] * gain12 +
-                       pSrc13[i * 2] * gain13 +
-                       pSrc14[i * 2] * gain14 +
-                       pSrc15[i * 2] * gain15 +
-                       pSrc16[i * 2] * gain16 +
-                       pSrc17[i * 2] * gain17 +
-                       pSrc18[i * 2] * gain18 +
-                       pSrc19[i * 2] * gain19 +
-                       pSrc20[i * 2] * gain20 +
-                       pSrc21[i * 2] * gain21 +
-                       pSrc22[i * 2] * gain22 +
-                       pSrc23[i * 2] * gain23 +
-                       pSrc24[i * 2] * gain24 +
-                       pSrc25[i * 2] * gain25;
-        pDest[i * 2 + 1] = pSrc0[i * 2 + 1] * gain0 +
-                           pSrc1[i * 2 + 1] * gain1 +
-                           pSrc2[i * 2 + 1] * gain2 +
-                           pSrc3[i * 2 + 1] * gain3 +
-                           pSrc4[i * 2 + 1] * gain4 +
-                           pSrc5[i * 2 + 1] * gain5 +
-                           pSrc6[i * 2 + 1] * gain6 +
-                           pSrc7[i * 2 + 1] * gain7 +
-                           pSrc8[i * 2 + 1] * gain8 +
-                           pSrc9[i * 2 + 1] * gain9 +
-                           pSrc10[i * 2 + 1] * gain10 +
-                           pSrc11[i * 2 + 1] * gain11 +
-                           pSrc12[i * 2 + 1] * gain12 +
-                           pSrc13[i * 2 + 1] * gain13 +
-                           pSrc14[i * 2 + 1] * gain14 +
-                           pSrc15[i * 2 + 1] * gain15 +
-                           pSrc16[i * 2 + 1] * gain16 +
-                           pSrc17[i * 2 + 1] * gain17 +
-                           pSrc18[i * 2 + 1] * gain18 +
-                           pSrc19[i * 2 + 1] * gain19 +
-                           pSrc20[i * 2 + 1] * gain20 +
-                           pSrc21[i * 2 + 1] * gain21 +
-                           pSrc22[i * 2 + 1] * gain22 +
-                           pSrc23[i * 2 + 1] * gain23 +
-                           pSrc24[i * 2 + 1] * gain24 +
-                           pSrc25[i * 2 + 1] * gain25;
-    }
+    const CSAMPLE* const pSrc[26] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15, pSrc16, pSrc17, pSrc18, pSrc19, pSrc20, pSrc21, pSrc22, pSrc23, pSrc24, pSrc25};
+    const CSAMPLE_GAIN start_gain[26] = {start_gain0, start_gain1, start_gain2, start_gain3, start_gain4, start_gain5, start_gain6, start_gain7, start_gain8, start_gain9, start_gain10, start_gain11, start_gain12, start_gain13, start_gain14, start_gain15, start_gain16, start_gain17, start_gain18, start_gain19, start_gain20, start_gain21, start_gain22, start_gain23, start_gain24, start_gain25};
+    const CSAMPLE_GAIN gain_delta[26] = {gain_delta0, gain_delta1, gain_delta2, gain_delta3, gain_delta4, gain_delta5, gain_delta6, gain_delta7, gain_delta8, gain_delta9, gain_delta10, gain_delta11, gain_delta12, gain_delta13, gain_delta14, gain_delta15, gain_delta16, gain_delta17, gain_delta18, gain_delta19, gain_delta20, gain_delta21, gain_delta22, gain_delta23, gain_delta24, gain_delta25};
+    copyMultipleWithRampingGain(pDest, pSrc, start_gain, gain_delta, 26, iNumSamples / 2);
 }
 static inline void copy27WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
@@ -6069,36 +4712,9 @@ static inline void copy27WithGain(CSAMPLE* M_RESTRICT pDest,
         copy26WithGain(pDest, pSrc0, gain0, pSrc1, gain1, pSrc2, gain2, pSrc3, gain3, pSrc4, gain4, pSrc5, gain5, pSrc6, gain6, pSrc7, gain7, pSrc8, gain8, pSrc9, gain9, pSrc10, gain10, pSrc11, gain11, pSrc12, gain12, pSrc13, gain13, pSrc14, gain14, pSrc15, gain15, pSrc16, gain16, pSrc17, gain17, pSrc18, gain18, pSrc19, gain19, pSrc20, gain20, pSrc21, gain21, pSrc22, gain22, pSrc23, gain23, pSrc24, gain24, pSrc25, gain25, iNumSamples);
         return;
     }
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples; ++i) {
-        pDest[i] = pSrc0[i] * gain0 +
-                   pSrc1[i] * gain1 +
-                   pSrc2[i] * gain2 +
-                   pSrc3[i] * gain3 +
-                   pSrc4[i] * gain4 +
-                   pSrc5[i] * gain5 +
-                   pSrc6[i] * gain6 +
-                   pSrc7[i] * gain7 +
-                   pSrc8[i] * gain8 +
-                   pSrc9[i] * gain9 +
-                   pSrc10[i] * gain10 +
-                   pSrc11[i] * gain11 +
-                   pSrc12[i] * gain12 +
-                   pSrc13[i] * gain13 +
-                   pSrc14[i] * gain14 +
-                   pSrc15[i] * gain15 +
-                   pSrc16[i] * gain16 +
-                   pSrc17[i] * gain17 +
-                   pSrc18[i] * gain18 +
-                   pSrc19[i] * gain19 +
-                   pSrc20[i] * gain20 +
-                   pSrc21[i] * gain21 +
-                   pSrc22[i] * gain22 +
-                   pSrc23[i] * gain23 +
-                   pSrc24[i] * gain24 +
-                   pSrc25[i] * gain25 +
-                   pSrc26[i] * gain26;
-    }
+    const CSAMPLE* const pSrc[27] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15, pSrc16, pSrc17, pSrc18, pSrc19, pSrc20, pSrc21, pSrc22, pSrc23, pSrc24, pSrc25, pSrc26};
+    const CSAMPLE_GAIN gain[27] = {gain0, gain1, gain2, gain3, gain4, gain5, gain6, gain7, gain8, gain9, gain10, gain11, gain12, gain13, gain14, gain15, gain16, gain17, gain18, gain19, gain20, gain21, gain22, gain23, gain24, gain25, gain26};
+    copyMultipleWithGain(pDest, pSrc, gain, 27, iNumSamples);
 }
 static inline void copy27WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
@@ -6291,90 +4907,10 @@ static inline void copy27WithRampingGain(CSAMPLE* M_RESTRICT pDest,
     const CSAMPLE_GAIN start_gain25 = gain25in + gain_delta25;
     const CSAMPLE_GAIN gain_delta26 = (gain26out - gain26in) / (iNumSamples / 2);
     const CSAMPLE_GAIN start_gain26 = gain26in + gain_delta26;
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples / 2; ++i) {
-        const CSAMPLE_GAIN gain0 = start_gain0 + gain_delta0 * i;
-        const CSAMPLE_GAIN gain1 = start_gain1 + gain_delta1 * i;
-        const CSAMPLE_GAIN gain2 = start_gain2 + gain_delta2 * i;
-        const CSAMPLE_GAIN gain3 = start_gain3 + gain_delta3 * i;
-        const CSAMPLE_GAIN gain4 = start_gain4 + gain_delta4 * i;
-        const CSAMPLE_GAIN gain5 = start_gain5 + gain_delta5 * i;
-        const CSAMPLE_GAIN gain6 = start_gain6 + gain_delta6 * i;
-        const CSAMPLE_GAIN gain7 = start_gain7 + gain_delta7 * i;
-        const CSAMPLE_GAIN gain8 = start_gain8 + gain_delta8 * i;
-        const CSAMPLE_GAIN gain9 = start_gain9 + gain_delta9 * i;
-        const CSAMPLE_GAIN gain10 = start_gain10 + gain_delta10 * i;
-        const CSAMPLE_GAIN gain11 = start_gain11 + gain_delta11 * i;
-        const CSAMPLE_GAIN gain12 = start_gain12 + gain_delta12 * i;
-        const CSAMPLE_GAIN gain13 = start_gain13 + gain_delta13 * i;
-        const CSAMPLE_GAIN gain14 = start_gain14 + gain_delta14 * i;
-        const CSAMPLE_GAIN gain15 = start_gain15 + gain_delta15 * i;
-        const CSAMPLE_GAIN gain16 = start_gain16 + gain_delta16 * i;
-        const CSAMPLE_GAIN gain17 = start_gain17 + gain_delta17 * i;
-        const CSAMPLE_GAIN gain18 = start_gain18 + gain_delta18 * i;
-        const CSAMPLE_GAIN gain19 = start_gain19 + gain_delta19 * i;
-        const CSAMPLE_GAIN gain20 = start_gain20 + gain_delta20 * i;
-        const CSAMPLE_GAIN gain21 = start_gain21 + gain_delta21 * i;
-        const CSAMPLE_GAIN gain22 = start_gain22 + gain_delta22 * i;
-        const CSAMPLE_GAIN gain23 = start_gain23 + gain_delta23 * i;
-        const CSAMPLE_GAIN gain24 = start_gain24 + gain_delta24 * i;
-        const CSAMPLE_GAIN gain25 = start_gain25 + gain_delta25 * i;
-        const CSAMPLE_GAIN gain26 = start_gain26 + gain_delta26 * i;
-        pDest[i * 2] = pSrc0[i * 2] * gain0 +
-                       pSrc1[i * 2] * gain1 +
-                       pSrc2[i * 2] * gain2 +
-                       pSrc3[i * 2] * gain3 +
-                       pSrc4[i * 2] * gain4 +
-                       pSrc5[i * 2] * gain5 +
-                       pSrc6[i * 2] * gain6 +
-                       pSrc7[i * 2] * gain7 +
-                       pSrc8[i * 2] * gain8 +
-                       pSrc9[i * 2] * gain9 +
-                       pSrc10[i * 2] * gain10 +
-                       pSrc11[i * 2] * gain11 +
-                       pSrc12[i * 2] * gain12 +
-                       pSrc13[i * 2] * gain13 +
-                       pSrc14[i * 2] * gain14 +
-                       pSrc15[i * 2] * gain15 +
-                       pSrc16[i * 2] * gain16 +
-                       pSrc17[i * 2] * gain17 +
-                       pSrc18[i * 2] * gain18 +
-                       pSrc19[i * 2] * gain19 +
-                       pSrc20[i * 2] * gain20 +
-                       pSrc21[i * 2] * gain21 +
-                       pSrc22[i * 2] * gain22 +
-                       pSrc23[i * 2] * gain23 +
-                       pSrc24[i * 2] * gain24 +
-                       pSrc25[i * 2] * gain25 +
-                       pSrc26[i * 2] * gain26;
-        pDest[i * 2 + 1] = pSrc0[i * 2 + 1] * gain0 +
-                           pSrc1[i * 2 + 1] * gain1 +
-                           pSrc2[i * 2 + 1] * gain2 +
-                           pSrc3[i * 2 + 1] * gain3 +
-                           pSrc4[i * 2 + 1] * gain4 +
-                           pSrc5[i * 2 + 1] * gain5 +
-                           pSrc6[i * 2 + 1] * gain6 +
-                           pSrc7[i * 2 + 1] * gain7 +
-                           pSrc8[i * 2 + 1] * gain8 +
-                           pSrc9[i * 2 + 1] * gain9 +
-                           pSrc10[i * 2 + 1] * gain10 +
-                           pSrc11[i * 2 + 1] * gain11 +
-                           pSrc12[i * 2 + 1] * gain12 +
-                           pSrc13[i * 2 + 1] * gain13 +
-                           pSrc14[i * 2 + 1] * gain14 +
-                           pSrc15[i * 2 + 1] * gain15 +
-                           pSrc16[i * 2 + 1] * gain16 +
-                           pSrc17[i * 2 + 1] * gain17 +
-                           pSrc18[i * 2 + 1] * gain18 +
-                           pSrc19[i * 2 + 1] * gain19 +
-                           pSrc20[i * 2 + 1] * gain20 +
-                           pSrc21[i * 2 + 1] * gain21 +
-                           pSrc22[i * 2 + 1] * gain22 +
-                           pSrc23[i * 2 + 1] * gain23 +
-                           pSrc24[i * 2 + 1] * gain24 +
-                           pSrc25[i * 2 + 1] * gain25 +
-                           pSrc26[i * 2 + 1] * gain26;
-    }
+    const CSAMPLE* const pSrc[27] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15, pSrc16, pSrc17, pSrc18, pSrc19, pSrc20, pSrc21, pSrc22, pSrc23, pSrc24, pSrc25, pSrc26};
+    const CSAMPLE_GAIN start_gain[27] = {start_gain0, start_gain1, start_gain2, start_gain3, start_gain4, start_gain5, start_gain6, start_gain7, start_gain8, start_gain9, start_gain10, start_gain11, start_gain12, start_gain13, start_gain14, start_gain15, start_gain16, start_gain17, start_gain18, start_gain19, start_gain20, start_gain21, start_gain22, start_gain23, start_gain24, start_gain25, start_gain26};
+    const CSAMPLE_GAIN gain_delta[27] = {gain_delta0, gain_delta1, gain_delta2, gain_delta3, gain_delta4, gain_delta5, gain_delta6, gain_delta7, gain_delta8, gain_delta9, gain_delta10, gain_delta11, gain_delta12, gain_delta13, gain_delta14, gain_delta15, gain_delta16, gain_delta17, gain_delta18, gain_delta19, gain_delta20, gain_delta21, gain_delta22, gain_delta23, gain_delta24, gain_delta25, gain_delta26};
+    copyMultipleWithRampingGain(pDest, pSrc, start_gain, gain_delta, 27, iNumSamples / 2);
 }
 static inline void copy28WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
@@ -6518,37 +5054,9 @@ static inline void copy28WithGain(CSAMPLE* M_RESTRICT pDest,
         copy27WithGain(pDest, pSrc0, gain0, pSrc1, gain1, pSrc2, gain2, pSrc3, gain3, pSrc4, gain4, pSrc5, gain5, pSrc6, gain6, pSrc7, gain7, pSrc8, gain8, pSrc9, gain9, pSrc10, gain10, pSrc11, gain11, pSrc12, gain12, pSrc13, gain13, pSrc14, gain14, pSrc15, gain15, pSrc16, gain16, pSrc17, gain17, pSrc18, gain18, pSrc19, gain19, pSrc20, gain20, pSrc21, gain21, pSrc22, gain22, pSrc23, gain23, pSrc24, gain24, pSrc25, gain25, pSrc26, gain26, iNumSamples);
         return;
     }
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples; ++i) {
-        pDest[i] = pSrc0[i] * gain0 +
-                   pSrc1[i] * gain1 +
-                   pSrc2[i] * gain2 +
-                   pSrc3[i] * gain3 +
-                   pSrc4[i] * gain4 +
-                   pSrc5[i] * gain5 +
-                   pSrc6[i] * gain6 +
-                   pSrc7[i] * gain7 +
-                   pSrc8[i] * gain8 +
-                   pSrc9[i] * gain9 +
-                   pSrc10[i] * gain10 +
-                   pSrc11[i] * gain11 +
-                   pSrc12[i] * gain12 +
-                   pSrc13[i] * gain13 +
-                   pSrc14[i] * gain14 +
-                   pSrc15[i] * gain15 +
-                   pSrc16[i] * gain16 +
-                   pSrc17[i] * gain17 +
-                   pSrc18[i] * gain18 +
-                   pSrc19[i] * gain19 +
-                   pSrc20[i] * gain20 +
-                   pSrc21[i] * gain21 +
-                   pSrc22[i] * gain22 +
-                   pSrc23[i] * gain23 +
-                   pSrc24[i] * gain24 +
-                   pSrc25[i] * gain25 +
-                   pSrc26[i] * gain26 +
-                   pSrc27[i] * gain27;
-    }
+    const CSAMPLE* const pSrc[28] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15, pSrc16, pSrc17, pSrc18, pSrc19, pSrc20, pSrc21, pSrc22, pSrc23, pSrc24, pSrc25, pSrc26, pSrc27};
+    const CSAMPLE_GAIN gain[28] = {gain0, gain1, gain2, gain3, gain4, gain5, gain6, gain7, gain8, gain9, gain10, gain11, gain12, gain13, gain14, gain15, gain16, gain17, gain18, gain19, gain20, gain21, gain22, gain23, gain24, gain25, gain26, gain27};
+    copyMultipleWithGain(pDest, pSrc, gain, 28, iNumSamples);
 }
 static inline void copy28WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
@@ -6748,93 +5256,10 @@ static inline void copy28WithRampingGain(CSAMPLE* M_RESTRICT pDest,
     const CSAMPLE_GAIN start_gain26 = gain26in + gain_delta26;
     const CSAMPLE_GAIN gain_delta27 = (gain27out - gain27in) / (iNumSamples / 2);
     const CSAMPLE_GAIN start_gain27 = gain27in + gain_delta27;
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples / 2; ++i) {
-        const CSAMPLE_GAIN gain0 = start_gain0 + gain_delta0 * i;
-        const CSAMPLE_GAIN gain1 = start_gain1 + gain_delta1 * i;
-        const CSAMPLE_GAIN gain2 = start_gain2 + gain_delta2 * i;
-        const CSAMPLE_GAIN gain3 = start_gain3 + gain_delta3 * i;
-        const CSAMPLE_GAIN gain4 = start_gain4 + gain_delta4 * i;
-        const CSAMPLE_GAIN gain5 = start_gain5 + gain_delta5 * i;
-        const CSAMPLE_GAIN gain6 = start_gain6 + gain_delta6 * i;
-        const CSAMPLE_GAIN gain7 = start_gain7 + gain_delta7 * i;
-        const CSAMPLE_GAIN gain8 = start_gain8 + gain_delta8 * i;
-        const CSAMPLE_GAIN gain9 = start_gain9 + gain_delta9 * i;
-        const CSAMPLE_GAIN gain10 = start_gain10 + gain_delta10 * i;
-        const CSAMPLE_GAIN gain11 = start_gain11 + gain_delta11 * i;
-        const CSAMPLE_GAIN gain12 = start_gain12 + gain_delta12 * i;
-        const CSAMPLE_GAIN gain13 = start_gain13 + gain_delta13 * i;
-        const CSAMPLE_GAIN gain14 = start_gain14 + gain_delta14 * i;
-        const CSAMPLE_GAIN gain15 = start_gain15 + gain_delta15 * i;
-        const CSAMPLE_GAIN gain16 = start_gain16 + gain_delta16 * i;
-        const CSAMPLE_GAIN gain17 = start_gain17 + gain_delta17 * i;
-        const CSAMPLE_GAIN gain18 = start_gain18 + gain_delta18 * i;
-        const CSAMPLE_GAIN gain19 = start_gain19 + gain_delta19 * i;
-        const CSAMPLE_GAIN gain20 = start_gain20 + gain_delta20 * i;
-        const CSAMPLE_GAIN gain21 = start_gain21 + gain_delta21 * i;
-        const CSAMPLE_GAIN gain22 = start_gain22 + gain_delta22 * i;
-        const CSAMPLE_GAIN gain23 = start_gain23 + gain_delta23 * i;
-        const CSAMPLE_GAIN gain24 = start_gain24 + gain_delta24 * i;
-        const CSAMPLE_GAIN gain25 = start_gain25 + gain_delta25 * i;
-        const CSAMPLE_GAIN gain26 = start_gain26 + gain_delta26 * i;
-        const CSAMPLE_GAIN gain27 = start_gain27 + gain_delta27 * i;
-        pDest[i * 2] = pSrc0[i * 2] * gain0 +
-                       pSrc1[i * 2] * gain1 +
-                       pSrc2[i * 2] * gain2 +
-                       pSrc3[i * 2] * gain3 +
-                       pSrc4[i * 2] * gain4 +
-                       pSrc5[i * 2] * gain5 +
-                       pSrc6[i * 2] * gain6 +
-                       pSrc7[i * 2] * gain7 +
-                       pSrc8[i * 2] * gain8 +
-                       pSrc9[i * 2] * gain9 +
-                       pSrc10[i * 2] * gain10 +
-                       pSrc11[i * 2] * gain11 +
-                       pSrc12[i * 2] * gain12 +
-                       pSrc13[i * 2] * gain13 +
-                       pSrc14[i * 2] * gain14 +
-                       pSrc15[i * 2] * gain15 +
-                       pSrc16[i * 2] * gain16 +
-                       pSrc17[i * 2] * gain17 +
-                       pSrc18[i * 2] * gain18 +
-                       pSrc19[i * 2] * gain19 +
-                       pSrc20[i * 2] * gain20 +
-                       pSrc21[i * 2] * gain21 +
-                       pSrc22[i * 2] * gain22 +
-                       pSrc23[i * 2] * gain23 +
-                       pSrc24[i * 2] * gain24 +
-                       pSrc25[i * 2] * gain25 +
-                       pSrc26[i * 2] * gain26 +
-                       pSrc27[i * 2] * gain27;
-        pDest[i * 2 + 1] = pSrc0[i * 2 + 1] * gain0 +
-                           pSrc1[i * 2 + 1] * gain1 +
-                           pSrc2[i * 2 + 1] * gain2 +
-                           pSrc3[i * 2 + 1] * gain3 +
-                           pSrc4[i * 2 + 1] * gain4 +
-                           pSrc5[i * 2 + 1] * gain5 +
-                           pSrc6[i * 2 + 1] * gain6 +
-                           pSrc7[i * 2 + 1] * gain7 +
-                           pSrc8[i * 2 + 1] * gain8 +
-                           pSrc9[i * 2 + 1] * gain9 +
-                           pSrc10[i * 2 + 1] * gain10 +
-                           pSrc11[i * 2 + 1] * gain11 +
-                           pSrc12[i * 2 + 1] * gain12 +
-                           pSrc13[i * 2 + 1] * gain13 +
-                           pSrc14[i * 2 + 1] * gain14 +
-                           pSrc15[i * 2 + 1] * gain15 +
-                           pSrc16[i * 2 + 1] * gain16 +
-                           pSrc17[i * 2 + 1] * gain17 +
-                           pSrc18[i * 2 + 1] * gain18 +
-                           pSrc19[i * 2 + 1] * gain19 +
-                           pSrc20[i * 2 + 1] * gain20 +
-                           pSrc21[i * 2 + 1] * gain21 +
-                           pSrc22[i * 2 + 1] * gain22 +
-                           pSrc23[i * 2 + 1] * gain23 +
-                           pSrc24[i * 2 + 1] * gain24 +
-                           pSrc25[i * 2 + 1] * gain25 +
-                           pSrc26[i * 2 + 1] * gain26 +
-                           pSrc27[i * 2 + 1] * gain27;
-    }
+    const CSAMPLE* const pSrc[28] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15, pSrc16, pSrc17, pSrc18, pSrc19, pSrc20, pSrc21, pSrc22, pSrc23, pSrc24, pSrc25, pSrc26, pSrc27};
+    const CSAMPLE_GAIN start_gain[28] = {start_gain0, start_gain1, start_gain2, start_gain3, start_gain4, start_gain5, start_gain6, start_gain7, start_gain8, start_gain9, start_gain10, start_gain11, start_gain12, start_gain13, start_gain14, start_gain15, start_gain16, start_gain17, start_gain18, start_gain19, start_gain20, start_gain21, start_gain22, start_gain23, start_gain24, start_gain25, start_gain26, start_gain27};
+    const CSAMPLE_GAIN gain_delta[28] = {gain_delta0, gain_delta1, gain_delta2, gain_delta3, gain_delta4, gain_delta5, gain_delta6, gain_delta7, gain_delta8, gain_delta9, gain_delta10, gain_delta11, gain_delta12, gain_delta13, gain_delta14, gain_delta15, gain_delta16, gain_delta17, gain_delta18, gain_delta19, gain_delta20, gain_delta21, gain_delta22, gain_delta23, gain_delta24, gain_delta25, gain_delta26, gain_delta27};
+    copyMultipleWithRampingGain(pDest, pSrc, start_gain, gain_delta, 28, iNumSamples / 2);
 }
 static inline void copy29WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
@@ -6983,38 +5408,9 @@ static inline void copy29WithGain(CSAMPLE* M_RESTRICT pDest,
         copy28WithGain(pDest, pSrc0, gain0, pSrc1, gain1, pSrc2, gain2, pSrc3, gain3, pSrc4, gain4, pSrc5, gain5, pSrc6, gain6, pSrc7, gain7, pSrc8, gain8, pSrc9, gain9, pSrc10, gain10, pSrc11, gain11, pSrc12, gain12, pSrc13, gain13, pSrc14, gain14, pSrc15, gain15, pSrc16, gain16, pSrc17, gain17, pSrc18, gain18, pSrc19, gain19, pSrc20, gain20, pSrc21, gain21, pSrc22, gain22, pSrc23, gain23, pSrc24, gain24, pSrc25, gain25, pSrc26, gain26, pSrc27, gain27, iNumSamples);
         return;
     }
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples; ++i) {
-        pDest[i] = pSrc0[i] * gain0 +
-                   pSrc1[i] * gain1 +
-                   pSrc2[i] * gain2 +
-                   pSrc3[i] * gain3 +
-                   pSrc4[i] * gain4 +
-                   pSrc5[i] * gain5 +
-                   pSrc6[i] * gain6 +
-                   pSrc7[i] * gain7 +
-                   pSrc8[i] * gain8 +
-                   pSrc9[i] * gain9 +
-                   pSrc10[i] * gain10 +
-                   pSrc11[i] * gain11 +
-                   pSrc12[i] * gain12 +
-                   pSrc13[i] * gain13 +
-                   pSrc14[i] * gain14 +
-                   pSrc15[i] * gain15 +
-                   pSrc16[i] * gain16 +
-                   pSrc17[i] * gain17 +
-                   pSrc18[i] * gain18 +
-                   pSrc19[i] * gain19 +
-                   pSrc20[i] * gain20 +
-                   pSrc21[i] * gain21 +
-                   pSrc22[i] * gain22 +
-                   pSrc23[i] * gain23 +
-                   pSrc24[i] * gain24 +
-                   pSrc25[i] * gain25 +
-                   pSrc26[i] * gain26 +
-                   pSrc27[i] * gain27 +
-                   pSrc28[i] * gain28;
-    }
+    const CSAMPLE* const pSrc[29] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15, pSrc16, pSrc17, pSrc18, pSrc19, pSrc20, pSrc21, pSrc22, pSrc23, pSrc24, pSrc25, pSrc26, pSrc27, pSrc28};
+    const CSAMPLE_GAIN gain[29] = {gain0, gain1, gain2, gain3, gain4, gain5, gain6, gain7, gain8, gain9, gain10, gain11, gain12, gain13, gain14, gain15, gain16, gain17, gain18, gain19, gain20, gain21, gain22, gain23, gain24, gain25, gain26, gain27, gain28};
+    copyMultipleWithGain(pDest, pSrc, gain, 29, iNumSamples);
 }
 static inline void copy29WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
@@ -7221,96 +5617,10 @@ static inline void copy29WithRampingGain(CSAMPLE* M_RESTRICT pDest,
     const CSAMPLE_GAIN start_gain27 = gain27in + gain_delta27;
     const CSAMPLE_GAIN gain_delta28 = (gain28out - gain28in) / (iNumSamples / 2);
     const CSAMPLE_GAIN start_gain28 = gain28in + gain_delta28;
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples / 2; ++i) {
-        const CSAMPLE_GAIN gain0 = start_gain0 + gain_delta0 * i;
-        const CSAMPLE_GAIN gain1 = start_gain1 + gain_delta1 * i;
-        const CSAMPLE_GAIN gain2 = start_gain2 + gain_delta2 * i;
-        const CSAMPLE_GAIN gain3 = start_gain3 + gain_delta3 * i;
-        const CSAMPLE_GAIN gain4 = start_gain4 + gain_delta4 * i;
-        const CSAMPLE_GAIN gain5 = start_gain5 + gain_delta5 * i;
-        const CSAMPLE_GAIN gain6 = start_gain6 + gain_delta6 * i;
-        const CSAMPLE_GAIN gain7 = start_gain7 + gain_delta7 * i;
-        const CSAMPLE_GAIN gain8 = start_gain8 + gain_delta8 * i;
-        const CSAMPLE_GAIN gain9 = start_gain9 + gain_delta9 * i;
-        const CSAMPLE_GAIN gain10 = start_gain10 + gain_delta10 * i;
-        const CSAMPLE_GAIN gain11 = start_gain11 + gain_delta11 * i;
-        const CSAMPLE_GAIN gain12 = start_gain12 + gain_delta12 * i;
-        const CSAMPLE_GAIN gain13 = start_gain13 + gain_delta13 * i;
-        const CSAMPLE_GAIN gain14 = start_gain14 + gain_delta14 * i;
-        const CSAMPLE_GAIN gain15 = start_gain15 + gain_delta15 * i;
-        const CSAMPLE_GAIN gain16 = start_gain16 + gain_delta16 * i;
-        const CSAMPLE_GAIN gain17 = start_gain17 + gain_delta17 * i;
-        const CSAMPLE_GAIN gain18 = start_gain18 + gain_delta18 * i;
-        const CSAMPLE_GAIN gain19 = start_gain19 + gain_delta19 * i;
-        const CSAMPLE_GAIN gain20 = start_gain20 + gain_delta20 * i;
-        const CSAMPLE_GAIN gain21 = start_gain21 + gain_delta21 * i;
-        const CSAMPLE_GAIN gain22 = start_gain22 + gain_delta22 * i;
-        const CSAMPLE_GAIN gain23 = start_gain23 + gain_delta23 * i;
-        const CSAMPLE_GAIN gain24 = start_gain24 + gain_delta24 * i;
-        const CSAMPLE_GAIN gain25 = start_gain25 + gain_delta25 * i;
-        const CSAMPLE_GAIN gain26 = start_gain26 + gain_delta26 * i;
-        const CSAMPLE_GAIN gain27 = start_gain27 + gain_delta27 * i;
-        const CSAMPLE_GAIN gain28 = start_gain28 + gain_delta28 * i;
-        pDest[i * 2] = pSrc0[i * 2] * gain0 +
-                       pSrc1[i * 2] * gain1 +
-                       pSrc2[i * 2] * gain2 +
-                       pSrc3[i * 2] * gain3 +
-                       pSrc4[i * 2] * gain4 +
-                       pSrc5[i * 2] * gain5 +
-                       pSrc6[i * 2] * gain6 +
-                       pSrc7[i * 2] * gain7 +
-                       pSrc8[i * 2] * gain8 +
-                       pSrc9[i * 2] * gain9 +
-                       pSrc10[i * 2] * gain10 +
-                       pSrc11[i * 2] * gain11 +
-                       pSrc12[i * 2] * gain12 +
-                       pSrc13[i * 2] * gain13 +
-                       pSrc14[i * 2] * gain14 +
-                       pSrc15[i * 2] * gain15 +
-                       pSrc16[i * 2] * gain16 +
-                       pSrc17[i * 2] * gain17 +
-                       pSrc18[i * 2] * gain18 +
-                       pSrc19[i * 2] * gain19 +
-                       pSrc20[i * 2] * gain20 +
-                       pSrc21[i * 2] * gain21 +
-                       pSrc22[i * 2] * gain22 +
-                       pSrc23[i * 2] * gain23 +
-                       pSrc24[i * 2] * gain24 +
-                       pSrc25[i * 2] * gain25 +
-                       pSrc26[i * 2] * gain26 +
-                       pSrc27[i * 2] * gain27 +
-                       pSrc28[i * 2] * gain28;
-        pDest[i * 2 + 1] = pSrc0[i * 2 + 1] * gain0 +
-                           pSrc1[i * 2 + 1] * gain1 +
-                           pSrc2[i * 2 + 1] * gain2 +
-                           pSrc3[i * 2 + 1] * gain3 +
-                           pSrc4[i * 2 + 1] * gain4 +
-                           pSrc5[i * 2 + 1] * gain5 +
-                           pSrc6[i * 2 + 1] * gain6 +
-                           pSrc7[i * 2 + 1] * gain7 +
-                           pSrc8[i * 2 + 1] * gain8 +
-                           pSrc9[i * 2 + 1] * gain9 +
-                           pSrc10[i * 2 + 1] * gain10 +
-                           pSrc11[i * 2 + 1] * gain11 +
-                           pSrc12[i * 2 + 1] * gain12 +
-                           pSrc13[i * 2 + 1] * gain13 +
-                           pSrc14[i * 2 + 1] * gain14 +
-                           pSrc15[i * 2 + 1] * gain15 +
-                           pSrc16[i * 2 + 1] * gain16 +
-                           pSrc17[i * 2 + 1] * gain17 +
-                           pSrc18[i * 2 + 1] * gain18 +
-                           pSrc19[i * 2 + 1] * gain19 +
-                           pSrc20[i * 2 + 1] * gain20 +
-                           pSrc21[i * 2 + 1] * gain21 +
-                           pSrc22[i * 2 + 1] * gain22 +
-                           pSrc23[i * 2 + 1] * gain23 +
-                           pSrc24[i * 2 + 1] * gain24 +
-                           pSrc25[i * 2 + 1] * gain25 +
-                           pSrc26[i * 2 + 1] * gain26 +
-                           pSrc27[i * 2 + 1] * gain27 +
-                           pSrc28[i * 2 + 1] * gain28;
-    }
+    const CSAMPLE* const pSrc[29] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15, pSrc16, pSrc17, pSrc18, pSrc19, pSrc20, pSrc21, pSrc22, pSrc23, pSrc24, pSrc25, pSrc26, pSrc27, pSrc28};
+    const CSAMPLE_GAIN start_gain[29] = {start_gain0, start_gain1, start_gain2, start_gain3, start_gain4, start_gain5, start_gain6, start_gain7, start_gain8, start_gain9, start_gain10, start_gain11, start_gain12, start_gain13, start_gain14, start_gain15, start_gain16, start_gain17, start_gain18, start_gain19, start_gain20, start_gain21, start_gain22, start_gain23, start_gain24, start_gain25, start_gain26, start_gain27, start_gain28};
+    const CSAMPLE_GAIN gain_delta[29] = {gain_delta0, gain_delta1, gain_delta2, gain_delta3, gain_delta4, gain_delta5, gain_delta6, gain_delta7, gain_delta8, gain_delta9, gain_delta10, gain_delta11, gain_delta12, gain_delta13, gain_delta14, gain_delta15, gain_delta16, gain_delta17, gain_delta18, gain_delta19, gain_delta20, gain_delta21, gain_delta22, gain_delta23, gain_delta24, gain_delta25, gain_delta26, gain_delta27, gain_delta28};
+    copyMultipleWithRampingGain(pDest, pSrc, start_gain, gain_delta, 29, iNumSamples / 2);
 }
 static inline void copy30WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
@@ -7464,39 +5774,9 @@ static inline void copy30WithGain(CSAMPLE* M_RESTRICT pDest,
         copy29WithGain(pDest, pSrc0, gain0, pSrc1, gain1, pSrc2, gain2, pSrc3, gain3, pSrc4, gain4, pSrc5, gain5, pSrc6, gain6, pSrc7, gain7, pSrc8, gain8, pSrc9, gain9, pSrc10, gain10, pSrc11, gain11, pSrc12, gain12, pSrc13, gain13, pSrc14, gain14, pSrc15, gain15, pSrc16, gain16, pSrc17, gain17, pSrc18, gain18, pSrc19, gain19, pSrc20, gain20, pSrc21, gain21, pSrc22, gain22, pSrc23, gain23, pSrc24, gain24, pSrc25, gain25, pSrc26, gain26, pSrc27, gain27, pSrc28, gain28, iNumSamples);
         return;
     }
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples; ++i) {
-        pDest[i] = pSrc0[i] * gain0 +
-                   pSrc1[i] * gain1 +
-                   pSrc2[i] * gain2 +
-                   pSrc3[i] * gain3 +
-                   pSrc4[i] * gain4 +
-                   pSrc5[i] * gain5 +
-                   pSrc6[i] * gain6 +
-                   pSrc7[i] * gain7 +
-                   pSrc8[i] * gain8 +
-                   pSrc9[i] * gain9 +
-                   pSrc10[i] * gain10 +
-                   pSrc11[i] * gain11 +
-                   pSrc12[i] * gain12 +
-                   pSrc13[i] * gain13 +
-                   pSrc14[i] * gain14 +
-                   pSrc15[i] * gain15 +
-                   pSrc16[i] * gain16 +
-                   pSrc17[i] * gain17 +
-                   pSrc18[i] * gain18 +
-                   pSrc19[i] * gain19 +
-                   pSrc20[i] * gain20 +
-                   pSrc21[i] * gain21 +
-                   pSrc22[i] * gain22 +
-                   pSrc23[i] * gain23 +
-                   pSrc24[i] * gain24 +
-                   pSrc25[i] * gain25 +
-                   pSrc26[i] * gain26 +
-                   pSrc27[i] * gain27 +
-                   pSrc28[i] * gain28 +
-                   pSrc29[i] * gain29;
-    }
+    const CSAMPLE* const pSrc[30] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15, pSrc16, pSrc17, pSrc18, pSrc19, pSrc20, pSrc21, pSrc22, pSrc23, pSrc24, pSrc25, pSrc26, pSrc27, pSrc28, pSrc29};
+    const CSAMPLE_GAIN gain[30] = {gain0, gain1, gain2, gain3, gain4, gain5, gain6, gain7, gain8, gain9, gain10, gain11, gain12, gain13, gain14, gain15, gain16, gain17, gain18, gain19, gain20, gain21, gain22, gain23, gain24, gain25, gain26, gain27, gain28, gain29};
+    copyMultipleWithGain(pDest, pSrc, gain, 30, iNumSamples);
 }
 static inline void copy30WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
@@ -7710,99 +5990,10 @@ static inline void copy30WithRampingGain(CSAMPLE* M_RESTRICT pDest,
     const CSAMPLE_GAIN start_gain28 = gain28in + gain_delta28;
     const CSAMPLE_GAIN gain_delta29 = (gain29out - gain29in) / (iNumSamples / 2);
     const CSAMPLE_GAIN start_gain29 = gain29in + gain_delta29;
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples / 2; ++i) {
-        const CSAMPLE_GAIN gain0 = start_gain0 + gain_delta0 * i;
-        const CSAMPLE_GAIN gain1 = start_gain1 + gain_delta1 * i;
-        const CSAMPLE_GAIN gain2 = start_gain2 + gain_delta2 * i;
-        const CSAMPLE_GAIN gain3 = start_gain3 + gain_delta3 * i;
-        const CSAMPLE_GAIN gain4 = start_gain4 + gain_delta4 * i;
-        const CSAMPLE_GAIN gain5 = start_gain5 + gain_delta5 * i;
-        const CSAMPLE_GAIN gain6 = start_gain6 + gain_delta6 * i;
-        const CSAMPLE_GAIN gain7 = start_gain7 + gain_delta7 * i;
-        const CSAMPLE_GAIN gain8 = start_gain8 + gain_delta8 * i;
-        const CSAMPLE_GAIN gain9 = start_gain9 + gain_delta9 * i;
-        const CSAMPLE_GAIN gain10 = start_gain10 + gain_delta10 * i;
-        const CSAMPLE_GAIN gain11 = start_gain11 + gain_delta11 * i;
-        const CSAMPLE_GAIN gain12 = start_gain12 + gain_delta12 * i;
-        const CSAMPLE_GAIN gain13 = start_gain13 + gain_delta13 * i;
-        const CSAMPLE_GAIN gain14 = start_gain14 + gain_delta14 * i;
-        const CSAMPLE_GAIN gain15 = start_gain15 + gain_delta15 * i;
-        const CSAMPLE_GAIN gain16 = start_gain16 + gain_delta16 * i;
-        const CSAMPLE_GAIN gain17 = start_gain17 + gain_delta17 * i;
-        const CSAMPLE_GAIN gain18 = start_gain18 + gain_delta18 * i;
-        const CSAMPLE_GAIN gain19 = start_gain19 + gain_delta19 * i;
-        const CSAMPLE_GAIN gain20 = start_gain20 + gain_delta20 * i;
-        const CSAMPLE_GAIN gain21 = start_gain21 + gain_delta21 * i;
-        const CSAMPLE_GAIN gain22 = start_gain22 + gain_delta22 * i;
-        const CSAMPLE_GAIN gain23 = start_gain23 + gain_delta23 * i;
-        const CSAMPLE_GAIN gain24 = start_gain24 + gain_delta24 * i;
-        const CSAMPLE_GAIN gain25 = start_gain25 + gain_delta25 * i;
-        const CSAMPLE_GAIN gain26 = start_gain26 + gain_delta26 * i;
-        const CSAMPLE_GAIN gain27 = start_gain27 + gain_delta27 * i;
-        const CSAMPLE_GAIN gain28 = start_gain28 + gain_delta28 * i;
-        const CSAMPLE_GAIN gain29 = start_gain29 + gain_delta29 * i;
-        pDest[i * 2] = pSrc0[i * 2] * gain0 +
-                       pSrc1[i * 2] * gain1 +
-                       pSrc2[i * 2] * gain2 +
-                       pSrc3[i * 2] * gain3 +
-                       pSrc4[i * 2] * gain4 +
-                       pSrc5[i * 2] * gain5 +
-                       pSrc6[i * 2] * gain6 +
-                       pSrc7[i * 2] * gain7 +
-                       pSrc8[i * 2] * gain8 +
-                       pSrc9[i * 2] * gain9 +
-                       pSrc10[i * 2] * gain10 +
-                       pSrc11[i * 2] * gain11 +
-                       pSrc12[i * 2] * gain12 +
-                       pSrc13[i * 2] * gain13 +
-                       pSrc14[i * 2] * gain14 +
-                       pSrc15[i * 2] * gain15 +
-                       pSrc16[i * 2] * gain16 +
-                       pSrc17[i * 2] * gain17 +
-                       pSrc18[i * 2] * gain18 +
-                       pSrc19[i * 2] * gain19 +
-                       pSrc20[i * 2] * gain20 +
-                       pSrc21[i * 2] * gain21 +
-                       pSrc22[i * 2] * gain22 +
-                       pSrc23[i * 2] * gain23 +
-                       pSrc24[i * 2] * gain24 +
-                       pSrc25[i * 2] * gain25 +
-                       pSrc26[i * 2] * gain26 +
-                       pSrc27[i * 2] * gain27 +
-                       pSrc28[i * 2] * gain28 +
-                       pSrc29[i * 2] * gain29;
-        pDest[i * 2 + 1] = pSrc0[i * 2 + 1] * gain0 +
-                           pSrc1[i * 2 + 1] * gain1 +
-                           pSrc2[i * 2 + 1] * gain2 +
-                           pSrc3[i * 2 + 1] * gain3 +
-                           pSrc4[i * 2 + 1] * gain4 +
-                           pSrc5[i * 2 + 1] * gain5 +
-                           pSrc6[i * 2 + 1] * gain6 +
-                           pSrc7[i * 2 + 1] * gain7 +
-                           pSrc8[i * 2 + 1] * gain8 +
-                           pSrc9[i * 2 + 1] * gain9 +
-                           pSrc10[i * 2 + 1] * gain10 +
-                           pSrc11[i * 2 + 1] * gain11 +
-                           pSrc12[i * 2 + 1] * gain12 +
-                           pSrc13[i * 2 + 1] * gain13 +
-                           pSrc14[i * 2 + 1] * gain14 +
-                           pSrc15[i * 2 + 1] * gain15 +
-                           pSrc16[i * 2 + 1] * gain16 +
-                           pSrc17[i * 2 + 1] * gain17 +
-                           pSrc18[i * 2 + 1] * gain18 +
-                           pSrc19[i * 2 + 1] * gain19 +
-                           pSrc20[i * 2 + 1] * gain20 +
-                           pSrc21[i * 2 + 1] * gain21 +
-                           pSrc22[i * 2 + 1] * gain22 +
-                           pSrc23[i * 2 + 1] * gain23 +
-                           pSrc24[i * 2 + 1] * gain24 +
-                           pSrc25[i * 2 + 1] * gain25 +
-                           pSrc26[i * 2 + 1] * gain26 +
-                           pSrc27[i * 2 + 1] * gain27 +
-                           pSrc28[i * 2 + 1] * gain28 +
-                           pSrc29[i * 2 + 1] * gain29;
-    }
+    const CSAMPLE* const pSrc[30] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15, pSrc16, pSrc17, pSrc18, pSrc19, pSrc20, pSrc21, pSrc22, pSrc23, pSrc24, pSrc25, pSrc26, pSrc27, pSrc28, pSrc29};
+    const CSAMPLE_GAIN start_gain[30] = {start_gain0, start_gain1, start_gain2, start_gain3, start_gain4, start_gain5, start_gain6, start_gain7, start_gain8, start_gain9, start_gain10, start_gain11, start_gain12, start_gain13, start_gain14, start_gain15, start_gain16, start_gain17, start_gain18, start_gain19, start_gain20, start_gain21, start_gain22, start_gain23, start_gain24, start_gain25, start_gain26, start_gain27, start_gain28, start_gain29};
+    const CSAMPLE_GAIN gain_delta[30] = {gain_delta0, gain_delta1, gain_delta2, gain_delta3, gain_delta4, gain_delta5, gain_delta6, gain_delta7, gain_delta8, gain_delta9, gain_delta10, gain_delta11, gain_delta12, gain_delta13, gain_delta14, gain_delta15, gain_delta16, gain_delta17, gain_delta18, gain_delta19, gain_delta20, gain_delta21, gain_delta22, gain_delta23, gain_delta24, gain_delta25, gain_delta26, gain_delta27, gain_delta28, gain_delta29};
+    copyMultipleWithRampingGain(pDest, pSrc, start_gain, gain_delta, 30, iNumSamples / 2);
 }
 static inline void copy31WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
@@ -7961,40 +6152,9 @@ static inline void copy31WithGain(CSAMPLE* M_RESTRICT pDest,
         copy30WithGain(pDest, pSrc0, gain0, pSrc1, gain1, pSrc2, gain2, pSrc3, gain3, pSrc4, gain4, pSrc5, gain5, pSrc6, gain6, pSrc7, gain7, pSrc8, gain8, pSrc9, gain9, pSrc10, gain10, pSrc11, gain11, pSrc12, gain12, pSrc13, gain13, pSrc14, gain14, pSrc15, gain15, pSrc16, gain16, pSrc17, gain17, pSrc18, gain18, pSrc19, gain19, pSrc20, gain20, pSrc21, gain21, pSrc22, gain22, pSrc23, gain23, pSrc24, gain24, pSrc25, gain25, pSrc26, gain26, pSrc27, gain27, pSrc28, gain28, pSrc29, gain29, iNumSamples);
         return;
     }
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples; ++i) {
-        pDest[i] = pSrc0[i] * gain0 +
-                   pSrc1[i] * gain1 +
-                   pSrc2[i] * gain2 +
-                   pSrc3[i] * gain3 +
-                   pSrc4[i] * gain4 +
-                   pSrc5[i] * gain5 +
-                   pSrc6[i] * gain6 +
-                   pSrc7[i] * gain7 +
-                   pSrc8[i] * gain8 +
-                   pSrc9[i] * gain9 +
-                   pSrc10[i] * gain10 +
-                   pSrc11[i] * gain11 +
-                   pSrc12[i] * gain12 +
-                   pSrc13[i] * gain13 +
-                   pSrc14[i] * gain14 +
-                   pSrc15[i] * gain15 +
-                   pSrc16[i] * gain16 +
-                   pSrc17[i] * gain17 +
-                   pSrc18[i] * gain18 +
-                   pSrc19[i] * gain19 +
-                   pSrc20[i] * gain20 +
-                   pSrc21[i] * gain21 +
-                   pSrc22[i] * gain22 +
-                   pSrc23[i] * gain23 +
-                   pSrc24[i] * gain24 +
-                   pSrc25[i] * gain25 +
-                   pSrc26[i] * gain26 +
-                   pSrc27[i] * gain27 +
-                   pSrc28[i] * gain28 +
-                   pSrc29[i] * gain29 +
-                   pSrc30[i] * gain30;
-    }
+    const CSAMPLE* const pSrc[31] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15, pSrc16, pSrc17, pSrc18, pSrc19, pSrc20, pSrc21, pSrc22, pSrc23, pSrc24, pSrc25, pSrc26, pSrc27, pSrc28, pSrc29, pSrc30};
+    const CSAMPLE_GAIN gain[31] = {gain0, gain1, gain2, gain3, gain4, gain5, gain6, gain7, gain8, gain9, gain10, gain11, gain12, gain13, gain14, gain15, gain16, gain17, gain18, gain19, gain20, gain21, gain22, gain23, gain24, gain25, gain26, gain27, gain28, gain29, gain30};
+    copyMultipleWithGain(pDest, pSrc, gain, 31, iNumSamples);
 }
 static inline void copy31WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
@@ -8215,102 +6375,10 @@ static inline void copy31WithRampingGain(CSAMPLE* M_RESTRICT pDest,
     const CSAMPLE_GAIN start_gain29 = gain29in + gain_delta29;
     const CSAMPLE_GAIN gain_delta30 = (gain30out - gain30in) / (iNumSamples / 2);
     const CSAMPLE_GAIN start_gain30 = gain30in + gain_delta30;
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples / 2; ++i) {
-        const CSAMPLE_GAIN gain0 = start_gain0 + gain_delta0 * i;
-        const CSAMPLE_GAIN gain1 = start_gain1 + gain_delta1 * i;
-        const CSAMPLE_GAIN gain2 = start_gain2 + gain_delta2 * i;
-        const CSAMPLE_GAIN gain3 = start_gain3 + gain_delta3 * i;
-        const CSAMPLE_GAIN gain4 = start_gain4 + gain_delta4 * i;
-        const CSAMPLE_GAIN gain5 = start_gain5 + gain_delta5 * i;
-        const CSAMPLE_GAIN gain6 = start_gain6 + gain_delta6 * i;
-        const CSAMPLE_GAIN gain7 = start_gain7 + gain_delta7 * i;
-        const CSAMPLE_GAIN gain8 = start_gain8 + gain_delta8 * i;
-        const CSAMPLE_GAIN gain9 = start_gain9 + gain_delta9 * i;
-        const CSAMPLE_GAIN gain10 = start_gain10 + gain_delta10 * i;
-        const CSAMPLE_GAIN gain11 = start_gain11 + gain_delta11 * i;
-        const CSAMPLE_GAIN gain12 = start_gain12 + gain_delta12 * i;
-        const CSAMPLE_GAIN gain13 = start_gain13 + gain_delta13 * i;
-        const CSAMPLE_GAIN gain14 = start_gain14 + gain_delta14 * i;
-        const CSAMPLE_GAIN gain15 = start_gain15 + gain_delta15 * i;
-        const CSAMPLE_GAIN gain16 = start_gain16 + gain_delta16 * i;
-        const CSAMPLE_GAIN gain17 = start_gain17 + gain_delta17 * i;
-        const CSAMPLE_GAIN gain18 = start_gain18 + gain_delta18 * i;
-        const CSAMPLE_GAIN gain19 = start_gain19 + gain_delta19 * i;
-        const CSAMPLE_GAIN gain20 = start_gain20 + gain_delta20 * i;
-        const CSAMPLE_GAIN gain21 = start_gain21 + gain_delta21 * i;
-        const CSAMPLE_GAIN gain22 = start_gain22 + gain_delta22 * i;
-        const CSAMPLE_GAIN gain23 = start_gain23 + gain_delta23 * i;
-        const CSAMPLE_GAIN gain24 = start_gain24 + gain_delta24 * i;
-        const CSAMPLE_GAIN gain25 = start_gain25 + gain_delta25 * i;
-        const CSAMPLE_GAIN gain26 = start_gain26 + gain_delta26 * i;
-        const CSAMPLE_GAIN gain27 = start_gain27 + gain_delta27 * i;
-        const CSAMPLE_GAIN gain28 = start_gain28 + gain_delta28 * i;
-        const CSAMPLE_GAIN gain29 = start_gain29 + gain_delta29 * i;
-        const CSAMPLE_GAIN gain30 = start_gain30 + gain_delta30 * i;
-        pDest[i * 2] = pSrc0[i * 2] * gain0 +
-                       pSrc1[i * 2] * gain1 +
-                       pSrc2[i * 2] * gain2 +
-                       pSrc3[i * 2] * gain3 +
-                       pSrc4[i * 2] * gain4 +
-                       pSrc5[i * 2] * gain5 +
-                       pSrc6[i * 2] * gain6 +
-                       pSrc7[i * 2] * gain7 +
-                       pSrc8[i * 2] * gain8 +
-                       pSrc9[i * 2] * gain9 +
-                       pSrc10[i * 2] * gain10 +
-                       pSrc11[i * 2] * gain11 +
-                       pSrc12[i * 2] * gain12 +
-                       pSrc13[i * 2] * gain13 +
-                       pSrc14[i * 2] * gain14 +
-                       pSrc15[i * 2] * gain15 +
-                       pSrc16[i * 2] * gain16 +
-                       pSrc17[i * 2] * gain17 +
-                       pSrc18[i * 2] * gain18 +
-                       pSrc19[i * 2] * gain19 +
-                       pSrc20[i * 2] * gain20 +
-                       pSrc21[i * 2] * gain21 +
-                       pSrc22[i * 2] * gain22 +
-                       pSrc23[i * 2] * gain23 +
-                       pSrc24[i * 2] * gain24 +
-                       pSrc25[i * 2] * gain25 +
-                       pSrc26[i * 2] * gain26 +
-                       pSrc27[i * 2] * gain27 +
-                       pSrc28[i * 2] * gain28 +
-                       pSrc29[i * 2] * gain29 +
-                       pSrc30[i * 2] * gain30;
-        pDest[i * 2 + 1] = pSrc0[i * 2 + 1] * gain0 +
-                           pSrc1[i * 2 + 1] * gain1 +
-                           pSrc2[i * 2 + 1] * gain2 +
-                           pSrc3[i * 2 + 1] * gain3 +
-                           pSrc4[i * 2 + 1] * gain4 +
-                           pSrc5[i * 2 + 1] * gain5 +
-                           pSrc6[i * 2 + 1] * gain6 +
-                           pSrc7[i * 2 + 1] * gain7 +
-                           pSrc8[i * 2 + 1] * gain8 +
-                           pSrc9[i * 2 + 1] * gain9 +
-                           pSrc10[i * 2 + 1] * gain10 +
-                           pSrc11[i * 2 + 1] * gain11 +
-                           pSrc12[i * 2 + 1] * gain12 +
-                           pSrc13[i * 2 + 1] * gain13 +
-                           pSrc14[i * 2 + 1] * gain14 +
-                           pSrc15[i * 2 + 1] * gain15 +
-                           pSrc16[i * 2 + 1] * gain16 +
-                           pSrc17[i * 2 + 1] * gain17 +
-                           pSrc18[i * 2 + 1] * gain18 +
-                           pSrc19[i * 2 + 1] * gain19 +
-                           pSrc20[i * 2 + 1] * gain20 +
-                           pSrc21[i * 2 + 1] * gain21 +
-                           pSrc22[i * 2 + 1] * gain22 +
-                           pSrc23[i * 2 + 1] * gain23 +
-                           pSrc24[i * 2 + 1] * gain24 +
-                           pSrc25[i * 2 + 1] * gain25 +
-                           pSrc26[i * 2 + 1] * gain26 +
-                           pSrc27[i * 2 + 1] * gain27 +
-                           pSrc28[i * 2 + 1] * gain28 +
-                           pSrc29[i * 2 + 1] * gain29 +
-                           pSrc30[i * 2 + 1] * gain30;
-    }
+    const CSAMPLE* const pSrc[31] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15, pSrc16, pSrc17, pSrc18, pSrc19, pSrc20, pSrc21, pSrc22, pSrc23, pSrc24, pSrc25, pSrc26, pSrc27, pSrc28, pSrc29, pSrc30};
+    const CSAMPLE_GAIN start_gain[31] = {start_gain0, start_gain1, start_gain2, start_gain3, start_gain4, start_gain5, start_gain6, start_gain7, start_gain8, start_gain9, start_gain10, start_gain11, start_gain12, start_gain13, start_gain14, start_gain15, start_gain16, start_gain17, start_gain18, start_gain19, start_gain20, start_gain21, start_gain22, start_gain23, start_gain24, start_gain25, start_gain26, start_gain27, start_gain28, start_gain29, start_gain30};
+    const CSAMPLE_GAIN gain_delta[31] = {gain_delta0, gain_delta1, gain_delta2, gain_delta3, gain_delta4, gain_delta5, gain_delta6, gain_delta7, gain_delta8, gain_delta9, gain_delta10, gain_delta11, gain_delta12, gain_delta13, gain_delta14, gain_delta15, gain_delta16, gain_delta17, gain_delta18, gain_delta19, gain_delta20, gain_delta21, gain_delta22, gain_delta23, gain_delta24, gain_delta25, gain_delta26, gain_delta27, gain_delta28, gain_delta29, gain_delta30};
+    copyMultipleWithRampingGain(pDest, pSrc, start_gain, gain_delta, 31, iNumSamples / 2);
 }
 static inline void copy32WithGain(CSAMPLE* M_RESTRICT pDest,
                                   const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0,
@@ -8474,41 +6542,9 @@ static inline void copy32WithGain(CSAMPLE* M_RESTRICT pDest,
         copy31WithGain(pDest, pSrc0, gain0, pSrc1, gain1, pSrc2, gain2, pSrc3, gain3, pSrc4, gain4, pSrc5, gain5, pSrc6, gain6, pSrc7, gain7, pSrc8, gain8, pSrc9, gain9, pSrc10, gain10, pSrc11, gain11, pSrc12, gain12, pSrc13, gain13, pSrc14, gain14, pSrc15, gain15, pSrc16, gain16, pSrc17, gain17, pSrc18, gain18, pSrc19, gain19, pSrc20, gain20, pSrc21, gain21, pSrc22, gain22, pSrc23, gain23, pSrc24, gain24, pSrc25, gain25, pSrc26, gain26, pSrc27, gain27, pSrc28, gain28, pSrc29, gain29, pSrc30, gain30, iNumSamples);
         return;
     }
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples; ++i) {
-        pDest[i] = pSrc0[i] * gain0 +
-                   pSrc1[i] * gain1 +
-                   pSrc2[i] * gain2 +
-                   pSrc3[i] * gain3 +
-                   pSrc4[i] * gain4 +
-                   pSrc5[i] * gain5 +
-                   pSrc6[i] * gain6 +
-                   pSrc7[i] * gain7 +
-                   pSrc8[i] * gain8 +
-                   pSrc9[i] * gain9 +
-                   pSrc10[i] * gain10 +
-                   pSrc11[i] * gain11 +
-                   pSrc12[i] * gain12 +
-                   pSrc13[i] * gain13 +
-                   pSrc14[i] * gain14 +
-                   pSrc15[i] * gain15 +
-                   pSrc16[i] * gain16 +
-                   pSrc17[i] * gain17 +
-                   pSrc18[i] * gain18 +
-                   pSrc19[i] * gain19 +
-                   pSrc20[i] * gain20 +
-                   pSrc21[i] * gain21 +
-                   pSrc22[i] * gain22 +
-                   pSrc23[i] * gain23 +
-                   pSrc24[i] * gain24 +
-                   pSrc25[i] * gain25 +
-                   pSrc26[i] * gain26 +
-                   pSrc27[i] * gain27 +
-                   pSrc28[i] * gain28 +
-                   pSrc29[i] * gain29 +
-                   pSrc30[i] * gain30 +
-                   pSrc31[i] * gain31;
-    }
+    const CSAMPLE* const pSrc[32] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15, pSrc16, pSrc17, pSrc18, pSrc19, pSrc20, pSrc21, pSrc22, pSrc23, pSrc24, pSrc25, pSrc26, pSrc27, pSrc28, pSrc29, pSrc30, pSrc31};
+    const CSAMPLE_GAIN gain[32] = {gain0, gain1, gain2, gain3, gain4, gain5, gain6, gain7, gain8, gain9, gain10, gain11, gain12, gain13, gain14, gain15, gain16, gain17, gain18, gain19, gain20, gain21, gain22, gain23, gain24, gain25, gain26, gain27, gain28, gain29, gain30, gain31};
+    copyMultipleWithGain(pDest, pSrc, gain, 32, iNumSamples);
 }
 static inline void copy32WithRampingGain(CSAMPLE* M_RESTRICT pDest,
                                          const CSAMPLE* M_RESTRICT pSrc0, CSAMPLE_GAIN gain0in, CSAMPLE_GAIN gain0out,
@@ -8736,104 +6772,9 @@ static inline void copy32WithRampingGain(CSAMPLE* M_RESTRICT pDest,
     const CSAMPLE_GAIN start_gain30 = gain30in + gain_delta30;
     const CSAMPLE_GAIN gain_delta31 = (gain31out - gain31in) / (iNumSamples / 2);
     const CSAMPLE_GAIN start_gain31 = gain31in + gain_delta31;
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < iNumSamples / 2; ++i) {
-        const CSAMPLE_GAIN gain0 = start_gain0 + gain_delta0 * i;
-        const CSAMPLE_GAIN gain1 = start_gain1 + gain_delta1 * i;
-        const CSAMPLE_GAIN gain2 = start_gain2 + gain_delta2 * i;
-        const CSAMPLE_GAIN gain3 = start_gain3 + gain_delta3 * i;
-        const CSAMPLE_GAIN gain4 = start_gain4 + gain_delta4 * i;
-        const CSAMPLE_GAIN gain5 = start_gain5 + gain_delta5 * i;
-        const CSAMPLE_GAIN gain6 = start_gain6 + gain_delta6 * i;
-        const CSAMPLE_GAIN gain7 = start_gain7 + gain_delta7 * i;
-        const CSAMPLE_GAIN gain8 = start_gain8 + gain_delta8 * i;
-        const CSAMPLE_GAIN gain9 = start_gain9 + gain_delta9 * i;
-        const CSAMPLE_GAIN gain10 = start_gain10 + gain_delta10 * i;
-        const CSAMPLE_GAIN gain11 = start_gain11 + gain_delta11 * i;
-        const CSAMPLE_GAIN gain12 = start_gain12 + gain_delta12 * i;
-        const CSAMPLE_GAIN gain13 = start_gain13 + gain_delta13 * i;
-        const CSAMPLE_GAIN gain14 = start_gain14 + gain_delta14 * i;
-        const CSAMPLE_GAIN gain15 = start_gain15 + gain_delta15 * i;
-        const CSAMPLE_GAIN gain16 = start_gain16 + gain_delta16 * i;
-        const CSAMPLE_GAIN gain17 = start_gain17 + gain_delta17 * i;
-        const CSAMPLE_GAIN gain18 = start_gain18 + gain_delta18 * i;
-        const CSAMPLE_GAIN gain19 = start_gain19 + gain_delta19 * i;
-        const CSAMPLE_GAIN gain20 = start_gain20 + gain_delta20 * i;
-        const CSAMPLE_GAIN gain21 = start_gain21 + gain_delta21 * i;
-        const CSAMPLE_GAIN gain22 = start_gain22 + gain_delta22 * i;
-        const CSAMPLE_GAIN gain23 = start_gain23 + gain_delta23 * i;
-        const CSAMPLE_GAIN gain24 = start_gain24 + gain_delta24 * i;
-        const CSAMPLE_GAIN gain25 = start_gain25 + gain_delta25 * i;
-        const CSAMPLE_GAIN gain26 = start_gain26 + gain_delta26 * i;
-        const CSAMPLE_GAIN gain27 = start_gain27 + gain_delta27 * i;
-        const CSAMPLE_GAIN gain28 = start_gain28 + gain_delta28 * i;
-        const CSAMPLE_GAIN gain29 = start_gain29 + gain_delta29 * i;
-        const CSAMPLE_GAIN gain30 = start_gain30 + gain_delta30 * i;
-        const CSAMPLE_GAIN gain31 = start_gain31 + gain_delta31 * i;
-        pDest[i * 2] = pSrc0[i * 2] * gain0 +
-                       pSrc1[i * 2] * gain1 +
-                       pSrc2[i * 2] * gain2 +
-                       pSrc3[i * 2] * gain3 +
-                       pSrc4[i * 2] * gain4 +
-                       pSrc5[i * 2] * gain5 +
-                       pSrc6[i * 2] * gain6 +
-                       pSrc7[i * 2] * gain7 +
-                       pSrc8[i * 2] * gain8 +
-                       pSrc9[i * 2] * gain9 +
-                       pSrc10[i * 2] * gain10 +
-                       pSrc11[i * 2] * gain11 +
-                       pSrc12[i * 2] * gain12 +
-                       pSrc13[i * 2] * gain13 +
-                       pSrc14[i * 2] * gain14 +
-                       pSrc15[i * 2] * gain15 +
-                       pSrc16[i * 2] * gain16 +
-                       pSrc17[i * 2] * gain17 +
-                       pSrc18[i * 2] * gain18 +
-                       pSrc19[i * 2] * gain19 +
-                       pSrc20[i * 2] * gain20 +
-                       pSrc21[i * 2] * gain21 +
-                       pSrc22[i * 2] * gain22 +
-                       pSrc23[i * 2] * gain23 +
-                       pSrc24[i * 2] * gain24 +
-                       pSrc25[i * 2] * gain25 +
-                       pSrc26[i * 2] * gain26 +
-                       pSrc27[i * 2] * gain27 +
-                       pSrc28[i * 2] * gain28 +
-                       pSrc29[i * 2] * gain29 +
-                       pSrc30[i * 2] * gain30 +
-                       pSrc31[i * 2] * gain31;
-        pDest[i * 2 + 1] = pSrc0[i * 2 + 1] * gain0 +
-                           pSrc1[i * 2 + 1] * gain1 +
-                           pSrc2[i * 2 + 1] * gain2 +
-                           pSrc3[i * 2 + 1] * gain3 +
-                           pSrc4[i * 2 + 1] * gain4 +
-                           pSrc5[i * 2 + 1] * gain5 +
-                           pSrc6[i * 2 + 1] * gain6 +
-                           pSrc7[i * 2 + 1] * gain7 +
-                           pSrc8[i * 2 + 1] * gain8 +
-                           pSrc9[i * 2 + 1] * gain9 +
-                           pSrc10[i * 2 + 1] * gain10 +
-                           pSrc11[i * 2 + 1] * gain11 +
-                           pSrc12[i * 2 + 1] * gain12 +
-                           pSrc13[i * 2 + 1] * gain13 +
-                           pSrc14[i * 2 + 1] * gain14 +
-                           pSrc15[i * 2 + 1] * gain15 +
-                           pSrc16[i * 2 + 1] * gain16 +
-                           pSrc17[i * 2 + 1] * gain17 +
-                           pSrc18[i * 2 + 1] * gain18 +
-                           pSrc19[i * 2 + 1] * gain19 +
-                           pSrc20[i * 2 + 1] * gain20 +
-                           pSrc21[i * 2 + 1] * gain21 +
-                           pSrc22[i * 2 + 1] * gain22 +
-                           pSrc23[i * 2 + 1] * gain23 +
-                           pSrc24[i * 2 + 1] * gain24 +
-                           pSrc25[i * 2 + 1] * gain25 +
-                           pSrc26[i * 2 + 1] * gain26 +
-                           pSrc27[i * 2 + 1] * gain27 +
-                           pSrc28[i * 2 + 1] * gain28 +
-                           pSrc29[i * 2 + 1] * gain29 +
-                           pSrc30[i * 2 + 1] * gain30 +
-                           pSrc31[i * 2 + 1] * gain31;
-    }
+    const CSAMPLE* const pSrc[32] = {pSrc0, pSrc1, pSrc2, pSrc3, pSrc4, pSrc5, pSrc6, pSrc7, pSrc8, pSrc9, pSrc10, pSrc11, pSrc12, pSrc13, pSrc14, pSrc15, pSrc16, pSrc17, pSrc18, pSrc19, pSrc20, pSrc21, pSrc22, pSrc23, pSrc24, pSrc25, pSrc26, pSrc27, pSrc28, pSrc29, pSrc30, pSrc31};
+    const CSAMPLE_GAIN start_gain[32] = {start_gain0, start_gain1, start_gain2, start_gain3, start_gain4, start_gain5, start_gain6, start_gain7, start_gain8, start_gain9, start_gain10, start_gain11, start_gain12, start_gain13, start_gain14, start_gain15, start_gain16, start_gain17, start_gain18, start_gain19, start_gain20, start_gain21, start_gain22, start_gain23, start_gain24, start_gain25, start_gain26, start_gain27, start_gain28, start_gain29, start_gain30, start_gain31};
+    const CSAMPLE_GAIN gain_delta[32] = {gain_delta0, gain_delta1, gain_delta2, gain_delta3, gain_delta4, gain_delta5, gain_delta6, gain_delta7, gain_delta8, gain_delta9, gain_delta10, gain_delta11, gain_delta12, gain_delta13, gain_delta14, gain_delta15, gain_delta16, gain_delta17, gain_delta18, gain_delta19, gain_delta20, gain_delta21, gain_delta22, gain_delta23, gain_delta24, gain_delta25, gain_delta26, gain_delta27, gain_delta28, gain_delta29, gain_delta30, gain_delta31};
+    copyMultipleWithRampingGain(pDest, pSrc, start_gain, gain_delta, 32, iNumSamples / 2);
 }
 #endif /* MIXXX_UTIL_SAMPLEAUTOGEN_H */
@@ -0,0 +1,499 @@
+#include "util/samplekernels.h"
+
+#include "util/math.h"
+#include "util/platform.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MIXXX_SAMPLEKERNELS_SSE2
+#include <emmintrin.h>
+#endif
+
+// The AVX kernels are compiled for the AVX target independent of the
+// compiler flags and are only selected if the CPU supports AVX.
+#if defined(MIXXX_SAMPLEKERNELS_SSE2) && \
+        (defined(_MSC_VER) || defined(__clang__) || \
+        (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+#define MIXXX_SAMPLEKERNELS_AVX
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define M_TARGET_AVX
+#else
+#define M_TARGET_AVX __attribute__((target("avx")))
+#endif
+#endif
+
+namespace mixxx {
+
+namespace {
+
+// Scalar kernels. They also process the remaining samples
+// that do not fill a whole vector register.
+
+inline void copyWithRampingGainScalarFrom(CSAMPLE* M_RESTRICT pDest,
+        const CSAMPLE* M_RESTRICT pSrc, CSAMPLE_GAIN startGain,
+        CSAMPLE_GAIN gainDelta, int firstFrame, int numFrames) {
+    for (int i = firstFrame; i < numFrames; ++i) {
+        const CSAMPLE_GAIN gain = startGain + gainDelta * i;
+        pDest[i * 2] = pSrc[i * 2] * gain;
+        pDest[i * 2 + 1] = pSrc[i * 2 + 1] * gain;
+    }
+}
+
+inline void addWithRampingGainScalarFrom(CSAMPLE* M_RESTRICT pDest,
+        const CSAMPLE* M_RESTRICT pSrc, CSAMPLE_GAIN startGain,
+        CSAMPLE_GAIN gainDelta, int firstFrame, int numFrames) {
+    for (int i = firstFrame; i < numFrames; ++i) {
+        const CSAMPLE_GAIN gain = startGain + gainDelta * i;
+        pDest[i * 2] += pSrc[i * 2] * gain;
+        pDest[i * 2 + 1] += pSrc[i * 2 + 1] * gain;
+    }
+}
+
+inline void copyMultipleWithGainScalarFrom(CSAMPLE* pDest,
+        const CSAMPLE* const* pSrc, const CSAMPLE_GAIN* pGain,
+        int numChannels, int firstSample, int numSamples) {
+    for (int i = firstSample; i < numSamples; ++i) {
+        CSAMPLE sum = pSrc[0][i] * pGain[0];
+        for (int j = 1; j < numChannels; ++j) {
+            sum += pSrc[j][i] * pGain[j];
+        }
+        pDest[i] = sum;
+    }
+}
+
+inline void copyMultipleWithRampingGainScalarFrom(CSAMPLE* pDest,
+        const CSAMPLE* const* pSrc, const CSAMPLE_GAIN* pStartGain,
+        const CSAMPLE_GAIN* pGainDelta, int numChannels,
+        int firstFrame, int numFrames) {
+    for (int i = firstFrame; i < numFrames; ++i) {
+        const CSAMPLE_GAIN gain0 = pStartGain[0] + pGainDelta[0] * i;
+        CSAMPLE sumL = pSrc[0][i * 2] * gain0;
+        CSAMPLE sumR = pSrc[0][i * 2 + 1] * gain0;
+        for (int j = 1; j < numChannels; ++j) {
+            const CSAMPLE_GAIN gain = pStartGain[j] + pGainDelta[j] * i;
+            sumL += pSrc[j][i * 2] * gain;
+            sumR += pSrc[j][i * 2 + 1] * gain;
+        }
+        pDest[i * 2] = sumL;
+        pDest[i * 2 + 1] = sumR;
+    }
+}
+
+inline void copyClampScalarFrom(CSAMPLE* pDest, const CSAMPLE* pSrc,
+        int firstSample, int numSamples) {
+    for (int i = firstSample; i < numSamples; ++i) {
+        pDest[i] = CSAMPLE_clamp(pSrc[i]);
+    }
+}
+
+inline void sumAbsAndPeakScalarFrom(const CSAMPLE* pBuffer,
+        int firstFrame, int numFrames,
+        CSAMPLE* pSumL, CSAMPLE* pSumR, CSAMPLE* pPeakL, CSAMPLE* pPeakR) {
+    CSAMPLE sumL = CSAMPLE_ZERO;
+    CSAMPLE sumR = CSAMPLE_ZERO;
+    CSAMPLE peakL = CSAMPLE_ZERO;
+    CSAMPLE peakR = CSAMPLE_ZERO;
+    for (int i = firstFrame; i < numFrames; ++i) {
+        const CSAMPLE absL = fabs(pBuffer[i * 2]);
+        const CSAMPLE absR = fabs(pBuffer[i * 2 + 1]);
+        sumL += absL;
+        sumR += absR;
+        peakL = math_max(peakL, absL);
+        peakR = math_max(peakR, absR);
+    }
+    *pSumL += sumL;
+    *pSumR += sumR;
+    *pPeakL = math_max(*pPeakL, peakL);
+    *pPeakR = math_max(*pPeakR, peakR);
+}
+
+void copyWithRampingGainScalar(CSAMPLE* pDest, const CSAMPLE* pSrc,
+        CSAMPLE_GAIN startGain, CSAMPLE_GAIN gainDelta, SINT numFrames) {
+    copyWithRampingGainScalarFrom(pDest, pSrc, startGain, gainDelta, 0, numFrames);
+}
+
+void addWithRampingGainScalar(CSAMPLE* pDest, const CSAMPLE* pSrc,
+        CSAMPLE_GAIN startGain, CSAMPLE_GAIN gainDelta, SINT numFrames) {
+    addWithRampingGainScalarFrom(pDest, pSrc, startGain, gainDelta, 0, numFrames);
+}
+
+void copyMultipleWithGainScalar(CSAMPLE* pDest,
+        const CSAMPLE* const* pSrc, const CSAMPLE_GAIN* pGain,
+        int numChannels, SINT numSamples) {
+    copyMultipleWithGainScalarFrom(pDest, pSrc, pGain, numChannels, 0, numSamples);
+}
+
+void copyMultipleWithRampingGainScalar(CSAMPLE* pDest,
+        const CSAMPLE* const* pSrc, const CSAMPLE_GAIN* pStartGain,
+        const CSAMPLE_GAIN* pGainDelta, int numChannels, SINT numFrames) {
+    copyMultipleWithRampingGainScalarFrom(pDest, pSrc, pStartGain, pGainDelta,
+            numChannels, 0, numFrames);
+}
+
+void copyClampScalar(CSAMPLE* pDest, const CSAMPLE* pSrc, SINT numSamples) {
+    copyClampScalarFrom(pDest, pSrc, 0, numSamples);
+}
+
+void sumAbsAndPeakPerChannelScalar(const CSAMPLE* pBuffer, SINT numFrames,
+        CSAMPLE* pSumL, CSAMPLE* pSumR, CSAMPLE* pPeakL, CSAMPLE* pPeakR) {
+    *pSumL = CSAMPLE_ZERO;
+    *pSumR = CSAMPLE_ZERO;
+    *pPeakL = CSAMPLE_ZERO;
+    *pPeakR = CSAMPLE_ZERO;
+    sumAbsAndPeakScalarFrom(pBuffer, 0, numFrames, pSumL, pSumR, pPeakL, pPeakR);
+}
+
+const SampleKernels kScalarKernels = {
+    copyWithRampingGainScalar,
+    addWithRampingGainScalar,
+    copyMultipleWithGainScalar,
+    copyMultipleWithRampingGainScalar,
+    copyClampScalar,
+    sumAbsAndPeakPerChannelScalar,
+};
+
+#ifdef MIXXX_SAMPLEKERNELS_SSE2
+
+// SSE2 kernels: 4 samples = 2 stereo frames per register
+
+void copyWithRampingGainSSE2(CSAMPLE* pDest, const CSAMPLE* pSrc,
+        CSAMPLE_GAIN startGain, CSAMPLE_GAIN gainDelta, SINT numFrames) {
+    const __m128 start = _mm_set1_ps(startGain);
+    const __m128 delta = _mm_set1_ps(gainDelta);
+    const __m128 step = _mm_set1_ps(2.0f);
+    // Frame indices of the samples in each lane (lowest lane first)
+    __m128 index = _mm_set_ps(1.0f, 1.0f, 0.0f, 0.0f);
+    int i = 0;
+    for (; i + 2 <= numFrames; i += 2) {
+        const __m128 gain = _mm_add_ps(start, _mm_mul_ps(delta, index));
+        _mm_storeu_ps(pDest + i * 2,
+                _mm_mul_ps(_mm_loadu_ps(pSrc + i * 2), gain));
+        index = _mm_add_ps(index, step);
+    }
+    copyWithRampingGainScalarFrom(pDest, pSrc, startGain, gainDelta, i, numFrames);
+}
+
+void addWithRampingGainSSE2(CSAMPLE* pDest, const CSAMPLE* pSrc,
+        CSAMPLE_GAIN startGain, CSAMPLE_GAIN gainDelta, SINT numFrames) {
+    const __m128 start = _mm_set1_ps(startGain);
+    const __m128 delta = _mm_set1_ps(gainDelta);
+    const __m128 step = _mm_set1_ps(2.0f);
+    __m128 index = _mm_set_ps(1.0f, 1.0f, 0.0f, 0.0f);
+    int i = 0;
+    for (; i + 2 <= numFrames; i += 2) {
+        const __m128 gain = _mm_add_ps(start, _mm_mul_ps(delta, index));
+        const __m128 product = _mm_mul_ps(_mm_loadu_ps(pSrc + i * 2), gain);
+        _mm_storeu_ps(pDest + i * 2,
+                _mm_add_ps(_mm_loadu_ps(pDest + i * 2), product));
+        index = _mm_add_ps(index, step);
+    }
+    addWithRampingGainScalarFrom(pDest, pSrc, startGain, gainDelta, i, numFrames);
+}
+
+void copyMultipleWithGainSSE2(CSAMPLE* pDest,
+        const CSAMPLE* const* pSrc, const CSAMPLE_GAIN* pGain,
+        int numChannels, SINT numSamples) {
+    int i = 0;
+    for (; i + 4 <= numSamples; i += 4) {
+        __m128 sum = _mm_mul_ps(_mm_loadu_ps(pSrc[0] + i), _mm_set1_ps(pGain[0]));
+        for (int j = 1; j < numChannels; ++j) {
+            sum = _mm_add_ps(sum,
+                    _mm_mul_ps(_mm_loadu_ps(pSrc[j] + i), _mm_set1_ps(pGain[j])));
+        }
+        _mm_storeu_ps(pDest + i, sum);
+    }
+    copyMultipleWithGainScalarFrom(pDest, pSrc, pGain, numChannels, i, numSamples);
+}
+
+void copyMultipleWithRampingGainSSE2(CSAMPLE* pDest,
+        const CSAMPLE* const* pSrc, const CSAMPLE_GAIN* pStartGain,
+        const CSAMPLE_GAIN* pGainDelta, int numChannels, SINT numFrames) {
+    const __m128 step = _mm_set1_ps(2.0f);
+    __m128 index = _mm_set_ps(1.0f, 1.0f, 0.0f, 0.0f);
+    int i = 0;
+    for (; i + 2 <= numFrames; i += 2) {
+        __m128 gain = _mm_add_ps(_mm_set1_ps(pStartGain[0]),
+                _mm_mul_ps(_mm_set1_ps(pGainDelta[0]), index));
+        __m128 sum = _mm_mul_ps(_mm_loadu_ps(pSrc[0] + i * 2), gain);
+        for (int j = 1; j < numChannels; ++j) {
+            gain = _mm_add_ps(_mm_set1_ps(pStartGain[j]),
+                    _mm_mul_ps(_mm_set1_ps(pGainDelta[j]), index));
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(pSrc[j] + i * 2), gain));
+        }
+        _mm_storeu_ps(pDest + i * 2, sum);
+        index = _mm_add_ps(index, step);
+    }
+    copyMultipleWithRampingGainScalarFrom(pDest, pSrc, pStartGain, pGainDelta,
+            numChannels, i, numFrames);
+}
+
+void copyClampSSE2(CSAMPLE* pDest, const CSAMPLE* pSrc, SINT numSamples) {
+    const __m128 peak = _mm_set1_ps(CSAMPLE_PEAK);
+    const __m128 negativePeak = _mm_set1_ps(-CSAMPLE_PEAK);
+    int i = 0;
+    for (; i + 4 <= numSamples; i += 4) {
+        const __m128 clamped = _mm_max_ps(
+                _mm_min_ps(_mm_loadu_ps(pSrc + i), peak), negativePeak);
+        _mm_storeu_ps(pDest + i, clamped);
+    }
+    copyClampScalarFrom(pDest, pSrc, i, numSamples);
+}
+
+void sumAbsAndPeakPerChannelSSE2(const CSAMPLE* pBuffer, SINT numFrames,
+        CSAMPLE* pSumL, CSAMPLE* pSumR, CSAMPLE* pPeakL, CSAMPLE* pPeakR) {
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    __m128 sum = _mm_setzero_ps();
+    __m128 peak = _mm_setzero_ps();
+    int i = 0;
+    for (; i + 2 <= numFrames; i += 2) {
+        const __m128 abs = _mm_and_ps(_mm_loadu_ps(pBuffer + i * 2), absMask);
+        sum = _mm_add_ps(sum, abs);
+        peak = _mm_max_ps(peak, abs);
+    }
+    M_ALIGN(16) CSAMPLE sums[4];
+    M_ALIGN(16) CSAMPLE peaks[4];
+    _mm_store_ps(sums, sum);
+    _mm_store_ps(peaks, peak);
+    *pSumL = sums[0] + sums[2];
+    *pSumR = sums[1] + sums[3];
+    *pPeakL = math_max(peaks[0], peaks[2]);
+    *pPeakR = math_max(peaks[1], peaks[3]);
+    sumAbsAndPeakScalarFrom(pBuffer, i, numFrames, pSumL, pSumR, pPeakL, pPeakR);
+}
+
+const SampleKernels kSSE2Kernels = {
+    copyWithRampingGainSSE2,
+    addWithRampingGainSSE2,
+    copyMultipleWithGainSSE2,
+    copyMultipleWithRampingGainSSE2,
+    copyClampSSE2,
+    sumAbsAndPeakPerChannelSSE2,
+};
+
+#endif // MIXXX_SAMPLEKERNELS_SSE2
+
+#ifdef MIXXX_SAMPLEKERNELS_AVX
+
+// AVX kernels: 8 samples = 4 stereo frames per register
+
+M_TARGET_AVX
+void copyWithRampingGainAVX(CSAMPLE* pDest, const CSAMPLE* pSrc,
+        CSAMPLE_GAIN startGain, CSAMPLE_GAIN gainDelta, SINT numFrames) {
+    const __m256 start = _mm256_set1_ps(startGain);
+    const __m256 delta = _mm256_set1_ps(gainDelta);
+    const __m256 step = _mm256_set1_ps(4.0f);
+    // Frame indices of the samples in each lane (lowest lane last)
+    __m256 index = _mm256_set_ps(3.0f, 3.0f, 2.0f, 2.0f, 1.0f, 1.0f, 0.0f, 0.0f);
+    int i = 0;
+    for (; i + 4 <= numFrames; i += 4) {
+        const __m256 gain = _mm256_add_ps(start, _mm256_mul_ps(delta, index));
+        _mm256_storeu_ps(pDest + i * 2,
+                _mm256_mul_ps(_mm256_loadu_ps(pSrc + i * 2), gain));
+        index = _mm256_add_ps(index, step);
+    }
+    copyWithRampingGainScalarFrom(pDest, pSrc, startGain, gainDelta, i, numFrames);
+}
+
+M_TARGET_AVX
+void addWithRampingGainAVX(CSAMPLE* pDest, const CSAMPLE* pSrc,
+        CSAMPLE_GAIN startGain, CSAMPLE_GAIN gainDelta, SINT numFrames) {
+    const __m256 start = _mm256_set1_ps(startGain);
+    const __m256 delta = _mm256_set1_ps(gainDelta);
+    const __m256 step = _mm256_set1_ps(4.0f);
+    __m256 index = _mm256_set_ps(3.0f, 3.0f, 2.0f, 2.0f, 1.0f, 1.0f, 0.0f, 0.0f);
+    int i = 0;
+    for (; i + 4 <= numFrames; i += 4) {
+        const __m256 gain = _mm256_add_ps(start, _mm256_mul_ps(delta, index));
+        const __m256 product = _mm256_mul_ps(_mm256_loadu_ps(pSrc + i * 2), gain);
+        _mm256_storeu_ps(pDest + i * 2,
+                _mm256_add_ps(_mm256_loadu_ps(pDest + i * 2), product));
+        index = _mm256_add_ps(index, step);
+    }
+    addWithRampingGainScalarFrom(pDest, pSrc, startGain, gainDelta, i, numFrames);
+}
+
+M_TARGET_AVX
+void copyMultipleWithGainAVX(CSAMPLE* pDest,
+        const CSAMPLE* const* pSrc, const CSAMPLE_GAIN* pGain,
+        int numChannels, SINT numSamples) {
+    int i = 0;
+    for (; i + 8 <= numSamples; i += 8) {
+        __m256 sum = _mm256_mul_ps(_mm256_loadu_ps(pSrc[0] + i),
+                _mm256_set1_ps(pGain[0]));
+        for (int j = 1; j < numChannels; ++j) {
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(
+                    _mm256_loadu_ps(pSrc[j] + i), _mm256_set1_ps(pGain[j])));
+        }
+        _mm256_storeu_ps(pDest + i, sum);
+    }
+    copyMultipleWithGainScalarFrom(pDest, pSrc, pGain, numChannels, i, numSamples);
+}
+
+M_TARGET_AVX
+void copyMultipleWithRampingGainAVX(CSAMPLE* pDest,
+        const CSAMPLE* const* pSrc, const CSAMPLE_GAIN* pStartGain,
+        const CSAMPLE_GAIN* pGainDelta, int numChannels, SINT numFrames) {
+    const __m256 step = _mm256_set1_ps(4.0f);
+    __m256 index = _mm256_set_ps(3.0f, 3.0f, 2.0f, 2.0f, 1.0f, 1.0f, 0.0f, 0.0f);
+    int i = 0;
+    for (; i + 4 <= numFrames; i += 4) {
+        __m256 gain = _mm256_add_ps(_mm256_set1_ps(pStartGain[0]),
+                _mm256_mul_ps(_mm256_set1_ps(pGainDelta[0]), index));
+        __m256 sum = _mm256_mul_ps(_mm256_loadu_ps(pSrc[0] + i * 2), gain);
+        for (int j = 1; j < numChannels; ++j) {
+            gain = _mm256_add_ps(_mm256_set1_ps(pStartGain[j]),
+                    _mm256_mul_ps(_mm256_set1_ps(pGainDelta[j]), index));
+            sum = _mm256_add_ps(sum,
+                    _mm256_mul_ps(_mm256_loadu_ps(pSrc[j] + i * 2), gain));
+        }
+        _mm256_storeu_ps(pDest + i * 2, sum);
+        index = _mm256_add_ps(index, step);
+    }
+    copyMultipleWithRampingGainScalarFrom(pDest, pSrc, pStartGain, pGainDelta,
+            numChannels, i, numFrames);
+}
+
+M_TARGET_AVX
+void copyClampAVX(CSAMPLE* pDest, const CSAMPLE* pSrc, SINT numSamples) {
+    const __m256 peak = _mm256_set1_ps(CSAMPLE_PEAK);
+    const __m256 negativePeak = _mm256_set1_ps(-CSAMPLE_PEAK);
+    int i = 0;
+    for (; i + 8 <= numSamples; i += 8) {
+        const __m256 clamped = _mm256_max_ps(
+                _mm256_min_ps(_mm256_loadu_ps(pSrc + i), peak), negativePeak);
+        _mm256_storeu_ps(pDest + i, clamped);
+    }
+    copyClampScalarFrom(pDest, pSrc, i, numSamples);
+}
+
+M_TARGET_AVX
+void sumAbsAndPeakPerChannelAVX(const CSAMPLE* pBuffer, SINT numFrames,
+        CSAMPLE* pSumL, CSAMPLE* pSumR, CSAMPLE* pPeakL, CSAMPLE* pPeakR) {
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    __m256 sum = _mm256_setzero_ps();
+    __m256 peak = _mm256_setzero_ps();
+    int i = 0;
+    for (; i + 4 <= numFrames; i += 4) {
+        const __m256 abs = _mm256_and_ps(_mm256_loadu_ps(pBuffer + i * 2), absMask);
+        sum = _mm256_add_ps(sum, abs);
+        peak = _mm256_max_ps(peak, abs);
+    }
+    CSAMPLE sums[8];
+    CSAMPLE peaks[8];
+    _mm256_storeu_ps(sums, sum);
+    _mm256_storeu_ps(peaks, peak);
+    *pSumL = (sums[0] + sums[2]) + (sums[4] + sums[6]);
+    *pSumR = (sums[1] + sums[3]) + (sums[5] + sums[7]);
+    *pPeakL = math_max(math_max(peaks[0], peaks[2]), math_max(peaks[4], peaks[6]));
+    *pPeakR = math_max(math_max(peaks[1], peaks[3]), math_max(peaks[5], peaks[7]));
+    // Avoid the AVX-SSE transition penalty in the scalar code that follows
+    _mm256_zeroupper();
+    sumAbsAndPeakScalarFrom(pBuffer, i, numFrames, pSumL, pSumR, pPeakL, pPeakR);
+}
+
+const SampleKernels kAVXKernels = {
+    copyWithRampingGainAVX,
+    addWithRampingGainAVX,
+    copyMultipleWithGainAVX,
+    copyMultipleWithRampingGainAVX,
+    copyClampAVX,
+    sumAbsAndPeakPerChannelAVX,
+};
+
+bool cpuSupportsAVX() {
+#if defined(_MSC_VER)
+    int cpuInfo[4];
+    __cpuid(cpuInfo, 1);
+    const bool osxsave = (cpuInfo[2] & (1 << 27)) != 0;
+    const bool avx = (cpuInfo[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx) {
+        return false;
+    }
+    // The OS must save and restore the YMM registers on context switches
+    return (_xgetbv(0) & 0x6) == 0x6;
+#else
+    // Also checks that the OS saves and restores the YMM registers
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx");
+#endif
+}
+
+#endif // MIXXX_SAMPLEKERNELS_AVX
+
+} // anonymous namespace
+
+// static
+bool SampleKernels::isSupported(InstructionSet instructionSet) {
+    switch (instructionSet) {
+    case InstructionSet::Scalar:
+        return true;
+    case InstructionSet::SSE2:
+#ifdef MIXXX_SAMPLEKERNELS_SSE2
+        return true;
+#else
+        return false;
+#endif
+    case InstructionSet::AVX:
+#ifdef MIXXX_SAMPLEKERNELS_AVX
+        return cpuSupportsAVX();
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+// static
+SampleKernels::InstructionSet SampleKernels::detectInstructionSet() {
+    if (isSupported(InstructionSet::AVX)) {
+        return InstructionSet::AVX;
+    }
+    if (isSupported(InstructionSet::SSE2)) {
+        return InstructionSet::SSE2;
+    }
+    return InstructionSet::Scalar;
+}
+
+// static
+const char* SampleKernels::instructionSetName(InstructionSet instructionSet) {
+    switch (instructionSet) {
+    case InstructionSet::Scalar:
+        return "Scalar";
+    case InstructionSet::SSE2:
+        return "SSE2";
+    case InstructionSet::AVX:
+        return "AVX";
+    }
+    return "Unknown";
+}
+
+// static
+const SampleKernels& SampleKernels::forInstructionSet(
+        InstructionSet instructionSet) {
+    if (!isSupported(instructionSet)) {
+        return kScalarKernels;
+    }
+    switch (instructionSet) {
+#ifdef MIXXX_SAMPLEKERNELS_AVX
+    case InstructionSet::AVX:
+        return kAVXKernels;
+#endif
+#ifdef MIXXX_SAMPLEKERNELS_SSE2
+    case InstructionSet::SSE2:
+        return kSSE2Kernels;
+#endif
+    default:
+        return kScalarKernels;
+    }
+}
+
+// static
+const SampleKernels& SampleKernels::get() {
+    // Detected only once, thread-safe since C++11
+    static const SampleKernels& kernels =
+            forInstructionSet(detectInstructionSet());
+    return kernels;
+}
+
+} // namespace mixxx
@@ -0,0 +1,63 @@
+#ifndef MIXXX_UTIL_SAMPLEKERNELS_H
+#define MIXXX_UTIL_SAMPLEKERNELS_H
+
+#include "util/types.h"
+
+namespace mixxx {
+
+// Explicitly vectorized implementations of the hot sample processing loops
+// of SampleUtil. Portable builds only target SSE2, so the best available
+// instruction set is detected at runtime and the matching set of kernels is
+// selected once. Use SampleUtil instead of calling the kernels directly.
+class SampleKernels {
+  public:
+    enum class InstructionSet {
+        Scalar,
+        SSE2,
+        AVX,
+    };
+
+    // Stereo gain ramps: The gain for frame i is startGain + gainDelta * i.
+    typedef void (*RampingGainFunc)(CSAMPLE* pDest, const CSAMPLE* pSrc,
+            CSAMPLE_GAIN startGain, CSAMPLE_GAIN gainDelta, SINT numFrames);
+    // pDest = sum of pSrc[j] * gain[j] for j in [0, numChannels)
+    typedef void (*MultipleWithGainFunc)(CSAMPLE* pDest,
+            const CSAMPLE* const* pSrc, const CSAMPLE_GAIN* pGain,
+            int numChannels, SINT numSamples);
+    // Like MultipleWithGainFunc, but with a stereo gain ramp per channel.
+    typedef void (*MultipleWithRampingGainFunc)(CSAMPLE* pDest,
+            const CSAMPLE* const* pSrc, const CSAMPLE_GAIN* pStartGain,
+            const CSAMPLE_GAIN* pGainDelta, int numChannels, SINT numFrames);
+    typedef void (*ClampFunc)(CSAMPLE* pDest, const CSAMPLE* pSrc,
+            SINT numSamples);
+    // Sums up and finds the peak of the absolute values of both channels
+    // of an interleaved stereo buffer. The vectorized kernels add up partial
+    // sums per lane, so the sums may differ from the scalar ones by rounding.
+    // The peaks are exact.
+    typedef void (*SumAbsAndPeakFunc)(const CSAMPLE* pBuffer, SINT numFrames,
+            CSAMPLE* pSumL, CSAMPLE* pSumR, CSAMPLE* pPeakL, CSAMPLE* pPeakR);
+
+    RampingGainFunc copyWithRampingGain;
+    RampingGainFunc addWithRampingGain;
+    MultipleWithGainFunc copyMultipleWithGain;
+    MultipleWithRampingGainFunc copyMultipleWithRampingGain;
+    ClampFunc copyClamp;
+    SumAbsAndPeakFunc sumAbsAndPeakPerChannel;
+
+    // The kernels for the best instruction set that is supported
+    // by both the build and the CPU.
+    static const SampleKernels& get();
+
+    // The kernels for a specific instruction set, e.g. for testing and
+    // benchmarking. Falls back to the scalar kernels if the instruction
+    // set is not supported.
+    static const SampleKernels& forInstructionSet(InstructionSet instructionSet);
+
+    static bool isSupported(InstructionSet instructionSet);
+    static InstructionSet detectInstructionSet();
+    static const char* instructionSetName(InstructionSet instructionSet);
+};
+
+} // namespace mixxx
+
+#endif /* MIXXX_UTIL_SAMPLEKERNELS_H */
@@ -0,0 +1,60 @@
+#ifndef MIXXX_UTIL_SPINLOCK_H
+#define MIXXX_UTIL_SPINLOCK_H
+
+#include <QAtomicInt>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+
+namespace mixxx {
+
+// Hints the CPU that the calling thread is busy waiting. Reduces the power
+// consumption and the penalty when leaving the loop on x86.
+inline void spinPause() {
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    _mm_pause();
+#endif
+}
+
+// A minimal lock for very short critical sections in real-time threads that
+// must not be suspended by the OS scheduler while waiting for a QMutex.
+// It is only ever contended while several engine threads process channels
+// in parallel.
+class SpinLock {
+  public:
+    SpinLock()
+            : m_locked(0) {
+    }
+
+    void lock() {
+        while (!m_locked.testAndSetAcquire(0, 1)) {
+            spinPause();
+        }
+    }
+
+    void unlock() {
+        m_locked.fetchAndStoreRelease(0);
+    }
+
+  private:
+    QAtomicInt m_locked;
+};
+
+class SpinLocker {
+  public:
+    explicit SpinLocker(SpinLock* pLock)
+            : m_pLock(pLock) {
+        m_pLock->lock();
+    }
+    ~SpinLocker() {
+        m_pLock->unlock();
+    }
+
+  private:
+    SpinLock* const m_pLock;
+};
+
+} // namespace mixxx
+
+#endif /* MIXXX_UTIL_SPINLOCK_H */
@@ -1,13 +1,183 @@
+#include <cstring>
 #include <limits>
 
+#include <QAtomicPointer>
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QStringList>
 #include <QtDebug>
 
 #include "util/stat.h"
+#include "util/compatibility.h"
+#include "util/assert.h"
 #include "util/time.h"
 #include "util/math.h"
 #include "util/statsmanager.h"
 
+namespace {
+
+// All registered tags, indexed by Stat::Id
+struct TagRegistry {
+    QMutex mutex;
+    QHash<QString, Stat::Id> idsByTag;
+    QVector<QString> tagsById;
+};
+
+TagRegistry& tagRegistry() {
+    static TagRegistry registry;
+    return registry;
+}
+
+// Lock-free cache for the IDs of tags with arguments, i.e. for
+// ScopedTimer. Entries are keyed by the contents of the key and argument
+// strings, because equal strings may have different addresses and a
+// buffer may be reused for different strings. Entries are never removed
+// or modified once they have been published, the number of call sites
+// is limited.
+enum class TagArgType {
+    Int,
+    String,
+};
+
+struct TagCacheEntry {
+    QByteArray key;
+    QByteArray stringArg;
+    int intArg;
+    TagArgType argType;
+    quint32 hash;
+    Stat::Id id;
+
+    bool matches(quint32 otherHash, const char* otherKey, int otherIntArg,
+            const char* otherStringArg, TagArgType otherArgType) const {
+        if (hash != otherHash || argType != otherArgType ||
+                strcmp(key.constData(), otherKey) != 0) {
+            return false;
+        }
+        if (argType == TagArgType::Int) {
+            return intArg == otherIntArg;
+        }
+        return strcmp(stringArg.constData(), otherStringArg) == 0;
+    }
+};
+
+const int kTagCacheSize = 1024; // must be a power of 2
+const int kTagCacheProbes = 8;
+
+QAtomicPointer<TagCacheEntry>* tagCache() {
+    static QAtomicPointer<TagCacheEntry> cache[kTagCacheSize];
+    return cache;
+}
+
+// FNV-1a of the key, the argument and its type. A null string argument
+// is hashed like an empty one.
+quint32 tagCacheHash(const char* key, int intArg, const char* stringArg,
+        TagArgType argType) {
+    quint32 hash = 2166136261u;
+    for (const char* pChar = key; *pChar != '\0'; ++pChar) {
+        hash = (hash ^ static_cast<quint8>(*pChar)) * 16777619u;
+    }
+    hash = (hash ^ static_cast<quint32>(argType)) * 16777619u;
+    if (argType == TagArgType::Int) {
+        hash = (hash ^ static_cast<quint32>(intArg)) * 16777619u;
+    } else {
+        for (const char* pChar = stringArg; *pChar != '\0'; ++pChar) {
+            hash = (hash ^ static_cast<quint8>(*pChar)) * 16777619u;
+        }
+    }
+    return hash;
+}
+
+int tagCacheSlot(quint32 hash) {
+    return static_cast<int>(hash) & (kTagCacheSize - 1);
+}
+
+Stat::Id lookupCachedTag(quint32 hash, const char* key, int intArg,
+        const char* stringArg, TagArgType argType) {
+    QAtomicPointer<TagCacheEntry>* pCache = tagCache();
+    const int slot = tagCacheSlot(hash);
+    for (int i = 0; i < kTagCacheProbes; ++i) {
+        const TagCacheEntry* pEntry = load_atomic_pointer(
+                pCache[(slot + i) & (kTagCacheSize - 1)]);
+        if (pEntry == nullptr) {
+            break;
+        }
+        if (pEntry->matches(hash, key, intArg, stringArg, argType)) {
+            return pEntry->id;
+        }
+    }
+    return Stat::kInvalidId;
+}
+
+void insertCachedTag(quint32 hash, const char* key, int intArg,
+        const char* stringArg, TagArgType argType, Stat::Id id) {
+    QAtomicPointer<TagCacheEntry>* pCache = tagCache();
+    TagCacheEntry* pNewEntry = new TagCacheEntry{QByteArray(key),
+            QByteArray(stringArg), intArg, argType, hash, id};
+    const int slot = tagCacheSlot(hash);
+    for (int i = 0; i < kTagCacheProbes; ++i) {
+        if (pCache[(slot + i) & (kTagCacheSize - 1)].testAndSetOrdered(
+                nullptr, pNewEntry)) {
+            return;
+        }
+    }
+    // The cache is crowded, so this tag will take the slow path
+    delete pNewEntry;
+}
+
+} // anonymous namespace
+
+// static
+Stat::Id Stat::registerTag(const QString& tag) {
+    TagRegistry& registry = tagRegistry();
+    QMutexLocker locker(&registry.mutex);
+    const auto it = registry.idsByTag.constFind(tag);
+    if (it != registry.idsByTag.constEnd()) {
+        return it.value();
+    }
+    const Id id = registry.tagsById.size();
+    registry.tagsById.append(tag);
+    registry.idsByTag.insert(tag, id);
+    return id;
+}
+
+// static
+Stat::Id Stat::registerTag(const char* key, int arg) {
+    const quint32 hash = tagCacheHash(key, arg, "", TagArgType::Int);
+    Id id = lookupCachedTag(hash, key, arg, "", TagArgType::Int);
+    if (id == kInvalidId) {
+        id = registerTag(QString(key).arg(arg));
+        insertCachedTag(hash, key, arg, "", TagArgType::Int, id);
+    }
+    return id;
+}
+
+// static
+Stat::Id Stat::registerTag(const char* key, const char* arg) {
+    if (arg == nullptr) {
+        arg = "";
+    }
+    const quint32 hash = tagCacheHash(key, 0, arg, TagArgType::String);
+    Id id = lookupCachedTag(hash, key, 0, arg, TagArgType::String);
+    if (id == kInvalidId) {
+        if (*arg == '\0') {
+            id = registerTag(QString(key));
+        } else {
+            id = registerTag(QString(key).arg(arg));
+        }
+        insertCachedTag(hash, key, 0, arg, TagArgType::String, id);
+    }
+    return id;
+}
+
+// static
+QString Stat::tagForId(Id id) {
+    TagRegistry& registry = tagRegistry();
+    QMutexLocker locker(&registry.mutex);
+    return registry.tagsById.value(id);
+}
+
 Stat::Stat()
         : m_type(UNSPECIFIED),
           m_compute(NONE),
@@ -62,7 +232,7 @@ void Stat::processReport(const StatReport& report) {
     }
 
     if (m_compute & Stat::HISTOGRAM) {
-        m_histogram[report.value] += 1.0;
+        m_histogram.record(report.value);
     }
 
     if (m_compute & Stat::VALUES) {
@@ -123,13 +293,12 @@ QDebug operator<<(QDebug dbg, const Stat &stat) {
     }
 
     if (stat.m_compute & Stat::HISTOGRAM) {
-        QStringList histogram;
-        for (QMap<double, double>::const_iterator it = stat.m_histogram.begin();
-             it != stat.m_histogram.end(); ++it) {
-            histogram << QString::number(it.key()) + stat.valueUnits() + ":" +
-                    QString::number(it.value());
-        }
-        stats << "histogram=" + histogram.join(",");
+        stats << "p50=" + QString::number(
+                stat.m_histogram.valueAtQuantile(0.5)) + stat.valueUnits();
+        stats << "p99=" + QString::number(
+                stat.m_histogram.valueAtQuantile(0.99)) + stat.valueUnits();
+        stats << "p999=" + QString::number(
+                stat.m_histogram.valueAtQuantile(0.999)) + stat.valueUnits();
     }
 
     dbg.nospace() << "Stat(" << stat.m_tag << "," << stats.join(",") << ")";
@@ -144,8 +313,20 @@ bool Stat::track(const QString& tag,
     if (!StatsManager::s_bStatsManagerEnabled) {
         return false;
     }
+    return track(registerTag(tag), type, compute, value);
+}
+
+// static
+bool Stat::track(Id id,
+                 Stat::StatType type,
+                 Stat::ComputeFlags compute,
+                 double value) {
+    if (!StatsManager::s_bStatsManagerEnabled) {
+        return false;
+    }
+    DEBUG_ASSERT(id != kInvalidId);
     StatReport report;
-    report.tag = strdup(tag.toAscii().constData());
+    report.id = id;
     report.type = type;
     report.compute = compute;
     report.time = mixxx::Time::elapsed().toIntegerNanos();
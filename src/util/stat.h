@@ -1,11 +1,11 @@
 #ifndef STAT_H
 #define STAT_H
 
-#include <QMap>
 #include <QVector>
 #include <QString>
 
 #include "util/experiment.h"
+#include "util/stathistogram.h"
 
 struct StatReport;
 
@@ -60,8 +60,7 @@ class Stat {
         MIN             = 0x0020,
         // O(1) in time and space.
         MAX             = 0x0040,
-        // O(1) in time, O(k) in space where k is # of distinct values.
-        // Use carefully!
+        // O(1) in time, O(log(range)) in space, see StatHistogram.
         HISTOGRAM       = 0x0080,
         // O(1) in time, O(n) in space where n is the # of reports.
         // Use carefully!
@@ -98,6 +97,28 @@ class Stat {
         }
     }
 
+    // Stats are identified by dense integer IDs, so that tracking a value
+    // does not need to copy or hash any strings. Each tag is registered
+    // once, e.g. when constructing a Counter or Timer.
+    typedef int Id;
+    static const Id kInvalidId = -1;
+
+    // Returns the ID of the tag and registers it if needed. Thread-safe,
+    // but acquires a lock and must not be used on real-time code paths.
+    static Id registerTag(const QString& tag);
+
+    // Returns the ID for a key with an argument that is substituted
+    // with QString::arg() like "EngineMaster::process %1". Subsequent
+    // calls with an equal key and argument neither lock nor allocate.
+    // Strings are cached by their contents, so they may live in
+    // temporary buffers. A null or empty string argument registers the
+    // key itself. Prefer registering tags up front on real-time code
+    // paths, the lookup hashes both strings.
+    static Id registerTag(const char* key, int arg);
+    static Id registerTag(const char* key, const char* arg);
+
+    static QString tagForId(Id id);
+
     explicit Stat();
     void processReport(const StatReport& report);
     QString valueUnits() const;
@@ -116,8 +137,14 @@ class Stat {
     double m_max;
     double m_variance_mk;
     double m_variance_sk;
-    QMap<double, double> m_histogram;
+    StatHistogram m_histogram;
+
+    static bool track(Id id,
+                      Stat::StatType type,
+                      Stat::ComputeFlags compute,
+                      double value);
 
+    // Convenience function for rarely tracked stats, prefer the ID.
     static bool track(const QString& tag,
                       Stat::StatType type,
                       Stat::ComputeFlags compute,
@@ -127,7 +154,7 @@ class Stat {
 QDebug operator<<(QDebug dbg, const Stat &stat);
 
 struct StatReport {
-    char* tag;
+    Stat::Id id;
     qint64 time;
     Stat::StatType type;
     Stat::ComputeFlags compute;
@@ -0,0 +1,70 @@
+#include "util/stathistogram.h"
+
+#include <cmath>
+
+#include "util/math.h"
+
+// static
+int StatHistogram::bucketForValue(double value) {
+    if (!(value >= std::ldexp(1.0, kMinExponent))) {
+        // Also catches NaN
+        return 0;
+    }
+    // value = mantissa * 2^exponent with mantissa in [0.5, 1)
+    int exponent;
+    const double mantissa = std::frexp(value, &exponent);
+    // The power of 2 range [2^(exponent - 1), 2^exponent) is
+    // divided into kSubBuckets linear buckets.
+    const int powerOf2 = exponent - 1;
+    if (powerOf2 > kMaxExponent) {
+        return kBucketCount - 1;
+    }
+    const int subBucket = math_min(kSubBuckets - 1,
+            static_cast<int>((2.0 * mantissa - 1.0) * kSubBuckets));
+    return 1 + (powerOf2 - kMinExponent) * kSubBuckets + subBucket;
+}
+
+// static
+double StatHistogram::bucketLowerBound(int bucket) {
+    if (bucket <= 0) {
+        return 0.0;
+    }
+    const int powerOf2 = (bucket - 1) / kSubBuckets + kMinExponent;
+    const int subBucket = (bucket - 1) % kSubBuckets;
+    return std::ldexp(1.0 + static_cast<double>(subBucket) / kSubBuckets,
+            powerOf2);
+}
+
+// static
+double StatHistogram::bucketUpperBound(int bucket) {
+    if (bucket <= 0) {
+        return std::ldexp(1.0, kMinExponent);
+    }
+    const int powerOf2 = (bucket - 1) / kSubBuckets + kMinExponent;
+    const int subBucket = (bucket - 1) % kSubBuckets;
+    return std::ldexp(1.0 + static_cast<double>(subBucket + 1) / kSubBuckets,
+            powerOf2);
+}
+
+void StatHistogram::record(double value, double count) {
+    if (m_counts.isEmpty()) {
+        m_counts.fill(0.0, kBucketCount);
+    }
+    m_counts[bucketForValue(value)] += count;
+    m_totalCount += count;
+}
+
+double StatHistogram::valueAtQuantile(double quantile) const {
+    if (isEmpty()) {
+        return 0.0;
+    }
+    const double rank = math_clamp(quantile, 0.0, 1.0) * m_totalCount;
+    double count = 0.0;
+    for (int bucket = 0; bucket < m_counts.size(); ++bucket) {
+        count += m_counts.at(bucket);
+        if ((count >= rank) && (m_counts.at(bucket) > 0.0)) {
+            return bucketUpperBound(bucket);
+        }
+    }
+    return bucketUpperBound(m_counts.size() - 1);
+}
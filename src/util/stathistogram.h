@@ -0,0 +1,59 @@
+#ifndef UTIL_STATHISTOGRAM_H
+#define UTIL_STATHISTOGRAM_H
+
+#include <QVector>
+
+// A histogram with log-linear buckets in the style of HDR histograms. Every
+// power of 2 is divided into kSubBuckets buckets of equal width, so the
+// relative error of a recorded value is bounded by 1 / kSubBuckets no matter
+// if it is a nanosecond duration or a count of millions. The number of
+// buckets is fixed and memory is only allocated for the first record.
+//
+// Non-positive values and values below 2^kMinExponent are counted in the
+// lowest bucket, values above 2^(kMaxExponent + 1) in the highest one.
+class StatHistogram {
+  public:
+    static const int kSubBucketBits = 4;
+    static const int kSubBuckets = 1 << kSubBucketBits;
+    static const int kMinExponent = -20;
+    static const int kMaxExponent = 63;
+    static const int kBucketCount =
+            1 + (kMaxExponent - kMinExponent + 1) * kSubBuckets;
+
+    StatHistogram()
+            : m_totalCount(0.0) {
+    }
+
+    void record(double value, double count = 1.0);
+
+    bool isEmpty() const {
+        return m_totalCount <= 0.0;
+    }
+
+    double totalCount() const {
+        return m_totalCount;
+    }
+
+    // Returns the upper bound of the bucket that contains the value at the
+    // given quantile in [0, 1], e.g. 0.99 for the 99th percentile.
+    double valueAtQuantile(double quantile) const;
+
+    // The buckets are ordered by their value range. Empty histograms
+    // don't have any buckets.
+    int bucketCount() const {
+        return m_counts.size();
+    }
+    double bucketCountAt(int bucket) const {
+        return m_counts.at(bucket);
+    }
+    static double bucketLowerBound(int bucket);
+    static double bucketUpperBound(int bucket);
+
+    static int bucketForValue(double value);
+
+  private:
+    QVector<double> m_counts;
+    double m_totalCount;
+};
+
+#endif // UTIL_STATHISTOGRAM_H
@@ -7,6 +7,7 @@
 #include "util/statsmanager.h"
 #include "util/compatibility.h"
 #include "util/cmdlineargs.h"
+#include "util/assert.h"
 
 // In practice we process stats pipes about once a minute @1ms latency.
 const int kStatsPipeSize = 1 << 10;
@@ -45,18 +46,20 @@ StatsManager::~StatsManager() {
     qDebug() << "=====================================";
     qDebug() << "ALL STATS";
     qDebug() << "=====================================";
-    for (QMap<QString, Stat>::const_iterator it = m_stats.begin();
-         it != m_stats.end(); ++it) {
-        qDebug() << it.value();
+    for (const Stat& stat : m_stats) {
+        if (stat.m_report_count > 0) {
+            qDebug() << stat;
+        }
     }
 
     if (!m_baseStats.isEmpty()) {
         qDebug() << "=====================================";
         qDebug() << "BASE STATS";
         qDebug() << "=====================================";
-        for (QMap<QString, Stat>::const_iterator it = m_baseStats.begin();
-             it != m_baseStats.end(); ++it) {
-            qDebug() << it.value();
+        for (const Stat& stat : m_baseStats) {
+            if (stat.m_report_count > 0) {
+                qDebug() << stat;
+            }
         }
     }
 
@@ -64,9 +67,10 @@ StatsManager::~StatsManager() {
         qDebug() << "=====================================";
         qDebug() << "EXPERIMENT STATS";
         qDebug() << "=====================================";
-        for (QMap<QString, Stat>::const_iterator it = m_experimentStats.begin();
-             it != m_experimentStats.end(); ++it) {
-            qDebug() << it.value();
+        for (const Stat& stat : m_experimentStats) {
+            if (stat.m_report_count > 0) {
+                qDebug() << stat;
+            }
         }
     }
     qDebug() << "=====================================";
@@ -74,6 +78,11 @@ StatsManager::~StatsManager() {
     if (CmdlineArgs::Instance().getTimelineEnabled()) {
         writeTimeline(CmdlineArgs::Instance().getTimelinePath());
     }
+
+    const QString statsPath = CmdlineArgs::Instance().getStatsPath();
+    if (!statsPath.isEmpty()) {
+        writeStats(statsPath);
+    }
 }
 
 class OrderByTime {
@@ -162,6 +171,134 @@ void StatsManager::writeTimeline(const QString& filename) {
     timeline.close();
 }
 
+namespace {
+
+QString jsonString(const QString& value) {
+    QString result = "\"";
+    for (const QChar c : value) {
+        if (c == '"' || c == '\\') {
+            result += '\\';
+            result += c;
+        } else if (c.unicode() < 0x20) {
+            result += QString("\\u%1").arg(c.unicode(), 4, 16, QChar('0'));
+        } else {
+            result += c;
+        }
+    }
+    result += '"';
+    return result;
+}
+
+QString csvString(const QString& value) {
+    if (!value.contains(',') && !value.contains('"') && !value.contains('\n')) {
+        return value;
+    }
+    QString escaped = value;
+    escaped.replace("\"", "\"\"");
+    return "\"" + escaped + "\"";
+}
+
+const double kExportedQuantiles[] = { 0.5, 0.9, 0.99, 0.999 };
+const char* const kExportedQuantileNames[] = { "p50", "p90", "p99", "p999" };
+
+void writeStatsJson(QTextStream& out, const QVector<Stat>& stats) {
+    out << "[";
+    bool first = true;
+    for (const Stat& stat : stats) {
+        if (stat.m_report_count <= 0) {
+            continue;
+        }
+        out << (first ? "\n" : ",\n");
+        first = false;
+        out << "  {\"tag\": " << jsonString(stat.m_tag)
+            << ", \"type\": " << jsonString(Stat::statTypeToString(stat.m_type))
+            << ", \"units\": " << jsonString(stat.valueUnits())
+            << ", \"count\": " << stat.m_report_count
+            << ", \"sum\": " << stat.m_sum
+            << ", \"min\": " << stat.m_min
+            << ", \"max\": " << stat.m_max
+            << ", \"mean\": " << stat.m_sum / stat.m_report_count
+            << ", \"variance\": " << stat.variance();
+        if (!stat.m_histogram.isEmpty()) {
+            for (size_t i = 0; i < sizeof(kExportedQuantiles) / sizeof(kExportedQuantiles[0]); ++i) {
+                out << ", \"" << kExportedQuantileNames[i] << "\": "
+                    << stat.m_histogram.valueAtQuantile(kExportedQuantiles[i]);
+            }
+            // Only non-empty buckets as [lower bound, upper bound, count]
+            out << ", \"histogram\": [";
+            bool firstBucket = true;
+            for (int bucket = 0; bucket < stat.m_histogram.bucketCount(); ++bucket) {
+                const double count = stat.m_histogram.bucketCountAt(bucket);
+                if (count <= 0.0) {
+                    continue;
+                }
+                out << (firstBucket ? "" : ", ") << "["
+                    << StatHistogram::bucketLowerBound(bucket) << ", "
+                    << StatHistogram::bucketUpperBound(bucket) << ", "
+                    << count << "]";
+                firstBucket = false;
+            }
+            out << "]";
+        }
+        out << "}";
+    }
+    out << "\n]\n";
+}
+
+void writeStatsCsv(QTextStream& out, const QVector<Stat>& stats) {
+    out << "tag,type,units,count,sum,min,max,mean,variance";
+    for (const char* name : kExportedQuantileNames) {
+        out << "," << name;
+    }
+    out << "\n";
+    for (const Stat& stat : stats) {
+        if (stat.m_report_count <= 0) {
+            continue;
+        }
+        out << csvString(stat.m_tag) << ","
+            << Stat::statTypeToString(stat.m_type) << ","
+            << stat.valueUnits() << ","
+            << stat.m_report_count << ","
+            << stat.m_sum << ","
+            << stat.m_min << ","
+            << stat.m_max << ","
+            << stat.m_sum / stat.m_report_count << ","
+            << stat.variance();
+        for (double quantile : kExportedQuantiles) {
+            out << ",";
+            if (!stat.m_histogram.isEmpty()) {
+                out << stat.m_histogram.valueAtQuantile(quantile);
+            }
+        }
+        out << "\n";
+    }
+}
+
+} // anonymous namespace
+
+void StatsManager::writeStats(const QString& filename) const {
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qWarning() << "Could not open stats file for writing:"
+                   << file.fileName();
+        return;
+    }
+    QTextStream out(&file);
+    out.setRealNumberPrecision(12);
+    if (filename.endsWith(".json", Qt::CaseInsensitive)) {
+        writeStatsJson(out, m_stats);
+    } else {
+        writeStatsCsv(out, m_stats);
+    }
+    qDebug() << "Wrote stats to" << file.fileName();
+}
+
+void StatsManager::dumpStats(const QString& filename) {
+    QMutexLocker locker(&m_statsPipeLock);
+    m_pendingDumpFilename = filename;
+    m_statsPipeCondition.wakeAll();
+}
+
 void StatsManager::onStatsPipeDestroyed(StatsPipe* pPipe) {
     QMutexLocker locker(&m_statsPipeLock);
     processIncomingStatReports();
@@ -198,30 +335,39 @@ bool StatsManager::maybeWriteReport(const StatReport& report) {
     return success;
 }
 
+// static
+void StatsManager::updateStat(QVector<Stat>* pStats, const StatReport& report) {
+    if (report.id >= pStats->size()) {
+        pStats->resize(report.id + 1);
+    }
+    Stat& stat = (*pStats)[report.id];
+    if (stat.m_tag.isEmpty()) {
+        stat.m_tag = Stat::tagForId(report.id);
+    }
+    stat.m_type = report.type;
+    stat.m_compute = report.compute;
+    stat.processReport(report);
+}
+
 void StatsManager::processIncomingStatReports() {
+    // Each updated stat is only emitted once per batch of reports
+    QVector<bool> updated(m_stats.size(), false);
     StatReport report;
     foreach (StatsPipe* pStatsPipe, m_statsPipes) {
         while (pStatsPipe->read(&report, 1) == 1) {
-            QString tag = QString::fromUtf8(report.tag);
-            Stat& info = m_stats[tag];
-            info.m_tag = tag;
-            info.m_type = report.type;
-            info.m_compute = report.compute;
-            info.processReport(report);
-            emit(statUpdated(info));
+            VERIFY_OR_DEBUG_ASSERT(report.id >= 0) {
+                continue;
+            }
+            updateStat(&m_stats, report);
+            if (report.id >= updated.size()) {
+                updated.resize(report.id + 1);
+            }
+            updated[report.id] = true;
 
             if (report.compute & Stat::STATS_EXPERIMENT) {
-                Stat& experiment = m_experimentStats[tag];
-                experiment.m_tag = tag;
-                experiment.m_type = report.type;
-                experiment.m_compute = report.compute;
-                experiment.processReport(report);
+                updateStat(&m_experimentStats, report);
             } else if (report.compute & Stat::STATS_BASE) {
-                Stat& base = m_baseStats[tag];
-                base.m_tag = tag;
-                base.m_type = report.type;
-                base.m_compute = report.compute;
-                base.processReport(report);
+                updateStat(&m_baseStats, report);
             }
 
             if (CmdlineArgs::Instance().getTimelineEnabled() &&
@@ -229,12 +375,16 @@ void StatsManager::processIncomingStatReports() {
                      report.type == Stat::EVENT_START ||
                      report.type == Stat::EVENT_END)) {
                 Event event;
-                event.m_tag = tag;
+                event.m_tag = m_stats.at(report.id).m_tag;
                 event.m_type = report.type;
                 event.m_time = mixxx::Duration::fromNanos(report.time);
                 m_events.append(event);
             }
-            free(report.tag);
+        }
+    }
+    for (int id = 0; id < updated.size(); ++id) {
+        if (updated.at(id)) {
+            emit(statUpdated(m_stats.at(id)));
         }
     }
 }
@@ -247,12 +397,19 @@ void StatsManager::run() {
         // We want to process reports even when we are about to quit since we
         // want to print the most accurate stat report on shutdown.
         processIncomingStatReports();
+        QString dumpFilename = m_pendingDumpFilename;
+        m_pendingDumpFilename.clear();
         m_statsPipeLock.unlock();
 
+        if (!dumpFilename.isEmpty()) {
+            writeStats(dumpFilename);
+        }
+
         if (load_atomic(m_emitAllStats) == 1) {
-            for (QMap<QString, Stat>::const_iterator it = m_stats.begin();
-                 it != m_stats.end(); ++it) {
-                emit(statUpdated(it.value()));
+            for (const Stat& stat : m_stats) {
+                if (stat.m_report_count > 0) {
+                    emit(statUpdated(stat));
+                }
             }
             m_emitAllStats = 0;
         }
@@ -2,6 +2,7 @@
 #define STATSMANAGER_H
 
 #include <QMap>
+#include <QVector>
 #include <QObject>
 #include <QString>
 #include <QThread>
@@ -47,6 +48,10 @@ class StatsManager : public QThread, public Singleton<StatsManager> {
         m_statsPipeCondition.wakeAll();
     }
 
+    // Asks the StatsManager thread to write all stats to the given file.
+    // The format is JSON if the file name ends with ".json", CSV otherwise.
+    void dumpStats(const QString& filename);
+
   signals:
     void statUpdated(const Stat& stat);
 
@@ -58,18 +63,23 @@ class StatsManager : public QThread, public Singleton<StatsManager> {
     StatsPipe* getStatsPipeForThread();
     void onStatsPipeDestroyed(StatsPipe* pPipe);
     void writeTimeline(const QString& filename);
+    void writeStats(const QString& filename) const;
+    static void updateStat(QVector<Stat>* pStats, const StatReport& report);
 
     QAtomicInt m_emitAllStats;
     QAtomicInt m_quit;
-    QMap<QString, Stat> m_stats;
-    QMap<QString, Stat> m_baseStats;
-    QMap<QString, Stat> m_experimentStats;
+    // Indexed by Stat::Id
+    QVector<Stat> m_stats;
+    QVector<Stat> m_baseStats;
+    QVector<Stat> m_experimentStats;
     QList<Event> m_events;
 
     QWaitCondition m_statsPipeCondition;
     QMutex m_statsPipeLock;
     QList<StatsPipe*> m_statsPipes;
     QThreadStorage<StatsPipe*> m_threadStatsPipes;
+    // Protected by m_statsPipeLock
+    QString m_pendingDumpFilename;
 
     friend class StatsPipe;
 };
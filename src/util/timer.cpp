@@ -3,7 +3,13 @@
 #include "waveform/guitick.h"
 
 Timer::Timer(const QString& key, Stat::ComputeFlags compute)
-        : m_key(key),
+        : m_statId(Stat::registerTag(key)),
+          m_compute(Stat::experimentFlags(compute)),
+          m_running(false) {
+}
+
+Timer::Timer(Stat::Id statId, Stat::ComputeFlags compute)
+        : m_statId(statId),
           m_compute(Stat::experimentFlags(compute)),
           m_running(false) {
 }
@@ -20,7 +26,7 @@ mixxx::Duration Timer::restart(bool report) {
             // Ignore the report if it crosses the experiment boundary.
             Experiment::Mode oldMode = Stat::modeFromFlags(m_compute);
             if (oldMode == Experiment::mode()) {
-                Stat::track(m_key, Stat::DURATION_NANOSEC, m_compute,
+                Stat::track(m_statId, Stat::DURATION_NANOSEC, m_compute,
                             elapsed.toIntegerNanos());
             }
         }
@@ -37,7 +43,7 @@ mixxx::Duration Timer::elapsed(bool report) {
         // Ignore the report if it crosses the experiment boundary.
         Experiment::Mode oldMode = Stat::modeFromFlags(m_compute);
         if (oldMode == Experiment::mode()) {
-            Stat::track(m_key, Stat::DURATION_NANOSEC, m_compute,
+            Stat::track(m_statId, Stat::DURATION_NANOSEC, m_compute,
                         elapsedTime.toIntegerNanos());
         }
     }
@@ -71,7 +77,7 @@ mixxx::Duration SuspendableTimer::elapsed(bool report) {
         // Ignore the report if it crosses the experiment boundary.
         Experiment::Mode oldMode = Stat::modeFromFlags(m_compute);
         if (oldMode == Experiment::mode()) {
-            Stat::track(m_key, Stat::DURATION_NANOSEC, m_compute,
+            Stat::track(m_statId, Stat::DURATION_NANOSEC, m_compute,
                         m_leapTime.toIntegerNanos());
         }
     }
@@ -10,6 +10,8 @@
 #include "util/cmdlineargs.h"
 #include "util/duration.h"
 
+// Histograms take about 10 KB per stat, so they are only computed for
+// stats that explicitly add Stat::HISTOGRAM to these flags.
 const Stat::ComputeFlags kDefaultComputeFlags = Stat::COUNT | Stat::SUM | Stat::AVERAGE |
         Stat::MAX | Stat::MIN | Stat::SAMPLE_VARIANCE;
 
@@ -20,6 +22,8 @@ class Timer {
   public:
     Timer(const QString& key,
           Stat::ComputeFlags compute = kDefaultComputeFlags);
+    Timer(Stat::Id statId,
+          Stat::ComputeFlags compute = kDefaultComputeFlags);
     void start();
 
     // Restart the timer returning the time duration since it was last
@@ -32,7 +36,7 @@ class Timer {
     mixxx::Duration elapsed(bool report);
 
   protected:
-    QString m_key;
+    Stat::Id m_statId;
     Stat::ComputeFlags m_compute;
     bool m_running;
     PerformanceTimer m_time;
@@ -53,12 +57,22 @@ class SuspendableTimer : public Timer {
 
 class ScopedTimer {
   public:
+    // For real-time code paths, the tag must be registered up front.
+    explicit ScopedTimer(Stat::Id statId,
+                Stat::ComputeFlags compute = kDefaultComputeFlags)
+            : m_pTimer(NULL),
+              m_cancel(false) {
+        if (enabled()) {
+            initialize(statId, compute);
+        }
+    }
+
     ScopedTimer(const char* key, int i,
                 Stat::ComputeFlags compute = kDefaultComputeFlags)
             : m_pTimer(NULL),
               m_cancel(false) {
-        if (CmdlineArgs::Instance().getDeveloper()) {
-            initialize(QString(key), QString::number(i), compute);
+        if (enabled()) {
+            initialize(Stat::registerTag(key, i), compute);
         }
     }
 
@@ -66,8 +80,8 @@ class ScopedTimer {
                 Stat::ComputeFlags compute = kDefaultComputeFlags)
             : m_pTimer(NULL),
               m_cancel(false) {
-        if (CmdlineArgs::Instance().getDeveloper()) {
-            initialize(QString(key), arg ? QString(arg) : QString(), compute);
+        if (enabled()) {
+            initialize(Stat::registerTag(key, arg), compute);
         }
     }
 
@@ -75,8 +89,10 @@ class ScopedTimer {
                 Stat::ComputeFlags compute = kDefaultComputeFlags)
             : m_pTimer(NULL),
               m_cancel(false) {
-        if (CmdlineArgs::Instance().getDeveloper()) {
-            initialize(QString(key), arg, compute);
+        if (enabled()) {
+            initialize(Stat::registerTag(
+                    arg.isEmpty() ? QString(key) : QString(key).arg(arg)),
+                    compute);
         }
     }
 
@@ -89,15 +105,9 @@ class ScopedTimer {
         }
     }
 
-    inline void initialize(const QString& key, const QString& arg,
+    inline void initialize(Stat::Id statId,
                 Stat::ComputeFlags compute = kDefaultComputeFlags) {
-        QString strKey;
-        if (arg.isEmpty()) {
-            strKey = key;
-        } else {
-            strKey = key.arg(arg);
-        }
-        m_pTimer = new(m_timerMem) Timer(strKey, compute);
+        m_pTimer = new(m_timerMem) Timer(statId, compute);
         m_pTimer->start();
     }
 
@@ -105,6 +115,12 @@ class ScopedTimer {
         m_cancel = true;
     }
   private:
+    // Like the StatsManager, see MixxxMainWindow
+    static bool enabled() {
+        const CmdlineArgs& args = CmdlineArgs::Instance();
+        return args.getDeveloper() || !args.getStatsPath().isEmpty();
+    }
+
     Timer* m_pTimer;
     char m_timerMem[sizeof(Timer)];
     bool m_cancel;
@@ -1,5 +1,7 @@
 #include <QGLFramebufferObject>
 
+#include <vector>
+
 #include "waveform/renderers/glslwaveformrenderersignal.h"
 #include "waveform/renderers/waveformwidgetrenderer.h"
 
@@ -122,8 +124,22 @@ bool GLSLWaveformRendererSignal::loadTexture() {
         int textureWidth = waveform->getTextureStride();
         int textureHeigth = waveform->getTextureSize() / waveform->getTextureStride();
 
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, textureWidth, textureHeigth, 0,
-                     GL_RGBA, GL_UNSIGNED_BYTE, data);
+        if (textureHeigth == textureWidth) {
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, textureWidth, textureHeigth, 0,
+                         GL_RGBA, GL_UNSIGNED_BYTE, data);
+        } else {
+            // Mapped waveforms only contain the rows with data, but the
+            // shaders expect a square texture. Pad it with silence.
+            std::vector<WaveformData> padding(
+                    textureWidth * (textureWidth - textureHeigth), WaveformData(0));
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, textureWidth, textureWidth, 0,
+                         GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, textureWidth, textureHeigth,
+                            GL_RGBA, GL_UNSIGNED_BYTE, data);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, textureHeigth, textureWidth,
+                            textureWidth - textureHeigth,
+                            GL_RGBA, GL_UNSIGNED_BYTE, padding.data());
+        }
         int error = glGetError();
         if (error)
             qDebug() << "GLSLWaveformRendererSignal::loadTexture - glTexImage2D error" << error;
@@ -35,12 +35,13 @@ void GLWaveformRendererFilteredSignal::draw(QPainter* painter, QPaintEvent* /*ev
         return;
     }
 
-    const int dataSize = waveform->getDataSize();
+    const int mipLevel = selectMipLevel(*waveform);
+    const int dataSize = waveform->getMipLevelDataSize(mipLevel);
     if (dataSize <= 1) {
         return;
     }
 
-    const WaveformData* data = waveform->data();
+    const WaveformData* data = waveform->getMipLevelData(mipLevel);
     if (data == NULL) {
         return;
     }
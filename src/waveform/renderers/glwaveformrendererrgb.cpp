@@ -31,12 +31,13 @@ void GLWaveformRendererRGB::draw(QPainter* painter, QPaintEvent* /*event*/) {
         return;
     }
 
-    const int dataSize = waveform->getDataSize();
+    const int mipLevel = selectMipLevel(*waveform);
+    const int dataSize = waveform->getMipLevelDataSize(mipLevel);
     if (dataSize <= 1) {
         return;
     }
 
-    const WaveformData* data = waveform->data();
+    const WaveformData* data = waveform->getMipLevelData(mipLevel);
     if (data == NULL) {
         return;
     }
@@ -0,0 +1,170 @@
+#include "waveform/renderers/rasterwaveformrendererrgb.h"
+
+#include <cmath>
+
+#include "track/track.h"
+#include "util/math.h"
+#include "waveform/renderers/waveformwidgetrenderer.h"
+#include "waveform/waveform.h"
+#include "waveform/waveformkernels.h"
+
+RasterWaveformRendererRGB::RasterWaveformRendererRGB(
+        WaveformWidgetRenderer* waveformWidgetRenderer)
+        : WaveformRendererSignalBase(waveformWidgetRenderer) {
+}
+
+RasterWaveformRendererRGB::~RasterWaveformRendererRGB() {
+}
+
+void RasterWaveformRendererRGB::onSetup(const QDomNode& /* node */) {
+}
+
+void RasterWaveformRendererRGB::draw(QPainter* painter,
+                                     QPaintEvent* /*event*/) {
+    const TrackPointer trackInfo = m_waveformRenderer->getTrackInfo();
+    if (!trackInfo) {
+        return;
+    }
+
+    ConstWaveformPointer waveform = trackInfo->getWaveform();
+    if (waveform.isNull()) {
+        return;
+    }
+
+    const int mipLevel = selectMipLevel(*waveform);
+    const int dataSize = waveform->getMipLevelDataSize(mipLevel);
+    if (dataSize <= 1) {
+        return;
+    }
+
+    const WaveformData* data = waveform->getMipLevelData(mipLevel);
+    if (data == NULL) {
+        return;
+    }
+
+    const int length = m_waveformRenderer->getLength();
+    const int breadth = m_waveformRenderer->getBreadth();
+    if (length <= 0 || breadth <= 0) {
+        return;
+    }
+
+    const bool horizontal =
+            m_waveformRenderer->getOrientation() == Qt::Horizontal;
+    const QSize size = horizontal ?
+            QSize(length, breadth) : QSize(breadth, length);
+    if (m_framebuffer.size() != size) {
+        m_framebuffer = QImage(size, QImage::Format_ARGB32_Premultiplied);
+    }
+    m_framebuffer.fill(0);
+
+    QRgb* const pPixels = reinterpret_cast<QRgb*>(m_framebuffer.bits());
+    const int stride = m_framebuffer.bytesPerLine() / sizeof(QRgb);
+    // The distance in pixels between neighbouring pixels across the
+    // waveform and between neighbouring columns.
+    const int breadthStep = horizontal ? stride : 1;
+    const int lengthStep = horizontal ? 1 : stride;
+
+    // Per-band gain from the EQ knobs.
+    float allGain(1.0), lowGain(1.0), midGain(1.0), highGain(1.0);
+    getGains(&allGain, &lowGain, &midGain, &highGain);
+
+    const float halfBreadth = (float)breadth / 2.0;
+    const float heightFactor = allGain * halfBreadth / sqrtf(255 * 255 * 3);
+
+    // Draw reference line
+    const QRgb axesColor = qPremultiply(m_pColors->getAxesColor().rgba());
+    QRgb* const pAxis =
+            pPixels + math_min((int)halfBreadth, breadth - 1) * breadthStep;
+    for (int x = 0; x < length; ++x) {
+        pAxis[x * lengthStep] = axesColor;
+    }
+
+    const double firstVisualFrame =
+            m_waveformRenderer->getFirstDisplayedPosition() * dataSize / 2.0;
+    const double lastVisualFrame =
+            m_waveformRenderer->getLastDisplayedPosition() * dataSize / 2.0;
+    const double framesPerPixel =
+            (lastVisualFrame - firstVisualFrame) / length;
+    const int frameCount = dataSize / 2;
+
+    const mixxx::WaveformKernels& kernels = mixxx::WaveformKernels::get();
+    for (int x = 0; x < length; ++x) {
+        // The visual frames of this column, at least one when zoomed in
+        int frameStart = static_cast<int>(
+                std::floor(firstVisualFrame + framesPerPixel * x));
+        int frameStop = static_cast<int>(
+                std::floor(firstVisualFrame + framesPerPixel * (x + 1)));
+        frameStop = math_max(frameStop, frameStart + 1);
+        frameStart = math_max(frameStart, 0);
+        frameStop = math_min(frameStop, frameCount);
+        if (frameStart >= frameStop) {
+            continue;
+        }
+
+        WaveformData maxLeft;
+        WaveformData maxRight;
+        kernels.maxPerChannel(data + frameStart * 2, frameStop - frameStart,
+                &maxLeft, &maxRight);
+
+        const float maxLowF = math_max(maxLeft.filtered.low,
+                maxRight.filtered.low) * lowGain;
+        const float maxMidF = math_max(maxLeft.filtered.mid,
+                maxRight.filtered.mid) * midGain;
+        const float maxHighF = math_max(maxLeft.filtered.high,
+                maxRight.filtered.high) * highGain;
+
+        const float red = maxLowF * m_rgbLowColor_r + maxMidF * m_rgbMidColor_r +
+                maxHighF * m_rgbHighColor_r;
+        const float green = maxLowF * m_rgbLowColor_g + maxMidF * m_rgbMidColor_g +
+                maxHighF * m_rgbHighColor_g;
+        const float blue = maxLowF * m_rgbLowColor_b + maxMidF * m_rgbMidColor_b +
+                maxHighF * m_rgbHighColor_b;
+
+        // Compute maximum (needed for value normalization)
+        const float max = math_max3(red, green, blue);
+        // Prevent division by zero
+        if (max <= 0.0f) {
+            continue;
+        }
+        const QRgb color = qRgb(static_cast<int>(255 * red / max),
+                static_cast<int>(255 * green / max),
+                static_cast<int>(255 * blue / max));
+
+        const float allLeft = heightFactor * sqrtf(
+                pow(maxLeft.filtered.low * lowGain, 2) +
+                pow(maxLeft.filtered.mid * midGain, 2) +
+                pow(maxLeft.filtered.high * highGain, 2));
+        const float allRight = heightFactor * sqrtf(
+                pow(maxRight.filtered.low * lowGain, 2) +
+                pow(maxRight.filtered.mid * midGain, 2) +
+                pow(maxRight.filtered.high * highGain, 2));
+
+        // The pixels [start, end) across the waveform
+        int start;
+        int end;
+        switch (m_alignment) {
+            case Qt::AlignBottom:
+            case Qt::AlignRight:
+                start = breadth - (int)math_max(allLeft, allRight);
+                end = breadth;
+                break;
+            case Qt::AlignTop:
+            case Qt::AlignLeft:
+                start = 0;
+                end = (int)math_max(allLeft, allRight);
+                break;
+            default:
+                start = (int)(halfBreadth - allLeft);
+                end = (int)(halfBreadth + allRight);
+        }
+        start = math_clamp(start, 0, breadth);
+        end = math_clamp(end, 0, breadth);
+
+        QRgb* const pColumn = pPixels + x * lengthStep;
+        for (int y = start; y < end; ++y) {
+            pColumn[y * breadthStep] = color;
+        }
+    }
+
+    painter->drawImage(QPoint(0, 0), m_framebuffer);
+}
@@ -0,0 +1,31 @@
+#ifndef RASTERWAVEFORMRENDERERRGB_H
+#define RASTERWAVEFORMRENDERERRGB_H
+
+#include <QImage>
+
+#include "util/class.h"
+#include "waveformrenderersignalbase.h"
+
+// Software RGB waveform renderer that does not draw through QPainter. The
+// columns are reduced with WaveformKernels and written directly into an
+// ARGB framebuffer, which is blitted once per frame.
+//
+// The "all" height of a column is computed from the per band maxima, like
+// for the coarser mip levels, so it can be slightly higher than with
+// WaveformRendererRGB.
+class RasterWaveformRendererRGB : public WaveformRendererSignalBase {
+  public:
+    explicit RasterWaveformRendererRGB(
+            WaveformWidgetRenderer* waveformWidgetRenderer);
+    virtual ~RasterWaveformRendererRGB();
+
+    virtual void onSetup(const QDomNode& node);
+    virtual void draw(QPainter* painter, QPaintEvent* event);
+
+  private:
+    QImage m_framebuffer;
+
+    DISALLOW_COPY_AND_ASSIGN(RasterWaveformRendererRGB);
+};
+
+#endif // RASTERWAVEFORMRENDERERRGB_H
@@ -2,6 +2,7 @@
 
 #include <QDomNode>
 
+#include "waveform/waveform.h"
 #include "waveform/waveformwidgetfactory.h"
 #include "waveformwidgetrenderer.h"
 #include "control/controlobject.h"
@@ -152,6 +153,10 @@ void WaveformRendererSignalBase::setup(const QDomNode& node,
 
 void WaveformRendererSignalBase::getGains(float* pAllGain, float* pLowGain,
                                           float* pMidGain, float* pHighGain) {
+    if (m_waveformRenderer->getFixedGains(
+            pAllGain, pLowGain, pMidGain, pHighGain)) {
+        return;
+    }
     WaveformWidgetFactory* factory = WaveformWidgetFactory::instance();
     if (pAllGain != NULL) {
         float allGain = m_waveformRenderer->getGain();
@@ -201,3 +206,21 @@ void WaveformRendererSignalBase::getGains(float* pAllGain, float* pLowGain,
         }
     }
 }
+
+int WaveformRendererSignalBase::selectMipLevel(const Waveform& waveform) const {
+    const int length = m_waveformRenderer->getLength();
+    if (length <= 0) {
+        return 0;
+    }
+    // Each visual frame consists of a left and a right data element
+    const double visualFramesPerPixel =
+            (m_waveformRenderer->getLastDisplayedPosition() -
+             m_waveformRenderer->getFirstDisplayedPosition()) *
+            waveform.getDataSize() / 2.0 / length;
+    const int levelCount = waveform.getMipLevelCount();
+    int level = 0;
+    while (level < levelCount && (2 << level) <= visualFramesPerPixel) {
+        ++level;
+    }
+    return level;
+}
@@ -7,6 +7,7 @@
 
 class ControlObject;
 class ControlProxy;
+class Waveform;
 
 class WaveformRendererSignalBase : public WaveformRendererAbstract {
 public:
@@ -25,6 +26,11 @@ public:
     void getGains(float* pAllGain, float* pLowGain, float* pMidGain,
                   float* highGain);
 
+    // Returns the coarsest mip level of the waveform that still has at least
+    // one visual frame per pixel in the displayed range. Renderers that use
+    // it iterate over O(pixels) data points at any zoom.
+    int selectMipLevel(const Waveform& waveform) const;
+
   protected:
     ControlProxy* m_pEQEnabled;
     ControlProxy* m_pLowFilterControlObject;
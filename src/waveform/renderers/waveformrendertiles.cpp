@@ -0,0 +1,410 @@
+#include "waveform/renderers/waveformrendertiles.h"
+
+#include <QPainter>
+#include <QtConcurrentRun>
+
+#include <cmath>
+
+#include "util/assert.h"
+#include "util/math.h"
+#include "util/memory.h"
+#include "waveform/waveform.h"
+
+namespace {
+
+// The number of tiles beyond the viewport that are rendered ahead of time
+// on either side, so that scrolling never waits for the worker.
+const int kPrefetchTiles = 2;
+
+// The number of tiles beyond the viewport that are kept in the cache.
+const int kKeepTiles = 16;
+
+} // anonymous namespace
+
+WaveformTileParameters::WaveformTileParameters()
+        : pWaveform(nullptr),
+          trackSamples(0),
+          trackPixelCount(0.0),
+          visualSamplePerPixel(0.0),
+          audioSamplePerPixel(0.0),
+          breadth(0),
+          gain(0.0),
+          allGain(0.0),
+          lowGain(0.0),
+          midGain(0.0),
+          highGain(0.0),
+          beatGridEnabled(false),
+          beatsRevision(0) {
+}
+
+bool WaveformTileParameters::operator==(
+        const WaveformTileParameters& other) const {
+    return pTrack == other.pTrack &&
+            pWaveform == other.pWaveform &&
+            trackSamples == other.trackSamples &&
+            trackPixelCount == other.trackPixelCount &&
+            visualSamplePerPixel == other.visualSamplePerPixel &&
+            audioSamplePerPixel == other.audioSamplePerPixel &&
+            breadth == other.breadth &&
+            gain == other.gain &&
+            allGain == other.allGain &&
+            lowGain == other.lowGain &&
+            midGain == other.midGain &&
+            highGain == other.highGain &&
+            beatGridEnabled == other.beatGridEnabled &&
+            beatsRevision == other.beatsRevision;
+}
+
+WaveformTileRenderer::WaveformTileRenderer(const char* group)
+        : WaveformWidgetRenderer(group),
+          m_allGain(0.0),
+          m_lowGain(0.0),
+          m_midGain(0.0),
+          m_highGain(0.0) {
+}
+
+bool WaveformTileRenderer::getFixedGains(float* pAllGain, float* pLowGain,
+        float* pMidGain, float* pHighGain) const {
+    if (pAllGain) {
+        *pAllGain = m_allGain;
+    }
+    if (pLowGain) {
+        *pLowGain = m_lowGain;
+    }
+    if (pMidGain) {
+        *pMidGain = m_midGain;
+    }
+    if (pHighGain) {
+        *pHighGain = m_highGain;
+    }
+    return true;
+}
+
+void WaveformTileRenderer::renderTile(QImage* pImage,
+        const WaveformTileParameters& parameters,
+        int tileIndex, int tileLength) {
+    m_pTrack = parameters.pTrack;
+    m_trackSamples = parameters.trackSamples;
+    m_trackPixelCount = parameters.trackPixelCount;
+    m_visualSamplePerPixel = parameters.visualSamplePerPixel;
+    m_audioSamplePerPixel = parameters.audioSamplePerPixel;
+    m_gain = parameters.gain;
+    m_allGain = parameters.allGain;
+    m_lowGain = parameters.lowGain;
+    m_midGain = parameters.midGain;
+    m_highGain = parameters.highGain;
+    m_enableBeatGrid = parameters.beatGridEnabled;
+    m_firstDisplayedPosition =
+            tileIndex * tileLength / parameters.trackPixelCount;
+    m_lastDisplayedPosition =
+            (tileIndex + 1) * tileLength / parameters.trackPixelCount;
+    m_playPos = m_firstDisplayedPosition;
+
+    if (getLength() != tileLength || getBreadth() != parameters.breadth) {
+        if (m_orientation == Qt::Horizontal) {
+            resize(tileLength, parameters.breadth);
+        } else {
+            resize(parameters.breadth, tileLength);
+        }
+    }
+
+    pImage->fill(Qt::transparent);
+    QPainter painter(pImage);
+    for (WaveformRendererAbstract* pRenderer : m_rendererStack) {
+        pRenderer->draw(&painter, nullptr);
+    }
+}
+
+WaveformRenderTiles::WaveformRenderTiles(
+        WaveformWidgetRenderer* waveformWidgetRenderer)
+        : WaveformRendererSignalBase(waveformWidgetRenderer),
+          m_pTileRenderer(std::make_unique<WaveformTileRenderer>(
+                  waveformWidgetRenderer->getGroup())),
+          m_beatsRevision(0),
+          m_pendingCompletion(0) {
+}
+
+WaveformRenderTiles::~WaveformRenderTiles() {
+    // The worker uses the tile renderer
+    m_future.waitForFinished();
+}
+
+bool WaveformRenderTiles::onInit() {
+    return m_pTileRenderer->init();
+}
+
+void WaveformRenderTiles::setup(const QDomNode& node,
+        const SkinContext& context) {
+    WaveformRendererSignalBase::setup(node, context);
+    m_future.waitForFinished();
+    m_pTileRenderer->setup(node, context);
+    m_tiles.clear();
+    m_staleTiles.clear();
+}
+
+void WaveformRenderTiles::onSetup(const QDomNode& /*node*/) {
+}
+
+void WaveformRenderTiles::onResize() {
+    // A different breadth changes the parameters, but the stale tiles
+    // would be stretched across the whole new breadth.
+    m_staleTiles.clear();
+}
+
+void WaveformRenderTiles::onSetTrack() {
+    m_tiles.clear();
+    m_staleTiles.clear();
+    // Releases the previous track
+    m_parameters = WaveformTileParameters();
+
+    if (m_pBeatsTrack) {
+        disconnect(m_pBeatsTrack.get(), SIGNAL(beatsUpdated()),
+                this, SLOT(slotBeatsUpdated()));
+    }
+    m_pBeatsTrack = m_waveformRenderer->getTrackInfo();
+    if (!m_pBeatsTrack) {
+        return;
+    }
+    connect(m_pBeatsTrack.get(), SIGNAL(beatsUpdated()),
+            this, SLOT(slotBeatsUpdated()));
+}
+
+void WaveformRenderTiles::slotBeatsUpdated() {
+    ++m_beatsRevision;
+}
+
+WaveformTileParameters WaveformRenderTiles::currentParameters(
+        const Waveform& waveform) {
+    WaveformTileParameters parameters;
+    parameters.pTrack = m_waveformRenderer->getTrackInfo();
+    parameters.pWaveform = &waveform;
+    parameters.trackSamples = m_waveformRenderer->getTrackSamples();
+    // Tiles are rendered at the original tempo of the track and stretched
+    // by the rate when they are composited, see drawTile(). Otherwise
+    // every movement of the pitch fader or a synced tempo would render all
+    // tiles again.
+    parameters.visualSamplePerPixel = math_max(1.0,
+            m_waveformRenderer->getZoomFactor() / scaleFactor());
+    parameters.audioSamplePerPixel = parameters.visualSamplePerPixel *
+            waveform.getAudioVisualRatio();
+    parameters.trackPixelCount = parameters.trackSamples / 2.0 /
+            parameters.audioSamplePerPixel;
+    parameters.breadth = m_waveformRenderer->getBreadth();
+    parameters.gain = m_waveformRenderer->getGain();
+    getGains(&parameters.allGain, &parameters.lowGain, &parameters.midGain,
+            &parameters.highGain);
+    parameters.beatGridEnabled = m_waveformRenderer->isBeatGridEnabled();
+    parameters.beatsRevision = m_beatsRevision;
+    return parameters;
+}
+
+void WaveformRenderTiles::setParameters(
+        const WaveformTileParameters& parameters) {
+    if (parameters == m_parameters) {
+        return;
+    }
+    // Keep showing the current tiles until their replacements are rendered
+    if (!m_tiles.isEmpty()) {
+        m_staleTiles.clear();
+        for (auto it = m_tiles.constBegin(); it != m_tiles.constEnd(); ++it) {
+            StaleTile staleTile;
+            staleTile.image = it.value().image;
+            staleTile.firstPosition =
+                    it.key() * kTileLength / m_parameters.trackPixelCount;
+            staleTile.lastPosition =
+                    (it.key() + 1) * kTileLength / m_parameters.trackPixelCount;
+            m_staleTiles.append(staleTile);
+        }
+        m_tiles.clear();
+    }
+    m_parameters = parameters;
+}
+
+void WaveformRenderTiles::collectRenderedTiles() {
+    if (m_pendingTileIndices.isEmpty() || !m_future.isFinished()) {
+        return;
+    }
+    const QVector<QImage> images = m_future.result();
+    DEBUG_ASSERT(images.size() == m_pendingTileIndices.size());
+    if (m_pendingParameters == m_parameters) {
+        for (int i = 0; i < images.size(); ++i) {
+            Tile& tile = m_tiles[m_pendingTileIndices[i]];
+            tile.image = images[i];
+            tile.completion = m_pendingCompletion;
+        }
+    } else if (m_pendingParameters.pTrack == m_parameters.pTrack) {
+        // Still closer to the current parameters than the stale tiles,
+        // e.g. while a knob is being turned.
+        m_staleTiles.clear();
+        for (int i = 0; i < images.size(); ++i) {
+            StaleTile staleTile;
+            staleTile.image = images[i];
+            staleTile.firstPosition = m_pendingTileIndices[i] * kTileLength /
+                    m_pendingParameters.trackPixelCount;
+            staleTile.lastPosition = (m_pendingTileIndices[i] + 1) *
+                    kTileLength / m_pendingParameters.trackPixelCount;
+            m_staleTiles.append(staleTile);
+        }
+    }
+    m_pendingTileIndices.clear();
+    // Releases the track, the job has finished
+    m_pendingParameters = WaveformTileParameters();
+}
+
+void WaveformRenderTiles::requestTiles(const QVector<int>& tileIndices) {
+    if (!m_pendingTileIndices.isEmpty()) {
+        // Only one job at a time, the remaining tiles are requested again
+        // with the next frame.
+        return;
+    }
+    m_pendingParameters = m_parameters;
+    m_pendingTileIndices = tileIndices;
+    m_pendingCompletion = m_parameters.pWaveform->getCompletion();
+    m_future = QtConcurrent::run(&WaveformRenderTiles::renderTiles,
+            m_pTileRenderer.get(), m_pendingParameters, m_pendingTileIndices);
+}
+
+// static
+QVector<QImage> WaveformRenderTiles::renderTiles(
+        WaveformTileRenderer* pTileRenderer,
+        WaveformTileParameters parameters, QVector<int> tileIndices) {
+    const bool horizontal =
+            pTileRenderer->getOrientation() == Qt::Horizontal;
+    QVector<QImage> images;
+    images.reserve(tileIndices.size());
+    for (int tileIndex : tileIndices) {
+        QImage image(horizontal ? kTileLength : parameters.breadth,
+                horizontal ? parameters.breadth : kTileLength,
+                QImage::Format_ARGB32_Premultiplied);
+        pTileRenderer->renderTile(&image, parameters, tileIndex, kTileLength);
+        images.append(image);
+    }
+    return images;
+}
+
+void WaveformRenderTiles::drawTile(QPainter* painter, const QImage& image,
+        double firstPosition, double lastPosition) {
+    const double start =
+            m_waveformRenderer->transformPositionInRendererWorld(firstPosition);
+    const double end =
+            m_waveformRenderer->transformPositionInRendererWorld(lastPosition);
+    const int breadth = m_waveformRenderer->getBreadth();
+    if (m_waveformRenderer->getOrientation() == Qt::Horizontal) {
+        painter->drawImage(QRectF(start, 0, end - start, breadth), image);
+    } else {
+        painter->drawImage(QRectF(0, start, breadth, end - start), image);
+    }
+}
+
+void WaveformRenderTiles::draw(QPainter* painter, QPaintEvent* /*event*/) {
+    // Also after the track has been ejected, to release it
+    collectRenderedTiles();
+
+    const TrackPointer pTrack = m_waveformRenderer->getTrackInfo();
+    if (!pTrack) {
+        return;
+    }
+    ConstWaveformPointer pWaveform = pTrack->getWaveform();
+    if (pWaveform.isNull() || pWaveform->getDataSize() <= 1 ||
+            m_waveformRenderer->getAudioSamplePerPixel() <= 0.0) {
+        return;
+    }
+
+    setParameters(currentParameters(*pWaveform));
+
+    const double trackPixelCount = m_parameters.trackPixelCount;
+    const int firstTile = static_cast<int>(std::floor(
+            m_waveformRenderer->getFirstDisplayedPosition() *
+            trackPixelCount / kTileLength));
+    const int lastTile = static_cast<int>(std::floor(
+            m_waveformRenderer->getLastDisplayedPosition() *
+            trackPixelCount / kTileLength));
+
+    // Tiles rendered while the waveform was being analyzed are rendered
+    // again once the analysis has progressed past them.
+    const int completion = pWaveform->getCompletion();
+    const int dataSize = pWaveform->getDataSize();
+    QVector<int> missingTiles;
+    // Returns the cached tile if there is one and queues tiles that are
+    // missing or outdated for rendering.
+    auto findTile = [&](int tileIndex) -> const Tile* {
+        auto it = m_tiles.constFind(tileIndex);
+        if (it == m_tiles.constEnd()) {
+            missingTiles.append(tileIndex);
+            return nullptr;
+        }
+        const double tileEnd = (tileIndex + 1) * kTileLength /
+                trackPixelCount * dataSize;
+        if (it.value().completion < math_min(tileEnd, double(completion))) {
+            missingTiles.append(tileIndex);
+        }
+        return &it.value();
+    };
+
+    bool visibleTilesReady = true;
+    painter->save();
+    for (int tileIndex = firstTile; tileIndex <= lastTile; ++tileIndex) {
+        const double firstPosition =
+                tileIndex * kTileLength / trackPixelCount;
+        const double lastPosition =
+                (tileIndex + 1) * kTileLength / trackPixelCount;
+        const Tile* pTile = findTile(tileIndex);
+        if (pTile) {
+            drawTile(painter, pTile->image, firstPosition, lastPosition);
+            continue;
+        }
+        visibleTilesReady = false;
+        if (m_staleTiles.isEmpty()) {
+            continue;
+        }
+        // Fill the gap with whatever stale tiles cover it. The gap is
+        // stretched by the rate like the tile.
+        const double start = m_waveformRenderer->transformPositionInRendererWorld(
+                firstPosition);
+        const double end = m_waveformRenderer->transformPositionInRendererWorld(
+                lastPosition);
+        const int breadth = m_waveformRenderer->getBreadth();
+        if (m_waveformRenderer->getOrientation() == Qt::Horizontal) {
+            painter->setClipRect(QRectF(start, 0, end - start, breadth));
+        } else {
+            painter->setClipRect(QRectF(0, start, breadth, end - start));
+        }
+        for (const StaleTile& staleTile : m_staleTiles) {
+            if (staleTile.lastPosition > firstPosition &&
+                    staleTile.firstPosition < lastPosition) {
+                drawTile(painter, staleTile.image,
+                        staleTile.firstPosition, staleTile.lastPosition);
+            }
+        }
+        painter->setClipping(false);
+    }
+    painter->restore();
+
+    if (visibleTilesReady) {
+        m_staleTiles.clear();
+    }
+    // Only tiles within the track
+    const int trackLastTile = static_cast<int>(
+            std::floor(trackPixelCount / kTileLength));
+    for (int i = 1; i <= kPrefetchTiles; ++i) {
+        if (lastTile + i <= trackLastTile) {
+            findTile(lastTile + i);
+        }
+        if (firstTile - i >= 0) {
+            findTile(firstTile - i);
+        }
+    }
+    if (!missingTiles.isEmpty()) {
+        requestTiles(missingTiles);
+    }
+
+    // Evict tiles that have scrolled far out of the viewport
+    for (auto it = m_tiles.begin(); it != m_tiles.end();) {
+        if (it.key() < firstTile - kKeepTiles ||
+                it.key() > lastTile + kKeepTiles) {
+            it = m_tiles.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
@@ -0,0 +1,140 @@
+#ifndef WAVEFORMRENDERTILES_H
+#define WAVEFORMRENDERTILES_H
+
+#include <QFuture>
+#include <QHash>
+#include <QImage>
+#include <QObject>
+#include <QVector>
+
+#include <memory>
+
+#include "track/track.h"
+#include "util/class.h"
+#include "waveform/renderers/waveformrenderersignalbase.h"
+#include "waveform/renderers/waveformwidgetrenderer.h"
+
+// Everything that affects the pixels of a tile. Tiles rendered with
+// different parameters are stale.
+struct WaveformTileParameters {
+    WaveformTileParameters();
+
+    bool operator==(const WaveformTileParameters& other) const;
+    bool operator!=(const WaveformTileParameters& other) const {
+        return !(*this == other);
+    }
+
+    TrackPointer pTrack;
+    const Waveform* pWaveform;
+    int trackSamples;
+    double trackPixelCount;
+    double visualSamplePerPixel;
+    double audioSamplePerPixel;
+    int breadth;
+    double gain;
+    float allGain;
+    float lowGain;
+    float midGain;
+    float highGain;
+    bool beatGridEnabled;
+    int beatsRevision;
+};
+
+// Renders a tile with its own stack of renderers. The renderers see a
+// viewport that covers exactly the tile, so they don't need to know about
+// tiles. Only used by one worker at a time.
+class WaveformTileRenderer : public WaveformWidgetRenderer {
+  public:
+    explicit WaveformTileRenderer(const char* group);
+
+    void renderTile(QImage* pImage, const WaveformTileParameters& parameters,
+            int tileIndex, int tileLength);
+
+    // The renderers use the gains of the parameters instead of reading the
+    // controls, which may have changed since the tile has been requested.
+    bool getFixedGains(float* pAllGain, float* pLowGain,
+            float* pMidGain, float* pHighGain) const override;
+
+  private:
+    float m_allGain;
+    float m_lowGain;
+    float m_midGain;
+    float m_highGain;
+};
+
+// Rasterizes the static parts of a waveform, i.e. the signal and the beat
+// grid, into cached tiles of kTileLength track pixels on a worker thread.
+// Track pixels are counted at the original tempo of the track, the rate is
+// applied when the tiles are composited.
+// Each frame only composites the tiles that intersect the viewport. Tiles
+// that are not ready yet are covered by the scaled tiles of the previous
+// parameters, e.g. while zooming or while a gain knob is turned.
+//
+// Marks and other renderers that depend on frequently changing controls
+// keep drawing per frame on top of the tiles.
+class WaveformRenderTiles : public QObject, public WaveformRendererSignalBase {
+    Q_OBJECT
+  public:
+    explicit WaveformRenderTiles(WaveformWidgetRenderer* waveformWidgetRenderer);
+    virtual ~WaveformRenderTiles();
+
+    // Adds a renderer that is drawn into the tiles.
+    template<class T_Renderer>
+    T_Renderer* addRenderer() {
+        return m_pTileRenderer->addRenderer<T_Renderer>();
+    }
+
+    virtual bool onInit();
+    virtual void setup(const QDomNode& node, const SkinContext& context);
+    virtual void onSetup(const QDomNode& node);
+    virtual void draw(QPainter* painter, QPaintEvent* event);
+
+    virtual void onResize();
+    virtual void onSetTrack();
+
+    static const int kTileLength = 256;
+
+  private slots:
+    void slotBeatsUpdated();
+
+  private:
+    struct Tile {
+        QImage image;
+        // The completion of the waveform when the tile was rendered
+        int completion;
+    };
+    struct StaleTile {
+        QImage image;
+        double firstPosition;
+        double lastPosition;
+    };
+
+    WaveformTileParameters currentParameters(const Waveform& waveform);
+    void setParameters(const WaveformTileParameters& parameters);
+    void collectRenderedTiles();
+    void requestTiles(const QVector<int>& tileIndices);
+    void drawTile(QPainter* painter, const QImage& image,
+            double firstPosition, double lastPosition);
+
+    static QVector<QImage> renderTiles(WaveformTileRenderer* pTileRenderer,
+            WaveformTileParameters parameters, QVector<int> tileIndices);
+
+    std::unique_ptr<WaveformTileRenderer> m_pTileRenderer;
+
+    WaveformTileParameters m_parameters;
+    QHash<int, Tile> m_tiles;
+    QVector<StaleTile> m_staleTiles;
+    // The track whose beatsUpdated() signal is connected
+    TrackPointer m_pBeatsTrack;
+    int m_beatsRevision;
+
+    // The worker job and what it was asked to render
+    QFuture<QVector<QImage> > m_future;
+    WaveformTileParameters m_pendingParameters;
+    QVector<int> m_pendingTileIndices;
+    int m_pendingCompletion;
+
+    DISALLOW_COPY_AND_ASSIGN(WaveformRenderTiles);
+};
+
+#endif // WAVEFORMRENDERTILES_H
@@ -71,6 +71,12 @@ class WaveformWidgetRenderer {
     double getZoomFactor() const { return m_zoomFactor;}
     double getRateAdjust() const { return m_rateAdjust;}
     double getGain() const { return m_gain;}
+    // Returns true and the gains to render the signal with if they don't
+    // depend on the current state of the controls.
+    virtual bool getFixedGains(float* /*pAllGain*/, float* /*pLowGain*/,
+            float* /*pMidGain*/, float* /*pHighGain*/) const {
+        return false;
+    }
     int getTrackSamples() const { return m_trackSamples;}
 
     bool isBeatGridEnabled() const { return m_enableBeatGrid; }
@@ -1,12 +1,14 @@
 #include <QtDebug>
 
+#include <cstring>
+
 #include "waveform/waveform.h"
 #include "proto/waveform.pb.h"
+#include "util/math.h"
+#include "util/memory.h"
 
 using namespace mixxx::track;
 
-const int kNumChannels = 2;
-
 // Return the smallest power of 2 which is greater than the desired size when
 // squared.
 int computeTextureStride(int size) {
@@ -21,6 +23,10 @@ Waveform::Waveform(const QByteArray data)
         : m_id(-1),
           m_saveState(SaveState::NotSaved),
           m_dataSize(0),
+          m_data(nullptr),
+          m_textureSize(0),
+          m_mipData(nullptr),
+          m_mipLevelCount(0),
           m_visualSampleRate(0),
           m_audioVisualRatio(0),
           m_textureStride(computeTextureStride(0)),
@@ -33,6 +39,10 @@ Waveform::Waveform(int audioSampleRate, int audioSamples,
         : m_id(-1),
           m_saveState(SaveState::NotSaved),
           m_dataSize(0),
+          m_data(nullptr),
+          m_textureSize(0),
+          m_mipData(nullptr),
+          m_mipLevelCount(0),
           m_visualSampleRate(0),
           m_audioVisualRatio(0),
           m_textureStride(1024),
@@ -67,70 +77,343 @@ Waveform::Waveform(int audioSampleRate, int audioSamples,
 Waveform::~Waveform() {
 }
 
+namespace {
+
+// The layout of the mappable waveform format. All values are stored in the
+// native byte order, files from a machine with a different byte order are
+// rejected and the waveform is analyzed again.
+struct MappableHeader {
+    char magic[Waveform::kMappableMagicSize];
+    quint32 formatVersion;
+    quint32 byteOrderMark;
+    quint32 headerSize;
+    qint32 dataSize;
+    qint32 textureStride;
+    // Rows of textureStride elements that follow the header
+    qint32 rowCount;
+    // The mip levels follow the rows in ascending order
+    qint32 mipLevelCount;
+    double visualSampleRate;
+    double audioVisualRatio;
+    // See checksumOfPayload(), covers everything after the header
+    quint32 checksum;
+};
+
+const char kMappableMagic[Waveform::kMappableMagicSize] = { 'M', 'X', 'W', 'F' };
+const quint32 kMappableFormatVersion = 1;
+const quint32 kMappableByteOrderMark = 0x01020304;
+const int kMappableHeaderSize = Waveform::kMappableHeaderSize;
+static_assert(sizeof(MappableHeader) <= kMappableHeaderSize,
+        "MappableHeader exceeds the reserved header size");
+static_assert(sizeof(WaveformData) == 4,
+        "WaveformData is stored as 4 bytes per element");
+
+int rowCountForSize(int dataSize, int textureStride) {
+    return (dataSize + textureStride - 1) / textureStride;
+}
+
+// Returns the offset of each mip level from level 1 in the mip level data,
+// indexed by the level. The element after the last level is the total
+// size. Level 0 is not part of the mip level data.
+std::vector<int> computeMipLevelOffsets(int dataSize, int levelCount) {
+    std::vector<int> offsets(levelCount + 2, 0);
+    int frames = (dataSize + 1) / 2;
+    for (int level = 1; level <= levelCount; ++level) {
+        frames = (frames + 1) / 2;
+        offsets[level + 1] = offsets[level] + 2 * frames;
+    }
+    return offsets;
+}
+
+// Sums of the 32 bit words like Fletcher's checksum. It detects truncated
+// and corrupted files, not deliberate modifications. Reading all pages is
+// as fast as reading the file has been with the protobuf format.
+quint32 checksumOfPayload(const uchar* pData, qint64 size) {
+    quint64 sum = 0;
+    quint64 sumOfSums = 0;
+    const qint64 wordCount = size / sizeof(quint32);
+    for (qint64 i = 0; i < wordCount; ++i) {
+        quint32 word;
+        memcpy(&word, pData + i * sizeof(quint32), sizeof(word));
+        sum += word;
+        sumOfSums += sum;
+    }
+    return static_cast<quint32>(sum) ^
+            static_cast<quint32>(sumOfSums) ^
+            static_cast<quint32>(sumOfSums >> 32);
+}
+
+void storeMax(WaveformData* pTarget, const WaveformData& first,
+        const WaveformData& second) {
+    pTarget->filtered.low = math_max(first.filtered.low, second.filtered.low);
+    pTarget->filtered.mid = math_max(first.filtered.mid, second.filtered.mid);
+    pTarget->filtered.high = math_max(first.filtered.high, second.filtered.high);
+    pTarget->filtered.all = math_max(first.filtered.all, second.filtered.all);
+}
+
+} // anonymous namespace
+
+// static
+bool Waveform::isMappableData(const QByteArray& data) {
+    return data.size() >= kMappableMagicSize &&
+            memcmp(data.constData(), kMappableMagic, kMappableMagicSize) == 0;
+}
+
+// static
+quint32 Waveform::mappableChecksum(const QByteArray& data) {
+    if (!isMappableData(data) || data.size() < kMappableHeaderSize) {
+        return 0;
+    }
+    MappableHeader header;
+    memcpy(&header, data.constData(), sizeof(header));
+    return header.checksum;
+}
+
+quint32 Waveform::computeDataChecksum() const {
+    return checksumOfPayload(reinterpret_cast<const uchar*>(m_data),
+            static_cast<qint64>(getDataSize()) * sizeof(WaveformData));
+}
+
+// static
+Waveform* Waveform::createMapped(const QString& fileName) {
+    Waveform* pWaveform = new Waveform();
+    auto pFile = std::make_unique<QFile>(fileName);
+    if (!pFile->open(QIODevice::ReadOnly)) {
+        qWarning() << "Failed to open waveform file" << fileName;
+        return pWaveform;
+    }
+#ifdef __WINDOWS__
+    // Windows can neither replace nor delete a file while it is mapped, so
+    // AnalysisDao could not store a new analysis of a loaded track.
+    const QByteArray data = pFile->readAll();
+    if (!pWaveform->readMappable(
+            reinterpret_cast<const uchar*>(data.constData()), data.size(),
+            true)) {
+        qWarning() << "Invalid waveform file" << fileName;
+    }
+    return pWaveform;
+#else
+    // The mapping keeps the data of a replaced or deleted file
+    const qint64 size = pFile->size();
+    const uchar* pData = pFile->map(0, size);
+    if (pData == nullptr) {
+        qWarning() << "Failed to map waveform file" << fileName
+                   << pFile->errorString();
+        return pWaveform;
+    }
+    if (!pWaveform->readMappable(pData, size, false)) {
+        qWarning() << "Invalid waveform file" << fileName;
+        return pWaveform;
+    }
+    pWaveform->m_pMappedFile = std::move(pFile);
+    return pWaveform;
+#endif
+}
+
 QByteArray Waveform::toByteArray() const {
-    io::Waveform waveform;
-    waveform.set_visual_sample_rate(m_visualSampleRate);
-    waveform.set_audio_visual_ratio(m_audioVisualRatio);
-
-    io::Waveform::Signal* all = waveform.mutable_signal_all();
-    io::Waveform::FilteredSignal* filtered = waveform.mutable_signal_filtered();
-    // TODO(rryan) get the actual cutoff values from analyzerwaveform.cpp so
-    // that if they change we don't have to remember to update these.
-
-    // Frequency cutoffs for butterworth filters:
-    // filtered->set_low_cutoff_frequency(200);
-    // filtered->set_mid_low_cutoff_frequency(200);
-    // filtered->set_mid_high_cutoff_frequency(2000);
-    // filtered->set_high_cutoff_frequency(2000);
-
-    // Frequency cutoff for bessel_lowpass4
-    filtered->set_low_cutoff_frequency(600);
-    // Frequency cutoff for bessel_bandpass
-    filtered->set_mid_low_cutoff_frequency(600);
-    filtered->set_mid_high_cutoff_frequency(4000);
-    // Frequency cutoff for bessel_highpass4
-    filtered->set_high_cutoff_frequency(4000);
-
-    io::Waveform::Signal* low = filtered->mutable_low();
-    io::Waveform::Signal* mid = filtered->mutable_mid();
-    io::Waveform::Signal* high = filtered->mutable_high();
-
-    // TODO(vrince) set max/min for each signal
-    int numChannels = kNumChannels;
-    all->set_units(io::Waveform::RMS);
-    all->set_channels(numChannels);
-    low->set_units(io::Waveform::RMS);
-    low->set_channels(numChannels);
-    mid->set_units(io::Waveform::RMS);
-    mid->set_channels(numChannels);
-    high->set_units(io::Waveform::RMS);
-    high->set_channels(numChannels);
+    const int dataSize = getDataSize();
+    const int rowCount = rowCountForSize(dataSize, m_textureStride);
+    DEBUG_ASSERT(rowCount * m_textureStride <= m_textureSize);
 
-    int dataSize = getDataSize();
-    for (int i = 0; i < dataSize; ++i) {
-        const WaveformData& datum = m_data.at(i);
-        all->add_value(datum.filtered.all);
-        low->add_value(datum.filtered.low);
-        mid->add_value(datum.filtered.mid);
-        high->add_value(datum.filtered.high);
+    MappableHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, kMappableMagic, kMappableMagicSize);
+    header.formatVersion = kMappableFormatVersion;
+    header.byteOrderMark = kMappableByteOrderMark;
+    header.headerSize = kMappableHeaderSize;
+    header.dataSize = dataSize;
+    header.textureStride = m_textureStride;
+    header.rowCount = rowCount;
+    header.mipLevelCount = getMipLevelCount();
+    header.visualSampleRate = m_visualSampleRate;
+    header.audioVisualRatio = m_audioVisualRatio;
+
+    const int dataBytes = rowCount * m_textureStride * sizeof(WaveformData);
+    const int mipBytes = header.mipLevelCount > 0 ?
+            m_mipLevelOffsets.back() * sizeof(WaveformData) : 0;
+    QByteArray result(kMappableHeaderSize + dataBytes + mipBytes, '\0');
+    uchar* pPayload = reinterpret_cast<uchar*>(result.data()) +
+            kMappableHeaderSize;
+    if (dataBytes > 0) {
+        memcpy(pPayload, m_data, dataBytes);
     }
+    if (mipBytes > 0) {
+        memcpy(pPayload + dataBytes, m_mipData, mipBytes);
+    }
+    header.checksum = checksumOfPayload(pPayload, dataBytes + mipBytes);
+    memcpy(result.data(), &header, sizeof(header));
 
-    qDebug() << "Writing waveform from byte array:"
+    qDebug() << "Writing waveform to byte array:"
              << "dataSize" << dataSize
-             << "allSignalSize" << all->value_size()
-             << "visualSampleRate" << waveform.visual_sample_rate()
-             << "audioVisualRatio" << waveform.audio_visual_ratio();
+             << "textureStride" << m_textureStride
+             << "visualSampleRate" << m_visualSampleRate
+             << "audioVisualRatio" << m_audioVisualRatio;
+    return result;
+}
 
-    std::string output;
-    waveform.SerializeToString(&output);
-    return QByteArray(output.data(), output.length());
+bool Waveform::readMappable(const uchar* pData, qint64 size, bool copy) {
+    if (size < kMappableHeaderSize) {
+        return false;
+    }
+    MappableHeader header;
+    memcpy(&header, pData, sizeof(header));
+    if (memcmp(header.magic, kMappableMagic, kMappableMagicSize) != 0 ||
+            header.formatVersion != kMappableFormatVersion ||
+            header.byteOrderMark != kMappableByteOrderMark ||
+            header.headerSize != static_cast<quint32>(kMappableHeaderSize)) {
+        qDebug() << "ERROR: Unsupported waveform format version"
+                 << header.formatVersion;
+        return false;
+    }
+    // The texture stride is a power of 2 and the data has to fit into a
+    // square texture.
+    if (header.textureStride < 1 ||
+            (header.textureStride & (header.textureStride - 1)) != 0 ||
+            header.textureStride > (1 << 15) ||
+            header.dataSize < 0 ||
+            header.dataSize > header.textureStride * header.textureStride ||
+            header.rowCount != rowCountForSize(header.dataSize, header.textureStride) ||
+            (header.mipLevelCount != 0 &&
+             header.mipLevelCount != mipLevelCountForSize(header.dataSize)) ||
+            !(header.visualSampleRate > 0) ||
+            !(header.audioVisualRatio > 0)) {
+        qDebug() << "ERROR: Waveform header is inconsistent";
+        return false;
+    }
+    const int textureSize = header.rowCount * header.textureStride;
+    std::vector<int> mipLevelOffsets = computeMipLevelOffsets(
+            header.dataSize, header.mipLevelCount);
+    const int mipSize = mipLevelOffsets.back();
+    const qint64 payloadSize =
+            static_cast<qint64>(textureSize + mipSize) * sizeof(WaveformData);
+    if (size < kMappableHeaderSize + payloadSize) {
+        qDebug() << "ERROR: Waveform data is truncated";
+        return false;
+    }
+
+    const uchar* pWaveformData = pData + kMappableHeaderSize;
+    if (checksumOfPayload(pWaveformData, payloadSize) != header.checksum) {
+        qDebug() << "ERROR: Waveform data is corrupt";
+        return false;
+    }
+    const uchar* pMipData = pWaveformData + textureSize * sizeof(WaveformData);
+    if (copy) {
+        // Pad to the full square texture like analyzed waveforms
+        resize(header.dataSize);
+        if (m_textureStride != header.textureStride) {
+            resize(0);
+            return false;
+        }
+        memcpy(m_data, pWaveformData, textureSize * sizeof(WaveformData));
+        if (header.mipLevelCount > 0) {
+            m_mipStorage.resize(mipSize);
+            memcpy(m_mipStorage.data(), pMipData, mipSize * sizeof(WaveformData));
+            m_mipData = m_mipStorage.data();
+        }
+    } else {
+        m_dataSize = header.dataSize;
+        m_textureStride = header.textureStride;
+        m_textureSize = textureSize;
+        // The mapping is read-only, see data()
+        m_data = reinterpret_cast<WaveformData*>(
+                const_cast<uchar*>(pWaveformData));
+        m_mipData = reinterpret_cast<WaveformData*>(
+                const_cast<uchar*>(pMipData));
+    }
+    m_visualSampleRate = header.visualSampleRate;
+    m_audioVisualRatio = header.audioVisualRatio;
+    m_completion = m_dataSize;
+    m_saveState = SaveState::Saved;
+    if (header.mipLevelCount > 0) {
+        m_mipLevelOffsets = std::move(mipLevelOffsets);
+        m_mipLevelCount.fetchAndStoreRelease(header.mipLevelCount);
+    } else if (copy) {
+        buildMipLevels();
+    }
+    return true;
+}
+
+// static
+int Waveform::mipLevelCountForSize(int dataSize) {
+    int levelCount = 0;
+    int frames = (dataSize + 1) / 2;
+    while ((frames + 1) / 2 >= kMinMipLevelFrames) {
+        frames = (frames + 1) / 2;
+        ++levelCount;
+    }
+    return levelCount;
+}
+
+int Waveform::getMipLevelDataSize(int level) const {
+    DEBUG_ASSERT(level >= 0 && level <= getMipLevelCount());
+    if (level == 0) {
+        return m_dataSize;
+    }
+    return m_mipLevelOffsets[level + 1] - m_mipLevelOffsets[level];
+}
+
+const WaveformData* Waveform::getMipLevelData(int level) const {
+    DEBUG_ASSERT(level >= 0 && level <= getMipLevelCount());
+    if (level == 0) {
+        return m_data;
+    }
+    return m_mipData + m_mipLevelOffsets[level];
+}
+
+void Waveform::buildMipLevels() {
+    VERIFY_OR_DEBUG_ASSERT(!isMapped()) {
+        return;
+    }
+    if (getMipLevelCount() > 0) {
+        return;
+    }
+    const int levelCount = mipLevelCountForSize(m_dataSize);
+    if (levelCount == 0) {
+        return;
+    }
+    // Readers don't access the mip levels before they are published
+    m_mipLevelOffsets = computeMipLevelOffsets(m_dataSize, levelCount);
+    m_mipStorage.assign(m_mipLevelOffsets.back(), WaveformData(0));
+    m_mipData = m_mipStorage.data();
+
+    const WaveformData* pSource = m_data;
+    int sourceFrames = (m_dataSize + 1) / 2;
+    for (int level = 1; level <= levelCount; ++level) {
+        WaveformData* pTarget = m_mipData + m_mipLevelOffsets[level];
+        const int targetFrames =
+                (m_mipLevelOffsets[level + 1] - m_mipLevelOffsets[level]) / 2;
+        for (int frame = 0; frame < targetFrames; ++frame) {
+            // The last frame of an odd number of frames has no partner
+            const bool hasPartner = 2 * frame + 1 < sourceFrames;
+            for (int channel = 0; channel < ChannelCount; ++channel) {
+                const WaveformData& first = pSource[4 * frame + channel];
+                const WaveformData& second = hasPartner ?
+                        pSource[4 * frame + 2 + channel] : first;
+                storeMax(&pTarget[2 * frame + channel], first, second);
+            }
+        }
+        pSource = pTarget;
+        sourceFrames = targetFrames;
+    }
+    m_mipLevelCount.fetchAndStoreRelease(levelCount);
 }
 
 void Waveform::readByteArray(const QByteArray& data) {
     if (data.isNull()) {
         return;
     }
+    if (isMappableData(data)) {
+        if (!readMappable(reinterpret_cast<const uchar*>(data.constData()),
+                data.size(), true)) {
+            qDebug() << "ERROR: Could not read Waveform from QByteArray of size"
+                     << data.size();
+        }
+        return;
+    }
+    readProtobuf(data);
+}
 
+void Waveform::readProtobuf(const QByteArray& data) {
     io::Waveform waveform;
 
     if (!waveform.ParseFromArray(data.constData(), data.size())) {
@@ -195,18 +478,23 @@ void Waveform::readByteArray(const QByteArray& data) {
     }
     m_completion = dataSize;
     m_saveState = SaveState::Saved;
+    buildMipLevels();
 }
 
 void Waveform::resize(int size) {
     m_dataSize = size;
     m_textureStride = computeTextureStride(size);
-    m_data.resize(m_textureStride * m_textureStride);
+    m_storage.resize(m_textureStride * m_textureStride);
+    m_data = m_storage.data();
+    m_textureSize = m_storage.size();
 }
 
 void Waveform::assign(int size, int value) {
     m_dataSize = size;
     m_textureStride = computeTextureStride(size);
-    m_data.assign(m_textureStride * m_textureStride, value);
+    m_storage.assign(m_textureStride * m_textureStride, value);
+    m_data = m_storage.data();
+    m_textureSize = m_storage.size();
     m_saveState = SaveState::SavePending;
 }
 
@@ -1,8 +1,10 @@
 #ifndef WAVEFORM_H
 #define WAVEFORM_H
 
+#include <memory>
 #include <vector>
 
+#include <QFile>
 #include <QMutex>
 #include <QByteArray>
 #include <QString>
@@ -10,6 +12,7 @@
 #include <QSharedPointer>
 #include <QMutexLocker>
 
+#include "util/assert.h"
 #include "util/class.h"
 #include "util/compatibility.h"
 
@@ -37,12 +40,41 @@ class Waveform {
         Saved
     };
 
+    // Reads the data written by toByteArray() or the protobuf serialization
+    // that has been used up to Waveform-5.0.
     explicit Waveform(const QByteArray pData = QByteArray());
     Waveform(int audioSampleRate, int audioSamples,
              int desiredVisualSampleRate, int maxVisualSamples);
 
     virtual ~Waveform();
 
+    // Maps a file with the data from toByteArray() into memory and uses it in
+    // place without copying, so waveforms of the same track share the page
+    // cache. The returned waveform is invalid if the file can't be mapped.
+    // On Windows the file is read into memory instead, because a mapped file
+    // can't be replaced or deleted there.
+    static Waveform* createMapped(const QString& fileName);
+
+    // Returns true if the data starts like the output of toByteArray(). A
+    // prefix of kMappableMagicSize bytes is sufficient.
+    static bool isMappableData(const QByteArray& data);
+    static const int kMappableMagicSize = 4;
+    // Keeps the data aligned to cache lines
+    static const int kMappableHeaderSize = 64;
+
+    // Returns the checksum of the data from toByteArray() that is stored in
+    // its header, or 0 if there is none. A prefix of kMappableHeaderSize
+    // bytes is sufficient. The data is validated against it when it is read.
+    static quint32 mappableChecksum(const QByteArray& data);
+
+    // Returns a checksum of the data that identifies its contents, e.g. to
+    // tell whether a track has been analyzed again. Reads all data.
+    quint32 computeDataChecksum() const;
+
+    bool isMapped() const {
+        return m_pMappedFile != nullptr;
+    }
+
     int getId() const {
         QMutexLocker locker(&m_mutex);
         return m_id;
@@ -73,6 +105,9 @@ class Waveform {
         m_description = description;
     }
 
+    // Serializes the waveform into a fixed binary layout that can be mapped
+    // into memory by createMapped(): a header followed by the data in rows of
+    // getTextureStride() elements.
     QByteArray toByteArray() const;
 
     // We do not lock the mutex since m_dataSize and m_visualSampleRate are not
@@ -110,9 +145,11 @@ class Waveform {
     // the constructor runs.
     inline int getTextureStride() const { return m_textureStride; }
 
-    // We do not lock the mutex since m_data is not resized after the
-    // constructor runs.
-    inline int getTextureSize() const { return m_data.size(); }
+    // The number of data elements that are accessible through data(). It is a
+    // multiple of getTextureStride() and at most the square of it. Mapped
+    // waveforms only contain the rows that hold data. We do not lock the
+    // mutex since m_textureSize is not changed after the constructor runs.
+    inline int getTextureSize() const { return m_textureSize; }
 
     // Atomically get the number of data elements in this Waveform. We do not
     // lock the mutex since m_dataSize is not changed after the constructor
@@ -126,17 +163,41 @@ class Waveform {
     inline unsigned char getAll(int i) const { return m_data[i].filtered.all;}
 
     // We do not lock the mutex since m_data is not resized after the
-    // constructor runs.
-    WaveformData* data() { return &m_data[0];}
+    // constructor runs. Mapped waveforms are read-only.
+    WaveformData* data() {
+        DEBUG_ASSERT(!isMapped());
+        return m_data;
+    }
 
     // We do not lock the mutex since m_data is not resized after the
     // constructor runs.
-    const WaveformData* data() const { return &m_data[0];}
+    const WaveformData* data() const { return m_data; }
+
+    // Mip levels hold the maximum of each band over 2^level visual frames,
+    // for rendering zoomed out waveforms in O(pixels). The left and right
+    // channel are interleaved like in data(). Level 0 is the full resolution
+    // data(), the coarsest level has at least kMinMipLevelFrames frames.
+    // Returns 0 until buildMipLevels() has been called.
+    int getMipLevelCount() const {
+        // Acquire the mip level data published by buildMipLevels()
+        return const_cast<QAtomicInt&>(m_mipLevelCount).fetchAndAddAcquire(0);
+    }
+    int getMipLevelDataSize(int level) const;
+    const WaveformData* getMipLevelData(int level) const;
+
+    // Computes the mip levels after all data has been written. Readers
+    // keep using the full resolution until the levels are complete.
+    void buildMipLevels();
+
+    static const int kMinMipLevelFrames = 1024;
+    static int mipLevelCountForSize(int dataSize);
 
     void dump() const;
 
   private:
     void readByteArray(const QByteArray& data);
+    void readProtobuf(const QByteArray& data);
+    bool readMappable(const uchar* pData, qint64 size, bool copy);
     void resize(int size);
     void assign(int size, int value = 0);
 
@@ -157,14 +218,24 @@ class Waveform {
     // The size of the waveform data stored in m_data. Not allowed to change
     // after the constructor runs.
     int m_dataSize;
-    // The vector storing the waveform data. It is potentially larger than
-    // m_dataSize since it includes padding for uploading the entire waveform as
-    // a texture in the GLSL renderer. The size is not allowed to change after
-    // the constructor runs. We use a std::vector to avoid the cost of bounds
-    // checking when accessing the vector.
-    // TODO(XXX): In the future we should switch to QVector and use the raw data
-    // pointer when performance matters.
-    std::vector<WaveformData> m_data;
+    // The waveform data, either m_storage or a file mapping. It is potentially
+    // larger than m_dataSize since it includes padding for uploading the
+    // waveform as a texture in the GLSL renderer. The size is not allowed to
+    // change after the constructor runs.
+    WaveformData* m_data;
+    int m_textureSize;
+    // We use a std::vector to avoid the cost of bounds checking when
+    // accessing the vector.
+    std::vector<WaveformData> m_storage;
+    // Owns the mapping of m_data if the waveform is mapped from a file.
+    std::unique_ptr<QFile> m_pMappedFile;
+    // All mip levels from level 1, either m_mipStorage or a file mapping.
+    // Not allowed to change after m_mipLevelCount has been published.
+    WaveformData* m_mipData;
+    std::vector<WaveformData> m_mipStorage;
+    // The offset of each level in m_mipData, see computeMipLevelOffsets()
+    std::vector<int> m_mipLevelOffsets;
+    QAtomicInt m_mipLevelCount;
     // Not allowed to change after the constructor runs.
     double m_visualSampleRate;
     // Not allowed to change after the constructor runs.
@@ -6,10 +6,30 @@
 // static
 Waveform* WaveformFactory::loadWaveformFromAnalysis(
         const AnalysisDao::AnalysisInfo& analysis) {
-    Waveform* pWaveform = new Waveform(analysis.data);
+    Waveform* pWaveform;
+    if (analysis.data.isEmpty() && !analysis.dataPath.isEmpty()) {
+        pWaveform = Waveform::createMapped(analysis.dataPath);
+    } else {
+        pWaveform = new Waveform(analysis.data);
+    }
     pWaveform->setId(analysis.analysisId);
-    pWaveform->setVersion(analysis.version);
-    pWaveform->setDescription(analysis.description);
+    if (pWaveform->isValid() &&
+            (analysis.version == WAVEFORM_5_VERSION ||
+             analysis.version == WAVEFORMSUMMARY_5_VERSION)) {
+        // Upgrade to the mappable format when the analysis is saved again
+        // under the same ID.
+        if (analysis.type == AnalysisDao::TYPE_WAVESUMMARY) {
+            pWaveform->setVersion(currentWaveformSummaryVersion());
+            pWaveform->setDescription(currentWaveformSummaryDescription());
+        } else {
+            pWaveform->setVersion(currentWaveformVersion());
+            pWaveform->setDescription(currentWaveformDescription());
+        }
+        pWaveform->setSaveState(Waveform::SaveState::SavePending);
+    } else {
+        pWaveform->setVersion(analysis.version);
+        pWaveform->setDescription(analysis.description);
+    }
     return pWaveform;
 }
 
@@ -20,6 +40,11 @@ WaveformFactory::VersionClass WaveformFactory::waveformVersionToVersionClass(con
         return VC_USE;
     }
 
+    if (version == WAVEFORM_5_VERSION) {
+        // use, it is converted to the current version when loaded
+        return VC_USE;
+    }
+
     if (version == WAVEFORM_4_VERSION) {
         // Used in Mixxx 1.12 beta, suffers Bug lp:1406389
         return VC_REMOVE;
@@ -46,6 +71,11 @@ WaveformFactory::VersionClass WaveformFactory::waveformSummaryVersionToVersionCl
         return VC_USE;
     }
 
+    if (version == WAVEFORMSUMMARY_5_VERSION) {
+        // use, it is converted to the current version when loaded
+        return VC_USE;
+    }
+
     if (version == WAVEFORMSUMMARY_4_VERSION) {
         // Used in Mixxx 1.12 beta, suffers Bug lp:1406389
         return VC_REMOVE;
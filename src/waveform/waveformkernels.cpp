@@ -0,0 +1,97 @@
+#include "waveform/waveformkernels.h"
+
+#include "util/math.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MIXXX_WAVEFORMKERNELS_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace mixxx {
+
+namespace {
+
+// Scalar kernels. They also process the remaining frames
+// that do not fill a whole vector register.
+
+inline void storeMaxBands(WaveformData* pMax, const WaveformData& data) {
+    pMax->filtered.low = math_max(pMax->filtered.low, data.filtered.low);
+    pMax->filtered.mid = math_max(pMax->filtered.mid, data.filtered.mid);
+    pMax->filtered.high = math_max(pMax->filtered.high, data.filtered.high);
+    pMax->filtered.all = math_max(pMax->filtered.all, data.filtered.all);
+}
+
+inline void maxPerChannelScalarFrom(const WaveformData* pData,
+        int firstFrame, int numFrames,
+        WaveformData* pMaxLeft, WaveformData* pMaxRight) {
+    for (int i = firstFrame; i < numFrames; ++i) {
+        storeMaxBands(pMaxLeft, pData[i * 2]);
+        storeMaxBands(pMaxRight, pData[i * 2 + 1]);
+    }
+}
+
+void maxPerChannelScalar(const WaveformData* pData, int numFrames,
+        WaveformData* pMaxLeft, WaveformData* pMaxRight) {
+    pMaxLeft->m_i = 0;
+    pMaxRight->m_i = 0;
+    maxPerChannelScalarFrom(pData, 0, numFrames, pMaxLeft, pMaxRight);
+}
+
+const WaveformKernels kScalarKernels = {
+    maxPerChannelScalar,
+};
+
+#ifdef MIXXX_WAVEFORMKERNELS_SSE2
+
+// SSE2 kernels: 16 bands = 2 stereo frames per register
+
+void maxPerChannelSSE2(const WaveformData* pData, int numFrames,
+        WaveformData* pMaxLeft, WaveformData* pMaxRight) {
+    __m128i max = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 2 <= numFrames; i += 2) {
+        max = _mm_max_epu8(max, _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(pData + i * 2)));
+    }
+    // Fold the second frame onto the first one
+    max = _mm_max_epu8(max, _mm_srli_si128(max, 8));
+    // The bands are stored in the same order as in WaveformData
+    pMaxLeft->m_i = _mm_cvtsi128_si32(max);
+    pMaxRight->m_i = _mm_cvtsi128_si32(_mm_srli_si128(max, 4));
+    maxPerChannelScalarFrom(pData, i, numFrames, pMaxLeft, pMaxRight);
+}
+
+const WaveformKernels kSSE2Kernels = {
+    maxPerChannelSSE2,
+};
+
+#endif // MIXXX_WAVEFORMKERNELS_SSE2
+
+} // anonymous namespace
+
+// static
+const WaveformKernels& WaveformKernels::forInstructionSet(
+        SampleKernels::InstructionSet instructionSet) {
+    if (!SampleKernels::isSupported(instructionSet)) {
+        return kScalarKernels;
+    }
+    switch (instructionSet) {
+#ifdef MIXXX_WAVEFORMKERNELS_SSE2
+    case SampleKernels::InstructionSet::AVX:
+    case SampleKernels::InstructionSet::SSE2:
+        return kSSE2Kernels;
+#endif
+    default:
+        return kScalarKernels;
+    }
+}
+
+// static
+const WaveformKernels& WaveformKernels::get() {
+    // Detected only once, thread-safe since C++11
+    static const WaveformKernels& kernels =
+            forInstructionSet(SampleKernels::detectInstructionSet());
+    return kernels;
+}
+
+} // namespace mixxx
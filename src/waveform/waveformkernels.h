@@ -0,0 +1,36 @@
+#ifndef MIXXX_WAVEFORM_WAVEFORMKERNELS_H
+#define MIXXX_WAVEFORM_WAVEFORMKERNELS_H
+
+#include "util/samplekernels.h"
+#include "waveform/waveform.h"
+
+namespace mixxx {
+
+// Explicitly vectorized reductions of waveform data for the software
+// waveform renderers. The instruction sets are shared with SampleKernels.
+// There are no AVX kernels, because 256 bit integer operations need AVX2,
+// so AVX selects the SSE2 kernels.
+class WaveformKernels {
+  public:
+    // Finds the maximum of each band of the left and the right channel of
+    // numFrames interleaved visual frames. Both maxima are zero if numFrames
+    // is 0.
+    typedef void (*MaxPerChannelFunc)(const WaveformData* pData, int numFrames,
+            WaveformData* pMaxLeft, WaveformData* pMaxRight);
+
+    MaxPerChannelFunc maxPerChannel;
+
+    // The kernels for the best instruction set that is supported
+    // by both the build and the CPU.
+    static const WaveformKernels& get();
+
+    // The kernels for a specific instruction set, e.g. for testing and
+    // benchmarking. Falls back to the scalar kernels if the instruction
+    // set is not supported.
+    static const WaveformKernels& forInstructionSet(
+            SampleKernels::InstructionSet instructionSet);
+};
+
+} // namespace mixxx
+
+#endif /* MIXXX_WAVEFORM_WAVEFORMKERNELS_H */
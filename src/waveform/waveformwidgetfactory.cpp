@@ -13,6 +13,7 @@
 #include "waveform/widgets/softwarewaveformwidget.h"
 #include "waveform/widgets/hsvwaveformwidget.h"
 #include "waveform/widgets/rgbwaveformwidget.h"
+#include "waveform/widgets/rasterrgbwaveformwidget.h"
 #include "waveform/widgets/glrgbwaveformwidget.h"
 #include "waveform/widgets/glwaveformwidget.h"
 #include "waveform/widgets/glsimplewaveformwidget.h"
@@ -69,6 +70,8 @@ WaveformWidgetFactory::WaveformWidgetFactory() :
         m_openGLShaderAvailable(false),
         m_beatGridEnabled(true),
         m_vsyncThread(NULL),
+        m_frameTimer("WaveformWidgetFactory frame time",
+                kDefaultComputeFlags | Stat::HISTOGRAM),
         m_frameCnt(0),
         m_actualFrameRate(0),
         m_vSyncType(0) {
@@ -487,6 +490,7 @@ void WaveformWidgetFactory::notifyZoomChange(WWaveformViewer* viewer) {
 
 void WaveformWidgetFactory::render() {
     ScopedTimer t("WaveformWidgetFactory::render() %1waveforms", m_waveformWidgetHolders.size());
+    m_frameTimer.restart(true);
 
     //int paintersSetupTime0 = 0;
     //int paintersSetupTime1 = 0;
@@ -570,7 +574,7 @@ WaveformWidgetType::Type WaveformWidgetFactory::autoChooseWidgetType() const {
             return WaveformWidgetType::GLRGBWaveform;
         }
     }
-    return WaveformWidgetType::SoftwareWaveform;
+    return WaveformWidgetType::RasterRGBWaveform;
 }
 
 void WaveformWidgetFactory::evaluateWidgets() {
@@ -608,6 +612,12 @@ void WaveformWidgetFactory::evaluateWidgets() {
             useOpenGLShaders = RGBWaveformWidget::useOpenGLShaders();
             developerOnly = RGBWaveformWidget::developerOnly();
             break;
+        case WaveformWidgetType::RasterRGBWaveform:
+            widgetName = RasterRGBWaveformWidget::getWaveformWidgetName();
+            useOpenGl = RasterRGBWaveformWidget::useOpenGl();
+            useOpenGLShaders = RasterRGBWaveformWidget::useOpenGLShaders();
+            developerOnly = RasterRGBWaveformWidget::developerOnly();
+            break;
         case WaveformWidgetType::QtSimpleWaveform:
             widgetName = QtSimpleWaveformWidget::getWaveformWidgetName();
             useOpenGl = QtSimpleWaveformWidget::useOpenGl();
@@ -706,6 +716,9 @@ WaveformWidgetAbstract* WaveformWidgetFactory::createWaveformWidget(
         case WaveformWidgetType::RGBWaveform:
             widget = new RGBWaveformWidget(viewer->getGroup(), viewer);
             break;
+        case WaveformWidgetType::RasterRGBWaveform:
+            widget = new RasterRGBWaveformWidget(viewer->getGroup(), viewer);
+            break;
         case WaveformWidgetType::QtSimpleWaveform:
             widget = new QtSimpleWaveformWidget(viewer->getGroup(), viewer);
             break;
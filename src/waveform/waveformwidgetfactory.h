@@ -11,6 +11,7 @@
 #include "waveform/waveform.h"
 #include "skin/skincontext.h"
 #include "util/performancetimer.h"
+#include "util/timer.h"
 
 class WWaveformViewer;
 class WaveformWidgetAbstract;
@@ -157,6 +158,9 @@ class WaveformWidgetFactory : public QObject, public Singleton<WaveformWidgetFac
 
     //Debug
     PerformanceTimer m_time;
+    // Reports the time between two rendered frames, so that its histogram
+    // shows how often the GUI thread misses a vsync.
+    Timer m_frameTimer;
     float m_frameCnt;
     double m_actualFrameRate;
     int m_vSyncType;
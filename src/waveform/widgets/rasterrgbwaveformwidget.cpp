@@ -0,0 +1,41 @@
+#include "rasterrgbwaveformwidget.h"
+
+#include <QPainter>
+
+#include "waveform/renderers/waveformwidgetrenderer.h"
+#include "waveform/renderers/waveformrenderbackground.h"
+#include "waveform/renderers/waveformrendermark.h"
+#include "waveform/renderers/waveformrendermarkrange.h"
+#include "waveform/renderers/rasterwaveformrendererrgb.h"
+#include "waveform/renderers/waveformrendererpreroll.h"
+#include "waveform/renderers/waveformrendererendoftrack.h"
+#include "waveform/renderers/waveformrenderbeat.h"
+
+RasterRGBWaveformWidget::RasterRGBWaveformWidget(const char* group, QWidget* parent)
+        : QWidget(parent),
+          WaveformWidgetAbstract(group) {
+    addRenderer<WaveformRenderBackground>();
+    addRenderer<WaveformRendererEndOfTrack>();
+    addRenderer<WaveformRendererPreroll>();
+    addRenderer<WaveformRenderMarkRange>();
+    addRenderer<RasterWaveformRendererRGB>();
+    addRenderer<WaveformRenderBeat>();
+    addRenderer<WaveformRenderMark>();
+
+    setAttribute(Qt::WA_NoSystemBackground);
+    setAttribute(Qt::WA_OpaquePaintEvent);
+
+    m_initSuccess = init();
+}
+
+RasterRGBWaveformWidget::~RasterRGBWaveformWidget() {
+}
+
+void RasterRGBWaveformWidget::castToQWidget() {
+    m_widget = static_cast<QWidget*>(this);
+}
+
+void RasterRGBWaveformWidget::paintEvent(QPaintEvent* event) {
+    QPainter painter(this);
+    draw(&painter, event);
+}
@@ -0,0 +1,31 @@
+#ifndef RASTERRGBWAVEFORMWIDGET_H
+#define RASTERRGBWAVEFORMWIDGET_H
+
+#include <QWidget>
+
+#include "waveformwidgetabstract.h"
+
+// RGB waveform for systems without OpenGL. The signal is written directly
+// into a framebuffer instead of being drawn line by line with QPainter.
+class RasterRGBWaveformWidget : public QWidget, public WaveformWidgetAbstract {
+    Q_OBJECT
+  public:
+    virtual ~RasterRGBWaveformWidget();
+
+    virtual WaveformWidgetType::Type getType() const { return WaveformWidgetType::RasterRGBWaveform; }
+
+    static inline QString getWaveformWidgetName() { return tr("RGB") + " - " + tr("Raster"); }
+    static inline bool useOpenGl() { return false; }
+    static inline bool useOpenGLShaders() { return false; }
+    static inline bool developerOnly() { return false; }
+
+  protected:
+    virtual void castToQWidget();
+    virtual void paintEvent(QPaintEvent* event);
+
+  private:
+    RasterRGBWaveformWidget(const char* group, QWidget* parent);
+    friend class WaveformWidgetFactory;
+};
+
+#endif // RASTERRGBWAVEFORMWIDGET_H
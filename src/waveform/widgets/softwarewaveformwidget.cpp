@@ -10,6 +10,7 @@
 #include "waveform/renderers/waveformrendererpreroll.h"
 #include "waveform/renderers/waveformrendererendoftrack.h"
 #include "waveform/renderers/waveformrenderbeat.h"
+#include "waveform/renderers/waveformrendertiles.h"
 
 SoftwareWaveformWidget::SoftwareWaveformWidget(const char* group, QWidget* parent)
     : QWidget(parent),
@@ -18,8 +19,10 @@ SoftwareWaveformWidget::SoftwareWaveformWidget(const char* group, QWidget* paren
     addRenderer<WaveformRendererEndOfTrack>();
     addRenderer<WaveformRendererPreroll>();
     addRenderer<WaveformRenderMarkRange>();
-    addRenderer<WaveformRendererFilteredSignal>();
-    addRenderer<WaveformRenderBeat>();
+    // The signal and the beat grid are rendered into tiles off the GUI thread
+    WaveformRenderTiles* pTiles = addRenderer<WaveformRenderTiles>();
+    pTiles->addRenderer<WaveformRendererFilteredSignal>();
+    pTiles->addRenderer<WaveformRenderBeat>();
     addRenderer<WaveformRenderMark>();
 
     setAttribute(Qt::WA_NoSystemBackground);
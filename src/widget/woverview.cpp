@@ -11,6 +11,8 @@
 //
 
 #include <QBrush>
+#include <QCache>
+#include <QCryptographicHash>
 #include <QtDebug>
 #include <QMouseEvent>
 #include <QPaintEvent>
@@ -20,11 +22,14 @@
 #include <QUrl>
 #include <QMimeData>
 
+#include <cmath>
+
 #include "control/controlobject.h"
 #include "control/controlproxy.h"
 #include "woverview.h"
 #include "wskincolor.h"
 #include "widget/controlwidgetconnection.h"
+#include "library/dao/analysisdao.h"
 #include "track/track.h"
 #include "util/math.h"
 #include "util/timer.h"
@@ -33,6 +38,28 @@
 #include "waveform/waveform.h"
 #include "waveform/waveformwidgetfactory.h"
 
+namespace {
+
+struct CachedOverview {
+    QImage image;
+    float peak;
+};
+
+// The size of a rendered overview is about 4 MB.
+const int kOverviewCacheKiloBytes = 32 * 1024;
+
+// Rendered overviews of completely analyzed tracks, so that loading a track
+// again does not need to draw its overview from scratch. Shared by all
+// overviews and only accessed from the GUI thread. They are also stored
+// with the analysis of the summary, see AnalysisDao, so that they survive
+// a restart.
+QCache<QString, CachedOverview> s_overviewCache(kOverviewCacheKiloBytes);
+
+// The text key of the peak in the stored image
+const QString kPeakTextKey = "peak";
+
+} // anonymous namespace
+
 WOverview::WOverview(const char *pGroup, UserSettingsPointer pConfig, QWidget* parent) :
         WWidget(parent),
         m_actualCompletion(0),
@@ -47,6 +74,7 @@ WOverview::WOverview(const char *pGroup, UserSettingsPointer pConfig, QWidget* p
         m_orientation(Qt::Horizontal),
         m_a(1.0),
         m_b(0.0),
+        m_scaledCompletion(0),
         m_dAnalyzerProgress(1.0),
         m_bAnalyzerFinalizing(false),
         m_trackLoaded(false),
@@ -165,17 +193,13 @@ void WOverview::slotWaveformSummaryUpdated() {
         // If the waveform is already complete, just draw it.
         if (m_pWaveform->getCompletion() == m_pWaveform->getDataSize()) {
             m_actualCompletion = 0;
-            if (drawNextPixmapPart()) {
+            if (drawNextWaveformPart()) {
                 update();
             }
         }
     } else {
         // Null waveform pointer means waveform was cleared.
-        m_waveformSourceImage = QImage();
-        m_dAnalyzerProgress = 1.0;
-        m_actualCompletion = 0;
-        m_waveformPeak = -1.0;
-        m_pixmapDone = false;
+        resetWaveformImage();
 
         update();
     }
@@ -189,7 +213,7 @@ void WOverview::slotAnalyzerProgress(int progress) {
     double analyzerProgress = progress / 1000.0;
     bool finalizing = progress == 999;
 
-    bool updateNeeded = drawNextPixmapPart();
+    bool updateNeeded = drawNextWaveformPart();
     // progress 0 .. 1000
     if (updateNeeded || (m_dAnalyzerProgress != analyzerProgress)) {
         m_dAnalyzerProgress = analyzerProgress;
@@ -214,11 +238,7 @@ void WOverview::slotLoadingTrack(TrackPointer pNewTrack, TrackPointer pOldTrack)
                    this, SLOT(slotAnalyzerProgress(int)));
     }
 
-    m_waveformSourceImage = QImage();
-    m_dAnalyzerProgress = 1.0;
-    m_actualCompletion = 0;
-    m_waveformPeak = -1.0;
-    m_pixmapDone = false;
+    resetWaveformImage();
     m_trackLoaded = false;
     m_endOfTrack = false;
 
@@ -324,18 +344,7 @@ void WOverview::paintEvent(QPaintEvent * /*unused*/) {
                 diffGain = 255.0 - 255.0 / visualGain;
             }
 
-            if (m_diffGain != diffGain || m_waveformImageScaled.isNull()) {
-                QRect sourceRect(0, diffGain, m_waveformSourceImage.width(),
-                    m_waveformSourceImage.height() - 2 * diffGain);
-                QImage croppedImage = m_waveformSourceImage.copy(sourceRect);
-                if (m_orientation == Qt::Vertical) {
-                    // Rotate pixmap
-                    croppedImage = croppedImage.transformed(QTransform(0, 1, 1, 0, 0, 0));
-                }
-                m_waveformImageScaled = croppedImage.scaled(size(), Qt::IgnoreAspectRatio,
-                                                            Qt::SmoothTransformation);
-                m_diffGain = diffGain;
-            }
+            updateWaveformImageScaled(diffGain);
 
             painter.drawImage(rect(), m_waveformImageScaled);
 
@@ -598,3 +607,192 @@ void WOverview::dropEvent(QDropEvent* event) {
     }
     event->ignore();
 }
+
+void WOverview::resetWaveformImage() {
+    m_waveformSourceImage = QImage();
+    m_waveformImageScaled = QImage();
+    m_dAnalyzerProgress = 1.0;
+    m_actualCompletion = 0;
+    m_scaledCompletion = 0;
+    m_waveformPeak = -1.0;
+    m_pixmapDone = false;
+}
+
+bool WOverview::drawNextWaveformPart() {
+    if (m_actualCompletion == 0 && restoreCachedOverview()) {
+        return true;
+    }
+    const bool pixmapDone = m_pixmapDone;
+    if (!drawNextPixmapPart()) {
+        return false;
+    }
+    if (m_pixmapDone && !pixmapDone) {
+        storeCachedOverview();
+    }
+    return true;
+}
+
+QString WOverview::overviewCacheKey() const {
+    if (!m_pCurrentTrack || !m_pWaveform) {
+        return QString();
+    }
+    const TrackId trackId = m_pCurrentTrack->getId();
+    if (!trackId.isValid()) {
+        return QString();
+    }
+    // Overviews of different types or with different colors look different.
+    // The summary keeps its ID when the track is analyzed again, so the
+    // checksum tells whether the data is still the same.
+    return QString("%1 %2 %3 %4 %5 %6").arg(
+            metaObject()->className(),
+            trackId.toString(),
+            QString::number(m_pWaveform->getId()),
+            QString::number(m_pWaveform->getDataSize()),
+            QString::number(m_pWaveform->computeDataChecksum()),
+            (QStringList()
+                    << m_signalColors.getSignalColor().name()
+                    << m_signalColors.getLowColor().name()
+                    << m_signalColors.getMidColor().name()
+                    << m_signalColors.getHighColor().name()
+                    << m_signalColors.getRgbLowColor().name()
+                    << m_signalColors.getRgbMidColor().name()
+                    << m_signalColors.getRgbHighColor().name()).join(","));
+}
+
+bool WOverview::restoreCachedOverview() {
+    const QString key = overviewCacheKey();
+    if (key.isEmpty()) {
+        return false;
+    }
+    if (m_pWaveform->getCompletion() < m_pWaveform->getDataSize()) {
+        // The track is analyzed again
+        s_overviewCache.remove(key);
+        return false;
+    }
+    const CachedOverview* pCachedOverview = s_overviewCache.object(key);
+    if (pCachedOverview) {
+        m_waveformSourceImage = pCachedOverview->image;
+        m_waveformPeak = pCachedOverview->peak;
+    } else {
+        QImage image;
+        float peak;
+        if (!loadStoredOverview(key, &image, &peak)) {
+            return false;
+        }
+        m_waveformSourceImage = image;
+        m_waveformPeak = peak;
+        CachedOverview* pStoredOverview = new CachedOverview;
+        pStoredOverview->image = image;
+        pStoredOverview->peak = peak;
+        s_overviewCache.insert(key, pStoredOverview, image.byteCount() / 1024);
+    }
+    m_actualCompletion = m_pWaveform->getDataSize();
+    m_pixmapDone = true;
+    m_waveformImageScaled = QImage();
+    return true;
+}
+
+void WOverview::storeCachedOverview() {
+    const QString key = overviewCacheKey();
+    if (key.isEmpty() || m_waveformSourceImage.isNull()) {
+        return;
+    }
+    CachedOverview* pCachedOverview = new CachedOverview;
+    // Implicitly shared until the next track is drawn
+    pCachedOverview->image = m_waveformSourceImage;
+    pCachedOverview->peak = m_waveformPeak;
+    s_overviewCache.insert(key, pCachedOverview,
+            m_waveformSourceImage.byteCount() / 1024);
+
+    // Not yet stored if the track has just been analyzed
+    const int analysisId = m_pWaveform->getId();
+    if (analysisId < 0) {
+        return;
+    }
+    // Replaces the overview of other data or colors
+    AnalysisDao::deleteRenderedOverviews(m_pConfig, analysisId,
+            metaObject()->className());
+    QImage image = m_waveformSourceImage;
+    image.setText(kPeakTextKey, QString::number(m_waveformPeak));
+    if (!image.save(storedOverviewPath(key), "PNG")) {
+        qWarning() << "Failed to store the overview of" << m_pCurrentTrack->getLocation();
+    }
+}
+
+QString WOverview::storedOverviewPath(const QString& key) const {
+    // The key is too long for a file name
+    const QString name = QString("%1-%2").arg(
+            metaObject()->className(),
+            QString::fromLatin1(QCryptographicHash::hash(key.toUtf8(),
+                    QCryptographicHash::Sha1).toHex()));
+    return AnalysisDao::renderedOverviewPath(m_pConfig, m_pWaveform->getId(),
+            name);
+}
+
+bool WOverview::loadStoredOverview(const QString& key, QImage* pImage,
+        float* pPeak) const {
+    if (m_pWaveform->getId() < 0) {
+        return false;
+    }
+    const QImage image(storedOverviewPath(key), "PNG");
+    bool ok = false;
+    *pPeak = image.text(kPeakTextKey).toFloat(&ok);
+    if (image.isNull() || !ok) {
+        return false;
+    }
+    *pImage = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    return true;
+}
+
+void WOverview::updateWaveformImageScaled(int diffGain) {
+    const int sourceWidth = m_waveformSourceImage.width();
+    const QRect sourceRect(0, diffGain, sourceWidth,
+            m_waveformSourceImage.height() - 2 * diffGain);
+    if (m_diffGain != diffGain || m_waveformImageScaled.isNull() ||
+            m_waveformImageScaled.size() != size() ||
+            m_scaledCompletion > m_actualCompletion) {
+        QImage croppedImage = m_waveformSourceImage.copy(sourceRect);
+        if (m_orientation == Qt::Vertical) {
+            // Rotate pixmap
+            croppedImage = croppedImage.transformed(QTransform(0, 1, 1, 0, 0, 0));
+        }
+        m_waveformImageScaled = croppedImage.scaled(size(), Qt::IgnoreAspectRatio,
+                                                    Qt::SmoothTransformation);
+        m_diffGain = diffGain;
+        m_scaledCompletion = m_actualCompletion;
+        return;
+    }
+    if (m_scaledCompletion == m_actualCompletion || sourceWidth <= 0) {
+        return;
+    }
+
+    // Each source column holds one visual frame. Widen the target range by
+    // one pixel on either side, so the smoothing matches the neighbours.
+    const double scale = static_cast<double>(length()) / sourceWidth;
+    const int targetStart = math_max(0,
+            static_cast<int>(m_scaledCompletion / 2 * scale) - 1);
+    const int targetEnd = math_min(length(),
+            static_cast<int>(std::ceil(m_actualCompletion / 2 * scale)) + 1);
+    const int sourceStart = static_cast<int>(targetStart / scale);
+    const int sourceEnd = math_min(sourceWidth,
+            static_cast<int>(std::ceil(targetEnd / scale)));
+    m_scaledCompletion = m_actualCompletion;
+    if (targetEnd <= targetStart || sourceEnd <= sourceStart) {
+        return;
+    }
+
+    QImage croppedImage = m_waveformSourceImage.copy(sourceStart, sourceRect.y(),
+            sourceEnd - sourceStart, sourceRect.height());
+    QPainter painter(&m_waveformImageScaled);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    if (m_orientation == Qt::Vertical) {
+        croppedImage = croppedImage.transformed(QTransform(0, 1, 1, 0, 0, 0));
+        painter.drawImage(0, targetStart, croppedImage.scaled(
+                breadth(), targetEnd - targetStart,
+                Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+    } else {
+        painter.drawImage(targetStart, 0, croppedImage.scaled(
+                targetEnd - targetStart, breadth(),
+                Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+    }
+}
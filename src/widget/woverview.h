@@ -91,6 +91,21 @@ class WOverview : public WWidget {
   private:
     // Append the waveform overview pixmap according to available data in waveform
     virtual bool drawNextPixmapPart() = 0;
+    // Restores a cached overview of a completely analyzed waveform or draws
+    // the part of the waveform that has been analyzed since the last call.
+    // Returns true if the pixmap has changed.
+    bool drawNextWaveformPart();
+    QString overviewCacheKey() const;
+    bool restoreCachedOverview();
+    void storeCachedOverview();
+    // The file of the overview that is stored with the analysis
+    QString storedOverviewPath(const QString& key) const;
+    bool loadStoredOverview(const QString& key, QImage* pImage,
+            float* pPeak) const;
+    void resetWaveformImage();
+    // Scales only the columns of the source image that have been drawn since
+    // the scaled image was last updated.
+    void updateWaveformImageScaled(int diffGain);
     void paintText(const QString &text, QPainter *painter);
     inline int valueToPosition(double value) const {
         return static_cast<int>(m_a * value - m_b);
@@ -129,6 +144,9 @@ class WOverview : public WWidget {
     double m_a;
     double m_b;
 
+    // The completion the scaled image has been updated to
+    int m_scaledCompletion;
+
     double m_dAnalyzerProgress;
     bool m_bAnalyzerFinalizing;
     bool m_trackLoaded;